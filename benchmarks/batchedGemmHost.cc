@@ -0,0 +1,156 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2017-2022 The Regents of the University of Michigan and DFT-FE
+// authors.
+//
+// This file is part of the DFT-FE code.
+//
+// The DFT-FE code is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the DFT-FE distribution.
+//
+// ---------------------------------------------------------------------
+//
+// Compares BLASWrapper<HOST>::xgemmStridedBatched against a serial loop of
+// xgemm calls for the cell level products of the Hamiltonian apply,
+// i.e. (numWfc x nDofsPerCell) times (nDofsPerCell x nDofsPerCell) for a
+// batch of cells, for FE orders 2 to 8 and 50 to 2000 wavefunctions. The
+// number of threads is taken from DFTFE_NUM_THREADS.
+//
+#include <BLASWrapper.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace
+{
+  // best of numRepeats wall times in milliseconds
+  template <typename Function>
+  double
+  timeIt(Function f, const unsigned int numRepeats)
+  {
+    double bestTime = 1e30;
+    for (unsigned int iRepeat = 0; iRepeat < numRepeats; ++iRepeat)
+      {
+        const auto start = std::chrono::steady_clock::now();
+        f();
+        const auto end = std::chrono::steady_clock::now();
+        bestTime =
+          std::min(bestTime,
+                   std::chrono::duration<double, std::milli>(end - start)
+                     .count());
+      }
+    return bestTime;
+  }
+} // namespace
+
+int
+main(int argc, char *argv[])
+{
+  const unsigned int numRepeats = argc > 1 ? std::atoi(argv[1]) : 5;
+  // bound on the memory of the cell blocks of X, Y and H, 1 GB by default
+  const double maxBytes =
+    (argc > 2 ? std::atof(argv[2]) : 1.0) * 1024 * 1024 * 1024;
+
+  dftfe::linearAlgebra::BLASWrapper<dftfe::utils::MemorySpace::HOST>
+    BLASWrapperHost;
+
+  std::mt19937                           generator(0);
+  std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+
+  std::printf("%6s %10s %8s %8s %12s %12s %8s %10s\n",
+              "order",
+              "dofs/cell",
+              "numWfc",
+              "cells",
+              "loop (ms)",
+              "batched(ms)",
+              "speedup",
+              "max diff");
+  for (unsigned int feOrder = 2; feOrder <= 8; ++feOrder)
+    for (const unsigned int numWfc : {50, 200, 500, 1000, 2000})
+      {
+        const unsigned int nDofs =
+          (feOrder + 1) * (feOrder + 1) * (feOrder + 1);
+        const double bytesPerCell =
+          8.0 * (2.0 * nDofs * numWfc + 1.0 * nDofs * nDofs);
+        const unsigned int numCells =
+          std::max(1, std::min(100, (int)(maxBytes / bytesPerCell)));
+
+        std::vector<double> X((std::size_t)numCells * nDofs * numWfc);
+        std::vector<double> H((std::size_t)numCells * nDofs * nDofs);
+        std::vector<double> YLoop((std::size_t)numCells * nDofs * numWfc);
+        std::vector<double> YBatched((std::size_t)numCells * nDofs * numWfc);
+        for (double &x : X)
+          x = distribution(generator);
+        for (double &h : H)
+          h = distribution(generator);
+
+        const double    scalarCoeffAlpha = 1.0, scalarCoeffBeta = 0.0;
+        const long long strideX = (long long)nDofs * numWfc;
+        const long long strideH = (long long)nDofs * nDofs;
+
+        const double loopTime = timeIt(
+          [&]() {
+            for (unsigned int iCell = 0; iCell < numCells; ++iCell)
+              BLASWrapperHost.xgemm('N',
+                                    'N',
+                                    numWfc,
+                                    nDofs,
+                                    nDofs,
+                                    &scalarCoeffAlpha,
+                                    X.data() + iCell * strideX,
+                                    numWfc,
+                                    H.data() + iCell * strideH,
+                                    nDofs,
+                                    &scalarCoeffBeta,
+                                    YLoop.data() + iCell * strideX,
+                                    numWfc);
+          },
+          numRepeats);
+        const double batchedTime = timeIt(
+          [&]() {
+            BLASWrapperHost.xgemmStridedBatched('N',
+                                                'N',
+                                                numWfc,
+                                                nDofs,
+                                                nDofs,
+                                                &scalarCoeffAlpha,
+                                                X.data(),
+                                                numWfc,
+                                                strideX,
+                                                H.data(),
+                                                nDofs,
+                                                strideH,
+                                                &scalarCoeffBeta,
+                                                YBatched.data(),
+                                                numWfc,
+                                                strideX,
+                                                numCells);
+          },
+          numRepeats);
+
+        double maxDiff = 0.0;
+        for (std::size_t i = 0; i < YLoop.size(); ++i)
+          maxDiff = std::max(maxDiff, std::abs(YLoop[i] - YBatched[i]));
+
+        std::printf("%6u %10u %8u %8u %12.3f %12.3f %8.2f %10.2e\n",
+                    feOrder,
+                    nDofs,
+                    numWfc,
+                    numCells,
+                    loopTime,
+                    batchedTime,
+                    loopTime / batchedTime,
+                    maxDiff);
+      }
+  return 0;
+}
@@ -0,0 +1,482 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2017-2022 The Regents of the University of Michigan and DFT-FE
+// authors.
+//
+// This file is part of the DFT-FE code.
+//
+// The DFT-FE code is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the DFT-FE distribution.
+//
+// ---------------------------------------------------------------------
+//
+// Compares the two host applications of the local Kohn-Sham Hamiltonian
+// (kinetic plus Veff) on a batch of cells for FE orders 2 to 8:
+//   - the dense cell matrix path, one (numWfc x nDofsPerCell) times
+//     (nDofsPerCell x nDofsPerCell) product per cell with
+//     xgemmStridedBatched,
+//   - the sum-factorized path of MATRIX FREE HAMILTONIAN, the 1D
+//     contractions of tensorProductUtils to the values and collocation
+//     gradients at the (FEOrder+1)^3 Gauss points, the quadrature point
+//     coefficients and the transposed contractions, in chunks of 32
+//     wavefunctions with the cells split over the threads.
+// The reference cell is the unit cube, each cell scales the coefficients by
+// its own factor so that the dense path streams a distinct matrix per cell.
+// Also prints the bytes stored per cell by each path, the crossover decides
+// the default. The number of threads is taken from DFTFE_NUM_THREADS.
+// argv[1] = repeats, argv[2] = GB memory bound of the wavefunction blocks.
+//
+#include <BLASWrapper.h>
+#include <tensorProductUtils.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+#ifdef _OPENMP
+#  include <omp.h>
+#else
+#  define omp_get_thread_num() 0
+#endif
+
+namespace
+{
+  // best of numRepeats wall times in milliseconds
+  template <typename Function>
+  double
+  timeIt(Function f, const unsigned int numRepeats)
+  {
+    double bestTime = 1e30;
+    for (unsigned int iRepeat = 0; iRepeat < numRepeats; ++iRepeat)
+      {
+        const auto start = std::chrono::steady_clock::now();
+        f();
+        const auto end = std::chrono::steady_clock::now();
+        bestTime =
+          std::min(bestTime,
+                   std::chrono::duration<double, std::milli>(end - start)
+                     .count());
+      }
+    return bestTime;
+  }
+
+  // Gauss-Legendre points and weights on [0,1]
+  void
+  gaussLegendre(const unsigned int   n,
+                std::vector<double> &points,
+                std::vector<double> &weights)
+  {
+    points.resize(n);
+    weights.resize(n);
+    for (unsigned int i = 0; i < n; ++i)
+      {
+        // Newton iterations for the i-th root of P_n
+        double x = std::cos(M_PI * (i + 0.75) / (n + 0.5)), derivative = 0.0;
+        for (unsigned int iter = 0; iter < 100; ++iter)
+          {
+            double p0 = 1.0, p1 = x;
+            for (unsigned int k = 2; k <= n; ++k)
+              {
+                const double p2 =
+                  ((2.0 * k - 1.0) * x * p1 - (k - 1.0) * p0) / k;
+                p0 = p1;
+                p1 = p2;
+              }
+            derivative      = n * (x * p1 - p0) / (x * x - 1.0);
+            const double dx = p1 / derivative;
+            x -= dx;
+            if (std::abs(dx) < 1e-15)
+              break;
+          }
+        points[n - 1 - i]  = 0.5 * (x + 1.0);
+        weights[n - 1 - i] = 1.0 / ((1.0 - x * x) * derivative * derivative);
+      }
+  }
+
+  // value and derivative of the i-th Lagrange polynomial on nodes at x
+  void
+  lagrange(const std::vector<double> &nodes,
+           const unsigned int         i,
+           const double               x,
+           double &                   value,
+           double &                   derivative)
+  {
+    value      = 1.0;
+    derivative = 0.0;
+    for (unsigned int j = 0; j < nodes.size(); ++j)
+      if (j != i)
+        {
+          const double factor = 1.0 / (nodes[i] - nodes[j]);
+          derivative = derivative * (x - nodes[j]) * factor + value * factor;
+          value *= (x - nodes[j]) * factor;
+        }
+  }
+} // namespace
+
+int
+main(int argc, char *argv[])
+{
+  const unsigned int numRepeats = argc > 1 ? std::atoi(argv[1]) : 5;
+  const double       maxBytes =
+    (argc > 2 ? std::atof(argv[2]) : 1.0) * 1024 * 1024 * 1024;
+  unsigned int nOMPThreads = 1;
+  if (const char *penv = std::getenv("DFTFE_NUM_THREADS"))
+    nOMPThreads = std::stoi(std::string(penv));
+  const unsigned int vectorsChunkSize = 32;
+
+  dftfe::linearAlgebra::BLASWrapper<dftfe::utils::MemorySpace::HOST>
+    BLASWrapperHost;
+
+  std::mt19937                           generator(0);
+  std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+
+  std::printf("%6s %10s %8s %8s %12s %12s %8s %13s %13s %10s\n",
+              "order",
+              "dofs/cell",
+              "numWfc",
+              "cells",
+              "dense(ms)",
+              "sumfac(ms)",
+              "speedup",
+              "dense B/cell",
+              "sumfac B/cell",
+              "rel diff");
+  for (unsigned int feOrder = 2; feOrder <= 8; ++feOrder)
+    {
+      const unsigned int nDofs1D       = feOrder + 1;
+      const unsigned int nQuads1D      = feOrder + 1;
+      const unsigned int nDofsPerCell  = nDofs1D * nDofs1D * nDofs1D;
+      const unsigned int nQuadsPerCell = nQuads1D * nQuads1D * nQuads1D;
+
+      // Chebyshev-Gauss-Lobatto support points, the timings do not depend
+      // on the placement of the nodes
+      std::vector<double> nodes(nDofs1D), quadPoints, quadWeights;
+      for (unsigned int i = 0; i < nDofs1D; ++i)
+        nodes[i] = 0.5 * (1.0 - std::cos(M_PI * i / feOrder));
+      gaussLegendre(nQuads1D, quadPoints, quadWeights);
+
+      // 1D data as in FEBasisOperations::computeTensorProductShapeData
+      std::vector<double> shapeValues(nQuads1D * nDofs1D),
+        shapeGradients(nQuads1D * nDofs1D),
+        collocationGradients(nQuads1D * nQuads1D);
+      for (unsigned int iQuad = 0; iQuad < nQuads1D; ++iQuad)
+        {
+          for (unsigned int iNode = 0; iNode < nDofs1D; ++iNode)
+            lagrange(nodes,
+                     iNode,
+                     quadPoints[iQuad],
+                     shapeValues[iQuad * nDofs1D + iNode],
+                     shapeGradients[iQuad * nDofs1D + iNode]);
+          for (unsigned int jQuad = 0; jQuad < nQuads1D; ++jQuad)
+            {
+              double value;
+              lagrange(quadPoints,
+                       jQuad,
+                       quadPoints[iQuad],
+                       value,
+                       collocationGradients[iQuad * nQuads1D + jQuad]);
+            }
+        }
+
+      // Veff*JxW and 0.5*J^-1J^-T*JxW of the reference cell, lexicographic
+      std::vector<double> VeffJxW(nQuadsPerCell),
+        stiffnessWeights(nQuadsPerCell);
+      for (unsigned int q2 = 0; q2 < nQuads1D; ++q2)
+        for (unsigned int q1 = 0; q1 < nQuads1D; ++q1)
+          for (unsigned int q0 = 0; q0 < nQuads1D; ++q0)
+            {
+              const unsigned int iQuad = (q2 * nQuads1D + q1) * nQuads1D + q0;
+              const double       jxw =
+                quadWeights[q0] * quadWeights[q1] * quadWeights[q2];
+              VeffJxW[iQuad] = (1.0 + 0.5 * distribution(generator)) * jxw;
+              stiffnessWeights[iQuad] = 0.5 * jxw;
+            }
+
+      // dense cell matrix of the reference cell
+      std::vector<double> cellMatrix(nDofsPerCell * nDofsPerCell, 0.0);
+      {
+        std::vector<double> values(nQuadsPerCell * nDofsPerCell),
+          gradients(3 * nQuadsPerCell * nDofsPerCell);
+        for (unsigned int iQuad = 0; iQuad < nQuadsPerCell; ++iQuad)
+          for (unsigned int iNode = 0; iNode < nDofsPerCell; ++iNode)
+            {
+              const unsigned int q[3] = {iQuad % nQuads1D,
+                                         (iQuad / nQuads1D) % nQuads1D,
+                                         iQuad / (nQuads1D * nQuads1D)};
+              const unsigned int n[3] = {iNode % nDofs1D,
+                                         (iNode / nDofs1D) % nDofs1D,
+                                         iNode / (nDofs1D * nDofs1D)};
+              double v[3], g[3];
+              for (unsigned int iDim = 0; iDim < 3; ++iDim)
+                {
+                  v[iDim] = shapeValues[q[iDim] * nDofs1D + n[iDim]];
+                  g[iDim] = shapeGradients[q[iDim] * nDofs1D + n[iDim]];
+                }
+              values[iQuad * nDofsPerCell + iNode] = v[0] * v[1] * v[2];
+              gradients[(3 * iQuad + 0) * nDofsPerCell + iNode] =
+                g[0] * v[1] * v[2];
+              gradients[(3 * iQuad + 1) * nDofsPerCell + iNode] =
+                v[0] * g[1] * v[2];
+              gradients[(3 * iQuad + 2) * nDofsPerCell + iNode] =
+                v[0] * v[1] * g[2];
+            }
+        for (unsigned int iQuad = 0; iQuad < nQuadsPerCell; ++iQuad)
+          for (unsigned int iNode = 0; iNode < nDofsPerCell; ++iNode)
+            for (unsigned int jNode = 0; jNode < nDofsPerCell; ++jNode)
+              {
+                double entry = VeffJxW[iQuad] *
+                               values[iQuad * nDofsPerCell + iNode] *
+                               values[iQuad * nDofsPerCell + jNode];
+                for (unsigned int iDim = 0; iDim < 3; ++iDim)
+                  entry +=
+                    stiffnessWeights[iQuad] *
+                    gradients[(3 * iQuad + iDim) * nDofsPerCell + iNode] *
+                    gradients[(3 * iQuad + iDim) * nDofsPerCell + jNode];
+                cellMatrix[iNode * nDofsPerCell + jNode] += entry;
+              }
+      }
+
+      for (const unsigned int numWfc : {50, 200, 500, 1000})
+        {
+          const double bytesPerCell =
+            8.0 * (2.0 * nDofsPerCell * numWfc + nDofsPerCell * nDofsPerCell);
+          const unsigned int numCells =
+            std::max(1, std::min(100, (int)(maxBytes / bytesPerCell)));
+
+          std::vector<double> cellScaling(numCells);
+          for (unsigned int iCell = 0; iCell < numCells; ++iCell)
+            cellScaling[iCell] = 1.0 + 0.01 * iCell;
+          std::vector<double> H((std::size_t)numCells * nDofsPerCell *
+                                nDofsPerCell);
+          for (unsigned int iCell = 0; iCell < numCells; ++iCell)
+            for (unsigned int i = 0; i < nDofsPerCell * nDofsPerCell; ++i)
+              H[(std::size_t)iCell * nDofsPerCell * nDofsPerCell + i] =
+                cellScaling[iCell] * cellMatrix[i];
+
+          std::vector<double> X((std::size_t)numCells * nDofsPerCell * numWfc);
+          std::vector<double> YDense(X.size()), YSumFac(X.size());
+          for (double &x : X)
+            x = distribution(generator);
+
+          const double    scalarCoeffAlpha = 1.0, scalarCoeffBeta = 0.0;
+          const long long strideX = (long long)nDofsPerCell * numWfc;
+          const long long strideH = (long long)nDofsPerCell * nDofsPerCell;
+          const double    denseTime = timeIt(
+            [&]() {
+              BLASWrapperHost.xgemmStridedBatched('N',
+                                                  'N',
+                                                  numWfc,
+                                                  nDofsPerCell,
+                                                  nDofsPerCell,
+                                                  &scalarCoeffAlpha,
+                                                  X.data(),
+                                                  numWfc,
+                                                  strideX,
+                                                  H.data(),
+                                                  nDofsPerCell,
+                                                  strideH,
+                                                  &scalarCoeffBeta,
+                                                  YDense.data(),
+                                                  numWfc,
+                                                  strideX,
+                                                  numCells);
+            },
+            numRepeats);
+
+          const unsigned int maxExtent1D = std::max(nDofs1D, nQuads1D);
+          const unsigned int bufferSize =
+            maxExtent1D * maxExtent1D * maxExtent1D * vectorsChunkSize;
+          std::vector<std::vector<double>> scratchThreads(
+            nOMPThreads, std::vector<double>(7 * bufferSize));
+          const std::array<unsigned int, 3> dofExtents  = {nDofs1D,
+                                                          nDofs1D,
+                                                          nDofs1D};
+          const std::array<unsigned int, 3> quadExtents = {nQuads1D,
+                                                           nQuads1D,
+                                                           nQuads1D};
+          const double                      sumFacTime  = timeIt(
+            [&]() {
+#pragma omp parallel for num_threads(nOMPThreads) if (nOMPThreads > 1)
+              for (unsigned int iCell = 0; iCell < numCells; ++iCell)
+                {
+                  double *cellValues =
+                    scratchThreads[omp_get_thread_num()].data();
+                  double *tempValues1      = cellValues + bufferSize;
+                  double *tempValues2      = tempValues1 + bufferSize;
+                  double *quadValues       = tempValues2 + bufferSize;
+                  double *quadGradients[3] = {quadValues + bufferSize,
+                                              quadValues + 2 * bufferSize,
+                                              quadValues + 3 * bufferSize};
+                  double *cellResult       = quadGradients[0];
+                  const double *src        = X.data() + iCell * strideX;
+                  double *      dst        = YSumFac.data() + iCell * strideX;
+                  for (unsigned int startVec = 0; startVec < numWfc;
+                       startVec += vectorsChunkSize)
+                    {
+                      const unsigned int nVecs =
+                        std::min(vectorsChunkSize, numWfc - startVec);
+                      for (unsigned int iNode = 0; iNode < nDofsPerCell;
+                           ++iNode)
+                        std::copy(src + iNode * numWfc + startVec,
+                                  src + iNode * numWfc + startVec + nVecs,
+                                  cellValues + iNode * nVecs);
+
+                      dftfe::tensorProductUtils::contractTensorProductDirection(
+                        BLASWrapperHost,
+                        shapeValues.data(),
+                        nQuads1D,
+                        nDofs1D,
+                        false,
+                        0,
+                        dofExtents,
+                        nVecs,
+                        cellValues,
+                        0.0,
+                        tempValues1);
+                      dftfe::tensorProductUtils::contractTensorProductDirection(
+                        BLASWrapperHost,
+                        shapeValues.data(),
+                        nQuads1D,
+                        nDofs1D,
+                        false,
+                        1,
+                        {nQuads1D, nDofs1D, nDofs1D},
+                        nVecs,
+                        tempValues1,
+                        0.0,
+                        tempValues2);
+                      dftfe::tensorProductUtils::contractTensorProductDirection(
+                        BLASWrapperHost,
+                        shapeValues.data(),
+                        nQuads1D,
+                        nDofs1D,
+                        false,
+                        2,
+                        {nQuads1D, nQuads1D, nDofs1D},
+                        nVecs,
+                        tempValues2,
+                        0.0,
+                        quadValues);
+                      for (unsigned int iDim = 0; iDim < 3; ++iDim)
+                        dftfe::tensorProductUtils::
+                          contractTensorProductDirection(
+                            BLASWrapperHost,
+                            collocationGradients.data(),
+                            nQuads1D,
+                            nQuads1D,
+                            false,
+                            iDim,
+                            quadExtents,
+                            nVecs,
+                            quadValues,
+                            0.0,
+                            quadGradients[iDim]);
+
+                      for (unsigned int iQuad = 0; iQuad < nQuadsPerCell;
+                           ++iQuad)
+                        {
+                          const double valueWeight =
+                            cellScaling[iCell] * VeffJxW[iQuad];
+                          const double gradientWeight =
+                            cellScaling[iCell] * stiffnessWeights[iQuad];
+                          for (unsigned int iVec = 0; iVec < nVecs; ++iVec)
+                            {
+                              quadValues[iQuad * nVecs + iVec] *= valueWeight;
+                              for (unsigned int iDim = 0; iDim < 3; ++iDim)
+                                quadGradients[iDim][iQuad * nVecs + iVec] *=
+                                  gradientWeight;
+                            }
+                        }
+
+                      for (unsigned int iDim = 0; iDim < 3; ++iDim)
+                        dftfe::tensorProductUtils::
+                          contractTensorProductDirection(
+                            BLASWrapperHost,
+                            collocationGradients.data(),
+                            nQuads1D,
+                            nQuads1D,
+                            true,
+                            iDim,
+                            quadExtents,
+                            nVecs,
+                            quadGradients[iDim],
+                            1.0,
+                            quadValues);
+                      dftfe::tensorProductUtils::contractTensorProductDirection(
+                        BLASWrapperHost,
+                        shapeValues.data(),
+                        nQuads1D,
+                        nDofs1D,
+                        true,
+                        2,
+                        quadExtents,
+                        nVecs,
+                        quadValues,
+                        0.0,
+                        tempValues2);
+                      dftfe::tensorProductUtils::contractTensorProductDirection(
+                        BLASWrapperHost,
+                        shapeValues.data(),
+                        nQuads1D,
+                        nDofs1D,
+                        true,
+                        1,
+                        {nQuads1D, nQuads1D, nDofs1D},
+                        nVecs,
+                        tempValues2,
+                        0.0,
+                        tempValues1);
+                      dftfe::tensorProductUtils::contractTensorProductDirection(
+                        BLASWrapperHost,
+                        shapeValues.data(),
+                        nQuads1D,
+                        nDofs1D,
+                        true,
+                        0,
+                        {nQuads1D, nDofs1D, nDofs1D},
+                        nVecs,
+                        tempValues1,
+                        0.0,
+                        cellResult);
+
+                      for (unsigned int iNode = 0; iNode < nDofsPerCell;
+                           ++iNode)
+                        std::copy(cellResult + iNode * nVecs,
+                                  cellResult + (iNode + 1) * nVecs,
+                                  dst + iNode * numWfc + startVec);
+                    }
+                }
+            },
+            numRepeats);
+
+          double maxDiff = 0.0, maxValue = 0.0;
+          for (std::size_t i = 0; i < YDense.size(); ++i)
+            {
+              maxDiff  = std::max(maxDiff, std::abs(YDense[i] - YSumFac[i]));
+              maxValue = std::max(maxValue, std::abs(YDense[i]));
+            }
+
+          std::printf("%6u %10u %8u %8u %12.3f %12.3f %8.2f %13.0f %13.0f "
+                      "%10.2e\n",
+                      feOrder,
+                      nDofsPerCell,
+                      numWfc,
+                      numCells,
+                      denseTime,
+                      sumFacTime,
+                      denseTime / sumFacTime,
+                      8.0 * nDofsPerCell * nDofsPerCell,
+                      8.0 * 11 * nQuadsPerCell,
+                      maxDiff / maxValue);
+        }
+    }
+  return 0;
+}
@@ -0,0 +1,223 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2017-2022 The Regents of the University of Michigan and DFT-FE
+// authors.
+//
+// This file is part of the DFT-FE code.
+//
+// The DFT-FE code is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the DFT-FE distribution.
+//
+// ---------------------------------------------------------------------
+//
+// Compares the communication modes of MPICommunicatorP2P (the MPI
+// COMMUNICATION MODE parameter) for the ghost value updates of a periodic
+// chain of processors, where every processor has the ghostsPerNeighbor
+// indices next to its owned range on both neighbours as ghosts. The time per
+// updateGhostValues is measured for 16 to 4096 ghosts per neighbour, block
+// sizes (number of vectors) 1 to 256 and 2, 4, ... processors up to the size
+// of MPI_COMM_WORLD. As in the Chebyshev filter, two vectors are updated in
+// turn. Run it with mpirun, e.g.
+//   mpirun -n 16 ./benchmarks/mpiCommunicatorP2P
+//
+#include <MPICommunicatorP2P.h>
+#include <MPIPatternP2P.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+namespace
+{
+  typedef dftfe::utils::mpi::MPIPatternP2P<dftfe::utils::MemorySpace::HOST>
+    patternType;
+  typedef dftfe::utils::mpi::
+    MPICommunicatorP2P<double, dftfe::utils::MemorySpace::HOST>
+      communicatorType;
+  typedef dftfe::utils::MemoryStorage<double, dftfe::utils::MemorySpace::HOST>
+    storageType;
+
+  // value of the index globalIndex in the column iVec of the block
+  double
+  referenceValue(const dftfe::global_size_type globalIndex,
+                 const unsigned int            iVec)
+  {
+    return globalIndex + 0.25 * iVec;
+  }
+
+  // fills the owned values of the data array, the ghosts with -1
+  void
+  fillData(storageType &                 data,
+           const patternType &           pattern,
+           const dftfe::global_size_type ownedStart,
+           const unsigned int            blockSize)
+  {
+    std::vector<double> values(data.size(), -1.0);
+    for (unsigned int i = 0; i < pattern.localOwnedSize(); ++i)
+      for (unsigned int iVec = 0; iVec < blockSize; ++iVec)
+        values[i * blockSize + iVec] = referenceValue(ownedStart + i, iVec);
+    data.copyFrom(values);
+  }
+
+  // max error of the ghost values over the processors of mpiComm
+  double
+  ghostError(const storageType &                         data,
+             const std::vector<dftfe::global_size_type> &ghostIndices,
+             const unsigned int                          numOwned,
+             const unsigned int                          blockSize,
+             const MPI_Comm &                            mpiComm)
+  {
+    std::vector<double> values(data.size());
+    data.copyTo(values);
+    double error = 0.0;
+    for (unsigned int i = 0; i < ghostIndices.size(); ++i)
+      for (unsigned int iVec = 0; iVec < blockSize; ++iVec)
+        error =
+          std::max(error,
+                   std::abs(values[(numOwned + i) * blockSize + iVec] -
+                            referenceValue(ghostIndices[i], iVec)));
+    MPI_Allreduce(MPI_IN_PLACE, &error, 1, MPI_DOUBLE, MPI_MAX, mpiComm);
+    return error;
+  }
+} // namespace
+
+int
+main(int argc, char *argv[])
+{
+  MPI_Init(&argc, &argv);
+  const unsigned int numRepeats = argc > 1 ? std::atoi(argv[1]) : 50;
+  // owned indices per processor
+  const unsigned int numOwned = argc > 2 ? std::atoi(argv[2]) : 20000;
+
+  int worldSize, worldRank;
+  MPI_Comm_size(MPI_COMM_WORLD, &worldSize);
+  MPI_Comm_rank(MPI_COMM_WORLD, &worldRank);
+
+  std::vector<int> numProcsList;
+  for (int numProcs = 2; numProcs < worldSize; numProcs *= 2)
+    numProcsList.push_back(numProcs);
+  numProcsList.push_back(std::max(worldSize, 2));
+
+  const std::vector<dftfe::utils::mpi::communicationMode> modes = {
+    dftfe::utils::mpi::communicationMode::nonBlocking,
+    dftfe::utils::mpi::communicationMode::persistent,
+    dftfe::utils::mpi::communicationMode::neighborhoodCollective};
+
+  if (worldRank == 0)
+    std::printf("%6s %8s %6s %12s %12s %12s %12s %10s\n",
+                "procs",
+                "ghosts",
+                "block",
+                "msg (KB)",
+                "nonblk (us)",
+                "persist (us)",
+                "neighbr (us)",
+                "max error");
+  for (const int numProcs : numProcsList)
+    {
+      if (numProcs > worldSize)
+        break;
+      MPI_Comm mpiComm;
+      MPI_Comm_split(MPI_COMM_WORLD,
+                     worldRank < numProcs ? 0 : MPI_UNDEFINED,
+                     worldRank,
+                     &mpiComm);
+      if (mpiComm != MPI_COMM_NULL)
+        {
+          int rank;
+          MPI_Comm_rank(mpiComm, &rank);
+          const dftfe::global_size_type ownedStart =
+            (dftfe::global_size_type)rank * numOwned;
+          const dftfe::global_size_type totalSize =
+            (dftfe::global_size_type)numProcs * numOwned;
+
+          for (const unsigned int ghostsPerNeighbor : {16, 256, 4096})
+            {
+              // the ghosts have to stay outside of the owned range
+              if (2 * ghostsPerNeighbor > numOwned)
+                continue;
+
+              // the last indices of the left and the first indices of the
+              // right neighbour, ordered
+              std::vector<dftfe::global_size_type> ghostIndices;
+              for (unsigned int i = 0; i < ghostsPerNeighbor; ++i)
+                {
+                  ghostIndices.push_back((ownedStart + totalSize - 1 - i) %
+                                         totalSize);
+                  ghostIndices.push_back((ownedStart + numOwned + i) %
+                                         totalSize);
+                }
+              std::sort(ghostIndices.begin(), ghostIndices.end());
+              ghostIndices.erase(std::unique(ghostIndices.begin(),
+                                             ghostIndices.end()),
+                                 ghostIndices.end());
+              auto pattern = std::make_shared<const patternType>(
+                std::make_pair(ownedStart, ownedStart + numOwned),
+                ghostIndices,
+                mpiComm);
+
+              for (const unsigned int blockSize : {1, 16, 64, 256})
+                {
+                  std::vector<double> timesPerUpdate;
+                  double              maxError = 0.0;
+                  for (const auto mode : modes)
+                    {
+                      communicatorType communicator(pattern, blockSize);
+                      communicator.setCommunicationMode(mode);
+                      std::vector<storageType> data(2);
+                      for (auto &vector : data)
+                        {
+                          vector.resize((numOwned + ghostIndices.size()) *
+                                        blockSize);
+                          fillData(vector, *pattern, ownedStart, blockSize);
+                        }
+
+                      // the first updates create the persistent requests and
+                      // the graph communicators
+                      for (auto &vector : data)
+                        communicator.updateGhostValues(vector);
+                      MPI_Barrier(mpiComm);
+                      const double start = MPI_Wtime();
+                      for (unsigned int iRepeat = 0; iRepeat < numRepeats;
+                           ++iRepeat)
+                        communicator.updateGhostValues(data[iRepeat % 2]);
+                      double time = (MPI_Wtime() - start) / numRepeats;
+                      MPI_Allreduce(
+                        MPI_IN_PLACE, &time, 1, MPI_DOUBLE, MPI_MAX, mpiComm);
+                      timesPerUpdate.push_back(1e6 * time);
+
+                      for (const auto &vector : data)
+                        maxError = std::max(maxError,
+                                            ghostError(vector,
+                                                       ghostIndices,
+                                                       numOwned,
+                                                       blockSize,
+                                                       mpiComm));
+                    }
+                  if (rank == 0)
+                    std::printf(
+                      "%6d %8u %6u %12.1f %12.1f %12.1f %12.1f %10.2e\n",
+                      numProcs,
+                      ghostsPerNeighbor,
+                      blockSize,
+                      8.0 * ghostsPerNeighbor * blockSize / 1024.0,
+                      timesPerUpdate[0],
+                      timesPerUpdate[1],
+                      timesPerUpdate[2],
+                      maxError);
+                }
+            }
+          MPI_Comm_free(&mpiComm);
+        }
+      MPI_Barrier(MPI_COMM_WORLD);
+    }
+  MPI_Finalize();
+  return 0;
+}
@@ -0,0 +1,190 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2017-2022 The Regents of the University of Michigan and DFT-FE
+// authors.
+//
+// This file is part of the DFT-FE code.
+//
+// The DFT-FE code is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the DFT-FE distribution.
+//
+// ---------------------------------------------------------------------
+//
+// Compares the evaluations used to build the nonlocal C matrix, the core
+// densities and the local pseudopotential against the per point path:
+//   - all the real spherical harmonics up to lMax from the Cartesian
+//     recurrence (getSphericalHarmonicValsAllLm) against
+//     convertCartesianToSpherical followed by one getSphericalHarmonicVal
+//     call per (l,m),
+//   - the batched radial spline evaluation (getRadialValues) against one
+//     getRadialValue call per point.
+// The radial function is tabulated on a logarithmic grid like the upf
+// grids. argv[1] = number of points, argv[2] = number of repeats.
+//
+#include <AtomCenteredSphericalFunctionCoreDensitySpline.h>
+#include <boost/math/special_functions/spherical_harmonic.hpp>
+#include <sphericalHarmonicUtils.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace
+{
+  // best of numRepeats wall times in milliseconds
+  template <typename Function>
+  double
+  timeIt(Function f, const unsigned int numRepeats)
+  {
+    double bestTime = 1e30;
+    for (unsigned int iRepeat = 0; iRepeat < numRepeats; ++iRepeat)
+      {
+        const auto start = std::chrono::steady_clock::now();
+        f();
+        const auto end = std::chrono::steady_clock::now();
+        bestTime =
+          std::min(bestTime,
+                   std::chrono::duration<double, std::milli>(end - start)
+                     .count());
+      }
+    return bestTime;
+  }
+} // namespace
+
+int
+main(int argc, char *argv[])
+{
+  const unsigned int numPoints  = argc > 1 ? std::atoi(argv[1]) : 100000;
+  const unsigned int numRepeats = argc > 2 ? std::atoi(argv[2]) : 5;
+  const double       rMax       = 6.0;
+
+  std::mt19937                           generator(0);
+  std::uniform_real_distribution<double> distribution(-rMax, rMax);
+  std::vector<double>                    points(3 * numPoints);
+  for (double &x : points)
+    x = distribution(generator);
+
+  std::printf("Spherical harmonics, %u points\n", numPoints);
+  std::printf("%6s %12s %12s %8s %10s\n",
+              "lMax",
+              "boost(ms)",
+              "allLm(ms)",
+              "speedup",
+              "max diff");
+  for (int lMax = 0; lMax <= 6; ++lMax)
+    {
+      const unsigned int  numLm = (lMax + 1) * (lMax + 1);
+      std::vector<double> valuesPerPoint(numPoints * numLm);
+      std::vector<double> valuesAllLm(numPoints * numLm);
+
+      const double perPointTime = timeIt(
+        [&]() {
+          for (unsigned int iPoint = 0; iPoint < numPoints; ++iPoint)
+            {
+              double x[3] = {points[3 * iPoint],
+                             points[3 * iPoint + 1],
+                             points[3 * iPoint + 2]};
+              double r, theta, phi;
+              dftfe::sphericalHarmonicUtils::convertCartesianToSpherical(
+                x, r, theta, phi);
+              for (int l = 0; l <= lMax; ++l)
+                for (int m = -l; m <= l; ++m)
+                  dftfe::sphericalHarmonicUtils::getSphericalHarmonicVal(
+                    theta,
+                    phi,
+                    l,
+                    m,
+                    valuesPerPoint[iPoint * numLm + l * l + l + m]);
+            }
+        },
+        numRepeats);
+      const double allLmTime = timeIt(
+        [&]() {
+          for (unsigned int iPoint = 0; iPoint < numPoints; ++iPoint)
+            dftfe::sphericalHarmonicUtils::getSphericalHarmonicValsAllLm(
+              points.data() + 3 * iPoint,
+              lMax,
+              valuesAllLm.data() + iPoint * numLm);
+        },
+        numRepeats);
+
+      double maxDiff = 0.0;
+      for (unsigned int i = 0; i < valuesAllLm.size(); ++i)
+        maxDiff =
+          std::max(maxDiff, std::abs(valuesAllLm[i] - valuesPerPoint[i]));
+      std::printf("%6d %12.3f %12.3f %8.2f %10.2e\n",
+                  lMax,
+                  perPointTime,
+                  allLmTime,
+                  perPointTime / allLmTime,
+                  maxDiff);
+    }
+
+  std::printf("\nRadial spline, %u points\n", numPoints);
+  std::printf("%8s %12s %12s %8s %10s\n",
+              "gridSize",
+              "perPoint(ms)",
+              "batched(ms)",
+              "speedup",
+              "max diff");
+  for (const unsigned int gridSize : {500, 1500, 4000})
+    {
+      // rows of [r, f(r)] on r_i = r_0 exp(i dx), with a trailing row as in
+      // the dftfe format files, whose last row is not used for the spline
+      std::vector<std::vector<double>> radialData(gridSize + 1,
+                                                  std::vector<double>(2));
+      const double r0 = 1e-4, dx = std::log(2.0 * rMax / r0) / (gridSize - 1);
+      for (unsigned int i = 0; i <= gridSize; ++i)
+        {
+          const double r   = r0 * std::exp(i * dx);
+          radialData[i][0] = r;
+          radialData[i][1] = std::exp(-r * r) * (1.0 + 0.5 * std::cos(3.0 * r));
+        }
+      dftfe::AtomCenteredSphericalFunctionCoreDensitySpline radialFunction(
+        radialData, 1e-14, true);
+
+      std::vector<double> radialDistances(numPoints);
+      for (unsigned int iPoint = 0; iPoint < numPoints; ++iPoint)
+        radialDistances[iPoint] =
+          std::sqrt(points[3 * iPoint] * points[3 * iPoint] +
+                    points[3 * iPoint + 1] * points[3 * iPoint + 1] +
+                    points[3 * iPoint + 2] * points[3 * iPoint + 2]);
+      std::vector<double> valuesPerPoint(numPoints), valuesBatched(numPoints);
+
+      const double perPointTime = timeIt(
+        [&]() {
+          for (unsigned int iPoint = 0; iPoint < numPoints; ++iPoint)
+            valuesPerPoint[iPoint] =
+              radialFunction.getRadialValue(radialDistances[iPoint]);
+        },
+        numRepeats);
+      const double batchedTime = timeIt(
+        [&]() {
+          radialFunction.getRadialValues(radialDistances.data(),
+                                         valuesBatched.data(),
+                                         numPoints);
+        },
+        numRepeats);
+
+      double maxDiff = 0.0;
+      for (unsigned int iPoint = 0; iPoint < numPoints; ++iPoint)
+        maxDiff = std::max(maxDiff,
+                           std::abs(valuesBatched[iPoint] -
+                                    valuesPerPoint[iPoint]));
+      std::printf("%8u %12.3f %12.3f %8.2f %10.2e\n",
+                  gridSize,
+                  perPointTime,
+                  batchedTime,
+                  perPointTime / batchedTime,
+                  maxDiff);
+    }
+  return 0;
+}
@@ -35,6 +35,19 @@ namespace dftfe
     virtual double
     getRadialValue(double r) const = 0;
 
+    /**
+     * @brief Computes the Radial Values of the Function at a batch of radial
+     * distances. The default implementation calls getRadialValue for each
+     * distance, derived classes can override it with a vectorized evaluation.
+     * @param[in] r radial distances, array of size numPoints
+     * @param[out] values function values, array of size numPoints
+     * @param[in] numPoints number of radial distances
+     */
+    virtual void
+    getRadialValues(const double *     r,
+                    double *           values,
+                    const unsigned int numPoints) const;
+
     // The following functions need not be re-defined in the
     // derived classes. So it is being defined in this class
     /**
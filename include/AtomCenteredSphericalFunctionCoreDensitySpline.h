@@ -52,6 +52,26 @@ namespace dftfe
       std::string filename,
       double      truncationTol    = 1E-10,
       bool        consider0thEntry = true);
+
+    /**
+     * @brief Creates splines for radial-core Density from rows of [r, f(r)] by applying suitable BC on spline and determining the cutOff Radius
+     * @param[in] radialFunctionData the radial data, an empty table creates
+     * a function without data
+     * @param[in] truncationTol the minimum function value afterwhich the
+     * function is truncated.
+     * @param[in]  consider0thEntry whether to replace the 0th fn value with the
+     * 1st value in the data.
+     */
+    AtomCenteredSphericalFunctionCoreDensitySpline(
+      const std::vector<std::vector<double>> &radialFunctionData,
+      double                                  truncationTol    = 1E-10,
+      bool                                    consider0thEntry = true);
+
+  private:
+    void
+    initializeSpline(const std::vector<std::vector<double>> &radialFunctionData,
+                     double                                  truncationTol,
+                     bool consider0thEntry);
   };
 
 } // end of namespace dftfe
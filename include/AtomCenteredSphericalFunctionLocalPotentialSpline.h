@@ -54,6 +54,28 @@ namespace dftfe
       double      atomAttribute,
       double      truncationTol  = 1E-10,
       double      maxAllowedTail = 8.0001);
+
+    /**
+     * @brief Creates splines for radial-Local Potential from rows of [r, V(r)] by applying suitable BC on spline and determining the cutOff Radius
+     * @param[in] radialFunctionData the radial data
+     * @param[in] atomAttribute the atomic number
+     * @param[in] truncationTol the minimum function value afterwhich the
+     * function is truncated.
+     * @param[in]  maxAllowedTail Maximum distance before the function is
+     * evaluated as Z/r
+     */
+    AtomCenteredSphericalFunctionLocalPotentialSpline(
+      const std::vector<std::vector<double>> &radialFunctionData,
+      double                                  atomAttribute,
+      double                                  truncationTol  = 1E-10,
+      double                                  maxAllowedTail = 8.0001);
+
+  private:
+    void
+    initializeSpline(const std::vector<std::vector<double>> &radialFunctionData,
+                     double                                  atomAttribute,
+                     double                                  truncationTol,
+                     double                                  maxAllowedTail);
   };
 
 } // end of namespace dftfe
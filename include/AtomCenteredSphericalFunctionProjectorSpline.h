@@ -59,6 +59,34 @@ namespace dftfe
                                                  int          totalColSize,
                                                  double truncationTol  = 1E-10,
                                                  bool consider0thEntry = true);
+
+    /**
+     * @brief Creates splines for radial projectors from rows of [r, f_1(r), f_2(r), ...] by applying suitable BC on spline and determining the cutOff Radius
+     * @param[in] radialFunctionData the radial data
+     * @param[in] l quantumNumber-l
+     * @param[in] radialPower  mulitply the data with pow(r,radialPower)
+     * @param[in] colIndex the column Number where the function data is present
+     * @param[in] truncationTol the minimum function value afterwhich the
+     * function is truncated.
+     * @param[in]  consider0thEntry whether to replace the 0th fn value with the
+     * 1st value in the data.
+     */
+    AtomCenteredSphericalFunctionProjectorSpline(
+      const std::vector<std::vector<double>> &radialFunctionData,
+      unsigned int                            l,
+      int                                     radialPower,
+      int                                     colIndex,
+      double                                  truncationTol    = 1E-10,
+      bool                                    consider0thEntry = true);
+
+  private:
+    void
+    initializeSpline(const std::vector<std::vector<double>> &radialFunctionData,
+                     unsigned int                            l,
+                     int                                     radialPower,
+                     int                                     colIndex,
+                     double                                  truncationTol,
+                     bool consider0thEntry);
   };
 
 } // end of namespace dftfe
@@ -43,6 +43,20 @@ namespace dftfe
     double
     getRadialValue(double r) const override;
 
+    /**
+     * @brief Computes the Radial Values at a batch of radial distances using
+     * the unpacked piecewise cubic coefficients of the spline. The spline
+     * interval of each distance is found from a uniform bin lookup table
+     * followed by a bisection restricted to the intervals of the bin, and the
+     * cubic polynomials are then evaluated in a vectorized loop. Gives the
+     * same values as getRadialValue. Falls back to getRadialValue if
+     * initializeBatchedEvaluation has not been called.
+     */
+    void
+    getRadialValues(const double *     r,
+                    double *           values,
+                    const unsigned int numPoints) const override;
+
     std::vector<double>
     getDerivativeValue(double r) const override;
 
@@ -50,9 +64,33 @@ namespace dftfe
     getrMinVal() const;
 
   protected:
+    /**
+     * @brief unpack the spline coefficients and build the bin lookup table
+     * used by getRadialValues. To be called by the derived classes after
+     * d_radialSplineObject is built.
+     */
+    void
+    initializeBatchedEvaluation();
+
     double d_rMin;
 
     alglib::spline1dinterpolant d_radialSplineObject;
+
+  private:
+    /// returns the spline interval index containing r
+    unsigned int
+    getSplineIntervalIndex(const double r) const;
+
+    /// spline knots
+    std::vector<double> d_splineKnots;
+
+    /// cubic coefficients c0,c1,c2,c3 of each interval in powers of (r-x_i)
+    std::vector<double> d_splineCoefficients;
+
+    /// interval index containing the left edge of each uniform bin
+    std::vector<unsigned int> d_binToIntervalIndex;
+
+    double d_binInverseWidth;
   };
 
 } // end of namespace dftfe
@@ -0,0 +1,101 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2017-2022 The Regents of the University of Michigan and DFT-FE
+// authors.
+//
+// This file is part of the DFT-FE code.
+//
+// The DFT-FE code is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the DFT-FE distribution.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dftfeAtomSpatialIndex_h
+#define dftfeAtomSpatialIndex_h
+
+#include <vector>
+
+namespace dftfe
+{
+  namespace utils
+  {
+    /**
+     * @brief Uniform cell-list over a set of points in 3D, used for the
+     * proximity queries between atoms, their periodic images and the
+     * cells of the mesh during setup.
+     *
+     * The points are given as a flattened xyz array, with the periodic images
+     * appended explicitly as separate points (the image lists are already
+     * available wherever these queries are made), so no wrapping is done
+     * inside the index. The queries return exactly what a brute force scan
+     * over all the points would return, including the order of the returned
+     * ids and the resolution of ties.
+     */
+    class AtomSpatialIndex
+    {
+    public:
+      AtomSpatialIndex();
+
+      /**
+       * @brief builds the index
+       * @param[in] points flattened coordinates of size 3*numPoints
+       * @param[in] binSize edge length of the bins. A non positive value
+       * chooses the bin size from the mean volume per point. The bin size is
+       * increased if needed to keep the number of bins of the order of the
+       * number of points.
+       */
+      AtomSpatialIndex(const std::vector<double> &points,
+                       const double               binSize = 0.0);
+
+      void
+      reinit(const std::vector<double> &points, const double binSize = 0.0);
+
+      unsigned int
+      numPoints() const;
+
+      /**
+       * @brief returns the id of the point closest to x, the smallest id
+       * among equidistant points. For an empty index returns 0 and
+       * the largest double as the distance.
+       * @param[in] x query point of size 3
+       * @param[out] distance distance from x to the closest point
+       */
+      unsigned int
+      findClosestPoint(const double *x, double &distance) const;
+
+      /**
+       * @brief ids, in increasing order, of the points at a distance of at
+       * most radius from x
+       */
+      void
+      findPointsInBall(const double *             x,
+                       const double               radius,
+                       std::vector<unsigned int> &pointIds) const;
+
+    private:
+      /// range of bins along each direction overlapping [x-radius,x+radius]
+      bool
+      getBinRange(const double *x,
+                  const double  radius,
+                  int *         binMin,
+                  int *         binMax) const;
+
+      double
+      distanceSquared(const double *x, const unsigned int pointId) const;
+
+      std::vector<double>       d_points;
+      double                    d_lowerCorner[3];
+      double                    d_binSize;
+      int                       d_numBins[3];
+      std::vector<unsigned int> d_binStart;
+      std::vector<unsigned int> d_binPointIds;
+    };
+  } // namespace utils
+
+} // namespace dftfe
+
+#endif
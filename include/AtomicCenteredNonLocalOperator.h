@@ -401,7 +401,9 @@ namespace dftfe
     unsigned int d_numberWaveFunctions;
     unsigned int d_kPointIndex;
     bool         d_isMallocCalled = false;
-    // Host CMatrix Entries are stored here
+    // Host CMatrix Entries are stored here, per atom and element in compact
+    // support. On the host these are released after building
+    // d_CMatrixEntriesConjugateAllCells and d_CMatrixEntriesTransposeAllCells
     std::vector<std::vector<std::vector<ValueType>>> d_CMatrixEntriesConjugate,
       d_CMatrixEntriesTranspose;
 
@@ -421,6 +423,21 @@ namespace dftfe
      */
     void
     initialisePartitioner();
+    /**
+     * @brief groups the cells in cellRange with nonlocal contributions by
+     * their number of spherical functions for the host batched gemms
+     * @param[in] cellRange start and end element id in list of nonlocal
+     * elements
+     * @param[out] cells the cells ordered by their number of spherical
+     * functions
+     * @param[out] groupStarts start of each group of cells with the same
+     * number of spherical functions in cells, with cells.size() appended
+     */
+    void
+    groupCellsByNumberSphericalFunctions(
+      const std::pair<unsigned int, unsigned int> cellRange,
+      std::vector<unsigned int> &                 cells,
+      std::vector<unsigned int> &                 groupStarts) const;
     /**
      * @brief computes the entries in C matrix for CPUs and GPUs. On GPUs the entries are copied to a flattened vector on device memory.
      * Further on GPUs, various maps are created crucial for accessing and
@@ -457,10 +474,24 @@ namespace dftfe
         &sphericalFunctionKetTimesVectorParFlattened);
 #endif
 
-    std::map<
-      unsigned int,
-      dftfe::utils::MemoryStorage<ValueType, dftfe::utils::MemorySpace::HOST>>
-      d_sphericalFnTimesWavefunMatrix;
+    // Host flattened layout of C^{\dagger}X, cell major with the (atom, alpha)
+    // columns of a cell contiguous, offsets given by
+    // d_nonTrivialSphericalFnsCellStartIndex
+    dftfe::utils::MemoryStorage<ValueType, dftfe::utils::MemorySpace::HOST>
+      d_sphericalFnTimesVectorAllCells;
+    // Host V*C^{\dagger}X in the (atom, alpha) numbering of the current
+    // processor
+    dftfe::utils::MemoryStorage<ValueType, dftfe::utils::MemorySpace::HOST>
+      d_couplingMatrixTimesVector;
+    // Host C matrix entries of all kPoints in the above cell major layout
+    std::vector<ValueType> d_CMatrixEntriesConjugateAllCells,
+      d_CMatrixEntriesTransposeAllCells;
+    // maps every entry of the cell major layout to the (atom, alpha)
+    // numbering of the current processor
+    std::vector<unsigned int> d_nonTrivialAllCellsSphericalFnProcessIds;
+    // local ids in the distributed vector of the (atom, alpha) numbering of
+    // the current processor
+    std::vector<unsigned int> d_sphericalFnIdsParallelNumberingMap;
     std::vector<dftfe::global_size_type>
       d_flattenedNonLocalCellDofIndexToProcessDofIndexVector;
     dftfe::utils::MemoryStorage<dftfe::global_size_type, memorySpace>
@@ -499,8 +530,7 @@ namespace dftfe
     dftfe::utils::MemoryStorage<ValueType, dftfe::utils::MemorySpace::DEVICE>
       d_sphericalFnTimesVectorAllCellsReductionDevice;
 
-    std::vector<unsigned int> d_sphericalFnIdsParallelNumberingMap;
-    std::vector<int>          d_sphericalFnIdsPaddedParallelNumberingMap;
+    std::vector<int> d_sphericalFnIdsPaddedParallelNumberingMap;
     dftfe::utils::MemoryStorage<unsigned int, dftfe::utils::MemorySpace::DEVICE>
       d_sphericalFnIdsParallelNumberingMapDevice;
     dftfe::utils::MemoryStorage<int, dftfe::utils::MemorySpace::DEVICE>
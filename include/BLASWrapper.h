@@ -588,6 +588,9 @@ namespace dftfe
            const dftfe::size_type size);
 
     private:
+      /// threads over which the batched GEMMs distribute the batch, set from
+      /// DFTFE_NUM_THREADS
+      unsigned int d_nOMPThreads;
     };
 #if defined(DFTFE_WITH_DEVICE)
     enum class tensorOpDataType
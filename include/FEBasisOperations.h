@@ -701,6 +701,61 @@ namespace dftfe
       unsigned int
       cellsTypeFlag() const;
 
+      /**
+       * @brief computes the one dimensional data of the tensor product basis
+       * used by the sum-factorized operator applications, the 1D shape
+       * function values at the 1D quadrature points and optionally the
+       * collocation derivative matrix on the 1D quadrature points. The FE has
+       * to be a scalar tensor product Lagrange element and the quadrature a
+       * tensor product quadrature, which is checked against the three
+       * dimensional shape function values. The data is stored on the host.
+       * @param[in] quadratureID quadrature index in the MatrixFree object
+       * @param[in] computeCollocationGradients also compute the collocation
+       * derivative matrix, requires at least as many 1D quadrature points as
+       * 1D dofs for the gradients to be exact
+       */
+      void
+      computeTensorProductShapeData(const unsigned int quadratureID,
+                                    const bool computeCollocationGradients);
+
+      /**
+       * @brief number of 1D dofs of the tensor product basis
+       */
+      unsigned int
+      nDofsPerCell1D() const;
+
+      /**
+       * @brief number of 1D quadrature points of the tensor product quadrature
+       * @param[in] quadratureID quadrature index in the MatrixFree object
+       */
+      unsigned int
+      nQuadsPerCell1D(const unsigned int quadratureID) const;
+
+      /**
+       * @brief 1D shape function values at the 1D quadrature points indexed
+       * by [iQuad * nDofsPerCell1D + iNode].
+       * @param[in] quadratureID quadrature index in the MatrixFree object
+       */
+      const std::vector<ValueTypeBasisData> &
+      tensorProductShapeValues1D(const unsigned int quadratureID) const;
+
+      /**
+       * @brief derivatives of the 1D Lagrange polynomials on the 1D
+       * quadrature points at the 1D quadrature points, indexed by [iQuad *
+       * nQuadsPerCell1D + jQuad].
+       * @param[in] quadratureID quadrature index in the MatrixFree object
+       */
+      const std::vector<ValueTypeBasisData> &
+      tensorProductCollocationGradients1D(
+        const unsigned int quadratureID) const;
+
+      /**
+       * @brief cell dof index of each lexicographically numbered (x fastest)
+       * dof of the tensor product basis.
+       */
+      const std::vector<unsigned int> &
+      lexicographicToCellDofNumbering() const;
+
       /**
        * @brief returns the deal.ii cellID corresponing to given cell Index.
        * @param[in] iElem cell Index
@@ -932,6 +987,13 @@ namespace dftfe
       bool                      areAllCellsCartesian;
       std::vector<UpdateFlags>  d_updateFlags;
 
+      std::map<unsigned int, std::vector<ValueTypeBasisData>>
+        d_tensorProductShapeValues1D;
+      std::map<unsigned int, std::vector<ValueTypeBasisData>>
+        d_tensorProductCollocationGradients1D;
+      std::vector<unsigned int> d_lexicographicToCellDofNumbering;
+      unsigned int              d_nDofsPerCell1D;
+
       std::shared_ptr<const utils::mpi::MPIPatternP2P<memorySpace>>
         mpiPatternP2P;
 
@@ -0,0 +1,158 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2017-2022 The Regents of the University of Michigan and DFT-FE
+// authors.
+//
+// This file is part of the DFT-FE code.
+//
+// The DFT-FE code is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the DFT-FE distribution.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dftfeHostMemoryPool_h
+#define dftfeHostMemoryPool_h
+
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace dftfe
+{
+  namespace utils
+  {
+    /**
+     * @brief Process wide pool of aligned host memory blocks, used by
+     * MemoryManager<ValueType, MemorySpace::HOST> once enabled.
+     *
+     * Requests are rounded up to size classes (four classes per power of two)
+     * and released blocks are kept on free lists per size class and NUMA node,
+     * so that the temporaries created and destroyed inside the SCF loop are
+     * recycled instead of going back to the system allocator. Blocks are 64
+     * byte aligned; blocks of at least 2 MB are aligned to 2 MB and advised
+     * for transparent huge pages. The pages of a new block are first touched
+     * by the allocating thread, which places them on its NUMA node, and a
+     * released block is only reused by threads running on the same node.
+     *
+     * Every allocation is attributed to the tag active on the calling thread
+     * (see ScopedTag), and the current and high-water bytes are recorded per
+     * tag.
+     */
+    class HostMemoryPool
+    {
+    public:
+      struct TagStatistics
+      {
+        std::size_t currentBytes   = 0;
+        std::size_t highWaterBytes = 0;
+        std::size_t numAllocations = 0;
+      };
+
+      /**
+       * @brief sets the tag of the allocations of the calling thread for the
+       * lifetime of the object
+       */
+      class ScopedTag
+      {
+      public:
+        explicit ScopedTag(const char *tag);
+        ~ScopedTag();
+
+        ScopedTag(const ScopedTag &) = delete;
+        ScopedTag &
+        operator=(const ScopedTag &) = delete;
+
+      private:
+        const char *d_previousTag;
+      };
+
+      /// the pool, never destroyed so that it outlives all static objects
+      static HostMemoryPool &
+      instance();
+
+      void
+      setEnabled(const bool enabled);
+
+      bool
+      isEnabled() const;
+
+      /**
+       * @brief maximum bytes kept on the free lists, released blocks beyond
+       * this are returned to the system
+       */
+      void
+      setMaxCachedBytes(const std::size_t maxCachedBytes);
+
+      /**
+       * @brief returns a block of at least size bytes, nullptr if size is zero
+       */
+      void *
+      allocate(const std::size_t size);
+
+      /**
+       * @brief returns the block to the pool. Returns false if ptr was not
+       * allocated by the pool, in which case nothing is done.
+       */
+      bool
+      deallocate(void *ptr);
+
+      /// returns all the blocks on the free lists to the system
+      void
+      releaseFreeBlocks();
+
+      std::map<std::string, TagStatistics>
+      getTagStatistics() const;
+
+      /// bytes held by live blocks including the size class padding
+      std::size_t
+      getLiveBytes() const;
+
+      std::size_t
+      getHighWaterBytes() const;
+
+      std::size_t
+      getCachedBytes() const;
+
+    private:
+      struct BlockInfo
+      {
+        std::size_t    classSize;
+        unsigned int   numaNode;
+        TagStatistics *tagStatistics;
+        std::size_t    requestedSize;
+      };
+
+      HostMemoryPool();
+
+      static std::size_t
+      getSizeClass(const std::size_t size);
+
+      static unsigned int
+      getCurrentNumaNode();
+
+      mutable std::mutex d_mutex;
+      std::atomic<bool>  d_isEnabled;
+      std::atomic<bool>  d_hasAllocated;
+      std::size_t        d_maxCachedBytes;
+      std::size_t        d_cachedBytes;
+      std::size_t        d_liveBytes;
+      std::size_t        d_highWaterBytes;
+      // free blocks for each numa node and size class
+      std::vector<std::unordered_map<std::size_t, std::vector<void *>>>
+                                                d_freeBlocks;
+      std::unordered_map<void *, BlockInfo>     d_liveBlocks;
+      std::map<std::string, TagStatistics>      d_tagStatistics;
+    };
+  } // namespace utils
+
+} // namespace dftfe
+
+#endif
@@ -153,6 +153,18 @@ namespace dftfe
     computeCellHamiltonianMatrix(
       const bool onlyHPrimePartForFirstOrderDensityMatResponse = false);
 
+    /**
+     * @brief Computes the cell Hamiltonian matrices of all the k-points of
+     * the pool for the given spin index from the k-point independent part
+     * (SHARED KPOINT HAMILTONIAN). The k-point dependent terms of all the
+     * k-points are added in one matrix multiplication per block of cells
+     * with the k-points as columns. This only replaces the assembly, the
+     * cell Hamiltonian matrices of all the k-points are stored and applied in
+     * HX as before. Only available with MEM OPT MODE set to false.
+     */
+    void
+    computeCellHamiltonianMatrixBatchedkPoints(const unsigned int spinIndex);
+
     void
     computeCellHamiltonianMatrixExtPotContribution();
 
@@ -206,6 +218,16 @@ namespace dftfe
       const bool onlyHPrimePartForFirstOrderDensityMatResponse = false);
 
   private:
+    /**
+     * @brief Partitions the blocks of cells used in HX into colours such that
+     * no two blocks of the same colour share a degree of freedom. The cell
+     * blocks of a colour can then be assembled concurrently by the host
+     * threads without atomics, and the summation order into each dof is fixed
+     * by the colour order which keeps the result deterministic.
+     */
+    void
+    computeCellBlockColoring();
+
     std::shared_ptr<
       AtomicCenteredNonLocalOperator<dataTypes::number, memorySpace>>
       d_ONCVnonLocalOperator;
@@ -236,6 +258,13 @@ namespace dftfe
       d_cellHamiltonianMatrix;
     std::vector<dftfe::utils::MemoryStorage<dataTypes::numberFP32, memorySpace>>
       d_cellHamiltonianMatrixSinglePrec;
+    // real Bz blocks of the noncollinear cell Hamiltonian matrices if they
+    // are stored as spin blocks
+    std::vector<dftfe::utils::MemoryStorage<double, memorySpace>>
+      d_cellHamiltonianMatrixBZNonCollin;
+    std::vector<dftfe::utils::MemoryStorage<float, memorySpace>>
+      d_cellHamiltonianMatrixBZNonCollinSinglePrec;
+    bool d_isNonCollinSpinBlockHamiltonian;
     dftfe::utils::MemoryStorage<double, memorySpace>
       d_cellHamiltonianMatrixExtPot;
 
@@ -285,6 +314,153 @@ namespace dftfe
     dftfe::utils::MemoryStorage<double, memorySpace>
       tempHamMatrixBZBlockNonCollin;
 
+    // SHARED KPOINT HAMILTONIAN: k-point independent part of the cell
+    // Hamiltonian matrices for the current effective potential, cell
+    // matrices of the k-point coupling term for the unit vectors along x, y
+    // and z stored one after the other, and the real and imaginary parts of
+    // a block of cells for all the k-points being assembled
+    bool d_isSharedKPointHamiltonian;
+    bool d_isKPointIndependentHamiltonianComputed;
+    dftfe::utils::MemoryStorage<double, memorySpace>
+      d_cellHamiltonianMatrixKPointIndependent;
+    dftfe::utils::MemoryStorage<double, memorySpace>
+      d_cellNjGradNiMatrixKPointDirections;
+    dftfe::utils::MemoryStorage<double, memorySpace>
+      d_tempHamMatrixRealBlockKPoints;
+    dftfe::utils::MemoryStorage<double, memorySpace>
+      d_tempHamMatrixImagBlockKPoints;
+
+    /**
+     * @brief real block of the cell Hamiltonian matrices of the cells in
+     * cellRange without the k-point dependent terms, and the magnetic field
+     * blocks for noncollinear spin
+     */
+    void
+    computeCellHamiltonianMatrixRealBlockCellRange(
+      const std::pair<unsigned int, unsigned int> cellRange,
+      const bool onlyHPrimePartForFirstOrderDensityMatResponse,
+      dftfe::utils::MemoryStorage<double, memorySpace> &tempRealBlock,
+      dftfe::utils::MemoryStorage<double, memorySpace> &tempBZBlock,
+      dftfe::utils::MemoryStorage<double, memorySpace> &tempBYBlock,
+      dftfe::utils::MemoryStorage<double, memorySpace> &tempBXBlock);
+
+    /**
+     * @brief computes the k-point independent part of the cell Hamiltonian
+     * matrices for the current effective potential if it is not up to date
+     */
+    void
+    computeCellHamiltonianMatrixKPointIndependent();
+
+    /**
+     * @brief H(k)=H_0+0.5|k|^2 M+i sum_d k_d G_d for the given k-points, where
+     * H_0 is the k-point independent part, M the cell mass matrix and G_d the
+     * cell matrices of the k-point coupling term for the unit vector along d
+     */
+    void
+    assembleCellHamiltonianMatricesKPoints(
+      const std::vector<unsigned int> &kPointIndices,
+      const std::vector<unsigned int> &hamiltonianIndices);
+
+    /**
+     * @brief adds the contributions of the cells in cellRange to the cell
+     * Hamiltonian matrix hamiltonianIndex of the k-point kPointIndex, using
+     * the given scratch blocks.
+     */
+    void
+    computeCellHamiltonianMatrixCellRange(
+      const std::pair<unsigned int, unsigned int> cellRange,
+      const unsigned int                          kPointIndex,
+      const unsigned int                          hamiltonianIndex,
+      const bool onlyHPrimePartForFirstOrderDensityMatResponse,
+      dftfe::utils::MemoryStorage<double, memorySpace> &tempRealBlock,
+      dftfe::utils::MemoryStorage<double, memorySpace> &tempImagBlock,
+      dftfe::utils::MemoryStorage<double, memorySpace> &tempBZBlock,
+      dftfe::utils::MemoryStorage<double, memorySpace> &tempBYBlock,
+      dftfe::utils::MemoryStorage<double, memorySpace> &tempBXBlock);
+
+    /**
+     * @brief dst=scalarHX*H_cell*src on the cells of cellRange for the
+     * noncollinear cell Hamiltonian stored as spin blocks: the spin diagonal
+     * complex block is applied to both spinor components at once, the real Bz
+     * block with opposite signs on the up and down components and the
+     * symmetric Bx+iBy block and its conjugate couple the components.
+     *
+     * @param cellHamiltonianMatrix spin diagonal blocks of all the cells
+     * followed by the Bx+iBy blocks of all the cells
+     * @param cellHamiltonianMatrixBZ Bz blocks of all the cells
+     * @param src,dst cell level wavefunction blocks of the first cell of cellRange
+     */
+    template <typename ValueType, typename RealType>
+    void
+    applyNonCollinearSpinBlockHamiltonian(
+      const std::pair<unsigned int, unsigned int> cellRange,
+      const unsigned int                          numberWavefunctions,
+      const RealType                              scalarHX,
+      const ValueType *                           cellHamiltonianMatrix,
+      const RealType *                            cellHamiltonianMatrixBZ,
+      const ValueType *                           src,
+      ValueType *                                 dst);
+
+    /**
+     * @brief sets up the data of the sum-factorized matrix-free application
+     * of the local part of the Hamiltonian (MATRIX FREE HAMILTONIAN), the 1D
+     * tensor product shape data of the density and local pseudopotential
+     * quadratures, the geometric factors of the kinetic term at the density
+     * quadrature points and the per thread scratch. Host only.
+     */
+    void
+    initMatrixFreeHamiltonian();
+
+    /**
+     * @brief selects the terms of the matrix-free local Hamiltonian. This
+     * replaces the construction of the cell Hamiltonian matrices if MATRIX
+     * FREE HAMILTONIAN is set, the quadrature point coefficients of the
+     * current k-point and spin index are used directly in the application.
+     */
+    void
+    computeMatrixFreeHamiltonianQuadData(
+      const bool onlyHPrimePartForFirstOrderDensityMatResponse);
+
+    /**
+     * @brief dst=scalar*H_loc*src on the cell iCell by sum factorization:
+     * the values and reference gradients at the quadrature points are
+     * obtained with 1D contractions along each direction, multiplied with
+     * the quadrature point coefficients and integrated back with the
+     * transposed 1D contractions. src and dst are cell level wavefunction
+     * blocks in the layout of d_cellWaveFunctionMatrixSrc.
+     *
+     * @param numberWavefunctions number of wavefunctions per spinor component
+     */
+    void
+    applyMatrixFreeHamiltonianCell(const unsigned int       iCell,
+                                   const unsigned int       numberWavefunctions,
+                                   const double             scalar,
+                                   const dataTypes::number *src,
+                                   dataTypes::number *      dst);
+
+    // 0.5*J^{-1}J^{-T}*JxW at the density quadrature points of each cell
+    std::vector<double> d_matrixFreeStiffnessWeights;
+    // JxW at the density quadrature points of each cell
+    std::vector<double> d_matrixFreeJxW;
+    // false if only the H' part is applied
+    bool d_matrixFreeIncludeKineticAndExtPot;
+    // number of wavefunctions per spinor component processed at once
+    unsigned int d_matrixFreeVectorsChunkSize;
+    // per thread scratch of the matrix-free cell application
+    std::vector<
+      dftfe::utils::MemoryStorage<double, dftfe::utils::MemorySpace::HOST>>
+      d_matrixFreeScratchThreads;
+
+    // per thread scratch of the exchange-correlation evaluation in
+    // computeVEff, sized for a chunk of cells
+    struct xcEvaluationScratch
+    {
+      std::vector<double> densityValue, gradDensityValue, sigmaValue,
+        exchangePotentialVal, corrPotentialVal, derExchEnergyWithSigmaVal,
+        derCorrEnergyWithSigmaVal, magAxis, veffGGA;
+    };
+    std::vector<xcEvaluationScratch> d_xcScratchThreads;
+
     const unsigned int         d_densityQuadratureID;
     const unsigned int         d_lpspQuadratureID;
     const unsigned int         d_feOrderPlusOneQuadratureID;
@@ -302,6 +478,9 @@ namespace dftfe
     unsigned int               d_nOMPThreads;
     dealii::ConditionalOStream pcout;
 
+    // starting cell index of the cell blocks in HX grouped by colour
+    std::vector<std::vector<unsigned int>> d_cellBlockColors;
+
     // compute-time logger
     dealii::TimerOutput computing_timer;
   };
@@ -28,6 +28,9 @@
 #include <MemoryStorage.h>
 #include <DataTypeOverloads.h>
 #include <dftfeDataTypes.h>
+#include <map>
+#include <tuple>
+#include <vector>
 #ifdef DFTFE_WITH_DEVICE
 #  include <DeviceTypeConfig.h>
 #  if defined(DFTFE_WITH_CUDA_NCCL)
@@ -57,6 +60,31 @@ namespace dftfe
         full
       };
 
+      /**
+       * @brief Mode in which the MPI messages of the host and device-aware MPI
+       * protocols are issued. nonBlocking posts fresh MPI_Irecv/MPI_Isend
+       * calls in every exchange, persistent starts MPI_Recv_init/MPI_Send_init
+       * requests created once for the fixed communication pattern and buffers,
+       * and neighborhoodCollective issues a single MPI_Ineighbor_alltoallv on
+       * a distributed graph communicator built from the pattern.
+       */
+      enum class communicationMode
+      {
+        nonBlocking,
+        persistent,
+        neighborhoodCollective
+      };
+
+      /**
+       * @brief sets the communication mode of the MPICommunicatorP2P objects
+       * created afterwards
+       */
+      void
+      setDefaultCommunicationMode(const communicationMode mode);
+
+      communicationMode
+      getDefaultCommunicationMode();
+
 
       template <typename ValueType, MemorySpace memorySpace>
       class MPICommunicatorP2P
@@ -66,6 +94,13 @@ namespace dftfe
           std::shared_ptr<const MPIPatternP2P<memorySpace>> mpiPatternP2P,
           const size_type                                   blockSize);
 
+        MPICommunicatorP2P(const MPICommunicatorP2P &) = delete;
+
+        MPICommunicatorP2P &
+        operator=(const MPICommunicatorP2P &) = delete;
+
+        ~MPICommunicatorP2P();
+
         void
         updateGhostValues(MemoryStorage<ValueType, memorySpace> &dataArray,
                           const size_type communicationChannel = 0);
@@ -101,7 +136,64 @@ namespace dftfe
         void
         setCommunicationPrecision(communicationPrecision precision);
 
+        /**
+         * @brief sets the communication mode. Must be called on all the
+         * processors of the communicator, as the neighborhood collectives and
+         * their graph communicator are collective.
+         */
+        void
+        setCommunicationMode(communicationMode mode);
+
       private:
+        /**
+         * @brief persistent requests of one tag and direction bound to one
+         * buffer
+         */
+        struct persistentRequests
+        {
+          const void *             buffer        = nullptr;
+          size_type                bytesPerIndex = 0;
+          std::vector<MPI_Request> requests;
+        };
+
+        /**
+         * @brief posts the receives from (isSend=false) or the sends to
+         * (isSend=true) the ghost processors (isGhostProcs=true) or the target
+         * processors (isGhostProcs=false), whose data is laid out contiguously
+         * starting at buffer, either with fresh non-blocking calls or by
+         * starting the persistent requests cached for the tag and buffer. The
+         * started requests are written to requests.
+         */
+        template <typename T>
+        void
+        startMessages(T *           buffer,
+                      const bool    isGhostProcs,
+                      const bool    isSend,
+                      const int     tag,
+                      MPI_Request * requests);
+
+        /**
+         * @brief non-blocking neighborhood all-to-all exchange of the update
+         * ghost values (isUpdateGhostValues=true) or the accumulate add
+         * locally owned (isUpdateGhostValues=false) communication
+         */
+        template <typename T>
+        void
+        startNeighborhoodAlltoallv(const T *       sendBuffer,
+                                   T *             recvBuffer,
+                                   const bool      isUpdateGhostValues,
+                                   const size_type communicationChannel);
+
+        /**
+         * @brief waits for the neighborhood exchanges started on all the
+         * communication channels of the given direction
+         */
+        void
+        waitNeighborhoodAlltoallv(const bool isUpdateGhostValues);
+
+        void
+        freePersistentRequests();
+
         std::shared_ptr<const MPIPatternP2P<memorySpace>> d_mpiPatternP2P;
 
         size_type d_blockSize;
@@ -151,11 +243,40 @@ namespace dftfe
         std::vector<MPI_Request> d_requestsUpdateGhostValues;
         std::vector<MPI_Request> d_requestsAccumulateAddLocallyOwned;
         MPI_Comm                 d_mpiCommunicator;
+
+        // persistent requests keyed by (tag, isGhostProcs, isSend), so that
+        // alternating communication channels reuse their requests, for each
+        // key the requests of the most recently used buffers, least recently
+        // used first
+        std::map<std::tuple<int, bool, bool>, std::vector<persistentRequests>>
+          d_persistentRequests;
+
+        // distributed graph communicators with the ghost processors as
+        // sources and the target processors as destinations and the reverse,
+        // created on the first neighborhood collective exchange
+        MPI_Comm d_neighborhoodCommUpdateGhostValues;
+        MPI_Comm d_neighborhoodCommAccumulateAddLocallyOwned;
+
+        // counts and displacements in number of indices of the ghost and the
+        // target processors, computed with the graph communicators. They are
+        // members since MPI_Ineighbor_alltoallv reads them until the exchange
+        // completes.
+        std::vector<int> d_neighborhoodGhostCounts;
+        std::vector<int> d_neighborhoodGhostDisplacements;
+        std::vector<int> d_neighborhoodTargetCounts;
+        std::vector<int> d_neighborhoodTargetDisplacements;
+
+        // outstanding neighborhood exchanges keyed by communication channel
+        std::map<size_type, MPI_Request>
+          d_requestsNeighborhoodUpdateGhostValues;
+        std::map<size_type, MPI_Request>
+          d_requestsNeighborhoodAccumulateAddLocallyOwned;
 #ifdef DFTFE_WITH_DEVICE
         dftfe::utils::deviceStream_t d_deviceCommStream;
 #endif
         communicationProtocol  d_commProtocol;
         communicationPrecision d_commPrecision;
+        communicationMode      d_commMode;
       };
 
     } // namespace mpi
@@ -35,6 +35,53 @@ namespace dftfe
       writeData(const std::vector<CompositeData *> &data,
                 const std::string &                 fileName,
                 const MPI_Comm &                    mpiComm);
+
+      /**
+       * @brief collective binary write of fixed size records to a file. The
+       * record with global id i is stored at the byte offset
+       * header.size()+i*recordSize, so the file layout does not depend on
+       * the number of processes. The header is written by the root process.
+       *
+       * @param[in] header bytes written at the beginning of the file
+       * @param[in] data contiguous local records, in the order of recordIds
+       * @param[in] recordIds global ids of the local records, sorted in
+       * increasing order
+       * @param[in] recordSize size of one record in bytes
+       */
+      static void
+      writeBinaryRecords(const std::vector<char> &         header,
+                         const char *                      data,
+                         const std::vector<unsigned long> &recordIds,
+                         const unsigned long               recordSize,
+                         const std::string &               fileName,
+                         const MPI_Comm &                  mpiComm);
+
+      /**
+       * @brief collective read of the header written by writeBinaryRecords.
+       * header must be sized to the number of bytes to be read.
+       */
+      static void
+      readBinaryHeader(std::vector<char> & header,
+                       const std::string &fileName,
+                       const MPI_Comm &   mpiComm);
+
+      /**
+       * @brief collective binary read of fixed size records written by
+       * writeBinaryRecords, possibly with a different number of processes.
+       *
+       * @param[in] headerSize size of the header in bytes
+       * @param[in] recordIds global ids of the records to be read, sorted in
+       * increasing order
+       * @param[in] recordSize size of one record in bytes
+       * @param[out] data contiguous local records, in the order of recordIds
+       */
+      static void
+      readBinaryRecords(const unsigned long               headerSize,
+                        const std::vector<unsigned long> &recordIds,
+                        const unsigned long               recordSize,
+                        char *                            data,
+                        const std::string &               fileName,
+                        const MPI_Comm &                  mpiComm);
     };
   } // namespace dftUtils
 } // namespace dftfe
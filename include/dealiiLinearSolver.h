@@ -66,6 +66,28 @@ namespace dftfe
           const int                  debugLevel     = 0,
           bool                       distributeFlag = true);
 
+    /**
+     * @brief Solve several independent linear systems, A_i*x_i=Rhs_i, with a
+     * block preconditioned CG. The iterations of all the systems are
+     * advanced together and the inner products of all the active systems are
+     * reduced in a single MPI_Allreduce per iteration (Chronopoulos-Gear
+     * formulation). Converged systems drop out of the active set, and
+     * systems whose initial guess already satisfies the tolerance are not
+     * iterated.
+     *
+     * @param problems vector of linearSolverProblem objects (functors) to compute Rhs and A*x, and preconditioning
+     * @param absTolerance Tolerance (absolute) required for convergence.
+     * @param maxNumberIterations Maximum number of iterations.
+     * @param debugLevel Debug output level
+     * @param distributeFlag distribute x to the constrained nodes after the solve
+     */
+    void
+    solveBlock(const std::vector<dealiiLinearSolverProblem *> &problems,
+               const double                                    absTolerance,
+               const unsigned int maxNumberIterations,
+               const int          debugLevel     = 0,
+               bool               distributeFlag = true);
+
   private:
     /// enum denoting the choice of the dealii solver
     const solverType d_type;
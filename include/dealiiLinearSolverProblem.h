@@ -67,6 +67,16 @@ namespace dftfe
                         const distributedCPUVec<double> &src,
                         const double                     omega) const = 0;
 
+    /**
+     * @brief preconditioner application used by the dealiiLinearSolver CG
+     * iterations. Defaults to the Jacobi preconditioner.
+     *
+     */
+    virtual void
+    precondition(distributedCPUVec<double> &      dst,
+                 const distributedCPUVec<double> &src,
+                 const double                     omega) const;
+
     /**
      * @brief distribute x to the constrained nodes.
      *
@@ -54,7 +54,8 @@ namespace dftfe
     const MPI_Comm &     interpoolcomm,
     const MPI_Comm &     interBandGroupComm,
     const dftParameters &dftParams,
-    const bool           spectrumSplit);
+    const bool           spectrumSplit,
+    const unsigned int   nOMPThreads);
 
   template <typename NumberType>
   void
@@ -77,7 +78,8 @@ namespace dftfe
     double *                                    gradRho,
     const bool                                  isEvaluateGradRho,
     const bool                                  isNonCollin,
-    const bool                                  hasSOC);
+    const bool                                  hasSOC,
+    const unsigned int                          nOMPThreads);
 
 #if defined(DFTFE_WITH_DEVICE)
   template <typename NumberType>
@@ -102,7 +104,8 @@ namespace dftfe
     double *                                    gradRho,
     const bool                                  isEvaluateGradRho,
     const bool                                  isNonCollin,
-    const bool                                  hasSOC);
+    const bool                                  hasSOC,
+    const unsigned int                          nOMPThreads);
 #endif
 
 } // namespace dftfe
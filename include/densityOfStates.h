@@ -0,0 +1,81 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2017-2022  The Regents of the University of Michigan and DFT-FE
+// authors.
+//
+// This file is part of the DFT-FE code.
+//
+// The DFT-FE code is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the DFT-FE distribution.
+//
+// ---------------------------------------------------------------------
+
+#ifndef DFTFE_DENSITYOFSTATES_H
+#define DFTFE_DENSITYOFSTATES_H
+
+#include <headers.h>
+#include <BLASWrapper.h>
+
+namespace dftfe
+{
+  /**
+   *  @brief Contains the functions used by the LDOS and PDOS computations of
+   *  dftClass
+   */
+  namespace internal
+  {
+    /**
+     * @brief Lorentzian smearing of a block of states onto the energy grid,
+     * indexed by [iState * numberIntervals + epsInt] and scaled by the given
+     * factor
+     */
+    void
+    computeSmearingKernel(const double *       eigenValues,
+                          const unsigned int   numStates,
+                          const double         lowerBoundEpsilon,
+                          const double         intervalSize,
+                          const unsigned int   numberIntervals,
+                          const double         sigma,
+                          const double         scalingFactor,
+                          std::vector<double> &smearingKernel);
+
+    /**
+     * @brief |psi|^2 of a block of states summed over the spinor components.
+     * The values are indexed by [iRow * numWfnSpinors * blockSize + iSpinor *
+     * blockSize + iWave] and normSquared by [iRow * blockSize + iWave]
+     */
+    void
+    computeSpinorNormSquared(const dataTypes::number *values,
+                             const unsigned int       numRows,
+                             const unsigned int       numWfnSpinors,
+                             const unsigned int       blockSize,
+                             double *                 normSquared);
+
+    /**
+     * @brief adds the smeared density of states of a block of states to each
+     * region, densityOfStates[iRegion * numberIntervals + epsInt] += sum over
+     * iState of the smearing kernel times stateWeights[iRegion * numStates +
+     * iState], computed as one GEMM
+     */
+    void
+    accumulateSmearedDensityOfStates(
+      const dftfe::linearAlgebra::BLASWrapper<dftfe::utils::MemorySpace::HOST>
+        &                  BLASWrapper,
+      const double *       eigenValues,
+      const unsigned int   numStates,
+      const double         lowerBoundEpsilon,
+      const double         intervalSize,
+      const unsigned int   numberIntervals,
+      const double         sigma,
+      const double         scalingFactor,
+      const double *       stateWeights,
+      const unsigned int   numRegions,
+      std::vector<double> &smearingKernel,
+      double *             densityOfStates);
+  } // namespace internal
+} // namespace dftfe
+#endif
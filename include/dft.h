@@ -296,6 +296,19 @@ namespace dftfe
     virtual void
     resetRhoNodalSplitIn(distributedCPUVec<double> &OutDensity);
 
+    /**
+     * @brief ASPC extrapolation of the wavefunctions to the next molecular
+     * dynamics time step. The converged wavefunctions of the last solve are
+     * rotated to the gauge of the stored history (orthogonal Procrustes),
+     * mixed with the previous prediction (corrector) and added to the
+     * history, from which the initial guess of the next solve is predicted.
+     */
+    unsigned int
+    extrapolateWaveFunctions();
+
+    unsigned int
+    getNumberChebyshevFilterPassesLastSolve() const;
+
     /**
      * @brief Number of Kohn-Sham eigen values to be computed
      */
@@ -506,6 +519,19 @@ namespace dftfe
     void
     loadTriaInfoAndRhoNodalData();
 
+    /**
+     *@brief save wavefunctions of all k-points and spins, eigenvalues and Fermi energy to checkpoint files for restarts.
+     * The files are written with MPI-IO in a layout independent of the number of MPI tasks
+     */
+    void
+    saveWaveFunctionsAndEigenData();
+
+    /**
+     *@brief load wavefunctions, eigenvalues and Fermi energy from checkpoint files written by saveWaveFunctionsAndEigenData
+     */
+    void
+    loadWaveFunctionsAndEigenData();
+
     void
     generateMPGrid();
     void
@@ -1292,6 +1318,11 @@ namespace dftfe
     std::shared_ptr<dftfe::oncvClass<dataTypes::number, memorySpace>>
       d_oncvClassPtr;
 
+    /// parsed pseudopotential data for each atomic number
+    std::map<unsigned int,
+             std::shared_ptr<const pseudoUtils::pseudoPotentialData>>
+      d_pseudoPotentialData;
+
 
     std::shared_ptr<
 #if defined(DFTFE_WITH_DEVICE)
@@ -1336,6 +1367,11 @@ namespace dftfe
     poissonSolverProblem<FEOrder, FEOrderElectro> d_phiTotalSolverProblem;
 
     poissonSolverProblem<FEOrder, FEOrderElectro> d_phiPrimeSolverProblem;
+
+    /// p-multigrid preconditioners for the CPU total electrostatic potential
+    /// and vself solves, only created if PRECONDITIONER is MULTIGRID
+    std::shared_ptr<poissonMultigridPreconditioner>
+      d_phiTotalMGPreconditionerPtr, d_vselfMGPreconditionerPtr;
 #ifdef DFTFE_WITH_DEVICE
     poissonSolverProblemDevice<FEOrder, FEOrderElectro>
       d_phiTotalSolverProblemDevice;
@@ -1636,6 +1672,19 @@ namespace dftfe
 
     bool d_isRestartGroundStateCalcFromChk;
 
+    /// total Chebyshev filtering passes over all scf iterations of the last
+    /// ground-state solve
+    unsigned int d_numberChebyshevFilterPassesLastSolve;
+
+    /**
+     * @brief ASPC wavefunction extrapolation data, the history of the
+     * corrected wavefunctions of the previous time steps (latest first) in a
+     * common gauge, and the prediction for the current time step. Both follow
+     * the indexing of d_eigenVectorsFlattenedHost.
+     */
+    std::vector<std::vector<dataTypes::number>> d_wfcExtrapolationHistory;
+    std::vector<dataTypes::number>              d_wfcExtrapolationPrediction;
+
     /**
      * @ nscf variables
      */
@@ -103,6 +103,26 @@ namespace dftfe
     virtual void
     resetRhoNodalSplitIn(distributedCPUVec<double> &OutDensity) = 0;
 
+    /**
+     * @brief Adds the ground-state wavefunctions of the last solve to the
+     * extrapolation history, and once the history is complete replaces them
+     * by their extrapolation to the next time step of a molecular dynamics
+     * run, to be used as the initial guess of the next solve
+     *
+     * @return number of time steps in the history, which is reset on
+     * remeshing. The extrapolation is done once it reaches WAVEFUNCTION
+     * EXTRAPOLATION ORDER+2.
+     */
+    virtual unsigned int
+    extrapolateWaveFunctions() = 0;
+
+    /**
+     * @brief Gets the total number of Chebyshev filtering passes over all the
+     * scf iterations of the last ground-state solve
+     */
+    virtual unsigned int
+    getNumberChebyshevFilterPassesLastSolve() const = 0;
+
     /**
      * @brief Gets the current atom Locations in cartesian form
      * (origin at center of domain) from dftClass
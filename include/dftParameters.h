@@ -41,15 +41,17 @@ namespace dftfe
     unsigned int chebyshevOrder, numPass, numSCFIterations,
       maxLinearSolverIterations, mixingHistory, npool,
       numberWaveFunctionsForEstimate, numLevels,
-      maxLinearSolverIterationsHelmholtz;
+      maxLinearSolverIterationsHelmholtz, vselfBlockSolveSize;
 
     bool        poissonGPU;
     bool        vselfGPU;
+    std::string poissonPreconditioner;
     std::string modelXCInputFile;
 
     double radiusAtomBall, mixingParameter, inverseKerkerMixingParameter,
       spinMixingEnhancementFactor;
     bool   adaptAndersonMixingParameter;
+    bool   incrementalMixingGramMatrix;
     bool   diagonalMassMatrix;
     double absLinearSolverTolerance, selfConsistentSolverTolerance, TVal,
       selfConsistentSolverEnergyTolerance, start_magnetization,
@@ -85,7 +87,8 @@ namespace dftfe
     double meshSizeInnerBall, meshSizeOuterBall;
     double chebyshevTolerance, topfrac, kerkerParameter, restaScreeningLength,
       restaFermiWavevector;
-    std::string optimizationMode, mixingMethod, ionOptSolver, cellOptSolver;
+    std::string optimizationMode, mixingMethod, mixingHistoryScheme,
+      ionOptSolver, cellOptSolver;
 
 
     bool         isIonForce, isCellStress, isBOMD;
@@ -98,6 +101,8 @@ namespace dftfe
     bool        keepScratchFolder;
     bool        saveRhoData;
     bool        loadRhoData;
+    bool        saveWfcData;
+    bool        loadWfcData;
     bool        restartSpinFromNoSpin;
 
     bool reproducible_output;
@@ -115,6 +120,7 @@ namespace dftfe
     unsigned int wfcBlockSize;
     unsigned int chebyWfcBlockSize;
     unsigned int subspaceRotDofsBlockSize;
+    unsigned int cellsBlockSizeDensityHost;
     unsigned int nbandGrps;
     bool         computeEnergyEverySCF;
     bool         useEnergyResidualTolerance;
@@ -125,6 +131,7 @@ namespace dftfe
     bool         reuseWfcGeoOpt;
     unsigned int reuseDensityGeoOpt;
     double       mpiAllReduceMessageBlockSizeMB;
+    std::string  mpiP2PCommunicationMode;
     bool         useSubspaceProjectedSHEPGPU;
     bool         useMixedPrecCGS_SR;
     bool         useMixedPrecCGS_O;
@@ -141,15 +148,19 @@ namespace dftfe
     bool         deviceFineGrainedTimings;
     bool         allowFullCPUMemSubspaceRot;
     bool         useSinglePrecCommunCheby;
+    bool         useSinglePrecCommunChebyHost;
     bool         useSinglePrecCheby;
     bool         usepCoarsenedSolve;
     bool         overlapComputeCommunCheby;
+    bool         overlapComputeCommunChebyHost;
     bool         overlapComputeCommunOrthoRR;
     bool         autoDeviceBlockSizes;
     bool         readWfcForPdosPspFile;
     double       maxJacobianRatioFactorForMD;
     double       chebyshevFilterPolyDegreeFirstScfScalingFactor;
     int          extrapolateDensity;
+    bool         extrapolateWfc;
+    unsigned int wfcExtrapolationOrder;
     double       timeStepBOMD;
     unsigned int numberStepsBOMD;
     unsigned int TotalImages;
@@ -176,6 +187,11 @@ namespace dftfe
     unsigned int highestStateOfInterestForChebFiltering;
     bool         useELPADeviceKernel;
     bool         memOptMode;
+    bool         matrixFreeHamiltonian;
+    bool         sharedKPointHamiltonian;
+    bool         noncolinSpinBlockHamiltonian;
+    bool         useHostMemoryPool;
+    unsigned int hostMemoryPoolCacheSizeMB;
     bool         noncolin;
     bool         hasSOC;
 
@@ -212,6 +212,33 @@ namespace dftfe
                   const std::vector<double> &b,
                   std::vector<double> &      crossProductVector);
 
+    /** @brief Density and magnetization magnitude, and their gradients, of a
+     * noncollinear density in the local spin frame, stored as the two
+     * components used by the spin polarized exchange-correlation terms.
+     *
+     *  @param  isGGA whether the gradients are needed
+     *  @param  rhoValues rho, mz, my and mx at the quadrature points
+     *  @param  gradRhoValues gradients of rhoValues, used only for GGA
+     *  @param  rhoLocalFrameValues rho and |m|
+     *  @param  gradRhoLocalFrameValues gradients of rho and |m|, set only for
+     * GGA
+     */
+    void
+    computeLocalFrameSpinDensity(
+      const bool isGGA,
+      const std::vector<
+        dftfe::utils::MemoryStorage<double, dftfe::utils::MemorySpace::HOST>>
+        &rhoValues,
+      const std::vector<
+        dftfe::utils::MemoryStorage<double, dftfe::utils::MemorySpace::HOST>>
+        &gradRhoValues,
+      std::vector<
+        dftfe::utils::MemoryStorage<double, dftfe::utils::MemorySpace::HOST>>
+        &rhoLocalFrameValues,
+      std::vector<
+        dftfe::utils::MemoryStorage<double, dftfe::utils::MemorySpace::HOST>>
+        &gradRhoLocalFrameValues);
+
 
     /** @brief Applies an affine transformation to the domain bounding vectors
      *
@@ -272,6 +299,15 @@ namespace dftfe
     void
     printCurrentMemoryUsage(const MPI_Comm &mpiComm, const std::string message);
 
+    /** @brief prints the high-water marks of the host memory pool, the total
+     * as maximum across mpiComm and per allocation tag for task 0
+     *
+     *  @[in]param mpiComm  mpi communicator across which the printing
+     * will be synchronized
+     */
+    void
+    printHostMemoryPoolStatistics(const MPI_Comm &mpiComm);
+
     /**
      * A class to split the given communicator into a number of pools
      */
@@ -667,6 +667,53 @@ namespace dftfe
       const double                                           b,
       const double                                           a0);
 
+    /** @brief Apply Chebyshev filter to two given subspaces simultaneously.
+     *  The ghost communication of one subspace is overlapped with the cell
+     *  level compute of the other.
+     *
+     *  @param[in] operatorMatrix An object which has access to the given matrix
+     *  @param[in,out]  X1 first subspace, in-place update
+     *  @param[in,out]  Y1 scratch multivector of the size of X1
+     *  @param[in,out]  X2 second subspace, in-place update
+     *  @param[in,out]  Y2 scratch multivector of the size of X2
+     *  @param[in]  m Chebyshev polynomial degree
+     *  @param[in]  a lower bound of unwanted spectrum
+     *  @param[in]  b upper bound of unwanted spectrum
+     *  @param[in]  a0 lower bound of wanted spectrum
+     */
+    template <typename T, dftfe::utils::MemorySpace memorySpace>
+    void
+    chebyshevFilterOverlapComputeCommunication(
+      operatorDFTClass<memorySpace> &                    operatorMatrix,
+      dftfe::linearAlgebra::MultiVector<T, memorySpace> &X1,
+      dftfe::linearAlgebra::MultiVector<T, memorySpace> &Y1,
+      dftfe::linearAlgebra::MultiVector<T, memorySpace> &X2,
+      dftfe::linearAlgebra::MultiVector<T, memorySpace> &Y2,
+      const unsigned int                                 m,
+      const double                                       a,
+      const double                                       b,
+      const double                                       a0);
+
+    template <typename T, typename TFP32, dftfe::utils::MemorySpace memorySpace>
+    void
+    chebyshevFilterOverlapComputeCommunicationSinglePrec(
+      const std::shared_ptr<dftfe::linearAlgebra::BLASWrapper<memorySpace>>
+        &                                                    BLASWrapperPtr,
+      operatorDFTClass<memorySpace> &                        operatorMatrix,
+      dftfe::linearAlgebra::MultiVector<T, memorySpace> &    X1,
+      dftfe::linearAlgebra::MultiVector<T, memorySpace> &    Y1,
+      dftfe::linearAlgebra::MultiVector<T, memorySpace> &    X2,
+      dftfe::linearAlgebra::MultiVector<T, memorySpace> &    Y2,
+      dftfe::linearAlgebra::MultiVector<TFP32, memorySpace> &X1_SP,
+      dftfe::linearAlgebra::MultiVector<TFP32, memorySpace> &Y1_SP,
+      dftfe::linearAlgebra::MultiVector<TFP32, memorySpace> &X2_SP,
+      dftfe::linearAlgebra::MultiVector<TFP32, memorySpace> &Y2_SP,
+      std::vector<double>                                    eigenvalues,
+      const unsigned int                                     m,
+      const double                                           a,
+      const double                                           b,
+      const double                                           a0);
+
 
     /** @brief Orthogonalize given subspace using GramSchmidt orthogonalization
      *
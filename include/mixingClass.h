@@ -46,14 +46,29 @@ namespace dftfe
    * This class takes can take different input variables as input in a
    * std::vector format and computes the mixing coefficients These coefficients
    * can then be used to compute the new variable at the start of the SCF.
+   * All the histories are kept in host memory, also in device builds, since
+   * the densities written by computeRhoFromPSI and read by computeVEff are
+   * host data.
    * @author Vishal Subramanian
    */
   class MixingScheme
   {
   public:
+    /**
+     * @brief Constructor
+     *
+     * @param useIncrementalGramMatrix keep the Gram matrix of the residual
+     * history across SCF iterations, only the inner products of the latest
+     * residual are computed
+     * @param useModifiedBroyden compute the mixing coefficients with the
+     * modified Broyden scheme of Johnson [PRB 38, 12807 (1988)] instead of the
+     * Anderson scheme, which always uses the incremental Gram matrix
+     */
     MixingScheme(const MPI_Comm &   mpi_comm_parent,
                  const MPI_Comm &   mpi_comm_domain,
-                 const unsigned int verbosity);
+                 const unsigned int verbosity,
+                 const bool         useIncrementalGramMatrix = false,
+                 const bool         useModifiedBroyden       = false);
 
     unsigned int
     lengthOfHistory();
@@ -166,6 +181,16 @@ namespace dftfe
       std::vector<double> &A,
       std::vector<double> &c);
 
+    /**
+     * @brief Adds the rows of the history entries not yet present to the Gram
+     * matrix of the residual history, G_ij = sum over the mixing variables of
+     * the weighted dot products of residuals i and j. The contributions of all
+     * the variables are reduced by a single MPI_Allreduce.
+     */
+    void
+    updateResidualGramMatrix(
+      const std::vector<mixingVariable> &mixingVariablesList);
+
     std::vector<double> d_A, d_c;
     double              d_cFinal;
 
@@ -191,6 +216,13 @@ namespace dftfe
     unsigned int                     d_mixingHistory;
     std::map<mixingVariable, bool>   d_performMixing;
     const int                        d_verbosity;
+    const bool                       d_useIncrementalGramMatrix;
+    const bool                       d_useModifiedBroyden;
+
+    /// lower triangle of the Gram matrix of the residual history, row i
+    /// stores G_ij for j<=i with the oldest history entry first
+    std::deque<std::vector<double>> d_residualGramMatrix;
+    std::vector<mixingVariable>     d_residualGramMatrixVariables;
 
 
     /// conditional stream object
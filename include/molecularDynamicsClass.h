@@ -97,6 +97,13 @@ namespace dftfe
     distributedCPUVec<double> d_extrapDensity_tmin2, d_extrapDensity_tmin1,
       d_extrapDensity_t0, d_extrapDensity_tp1;
 
+    // statistics of the Chebyshev filtering passes with wavefunction
+    // extrapolation, the baseline being the steps reusing the wavefunctions of
+    // the previous step as they are
+    bool         d_wfcExtrapolatedForNextStep;
+    unsigned int d_baselineFilterPasses, d_baselineSteps;
+    unsigned int d_extrapolatedFilterPasses, d_extrapolatedSteps;
+
 
     /**
      * @brief mdNVE Performs a Ccanonical Ensemble MD calculation. The inital temperature is set by runMD().
@@ -460,6 +467,14 @@ namespace dftfe
     void
     DensitySplitExtrapolation(int TimeStep);
 
+    /**
+     * @brief  WaveFunctionExtrapolation extrapolates the ground-state wavefunctions to the next time step (ASPC) and prints
+     * the number of Chebyshev filtering passes saved by the extrapolation
+     *
+     */
+    void
+    WaveFunctionExtrapolation();
+
 
     /**
      * @brief  set() initalises all the private datamembers of mdclass object from the parameters declared by user.
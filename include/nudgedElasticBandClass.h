@@ -44,6 +44,12 @@ namespace dftfe
      * Third, creates the array of pointers of dftClass for each image.
      * If in restart mode, calls function to read coordinates and initialise
      * parameters Sets solvermode: CGPT, LBFGS, BFGS
+     *
+     * The MPI tasks of mpi_comm_parent are split into numberImageGroups
+     * groups of equal size, and the images are distributed round robin over
+     * the groups. Each group only creates the dftClass objects of its own
+     * images and solves them on its own communicator, concurrently with the
+     * other groups.
      */
 
     nudgedElasticBandClass(const std::string  parameter_file,
@@ -65,9 +71,10 @@ namespace dftfe
                            const std::string &optimizationSolver,
                            const std::string &coordinatesFileNEB,
                            const std::string &domainVectorsFileNEB,
-                           const std::string &ionRelaxFlagsFile);
+                           const std::string &ionRelaxFlagsFile,
+                           const unsigned int numberImageGroups = 1);
 
-    //~nudgedElasticBandClass();
+    ~nudgedElasticBandClass();
 
     double d_kmax = 0.1; // 0.1 Ha/bohr
     double d_kmin = 0.1; // 0.1Ha/bohr
@@ -140,6 +147,8 @@ namespace dftfe
     getUnknownCountFlag() const;
 
   private:
+    // only the images owned by the image group of this task are created, the
+    // others are nullptr
     std::vector<std::unique_ptr<dftfeWrapper>> d_dftfeWrapper;
     dftBase *                                  d_dftPtr;
     std::unique_ptr<nonLinearSolver>           d_nonLinearSolverPtr;
@@ -147,6 +156,18 @@ namespace dftfe
     const MPI_Comm d_mpiCommParent;
     // const unsigned int n_mpi_processes;
     const unsigned int d_this_mpi_process;
+    // communicator of the image group of this task
+    MPI_Comm     d_imageGroupComm;
+    unsigned int d_numberImageGroups;
+    unsigned int d_imageGroupSize;
+    unsigned int d_imageGroupId;
+
+    // free energies, electronic entropic energies, atom positions and forces
+    // of all the images, kept up to date on all the image groups
+    std::vector<double>                           d_imageFreeEnergy;
+    std::vector<double>                           d_imageEntropicEnergy;
+    std::vector<std::vector<std::vector<double>>> d_imageAtomPositionsCart;
+    std::vector<std::vector<std::vector<double>>> d_imageForces;
 
     // conditional stream object
     dealii::ConditionalOStream pcout;
@@ -186,6 +207,42 @@ namespace dftfe
     const MPI_Comm &
     getMPICommunicator();
 
+    /**
+     * @brief Returns the id of the image group which owns the image.
+     */
+    unsigned int
+    getImageGroupId(const unsigned int image) const;
+
+    /**
+     * @brief Solves the ground state of the given images, each on the image
+     * group owning it. The images are solved in rounds, with every group
+     * solving its next image in each round, and the energies, forces and
+     * positions of the images solved in a round are broadcast to all the
+     * groups at the end of the round. With a single image group this solves
+     * the images one after another in the given order.
+     *
+     * @param[in] images images to be solved in increasing order
+     * @param[in] atomsDisplacements displacements applied to the atoms of an
+     * image before solving it, images not in the map are not moved
+     * @param[in] computeImageErrors if true, the image errors of the images
+     * solved in a round are updated at the end of the round
+     */
+    void
+    solveImages(
+      const std::vector<unsigned int> &images,
+      const std::map<unsigned int, std::vector<std::vector<double>>>
+        &        atomsDisplacements,
+      const bool computeImageErrors);
+
+    /**
+     * @brief Broadcasts the free energy, electronic entropic energy, atom
+     * positions and forces of the image from the image group owning it to all
+     * the image groups.
+     */
+    void
+    exchangeImageData(const unsigned int image,
+                      const bool         isGroundStateConverged);
+
     /**
      * @brief Calculate the tangent between each image
      */
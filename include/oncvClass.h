@@ -28,6 +28,7 @@
 #include "AtomCenteredSphericalFunctionProjectorSpline.h"
 #include "AtomCenteredSphericalFunctionContainer.h"
 #include "AtomicCenteredNonLocalOperator.h"
+#include <pseudoPotentialData.h>
 #include <memory>
 #include <MemorySpaceType.h>
 #include <headers.h>
@@ -48,8 +49,11 @@ namespace dftfe
   class oncvClass
   {
   public:
-    oncvClass(const MPI_Comm &              mpi_comm_parent,
-              const std::string &           scratchFolderName,
+    oncvClass(const MPI_Comm &mpi_comm_parent,
+              const std::map<unsigned int,
+                             std::shared_ptr<
+                               const pseudoUtils::pseudoPotentialData>>
+                &                           pseudoPotentialData,
               const std::set<unsigned int> &atomTypes,
               const bool                    floatingNuclearCharges,
               const unsigned int            nOMPThreads,
@@ -303,12 +307,15 @@ namespace dftfe
     std::vector<std::vector<double>> d_atomLocations;
     std::set<unsigned int>           d_atomTypes;
     std::map<unsigned int, std::vector<unsigned int>> d_atomTypesList;
-    std::string                                       d_dftfeScratchFolderName;
     std::vector<int>                                  d_imageIds;
     std::vector<std::vector<double>>                  d_imagePositions;
     unsigned int                                      d_numEigenValues;
     unsigned int                                      d_nOMPThreads;
 
+    std::map<unsigned int,
+             std::shared_ptr<const pseudoUtils::pseudoPotentialData>>
+      d_pseudoPotentialData;
+
     // Creating Object for Atom Centerd Nonlocal Operator
     std::shared_ptr<AtomicCenteredNonLocalOperator<ValueType, memorySpace>>
       d_nonLocalOperator;
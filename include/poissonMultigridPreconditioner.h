@@ -0,0 +1,304 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2017-2022  The Regents of the University of Michigan and DFT-FE
+// authors.
+//
+// This file is part of the DFT-FE code.
+//
+// The DFT-FE code is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the DFT-FE distribution.
+//
+// ---------------------------------------------------------------------
+//
+
+
+#ifndef poissonMultigridPreconditioner_H_
+#define poissonMultigridPreconditioner_H_
+
+#include <headers.h>
+#include <dftParameters.h>
+#include <deal.II/lac/diagonal_matrix.h>
+#include <deal.II/multigrid/mg_coarse.h>
+#include <deal.II/multigrid/mg_matrix.h>
+#include <deal.II/multigrid/mg_smoother.h>
+#include <deal.II/multigrid/mg_transfer_global_coarsening.h>
+#include <deal.II/multigrid/multigrid.h>
+
+namespace dftfe
+{
+  /**
+   * @brief Matrix-free action of the Poisson operator (1/4pi) grad.grad on
+   * one level of the p-multigrid hierarchy. Constrained dofs are treated as
+   * identity rows so that the level operator is invertible.
+   */
+  class poissonMGLevelOperator : public dealii::Subscriptor
+  {
+  public:
+    /**
+     * @brief attach the MatrixFree object, dofHandler index and quadrature
+     * index the operator acts on.
+     */
+    void
+    reinit(const dealii::MatrixFree<3, double> &matrixFreeData,
+           const unsigned int                   dofHandlerIndex,
+           const unsigned int                   quadratureIndex);
+
+    /**
+     * @brief compute the inverse of the diagonal of the operator. Constrained
+     * dofs get a unit diagonal.
+     */
+    void
+    computeInverseDiagonal(
+      const dealii::AffineConstraints<double> &constraintMatrix,
+      distributedCPUVec<double> &              inverseDiagonal) const;
+
+    /// initialize vector with the partitioner of the operator
+    void
+    initialize_dof_vector(distributedCPUVec<double> &vec) const;
+
+    /// global number of rows, needed by dealii
+    dealii::types::global_dof_index
+    m() const;
+
+    /// global number of columns, needed by dealii
+    dealii::types::global_dof_index
+    n() const;
+
+    void
+    vmult(distributedCPUVec<double> &      dst,
+          const distributedCPUVec<double> &src) const;
+
+    void
+    Tvmult(distributedCPUVec<double> &      dst,
+           const distributedCPUVec<double> &src) const;
+
+    void
+    vmult_add(distributedCPUVec<double> &      dst,
+              const distributedCPUVec<double> &src) const;
+
+    void
+    Tvmult_add(distributedCPUVec<double> &      dst,
+               const distributedCPUVec<double> &src) const;
+
+  private:
+    /**
+     * @brief required for the cell_loop operation in dealii's MatrixFree class
+     *
+     */
+    void
+    AX(const dealii::MatrixFree<3, double> &        matrixFreeData,
+       distributedCPUVec<double> &                  dst,
+       const distributedCPUVec<double> &            src,
+       const std::pair<unsigned int, unsigned int> &cell_range) const;
+
+    /// add src to dst on the constrained dofs (identity rows)
+    void
+    addConstrainedDofs(distributedCPUVec<double> &      dst,
+                       const distributedCPUVec<double> &src) const;
+
+    const dealii::MatrixFree<3, double> *d_matrixFreeDataPtr = nullptr;
+    unsigned int                         d_dofHandlerIndex   = 0;
+    unsigned int                         d_quadratureIndex   = 0;
+  };
+
+  /**
+   * @brief Matrix-free p-multigrid preconditioner for the Poisson problems
+   * (total electrostatic potential and vself solves). The hierarchy coarsens
+   * the polynomial order of the electrostatics FE space down to linear
+   * elements on the same triangulation. Each level is smoothed by a Chebyshev
+   * iteration preconditioned with the inverse diagonal, and the linear level
+   * is solved approximately with a higher degree Chebyshev iteration. The
+   * finest level reuses the MatrixFree object of the outer CG solve.
+   *
+   * Usage: initializeLevels() once per mesh (creates the coarse dofHandlers
+   * with hanging node and periodic constraints), reinit() before the solves
+   * of a fine problem (adds the Dirichlet dofs of the fine problem to the
+   * coarse levels), then vmult() as the preconditioner application. The
+   * hierarchy set up by reinit() is cached until the next initializeLevels()
+   * call, so that calling reinit() again for the same fine problem, e.g. for
+   * the total electrostatic potential in every SCF or the same vself bin in
+   * every ionic step without remeshing, only selects the cached hierarchy.
+   */
+  class poissonMultigridPreconditioner
+  {
+  public:
+    /// Constructor
+    poissonMultigridPreconditioner(const MPI_Comm &mpi_comm);
+
+    /**
+     * @brief create the coarse level dofHandlers and their hanging node and
+     * periodic constraints.
+     *
+     * @param[in] fineDofHandler electrostatics dofHandler (FEOrderElectro)
+     * @param[in] fineHangingPeriodicConstraints hanging node and periodic
+     * constraints of fineDofHandler. The constrained dofs of a fine problem
+     * which are not constrained here are its Dirichlet dofs.
+     * @param[in] domainBoundingVectors domain bounding vectors used for the
+     * periodic face matching
+     * @param[in] dftParams dftParameters object
+     */
+    void
+    initializeLevels(
+      const dealii::DoFHandler<3> &            fineDofHandler,
+      const dealii::AffineConstraints<double> &fineHangingPeriodicConstraints,
+      const std::vector<std::vector<double>> & domainBoundingVectors,
+      const dftParameters &                    dftParams);
+
+    /**
+     * @brief set up the level operators, smoothers and transfers for the
+     * fine problem defined by the MatrixFree object and the constraints, or
+     * select the cached ones if they were set up for the same fine problem.
+     *
+     * @param[in] matrixFreeData MatrixFree object of the fine problem
+     * @param[in] dofHandlerIndex MatrixFree dofHandler index of the fine
+     * problem
+     * @param[in] quadratureIndex MatrixFree quadrature index used for A*x
+     * @param[in] constraintMatrix constraints of the fine problem. The dofs
+     * constrained here but not by the hanging node and periodic constraints
+     * passed to initializeLevels are the Dirichlet dofs, and are transferred
+     * to the vertex, edge and face dofs of the coarse levels.
+     */
+    void
+    reinit(const dealii::MatrixFree<3, double> &    matrixFreeData,
+           const unsigned int                       dofHandlerIndex,
+           const unsigned int                       quadratureIndex,
+           const dealii::AffineConstraints<double> &constraintMatrix);
+
+    /**
+     * @brief apply one multigrid V-cycle, dst=P^{-1}*src
+     */
+    void
+    vmult(distributedCPUVec<double> &      dst,
+          const distributedCPUVec<double> &src) const;
+
+    /// true if reinit has been called after the last initializeLevels
+    bool
+    isInitialized() const;
+
+  private:
+    typedef dealii::PreconditionChebyshev<
+      poissonMGLevelOperator,
+      distributedCPUVec<double>,
+      dealii::DiagonalMatrix<distributedCPUVec<double>>>
+      smootherType;
+
+    /**
+     * @brief level data and multigrid objects set up for one fine problem.
+     * The multigrid objects hold subscriptions to the level objects and are
+     * declared after them, so that they are released first.
+     */
+    struct multigridHierarchy
+    {
+      /// MatrixFree object and indices of the fine problem
+      const dealii::MatrixFree<3, double> *matrixFreeDataPtr;
+      unsigned int                         dofHandlerIndex;
+      unsigned int                         quadratureIndex;
+
+      /// sorted locally relevant Dirichlet dofs of the fine problem
+      std::vector<dealii::types::global_dof_index> fineDirichletDofs;
+
+      /// hanging node, periodic and Dirichlet constraints of all levels
+      dealii::MGLevelObject<dealii::AffineConstraints<double>> levelConstraints;
+
+      /// MatrixFree objects of the coarse levels
+      dealii::MGLevelObject<dealii::MatrixFree<3, double>> levelMatrixFreeData;
+
+      dealii::MGLevelObject<poissonMGLevelOperator> levelOperators;
+
+      dealii::MGLevelObject<
+        dealii::MGTwoLevelTransfer<3, distributedCPUVec<double>>>
+        levelTransfers;
+
+      std::unique_ptr<
+        dealii::MGTransferGlobalCoarsening<3, distributedCPUVec<double>>>
+        transferPtr;
+
+      std::unique_ptr<dealii::mg::Matrix<distributedCPUVec<double>>>
+        mgMatrixPtr;
+
+      std::unique_ptr<
+        dealii::MGSmootherPrecondition<poissonMGLevelOperator,
+                                       smootherType,
+                                       distributedCPUVec<double>>>
+        mgSmootherPtr;
+
+      std::unique_ptr<
+        dealii::MGCoarseGridApplySmoother<distributedCPUVec<double>>>
+        mgCoarsePtr;
+
+      std::unique_ptr<dealii::Multigrid<distributedCPUVec<double>>> mgPtr;
+
+      std::unique_ptr<
+        dealii::PreconditionMG<
+          3,
+          distributedCPUVec<double>,
+          dealii::MGTransferGlobalCoarsening<3, distributedCPUVec<double>>>>
+        preconditionerPtr;
+    };
+
+    /**
+     * @brief set up the level data and multigrid objects of hierarchy for its
+     * fine problem
+     */
+    void
+    setupHierarchy(const dealii::AffineConstraints<double> &constraintMatrix,
+                   multigridHierarchy &                     hierarchy) const;
+
+    /**
+     * @brief create Dirichlet constraints on a coarse level from the fine
+     * constraints
+     */
+    void
+    createLevelDirichletConstraints(
+      const std::vector<dealii::types::global_dof_index> &fineDirichletDofs,
+      const unsigned int                                  level,
+      dealii::AffineConstraints<double> &levelDirichletConstraints) const;
+
+    /**
+     * @brief release the cached hierarchies, which depend on the fine
+     * problems
+     */
+    void
+    clearMultigridData();
+
+    /// polynomial degrees of the levels, level 0 is linear
+    std::vector<unsigned int> d_levelDegrees;
+
+    /// dofHandlers of the coarse levels (finest level uses the fine problem
+    /// dofHandler)
+    dealii::MGLevelObject<dealii::DoFHandler<3>> d_levelDofHandlers;
+
+    /// hanging node and periodic constraints of the coarse levels
+    dealii::MGLevelObject<dealii::AffineConstraints<double>>
+      d_levelHangingPeriodicConstraints;
+
+    /// hierarchies set up since the last initializeLevels, one per fine
+    /// problem
+    std::vector<std::unique_ptr<multigridHierarchy>> d_hierarchies;
+
+    /// hierarchy used by vmult
+    const multigridHierarchy *d_activeHierarchyPtr;
+
+    /// fine dofHandler the levels were created for
+    const dealii::DoFHandler<3> *d_fineDofHandlerPtr;
+
+    /// hanging node and periodic constraints of the fine dofHandler
+    const dealii::AffineConstraints<double>
+      *d_fineHangingPeriodicConstraintsPtr;
+
+    bool d_constraintsParallelCheck;
+
+    int d_verbosity;
+
+    const MPI_Comm             mpi_communicator;
+    const unsigned int         n_mpi_processes;
+    const unsigned int         this_mpi_process;
+    dealii::ConditionalOStream pcout;
+  };
+
+} // namespace dftfe
+#endif // poissonMultigridPreconditioner_H_
@@ -21,6 +21,7 @@
 
 #include <dealiiLinearSolverProblem.h>
 #include <constraintMatrixInfo.h>
+#include <poissonMultigridPreconditioner.h>
 #include "FEBasisOperations.h"
 
 namespace dftfe
@@ -116,6 +117,28 @@ namespace dftfe
                         const distributedCPUVec<double> &src,
                         const double                     omega) const;
 
+    /**
+     * @brief Preconditioner application: multigrid V-cycle if a multigrid
+     * preconditioner is set, Jacobi otherwise.
+     *
+     */
+    void
+    precondition(distributedCPUVec<double> &      dst,
+                 const distributedCPUVec<double> &src,
+                 const double                     omega) const;
+
+    /**
+     * @brief set the multigrid preconditioner to be used in place of Jacobi.
+     * The preconditioner is set up in reinit whenever the diagonal of A is
+     * computed. The pointer is kept across clear(). Pass a nullptr to switch
+     * back to Jacobi preconditioning.
+     *
+     */
+    void
+    setMultigridPreconditioner(
+      const std::shared_ptr<poissonMultigridPreconditioner>
+        &mgPreconditionerPtr);
+
     /**
      * @brief distribute x to the constrained nodes.
      *
@@ -197,6 +220,9 @@ namespace dftfe
     /// storage for diagonal of the A matrix
     distributedCPUVec<double> d_diagonalA;
 
+    /// multigrid preconditioner, Jacobi preconditioning is used if not set
+    std::shared_ptr<poissonMultigridPreconditioner> d_mgPreconditionerPtr;
+
     /// storage for smeared charge rhs in case of total potential solve (doesn't
     /// change every scf)
     distributedCPUVec<double> d_rhsSmearedCharge;
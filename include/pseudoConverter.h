@@ -18,6 +18,9 @@
 
 #ifndef converter_h
 #define converter_h
+#include <pseudoPotentialData.h>
+#include <map>
+#include <memory>
 #include <string>
 
 #include "string.h"
@@ -28,11 +31,13 @@ namespace dftfe
   //
 
   /**
-   *  @brief wrapper to convert pseudopotential file from upf to dftfe format and returns the nonlinear core correction
+   *  @brief wrapper to read the pseudopotential files in upf format and returns the nonlinear core correction
    *  flag
    *
    *  The functionality reads a file containing list of pseudopotential files in
-   * upf format and converts into into dftfe format -via- xml file format
+   * upf format and parses them in memory, the parsed data is shared with the
+   * earlier setups in the same process if the files did not change. Has to be
+   * called by all the processors of mpiComm.
    *
    *  @author Phani Motamarri
    */
@@ -41,10 +46,12 @@ namespace dftfe
   {
     std::vector<int>
     convert(const std::string &file,
-            const std::string &dftfeScratchFolderName,
+            const MPI_Comm &   mpiComm,
             const int          verbosity,
             const unsigned     natomTypes,
-            const bool         pseudoTestsFlag);
+            const bool         pseudoTestsFlag,
+            std::map<unsigned int, std::shared_ptr<const pseudoPotentialData>>
+              &pseudoPotentialDataMap);
   }
 } // namespace dftfe
 #endif
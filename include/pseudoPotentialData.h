@@ -0,0 +1,107 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2017-2022 The Regents of the University of Michigan and DFT-FE
+// authors.
+//
+// This file is part of the DFT-FE code.
+//
+// The DFT-FE code is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the DFT-FE distribution.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dftfePseudoPotentialData_h
+#define dftfePseudoPotentialData_h
+
+#include <mpi.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace dftfe
+{
+  namespace pseudoUtils
+  {
+    /**
+     * @brief Radial data of a pseudopotential in upf format, in the units and
+     * layout used to build the atom centered spherical functions.
+     *
+     * The tables hold one row per radial grid point with the radial
+     * coordinate in the first column, same as the rows read from the dftfe
+     * format files written by the upf converter.
+     */
+    struct pseudoPotentialData
+    {
+      std::string fileName;
+      bool        hasNLCC;
+      bool        hasSOC;
+      bool        isPAW;
+
+      /// one row per projector (index, l, [j,] m), the radial projector index
+      /// counts the radial projectors in the order of radialProjectors
+      std::vector<std::vector<double>> projectorIds;
+
+      /// radial projectors grouped by l in increasing order, rows of
+      /// (r, beta_1(r)/r, beta_2(r)/r, ...)
+      std::vector<std::pair<unsigned int, std::vector<std::vector<double>>>>
+        radialProjectors;
+
+      /// PP_DIJ in Hartree, in the order of the radial projectors
+      std::vector<std::vector<double>> couplingMatrix;
+
+      /// rows of (r, V_loc(r)) in Hartree
+      std::vector<std::vector<double>> localPotential;
+
+      /// rows of (r, rho(r)), the spherically averaged valence density
+      std::vector<std::vector<double>> valenceDensity;
+
+      /// rows of (r, rho_core(r)), empty without nonlinear core correction
+      std::vector<std::vector<double>> coreDensity;
+
+      /// single atom wavefunctions keyed by (n, l), rows of (r, chi(r))
+      std::map<std::pair<unsigned int, unsigned int>,
+               std::vector<std::vector<double>>>
+        orbitals;
+    };
+
+    /**
+     * @brief reads a file on the root of mpiComm and broadcasts its contents
+     * to all the processors of mpiComm
+     * @param[in] fileName name of the file
+     * @param[in] mpiComm communicator
+     * @param[out] contents contents of the file
+     * @return false on all the processors if the file could not be read
+     */
+    bool
+    readAndBroadcastFile(const std::string &fileName,
+                         const MPI_Comm &   mpiComm,
+                         std::string &      contents);
+
+    /**
+     * @brief parses a pseudopotential file in upf format from its contents
+     * @param[in] fileName name of the file, used in the error messages
+     * @param[in] contents contents of the upf file
+     */
+    std::shared_ptr<const pseudoPotentialData>
+    parseUPF(const std::string &fileName, const std::string &contents);
+
+    /**
+     * @brief returns the parsed data of a upf file. The file is read on the
+     * root of mpiComm and broadcast, so this has to be called by all the
+     * processors of mpiComm. The parsed data is cached for the lifetime of
+     * the process keyed on the file path and a hash of its contents, so
+     * repeated setups (multiple dftfeWrapper instances, reinit) only read
+     * the file again and skip the parsing.
+     */
+    std::shared_ptr<const pseudoPotentialData>
+    getPseudoPotentialData(const std::string &fileName,
+                           const MPI_Comm &   mpiComm);
+  } // namespace pseudoUtils
+} // namespace dftfe
+#endif
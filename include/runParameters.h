@@ -39,6 +39,7 @@ namespace dftfe
     bool        restart;
     std::string restartFilesPath;
     int         numberOfImages;
+    int         numberImageGroups;
     bool        imageFreeze;
     double      Kmax;
     double      Kmin;
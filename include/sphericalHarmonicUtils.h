@@ -54,6 +54,80 @@ namespace dftfe
       return;
     }
 
+    /**
+     * @brief real spherical harmonics of all (l,m), l<=lMax, at the cartesian
+     * point x (relative to the centre) in the same convention as
+     * getSphericalHarmonicVal. The associated Legendre functions are built
+     * from the Cartesian recurrence in z/r and (x+iy)/r, avoiding the
+     * acos/atan2 and the per (l,m) boost calls. The value of (l,m) is stored
+     * at sphericalHarmonicVals[l*l+l+m], so the array is of size (lMax+1)^2.
+     */
+    inline void
+    getSphericalHarmonicValsAllLm(const double *x,
+                                  const int     lMax,
+                                  double *      sphericalHarmonicVals)
+    {
+      const double tolerance = 1e-12;
+      const double r = std::sqrt(x[0] * x[0] + x[1] * x[1] + x[2] * x[2]);
+
+      // cos(theta), sin(theta)cos(phi), sin(theta)sin(phi)
+      double cosTheta = 1.0, sinThetaCosPhi = 0.0, sinThetaSinPhi = 0.0;
+      if (r > tolerance)
+        {
+          cosTheta       = x[2] / r;
+          sinThetaCosPhi = x[0] / r;
+          sinThetaSinPhi = x[1] / r;
+        }
+
+      // sin^m(theta)cos(m phi) and sin^m(theta)sin(m phi)
+      double       cosMPhi = 1.0, sinMPhi = 0.0;
+      // P_m^m/sin^m(theta)=(-1)^m (2m-1)!!, Condon-Shortley phase included
+      double       pmm     = 1.0;
+      const double sqrt2   = std::sqrt(2.0);
+      for (int m = 0; m <= lMax; ++m)
+        {
+          if (m > 0)
+            {
+              const double temp =
+                cosMPhi * sinThetaCosPhi - sinMPhi * sinThetaSinPhi;
+              sinMPhi = cosMPhi * sinThetaSinPhi + sinMPhi * sinThetaCosPhi;
+              cosMPhi = temp;
+              pmm *= -(2.0 * m - 1.0);
+            }
+
+          double plmMinus1 = 0.0, plmMinus2 = 0.0;
+          // (l-m)!/(l+m)!
+          double factorialRatio = 1.0;
+          for (int k = 1; k <= 2 * m; ++k)
+            factorialRatio /= k;
+          for (int l = m; l <= lMax; ++l)
+            {
+              const double plm =
+                l == m ? pmm :
+                         ((2.0 * l - 1.0) * cosTheta * plmMinus1 -
+                          (l + m - 1.0) * plmMinus2) /
+                           (l - m);
+              plmMinus2 = plmMinus1;
+              plmMinus1 = plm;
+
+              if (l > m)
+                factorialRatio *= (double)(l - m) / (double)(l + m);
+              const double normalization =
+                std::sqrt((2.0 * l + 1.0) / (4.0 * M_PI) * factorialRatio);
+
+              if (m == 0)
+                sphericalHarmonicVals[l * l + l] = normalization * plm;
+              else
+                {
+                  sphericalHarmonicVals[l * l + l + m] =
+                    sqrt2 * normalization * plm * cosMPhi;
+                  sphericalHarmonicVals[l * l + l - m] =
+                    sqrt2 * normalization * plm * sinMPhi;
+                }
+            }
+        }
+    }
+
     inline void
     convertCartesianToSpherical(double *x,
                                 double &r,
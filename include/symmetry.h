@@ -79,6 +79,13 @@ namespace dftfe
      * @param [in] flag type of coordinate transformation, 1 takes crys. to cart. -1 takes cart. to crys.
      */
     dealii::Point<3> crys2cart(dealii::Point<3> p, int flag);
+    /**
+     * cartesian representation of a rotation given in crystal coordinates,
+     * i.e. the matrix mapping crys2cart(p,1) to crys2cart(rotation*p,1)
+     * @param [in] rotation 3x3 rotation matrix in crystal coordinates
+     */
+    std::vector<std::vector<double>>
+    crys2cartRotation(const std::vector<std::vector<double>> &rotation);
 
 
   private:
@@ -106,6 +113,18 @@ namespace dftfe
     double                                        translation[500][3];
     std::vector<std::vector<int>>                 symmUnderGroup;
     std::vector<int>                              numSymmUnderGroup;
+    /**
+     * Magnetic symmetry related data, an operation combined with time reversal
+     * flips the magnetization which otherwise transforms as an axial vector
+     * under the cartesian rotation
+     */
+    std::vector<int>                              timeReversedSymm;
+    std::vector<std::vector<std::vector<double>>> symmMatCart;
+    /**
+     * number of density components symmetrized, 1, 2 (spin up and down) or 4
+     * (rho, mz, my, mx) for noncollinear magnetism
+     */
+    unsigned int numDensityComponents;
     /**
      * Data members required for storing mapping tables locally
      */
@@ -131,9 +150,16 @@ namespace dftfe
                                                                mappedGroupRecvd1;
     std::vector<std::vector<std::vector<std::vector<int>>>>    send_buf_size;
     std::vector<std::vector<std::vector<std::vector<int>>>>    recv_buf_size;
-    std::vector<std::vector<std::vector<std::vector<double>>>> rhoRecvd,
-      gradRhoRecvd;
-    std::vector<std::vector<std::vector<std::vector<int>>>> groupOffsets;
+    std::vector<std::vector<std::vector<std::vector<int>>>>    groupOffsets;
+    /**
+     * Symmetrized density received back at the transformed points, flattened
+     * over the processors, locally owned cells and symmetries in the order of
+     * the mapping tables. rhoRecvdOffsets gives the first point for a
+     * (cell, symmetry, processor) triplet with index
+     * (iCell*numSymm+iSymm)*n_mpi_processes+proc
+     */
+    std::vector<double>       rhoRecvd, gradRhoRecvd;
+    std::vector<unsigned int> rhoRecvdOffsets;
     /**
      * Data sizes and offsets required for MPI scattering and gathering of
      * mapping tables and symmetrized density They have to be data members since
@@ -147,6 +173,8 @@ namespace dftfe
     std::vector<int> recvdData0, recvdData2, recvdData3;
     std::vector<std::vector<double>> recvdData1;
     std::vector<int>                 recv_size0, recv_size1, recvGrad_size1;
+    std::vector<int>                 recv_offsets, recvGrad_size,
+      recvGrad_offsets;
     //
   };
 } // namespace dftfe
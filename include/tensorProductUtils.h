@@ -0,0 +1,58 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2017-2022 The Regents of the University of Michigan and DFT-FE
+// authors.
+//
+// This file is part of the DFT-FE code.
+//
+// The DFT-FE code is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the DFT-FE distribution.
+//
+// ---------------------------------------------------------------------
+
+#ifndef DFTFE_TENSORPRODUCTUTILS_H
+#define DFTFE_TENSORPRODUCTUTILS_H
+
+#include <BLASWrapper.h>
+#include <array>
+
+namespace dftfe
+{
+  namespace tensorProductUtils
+  {
+    /**
+     * @brief contracts the tensor in, indexed by [i2][i1][i0][iInner] with
+     * extents {extents[2],extents[1],extents[0],nInner}, along the given
+     * direction with the row major matrixRows x matrixCols matrix (or its
+     * transpose), out=beta*out+matrix*in. Each contraction is a strided
+     * batched gemm over the slower directions.
+     *
+     * @param[in] BLASWrapper host BLAS wrapper
+     * @param[in] matrix row major 1D matrix, e.g. shape values indexed by
+     * [iQuad * nDofs1D + iNode]
+     * @param[in] transpose contract with the transpose of matrix
+     * @param[in] direction direction to contract, 0 is the fastest
+     * @param[in] extents extents of in along the three directions
+     * @param[in] nInner size of the innermost (vectors) index
+     */
+    void
+    contractTensorProductDirection(
+      const dftfe::linearAlgebra::BLASWrapper<dftfe::utils::MemorySpace::HOST>
+        &                                BLASWrapper,
+      const double *                     matrix,
+      const unsigned int                 matrixRows,
+      const unsigned int                 matrixCols,
+      const bool                         transpose,
+      const unsigned int                 direction,
+      const std::array<unsigned int, 3> &extents,
+      const unsigned int                 nInner,
+      const double *                     in,
+      const double                       beta,
+      double *                           out);
+  } // namespace tensorProductUtils
+} // namespace dftfe
+#endif // DFTFE_TENSORPRODUCTUTILS_H
@@ -19,6 +19,7 @@
 #include "constraintMatrixInfo.h"
 #include "dftParameters.h"
 #include "FEBasisOperations.h"
+#include "poissonMultigridPreconditioner.h"
 
 #ifndef vselfBinsManager_H_
 #  define vselfBinsManager_H_
@@ -284,6 +285,13 @@ namespace dftfe
     double
     getStoredAdaptiveBallRadius() const;
 
+    /// set multigrid preconditioner for the CPU vself solves in
+    /// solveVselfInBins. Jacobi preconditioning is used if not set.
+    void
+    setMultigridPreconditioner(
+      const std::shared_ptr<poissonMultigridPreconditioner>
+        &mgPreconditionerPtr);
+
 
   private:
     /**
@@ -364,6 +372,9 @@ namespace dftfe
     /// and reused for subsequent calls
     double d_storedAdaptiveBallRadius;
 
+    /// multigrid preconditioner for the CPU vself solves
+    std::shared_ptr<poissonMultigridPreconditioner> d_mgPreconditionerPtr;
+
     const dftParameters &d_dftParams;
 
     const MPI_Comm             d_mpiCommParent;
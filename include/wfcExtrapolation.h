@@ -0,0 +1,53 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2017-2022  The Regents of the University of Michigan and DFT-FE
+// authors.
+//
+// This file is part of the DFT-FE code.
+//
+// The DFT-FE code is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the DFT-FE distribution.
+//
+// ---------------------------------------------------------------------
+
+#ifndef DFTFE_WFCEXTRAPOLATION_H
+#define DFTFE_WFCEXTRAPOLATION_H
+
+#include <headers.h>
+
+namespace dftfe
+{
+  /**
+   *  @brief Contains the functions used by the ASPC wavefunction
+   *  extrapolation of dftClass
+   */
+  namespace internal
+  {
+    /**
+     * @brief predictor coefficients B_j, j=1,...,K+2 of the always stable
+     * predictor-corrector of order K (J. Kolafa, J. Comput. Chem. 25, 335
+     * (2004))
+     */
+    std::vector<double>
+    getASPCPredictorCoefficients(const unsigned int order);
+
+    /**
+     * @brief rotates X to the gauge of Y for each of the numBlocks k point and
+     * spin blocks, X <- X U with U the unitary polar factor of X^{H}Y. Each
+     * block stores the numRows locally owned rows of the N states row major,
+     * the rows of a block being distributed over mpiComm
+     */
+    void
+    alignWaveFunctionsProcrustes(dataTypes::number *      X,
+                                 const dataTypes::number *Y,
+                                 const unsigned int       numBlocks,
+                                 const unsigned int       numRows,
+                                 const unsigned int       N,
+                                 const MPI_Comm &         mpiComm);
+  } // namespace internal
+} // namespace dftfe
+#endif
@@ -20,6 +20,16 @@
 
 namespace dftfe
 {
+  void
+  AtomCenteredSphericalFunctionBase::getRadialValues(
+    const double *     r,
+    double *           values,
+    const unsigned int numPoints) const
+  {
+    for (unsigned int iPoint = 0; iPoint < numPoints; ++iPoint)
+      values[iPoint] = getRadialValue(r[iPoint]);
+  }
+
   unsigned int
   AtomCenteredSphericalFunctionBase::getQuantumNumberl() const
   {
@@ -16,6 +16,7 @@
 //
 
 #include "AtomCenteredSphericalFunctionContainer.h"
+#include <AtomSpatialIndex.h>
 
 namespace dftfe
 {
@@ -283,16 +284,13 @@ namespace dftfe
     d_AtomIdsInElement.clear();
     d_AtomIdsInElement.resize(numberElements);
 
-    for (int iCell = 0; iCell < numberElements; ++iCell)
+    // atoms are visited in increasing order, as are the atoms of each cell
+    for (int iAtom = 0; iAtom < d_AtomIdsInCurrentProcess.size(); iAtom++)
       {
-        for (int iAtom = 0; iAtom < d_AtomIdsInCurrentProcess.size(); iAtom++)
-          {
-            if (d_sparsityPattern[d_AtomIdsInCurrentProcess[iAtom]][iCell] >= 0)
-              {
-                d_AtomIdsInElement[iCell].push_back(
-                  d_AtomIdsInCurrentProcess[iAtom]);
-              }
-          }
+        const unsigned int atomId = d_AtomIdsInCurrentProcess[iAtom];
+        for (const unsigned int iCell :
+             d_elementIndexesInAtomCompactSupport[atomId])
+          d_AtomIdsInElement[iCell].push_back(atomId);
       }
   }
 
@@ -347,6 +345,128 @@ namespace dftfe
 
     std::vector<int> sparsityPattern(numberElements, -1);
 
+    //
+    // the radial functions of an atom vanish beyond their cutoff radius, so a
+    // cell can only be in the compact support of an atom (or one of its
+    // periodic images) within the cutoff radius of the cell. For
+    // cutOffType 0 this holds only for a positive cutOffVal.
+    //
+    const bool checkOnlyNearbyImages = cutOffType != 0 || cutOffVal > 0.0;
+
+    std::vector<double>       atomImagePoints;
+    std::vector<unsigned int> pointAtomIds, pointImageIds;
+    std::vector<double>       atomCutOffRadii(numberAtomsOfInterest, 0.0);
+    double                    maxCutOffRadius = 0.0;
+    for (int iAtom = 0; iAtom < numberAtomsOfInterest; ++iAtom)
+      {
+        const unsigned int Znum = d_atomicNumbers[iAtom];
+        if (cutOffType == 1)
+          atomCutOffRadii[iAtom] = cutOffVal;
+        else if (cutOffType == 0)
+          for (unsigned int iPsp = 0;
+               iPsp < d_numRadialSphericalFunctions[Znum];
+               ++iPsp)
+            {
+              const double radialCutOff =
+                d_sphericalFunctionsContainer[std::make_pair(Znum, iPsp)]
+                  ->getRadialCutOff();
+              if (std::isfinite(radialCutOff))
+                atomCutOffRadii[iAtom] =
+                  std::max(atomCutOffRadii[iAtom], radialCutOff);
+            }
+        maxCutOffRadius = std::max(maxCutOffRadius, atomCutOffRadii[iAtom]);
+
+        const unsigned int imageIdsSize =
+          d_periodicImageCoord[iAtom].size() / 3;
+        for (unsigned int iImageAtomCount = 0; iImageAtomCount < imageIdsSize;
+             ++iImageAtomCount)
+          {
+            for (unsigned int iDim = 0; iDim < 3; ++iDim)
+              atomImagePoints.push_back(
+                iImageAtomCount == 0 ?
+                  d_atomCoords[3 * iAtom + iDim] :
+                  d_periodicImageCoord[iAtom][3 * iImageAtomCount + iDim]);
+            pointAtomIds.push_back(iAtom);
+            pointImageIds.push_back(iImageAtomCount);
+          }
+      }
+
+    //
+    // candidate cells of each atom in increasing order, and for each of them
+    // the candidate images in increasing order
+    //
+    std::vector<std::vector<unsigned int>> candidateCells(
+      numberAtomsOfInterest);
+    std::vector<std::vector<unsigned int>> candidateImageOffsets(
+      numberAtomsOfInterest);
+    std::vector<std::vector<unsigned int>> candidateImages(
+      numberAtomsOfInterest);
+    if (checkOnlyNearbyImages)
+      {
+        const utils::AtomSpatialIndex atomImagesSpatialIndex(atomImagePoints,
+                                                             maxCutOffRadius);
+        std::vector<unsigned int>     cellPointIds;
+        for (unsigned int iCell = 0; iCell < totalLocallyOwnedCells; ++iCell)
+          {
+            // ball around the quadrature points of the cell
+            const double *cellQuadPoints =
+              quadraturePointsVector.data() +
+              iCell * numberQuadraturePoints * 3;
+            double cellCenter[3];
+            for (unsigned int iDim = 0; iDim < 3; ++iDim)
+              {
+                double lower = cellQuadPoints[iDim];
+                double upper = cellQuadPoints[iDim];
+                for (unsigned int iQuad = 1; iQuad < numberQuadraturePoints;
+                     ++iQuad)
+                  {
+                    lower = std::min(lower, cellQuadPoints[3 * iQuad + iDim]);
+                    upper = std::max(upper, cellQuadPoints[3 * iQuad + iDim]);
+                  }
+                cellCenter[iDim] = 0.5 * (lower + upper);
+              }
+            double cellRadius = 0.0;
+            for (unsigned int iQuad = 0; iQuad < numberQuadraturePoints;
+                 ++iQuad)
+              {
+                double distanceSquared = 0.0;
+                for (unsigned int iDim = 0; iDim < 3; ++iDim)
+                  distanceSquared +=
+                    (cellQuadPoints[3 * iQuad + iDim] - cellCenter[iDim]) *
+                    (cellQuadPoints[3 * iQuad + iDim] - cellCenter[iDim]);
+                cellRadius = std::max(cellRadius, std::sqrt(distanceSquared));
+              }
+
+            atomImagesSpatialIndex.findPointsInBall(cellCenter,
+                                                    cellRadius +
+                                                      maxCutOffRadius + 1e-8,
+                                                    cellPointIds);
+            for (const unsigned int pointId : cellPointIds)
+              {
+                const unsigned int iAtom = pointAtomIds[pointId];
+                const double       dx =
+                  atomImagePoints[3 * pointId + 0] - cellCenter[0];
+                const double dy =
+                  atomImagePoints[3 * pointId + 1] - cellCenter[1];
+                const double dz =
+                  atomImagePoints[3 * pointId + 2] - cellCenter[2];
+                if (std::sqrt(dx * dx + dy * dy + dz * dz) >
+                    cellRadius + atomCutOffRadii[iAtom] + 1e-8)
+                  continue;
+                if (candidateCells[iAtom].empty() ||
+                    candidateCells[iAtom].back() != iCell)
+                  {
+                    candidateCells[iAtom].push_back(iCell);
+                    candidateImageOffsets[iAtom].push_back(
+                      candidateImages[iAtom].size());
+                  }
+                candidateImages[iAtom].push_back(pointImageIds[pointId]);
+              }
+          }
+        for (int iAtom = 0; iAtom < numberAtomsOfInterest; ++iAtom)
+          candidateImageOffsets[iAtom].push_back(candidateImages[iAtom].size());
+      }
+
     for (int iAtom = 0; iAtom < numberAtomsOfInterest; ++iAtom)
       {
         //
@@ -375,8 +495,24 @@ namespace dftfe
         // parallel loop over all elements
         //
 
-        for (int iCell = 0; iCell < totalLocallyOwnedCells; iCell++)
+        const unsigned int numberCandidateCells =
+          checkOnlyNearbyImages ? candidateCells[iAtom].size() :
+                                  totalLocallyOwnedCells;
+        for (unsigned int iCandidateCell = 0;
+             iCandidateCell < numberCandidateCells;
+             iCandidateCell++)
           {
+            const int iCell = checkOnlyNearbyImages ?
+                                candidateCells[iAtom][iCandidateCell] :
+                                iCandidateCell;
+            const unsigned int imageBegin =
+              checkOnlyNearbyImages ?
+                candidateImageOffsets[iAtom][iCandidateCell] :
+                0;
+            const unsigned int imageEnd =
+              checkOnlyNearbyImages ?
+                candidateImageOffsets[iAtom][iCandidateCell + 1] :
+                imageIdsSize;
             double              maxR = 0.0;
             std::vector<double> quadPoints(numberQuadraturePoints * 3, 0.0);
             for (int iQuad = 0; iQuad < numberQuadraturePoints; iQuad++)
@@ -392,9 +528,11 @@ namespace dftfe
                                          iQuad * 3 + 2];
               }
             sparseFlag = 0;
-            for (int iImageAtomCount = 0; iImageAtomCount < imageIdsSize;
-                 ++iImageAtomCount)
+            for (unsigned int iImage = imageBegin; iImage < imageEnd; ++iImage)
               {
+                const unsigned int iImageAtomCount =
+                  checkOnlyNearbyImages ? candidateImages[iAtom][iImage] :
+                                          iImage;
                 std::vector<double> x(3, 0.0);
                 dealii::Point<3>    chargePoint(0.0, 0.0, 0.0);
                 if (iImageAtomCount == 0)
@@ -504,16 +642,13 @@ namespace dftfe
     d_AtomIdsInElement.clear();
     d_AtomIdsInElement.resize(numberElements);
 
-    for (int iCell = 0; iCell < numberElements; ++iCell)
+    // atoms are visited in increasing order, as are the atoms of each cell
+    for (int iAtom = 0; iAtom < d_AtomIdsInCurrentProcess.size(); iAtom++)
       {
-        for (int iAtom = 0; iAtom < d_AtomIdsInCurrentProcess.size(); iAtom++)
-          {
-            if (d_sparsityPattern[d_AtomIdsInCurrentProcess[iAtom]][iCell] >= 0)
-              {
-                d_AtomIdsInElement[iCell].push_back(
-                  d_AtomIdsInCurrentProcess[iAtom]);
-              }
-          }
+        const unsigned int atomId = d_AtomIdsInCurrentProcess[iAtom];
+        for (const unsigned int iCell :
+             d_elementIndexesInAtomCompactSupport[atomId])
+          d_AtomIdsInElement[iCell].push_back(atomId);
       }
   }
   template void
@@ -24,14 +24,31 @@ namespace dftfe
                                                    double      truncationTol,
                                                    bool        consider0thEntry)
   {
-    d_lQuantumNumber = 0;
     std::vector<std::vector<double>> radialFunctionData(0);
-    unsigned int                     fileReadFlag =
-      dftUtils::readPsiFile(2, radialFunctionData, filename);
-    d_DataPresent = fileReadFlag;
-    d_cutOff      = 0.0;
-    d_rMin        = 0.0;
-    if (fileReadFlag)
+    dftUtils::readPsiFile(2, radialFunctionData, filename);
+    initializeSpline(radialFunctionData, truncationTol, consider0thEntry);
+  }
+
+  AtomCenteredSphericalFunctionCoreDensitySpline::
+    AtomCenteredSphericalFunctionCoreDensitySpline(
+      const std::vector<std::vector<double>> &radialFunctionData,
+      double                                  truncationTol,
+      bool                                    consider0thEntry)
+  {
+    initializeSpline(radialFunctionData, truncationTol, consider0thEntry);
+  }
+
+  void
+  AtomCenteredSphericalFunctionCoreDensitySpline::initializeSpline(
+    const std::vector<std::vector<double>> &radialFunctionData,
+    double                                  truncationTol,
+    bool                                    consider0thEntry)
+  {
+    d_lQuantumNumber = 0;
+    d_DataPresent    = !radialFunctionData.empty();
+    d_cutOff         = 0.0;
+    d_rMin           = 0.0;
+    if (d_DataPresent)
       {
         unsigned int        numRows = radialFunctionData.size() - 1;
         std::vector<double> xData(numRows), yData(numRows);
@@ -63,6 +80,7 @@ namespace dftfe
                            natural_bound_type_R,
                            0.0,
                            d_radialSplineObject);
+        initializeBatchedEvaluation();
         d_cutOff = xData[maxRowId];
         d_rMin   = xData[0];
       }
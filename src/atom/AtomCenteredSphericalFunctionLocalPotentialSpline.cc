@@ -25,14 +25,39 @@ namespace dftfe
                                                       double      truncationTol,
                                                       double maxAllowedTail)
   {
-    d_lQuantumNumber = 0;
     std::vector<std::vector<double>> radialFunctionData(0);
-    unsigned int                     fileReadFlag =
-      dftUtils::readPsiFile(2, radialFunctionData, filename);
-    d_DataPresent = fileReadFlag;
-    d_cutOff      = 0.0;
-    d_rMin        = 0.0;
-    if (fileReadFlag)
+    dftUtils::readPsiFile(2, radialFunctionData, filename);
+    initializeSpline(radialFunctionData,
+                     atomAttribute,
+                     truncationTol,
+                     maxAllowedTail);
+  }
+
+  AtomCenteredSphericalFunctionLocalPotentialSpline::
+    AtomCenteredSphericalFunctionLocalPotentialSpline(
+      const std::vector<std::vector<double>> &radialFunctionData,
+      double                                  atomAttribute,
+      double                                  truncationTol,
+      double                                  maxAllowedTail)
+  {
+    initializeSpline(radialFunctionData,
+                     atomAttribute,
+                     truncationTol,
+                     maxAllowedTail);
+  }
+
+  void
+  AtomCenteredSphericalFunctionLocalPotentialSpline::initializeSpline(
+    const std::vector<std::vector<double>> &radialFunctionData,
+    double                                  atomAttribute,
+    double                                  truncationTol,
+    double                                  maxAllowedTail)
+  {
+    d_lQuantumNumber = 0;
+    d_DataPresent    = !radialFunctionData.empty();
+    d_cutOff         = 0.0;
+    d_rMin           = 0.0;
+    if (d_DataPresent)
       {
         unsigned int        numRows = radialFunctionData.size() - 1;
         std::vector<double> xData(numRows), yData(numRows);
@@ -72,6 +97,7 @@ namespace dftfe
                            bound_type_r,
                            slopeR,
                            d_radialSplineObject);
+        initializeBatchedEvaluation();
       }
   }
 
@@ -28,12 +28,46 @@ namespace dftfe
                                                  double       truncationTol,
                                                  bool         consider0thEntry)
   {
-    d_lQuantumNumber = l;
     std::vector<std::vector<double>> radialFunctionData(0);
     dftUtils::readFile(totalColSize, radialFunctionData, filename);
-    d_DataPresent = true;
-    d_cutOff      = 0.0;
-    d_rMin        = 0.0;
+    initializeSpline(radialFunctionData,
+                     l,
+                     radialPower,
+                     colIndex,
+                     truncationTol,
+                     consider0thEntry);
+  }
+
+  AtomCenteredSphericalFunctionProjectorSpline::
+    AtomCenteredSphericalFunctionProjectorSpline(
+      const std::vector<std::vector<double>> &radialFunctionData,
+      unsigned int                            l,
+      int                                     radialPower,
+      int                                     colIndex,
+      double                                  truncationTol,
+      bool                                    consider0thEntry)
+  {
+    initializeSpline(radialFunctionData,
+                     l,
+                     radialPower,
+                     colIndex,
+                     truncationTol,
+                     consider0thEntry);
+  }
+
+  void
+  AtomCenteredSphericalFunctionProjectorSpline::initializeSpline(
+    const std::vector<std::vector<double>> &radialFunctionData,
+    unsigned int                            l,
+    int                                     radialPower,
+    int                                     colIndex,
+    double                                  truncationTol,
+    bool                                    consider0thEntry)
+  {
+    d_lQuantumNumber = l;
+    d_DataPresent    = true;
+    d_cutOff         = 0.0;
+    d_rMin           = 0.0;
 
 
     unsigned int        numRows = radialFunctionData.size() - 1;
@@ -69,6 +103,7 @@ namespace dftfe
                        natural_bound_type_R,
                        0.0,
                        d_radialSplineObject);
+    initializeBatchedEvaluation();
     d_cutOff = xData[maxRowId + 10];
     d_rMin   = xData[0];
   }
@@ -17,6 +17,7 @@
 
 #include "AtomCenteredSphericalFunctionSpline.h"
 #include "vector"
+#include <algorithm>
 namespace dftfe
 {
   double
@@ -32,6 +33,108 @@ namespace dftfe
     return v;
   }
 
+  void
+  AtomCenteredSphericalFunctionSpline::getRadialValues(
+    const double *     r,
+    double *           values,
+    const unsigned int numPoints) const
+  {
+    if (d_splineKnots.empty())
+      {
+        AtomCenteredSphericalFunctionBase::getRadialValues(r,
+                                                           values,
+                                                           numPoints);
+        return;
+      }
+
+    constexpr unsigned int chunkSize = 64;
+    unsigned int           intervalIndices[chunkSize];
+    double                 t[chunkSize];
+    const double *         coefficients = d_splineCoefficients.data();
+    for (unsigned int iStart = 0; iStart < numPoints; iStart += chunkSize)
+      {
+        const unsigned int numPointsChunk =
+          std::min(chunkSize, numPoints - iStart);
+
+        for (unsigned int iPoint = 0; iPoint < numPointsChunk; ++iPoint)
+          {
+            const double rClamped = std::max(r[iStart + iPoint], d_rMin);
+            intervalIndices[iPoint] = getSplineIntervalIndex(rClamped);
+            t[iPoint] = rClamped - d_splineKnots[intervalIndices[iPoint]];
+          }
+
+#pragma omp simd
+        for (unsigned int iPoint = 0; iPoint < numPointsChunk; ++iPoint)
+          {
+            const double *c = coefficients + 4 * intervalIndices[iPoint];
+            const double  v =
+              c[0] + t[iPoint] * (c[1] + t[iPoint] * (c[2] + t[iPoint] * c[3]));
+            values[iStart + iPoint] = r[iStart + iPoint] >= d_cutOff ? 0.0 : v;
+          }
+      }
+  }
+
+  void
+  AtomCenteredSphericalFunctionSpline::initializeBatchedEvaluation()
+  {
+    alglib::ae_int_t      numKnots;
+    alglib::real_2d_array splineTable;
+    alglib::spline1dunpack(d_radialSplineObject, numKnots, splineTable);
+
+    const unsigned int numIntervals = numKnots - 1;
+    d_splineKnots.resize(numKnots);
+    d_splineCoefficients.resize(4 * numIntervals);
+    for (unsigned int i = 0; i < numIntervals; ++i)
+      {
+        d_splineKnots[i] = splineTable[i][0];
+        for (unsigned int j = 0; j < 4; ++j)
+          d_splineCoefficients[4 * i + j] = splineTable[i][2 + j];
+      }
+    d_splineKnots[numIntervals] = splineTable[numIntervals - 1][1];
+
+    // interval containing x is the last one with x_i < x, as in spline1dcalc
+    auto intervalIndex = [&](const double x) {
+      const unsigned int i =
+        std::lower_bound(d_splineKnots.begin(), d_splineKnots.end(), x) -
+        d_splineKnots.begin();
+      return i == 0 ? 0 : std::min(i - 1, numIntervals - 1);
+    };
+
+    const unsigned int numBins = numIntervals;
+    const double       binWidth =
+      (d_splineKnots[numIntervals] - d_splineKnots[0]) / numBins;
+    d_binInverseWidth = 1.0 / binWidth;
+    d_binToIntervalIndex.resize(numBins + 1);
+    for (unsigned int iBin = 0; iBin <= numBins; ++iBin)
+      d_binToIntervalIndex[iBin] =
+        intervalIndex(d_splineKnots[0] + iBin * binWidth);
+  }
+
+  unsigned int
+  AtomCenteredSphericalFunctionSpline::getSplineIntervalIndex(
+    const double r) const
+  {
+    const unsigned int numBins = d_binToIntervalIndex.size() - 1;
+    const double binCoordinate = (r - d_splineKnots[0]) * d_binInverseWidth;
+    const unsigned int iBin =
+      binCoordinate <= 0.0 ?
+        0 :
+        std::min((unsigned int)binCoordinate, numBins - 1);
+
+    // neighbouring bins are included to guard against roundoff in iBin
+    unsigned int lower = d_binToIntervalIndex[iBin == 0 ? 0 : iBin - 1];
+    unsigned int upper = d_binToIntervalIndex[std::min(iBin + 2, numBins)];
+    while (lower < upper)
+      {
+        const unsigned int mid = (lower + upper + 1) / 2;
+        if (d_splineKnots[mid] < r)
+          lower = mid;
+        else
+          upper = mid - 1;
+      }
+    return lower;
+  }
+
   std::vector<double>
   AtomCenteredSphericalFunctionSpline::getDerivativeValue(double r) const
   {
@@ -17,6 +17,7 @@
 // @author Kartick Ramakrishnan, Sambit Das, Phani Motamarri, Vishal Subramanian
 //
 #include <AtomicCenteredNonLocalOperator.h>
+#include <algorithm>
 #if defined(DFTFE_WITH_DEVICE)
 #  include <AtomicCenteredNonLocalOperatorKernelsDevice.h>
 #  include <DeviceTypeConfig.h>
@@ -80,18 +81,7 @@ namespace dftfe
     if constexpr (dftfe::utils::MemorySpace::HOST == memorySpace)
       {
         d_kPointIndex = kPointIndex;
-
-        const std::vector<unsigned int> atomIdsInProcessor =
-          d_atomCenteredSphericalFunctionContainer
-            ->getAtomIdsInCurrentProcess();
-        const std::vector<unsigned int> &atomicNumber =
-          d_atomCenteredSphericalFunctionContainer->getAtomicNumbers();
-        for (int iAtom = 0; iAtom < d_totalAtomsInCurrentProc; iAtom++)
-          {
-            unsigned int atomId = atomIdsInProcessor[iAtom];
-
-            d_sphericalFnTimesWavefunMatrix[atomId].setValue(0.0);
-          }
+        d_sphericalFnTimesVectorAllCells.setValue(0.0);
       }
 #if defined(DFTFE_WITH_DEVICE)
     else
@@ -372,6 +362,13 @@ namespace dftfe
                     maxkPoints * numberQuadraturePoints *
                       (2 * lQuantumNumber + 1) * 3,
                     ValueType(0.0));
+                std::vector<double> quadPointsMinusChargePoint(
+                  numberQuadraturePoints * 3, 0.0);
+                std::vector<double> radialDistances(numberQuadraturePoints,
+                                                    0.0);
+                std::vector<double> radialVals(numberQuadraturePoints, 0.0);
+                std::vector<double> sphericalHarmonicVals(
+                  (lQuantumNumber + 1) * (lQuantumNumber + 1), 0.0);
                 for (int iImageAtomCount = 0; iImageAtomCount < imageIdsSize;
                      ++iImageAtomCount)
                   {
@@ -389,50 +386,59 @@ namespace dftfe
                         chargePoint[2] =
                           imageCoordinates[3 * iImageAtomCount + 2];
                       }
-                    double x[3], pointMinusLatticeVector[3];
-                    double sphericalHarmonicVal, radialVal,
-                      sphericalFunctionValue;
-                    double r, theta, phi, angle;
+                    double pointMinusLatticeVector[3];
+                    double radialVal, sphericalFunctionValue;
+                    double angle;
 
+                    // radial values of all the quadrature points of the cell
+                    // are evaluated as one batch
                     for (int iQuadPoint = 0;
                          iQuadPoint < numberQuadraturePoints;
                          ++iQuadPoint)
                       {
-                        x[0] =
-                          quadraturePointsVector[elementIndex *
-                                                   numberQuadraturePoints * 3 +
-                                                 3 * iQuadPoint] -
-                          chargePoint[0];
-                        x[1] =
-                          quadraturePointsVector[elementIndex *
-                                                   numberQuadraturePoints * 3 +
-                                                 3 * iQuadPoint + 1] -
-                          chargePoint[1];
-                        x[2] =
-                          quadraturePointsVector[elementIndex *
-                                                   numberQuadraturePoints * 3 +
-                                                 3 * iQuadPoint + 2] -
-                          chargePoint[2];
-                        sphericalHarmonicUtils::convertCartesianToSpherical(
-                          x, r, theta, phi);
-                        if (r <= sphFn->getRadialCutOff())
+                        double *x =
+                          quadPointsMinusChargePoint.data() + 3 * iQuadPoint;
+                        for (unsigned int iDim = 0; iDim < 3; ++iDim)
+                          x[iDim] =
+                            quadraturePointsVector[elementIndex *
+                                                     numberQuadraturePoints *
+                                                     3 +
+                                                   3 * iQuadPoint + iDim] -
+                            chargePoint[iDim];
+                        radialDistances[iQuadPoint] =
+                          std::sqrt(x[0] * x[0] + x[1] * x[1] + x[2] * x[2]);
+                      }
+                    sphFn->getRadialValues(radialDistances.data(),
+                                           radialVals.data(),
+                                           numberQuadraturePoints);
+
+                    for (int iQuadPoint = 0;
+                         iQuadPoint < numberQuadraturePoints;
+                         ++iQuadPoint)
+                      {
+                        const double *x =
+                          quadPointsMinusChargePoint.data() + 3 * iQuadPoint;
+                        if (radialDistances[iQuadPoint] <=
+                            sphFn->getRadialCutOff())
                           {
-                            radialVal = sphFn->getRadialValue(r);
+                            radialVal = radialVals[iQuadPoint];
+                            sphericalHarmonicUtils::
+                              getSphericalHarmonicValsAllLm(
+                                x,
+                                lQuantumNumber,
+                                sphericalHarmonicVals.data());
 
                             unsigned int tempIndex = 0;
                             for (int mQuantumNumber = int(-lQuantumNumber);
                                  mQuantumNumber <= int(lQuantumNumber);
                                  mQuantumNumber++)
                               {
-                                sphericalHarmonicUtils::getSphericalHarmonicVal(
-                                  theta,
-                                  phi,
-                                  lQuantumNumber,
-                                  mQuantumNumber,
-                                  sphericalHarmonicVal);
-
                                 sphericalFunctionValue =
-                                  radialVal * sphericalHarmonicVal;
+                                  radialVal *
+                                  sphericalHarmonicVals[lQuantumNumber *
+                                                          lQuantumNumber +
+                                                        lQuantumNumber +
+                                                        mQuantumNumber];
 
 
 
@@ -828,6 +834,110 @@ namespace dftfe
                   }
               }
           }
+
+        // Gather the C matrix entries cell wise over the atoms having support
+        // in the cell, so that CconjtransX and CVCconjtransX on a cell are a
+        // single gemm each and the assembly over cells is an index scatter
+        d_sphericalFnIdsParallelNumberingMap.clear();
+        d_sphericalFnIdsParallelNumberingMap.reserve(d_totalNonLocalEntries);
+        std::vector<unsigned int> atomStartIndex(d_totalAtomsInCurrentProc, 0);
+        for (unsigned int iAtom = 0; iAtom < d_totalAtomsInCurrentProc; ++iAtom)
+          {
+            atomStartIndex[iAtom] = d_sphericalFnIdsParallelNumberingMap.size();
+            d_sphericalFnIdsParallelNumberingMap.insert(
+              d_sphericalFnIdsParallelNumberingMap.end(),
+              sphericalFnKetTimesVectorLocalIds[iAtom].begin(),
+              sphericalFnKetTimesVectorLocalIds[iAtom].end());
+          }
+
+        const unsigned int kPointStride =
+          d_sumNonTrivialSphericalFnOverAllCells * d_numberNodesPerElement;
+        d_CMatrixEntriesConjugateAllCells.clear();
+        d_CMatrixEntriesConjugateAllCells.resize(maxkPoints * kPointStride,
+                                                 ValueType(0.0));
+        d_CMatrixEntriesTransposeAllCells.clear();
+        d_CMatrixEntriesTransposeAllCells.resize(maxkPoints * kPointStride,
+                                                 ValueType(0.0));
+        d_nonTrivialAllCellsSphericalFnProcessIds.clear();
+        d_nonTrivialAllCellsSphericalFnProcessIds.resize(
+          d_sumNonTrivialSphericalFnOverAllCells, 0);
+        for (unsigned int iAtom = 0; iAtom < d_totalAtomsInCurrentProc; ++iAtom)
+          {
+            const unsigned int atomId = atomIdsInProc[iAtom];
+            const unsigned int numberSphericalFunctions =
+              d_atomCenteredSphericalFunctionContainer
+                ->getTotalNumberOfSphericalFunctionsPerAtom(
+                  atomicNumber[atomId]);
+            const std::vector<unsigned int>
+              &elementIndexesInAtomCompactSupport =
+                d_atomCenteredSphericalFunctionContainer
+                  ->d_elementIndexesInAtomCompactSupport[atomId];
+            for (unsigned int iElemComp = 0;
+                 iElemComp < elementIndexesInAtomCompactSupport.size();
+                 ++iElemComp)
+              {
+                const unsigned int elementId =
+                  elementIndexesInAtomCompactSupport[iElemComp];
+                const unsigned int numberSphericalFunctionsInCell =
+                  d_nonTrivialSphericalFnPerCell[elementId];
+                const unsigned int cellStartIndex =
+                  d_nonTrivialSphericalFnsCellStartIndex[elementId];
+                const unsigned int cellColumnId =
+                  d_atomIdToNonTrivialSphericalFnCellStartIndex[iAtom]
+                                                               [elementId];
+                for (unsigned int alpha = 0; alpha < numberSphericalFunctions;
+                     ++alpha)
+                  d_nonTrivialAllCellsSphericalFnProcessIds[cellStartIndex +
+                                                            cellColumnId +
+                                                            alpha] =
+                    atomStartIndex[iAtom] + alpha;
+
+                for (unsigned int kPoint = 0; kPoint < maxkPoints; ++kPoint)
+                  {
+                    const ValueType *CMatrixEntriesConjugateAtomElem =
+                      d_CMatrixEntriesConjugate[atomId][iElemComp].data() +
+                      kPoint * d_numberNodesPerElement *
+                        numberSphericalFunctions;
+                    const ValueType *CMatrixEntriesTransposeAtomElem =
+                      d_CMatrixEntriesTranspose[atomId][iElemComp].data() +
+                      kPoint * d_numberNodesPerElement *
+                        numberSphericalFunctions;
+                    ValueType *CMatrixEntriesConjugateCell =
+                      d_CMatrixEntriesConjugateAllCells.data() +
+                      kPoint * kPointStride +
+                      cellStartIndex * d_numberNodesPerElement;
+                    ValueType *CMatrixEntriesTransposeCell =
+                      d_CMatrixEntriesTransposeAllCells.data() +
+                      kPoint * kPointStride +
+                      cellStartIndex * d_numberNodesPerElement;
+                    for (unsigned int iNode = 0;
+                         iNode < d_numberNodesPerElement;
+                         ++iNode)
+                      for (unsigned int alpha = 0;
+                           alpha < numberSphericalFunctions;
+                           ++alpha)
+                        {
+                          CMatrixEntriesConjugateCell
+                            [(cellColumnId + alpha) * d_numberNodesPerElement +
+                             iNode] =
+                              CMatrixEntriesConjugateAtomElem
+                                [alpha * d_numberNodesPerElement + iNode];
+                          CMatrixEntriesTransposeCell
+                            [iNode * numberSphericalFunctionsInCell +
+                             cellColumnId + alpha] =
+                              CMatrixEntriesTransposeAtomElem
+                                [iNode * numberSphericalFunctions + alpha];
+                        }
+                  }
+              }
+          }
+
+        // the per atom copies are not used on the host once gathered cell
+        // wise, free them instead of keeping the C matrix twice in memory
+        std::vector<std::vector<std::vector<ValueType>>>().swap(
+          d_CMatrixEntriesConjugate);
+        std::vector<std::vector<std::vector<ValueType>>>().swap(
+          d_CMatrixEntriesTranspose);
       }
 #if defined(DFTFE_WITH_DEVICE)
     else
@@ -1111,22 +1221,14 @@ namespace dftfe
           d_SphericalFunctionKetTimesVectorPar[0].get_partitioner(),
           waveFunctionBlockSize,
           sphericalFunctionKetTimesVectorParFlattened);
-        d_sphericalFnTimesWavefunMatrix.clear();
-        const std::vector<unsigned int> atomIdsInProcessor =
-          d_atomCenteredSphericalFunctionContainer
-            ->getAtomIdsInCurrentProcess();
-        const std::vector<unsigned int> &atomicNumber =
-          d_atomCenteredSphericalFunctionContainer->getAtomicNumbers();
-        for (int iAtom = 0; iAtom < d_totalAtomsInCurrentProc; iAtom++)
-          {
-            unsigned int atomId = atomIdsInProcessor[iAtom];
-            unsigned int Znum   = atomicNumber[atomId];
-            unsigned int numberSphericalFunctions =
-              d_atomCenteredSphericalFunctionContainer
-                ->getTotalNumberOfSphericalFunctionsPerAtom(Znum);
-            d_sphericalFnTimesWavefunMatrix[atomId].resize(
-              numberSphericalFunctions * d_numberWaveFunctions, ValueType(0.0));
-          }
+        d_sphericalFnTimesVectorAllCells.clear();
+        d_sphericalFnTimesVectorAllCells.resize(
+          d_sumNonTrivialSphericalFnOverAllCells * d_numberWaveFunctions,
+          ValueType(0.0));
+        d_couplingMatrixTimesVector.clear();
+        d_couplingMatrixTimesVector.resize(d_totalNonLocalEntries *
+                                             d_numberWaveFunctions,
+                                           ValueType(0.0));
       }
 #if defined(DFTFE_WITH_DEVICE)
     else
@@ -1666,70 +1768,58 @@ namespace dftfe
       {
         if constexpr (dftfe::utils::MemorySpace::HOST == memorySpace)
           {
-            const std::vector<unsigned int> &atomicNumber =
-              d_atomCenteredSphericalFunctionContainer->getAtomicNumbers();
-            const std::vector<unsigned int> atomIdsInProc =
-              d_atomCenteredSphericalFunctionContainer
-                ->getAtomIdsInCurrentProcess();
             if (couplingtype == CouplingStructure::diagonal)
               {
-                unsigned int       startIndex = 0;
-                const unsigned int inc        = 1;
-                for (int iAtom = 0; iAtom < d_totalAtomsInCurrentProc; iAtom++)
+                if (flagCopyResultsToMatrix)
                   {
-                    const unsigned int atomId = atomIdsInProc[iAtom];
-                    const unsigned int Znum   = atomicNumber[atomId];
-                    const unsigned int numberSphericalFunctions =
-                      d_atomCenteredSphericalFunctionContainer
-                        ->getTotalNumberOfSphericalFunctionsPerAtom(Znum);
-
-
-                    for (unsigned int alpha = 0;
-                         alpha < numberSphericalFunctions;
-                         alpha++)
+                    for (unsigned int iSphericalFn = 0;
+                         iSphericalFn < d_sumNonTrivialSphericalFnOverAllCells;
+                         ++iSphericalFn)
                       {
-                        ValueType nonlocalConstantV =
-                          couplingMatrix[startIndex++];
+                        const ValueType nonlocalConstantV =
+                          couplingMatrix
+                            [d_nonTrivialAllCellsSphericalFnProcessIds
+                               [iSphericalFn]];
                         const unsigned int localId =
-                          sphericalFunctionKetTimesVectorParFlattened
-                            .getMPIPatternP2P()
-                            ->globalToLocal(
-                              d_sphericalFunctionIdsNumberingMapCurrentProcess
-                                .find(std::make_pair(atomId, alpha))
-                                ->second);
-                        if (flagCopyResultsToMatrix)
-                          {
-                            std::transform(
-                              sphericalFunctionKetTimesVectorParFlattened
-                                  .begin() +
-                                localId * d_numberWaveFunctions,
-                              sphericalFunctionKetTimesVectorParFlattened
-                                  .begin() +
-                                localId * d_numberWaveFunctions +
-                                d_numberWaveFunctions,
-                              d_sphericalFnTimesWavefunMatrix[atomId].begin() +
-                                d_numberWaveFunctions * alpha,
-                              [&nonlocalConstantV](auto &a) {
-                                return nonlocalConstantV * a;
-                              });
-                          }
-                        else
-                          {
-                            d_BLASWrapperPtr->xscal(
-                              sphericalFunctionKetTimesVectorParFlattened
-                                  .begin() +
-                                localId * d_numberWaveFunctions,
-                              nonlocalConstantV,
-                              d_numberWaveFunctions);
-                          }
+                          d_sphericalFnTimesVectorFlattenedVectorLocalIds
+                            [iSphericalFn];
+                        std::transform(
+                          sphericalFunctionKetTimesVectorParFlattened.begin() +
+                            localId * d_numberWaveFunctions,
+                          sphericalFunctionKetTimesVectorParFlattened.begin() +
+                            localId * d_numberWaveFunctions +
+                            d_numberWaveFunctions,
+                          d_sphericalFnTimesVectorAllCells.begin() +
+                            iSphericalFn * d_numberWaveFunctions,
+                          [&nonlocalConstantV](auto &a) {
+                            return nonlocalConstantV * a;
+                          });
                       }
                   }
+                else
+                  {
+                    for (unsigned int iSphericalFn = 0;
+                         iSphericalFn < d_totalNonLocalEntries;
+                         ++iSphericalFn)
+                      d_BLASWrapperPtr->xscal(
+                        sphericalFunctionKetTimesVectorParFlattened.begin() +
+                          d_sphericalFnIdsParallelNumberingMap[iSphericalFn] *
+                            d_numberWaveFunctions,
+                        couplingMatrix[iSphericalFn],
+                        d_numberWaveFunctions);
+                  }
               }
             else if (couplingtype == CouplingStructure::blockDiagonal)
               {
-                const ValueType one   = 1.0;
-                const ValueType zero  = 0.0;
-                unsigned int    alpha = 0;
+                const std::vector<unsigned int> &atomicNumber =
+                  d_atomCenteredSphericalFunctionContainer->getAtomicNumbers();
+                const std::vector<unsigned int> &atomIdsInProc =
+                  d_atomCenteredSphericalFunctionContainer
+                    ->getAtomIdsInCurrentProcess();
+                const ValueType one        = 1.0;
+                const ValueType zero       = 0.0;
+                unsigned int    alpha      = 0;
+                unsigned int    startIndex = 0;
                 for (int iAtom = 0; iAtom < d_totalAtomsInCurrentProc; iAtom++)
                   {
                     const unsigned int atomId = atomIdsInProc[iAtom];
@@ -1738,12 +1828,7 @@ namespace dftfe
                       d_atomCenteredSphericalFunctionContainer
                         ->getTotalNumberOfSphericalFunctionsPerAtom(Znum);
                     const unsigned int localId =
-                      sphericalFunctionKetTimesVectorParFlattened
-                        .getMPIPatternP2P()
-                        ->globalToLocal(
-                          d_sphericalFunctionIdsNumberingMapCurrentProcess
-                            .find(std::make_pair(atomId, 0))
-                            ->second);
+                      d_sphericalFnIdsParallelNumberingMap[startIndex];
                     d_BLASWrapperPtr->xgemm(
                       'N',
                       'T',
@@ -1757,11 +1842,24 @@ namespace dftfe
                       couplingMatrix.begin() + alpha,
                       numberSphericalFunctions * 2,
                       &zero,
-                      &d_sphericalFnTimesWavefunMatrix[atomId][0],
+                      d_couplingMatrixTimesVector.begin() +
+                        startIndex * d_numberWaveFunctions,
                       d_numberWaveFunctions / 2);
                     alpha +=
                       numberSphericalFunctions * numberSphericalFunctions * 4;
+                    startIndex += numberSphericalFunctions;
                   }
+                if (flagCopyResultsToMatrix)
+                  for (unsigned int iSphericalFn = 0;
+                       iSphericalFn < d_sumNonTrivialSphericalFnOverAllCells;
+                       ++iSphericalFn)
+                    std::memcpy(d_sphericalFnTimesVectorAllCells.begin() +
+                                  iSphericalFn * d_numberWaveFunctions,
+                                d_couplingMatrixTimesVector.begin() +
+                                  d_nonTrivialAllCellsSphericalFnProcessIds
+                                      [iSphericalFn] *
+                                    d_numberWaveFunctions,
+                                d_numberWaveFunctions * sizeof(ValueType));
               }
           }
 #if defined(DFTFE_WITH_DEVICE)
@@ -1850,47 +1948,32 @@ namespace dftfe
       {
         if constexpr (dftfe::utils::MemorySpace::HOST == memorySpace)
           {
-            const std::vector<unsigned int> atomIdsInProc =
-              d_atomCenteredSphericalFunctionContainer
-                ->getAtomIdsInCurrentProcess();
-            const std::vector<unsigned int> &atomicNumber =
-              d_atomCenteredSphericalFunctionContainer->getAtomicNumbers();
-            for (int iAtom = 0; iAtom < d_totalAtomsInCurrentProc; iAtom++)
-              {
-                const unsigned int atomId = atomIdsInProc[iAtom];
-                unsigned int       Znum   = atomicNumber[atomId];
-                const unsigned int numberSphericalFunctions =
-                  d_atomCenteredSphericalFunctionContainer
-                    ->getTotalNumberOfSphericalFunctionsPerAtom(Znum);
-                for (unsigned int alpha = 0; alpha < numberSphericalFunctions;
-                     alpha++)
-                  {
-                    const unsigned int id =
-                      d_sphericalFunctionIdsNumberingMapCurrentProcess
-                        .find(std::make_pair(atomId, alpha))
-                        ->second;
-                    std::memcpy(
-                      sphericalFunctionKetTimesVectorParFlattened.data() +
-                        sphericalFunctionKetTimesVectorParFlattened
-                            .getMPIPatternP2P()
-                            ->globalToLocal(id) *
+            // index scatter of the cell major layout, reducing the
+            // contributions of the cells in the support of each atom
+            for (unsigned int iSphericalFn = 0;
+                 iSphericalFn < d_totalNonLocalEntries;
+                 ++iSphericalFn)
+              std::fill_n(sphericalFunctionKetTimesVectorParFlattened.data() +
+                            d_sphericalFnIdsParallelNumberingMap[iSphericalFn] *
+                              d_numberWaveFunctions,
                           d_numberWaveFunctions,
-                      d_sphericalFnTimesWavefunMatrix[atomId].begin() +
-                        d_numberWaveFunctions * alpha,
-                      d_numberWaveFunctions * sizeof(ValueType));
-
-
-                    // d_BLASWrapperPtr->xcopy(
-                    //   d_numberWaveFunctions,
-                    //   &d_sphericalFnTimesWavefunMatrix[atomId]
-                    //                                  [d_numberWaveFunctions *
-                    //                                  alpha],
-                    //   inc,
-                    //   sphericalFunctionKetTimesVectorParFlattened.data() +
-                    //     sphericalFunctionKetTimesVectorParFlattened.getMPIPatternP2P()
-                    //     ->globalToLocal(id) *d_numberWaveFunctions,
-                    //   inc);
-                  }
+                          ValueType(0.0));
+            for (unsigned int iSphericalFn = 0;
+                 iSphericalFn < d_sumNonTrivialSphericalFnOverAllCells;
+                 ++iSphericalFn)
+              {
+                ValueType *sphericalFnTimesVector =
+                  sphericalFunctionKetTimesVectorParFlattened.data() +
+                  d_sphericalFnTimesVectorFlattenedVectorLocalIds
+                      [iSphericalFn] *
+                    d_numberWaveFunctions;
+                std::transform(d_sphericalFnTimesVectorAllCells.begin() +
+                                 iSphericalFn * d_numberWaveFunctions,
+                               d_sphericalFnTimesVectorAllCells.begin() +
+                                 (iSphericalFn + 1) * d_numberWaveFunctions,
+                               sphericalFnTimesVector,
+                               sphericalFnTimesVector,
+                               std::plus<>{});
               }
             if (!skipComm)
               {
@@ -1922,6 +2005,33 @@ namespace dftfe
 #endif
       }
   }
+  template <typename ValueType, dftfe::utils::MemorySpace memorySpace>
+  void
+  AtomicCenteredNonLocalOperator<ValueType, memorySpace>::
+    groupCellsByNumberSphericalFunctions(
+      const std::pair<unsigned int, unsigned int> cellRange,
+      std::vector<unsigned int> &                 cells,
+      std::vector<unsigned int> &                 groupStarts) const
+  {
+    cells.clear();
+    for (unsigned int iElem = cellRange.first; iElem < cellRange.second;
+         iElem++)
+      if (d_nonTrivialSphericalFnPerCell[iElem] > 0)
+        cells.push_back(iElem);
+    std::stable_sort(cells.begin(),
+                     cells.end(),
+                     [this](const unsigned int a, const unsigned int b) {
+                       return d_nonTrivialSphericalFnPerCell[a] <
+                              d_nonTrivialSphericalFnPerCell[b];
+                     });
+    groupStarts.clear();
+    for (unsigned int i = 0; i < cells.size(); ++i)
+      if (i == 0 || d_nonTrivialSphericalFnPerCell[cells[i]] !=
+                      d_nonTrivialSphericalFnPerCell[cells[i - 1]])
+        groupStarts.push_back(i);
+    groupStarts.push_back(cells.size());
+  }
+
   template <typename ValueType, dftfe::utils::MemorySpace memorySpace>
   void
   AtomicCenteredNonLocalOperator<ValueType, memorySpace>::applyCconjtransOnX(
@@ -1930,54 +2040,52 @@ namespace dftfe
   {
     if constexpr (dftfe::utils::MemorySpace::HOST == memorySpace)
       {
-        const ValueType    zero(0.0), one(1.0);
-        const unsigned int inc                            = 1;
-        d_AllReduceCompleted                              = false;
-        int                              numberOfElements = d_locallyOwnedCells;
-        const std::vector<unsigned int> &atomicNumber =
-          d_atomCenteredSphericalFunctionContainer->getAtomicNumbers();
-        const std::map<unsigned int, std::vector<int>> sparsityPattern =
-          d_atomCenteredSphericalFunctionContainer->getSparsityPattern();
-        for (int iElem = cellRange.first; iElem < cellRange.second; iElem++)
+        // the (atom, alpha) columns of a cell are contiguous in the cell major
+        // layout, hence one product per cell writing only its own block. The
+        // cells with the same number of spherical functions are one batch.
+        const ValueType  one(1.0);
+        const ValueType *CMatrixEntriesConjugate =
+          d_CMatrixEntriesConjugateAllCells.data() +
+          d_kPointIndex * d_sumNonTrivialSphericalFnOverAllCells *
+            d_numberNodesPerElement;
+        std::vector<unsigned int> cells, groupStarts;
+        groupCellsByNumberSphericalFunctions(cellRange, cells, groupStarts);
+        std::vector<const ValueType *> XPointers(cells.size()),
+          CMatrixPointers(cells.size());
+        std::vector<ValueType *> outputPointers(cells.size());
+        for (unsigned int i = 0; i < cells.size(); ++i)
           {
-            if (atomSupportInElement(iElem))
-              {
-                const std::vector<int> atomIdsInElement =
-                  d_atomCenteredSphericalFunctionContainer->getAtomIdsInElement(
-                    iElem);
-                int numOfAtomsInElement = atomIdsInElement.size();
-                for (int iAtom = 0; iAtom < numOfAtomsInElement; iAtom++)
-                  {
-                    unsigned int       atomId = atomIdsInElement[iAtom];
-                    unsigned int       Znum   = atomicNumber[atomId];
-                    const unsigned int numberSphericalFunctions =
-                      d_atomCenteredSphericalFunctionContainer
-                        ->getTotalNumberOfSphericalFunctionsPerAtom(Znum);
-                    const int nonZeroElementMatrixId =
-                      sparsityPattern.find(atomId)->second[iElem];
-
-                    d_BLASWrapperPtr->xgemm(
-                      'N',
-                      'N',
-                      d_numberWaveFunctions,
-                      numberSphericalFunctions,
-                      d_numberNodesPerElement,
-                      &one,
-                      &X[(iElem - cellRange.first) * d_numberNodesPerElement *
-                         d_numberWaveFunctions],
-                      d_numberWaveFunctions,
-                      &d_CMatrixEntriesConjugate[atomId][nonZeroElementMatrixId]
-                                                [d_kPointIndex *
-                                                 d_numberNodesPerElement *
-                                                 numberSphericalFunctions],
-                      d_numberNodesPerElement,
-                      &one,
-                      &d_sphericalFnTimesWavefunMatrix[atomId][0],
-                      d_numberWaveFunctions);
-
-                  } // iAtom
-              }
-          } // iElem
+            const unsigned int cellStartIndex =
+              d_nonTrivialSphericalFnsCellStartIndex[cells[i]];
+            XPointers[i] = X + (cells[i] - cellRange.first) *
+                                 d_numberNodesPerElement *
+                                 d_numberWaveFunctions;
+            CMatrixPointers[i] =
+              CMatrixEntriesConjugate +
+              cellStartIndex * d_numberNodesPerElement;
+            outputPointers[i] = d_sphericalFnTimesVectorAllCells.data() +
+                                cellStartIndex * d_numberWaveFunctions;
+          }
+        for (unsigned int iGroup = 0; iGroup + 1 < groupStarts.size();
+             ++iGroup)
+          {
+            const unsigned int start = groupStarts[iGroup];
+            d_BLASWrapperPtr->xgemmBatched(
+              'N',
+              'N',
+              d_numberWaveFunctions,
+              d_nonTrivialSphericalFnPerCell[cells[start]],
+              d_numberNodesPerElement,
+              &one,
+              XPointers.data() + start,
+              d_numberWaveFunctions,
+              CMatrixPointers.data() + start,
+              d_numberNodesPerElement,
+              &one,
+              outputPointers.data() + start,
+              d_numberWaveFunctions,
+              groupStarts[iGroup + 1] - start);
+          }
       }
 #if defined(DFTFE_WITH_DEVICE)
     else
@@ -2206,54 +2314,52 @@ namespace dftfe
   {
     if constexpr (dftfe::utils::MemorySpace::HOST == memorySpace)
       {
-        const ValueType                                zero(0.0), one(1.0);
-        const unsigned int                             inc = 1;
-        const std::map<unsigned int, std::vector<int>> sparsityPattern =
-          d_atomCenteredSphericalFunctionContainer->getSparsityPattern();
-        const std::vector<unsigned int> &atomicNumber =
-          d_atomCenteredSphericalFunctionContainer->getAtomicNumbers();
-        for (int iElem = cellRange.first; iElem < cellRange.second; iElem++)
+        // called concurrently from the threaded cell loops in HX, hence only
+        // const access to the shared data structures
+        const ValueType  one(1.0);
+        const ValueType *CMatrixEntriesTranspose =
+          d_CMatrixEntriesTransposeAllCells.data() +
+          d_kPointIndex * d_sumNonTrivialSphericalFnOverAllCells *
+            d_numberNodesPerElement;
+        std::vector<unsigned int> cells, groupStarts;
+        groupCellsByNumberSphericalFunctions(cellRange, cells, groupStarts);
+        std::vector<const ValueType *> inputPointers(cells.size()),
+          CMatrixPointers(cells.size());
+        std::vector<ValueType *> XoutPointers(cells.size());
+        for (unsigned int i = 0; i < cells.size(); ++i)
           {
-            if (atomSupportInElement(iElem))
-              {
-                const std::vector<int> atomIdsInElement =
-                  d_atomCenteredSphericalFunctionContainer->getAtomIdsInElement(
-                    iElem);
-
-
-                int numOfAtomsInElement = atomIdsInElement.size();
-                for (int iAtom = 0; iAtom < numOfAtomsInElement; iAtom++)
-                  {
-                    unsigned int atomId = atomIdsInElement[iAtom];
-
-                    unsigned int       Znum = atomicNumber[atomId];
-                    const unsigned int numberSphericalFunctions =
-                      d_atomCenteredSphericalFunctionContainer
-                        ->getTotalNumberOfSphericalFunctionsPerAtom(Znum);
-                    const int nonZeroElementMatrixId =
-                      sparsityPattern.find(atomId)->second[iElem];
-                    d_BLASWrapperPtr->xgemm(
-                      'N',
-                      'N',
-                      d_numberWaveFunctions,
-                      d_numberNodesPerElement,
-                      numberSphericalFunctions,
-                      &one,
-                      &d_sphericalFnTimesWavefunMatrix[atomId][0],
-                      d_numberWaveFunctions,
-                      &d_CMatrixEntriesTranspose[atomId][nonZeroElementMatrixId]
-                                                [d_kPointIndex *
-                                                 d_numberNodesPerElement *
-                                                 numberSphericalFunctions],
-                      numberSphericalFunctions,
-                      &one,
-                      &Xout[(iElem - cellRange.first) *
-                            d_numberNodesPerElement * d_numberWaveFunctions],
-                      d_numberWaveFunctions);
-
-                  } // iAtom
-              }
-          } // iElem
+            const unsigned int cellStartIndex =
+              d_nonTrivialSphericalFnsCellStartIndex[cells[i]];
+            inputPointers[i] = d_sphericalFnTimesVectorAllCells.data() +
+                               cellStartIndex * d_numberWaveFunctions;
+            CMatrixPointers[i] =
+              CMatrixEntriesTranspose +
+              cellStartIndex * d_numberNodesPerElement;
+            XoutPointers[i] = Xout + (cells[i] - cellRange.first) *
+                                       d_numberNodesPerElement *
+                                       d_numberWaveFunctions;
+          }
+        for (unsigned int iGroup = 0; iGroup + 1 < groupStarts.size();
+             ++iGroup)
+          {
+            const unsigned int start = groupStarts[iGroup];
+            const unsigned int numberSphericalFunctionsInCell =
+              d_nonTrivialSphericalFnPerCell[cells[start]];
+            d_BLASWrapperPtr->xgemmBatched('N',
+                                           'N',
+                                           d_numberWaveFunctions,
+                                           d_numberNodesPerElement,
+                                           numberSphericalFunctionsInCell,
+                                           &one,
+                                           inputPointers.data() + start,
+                                           d_numberWaveFunctions,
+                                           CMatrixPointers.data() + start,
+                                           numberSphericalFunctionsInCell,
+                                           &one,
+                                           XoutPointers.data() + start,
+                                           d_numberWaveFunctions,
+                                           groupStarts[iGroup + 1] - start);
+          }
       }
 #if defined(DFTFE_WITH_DEVICE)
     else
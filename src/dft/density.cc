@@ -124,7 +124,8 @@ namespace dftfe
                             interBandGroupComm,
                             *d_dftParamsPtr,
                             isConsiderSpectrumSplitting &&
-                              d_numEigenValues != d_numEigenValuesRR);
+                              d_numEigenValues != d_numEigenValuesRR,
+                            d_nOMPThreads);
 #endif
         if (!d_dftParamsPtr->useDevice)
           computeRhoFromPSI(&d_eigenVectorsFlattenedHost,
@@ -149,7 +150,8 @@ namespace dftfe
                             interBandGroupComm,
                             *d_dftParamsPtr,
                             isConsiderSpectrumSplitting &&
-                              d_numEigenValues != d_numEigenValuesRR);
+                              d_numEigenValues != d_numEigenValuesRR,
+                            d_nOMPThreads);
         // normalizeRhoOutQuadValues();
 
         if (d_dftParamsPtr->computeEnergyEverySCF || isGroundState)
@@ -362,7 +364,8 @@ namespace dftfe
                         interBandGroupComm,
                         *d_dftParamsPtr,
                         isConsiderSpectrumSplitting &&
-                          d_numEigenValues != d_numEigenValuesRR);
+                          d_numEigenValues != d_numEigenValuesRR,
+                        d_nOMPThreads);
 #endif
     if (!d_dftParamsPtr->useDevice)
       computeRhoFromPSI(&d_eigenVectorsFlattenedHost,
@@ -386,7 +389,8 @@ namespace dftfe
                         interBandGroupComm,
                         *d_dftParamsPtr,
                         isConsiderSpectrumSplitting &&
-                          d_numEigenValues != d_numEigenValuesRR);
+                          d_numEigenValues != d_numEigenValuesRR,
+                        d_nOMPThreads);
 
     // copy Lobatto quadrature data to fill in 2p DoFHandler nodal data
     for (unsigned int iComp = 0; iComp < densityPRefinedNodalData.size();
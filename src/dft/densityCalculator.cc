@@ -21,6 +21,7 @@
 #include <constants.h>
 #include <densityCalculator.h>
 #include <dftUtils.h>
+#include <HostMemoryPool.h>
 #include <vectorUtilities.h>
 #include <MemoryStorage.h>
 #include <DataTypeOverloads.h>
@@ -64,9 +65,11 @@ namespace dftfe
     const MPI_Comm &     interpoolcomm,
     const MPI_Comm &     interBandGroupComm,
     const dftParameters &dftParams,
-    const bool           spectrumSplit)
+    const bool           spectrumSplit,
+    const unsigned int   nOMPThreads)
   {
-    int this_process;
+    dftfe::utils::HostMemoryPool::ScopedTag memoryTag("computeRhoFromPSI");
+    int                                     this_process;
     MPI_Comm_rank(mpiCommParent, &this_process);
 #if defined(DFTFE_WITH_DEVICE)
     if (memorySpace == dftfe::utils::MemorySpace::DEVICE)
@@ -109,8 +112,14 @@ namespace dftfe
     const NumberType scalarCoeffAlphaGradRho = 1.0;
     const NumberType scalarCoeffBetaGradRho  = 1.0;
 
+    // on the host a block of cells is interpolated by a single batched gemm
+    // and contracted into rho with OpenMP threads over the cells of the block
     const unsigned int cellsBlockSize =
-      memorySpace == dftfe::utils::MemorySpace::DEVICE ? 50 : 1;
+      memorySpace == dftfe::utils::MemorySpace::DEVICE ?
+        50 :
+        std::max(1u,
+                 std::min(dftParams.cellsBlockSizeDensityHost,
+                          totalLocallyOwnedCells));
     const unsigned int numCellBlocks = totalLocallyOwnedCells / cellsBlockSize;
     const unsigned int remCellBlockSize =
       totalLocallyOwnedCells - numCellBlocks * cellsBlockSize;
@@ -315,7 +324,8 @@ namespace dftfe
                                                numQuadPoints * 3,
                             isEvaluateGradRho,
                             dftParams.noncolin,
-                            dftParams.hasSOC);
+                            dftParams.hasSOC,
+                            nOMPThreads);
                         } // non-trivial cell block check
                     }     // cells block loop
                 }
@@ -448,7 +458,8 @@ namespace dftfe
                                                  numQuadPoints * 3,
                               isEvaluateGradRho,
                               dftParams.noncolin,
-                              dftParams.hasSOC);
+                              dftParams.hasSOC,
+                              nOMPThreads);
                           } // non-tivial cells block
                       }     // cells block loop
                   }
@@ -611,140 +622,169 @@ namespace dftfe
     double *                                    gradRho,
     const bool                                  isEvaluateGradRho,
     const bool                                  isNonCollin,
-    const bool                                  hasSOC)
+    const bool                                  hasSOC,
+    const unsigned int                          nOMPThreads)
   {
-    const unsigned int cellsBlockSize   = cellRange.second - cellRange.first;
     const unsigned int vectorsBlockSize = vecRange.second - vecRange.first;
     const unsigned int nQuadsPerCell    = basisOperationsPtr->nQuadsPerCell();
     const unsigned int nCells           = basisOperationsPtr->nCells();
+    const unsigned int nCellsQuads      = nCells * nQuadsPerCell;
+    // the occupation weighted sums over the wavefunctions are accumulated in
+    // registers for all the density components in a single pass, the real
+    // and imaginary parts are spelled out to keep the loops vectorizable
     if (isNonCollin || hasSOC)
-      for (unsigned int iCell = cellRange.first; iCell < cellRange.second;
-           ++iCell)
-        for (unsigned int iQuad = 0; iQuad < nQuadsPerCell; ++iQuad)
-          for (unsigned int iWave = 0; iWave < vecRange.second - vecRange.first;
-               ++iWave)
+      {
+#pragma omp parallel for num_threads(nOMPThreads) if (nOMPThreads > 1)
+        for (unsigned int iCell = cellRange.first; iCell < cellRange.second;
+             ++iCell)
+          for (unsigned int iQuad = 0; iQuad < nQuadsPerCell; ++iQuad)
             {
-              const NumberType psiUp =
-                wfcQuadPointData[(iCell - cellRange.first) * nQuadsPerCell *
-                                   vectorsBlockSize * 2 +
-                                 iQuad * vectorsBlockSize * 2 + iWave];
-              const NumberType psiDown =
-                wfcQuadPointData[(iCell - cellRange.first) * nQuadsPerCell *
-                                   vectorsBlockSize * 2 +
-                                 iQuad * vectorsBlockSize * 2 +
-                                 vectorsBlockSize + iWave];
-              rho[0 * nCells * nQuadsPerCell + iCell * nQuadsPerCell + iQuad] +=
-                partialOccupVec[iWave] *
-                (std::abs(psiUp * psiUp) + std::abs(psiDown * psiDown));
-              if (isNonCollin)
+              const NumberType *psiUp =
+                wfcQuadPointData + (iCell - cellRange.first) * nQuadsPerCell *
+                                     vectorsBlockSize * 2 +
+                iQuad * vectorsBlockSize * 2;
+              const NumberType *psiDown = psiUp + vectorsBlockSize;
+              double            rhoTotal = 0.0, magZ = 0.0, magY = 0.0,
+                     magX = 0.0;
+#pragma omp simd reduction(+ : rhoTotal, magZ, magY, magX)
+              for (unsigned int iWave = 0; iWave < vectorsBlockSize; ++iWave)
                 {
-                  rho[1 * nCells * nQuadsPerCell + iCell * nQuadsPerCell +
-                      iQuad] +=
-                    partialOccupVec[iWave] *
-                    (std::abs(psiUp * psiUp) - std::abs(psiDown * psiDown));
-                  rho[2 * nCells * nQuadsPerCell + iCell * nQuadsPerCell +
-                      iQuad] += partialOccupVec[iWave] * 2.0 *
-                                dftfe::utils::imagPart(
-                                  dftfe::utils::complexConj(psiUp) * psiDown);
-                  rho[3 * nCells * nQuadsPerCell + iCell * nQuadsPerCell +
-                      iQuad] += partialOccupVec[iWave] * 2.0 *
-                                dftfe::utils::realPart(
-                                  dftfe::utils::complexConj(psiUp) * psiDown);
+                  const double upReal = dftfe::utils::realPart(psiUp[iWave]);
+                  const double upImag = dftfe::utils::imagPart(psiUp[iWave]);
+                  const double downReal =
+                    dftfe::utils::realPart(psiDown[iWave]);
+                  const double downImag =
+                    dftfe::utils::imagPart(psiDown[iWave]);
+                  const double upSquare = upReal * upReal + upImag * upImag;
+                  const double downSquare =
+                    downReal * downReal + downImag * downImag;
+                  rhoTotal += partialOccupVec[iWave] * (upSquare + downSquare);
+                  magZ += partialOccupVec[iWave] * (upSquare - downSquare);
+                  magY += partialOccupVec[iWave] * 2.0 *
+                          (upReal * downImag - upImag * downReal);
+                  magX += partialOccupVec[iWave] * 2.0 *
+                          (upReal * downReal + upImag * downImag);
                 }
-              if (isEvaluateGradRho)
+              rho[iCell * nQuadsPerCell + iQuad] += rhoTotal;
+              if (isNonCollin)
                 {
-                  for (unsigned int iDim = 0; iDim < 3; ++iDim)
-                    {
-                      const NumberType gradPsiUp = gradWfcQuadPointData
-                        [(iCell - cellRange.first) * nQuadsPerCell *
-                           vectorsBlockSize * 3 * 2 +
-                         iDim * nQuadsPerCell * vectorsBlockSize * 2 +
-                         iQuad * vectorsBlockSize * 2 + iWave];
-                      const NumberType gradPsiDown =
-                        gradWfcQuadPointData[(iCell - cellRange.first) *
-                                               nQuadsPerCell *
-                                               vectorsBlockSize * 3 * 2 +
-                                             iDim * nQuadsPerCell *
-                                               vectorsBlockSize * 2 +
-                                             iQuad * vectorsBlockSize * 2 +
-                                             vectorsBlockSize + iWave];
-                      gradRho[0 * nCells * nQuadsPerCell * 3 +
-                              iCell * nQuadsPerCell * 3 + 3 * iQuad + iDim] +=
-                        2.0 * partialOccupVec[iWave] *
-                        dftfe::utils::realPart(
-                          dftfe::utils::complexConj(psiUp) * gradPsiUp +
-                          dftfe::utils::complexConj(psiDown) * gradPsiDown);
-                      if (isNonCollin)
-                        {
-                          gradRho[1 * nCells * nQuadsPerCell * 3 +
-                                  iCell * nQuadsPerCell * 3 + 3 * iQuad +
-                                  iDim] +=
-                            2.0 * partialOccupVec[iWave] *
-                            dftfe::utils::realPart(
-                              dftfe::utils::complexConj(psiUp) * gradPsiUp -
-                              dftfe::utils::complexConj(psiDown) * gradPsiDown);
-                          gradRho[2 * nCells * nQuadsPerCell * 3 +
-                                  iCell * nQuadsPerCell * 3 + 3 * iQuad +
-                                  iDim] +=
-                            2.0 * partialOccupVec[iWave] *
-                            dftfe::utils::imagPart(
-                              dftfe::utils::complexConj(gradPsiUp) * psiDown +
-                              dftfe::utils::complexConj(psiUp) * gradPsiDown);
-                          gradRho[3 * nCells * nQuadsPerCell * 3 +
-                                  iCell * nQuadsPerCell * 3 + 3 * iQuad +
-                                  iDim] +=
-                            2.0 * partialOccupVec[iWave] *
-                            dftfe::utils::realPart(
-                              dftfe::utils::complexConj(gradPsiUp) * psiDown +
-                              dftfe::utils::complexConj(psiUp) * gradPsiDown);
-                        }
-                    }
+                  rho[1 * nCellsQuads + iCell * nQuadsPerCell + iQuad] += magZ;
+                  rho[2 * nCellsQuads + iCell * nQuadsPerCell + iQuad] += magY;
+                  rho[3 * nCellsQuads + iCell * nQuadsPerCell + iQuad] += magX;
                 }
+              if (isEvaluateGradRho)
+                for (unsigned int iDim = 0; iDim < 3; ++iDim)
+                  {
+                    const NumberType *gradPsiUp =
+                      gradWfcQuadPointData +
+                      (iCell - cellRange.first) * nQuadsPerCell *
+                        vectorsBlockSize * 3 * 2 +
+                      iDim * nQuadsPerCell * vectorsBlockSize * 2 +
+                      iQuad * vectorsBlockSize * 2;
+                    const NumberType *gradPsiDown =
+                      gradPsiUp + vectorsBlockSize;
+                    double gradRhoTotal = 0.0, gradMagZ = 0.0, gradMagY = 0.0,
+                           gradMagX = 0.0;
+#pragma omp simd reduction(+ : gradRhoTotal, gradMagZ, gradMagY, gradMagX)
+                    for (unsigned int iWave = 0; iWave < vectorsBlockSize;
+                         ++iWave)
+                      {
+                        const double upReal =
+                          dftfe::utils::realPart(psiUp[iWave]);
+                        const double upImag =
+                          dftfe::utils::imagPart(psiUp[iWave]);
+                        const double downReal =
+                          dftfe::utils::realPart(psiDown[iWave]);
+                        const double downImag =
+                          dftfe::utils::imagPart(psiDown[iWave]);
+                        const double gradUpReal =
+                          dftfe::utils::realPart(gradPsiUp[iWave]);
+                        const double gradUpImag =
+                          dftfe::utils::imagPart(gradPsiUp[iWave]);
+                        const double gradDownReal =
+                          dftfe::utils::realPart(gradPsiDown[iWave]);
+                        const double gradDownImag =
+                          dftfe::utils::imagPart(gradPsiDown[iWave]);
+                        // Re(conj(psi)*gradPsi) of the two spinor components
+                        const double upGradUp =
+                          upReal * gradUpReal + upImag * gradUpImag;
+                        const double downGradDown =
+                          downReal * gradDownReal + downImag * gradDownImag;
+                        // conj(gradPsiUp)*psiDown + conj(psiUp)*gradPsiDown
+                        const double crossReal =
+                          gradUpReal * downReal + gradUpImag * downImag +
+                          upReal * gradDownReal + upImag * gradDownImag;
+                        const double crossImag =
+                          gradUpReal * downImag - gradUpImag * downReal +
+                          upReal * gradDownImag - upImag * gradDownReal;
+                        const double occupFactor = 2.0 * partialOccupVec[iWave];
+                        gradRhoTotal += occupFactor * (upGradUp + downGradDown);
+                        gradMagZ += occupFactor * (upGradUp - downGradDown);
+                        gradMagY += occupFactor * crossImag;
+                        gradMagX += occupFactor * crossReal;
+                      }
+                    gradRho[iCell * nQuadsPerCell * 3 + 3 * iQuad + iDim] +=
+                      gradRhoTotal;
+                    if (isNonCollin)
+                      {
+                        gradRho[1 * nCellsQuads * 3 +
+                                iCell * nQuadsPerCell * 3 + 3 * iQuad + iDim] +=
+                          gradMagZ;
+                        gradRho[2 * nCellsQuads * 3 +
+                                iCell * nQuadsPerCell * 3 + 3 * iQuad + iDim] +=
+                          gradMagY;
+                        gradRho[3 * nCellsQuads * 3 +
+                                iCell * nQuadsPerCell * 3 + 3 * iQuad + iDim] +=
+                          gradMagX;
+                      }
+                  }
             }
+      }
     else
-      for (unsigned int iCell = cellRange.first; iCell < cellRange.second;
-           ++iCell)
-        for (unsigned int iQuad = 0; iQuad < nQuadsPerCell; ++iQuad)
-          for (unsigned int iWave = 0; iWave < vecRange.second - vecRange.first;
-               ++iWave)
+      {
+#pragma omp parallel for num_threads(nOMPThreads) if (nOMPThreads > 1)
+        for (unsigned int iCell = cellRange.first; iCell < cellRange.second;
+             ++iCell)
+          for (unsigned int iQuad = 0; iQuad < nQuadsPerCell; ++iQuad)
             {
-              const NumberType psi =
-                wfcQuadPointData[(iCell - cellRange.first) * nQuadsPerCell *
-                                   vectorsBlockSize +
-                                 iQuad * vectorsBlockSize + iWave];
-              rho[iCell * nQuadsPerCell + iQuad] +=
-                partialOccupVec[iWave] * std::abs(psi) * std::abs(psi);
-              if (isEvaluateGradRho)
+              const NumberType *psi =
+                wfcQuadPointData + (iCell - cellRange.first) * nQuadsPerCell *
+                                     vectorsBlockSize +
+                iQuad * vectorsBlockSize;
+              double rhoQuad = 0.0;
+#pragma omp simd reduction(+ : rhoQuad)
+              for (unsigned int iWave = 0; iWave < vectorsBlockSize; ++iWave)
                 {
-                  gradRho[iCell * nQuadsPerCell * 3 + 3 * iQuad] +=
-                    2 * partialOccupVec[iWave] *
-                    dftfe::utils::realPart(
-                      dftfe::utils::complexConj(psi) *
-                      gradWfcQuadPointData[(iCell - cellRange.first) *
-                                             nQuadsPerCell * vectorsBlockSize *
-                                             3 +
-                                           iQuad * vectorsBlockSize + iWave]);
-                  gradRho[iCell * nQuadsPerCell * 3 + 3 * iQuad + 1] +=
-                    2 * partialOccupVec[iWave] *
-                    dftfe::utils::realPart(
-                      dftfe::utils::complexConj(psi) *
-                      gradWfcQuadPointData[(iCell - cellRange.first) *
-                                             nQuadsPerCell * vectorsBlockSize *
-                                             3 +
-                                           nQuadsPerCell * vectorsBlockSize +
-                                           iQuad * vectorsBlockSize + iWave]);
-                  gradRho[iCell * nQuadsPerCell * 3 + 3 * iQuad + 2] +=
-                    2 * partialOccupVec[iWave] *
-                    dftfe::utils::realPart(
-                      dftfe::utils::complexConj(psi) *
-                      gradWfcQuadPointData[(iCell - cellRange.first) *
-                                             nQuadsPerCell * vectorsBlockSize *
-                                             3 +
-                                           2 * nQuadsPerCell *
-                                             vectorsBlockSize +
-                                           iQuad * vectorsBlockSize + iWave]);
+                  const double psiReal = dftfe::utils::realPart(psi[iWave]);
+                  const double psiImag = dftfe::utils::imagPart(psi[iWave]);
+                  rhoQuad += partialOccupVec[iWave] *
+                             (psiReal * psiReal + psiImag * psiImag);
                 }
+              rho[iCell * nQuadsPerCell + iQuad] += rhoQuad;
+              if (isEvaluateGradRho)
+                for (unsigned int iDim = 0; iDim < 3; ++iDim)
+                  {
+                    const NumberType *gradPsi =
+                      gradWfcQuadPointData +
+                      (iCell - cellRange.first) * nQuadsPerCell *
+                        vectorsBlockSize * 3 +
+                      iDim * nQuadsPerCell * vectorsBlockSize +
+                      iQuad * vectorsBlockSize;
+                    double gradRhoQuad = 0.0;
+#pragma omp simd reduction(+ : gradRhoQuad)
+                    for (unsigned int iWave = 0; iWave < vectorsBlockSize;
+                         ++iWave)
+                      gradRhoQuad +=
+                        2.0 * partialOccupVec[iWave] *
+                        (dftfe::utils::realPart(psi[iWave]) *
+                           dftfe::utils::realPart(gradPsi[iWave]) +
+                         dftfe::utils::imagPart(psi[iWave]) *
+                           dftfe::utils::imagPart(gradPsi[iWave]));
+                    gradRho[iCell * nQuadsPerCell * 3 + 3 * iQuad + iDim] +=
+                      gradRhoQuad;
+                  }
             }
+      }
   }
 #if defined(DFTFE_WITH_DEVICE)
   template void
@@ -781,7 +821,8 @@ namespace dftfe
     const MPI_Comm &     interpoolcomm,
     const MPI_Comm &     interBandGroupComm,
     const dftParameters &dftParams,
-    const bool           spectrumSplit);
+    const bool           spectrumSplit,
+    const unsigned int   nOMPThreads);
 #endif
 
   template void
@@ -818,5 +859,6 @@ namespace dftfe
     const MPI_Comm &     interpoolcomm,
     const MPI_Comm &     interBandGroupComm,
     const dftParameters &dftParams,
-    const bool           spectrumSplit);
+    const bool           spectrumSplit,
+    const unsigned int   nOMPThreads);
 } // namespace dftfe
@@ -276,7 +276,8 @@ namespace dftfe
     double *                                    gradRho,
     const bool                                  isEvaluateGradRho,
     const bool                                  isNonCollin,
-    const bool                                  hasSOC)
+    const bool                                  hasSOC,
+    const unsigned int                          nOMPThreads)
   {
     const unsigned int cellsBlockSize   = cellRange.second - cellRange.first;
     const unsigned int vectorsBlockSize = vecRange.second - vecRange.first;
@@ -416,6 +417,7 @@ namespace dftfe
     double *                                    gradRho,
     const bool                                  isEvaluateGradRho,
     const bool                                  isNonCollin,
-    const bool                                  hasSOC);
+    const bool                                  hasSOC,
+    const unsigned int                          nOMPThreads);
 
 } // namespace dftfe
@@ -40,6 +40,8 @@
 #include <MemoryTransfer.h>
 #include <QuadDataCompositeWrite.h>
 #include <MPIWriteOnFile.h>
+#include <HostMemoryPool.h>
+#include <MPICommunicatorP2P.h>
 
 #include <algorithm>
 #include <cmath>
@@ -148,7 +150,11 @@ namespace dftfe
 #endif
     , d_phiTotalSolverProblem(mpi_comm_domain)
     , d_phiPrimeSolverProblem(mpi_comm_domain)
-    , d_mixingScheme(mpi_comm_parent, mpi_comm_domain, dftParams.verbosity)
+    , d_mixingScheme(mpi_comm_parent,
+                     mpi_comm_domain,
+                     dftParams.verbosity,
+                     dftParams.incrementalMixingGramMatrix,
+                     dftParams.mixingHistoryScheme == "BROYDEN")
   {
     if (d_dftParamsPtr->usepCoarsenedSolve)
       {
@@ -207,6 +213,20 @@ namespace dftfe
       }
     if (d_dftParamsPtr->verbosity > 0)
       pcout << "Threads per MPI task: " << d_nOMPThreads << std::endl;
+    dftfe::utils::HostMemoryPool::instance().setEnabled(
+      d_dftParamsPtr->useHostMemoryPool);
+    dftfe::utils::HostMemoryPool::instance().setMaxCachedBytes(
+      std::size_t(d_dftParamsPtr->hostMemoryPoolCacheSizeMB) * 1024 * 1024);
+    if (d_dftParamsPtr->mpiP2PCommunicationMode == "PERSISTENT")
+      dftfe::utils::mpi::setDefaultCommunicationMode(
+        dftfe::utils::mpi::communicationMode::persistent);
+    else if (d_dftParamsPtr->mpiP2PCommunicationMode ==
+             "NEIGHBORHOOD COLLECTIVE")
+      dftfe::utils::mpi::setDefaultCommunicationMode(
+        dftfe::utils::mpi::communicationMode::neighborhoodCollective);
+    else
+      dftfe::utils::mpi::setDefaultCommunicationMode(
+        dftfe::utils::mpi::communicationMode::nonBlocking);
     d_elpaScala = new dftfe::elpaScalaManager(mpi_comm_domain);
 
     forcePtr = new forceClass<FEOrder, FEOrderElectro, memorySpace>(
@@ -214,8 +234,9 @@ namespace dftfe
     symmetryPtr = new symmetryClass<FEOrder, FEOrderElectro, memorySpace>(
       this, mpi_comm_parent, mpi_comm_domain, _interpoolcomm);
 
-    d_excManagerPtr                   = std::make_shared<excManager>();
-    d_isRestartGroundStateCalcFromChk = false;
+    d_excManagerPtr                       = std::make_shared<excManager>();
+    d_isRestartGroundStateCalcFromChk     = false;
+    d_numberChebyshevFilterPassesLastSolve = 0;
 
 #if defined(DFTFE_WITH_DEVICE)
     d_devicecclMpiCommDomainPtr = new utils::DeviceCCLWrapper;
@@ -769,7 +790,7 @@ namespace dftfe
                   << std::endl;
           }
       }
-    // convert pseudopotential files in upf format to dftfe format
+    // read pseudopotential files in upf format
     if (d_dftParamsPtr->verbosity >= 1)
       {
         pcout
@@ -780,16 +801,15 @@ namespace dftfe
 
     int              nlccFlag = 0;
     std::vector<int> pspFlags(2, 0);
-    if (dealii::Utilities::MPI::this_mpi_process(d_mpiCommParent) == 0 &&
-        d_dftParamsPtr->isPseudopotential == true)
+    if (d_dftParamsPtr->isPseudopotential == true)
       pspFlags = pseudoUtils::convert(d_dftParamsPtr->pseudoPotentialFile,
-                                      d_dftfeScratchFolderName,
+                                      d_mpiCommParent,
                                       d_dftParamsPtr->verbosity,
                                       d_dftParamsPtr->natomTypes,
-                                      d_dftParamsPtr->pseudoTestsFlag);
+                                      d_dftParamsPtr->pseudoTestsFlag,
+                                      d_pseudoPotentialData);
 
     nlccFlag = pspFlags[0];
-    nlccFlag = dealii::Utilities::MPI::sum(nlccFlag, d_mpiCommParent);
     if (nlccFlag > 0 && d_dftParamsPtr->isPseudopotential == true)
       d_dftParamsPtr->nonLinearCoreCorrection = true;
     // estimate total number of wave functions from atomic orbital filling
@@ -859,7 +879,7 @@ namespace dftfe
         d_oncvClassPtr =
           std::make_shared<dftfe::oncvClass<dataTypes::number, memorySpace>>(
             mpi_communicator, // domain decomposition communicator
-            d_dftfeScratchFolderName,
+            d_pseudoPotentialData,
             atomTypes,
             d_dftParamsPtr->floatingNuclearCharges,
             d_nOMPThreads,
@@ -1262,6 +1282,9 @@ namespace dftfe
 
     if (d_dftParamsPtr->loadRhoData)
       {
+        if (d_dftParamsPtr->loadWfcData)
+          loadWaveFunctionsAndEigenData();
+
         if (d_dftParamsPtr->verbosity >= 1)
           pcout
             << "Overwriting input density data to SCF solve with data read from restart file.."
@@ -1432,6 +1455,10 @@ namespace dftfe
 
     if (useSingleAtomSolutionOverride)
       {
+        // the single atom wavefunctions replace the extrapolation history
+        d_wfcExtrapolationHistory.clear();
+        d_wfcExtrapolationPrediction.clear();
+
         readPSI();
         initRho();
       }
@@ -1443,7 +1470,10 @@ namespace dftfe
         // if(d_dftParamsPtr->mixingMethod != "ANDERSON_WITH_KERKER")
         //   solveNoSCF();
 
-        if (!d_dftParamsPtr->reuseWfcGeoOpt)
+        // the extrapolated wavefunctions are the initial guess
+        if (!d_dftParamsPtr->reuseWfcGeoOpt &&
+            !(d_dftParamsPtr->extrapolateWfc &&
+              d_dftParamsPtr->solverMode == "MD"))
           readPSI();
 
         noRemeshRhoDataInit();
@@ -2044,6 +2074,9 @@ namespace dftfe
     if (d_dftParamsPtr->writeLocalizationLengths)
       compute_localizationLength("localizationLengths.out");
 
+    if (d_dftParamsPtr->useHostMemoryPool && d_dftParamsPtr->verbosity >= 1)
+      dftUtils::printHostMemoryPoolStatistics(d_mpiCommParent);
+
     if (d_dftParamsPtr->verbosity >= 1)
       pcout
         << std::endl
@@ -2432,6 +2465,15 @@ namespace dftfe
       firstScfChebyTol = d_dftParamsPtr->chebyshevTolerance > 1e-3 ?
                            1e-3 :
                            d_dftParamsPtr->chebyshevTolerance;
+
+    // build the cell Hamiltonian matrices of all the k-points of the pool
+    // from the k-point independent part shared by the k-points of the pool
+    const bool isCellHamiltonianBatchedkPoints =
+      std::is_same<dataTypes::number, std::complex<double>>::value &&
+      d_dftParamsPtr->sharedKPointHamiltonian && !d_dftParamsPtr->noncolin &&
+      !d_dftParamsPtr->memOptMode && !d_dftParamsPtr->matrixFreeHamiltonian &&
+      d_kPointWeights.size() > 1;
+
     std::vector<mixingVariable> mixingVariables;
     std::vector<mixingVariable> gradMixingVariables;
     mixingVariables.resize(d_dftParamsPtr->noncolin ?
@@ -2552,6 +2594,7 @@ namespace dftfe
       d_dftParamsPtr->chebyshevTolerance;
     bool scfConverged           = false;
     bool pCoarsenedSCFConverged = false;
+    d_numberChebyshevFilterPassesLastSolve = 0;
     bool ispCoarsenedMesh       = d_dftParamsPtr->usepCoarsenedSolve;
     pcout << std::endl;
     if (d_dftParamsPtr->verbosity == 0)
@@ -3090,6 +3133,15 @@ namespace dftfe
                                                       s);
                 computing_timer.leave_subsection("VEff Computation");
 
+                if (isCellHamiltonianBatchedkPoints)
+                  {
+                    computing_timer.enter_subsection(
+                      "Hamiltonian Matrix Computation");
+                    d_kohnShamDFTOperatorPtr
+                      ->computeCellHamiltonianMatrixBatchedkPoints(s);
+                    computing_timer.leave_subsection(
+                      "Hamiltonian Matrix Computation");
+                  }
 
                 for (unsigned int kPoint = 0; kPoint < d_kPointWeights.size();
                      ++kPoint)
@@ -3097,12 +3149,15 @@ namespace dftfe
                     d_kohnShamDFTOperatorPtr->reinitkPointSpinIndex(kPoint, s);
 
 
-
-                    computing_timer.enter_subsection(
-                      "Hamiltonian Matrix Computation");
-                    d_kohnShamDFTOperatorPtr->computeCellHamiltonianMatrix();
-                    computing_timer.leave_subsection(
-                      "Hamiltonian Matrix Computation");
+                    if (!isCellHamiltonianBatchedkPoints)
+                      {
+                        computing_timer.enter_subsection(
+                          "Hamiltonian Matrix Computation");
+                        d_kohnShamDFTOperatorPtr
+                          ->computeCellHamiltonianMatrix();
+                        computing_timer.leave_subsection(
+                          "Hamiltonian Matrix Computation");
+                      }
 
 
                     for (unsigned int j = 0; j < 1; ++j)
@@ -3375,6 +3430,15 @@ namespace dftfe
                                                   d_gradRhoCore);
             computing_timer.leave_subsection("VEff Computation");
 
+            if (isCellHamiltonianBatchedkPoints)
+              {
+                computing_timer.enter_subsection(
+                  "Hamiltonian Matrix Computation");
+                d_kohnShamDFTOperatorPtr
+                  ->computeCellHamiltonianMatrixBatchedkPoints(0);
+                computing_timer.leave_subsection(
+                  "Hamiltonian Matrix Computation");
+              }
 
             for (unsigned int kPoint = 0; kPoint < d_kPointWeights.size();
                  ++kPoint)
@@ -3382,11 +3446,14 @@ namespace dftfe
                 d_kohnShamDFTOperatorPtr->reinitkPointSpinIndex(kPoint, 0);
 
 
-                computing_timer.enter_subsection(
-                  "Hamiltonian Matrix Computation");
-                d_kohnShamDFTOperatorPtr->computeCellHamiltonianMatrix();
-                computing_timer.leave_subsection(
-                  "Hamiltonian Matrix Computation");
+                if (!isCellHamiltonianBatchedkPoints)
+                  {
+                    computing_timer.enter_subsection(
+                      "Hamiltonian Matrix Computation");
+                    d_kohnShamDFTOperatorPtr->computeCellHamiltonianMatrix();
+                    computing_timer.leave_subsection(
+                      "Hamiltonian Matrix Computation");
+                  }
 
 
                 for (unsigned int j = 0; j < 1; ++j)
@@ -3852,12 +3919,17 @@ namespace dftfe
                 << "Number of Chebyshev filtered subspace iterations: "
                 << numberChebyshevSolvePasses << std::endl
                 << std::endl;
+        d_numberChebyshevFilterPassesLastSolve += numberChebyshevSolvePasses;
         //
         scfIter++;
 
         if (d_dftParamsPtr->saveRhoData && scfIter % 10 == 0 &&
             d_dftParamsPtr->solverMode == "GS")
-          saveTriaInfoAndRhoNodalData();
+          {
+            saveTriaInfoAndRhoNodalData();
+            if (d_dftParamsPtr->saveWfcData)
+              saveWaveFunctionsAndEigenData();
+          }
       }
 
     if (d_dftParamsPtr->saveRhoData &&
@@ -4123,6 +4195,10 @@ namespace dftfe
       d_eigenVectorsFlattenedDevice.copyTo(d_eigenVectorsFlattenedHost);
 #endif
 
+    if (d_dftParamsPtr->saveWfcData &&
+        !(d_dftParamsPtr->solverMode == "GS" && scfIter % 10 == 0))
+      saveWaveFunctionsAndEigenData();
+
 
     if (d_dftParamsPtr->isIonForce)
       {
@@ -4981,6 +5057,16 @@ namespace dftfe
     return d_rhoOutNodalValuesSplit;
   }
 
+  template <unsigned int              FEOrder,
+            unsigned int              FEOrderElectro,
+            dftfe::utils::MemorySpace memorySpace>
+  unsigned int
+  dftClass<FEOrder, FEOrderElectro, memorySpace>::
+    getNumberChebyshevFilterPassesLastSolve() const
+  {
+    return d_numberChebyshevFilterPassesLastSolve;
+  }
+
   template <unsigned int              FEOrder,
             unsigned int              FEOrderElectro,
             dftfe::utils::MemorySpace memorySpace>
@@ -16,6 +16,8 @@
 //
 // @author Phani Motamarri
 //
+#include <AtomSpatialIndex.h>
+#include <densityOfStates.h>
 #include <dft.h>
 #include <fileReaders.h>
 #include <vectorUtilities.h>
@@ -137,6 +139,178 @@ namespace dftfe
           wfcInitTruncation = maxTruncationRadius;
       }
   }
+  namespace internal
+  {
+    // centroid of a locally owned cell from its quadrature points, indexed by
+    // [iCell * numQuadPoints * 3 + iQuad * 3 + iDim]
+    void
+    getCellCentroid(const double *     quadPoints,
+                    const unsigned int iCell,
+                    const unsigned int numQuadPoints,
+                    double *           centroid)
+    {
+      for (unsigned int d = 0; d < 3; ++d)
+        {
+          centroid[d] = 0.0;
+          for (unsigned int q = 0; q < numQuadPoints; ++q)
+            centroid[d] += quadPoints[(iCell * numQuadPoints + q) * 3 + d];
+          centroid[d] /= numQuadPoints;
+        }
+    }
+
+    // copies the wavefunctions [startVec, startVec + blockSize) of one k-point
+    // and spin index into a flattened multivector and applies the constraints
+    void
+    copyWaveFunctionsBlock(
+      const dftfe::basis::FEBasisOperations<dataTypes::number,
+                                            double,
+                                            dftfe::utils::MemorySpace::HOST>
+        &                      basisOperations,
+      const dataTypes::number *X,
+      const unsigned int       totalNumWaveFunctions,
+      const unsigned int       numWfnSpinors,
+      const unsigned int       startVec,
+      const unsigned int       blockSize,
+      dftfe::linearAlgebra::MultiVector<dataTypes::number,
+                                        dftfe::utils::MemorySpace::HOST>
+        &flattenedArrayBlock)
+    {
+      const unsigned int numLocalDofs = basisOperations.nOwnedDofs();
+      for (unsigned int iNode = 0; iNode < numLocalDofs * numWfnSpinors;
+           ++iNode)
+        std::memcpy(flattenedArrayBlock.data() + iNode * blockSize,
+                    X +
+                      (dealii::types::global_dof_index)iNode *
+                        totalNumWaveFunctions +
+                      startVec,
+                    blockSize * sizeof(dataTypes::number));
+      flattenedArrayBlock.updateGhostValues();
+      basisOperations.distribute(flattenedArrayBlock);
+    }
+
+    void
+    computeSmearingKernel(const double *       eigenValues,
+                          const unsigned int   numStates,
+                          const double         lowerBoundEpsilon,
+                          const double         intervalSize,
+                          const unsigned int   numberIntervals,
+                          const double         sigma,
+                          const double         scalingFactor,
+                          std::vector<double> &smearingKernel)
+    {
+      for (unsigned int iState = 0; iState < numStates; ++iState)
+        for (unsigned int epsInt = 0; epsInt < numberIntervals; ++epsInt)
+          {
+            const double term1 =
+              lowerBoundEpsilon + epsInt * intervalSize - eigenValues[iState];
+            smearingKernel[iState * numberIntervals + epsInt] =
+              scalingFactor * (sigma / M_PI) *
+              (1.0 / (term1 * term1 + sigma * sigma));
+          }
+    }
+
+    void
+    computeSpinorNormSquared(const dataTypes::number *values,
+                             const unsigned int       numRows,
+                             const unsigned int       numWfnSpinors,
+                             const unsigned int       blockSize,
+                             double *                 normSquared)
+    {
+      const unsigned int numVec = blockSize * numWfnSpinors;
+      for (unsigned int iRow = 0; iRow < numRows; ++iRow)
+        for (unsigned int iWave = 0; iWave < blockSize; ++iWave)
+          {
+            double value = 0.0;
+            for (unsigned int iSpinor = 0; iSpinor < numWfnSpinors; ++iSpinor)
+              value +=
+                std::norm(values[iRow * numVec + iSpinor * blockSize + iWave]);
+            normSquared[iRow * blockSize + iWave] = value;
+          }
+    }
+
+    void
+    accumulateSmearedDensityOfStates(
+      const dftfe::linearAlgebra::BLASWrapper<dftfe::utils::MemorySpace::HOST>
+        &                  BLASWrapper,
+      const double *       eigenValues,
+      const unsigned int   numStates,
+      const double         lowerBoundEpsilon,
+      const double         intervalSize,
+      const unsigned int   numberIntervals,
+      const double         sigma,
+      const double         scalingFactor,
+      const double *       stateWeights,
+      const unsigned int   numRegions,
+      std::vector<double> &smearingKernel,
+      double *             densityOfStates)
+    {
+      const double scalarCoeffOne = 1.0;
+      computeSmearingKernel(eigenValues,
+                            numStates,
+                            lowerBoundEpsilon,
+                            intervalSize,
+                            numberIntervals,
+                            sigma,
+                            scalingFactor,
+                            smearingKernel);
+      BLASWrapper.xgemm('N',
+                        'N',
+                        numberIntervals,
+                        numRegions,
+                        numStates,
+                        &scalarCoeffOne,
+                        smearingKernel.data(),
+                        numberIntervals,
+                        stateWeights,
+                        numStates,
+                        &scalarCoeffOne,
+                        densityOfStates,
+                        numberIntervals);
+    }
+
+    // single atom orbital at a point relative to the atom, real spherical
+    // harmonics are used for the angular part
+    double
+    evaluateSingleAtomOrbital(const orbital &dataOrb,
+                              const double   x,
+                              const double   y,
+                              const double   z,
+                              const double   truncationRadius)
+    {
+      const double r = std::sqrt(x * x + y * y + z * z);
+      if (r > truncationRadius)
+        return 0.0;
+
+      double theta = std::acos(z / r);
+      double phi   = std::atan2(y, x);
+      if (r == 0)
+        {
+          theta = 0;
+          phi   = 0;
+        }
+
+      const double R = alglib::spline1dcalc(dataOrb.psi, r);
+      if (dataOrb.m > 0)
+        return R * std::sqrt(2) *
+               boost::math::spherical_harmonic_r(dataOrb.l,
+                                                 dataOrb.m,
+                                                 theta,
+                                                 phi);
+      else if (dataOrb.m == 0)
+        return R * boost::math::spherical_harmonic_r(dataOrb.l,
+                                                     dataOrb.m,
+                                                     theta,
+                                                     phi);
+      else
+        return R * std::sqrt(2) *
+               boost::math::spherical_harmonic_i(dataOrb.l,
+                                                 -dataOrb.m,
+                                                 theta,
+                                                 phi);
+    }
+  } // namespace internal
+
+
 
 
 
@@ -377,9 +551,6 @@ namespace dftfe
     const std::string &                     ldosFileName)
   {
     computing_timer.enter_subsection("LDOS computation");
-    //
-    // create a map of cellId and atomId
-    //
 
     // loop over elements
     std::vector<double> eigenValuesAllkPoints;
@@ -420,302 +591,185 @@ namespace dftfe
       std::ceil((upperBoundEpsilon - lowerBoundEpsilon) / intervalSize);
     unsigned int numberGlobalAtoms = atomLocations.size();
 
-    // map each cell to an atom based on closest atom to the centroid of each
-    // cell
-    typename dealii::DoFHandler<3>::active_cell_iterator
-      cell = dofHandler.begin_active(),
-      endc = dofHandler.end();
-    std::map<dealii::CellId, unsigned int> cellToAtomIdMap;
-    for (; cell != endc; ++cell)
-      {
-        if (cell->is_locally_owned())
-          {
-            const dealii::Point<3> center(cell->center());
-
-            // loop over all atoms
-            double           distanceToClosestAtom = 1e8;
-            dealii::Point<3> closestAtom;
-            unsigned int     closestAtomId;
-            for (unsigned int n = 0; n < atomLocations.size(); n++)
-              {
-                dealii::Point<3> atom(atomLocations[n][2],
-                                      atomLocations[n][3],
-                                      atomLocations[n][4]);
-                if (center.distance(atom) < distanceToClosestAtom)
-                  {
-                    distanceToClosestAtom = center.distance(atom);
-                    closestAtom           = atom;
-                    closestAtomId         = n;
-                  }
-              }
-            cellToAtomIdMap[cell->id()] = closestAtomId;
-          }
-      }
-
-    std::vector<double> localDensityOfStates, localDensityOfStatesUp,
-      localDensityOfStatesDown;
-    localDensityOfStates.resize(numberGlobalAtoms * numberIntervals, 0.0);
-    if (d_dftParamsPtr->spinPolarized == 1)
-      {
-        localDensityOfStatesUp.resize(numberGlobalAtoms * numberIntervals, 0.0);
-        localDensityOfStatesDown.resize(numberGlobalAtoms * numberIntervals,
-                                        0.0);
-      }
-
-    // access finite-element data
-    dealii::QGauss<3>   quadrature_formula(C_num1DQuad<FEOrder>());
-    dealii::FEValues<3> fe_values(dofHandler.get_fe(),
-                                  quadrature_formula,
-                                  dealii::update_values |
-                                    dealii::update_JxW_values);
-    const unsigned int  dofs_per_cell = dofHandler.get_fe().dofs_per_cell;
-    const unsigned int  n_q_points    = quadrature_formula.size();
+    const unsigned int numSpinComponents =
+      (d_dftParamsPtr->spinPolarized == 1) ? 2 : 1;
+    const unsigned int numWfnSpinors =
+      (d_dftParamsPtr->noncolin || d_dftParamsPtr->hasSOC) ? 2 : 1;
+    const double spinPolarizedFactor =
+      (numSpinComponents == 2 || numWfnSpinors == 2) ? 1.0 : 2.0;
 
+#ifdef DFTFE_WITH_DEVICE
+    if constexpr (dftfe::utils::MemorySpace::DEVICE == memorySpace)
+      d_eigenVectorsFlattenedDevice.copyTo(d_eigenVectorsFlattenedHost);
+#endif
 
+    const unsigned int numLocalDofs = d_basisOperationsPtrHost->nOwnedDofs();
+    const unsigned int totalLocallyOwnedCells =
+      d_basisOperationsPtrHost->nCells();
     const unsigned int blockSize =
       std::min(d_dftParamsPtr->wfcBlockSize, d_numEigenValues);
+    const unsigned int cellsBlockSize =
+      std::max(1u,
+               std::min(d_dftParamsPtr->cellsBlockSizeDensityHost,
+                        totalLocallyOwnedCells));
+    d_basisOperationsPtrHost->reinit(blockSize * numWfnSpinors,
+                                     cellsBlockSize,
+                                     d_densityQuadratureId);
+    const unsigned int numQuadPoints =
+      d_basisOperationsPtrHost->nQuadsPerCell();
+
+    const double *quadPoints = d_basisOperationsPtrHost->quadPoints().data();
+    const double *JxW        = d_basisOperationsPtrHost->JxWBasisData().data();
+
+    // map each cell to an atom based on closest atom to the centroid of each
+    // cell
+    std::vector<double> atomPoints(3 * numberGlobalAtoms);
+    for (unsigned int iAtom = 0; iAtom < numberGlobalAtoms; ++iAtom)
+      for (unsigned int d = 0; d < 3; ++d)
+        atomPoints[3 * iAtom + d] = atomLocations[iAtom][2 + d];
+    const utils::AtomSpatialIndex atomsSpatialIndex(atomPoints);
+    std::vector<unsigned int>     cellToAtomIds(totalLocallyOwnedCells);
+    for (unsigned int iCell = 0; iCell < totalLocallyOwnedCells; ++iCell)
+      {
+        double centroid[3], distanceToClosestAtom;
+        internal::getCellCentroid(quadPoints, iCell, numQuadPoints, centroid);
+        cellToAtomIds[iCell] =
+          atomsSpatialIndex.findClosestPoint(centroid, distanceToClosestAtom);
+      }
 
-    std::vector<double> tempContribution(blockSize, 0.0);
-    std::vector<double> tempQuadPointValues(n_q_points);
+    // indexed by [spinIndex * numberGlobalAtoms * numberIntervals +
+    // numberIntervals * atomId + epsInt]
+    std::vector<double> localDensityOfStates(numSpinComponents *
+                                               numberGlobalAtoms *
+                                               numberIntervals,
+                                             0.0);
 
-    const unsigned int localVectorSize =
-      matrix_free_data.get_vector_partitioner()->locally_owned_size();
-    std::vector<std::vector<distributedCPUVec<double>>> eigenVectors(
-      (1 + d_dftParamsPtr->spinPolarized) * d_kPointWeights.size());
-    std::vector<distributedCPUVec<dataTypes::number>>
-      eigenVectorsFlattenedBlock((1 + d_dftParamsPtr->spinPolarized) *
-                                 d_kPointWeights.size());
+    dftfe::linearAlgebra::MultiVector<dataTypes::number,
+                                      dftfe::utils::MemorySpace::HOST>
+                                   flattenedArrayBlock;
+    std::vector<dataTypes::number> wfcQuadPointData(
+      cellsBlockSize * numQuadPoints * blockSize * numWfnSpinors);
+    std::vector<double> absWfcQuadPointData(numQuadPoints * blockSize);
+    std::vector<double> atomContributions(blockSize * numberGlobalAtoms);
+    std::vector<double> smearingKernel(numberIntervals * blockSize);
+    const double        scalarCoeffOne = 1.0;
 
     for (unsigned int ivec = 0; ivec < d_numEigenValues; ivec += blockSize)
       {
         const unsigned int currentBlockSize =
           std::min(blockSize, d_numEigenValues - ivec);
+        const unsigned int numVec = currentBlockSize * numWfnSpinors;
 
         if (currentBlockSize != blockSize || ivec == 0)
-          {
-            for (unsigned int kPoint = 0;
-                 kPoint <
-                 (1 + d_dftParamsPtr->spinPolarized) * d_kPointWeights.size();
-                 ++kPoint)
-              {
-                eigenVectors[kPoint].resize(currentBlockSize);
-                for (unsigned int i = 0; i < currentBlockSize; ++i)
-                  eigenVectors[kPoint][i].reinit(d_tempEigenVec);
+          d_basisOperationsPtrHost->createMultiVector(numVec,
+                                                      flattenedArrayBlock);
+        d_basisOperationsPtrHost->reinit(numVec,
+                                         cellsBlockSize,
+                                         d_densityQuadratureId,
+                                         false);
 
-
-                vectorTools::createDealiiVector<dataTypes::number>(
-                  matrix_free_data.get_vector_partitioner(),
-                  currentBlockSize,
-                  eigenVectorsFlattenedBlock[kPoint]);
-                eigenVectorsFlattenedBlock[kPoint] = dataTypes::number(0.0);
-              }
-          }
-
-
-        std::vector<std::vector<double>> blockedEigenValues(
-          d_kPointWeights.size(),
-          std::vector<double>((1 + d_dftParamsPtr->spinPolarized) *
-                                currentBlockSize,
-                              0.0));
         for (unsigned int kPoint = 0; kPoint < d_kPointWeights.size(); ++kPoint)
-          for (unsigned int iWave = 0; iWave < currentBlockSize; ++iWave)
+          for (unsigned int spinIndex = 0; spinIndex < numSpinComponents;
+               ++spinIndex)
             {
-              blockedEigenValues[kPoint][iWave] =
-                eigenValues[kPoint][ivec + iWave];
-              if (d_dftParamsPtr->spinPolarized == 1)
-                blockedEigenValues[kPoint][currentBlockSize + iWave] =
-                  eigenValues[kPoint][d_numEigenValues + ivec + iWave];
+              internal::copyWaveFunctionsBlock(
+                *d_basisOperationsPtrHost,
+                d_eigenVectorsFlattenedHost.data() +
+                  (dealii::types::global_dof_index)(numSpinComponents * kPoint +
+                                                    spinIndex) *
+                    numLocalDofs * numWfnSpinors * d_numEigenValues,
+                d_numEigenValues,
+                numWfnSpinors,
+                ivec,
+                currentBlockSize,
+                flattenedArrayBlock);
+
+              // |psi|^2 integrated over the cells mapped to each atom, a
+              // sparse product with the quadrature weights of the cells
+              std::fill(atomContributions.begin(),
+                        atomContributions.end(),
+                        0.0);
+              for (unsigned int startingCellId = 0;
+                   startingCellId < totalLocallyOwnedCells;
+                   startingCellId += cellsBlockSize)
+                {
+                  const unsigned int currentCellsBlockSize =
+                    std::min(cellsBlockSize,
+                             totalLocallyOwnedCells - startingCellId);
+                  d_basisOperationsPtrHost->interpolateKernel(
+                    flattenedArrayBlock,
+                    wfcQuadPointData.data(),
+                    NULL,
+                    std::pair<unsigned int, unsigned int>(
+                      startingCellId, startingCellId + currentCellsBlockSize));
+
+                  for (unsigned int iCell = 0; iCell < currentCellsBlockSize;
+                       ++iCell)
+                    {
+                      const dataTypes::number *cellWfcQuadPointData =
+                        wfcQuadPointData.data() +
+                        iCell * numQuadPoints * numVec;
+                      internal::computeSpinorNormSquared(
+                        cellWfcQuadPointData,
+                        numQuadPoints,
+                        numWfnSpinors,
+                        currentBlockSize,
+                        absWfcQuadPointData.data());
+
+                      d_BLASWrapperPtrHost->xgemv(
+                        'N',
+                        currentBlockSize,
+                        numQuadPoints,
+                        &scalarCoeffOne,
+                        absWfcQuadPointData.data(),
+                        currentBlockSize,
+                        JxW + (startingCellId + iCell) * numQuadPoints,
+                        1,
+                        &scalarCoeffOne,
+                        atomContributions.data() +
+                          cellToAtomIds[startingCellId + iCell] *
+                            currentBlockSize,
+                        1);
+                    }
+                }
+
+              // smearing of the block of states onto the energy grid
+              internal::accumulateSmearedDensityOfStates(
+                *d_BLASWrapperPtrHost,
+                eigenValuesInput[kPoint].data() + spinIndex * d_numEigenValues +
+                  ivec,
+                currentBlockSize,
+                lowerBoundEpsilon,
+                intervalSize,
+                numberIntervals,
+                sigma,
+                spinPolarizedFactor * d_kPointWeights[kPoint],
+                atomContributions.data(),
+                numberGlobalAtoms,
+                smearingKernel,
+                localDensityOfStates.data() +
+                  spinIndex * numberGlobalAtoms * numberIntervals);
             }
-
-        for (unsigned int kPoint = 0;
-             kPoint <
-             (1 + d_dftParamsPtr->spinPolarized) * d_kPointWeights.size();
-             ++kPoint)
-          {
-            for (unsigned int iNode = 0; iNode < localVectorSize; ++iNode)
-              for (unsigned int iWave = 0; iWave < currentBlockSize; ++iWave)
-                eigenVectorsFlattenedBlock[kPoint].local_element(
-                  iNode * currentBlockSize + iWave) =
-                  d_eigenVectorsFlattenedHost[kPoint * d_numEigenValues *
-                                                localVectorSize +
-                                              iNode * d_numEigenValues + ivec +
-                                              iWave];
-
-            eigenVectorsFlattenedBlock[kPoint].update_ghost_values();
-            constraintsNoneDataInfo.distribute(
-              eigenVectorsFlattenedBlock[kPoint], currentBlockSize);
-            eigenVectorsFlattenedBlock[kPoint].update_ghost_values();
-
-#ifdef USE_COMPLEX
-            vectorTools::copyFlattenedDealiiVecToSingleCompVec(
-              eigenVectorsFlattenedBlock[kPoint],
-              currentBlockSize,
-              std::make_pair(0, currentBlockSize),
-              localProc_dof_indicesReal,
-              localProc_dof_indicesImag,
-              eigenVectors[kPoint],
-              false);
-
-            // FIXME: The underlying call to update_ghost_values
-            // is required because currently localProc_dof_indicesReal
-            // and localProc_dof_indicesImag are only available for
-            // locally owned nodes. Once they are also made available
-            // for ghost nodes- use true for the last argument in
-            // copyFlattenedDealiiVecToSingleCompVec(..) above and supress
-            // underlying call.
-            for (unsigned int i = 0; i < currentBlockSize; ++i)
-              eigenVectors[kPoint][i].update_ghost_values();
-#else
-            vectorTools::copyFlattenedDealiiVecToSingleCompVec(
-              eigenVectorsFlattenedBlock[kPoint],
-              currentBlockSize,
-              std::make_pair(0, currentBlockSize),
-              eigenVectors[kPoint],
-              true);
-
-#endif
-          }
-
-        if (d_dftParamsPtr->spinPolarized == 1)
-          {
-            for (unsigned int spinType = 0; spinType < 2; ++spinType)
-              {
-                typename dealii::DoFHandler<3>::active_cell_iterator
-                  cellN = dofHandler.begin_active(),
-                  endcN = dofHandler.end();
-
-                for (; cellN != endcN; ++cellN)
-                  {
-                    if (cellN->is_locally_owned())
-                      {
-                        fe_values.reinit(cellN);
-                        unsigned int globalAtomId =
-                          cellToAtomIdMap[cellN->id()];
-
-                        for (unsigned int iEigenVec = 0;
-                             iEigenVec < currentBlockSize;
-                             ++iEigenVec)
-                          {
-                            fe_values.get_function_values(
-                              eigenVectors[spinType][iEigenVec],
-                              tempQuadPointValues);
-
-                            tempContribution[iEigenVec] = 0.0;
-                            for (unsigned int q_point = 0; q_point < n_q_points;
-                                 ++q_point)
-                              {
-                                tempContribution[iEigenVec] +=
-                                  tempQuadPointValues[q_point] *
-                                  tempQuadPointValues[q_point] *
-                                  fe_values.JxW(q_point);
-                              }
-                          }
-
-                        for (unsigned int iEigenVec = 0;
-                             iEigenVec < currentBlockSize;
-                             ++iEigenVec)
-                          for (unsigned int epsInt = 0;
-                               epsInt < numberIntervals;
-                               ++epsInt)
-                            {
-                              double epsValue =
-                                lowerBoundEpsilon + epsInt * intervalSize;
-                              double term1 =
-                                (epsValue -
-                                 blockedEigenValues[0][spinType *
-                                                         currentBlockSize +
-                                                       iEigenVec]);
-                              double smearedEnergyLevel =
-                                (sigma / M_PI) *
-                                (1.0 / (term1 * term1 + sigma * sigma));
-
-                              if (spinType == 0)
-                                localDensityOfStatesUp[numberIntervals *
-                                                         globalAtomId +
-                                                       epsInt] +=
-                                  tempContribution[iEigenVec] *
-                                  smearedEnergyLevel;
-                              else
-                                localDensityOfStatesDown[numberIntervals *
-                                                           globalAtomId +
-                                                         epsInt] +=
-                                  tempContribution[iEigenVec] *
-                                  smearedEnergyLevel;
-                            }
-                      }
-                  }
-              }
-          }
-        else
-          {
-            typename dealii::DoFHandler<3>::active_cell_iterator
-              cellN = dofHandler.begin_active(),
-              endcN = dofHandler.end();
-
-            for (; cellN != endcN; ++cellN)
-              {
-                if (cellN->is_locally_owned())
-                  {
-                    fe_values.reinit(cellN);
-                    unsigned int globalAtomId = cellToAtomIdMap[cellN->id()];
-
-                    for (unsigned int iEigenVec = 0;
-                         iEigenVec < currentBlockSize;
-                         ++iEigenVec)
-                      {
-                        fe_values.get_function_values(
-                          eigenVectors[0][iEigenVec], tempQuadPointValues);
-
-                        tempContribution[iEigenVec] = 0.0;
-                        for (unsigned int q_point = 0; q_point < n_q_points;
-                             ++q_point)
-                          {
-                            tempContribution[iEigenVec] +=
-                              tempQuadPointValues[q_point] *
-                              tempQuadPointValues[q_point] *
-                              fe_values.JxW(q_point);
-                          }
-                      }
-
-                    for (unsigned int iEigenVec = 0;
-                         iEigenVec < currentBlockSize;
-                         ++iEigenVec)
-                      for (unsigned int epsInt = 0; epsInt < numberIntervals;
-                           ++epsInt)
-                        {
-                          double epsValue =
-                            lowerBoundEpsilon + epsInt * intervalSize;
-                          double term1 =
-                            (epsValue - blockedEigenValues[0][iEigenVec]);
-                          double smearedEnergyLevel =
-                            (sigma / M_PI) *
-                            (1.0 / (term1 * term1 + sigma * sigma));
-                          localDensityOfStates[numberIntervals * globalAtomId +
-                                               epsInt] +=
-                            2.0 * tempContribution[iEigenVec] *
-                            smearedEnergyLevel;
-                        }
-                  }
-              }
-          }
       } // ivec loop
 
-    if (d_dftParamsPtr->spinPolarized == 1)
-      {
-        dealii::Utilities::MPI::sum(localDensityOfStatesUp,
-                                    mpi_communicator,
-                                    localDensityOfStatesUp);
+    MPI_Allreduce(MPI_IN_PLACE,
+                  localDensityOfStates.data(),
+                  localDensityOfStates.size(),
+                  dataTypes::mpi_type_id(localDensityOfStates.data()),
+                  MPI_SUM,
+                  mpi_communicator);
 
-        dealii::Utilities::MPI::sum(localDensityOfStatesDown,
-                                    mpi_communicator,
-                                    localDensityOfStatesDown);
-      }
-    else
-      {
-        dealii::Utilities::MPI::sum(localDensityOfStates,
-                                    mpi_communicator,
-                                    localDensityOfStates);
-      }
+    MPI_Allreduce(MPI_IN_PLACE,
+                  localDensityOfStates.data(),
+                  localDensityOfStates.size(),
+                  dataTypes::mpi_type_id(localDensityOfStates.data()),
+                  MPI_SUM,
+                  interpoolcomm);
+
+    const double *localDensityOfStatesUp = localDensityOfStates.data();
+    const double *localDensityOfStatesDown =
+      localDensityOfStates.data() +
+      (numSpinComponents - 1) * numberGlobalAtoms * numberIntervals;
 
     double checkSum = 0;
     if (dealii::Utilities::MPI::this_mpi_process(d_mpiCommParent) == 0)
@@ -918,7 +972,7 @@ namespace dftfe
                                       radValues;
     std::vector<std::vector<orbital>> singleAtomInfo;
     singleAtomInfo.resize(numberGlobalAtoms);
-    double wfcInitTruncation;
+    double wfcInitTruncation = 0.0;
 
     for (std::vector<std::vector<unsigned int>>::iterator it = stencil.begin();
          it < stencil.end();
@@ -965,16 +1019,13 @@ namespace dftfe
           errorReadFile += 1;
       } // end stencil
 
-    unsigned int totalAtomicData = 0;
+    // the orbitals of an atom are contiguous, starting at
+    // orbitalOffsets[iAtom]
+    std::vector<unsigned int> orbitalOffsets(numberGlobalAtoms + 1, 0);
     for (unsigned int iAtom = 0; iAtom < numberGlobalAtoms; ++iAtom)
-      {
-        for (unsigned int iSingAtomData = 0;
-             iSingAtomData < singleAtomInfo[iAtom].size();
-             ++iSingAtomData)
-          {
-            totalAtomicData += 1;
-          }
-      }
+      orbitalOffsets[iAtom + 1] =
+        orbitalOffsets[iAtom] + singleAtomInfo[iAtom].size();
+    const unsigned int totalAtomicData = orbitalOffsets[numberGlobalAtoms];
 
     // loop over elements
     std::vector<double> eigenValuesAllkPoints;
@@ -1016,283 +1067,241 @@ namespace dftfe
     std::vector<double> partialDensityOfStates;
     partialDensityOfStates.resize(totalAtomicData * numberIntervals, 0.0);
 
-    // access finite-element data
-    dealii::QGauss<3>   quadrature_formula(C_num1DQuad<FEOrder>());
-    dealii::FEValues<3> fe_values(dofHandler.get_fe(),
-                                  quadrature_formula,
-                                  dealii::update_values |
-                                    dealii::update_JxW_values |
-                                    dealii::update_quadrature_points);
-    const unsigned int  dofs_per_cell = dofHandler.get_fe().dofs_per_cell;
-    const unsigned int  n_q_points    = quadrature_formula.size();
+    AssertThrow(d_dftParamsPtr->spinPolarized != 1,
+                dealii::ExcMessage(
+                  "PDOS is not implemented for spin-polarized problems"));
 
+    const unsigned int numWfnSpinors =
+      (d_dftParamsPtr->noncolin || d_dftParamsPtr->hasSOC) ? 2 : 1;
+    const double spinPolarizedFactor = (numWfnSpinors == 2) ? 1.0 : 2.0;
+
+#ifdef DFTFE_WITH_DEVICE
+    if constexpr (dftfe::utils::MemorySpace::DEVICE == memorySpace)
+      d_eigenVectorsFlattenedDevice.copyTo(d_eigenVectorsFlattenedHost);
+#endif
 
+    const unsigned int numKPoints   = d_kPointWeights.size();
+    const unsigned int numLocalDofs = d_basisOperationsPtrHost->nOwnedDofs();
+    const unsigned int totalLocallyOwnedCells =
+      d_basisOperationsPtrHost->nCells();
     const unsigned int blockSize =
       std::min(d_dftParamsPtr->wfcBlockSize, d_numEigenValues);
+    const unsigned int cellsBlockSize =
+      std::max(1u,
+               std::min(d_dftParamsPtr->cellsBlockSizeDensityHost,
+                        totalLocallyOwnedCells));
+    d_basisOperationsPtrHost->reinit(blockSize * numWfnSpinors,
+                                     cellsBlockSize,
+                                     d_densityQuadratureId);
+    const unsigned int numQuadPoints =
+      d_basisOperationsPtrHost->nQuadsPerCell();
+
+    const double *quadPoints = d_basisOperationsPtrHost->quadPoints().data();
+    const double *JxW        = d_basisOperationsPtrHost->JxWBasisData().data();
+
+    // atoms whose single atom orbitals do not vanish on each cell
+    std::vector<double> atomPoints(3 * numberGlobalAtoms);
+    for (unsigned int iAtom = 0; iAtom < numberGlobalAtoms; ++iAtom)
+      for (unsigned int d = 0; d < 3; ++d)
+        atomPoints[3 * iAtom + d] = atomLocations[iAtom][2 + d];
+    const utils::AtomSpatialIndex          atomsSpatialIndex(atomPoints);
+    std::vector<std::vector<unsigned int>> cellAtomIds(totalLocallyOwnedCells);
+    for (unsigned int iCell = 0; iCell < totalLocallyOwnedCells; ++iCell)
+      {
+        double centroid[3];
+        internal::getCellCentroid(quadPoints, iCell, numQuadPoints, centroid);
+        double cellRadius = 0.0;
+        for (unsigned int q = 0; q < numQuadPoints; ++q)
+          {
+            const double *quadPoint =
+              quadPoints + (iCell * numQuadPoints + q) * 3;
+            const double x = quadPoint[0] - centroid[0];
+            const double y = quadPoint[1] - centroid[1];
+            const double z = quadPoint[2] - centroid[2];
+            cellRadius = std::max(cellRadius, std::sqrt(x * x + y * y + z * z));
+          }
+        atomsSpatialIndex.findPointsInBall(centroid,
+                                           wfcInitTruncation + cellRadius,
+                                           cellAtomIds[iCell]);
+      }
 
-    std::vector<std::vector<double>> tempQuadPointValuesForWaveFunctions(
-      blockSize);
-    std::vector<double> tempQuadPointValues(n_q_points);
-
-    const unsigned int localVectorSize =
-      matrix_free_data.get_vector_partitioner()->locally_owned_size();
-    std::vector<std::vector<distributedCPUVec<double>>> eigenVectors(
-      (1 + d_dftParamsPtr->spinPolarized) * d_kPointWeights.size());
-    std::vector<distributedCPUVec<dataTypes::number>>
-      eigenVectorsFlattenedBlock((1 + d_dftParamsPtr->spinPolarized) *
-                                 d_kPointWeights.size());
-    // std::vector<double>
-    // innerProductWaveFunctionSingAtom(d_numEigenValues*5,0.0);
-    // std::vector<double> tempContribution(blockSize*,0.0);
+    std::vector<dftfe::linearAlgebra::MultiVector<
+      dataTypes::number,
+      dftfe::utils::MemorySpace::HOST>>
+                                   flattenedArrayBlocks(numKPoints);
+    std::vector<dataTypes::number> wfcQuadPointData(
+      cellsBlockSize * numQuadPoints * blockSize * numWfnSpinors);
+    // single atom orbitals times JxW on the cells of a cell block, indexed by
+    // [(cellOrbitalOffsets[iCell] + iOrbital) * numQuadPoints + q]
+    std::vector<dataTypes::number> orbitalQuadPointData;
+    std::vector<unsigned int>      cellOrbitalOffsets(cellsBlockSize + 1);
+    // <orbital|psi> indexed by [(kPoint * totalAtomicData + iOrbital) *
+    // numVec + iSpinor * currentBlockSize + iWave]
+    std::vector<dataTypes::number> projections;
+
+    std::vector<double> projectionWeights(blockSize * totalAtomicData);
+    std::vector<double> smearingKernel(numberIntervals * blockSize);
+
+    const dataTypes::number scalarCoeffOne = 1.0;
 
     for (unsigned int ivec = 0; ivec < d_numEigenValues; ivec += blockSize)
       {
         const unsigned int currentBlockSize =
           std::min(blockSize, d_numEigenValues - ivec);
-        std::vector<double> tempContribution(currentBlockSize * totalAtomicData,
-                                             0.0);
+        const unsigned int numVec = currentBlockSize * numWfnSpinors;
 
         if (currentBlockSize != blockSize || ivec == 0)
+          for (unsigned int kPoint = 0; kPoint < numKPoints; ++kPoint)
+            d_basisOperationsPtrHost->createMultiVector(
+              numVec, flattenedArrayBlocks[kPoint]);
+        d_basisOperationsPtrHost->reinit(numVec,
+                                         cellsBlockSize,
+                                         d_densityQuadratureId,
+                                         false);
+
+        for (unsigned int kPoint = 0; kPoint < numKPoints; ++kPoint)
+          internal::copyWaveFunctionsBlock(
+            *d_basisOperationsPtrHost,
+            d_eigenVectorsFlattenedHost.data() +
+              (dealii::types::global_dof_index)kPoint * numLocalDofs *
+                numWfnSpinors * d_numEigenValues,
+            d_numEigenValues,
+            numWfnSpinors,
+            ivec,
+            currentBlockSize,
+            flattenedArrayBlocks[kPoint]);
+
+        projections.assign(numKPoints * totalAtomicData * numVec,
+                           dataTypes::number(0.0));
+        for (unsigned int startingCellId = 0;
+             startingCellId < totalLocallyOwnedCells;
+             startingCellId += cellsBlockSize)
           {
-            for (unsigned int kPoint = 0;
-                 kPoint <
-                 (1 + d_dftParamsPtr->spinPolarized) * d_kPointWeights.size();
-                 ++kPoint)
-              {
-                eigenVectors[kPoint].resize(currentBlockSize);
-                for (unsigned int i = 0; i < currentBlockSize; ++i)
-                  eigenVectors[kPoint][i].reinit(d_tempEigenVec);
-
+            const unsigned int currentCellsBlockSize =
+              std::min(cellsBlockSize, totalLocallyOwnedCells - startingCellId);
 
-                vectorTools::createDealiiVector<dataTypes::number>(
-                  matrix_free_data.get_vector_partitioner(),
-                  currentBlockSize,
-                  eigenVectorsFlattenedBlock[kPoint]);
-                eigenVectorsFlattenedBlock[kPoint] = dataTypes::number(0.0);
+            // the orbitals are evaluated once for all the k-points
+            cellOrbitalOffsets[0] = 0;
+            for (unsigned int iCell = 0; iCell < currentCellsBlockSize; ++iCell)
+              {
+                cellOrbitalOffsets[iCell + 1] = cellOrbitalOffsets[iCell];
+                for (const unsigned int atomId :
+                     cellAtomIds[startingCellId + iCell])
+                  cellOrbitalOffsets[iCell + 1] +=
+                    singleAtomInfo[atomId].size();
               }
-          }
-
-
-        std::vector<std::vector<double>> blockedEigenValues(
-          d_kPointWeights.size(),
-          std::vector<double>((1 + d_dftParamsPtr->spinPolarized) *
-                                currentBlockSize,
-                              0.0));
-
-        for (unsigned int kPoint = 0; kPoint < d_kPointWeights.size(); ++kPoint)
-          for (unsigned int iWave = 0; iWave < currentBlockSize; ++iWave)
-            {
-              blockedEigenValues[kPoint][iWave] =
-                eigenValues[kPoint][ivec + iWave];
-              if (d_dftParamsPtr->spinPolarized == 1)
-                blockedEigenValues[kPoint][currentBlockSize + iWave] =
-                  eigenValues[kPoint][d_numEigenValues + ivec + iWave];
-            }
-
-
-        for (unsigned int kPoint = 0;
-             kPoint <
-             (1 + d_dftParamsPtr->spinPolarized) * d_kPointWeights.size();
-             ++kPoint)
-          {
-            for (unsigned int iNode = 0; iNode < localVectorSize; ++iNode)
-              for (unsigned int iWave = 0; iWave < currentBlockSize; ++iWave)
-                eigenVectorsFlattenedBlock[kPoint].local_element(
-                  iNode * currentBlockSize + iWave) =
-                  d_eigenVectorsFlattenedHost[kPoint * localVectorSize *
-                                                d_numEigenValues +
-                                              iNode * d_numEigenValues + ivec +
-                                              iWave];
-
-            eigenVectorsFlattenedBlock[kPoint].update_ghost_values();
-            constraintsNoneDataInfo.distribute(
-              eigenVectorsFlattenedBlock[kPoint], currentBlockSize);
-            eigenVectorsFlattenedBlock[kPoint].update_ghost_values();
-
-#ifdef USE_COMPLEX
-            vectorTools::copyFlattenedDealiiVecToSingleCompVec(
-              eigenVectorsFlattenedBlock[kPoint],
-              currentBlockSize,
-              std::make_pair(0, currentBlockSize),
-              localProc_dof_indicesReal,
-              localProc_dof_indicesImag,
-              eigenVectors[kPoint],
-              false);
-
-            // FIXME: The underlying call to update_ghost_values
-            // is required because currently localProc_dof_indicesReal
-            // and localProc_dof_indicesImag are only available for
-            // locally owned nodes. Once they are also made available
-            // for ghost nodes- use true for the last argument in
-            // copyFlattenedDealiiVecToSingleCompVec(..) above and supress
-            // underlying call.
-            for (unsigned int i = 0; i < currentBlockSize; ++i)
-              eigenVectors[kPoint][i].update_ghost_values();
-#else
-            vectorTools::copyFlattenedDealiiVecToSingleCompVec(
-              eigenVectorsFlattenedBlock[kPoint],
-              currentBlockSize,
-              std::make_pair(0, currentBlockSize),
-              eigenVectors[kPoint],
-              true);
-#endif
-          }
-
-        if (d_dftParamsPtr->spinPolarized == 1)
-          {
-            AssertThrow(
-              false,
-              dealii::ExcMessage(
-                "PDOS is not implemented for spin-polarized problems"));
-          }
-        else
-          {
-            typename dealii::DoFHandler<3>::active_cell_iterator
-              cellN = dofHandler.begin_active(),
-              endcN = dofHandler.end();
-            for (; cellN != endcN; ++cellN)
+            orbitalQuadPointData.resize(
+              cellOrbitalOffsets[currentCellsBlockSize] * numQuadPoints);
+            for (unsigned int iCell = 0; iCell < currentCellsBlockSize; ++iCell)
               {
-                if (cellN->is_locally_owned())
-                  {
-                    fe_values.reinit(cellN);
-
-                    for (unsigned int iEigenVec = 0;
-                         iEigenVec < currentBlockSize;
-                         ++iEigenVec)
+                const unsigned int cellIndex = startingCellId + iCell;
+                unsigned int       iOrbital  = cellOrbitalOffsets[iCell];
+                for (const unsigned int atomId : cellAtomIds[cellIndex])
+                  for (unsigned int iSingAtomData = 0;
+                       iSingAtomData < singleAtomInfo[atomId].size();
+                       ++iSingAtomData, ++iOrbital)
+                    for (unsigned int q = 0; q < numQuadPoints; ++q)
                       {
-                        tempQuadPointValuesForWaveFunctions[iEigenVec].resize(
-                          n_q_points);
-                        fe_values.get_function_values(
-                          eigenVectors[0][iEigenVec], tempQuadPointValues);
-                        tempQuadPointValuesForWaveFunctions[iEigenVec] =
-                          tempQuadPointValues;
+                        const double *quadPoint =
+                          quadPoints + (cellIndex * numQuadPoints + q) * 3;
+                        orbitalQuadPointData[iOrbital * numQuadPoints + q] =
+                          internal::evaluateSingleAtomOrbital(
+                            singleAtomInfo[atomId][iSingAtomData],
+                            quadPoint[0] - atomLocations[atomId][2],
+                            quadPoint[1] - atomLocations[atomId][3],
+                            quadPoint[2] - atomLocations[atomId][4],
+                            wfcInitTruncation) *
+                          JxW[cellIndex * numQuadPoints + q];
                       }
+              }
 
-
-
-                    for (unsigned int iAtom = 0; iAtom < numberGlobalAtoms;
-                         ++iAtom)
-                      {
-                        for (unsigned int iSingAtomData = 0;
-                             iSingAtomData < singleAtomInfo[iAtom].size();
-                             ++iSingAtomData)
-                          {
-                            for (unsigned int q = 0; q < n_q_points; ++q)
-                              {
-                                const dealii::Point<3> &quadPoint =
-                                  fe_values.quadrature_point(q);
-                                double x =
-                                  quadPoint[0] - atomLocations[iAtom][2];
-                                double y =
-                                  quadPoint[1] - atomLocations[iAtom][3];
-                                double z =
-                                  quadPoint[2] - atomLocations[iAtom][4];
-
-                                double r     = sqrt(x * x + y * y + z * z);
-                                double theta = acos(z / r);
-                                double phi   = atan2(y, x);
-
-                                if (r == 0)
-                                  {
-                                    theta = 0;
-                                    phi   = 0;
-                                  }
-
-                                orbital dataOrb =
-                                  singleAtomInfo[iAtom][iSingAtomData];
-
-                                double R = 0.0;
-                                double singleAtomWaveFunctionQuadValue;
-
-                                if (r <= wfcInitTruncation)
-                                  {
-                                    R = alglib::spline1dcalc(dataOrb.psi, r);
-                                    if (dataOrb.m > 0)
-                                      singleAtomWaveFunctionQuadValue =
-                                        R * std::sqrt(2) *
-                                        boost::math::spherical_harmonic_r(
-                                          dataOrb.l, dataOrb.m, theta, phi);
-                                    else if (dataOrb.m == 0)
-                                      singleAtomWaveFunctionQuadValue =
-                                        R * boost::math::spherical_harmonic_r(
-                                              dataOrb.l, dataOrb.m, theta, phi);
-                                    else
-                                      singleAtomWaveFunctionQuadValue =
-                                        R * std::sqrt(2) *
-                                        boost::math::spherical_harmonic_i(
-                                          dataOrb.l, -dataOrb.m, theta, phi);
-                                  }
-                                else
-                                  singleAtomWaveFunctionQuadValue = 0.0;
-
-                                for (unsigned int iEigenVec = 0;
-                                     iEigenVec < currentBlockSize;
-                                     ++iEigenVec)
-                                  {
-                                    tempContribution
-                                      [currentBlockSize *
-                                         singleAtomInfo[iAtom].size() * iAtom +
-                                       currentBlockSize * iSingAtomData +
-                                       iEigenVec] +=
-                                      tempQuadPointValuesForWaveFunctions
-                                        [iEigenVec][q] *
-                                      singleAtomWaveFunctionQuadValue *
-                                      fe_values.JxW(q);
-                                  }
-                              } // quad loop
-
-                          } // single atom wavefunction data
-
-                      } // iAtom data
-
-                  } // if cell
-
-              } // cell loop
-
-            dealii::Utilities::MPI::sum(tempContribution,
-                                        mpi_communicator,
-                                        tempContribution);
-          } // if-else loop
-
-
-        for (unsigned int iAtom = 0; iAtom < numberGlobalAtoms; ++iAtom)
-          {
-            for (unsigned int iSingAtomData = 0;
-                 iSingAtomData < singleAtomInfo[iAtom].size();
-                 ++iSingAtomData)
+            for (unsigned int kPoint = 0; kPoint < numKPoints; ++kPoint)
               {
-                for (unsigned int iEigenVec = 0; iEigenVec < currentBlockSize;
-                     ++iEigenVec)
+                d_basisOperationsPtrHost->interpolateKernel(
+                  flattenedArrayBlocks[kPoint],
+                  wfcQuadPointData.data(),
+                  NULL,
+                  std::pair<unsigned int, unsigned int>(
+                    startingCellId, startingCellId + currentCellsBlockSize));
+
+                // projections of all the states and spinors of the block on
+                // the orbitals of each atom overlapping the cell
+                for (unsigned int iCell = 0; iCell < currentCellsBlockSize;
+                     ++iCell)
                   {
-                    for (unsigned int epsInt = 0; epsInt < numberIntervals;
-                         ++epsInt)
+                    unsigned int iOrbital = cellOrbitalOffsets[iCell];
+                    for (const unsigned int atomId :
+                         cellAtomIds[startingCellId + iCell])
                       {
-                        double epsValue =
-                          lowerBoundEpsilon + epsInt * intervalSize;
-                        double term1 =
-                          (epsValue - blockedEigenValues[0][iEigenVec]);
-                        double smearedEnergyLevel =
-                          (sigma / M_PI) *
-                          (1.0 / (term1 * term1 + sigma * sigma));
-                        double tempValue =
-                          tempContribution[currentBlockSize *
-                                             singleAtomInfo[iAtom].size() *
-                                             iAtom +
-                                           currentBlockSize * iSingAtomData +
-                                           iEigenVec];
-                        partialDensityOfStates[numberIntervals *
-                                                 singleAtomInfo[iAtom].size() *
-                                                 iAtom +
-                                               numberIntervals * iSingAtomData +
-                                               epsInt] +=
-                          2.0 * tempValue * tempValue * smearedEnergyLevel;
+                        const unsigned int numOrbitals =
+                          singleAtomInfo[atomId].size();
+                        if (numOrbitals == 0)
+                          continue;
+                        d_BLASWrapperPtrHost->xgemm(
+                          'N',
+                          'N',
+                          numVec,
+                          numOrbitals,
+                          numQuadPoints,
+                          &scalarCoeffOne,
+                          wfcQuadPointData.data() +
+                            iCell * numQuadPoints * numVec,
+                          numVec,
+                          orbitalQuadPointData.data() +
+                            iOrbital * numQuadPoints,
+                          numQuadPoints,
+                          &scalarCoeffOne,
+                          projections.data() +
+                            (kPoint * totalAtomicData +
+                             orbitalOffsets[atomId]) *
+                              numVec,
+                          numVec);
+                        iOrbital += numOrbitals;
                       }
                   }
               }
           }
 
+        MPI_Allreduce(MPI_IN_PLACE,
+                      projections.data(),
+                      projections.size(),
+                      dataTypes::mpi_type_id(projections.data()),
+                      MPI_SUM,
+                      mpi_communicator);
+
+        for (unsigned int kPoint = 0; kPoint < numKPoints; ++kPoint)
+          {
+            internal::computeSpinorNormSquared(
+              projections.data() + kPoint * totalAtomicData * numVec,
+              totalAtomicData,
+              numWfnSpinors,
+              currentBlockSize,
+              projectionWeights.data());
+
+            // smearing of the block of states onto the energy grid
+            internal::accumulateSmearedDensityOfStates(
+              *d_BLASWrapperPtrHost,
+              eigenValuesInput[kPoint].data() + ivec,
+              currentBlockSize,
+              lowerBoundEpsilon,
+              intervalSize,
+              numberIntervals,
+              sigma,
+              spinPolarizedFactor * d_kPointWeights[kPoint],
+              projectionWeights.data(),
+              totalAtomicData,
+              smearingKernel,
+              partialDensityOfStates.data());
+          }
       } // ivec block loop
 
+    MPI_Allreduce(MPI_IN_PLACE,
+                  partialDensityOfStates.data(),
+                  partialDensityOfStates.size(),
+                  dataTypes::mpi_type_id(partialDensityOfStates.data()),
+                  MPI_SUM,
+                  interpoolcomm);
+
     pcout << "Following is the Single atom data used for PDOS computation: "
           << std::endl;
 
@@ -1347,7 +1356,7 @@ namespace dftfe
                               << std::setprecision(18)
                               << partialDensityOfStates
                                    [numberIntervals *
-                                      singleAtomInfo[iAtom].size() * iAtom +
+                                      orbitalOffsets[iAtom] +
                                     numberIntervals * iSingAtomData + epsInt]
                               << " ";
                           }
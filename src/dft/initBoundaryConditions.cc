@@ -345,12 +345,13 @@ namespace dftfe
           (d_dftParamsPtr->noncolin || d_dftParamsPtr->hasSOC) ? 2 : 1;
         d_basisOperationsPtrHost->createScratchMultiVectors(numWfnComponents,
                                                             4);
-        d_basisOperationsPtrHost->createScratchMultiVectors(BVec *
-                                                              numWfnComponents,
-                                                            2);
+        d_basisOperationsPtrHost->createScratchMultiVectors(
+          BVec * numWfnComponents,
+          d_dftParamsPtr->overlapComputeCommunChebyHost ? 4 : 2);
         if (d_dftParamsPtr->useSinglePrecCheby)
           d_basisOperationsPtrHost->createScratchMultiVectorsSinglePrec(
-            BVec * numWfnComponents, 2);
+            BVec * numWfnComponents,
+            d_dftParamsPtr->overlapComputeCommunChebyHost ? 4 : 2);
         if (d_numEigenValues % BVec != 0)
           d_basisOperationsPtrHost->createScratchMultiVectors(
             (d_numEigenValues % BVec) * numWfnComponents, 2);
@@ -122,6 +122,10 @@ namespace dftfe
           dataTypes::number(0.0));
       }
 
+    // the wavefunction extrapolation history lives on the previous mesh
+    d_wfcExtrapolationHistory.clear();
+    d_wfcExtrapolationPrediction.clear();
+
     pcout << std::endl
           << "Setting initial guess for wavefunctions...." << std::endl;
 
@@ -565,6 +565,129 @@ namespace dftfe
               }
             symmetryPtr->numSymm = 2 * symmetryPtr->numSymm;
           }
+        std::vector<int> isTimeReversedTemp(symmetryPtr->numSymm, 0);
+        if (d_dftParamsPtr->timeReversal)
+          for (unsigned int iSymm = symmetryPtr->numSymm / 2;
+               iSymm < symmetryPtr->numSymm;
+               ++iSymm)
+            isTimeReversedTemp[iSymm] = 1;
+        //
+        // With noncollinear magnetism only the operations mapping the starting
+        // magnetic moments of the atoms onto each other, as axial vectors and
+        // flipped if combined with time reversal, are symmetries. Operations
+        // combined with time reversal are only kept if the density is
+        // symmetrized, as they flip the magnetization of the k-points they
+        // relate.
+        if (d_dftParamsPtr->noncolin)
+          {
+            const unsigned int numAtoms = atomLocationsFractional.size();
+            std::vector<std::vector<double>> atomMoments(
+              numAtoms, std::vector<double>(3, 0.0));
+            for (unsigned int iAtom = 0; iAtom < numAtoms; ++iAtom)
+              if (atomLocationsFractional[iAtom].size() >= 8)
+                {
+                  const double magnitude = atomLocationsFractional[iAtom][5];
+                  const double theta     = atomLocationsFractional[iAtom][6];
+                  const double phi       = atomLocationsFractional[iAtom][7];
+                  atomMoments[iAtom][0] =
+                    magnitude * std::sin(theta) * std::cos(phi);
+                  atomMoments[iAtom][1] =
+                    magnitude * std::sin(theta) * std::sin(phi);
+                  atomMoments[iAtom][2] = magnitude * std::cos(theta);
+                }
+            //
+            unsigned int numMagneticSymm = 0;
+            for (unsigned int iSymm = 0; iSymm < symmetryPtr->numSymm; ++iSymm)
+              {
+                const double timeReversalFactor =
+                  isTimeReversedTemp[iSymm] == 1 ? -1.0 : 1.0;
+                if (isTimeReversedTemp[iSymm] == 1 && !d_dftParamsPtr->useSymm)
+                  continue;
+                // real space rotation, the rotations combined with time
+                // reversal being stored with the sign of the k-point map
+                std::vector<std::vector<double>> rotationCrys(
+                  3, std::vector<double>(3, 0.0));
+                for (unsigned int j = 0; j < 3; ++j)
+                  for (unsigned int k = 0; k < 3; ++k)
+                    rotationCrys[j][k] =
+                      timeReversalFactor * rotation[iSymm][j][k];
+                const std::vector<std::vector<double>> rotationCart =
+                  symmetryPtr->crys2cartRotation(rotationCrys);
+                const double axialFactor =
+                  timeReversalFactor *
+                  (rotationCart[0][0] *
+                     (rotationCart[1][1] * rotationCart[2][2] -
+                      rotationCart[1][2] * rotationCart[2][1]) -
+                   rotationCart[0][1] *
+                     (rotationCart[1][0] * rotationCart[2][2] -
+                      rotationCart[1][2] * rotationCart[2][0]) +
+                   rotationCart[0][2] *
+                     (rotationCart[1][0] * rotationCart[2][1] -
+                      rotationCart[1][1] * rotationCart[2][0]));
+                //
+                bool isMagneticSymm = true;
+                for (unsigned int iAtom = 0; iAtom < numAtoms && isMagneticSymm;
+                     ++iAtom)
+                  {
+                    double mappedPosition[3];
+                    for (unsigned int j = 0; j < 3; ++j)
+                      mappedPosition[j] =
+                        rotationCrys[j][0] * atomLocationsFractional[iAtom][2] +
+                        rotationCrys[j][1] * atomLocationsFractional[iAtom][3] +
+                        rotationCrys[j][2] * atomLocationsFractional[iAtom][4] +
+                        symmetryPtr->translation[iSymm][j];
+                    unsigned int jAtom = 0;
+                    for (; jAtom < numAtoms; ++jAtom)
+                      {
+                        if (atomLocationsFractional[jAtom][0] !=
+                            atomLocationsFractional[iAtom][0])
+                          continue;
+                        bool isSamePosition = true;
+                        for (unsigned int j = 0; j < 3; ++j)
+                          {
+                            const double diff =
+                              mappedPosition[j] -
+                              atomLocationsFractional[jAtom][2 + j];
+                            if (std::abs(diff - std::round(diff)) > 1e-5)
+                              isSamePosition = false;
+                          }
+                        if (isSamePosition)
+                          break;
+                      }
+                    if (jAtom == numAtoms)
+                      {
+                        isMagneticSymm = false;
+                        break;
+                      }
+                    for (unsigned int i = 0; i < 3; ++i)
+                      {
+                        double mappedMoment = 0.0;
+                        for (unsigned int j = 0; j < 3; ++j)
+                          mappedMoment += axialFactor * rotationCart[i][j] *
+                                          atomMoments[iAtom][j];
+                        if (std::abs(mappedMoment - atomMoments[jAtom][i]) >
+                            1e-6)
+                          isMagneticSymm = false;
+                      }
+                  }
+                if (!isMagneticSymm)
+                  continue;
+                for (unsigned int j = 0; j < 3; ++j)
+                  {
+                    for (unsigned int k = 0; k < 3; ++k)
+                      rotation[numMagneticSymm][j][k] = rotation[iSymm][j][k];
+                    symmetryPtr->translation[numMagneticSymm][j] =
+                      symmetryPtr->translation[iSymm][j];
+                  }
+                isTimeReversedTemp[numMagneticSymm] = isTimeReversedTemp[iSymm];
+                numMagneticSymm++;
+              }
+            if (!d_dftParamsPtr->reproducible_output &&
+                d_dftParamsPtr->verbosity > 3)
+              pcout << " number of magnetic symmetries " << numMagneticSymm
+                    << " out of " << symmetryPtr->numSymm << std::endl;
+            symmetryPtr->numSymm = numMagneticSymm;
+          }
         //
         symmMatTemp.resize(symmetryPtr->numSymm);
         symmMatTemp2.resize(symmetryPtr->numSymm);
@@ -580,8 +703,7 @@ namespace dftfe
                   {
                     symmMatTemp[i][j][k]  = double(rotation[i][j][k]);
                     symmMatTemp2[i][j][k] = double(rotation[i][j][k]);
-                    if (d_dftParamsPtr->timeReversal &&
-                        i >= symmetryPtr->numSymm / 2)
+                    if (isTimeReversedTemp[i] == 1)
                       symmMatTemp2[i][j][k] = -double(rotation[i][j][k]);
                   }
               }
@@ -602,6 +724,7 @@ namespace dftfe
               translationTemp[i][j] = (symmetryPtr->translation)[i][j];
           }
         //
+        symmetryPtr->timeReversedSymm.assign(symmetryPtr->numSymm, 0);
         symmetryPtr->symmMat[0] = symmMatTemp[0];
         unsigned int usedSymm   = 1,
                      ik = 0; // note usedSymm is initialized to 1 and not 0.
@@ -674,6 +797,8 @@ namespace dftfe
                       {
                         usedSymmNum[iSymm]               = usedSymm;
                         (symmetryPtr->symmMat)[usedSymm] = symmMatTemp2[iSymm];
+                        (symmetryPtr->timeReversedSymm)[usedSymm] =
+                          isTimeReversedTemp[iSymm];
                         for (unsigned int j = 0; j < 3; ++j)
                           (symmetryPtr->translation)[usedSymm][j] =
                             translationTemp[iSymm][j];
@@ -699,6 +824,7 @@ namespace dftfe
           }
         //
         symmetryPtr->numSymm = usedSymm;
+        symmetryPtr->timeReversedSymm.resize(usedSymm);
         symmetryPtr->symmUnderGroup.resize(
           maxkPoints, std::vector<int>(symmetryPtr->numSymm, 0));
         symmetryPtr->numSymmUnderGroup.resize(
@@ -419,6 +419,31 @@ namespace dftfe
                                     quadratureVector,
                                     additional_data);
 
+    if (d_dftParamsPtr->poissonPreconditioner == "MULTIGRID")
+      {
+        if (!d_phiTotalMGPreconditionerPtr)
+          {
+            d_phiTotalMGPreconditionerPtr =
+              std::make_shared<poissonMultigridPreconditioner>(
+                mpi_communicator);
+            d_vselfMGPreconditionerPtr =
+              std::make_shared<poissonMultigridPreconditioner>(
+                mpi_communicator);
+          }
+        d_phiTotalMGPreconditionerPtr->initializeLevels(d_dofHandlerPRefined,
+                                                        d_constraintsPRefined,
+                                                        d_domainBoundingVectors,
+                                                        *d_dftParamsPtr);
+        d_vselfMGPreconditionerPtr->initializeLevels(d_dofHandlerPRefined,
+                                                     d_constraintsPRefined,
+                                                     d_domainBoundingVectors,
+                                                     *d_dftParamsPtr);
+        d_phiTotalSolverProblem.setMultigridPreconditioner(
+          d_phiTotalMGPreconditionerPtr);
+        d_vselfBinsManager.setMultigridPreconditioner(
+          d_vselfMGPreconditionerPtr);
+      }
+
     if (recomputeBasisData)
       {
         if (!vselfPerturbationUpdateForStress)
@@ -51,7 +51,9 @@ namespace dftfe
     //
     // set the paths for the Single-Atom wavefunction data
     //
-    char psiFile[256];
+    char                             psiFile[256];
+    std::vector<std::vector<double>> values;
+    bool                             isDataInMemory = false;
 
     if (d_dftParamsPtr->isPseudopotential && d_dftParamsPtr->pseudoTestsFlag)
       // if(d_dftParamsPtr->pseudoProjector==2)
@@ -68,13 +70,24 @@ namespace dftfe
     else if (d_dftParamsPtr->isPseudopotential &&
              !d_dftParamsPtr->pseudoTestsFlag)
       {
-        strcpy(psiFile,
-               (d_dftfeScratchFolderName + "/z" + std::to_string(Z) + "/" +
-                "psi" + std::to_string(n) + std::to_string(l) + ".inp")
-                 .c_str());
-        std::vector<std::vector<double>> values;
-        fileReadFlag = dftUtils::readPsiFile(2, values, psiFile);
-        if (fileReadFlag == 0)
+        // single atom wavefunctions from the parsed pseudopotential file
+        const auto pseudoDataIt = d_pseudoPotentialData.find(Z);
+        if (pseudoDataIt != d_pseudoPotentialData.end())
+          {
+            const auto orbitalIt =
+              pseudoDataIt->second->orbitals.find(std::make_pair(n, l));
+            if (orbitalIt != pseudoDataIt->second->orbitals.end())
+              {
+                values         = orbitalIt->second;
+                isDataInMemory = true;
+                fileReadFlag   = values.size() > 0 ? 1 : 0;
+                if (!d_dftParamsPtr->reproducible_output)
+                  pcout << "reading data of psi" << n << l
+                        << " from pseudopotential file: "
+                        << pseudoDataIt->second->fileName << std::endl;
+              }
+          }
+        if (!isDataInMemory)
           {
             sprintf(
               psiFile,
@@ -94,8 +107,8 @@ namespace dftfe
         n,
         l);
 
-    std::vector<std::vector<double>> values;
-    fileReadFlag = dftUtils::readPsiFile(2, values, psiFile);
+    if (!isDataInMemory)
+      fileReadFlag = dftUtils::readPsiFile(2, values, psiFile);
 
     const double truncationTol =
       d_dftParamsPtr->reproducible_output ? 1e-10 : 1e-8;
@@ -106,7 +119,7 @@ namespace dftfe
       {
         double       maxTruncationRadius = 0.0;
         unsigned int truncRowId          = 0;
-        if (!d_dftParamsPtr->reproducible_output)
+        if (!d_dftParamsPtr->reproducible_output && !isDataInMemory)
           pcout << "reading data from file: " << psiFile << std::endl;
 
         int                 numRows = values.size() - 1;
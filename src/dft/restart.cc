@@ -25,6 +25,7 @@
 #include <fileReaders.h>
 #include <dftUtils.h>
 #include <linearAlgebraOperations.h>
+#include <MPIWriteOnFile.h>
 
 namespace dftfe
 {
@@ -41,6 +42,131 @@ namespace dftfe
                               const std::vector<bool> &  periodicBc);
   } // namespace internal
 
+  namespace
+  {
+    //
+    // indices of the locally owned dofs of the dofHandler in a global
+    // numbering which does not depend on the partitioning of the
+    // triangulation: the hierarchical (z-order) numbering of a second
+    // dofHandler on the same triangulation
+    //
+    std::vector<unsigned long>
+    getPartitionIndependentDofIndices(const dealii::DoFHandler<3> &dofHandlerIn)
+    {
+      dealii::DoFHandler<3> dofHandlerHierarchical(
+        dofHandlerIn.get_triangulation());
+      dofHandlerHierarchical.distribute_dofs(dofHandlerIn.get_fe());
+      dealii::DoFRenumbering::hierarchical(dofHandlerHierarchical);
+
+      const dealii::IndexSet &locallyOwnedSet =
+        dofHandlerIn.locally_owned_dofs();
+      std::vector<unsigned long> partitionIndependentDofIndices(
+        locallyOwnedSet.n_elements(), 0);
+
+      const unsigned int dofsPerCell = dofHandlerIn.get_fe().dofs_per_cell;
+      std::vector<dealii::types::global_dof_index> cellDofIndices(dofsPerCell);
+      std::vector<dealii::types::global_dof_index> cellDofIndicesHierarchical(
+        dofsPerCell);
+
+      dealii::DoFHandler<3>::active_cell_iterator
+        cell             = dofHandlerIn.begin_active(),
+        cellHierarchical = dofHandlerHierarchical.begin_active(),
+        endc             = dofHandlerIn.end();
+      for (; cell != endc; ++cell, ++cellHierarchical)
+        if (cell->is_locally_owned())
+          {
+            cell->get_dof_indices(cellDofIndices);
+            cellHierarchical->get_dof_indices(cellDofIndicesHierarchical);
+            for (unsigned int iNode = 0; iNode < dofsPerCell; ++iNode)
+              if (locallyOwnedSet.is_element(cellDofIndices[iNode]))
+                partitionIndependentDofIndices[locallyOwnedSet
+                                                 .index_within_set(
+                                                   cellDofIndices[iNode])] =
+                  cellDofIndicesHierarchical[iNode];
+          }
+
+      return partitionIndependentDofIndices;
+    }
+
+    //
+    // sort the local dofs by their partition independent indices
+    //
+    void
+    sortDofIndices(const std::vector<unsigned long> &dofIndices,
+                   std::vector<unsigned long> &      sortedDofIndices,
+                   std::vector<unsigned int> &       localDofIdsSorted)
+    {
+      localDofIdsSorted.resize(dofIndices.size());
+      for (unsigned int i = 0; i < dofIndices.size(); ++i)
+        localDofIdsSorted[i] = i;
+      std::sort(localDofIdsSorted.begin(),
+                localDofIdsSorted.end(),
+                [&dofIndices](const unsigned int a, const unsigned int b) {
+                  return dofIndices[a] < dofIndices[b];
+                });
+
+      sortedDofIndices.resize(dofIndices.size());
+      for (unsigned int i = 0; i < dofIndices.size(); ++i)
+        sortedDofIndices[i] = dofIndices[localDofIdsSorted[i]];
+    }
+
+    //
+    // header of the wavefunction checkpoint files: number of global dofs,
+    // spinor factor, number of wavefunctions and size of a wavefunction entry
+    // followed by the Fermi energies (fermiEnergy, fermiEnergyUp,
+    // fermiEnergyDown) and the eigenvalues
+    //
+    const unsigned int wfcHeaderNumberIntegers = 4;
+    const unsigned int wfcHeaderNumberDoubles  = 3;
+    const unsigned int wfcHeaderFixedSize =
+      wfcHeaderNumberIntegers * sizeof(unsigned long) +
+      wfcHeaderNumberDoubles * sizeof(double);
+
+    std::string
+    getWfcCheckpointFileName(const std::string &restartFolder,
+                             const unsigned int kPointGlobalIndex,
+                             const unsigned int spinIndex)
+    {
+      return restartFolder + "/wfcDataKPoint" +
+             std::to_string(kPointGlobalIndex) + "Spin" +
+             std::to_string(spinIndex) + ".chk";
+    }
+
+    //
+    // true if the wavefunction checkpoint file exists, has been written
+    // completely and matches the number of global dofs, the spinor factor and
+    // the real/complex build of the current run
+    //
+    bool
+    isWfcCheckpointFileCompatible(const std::string & fileName,
+                                  const unsigned long numberGlobalDofs,
+                                  const unsigned long spinorFactor)
+    {
+      std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+      if (!file.is_open())
+        return false;
+
+      const unsigned long fileSize = file.tellg();
+      if (fileSize < wfcHeaderFixedSize)
+        return false;
+
+      unsigned long headerIntegers[wfcHeaderNumberIntegers];
+      file.seekg(0);
+      file.read(reinterpret_cast<char *>(headerIntegers),
+                sizeof(headerIntegers));
+      if (!file)
+        return false;
+
+      const unsigned long numEigenValues = headerIntegers[2];
+      return headerIntegers[0] == numberGlobalDofs &&
+             headerIntegers[1] == spinorFactor && numEigenValues > 0 &&
+             headerIntegers[3] == sizeof(dataTypes::number) &&
+             fileSize == wfcHeaderFixedSize + numEigenValues * sizeof(double) +
+                           numberGlobalDofs * spinorFactor * numEigenValues *
+                             sizeof(dataTypes::number);
+    }
+  } // namespace
+
   template <unsigned int              FEOrder,
             unsigned int              FEOrderElectro,
             dftfe::utils::MemorySpace memorySpace>
@@ -187,6 +313,245 @@ namespace dftfe
       }
   }
 
+  template <unsigned int              FEOrder,
+            unsigned int              FEOrderElectro,
+            dftfe::utils::MemorySpace memorySpace>
+  void
+  dftClass<FEOrder, FEOrderElectro, memorySpace>::
+    saveWaveFunctionsAndEigenData()
+  {
+    pcout << "Checkpointing wavefunctions and eigenvalues in progress..."
+          << std::endl;
+
+#ifdef DFTFE_WITH_DEVICE
+    if (d_dftParamsPtr->useDevice)
+      d_eigenVectorsFlattenedDevice.copyTo(d_eigenVectorsFlattenedHost);
+#endif
+
+    // all band groups hold all the wavefunctions at the end of the scf solve
+    if (dealii::Utilities::MPI::this_mpi_process(interBandGroupComm) == 0)
+      {
+        const unsigned int spinorFactor =
+          (d_dftParamsPtr->noncolin || d_dftParamsPtr->hasSOC) ? 2 : 1;
+        const unsigned int numSpins = 1 + d_dftParamsPtr->spinPolarized;
+        const unsigned int localVectorSize =
+          matrix_free_data.get_vector_partitioner()->locally_owned_size();
+        const unsigned long recordSize =
+          spinorFactor * d_numEigenValues * sizeof(dataTypes::number);
+
+        std::vector<unsigned long> sortedDofIndices;
+        std::vector<unsigned int>  localDofIdsSorted;
+        sortDofIndices(getPartitionIndependentDofIndices(dofHandler),
+                       sortedDofIndices,
+                       localDofIdsSorted);
+
+        std::vector<dataTypes::number> wfcSorted(localVectorSize *
+                                                 spinorFactor *
+                                                 d_numEigenValues);
+        std::vector<char> header(wfcHeaderFixedSize +
+                                 d_numEigenValues * sizeof(double));
+        const unsigned long headerIntegers[wfcHeaderNumberIntegers] = {
+          static_cast<unsigned long>(dofHandler.n_dofs()),
+          spinorFactor,
+          d_numEigenValues,
+          sizeof(dataTypes::number)};
+        const double headerDoubles[wfcHeaderNumberDoubles] = {fermiEnergy,
+                                                              fermiEnergyUp,
+                                                              fermiEnergyDown};
+        std::memcpy(&header[0], headerIntegers, sizeof(headerIntegers));
+        std::memcpy(&header[sizeof(headerIntegers)],
+                    headerDoubles,
+                    sizeof(headerDoubles));
+
+        for (unsigned int kPoint = 0; kPoint < d_kPointWeights.size(); ++kPoint)
+          for (unsigned int spinIndex = 0; spinIndex < numSpins; ++spinIndex)
+            {
+              const dataTypes::number *wfc =
+                d_eigenVectorsFlattenedHost.data() +
+                (numSpins * kPoint + spinIndex) * localVectorSize *
+                  spinorFactor * d_numEigenValues;
+              for (unsigned int i = 0; i < localVectorSize; ++i)
+                std::copy(wfc + localDofIdsSorted[i] * spinorFactor *
+                                  d_numEigenValues,
+                          wfc + (localDofIdsSorted[i] + 1) * spinorFactor *
+                                  d_numEigenValues,
+                          wfcSorted.begin() +
+                            i * spinorFactor * d_numEigenValues);
+
+              std::memcpy(&header[wfcHeaderFixedSize],
+                          &eigenValues[kPoint][spinIndex * d_numEigenValues],
+                          d_numEigenValues * sizeof(double));
+
+              dftUtils::MPIWriteOnFile::writeBinaryRecords(
+                header,
+                reinterpret_cast<const char *>(wfcSorted.data()),
+                sortedDofIndices,
+                recordSize,
+                getWfcCheckpointFileName(d_dftParamsPtr->restartFolder,
+                                         lowerBoundKindex + kPoint,
+                                         spinIndex),
+                mpi_communicator);
+            }
+      }
+
+    pcout << "...checkpointing done." << std::endl;
+  }
+
+  template <unsigned int              FEOrder,
+            unsigned int              FEOrderElectro,
+            dftfe::utils::MemorySpace memorySpace>
+  void
+  dftClass<FEOrder, FEOrderElectro, memorySpace>::
+    loadWaveFunctionsAndEigenData()
+  {
+    pcout
+      << "Reading wavefunctions and eigenvalues from checkpoint in progress..."
+      << std::endl;
+
+    const unsigned int spinorFactor =
+      (d_dftParamsPtr->noncolin || d_dftParamsPtr->hasSOC) ? 2 : 1;
+    const unsigned int numSpins = 1 + d_dftParamsPtr->spinPolarized;
+    const unsigned int localVectorSize =
+      matrix_free_data.get_vector_partitioner()->locally_owned_size();
+
+    // the checkpoint files of all the k-points and spins are checked before
+    // any of them is read. If one of them is missing, incomplete or was
+    // written for a different mesh or build, all the pools keep the initial
+    // guess wavefunctions.
+    int isCheckpointCompatible = 1;
+    if (dealii::Utilities::MPI::this_mpi_process(mpi_communicator) == 0)
+      for (unsigned int kPoint = 0; kPoint < d_kPointWeights.size(); ++kPoint)
+        for (unsigned int spinIndex = 0; spinIndex < numSpins; ++spinIndex)
+          {
+            const std::string fileName =
+              getWfcCheckpointFileName(d_dftParamsPtr->restartFolder,
+                                       lowerBoundKindex + kPoint,
+                                       spinIndex);
+            if (isCheckpointCompatible == 1 &&
+                !isWfcCheckpointFileCompatible(fileName,
+                                               dofHandler.n_dofs(),
+                                               spinorFactor))
+              {
+                isCheckpointCompatible = 0;
+                if (dealii::Utilities::MPI::this_mpi_process(
+                      interBandGroupComm) == 0)
+                  std::cout
+                    << "DFT-FE Warning: wavefunction checkpoint file "
+                    << fileName
+                    << " is missing, incomplete or not compatible with the current mesh, spinor type or real/complex build."
+                    << std::endl;
+              }
+          }
+    MPI_Allreduce(MPI_IN_PLACE,
+                  &isCheckpointCompatible,
+                  1,
+                  MPI_INT,
+                  MPI_MIN,
+                  d_mpiCommParent);
+    if (isCheckpointCompatible == 0)
+      {
+        if (dealii::Utilities::MPI::this_mpi_process(d_mpiCommParent) == 0)
+          std::cout
+            << "DFT-FE Warning: LOAD WFC DATA is ignored, the SCF solve starts from the initial guess wavefunctions."
+            << std::endl;
+        return;
+      }
+
+    std::vector<unsigned long> sortedDofIndices;
+    std::vector<unsigned int>  localDofIdsSorted;
+    sortDofIndices(getPartitionIndependentDofIndices(dofHandler),
+                   sortedDofIndices,
+                   localDofIdsSorted);
+
+    std::vector<dataTypes::number> wfcSorted;
+    for (unsigned int kPoint = 0; kPoint < d_kPointWeights.size(); ++kPoint)
+      for (unsigned int spinIndex = 0; spinIndex < numSpins; ++spinIndex)
+        {
+          const std::string fileName =
+            getWfcCheckpointFileName(d_dftParamsPtr->restartFolder,
+                                     lowerBoundKindex + kPoint,
+                                     spinIndex);
+
+          std::vector<char> header(wfcHeaderFixedSize);
+          dftUtils::MPIWriteOnFile::readBinaryHeader(header,
+                                                     fileName,
+                                                     mpi_communicator);
+          unsigned long headerIntegers[wfcHeaderNumberIntegers];
+          double        headerDoubles[wfcHeaderNumberDoubles];
+          std::memcpy(headerIntegers, &header[0], sizeof(headerIntegers));
+          std::memcpy(headerDoubles,
+                      &header[sizeof(headerIntegers)],
+                      sizeof(headerDoubles));
+
+          AssertThrow(
+            headerIntegers[0] == dofHandler.n_dofs() &&
+              headerIntegers[1] == spinorFactor &&
+              headerIntegers[3] == sizeof(dataTypes::number),
+            dealii::ExcMessage(
+              "DFT-FE Error: wavefunction checkpoint file " + fileName +
+              " is not compatible with the current mesh, spinor type or real/complex build."));
+
+          const unsigned int numEigenValuesRead = headerIntegers[2];
+          const unsigned int numEigenValuesCopy =
+            std::min(numEigenValuesRead, d_numEigenValues);
+
+          header.resize(wfcHeaderFixedSize +
+                        numEigenValuesRead * sizeof(double));
+          dftUtils::MPIWriteOnFile::readBinaryHeader(header,
+                                                     fileName,
+                                                     mpi_communicator);
+
+          wfcSorted.resize(localVectorSize * spinorFactor * numEigenValuesRead);
+          dftUtils::MPIWriteOnFile::readBinaryRecords(
+            header.size(),
+            sortedDofIndices,
+            spinorFactor * numEigenValuesRead * sizeof(dataTypes::number),
+            reinterpret_cast<char *>(wfcSorted.data()),
+            fileName,
+            mpi_communicator);
+
+          // wavefunctions beyond the ones in the checkpoint keep the
+          // initial guess
+          dataTypes::number *wfc = d_eigenVectorsFlattenedHost.data() +
+                                   (numSpins * kPoint + spinIndex) *
+                                     localVectorSize * spinorFactor *
+                                     d_numEigenValues;
+          for (unsigned int i = 0; i < localVectorSize; ++i)
+            for (unsigned int iSpinor = 0; iSpinor < spinorFactor; ++iSpinor)
+              std::copy(wfcSorted.begin() +
+                          (i * spinorFactor + iSpinor) * numEigenValuesRead,
+                        wfcSorted.begin() +
+                          (i * spinorFactor + iSpinor) * numEigenValuesRead +
+                          numEigenValuesCopy,
+                        wfc + (localDofIdsSorted[i] * spinorFactor + iSpinor) *
+                                d_numEigenValues);
+
+          for (unsigned int iWave = 0; iWave < d_numEigenValues; ++iWave)
+            {
+              double eigenValue;
+              std::memcpy(
+                &eigenValue,
+                &header[wfcHeaderFixedSize +
+                        std::min(iWave, numEigenValuesRead - 1) *
+                          sizeof(double)],
+                sizeof(double));
+              eigenValues[kPoint][spinIndex * d_numEigenValues + iWave] =
+                eigenValue;
+            }
+
+          fermiEnergy     = headerDoubles[0];
+          fermiEnergyUp   = headerDoubles[1];
+          fermiEnergyDown = headerDoubles[2];
+        }
+
+#ifdef DFTFE_WITH_DEVICE
+    if (d_dftParamsPtr->useDevice)
+      d_eigenVectorsFlattenedDevice.copyFrom(d_eigenVectorsFlattenedHost);
+#endif
+
+    pcout << "...Reading from checkpoint done." << std::endl;
+  }
+
   template <unsigned int              FEOrder,
             unsigned int              FEOrderElectro,
             dftfe::utils::MemorySpace memorySpace>
@@ -416,8 +416,27 @@ namespace dftfe
                                 mpi_communicator,
                                 dealiiLinearSolver::CG);
 
-    poissonSolverProblem<FEOrder, FEOrderElectro> vselfSolverProblem(
-      mpi_communicator);
+    // Without the multigrid preconditioner the vself solves (and the derR
+    // solves) of the bins are collected and solved together by a block CG,
+    // in blocks of at most VSELF BLOCK SIZE problems, which needs one
+    // poissonSolverProblem object per solve in the block. The multigrid
+    // preconditioner is set up for the constraints of one problem at a time,
+    // so with it every problem is solved right after its reinit.
+    const bool isBlockSolve = !d_mgPreconditionerPtr;
+    std::vector<
+      std::unique_ptr<poissonSolverProblem<FEOrder, FEOrderElectro>>>
+                                             vselfSolverProblems;
+    std::vector<dealiiLinearSolverProblem *> blockSolveProblems;
+
+    // solves the collected problems together and releases them
+    auto solveBlockSolveProblems = [&]() {
+      CGSolver.solveBlock(blockSolveProblems,
+                          d_dftParams.absLinearSolverTolerance,
+                          d_dftParams.maxLinearSolverIterations,
+                          d_dftParams.verbosity);
+      blockSolveProblems.clear();
+      vselfSolverProblems.clear();
+    };
 
     std::map<dealii::types::global_dof_index, dealii::Point<3>> supportPoints;
     dealii::DoFTools::map_dofs_to_support_points(
@@ -435,13 +454,15 @@ namespace dftfe
     else
       d_vselfFieldPerturbedBins.resize(numberBins);
 
-    std::map<dealii::CellId, std::vector<double>> bQuadValuesBin;
+    std::vector<std::map<dealii::CellId, std::vector<double>>> bQuadValuesBins(
+      numberBins);
     dftfe::utils::MemoryStorage<double, dftfe::utils::MemorySpace::HOST> dummy;
 
-    distributedCPUVec<double>              vselfBinScratch;
-    std::vector<distributedCPUVec<double>> vselfDerRBinScratch(3);
-    std::vector<unsigned int>              constraintMatrixIdVselfDerR(3);
+    std::vector<unsigned int> constraintMatrixIdVselfDerR(3);
 
+    //
+    // set up the vself (and derR) solver problems of all bins
+    //
     for (unsigned int iBin = 0; iBin < numberBins; ++iBin)
       {
         double init_time;
@@ -504,7 +525,8 @@ namespace dftfe
                                         numberGlobalCharges);
           }
 
-        bQuadValuesBin.clear();
+        std::map<dealii::CellId, std::vector<double>> &bQuadValuesBin =
+          bQuadValuesBins[iBin];
         if (useSmearedCharges)
           smearedNuclearCharges(dofHandler,
                                 matrix_free_data.get_quadrature(
@@ -527,6 +549,9 @@ namespace dftfe
                                 smearedChargeScaling);
 
         const unsigned int constraintMatrixIdVself = 4 * iBin + offset;
+        distributedCPUVec<double> &vselfBinScratch =
+          isVselfPerturbationSolve ? d_vselfFieldPerturbedBins[iBin] :
+                                     d_vselfFieldBins[iBin];
         matrix_free_data.initialize_dof_vector(vselfBinScratch,
                                                constraintMatrixIdVself);
         vselfBinScratch = 0;
@@ -560,9 +585,9 @@ namespace dftfe
                   constraintMatrixIdVselfDerR[idim] =
                     4 * iBin + idim + offset + 1;
                   matrix_free_data.initialize_dof_vector(
-                    vselfDerRBinScratch[idim],
+                    d_vselfFieldDerRBins[3 * iBin + idim],
                     constraintMatrixIdVselfDerR[idim]);
-                  vselfDerRBinScratch[idim] = 0;
+                  d_vselfFieldDerRBins[3 * iBin + idim] = 0;
                 }
           }
         else
@@ -582,11 +607,20 @@ namespace dftfe
         MPI_Barrier(d_mpiCommParent);
         vselfinit_time = MPI_Wtime();
 
+        if (isBlockSolve || vselfSolverProblems.size() == 0)
+          {
+            vselfSolverProblems.push_back(
+              std::make_unique<poissonSolverProblem<FEOrder, FEOrderElectro>>(
+                mpi_communicator));
+            vselfSolverProblems.back()->setMultigridPreconditioner(
+              d_mgPreconditionerPtr);
+          }
+
         //
-        // call the poisson solver to compute vSelf in current bin
+        // set up the poisson problem to compute vSelf in current bin
         //
         if (useSmearedCharges)
-          vselfSolverProblem.reinit(
+          vselfSolverProblems.back()->reinit(
             basisOperationsPtr,
             vselfBinScratch,
             d_vselfBinConstraintMatrices[4 * iBin],
@@ -607,25 +641,26 @@ namespace dftfe
             false,
             true);
         else
-          vselfSolverProblem.reinit(basisOperationsPtr,
-                                    vselfBinScratch,
-                                    d_vselfBinConstraintMatrices[4 * iBin],
-                                    constraintMatrixIdVself,
-                                    0,
-                                    matrixFreeQuadratureIdAX,
-                                    d_atomsInBin[iBin],
-                                    bQuadValuesBin,
-                                    smearedChargeQuadratureId,
-                                    dummy,
-                                    true,
-                                    false,
-                                    false,
-                                    false,
-                                    false,
-                                    0,
-                                    false,
-                                    false,
-                                    true);
+          vselfSolverProblems.back()->reinit(
+            basisOperationsPtr,
+            vselfBinScratch,
+            d_vselfBinConstraintMatrices[4 * iBin],
+            constraintMatrixIdVself,
+            0,
+            matrixFreeQuadratureIdAX,
+            d_atomsInBin[iBin],
+            bQuadValuesBin,
+            smearedChargeQuadratureId,
+            dummy,
+            true,
+            false,
+            false,
+            false,
+            false,
+            0,
+            false,
+            false,
+            true);
 
         MPI_Barrier(d_mpiCommParent);
         vselfinit_time = MPI_Wtime() - vselfinit_time;
@@ -633,22 +668,41 @@ namespace dftfe
           pcout << " Time taken for vself solver problem init for current bin: "
                 << vselfinit_time << std::endl;
 
-        CGSolver.solve(vselfSolverProblem,
-                       d_dftParams.absLinearSolverTolerance,
-                       d_dftParams.maxLinearSolverIterations,
-                       d_dftParams.verbosity);
+        if (isBlockSolve)
+          {
+            blockSolveProblems.push_back(vselfSolverProblems.back().get());
+            if (blockSolveProblems.size() == d_dftParams.vselfBlockSolveSize)
+              solveBlockSolveProblems();
+          }
+        else
+          CGSolver.solve(*vselfSolverProblems.back(),
+                         d_dftParams.absLinearSolverTolerance,
+                         d_dftParams.maxLinearSolverIterations,
+                         d_dftParams.verbosity);
 
         if (useSmearedCharges && !isVselfPerturbationSolve)
           for (unsigned int idim = 0; idim < 3; idim++)
             {
               MPI_Barrier(d_mpiCommParent);
               vselfinit_time = MPI_Wtime();
+
+              if (isBlockSolve)
+                {
+                  vselfSolverProblems.push_back(
+                    std::make_unique<
+                      poissonSolverProblem<FEOrder, FEOrderElectro>>(
+                      mpi_communicator));
+                  vselfSolverProblems.back()->setMultigridPreconditioner(
+                    d_mgPreconditionerPtr);
+                }
+
               //
-              // call the poisson solver to compute vSelf in current bin
+              // set up the poisson problem to compute vSelf derR in current
+              // bin
               //
-              vselfSolverProblem.reinit(
+              vselfSolverProblems.back()->reinit(
                 basisOperationsPtr,
-                vselfDerRBinScratch[idim],
+                d_vselfFieldDerRBins[3 * iBin + idim],
                 d_vselfBinConstraintMatrices[4 * iBin + idim + 1],
                 constraintMatrixIdVselfDerR[idim],
                 0,
@@ -675,144 +729,146 @@ namespace dftfe
                   << " Time taken for vself solver problem init for current bin: "
                   << vselfinit_time << std::endl;
 
-              CGSolver.solve(vselfSolverProblem,
-                             d_dftParams.absLinearSolverTolerance,
-                             d_dftParams.maxLinearSolverIterations,
-                             d_dftParams.verbosity);
+              if (isBlockSolve)
+                {
+                  blockSolveProblems.push_back(
+                    vselfSolverProblems.back().get());
+                  if (blockSolveProblems.size() ==
+                      d_dftParams.vselfBlockSolveSize)
+                    solveBlockSolveProblems();
+                }
+              else
+                CGSolver.solve(*vselfSolverProblems.back(),
+                               d_dftParams.absLinearSolverTolerance,
+                               d_dftParams.maxLinearSolverIterations,
+                               d_dftParams.verbosity);
             }
+      } // bin loop
 
-        //
-        // store Vselfs for atoms in bin
-        //
-        if (!isVselfPerturbationSolve)
-          {
-            if (useSmearedCharges)
-              {
-                double selfenergy_time;
-                MPI_Barrier(d_mpiCommParent);
-                selfenergy_time = MPI_Wtime();
-
-                dealii::FEEvaluation<3, -1> fe_eval_sc(
-                  matrix_free_data,
-                  constraintMatrixIdVself,
-                  smearedChargeQuadratureId);
+    //
+    // solve the remaining collected poisson problems together
+    //
+    solveBlockSolveProblems();
 
-                double vselfTimesSmearedChargesIntegralBin = 0.0;
+    //
+    // store Vselfs for atoms in bin
+    //
+    if (!isVselfPerturbationSolve)
+      for (unsigned int iBin = 0; iBin < numberBins; ++iBin)
+        {
+          const unsigned int constraintMatrixIdVself = 4 * iBin + offset;
+          const distributedCPUVec<double> &vselfBinScratch =
+            d_vselfFieldBins[iBin];
+          std::map<dealii::CellId, std::vector<double>> &bQuadValuesBin =
+            bQuadValuesBins[iBin];
+          if (useSmearedCharges)
+            {
+              double selfenergy_time;
+              MPI_Barrier(d_mpiCommParent);
+              selfenergy_time = MPI_Wtime();
 
-                const unsigned int numQuadPointsSmearedb =
-                  fe_eval_sc.n_q_points;
-                dealii::AlignedVector<dealii::VectorizedArray<double>>
-                  smearedbQuads(numQuadPointsSmearedb,
-                                dealii::make_vectorized_array(0.0));
-                for (unsigned int macrocell = 0;
-                     macrocell < matrix_free_data.n_cell_batches();
-                     ++macrocell)
-                  {
-                    std::fill(smearedbQuads.begin(),
-                              smearedbQuads.end(),
-                              dealii::make_vectorized_array(0.0));
-                    bool               isMacroCellTrivial = true;
-                    const unsigned int numSubCells =
-                      matrix_free_data.n_active_entries_per_cell_batch(
-                        macrocell);
-                    for (unsigned int iSubCell = 0; iSubCell < numSubCells;
-                         ++iSubCell)
-                      {
-                        subCellPtr = matrix_free_data.get_cell_iterator(
-                          macrocell, iSubCell, constraintMatrixIdVself);
-                        dealii::CellId             subCellId = subCellPtr->id();
-                        const std::vector<double> &tempVec =
-                          bQuadValuesBin.find(subCellId)->second;
-                        if (tempVec.size() == 0)
-                          continue;
+              dealii::FEEvaluation<3, -1> fe_eval_sc(
+                matrix_free_data,
+                constraintMatrixIdVself,
+                smearedChargeQuadratureId);
 
-                        for (unsigned int q = 0; q < numQuadPointsSmearedb; ++q)
-                          smearedbQuads[q][iSubCell] = tempVec[q];
+              double vselfTimesSmearedChargesIntegralBin = 0.0;
 
-                        isMacroCellTrivial = false;
-                      }
+              const unsigned int numQuadPointsSmearedb =
+                fe_eval_sc.n_q_points;
+              dealii::AlignedVector<dealii::VectorizedArray<double>>
+                smearedbQuads(numQuadPointsSmearedb,
+                              dealii::make_vectorized_array(0.0));
+              for (unsigned int macrocell = 0;
+                   macrocell < matrix_free_data.n_cell_batches();
+                   ++macrocell)
+                {
+                  std::fill(smearedbQuads.begin(),
+                            smearedbQuads.end(),
+                            dealii::make_vectorized_array(0.0));
+                  bool               isMacroCellTrivial = true;
+                  const unsigned int numSubCells =
+                    matrix_free_data.n_active_entries_per_cell_batch(
+                      macrocell);
+                  for (unsigned int iSubCell = 0; iSubCell < numSubCells;
+                       ++iSubCell)
+                    {
+                      subCellPtr = matrix_free_data.get_cell_iterator(
+                        macrocell, iSubCell, constraintMatrixIdVself);
+                      dealii::CellId             subCellId = subCellPtr->id();
+                      const std::vector<double> &tempVec =
+                        bQuadValuesBin.find(subCellId)->second;
+                      if (tempVec.size() == 0)
+                        continue;
 
-                    if (!isMacroCellTrivial)
-                      {
-                        fe_eval_sc.reinit(macrocell);
-                        fe_eval_sc.read_dof_values_plain(vselfBinScratch);
-                        fe_eval_sc.evaluate(true, false);
-                        for (unsigned int q = 0; q < fe_eval_sc.n_q_points; ++q)
-                          {
-                            fe_eval_sc.submit_value(fe_eval_sc.get_value(q) *
-                                                      smearedbQuads[q],
-                                                    q);
-                          }
-                        dealii::VectorizedArray<double> val =
-                          fe_eval_sc.integrate_value();
+                      for (unsigned int q = 0; q < numQuadPointsSmearedb; ++q)
+                        smearedbQuads[q][iSubCell] = tempVec[q];
 
-                        for (unsigned int iSubCell = 0; iSubCell < numSubCells;
-                             ++iSubCell)
-                          vselfTimesSmearedChargesIntegralBin += val[iSubCell];
-                      }
-                  }
+                      isMacroCellTrivial = false;
+                    }
 
-                cell = dofHandler.begin_active();
-                for (; cell != endc; ++cell)
-                  if (cell->is_locally_owned())
+                  if (!isMacroCellTrivial)
                     {
-                      std::vector<double> &bQuadValuesBinCell =
-                        bQuadValuesBin[cell->id()];
-                      std::vector<double> &bQuadValuesAllAtomsCell =
-                        bQuadValuesAllAtoms[cell->id()];
-
-                      if (bQuadValuesBinCell.size() == 0)
-                        continue;
+                      fe_eval_sc.reinit(macrocell);
+                      fe_eval_sc.read_dof_values_plain(vselfBinScratch);
+                      fe_eval_sc.evaluate(true, false);
+                      for (unsigned int q = 0; q < fe_eval_sc.n_q_points; ++q)
+                        {
+                          fe_eval_sc.submit_value(fe_eval_sc.get_value(q) *
+                                                    smearedbQuads[q],
+                                                  q);
+                        }
+                      dealii::VectorizedArray<double> val =
+                        fe_eval_sc.integrate_value();
 
-                      for (unsigned int q = 0; q < n_q_points_sc; ++q)
-                        bQuadValuesAllAtomsCell[q] += bQuadValuesBinCell[q];
+                      for (unsigned int iSubCell = 0; iSubCell < numSubCells;
+                           ++iSubCell)
+                        vselfTimesSmearedChargesIntegralBin += val[iSubCell];
                     }
+                }
 
-                localVselfs[0][0] += vselfTimesSmearedChargesIntegralBin;
-
-                MPI_Barrier(d_mpiCommParent);
-                selfenergy_time = MPI_Wtime() - selfenergy_time;
-                if (d_dftParams.verbosity >= 4)
-                  pcout << " Time taken for vself self energy for current bin: "
-                        << selfenergy_time << std::endl;
-              }
-            else
-              {
-                for (std::map<dealii::types::global_dof_index, double>::iterator
-                       it = d_atomsInBin[iBin].begin();
-                     it != d_atomsInBin[iBin].end();
-                     ++it)
+              cell = dofHandler.begin_active();
+              for (; cell != endc; ++cell)
+                if (cell->is_locally_owned())
                   {
-                    std::vector<double> temp(2, 0.0);
-                    temp[0] = it->second;                 // charge;
-                    temp[1] = vselfBinScratch(it->first); // vself
-                    if (d_dftParams.verbosity >= 4)
-                      std::cout << "(only for debugging: peak value of Vself: "
-                                << temp[1] << ")" << std::endl;
-
-                    localVselfs.push_back(temp);
+                    std::vector<double> &bQuadValuesBinCell =
+                      bQuadValuesBin[cell->id()];
+                    std::vector<double> &bQuadValuesAllAtomsCell =
+                      bQuadValuesAllAtoms[cell->id()];
+
+                    if (bQuadValuesBinCell.size() == 0)
+                      continue;
+
+                    for (unsigned int q = 0; q < n_q_points_sc; ++q)
+                      bQuadValuesAllAtomsCell[q] += bQuadValuesBinCell[q];
                   }
-              }
 
-            //
-            // store solved vselfBinScratch field
-            //
-            d_vselfFieldBins[iBin] = vselfBinScratch;
+              localVselfs[0][0] += vselfTimesSmearedChargesIntegralBin;
 
+              MPI_Barrier(d_mpiCommParent);
+              selfenergy_time = MPI_Wtime() - selfenergy_time;
+              if (d_dftParams.verbosity >= 4)
+                pcout << " Time taken for vself self energy for current bin: "
+                      << selfenergy_time << std::endl;
+            }
+          else
+            {
+              for (std::map<dealii::types::global_dof_index, double>::iterator
+                     it = d_atomsInBin[iBin].begin();
+                   it != d_atomsInBin[iBin].end();
+                   ++it)
+                {
+                  std::vector<double> temp(2, 0.0);
+                  temp[0] = it->second;                 // charge;
+                  temp[1] = vselfBinScratch(it->first); // vself
+                  if (d_dftParams.verbosity >= 4)
+                    std::cout << "(only for debugging: peak value of Vself: "
+                              << temp[1] << ")" << std::endl;
 
-            if (useSmearedCharges)
-              for (unsigned int idim = 0; idim < 3; idim++)
-                d_vselfFieldDerRBins[3 * iBin + idim] =
-                  vselfDerRBinScratch[idim];
-          }
-        else
-          {
-            //
-            // store solved vselfBinScratch field
-            //
-            d_vselfFieldPerturbedBins[iBin] = vselfBinScratch;
-          }
-      } // bin loop
+                  localVselfs.push_back(temp);
+                }
+            }
+        } // bin loop
   }
 
 #ifdef DFTFE_WITH_DEVICE
@@ -147,6 +147,29 @@ namespace dftfe
       }
 
 
+      // p=u+beta*p and q=w+beta*q
+      __global__ void
+      updateDirectionsBlockedKernel(const unsigned int blockSize,
+                                    const unsigned int numContiguousBlocks,
+                                    const double *     u,
+                                    const double *     w,
+                                    const double *     beta,
+                                    double *           p,
+                                    double *           q)
+      {
+        const unsigned int globalThreadId =
+          blockIdx.x * blockDim.x + threadIdx.x;
+
+        for (unsigned int index = globalThreadId;
+             index < numContiguousBlocks * blockSize;
+             index += blockDim.x * gridDim.x)
+          {
+            const unsigned int blockIndex      = index / blockSize;
+            const unsigned int intraBlockIndex = index - blockIndex * blockSize;
+            p[index] = u[index] + beta[intraBlockIndex] * p[index];
+            q[index] = w[index] + beta[intraBlockIndex] * q[index];
+          }
+      }
 
       void
       computeAX(
@@ -633,17 +656,11 @@ namespace dftfe
       const unsigned int inc = 1;
 
       dftfe::utils::MemoryStorage<double, dftfe::utils::MemorySpace::DEVICE>
-        delta_newD(numberBins, 0.0);
-      dftfe::utils::MemoryStorage<double, dftfe::utils::MemorySpace::DEVICE>
-        delta_oldD(numberBins, 0.0);
-      dftfe::utils::MemoryStorage<double, dftfe::utils::MemorySpace::DEVICE>
-        delta_0D(numberBins, 0.0);
+        gammaDeltaD(2 * numberBins, 0.0);
       dftfe::utils::MemoryStorage<double, dftfe::utils::MemorySpace::DEVICE>
         alphaD(numberBins, 0.0);
       dftfe::utils::MemoryStorage<double, dftfe::utils::MemorySpace::DEVICE>
         betaD(numberBins, 0.0);
-      dftfe::utils::MemoryStorage<double, dftfe::utils::MemorySpace::DEVICE>
-        scalarD(numberBins, 0.0);
       dftfe::utils::MemoryStorage<double, dftfe::utils::MemorySpace::DEVICE>
         residualNormSqD(numberBins, 0.0);
       dftfe::utils::MemoryStorage<double, dftfe::utils::MemorySpace::DEVICE>
@@ -661,12 +678,12 @@ namespace dftfe
         cellStiffnessMatrixTimesVectorD(totalLocallyOwnedCells *
                                         numberNodesPerElement * numberBins);
 
-      std::vector<double> delta_newH(numberBins, 0.0);
-      std::vector<double> delta_oldH(numberBins, 0.0);
-      std::vector<double> alphaH(numberBins, 0.0);
-      std::vector<double> betaH(numberBins, 0.0);
-      std::vector<double> scalarH(numberBins, 0.0);
-      std::vector<double> residualNormSqH(numberBins, 0.0);
+      std::vector<double>       gammaDeltaH(2 * numberBins, 0.0);
+      std::vector<double>       gammaOldH(numberBins, 0.0);
+      std::vector<double>       alphaH(numberBins, 0.0);
+      std::vector<double>       betaH(numberBins, 0.0);
+      std::vector<double>       residualNormSqH(numberBins, 0.0);
+      std::vector<unsigned int> isConvergedH(numberBins, 0);
 
       // compute RHS b
       // dftfe::utils::MemoryStorage<double,dftfe::utils::MemorySpace::DEVICE>
@@ -755,136 +772,171 @@ namespace dftfe
                                             inc);
 
 
-      // precondition r
-      // dftfe::utils::MemoryStorage<double,dftfe::utils::MemorySpace::DEVICE>
-      // d; d.resize(localSize,0.0);
+      // Chronopoulos-Gear variant of the preconditioned CG: u=M^{-1}*r and
+      // w=A*u are formed before the inner products so that (r,u) and (w,u)
+      // of all the bins are reduced together in a single MPI_Allreduce per
+      // iteration. The search direction d and q=A*d are then updated by
+      // recurrences. s stores u.
+      distributedDeviceVec<double> w;
+      w.reinit(x);
 
-      // precondition_Jacobi(r,d);
+      // u=M^{-1}*r
       precondition_Jacobi(
-        r.begin(), diagonalAD, numberBins, localSize, d.begin());
-
-
-      computeResidualSq(handle,
-                        r.begin(),
-                        d.begin(),
-                        vecTempD.begin(),
-                        onesVecD.begin(),
-                        numberBins,
-                        localSize,
-                        delta_newD.begin());
+        r.begin(), diagonalAD, numberBins, localSize, s.begin());
 
-      dftfe::utils::deviceMemcpyD2H(&delta_newH[0],
-                                    delta_newD.begin(),
-                                    numberBins * sizeof(double));
-
-
-      MPI_Allreduce(MPI_IN_PLACE,
-                    &delta_newH[0],
-                    numberBins,
-                    MPI_DOUBLE,
-                    MPI_SUM,
-                    mpiCommDomain);
-
-      dftfe::utils::deviceMemcpyH2D(delta_newD.begin(),
-                                    &delta_newH[0],
-                                    numberBins * sizeof(double));
+      // w=A*u
+      computeAX(handle,
+                constraintsMatrixDataInfoDevice,
+                s,
+                temp,
+                totalLocallyOwnedCells,
+                numberNodesPerElement,
+                numberBins,
+                localSize,
+                ghostSize,
+                poissonCellStiffnessMatricesD,
+                inhomoIdsColoredVecFlattenedD,
+                cellLocalProcIndexIdMapD,
+                w,
+                cellNodalVectorD,
+                cellStiffnessMatrixTimesVectorD);
 
-      // assign delta0 to delta_new
-      delta_0D = delta_newD;
+      if (debugLevel >= 2)
+        {
+          computeResidualSq(handle,
+                            r.begin(),
+                            r.begin(),
+                            vecTempD.begin(),
+                            onesVecD.begin(),
+                            numberBins,
+                            localSize,
+                            residualNormSqD.begin());
 
-      // allocate memory for q
-      // dftfe::utils::MemoryStorage<double,dftfe::utils::MemorySpace::DEVICE>
-      // q,s; q.resize(localSize,0.0); s.resize(localSize,0.0);
+          dftfe::utils::deviceMemcpyD2H(&residualNormSqH[0],
+                                        residualNormSqD.begin(),
+                                        numberBins * sizeof(double));
 
-      unsigned int iterationNumber = 0;
 
-      computeResidualSq(handle,
-                        r.begin(),
-                        r.begin(),
-                        vecTempD.begin(),
-                        onesVecD.begin(),
+          MPI_Allreduce(MPI_IN_PLACE,
+                        &residualNormSqH[0],
                         numberBins,
-                        localSize,
-                        residualNormSqD.begin());
-
-      dftfe::utils::deviceMemcpyD2H(&residualNormSqH[0],
-                                    residualNormSqD.begin(),
-                                    numberBins * sizeof(double));
-
-
-      MPI_Allreduce(MPI_IN_PLACE,
-                    &residualNormSqH[0],
-                    numberBins,
-                    MPI_DOUBLE,
-                    MPI_SUM,
-                    mpiCommDomain);
+                        MPI_DOUBLE,
+                        MPI_SUM,
+                        mpiCommDomain);
 
-      if (debugLevel >= 2 && this_process == 0)
-        {
-          for (unsigned int i = 0; i < numberBins; i++)
-            std::cout
-              << "Device based Linear Conjugate Gradient solver for bin: " << i
-              << " started with residual norm squared: " << residualNormSqH[i]
-              << std::endl;
+          if (this_process == 0)
+            for (unsigned int i = 0; i < numberBins; i++)
+              std::cout
+                << "Device based Linear Conjugate Gradient solver for bin: "
+                << i << " started with residual norm squared: "
+                << residualNormSqH[i] << std::endl;
         }
 
-      for (unsigned int iter = 0; iter < maxIter; ++iter)
+      unsigned int iterationNumber = 0;
+      for (unsigned int iter = 0; iter <= maxIter; ++iter)
         {
-          // q = Ad
-          // computeAX(d,q);
-
-
-          computeAX(handle,
-                    constraintsMatrixDataInfoDevice,
-                    d,
-                    temp,
-                    totalLocallyOwnedCells,
-                    numberNodesPerElement,
-                    numberBins,
-                    localSize,
-                    ghostSize,
-                    poissonCellStiffnessMatricesD,
-                    inhomoIdsColoredVecFlattenedD,
-                    cellLocalProcIndexIdMapD,
-                    q,
-                    cellNodalVectorD,
-                    cellStiffnessMatrixTimesVectorD);
-
-          // compute alpha
+          // gamma=(r,u) and delta=(w,u) packed as [gamma,delta]
           computeResidualSq(handle,
-                            d.begin(),
-                            q.begin(),
+                            r.begin(),
+                            s.begin(),
                             vecTempD.begin(),
                             onesVecD.begin(),
                             numberBins,
                             localSize,
-                            scalarD.begin());
+                            gammaDeltaD.begin());
 
-          dftfe::utils::deviceMemcpyD2H(&scalarH[0],
-                                        scalarD.begin(),
-                                        numberBins * sizeof(double));
+          computeResidualSq(handle,
+                            w.begin(),
+                            s.begin(),
+                            vecTempD.begin(),
+                            onesVecD.begin(),
+                            numberBins,
+                            localSize,
+                            gammaDeltaD.begin() + numberBins);
 
+          dftfe::utils::deviceMemcpyD2H(&gammaDeltaH[0],
+                                        gammaDeltaD.begin(),
+                                        2 * numberBins * sizeof(double));
 
           MPI_Allreduce(MPI_IN_PLACE,
-                        &scalarH[0],
-                        numberBins,
+                        &gammaDeltaH[0],
+                        2 * numberBins,
                         MPI_DOUBLE,
                         MPI_SUM,
                         mpiCommDomain);
 
-          // for (unsigned int i=0;i <numberBins; i++)
-          //   std::cout<< "scalar "<<scalarH[i]<<std::endl;
-
+          // converged bins drop out of the active set: their step lengths are
+          // set to zero which freezes x and r for those bins
+          unsigned int isBreak = 1;
           for (unsigned int i = 0; i < numberBins; i++)
-            alphaH[i] = delta_newH[i] / scalarH[i];
+            {
+              const double gamma = gammaDeltaH[i];
+              const double delta = gammaDeltaH[numberBins + i];
+              if (gamma <= absTol * absTol)
+                isConvergedH[i] = 1;
+
+              if (isConvergedH[i] == 1)
+                {
+                  alphaH[i] = 0.0;
+                  betaH[i]  = 0.0;
+                  continue;
+                }
+
+              isBreak = 0;
+              if (iter == 0)
+                {
+                  betaH[i]  = 0.0;
+                  alphaH[i] = gamma / delta;
+                }
+              else
+                {
+                  betaH[i]  = gamma / gammaOldH[i];
+                  alphaH[i] = gamma / (delta - betaH[i] * gamma / alphaH[i]);
+                }
+              gammaOldH[i] = gamma;
+            }
 
-          // for (unsigned int i=0;i <numberBins; i++)
-          //   std::cout<< "alpha "<<alphaH[i]<<std::endl;
+          if (isBreak == 1 || iter == maxIter)
+            break;
 
           dftfe::utils::deviceMemcpyH2D(alphaD.begin(),
                                         &alphaH[0],
                                         numberBins * sizeof(double));
 
+          dftfe::utils::deviceMemcpyH2D(betaD.begin(),
+                                        &betaH[0],
+                                        numberBins * sizeof(double));
+
+          // d=u+beta*d, q=w+beta*q
+          if (localSize > 0)
+#  ifdef DFTFE_WITH_DEVICE_LANG_CUDA
+            updateDirectionsBlockedKernel<<<
+              (numberBins + (dftfe::utils::DEVICE_BLOCK_SIZE - 1)) /
+                dftfe::utils::DEVICE_BLOCK_SIZE * localSize,
+              dftfe::utils::DEVICE_BLOCK_SIZE>>>(numberBins,
+                                                 localSize,
+                                                 s.begin(),
+                                                 w.begin(),
+                                                 betaD.begin(),
+                                                 d.begin(),
+                                                 q.begin());
+#  elif DFTFE_WITH_DEVICE_LANG_HIP
+            hipLaunchKernelGGL(updateDirectionsBlockedKernel,
+                               (numberBins +
+                                (dftfe::utils::DEVICE_BLOCK_SIZE - 1)) /
+                                 dftfe::utils::DEVICE_BLOCK_SIZE * localSize,
+                               dftfe::utils::DEVICE_BLOCK_SIZE,
+                               0,
+                               0,
+                               numberBins,
+                               localSize,
+                               s.begin(),
+                               w.begin(),
+                               betaD.begin(),
+                               d.begin(),
+                               q.begin());
+#  endif
+
           // update x; x = x + alpha*d
           if (localSize > 0)
 #  ifdef DFTFE_WITH_DEVICE_LANG_CUDA
@@ -908,7 +960,7 @@ namespace dftfe
                                x.begin());
 #  endif
 
-          if (iter % 50 == 0)
+          if ((iter + 1) % 50 == 0)
             {
               // r = b
               dftfe::utils::deviceBlasWrapper::copy(
@@ -960,7 +1012,7 @@ namespace dftfe
             }
           else
             {
-              // negAlphaD = -alpha;
+              // r = r - alpha*q
               if (localSize > 0)
 #  ifdef DFTFE_WITH_DEVICE_LANG_CUDA
                 dmaxpyBlockedKernel<<<
@@ -985,117 +1037,30 @@ namespace dftfe
 #  endif
             }
 
-          // precondition_Jacobi(r,s);
+          // u=M^{-1}*r
           precondition_Jacobi(
             r.begin(), diagonalAD, numberBins, localSize, s.begin());
 
-          delta_oldD = delta_newD;
-
-          dftfe::utils::deviceMemcpyD2H(&delta_oldH[0],
-                                        delta_oldD.begin(),
-                                        numberBins * sizeof(double));
-
-
-          // delta_new = r*s;
-          computeResidualSq(handle,
-                            r.begin(),
-                            s.begin(),
-                            vecTempD.begin(),
-                            onesVecD.begin(),
-                            numberBins,
-                            localSize,
-                            delta_newD.begin());
-
-          // beta = delta_new/delta_old;
-
-
-          dftfe::utils::deviceMemcpyD2H(&delta_newH[0],
-                                        delta_newD.begin(),
-                                        numberBins * sizeof(double));
-
-
-          MPI_Allreduce(MPI_IN_PLACE,
-                        &delta_newH[0],
-                        numberBins,
-                        MPI_DOUBLE,
-                        MPI_SUM,
-                        mpiCommDomain);
-
-
-          // for (unsigned int i=0;i <numberBins; i++)
-          //   std::cout<< "delta_new "<<delta_newH[i]<<std::endl;
-
-          for (unsigned int i = 0; i < numberBins; i++)
-            betaH[i] = delta_newH[i] / delta_oldH[i];
-
-          dftfe::utils::deviceMemcpyH2D(betaD.begin(),
-                                        &betaH[0],
-                                        numberBins * sizeof(double));
-
-          dftfe::utils::deviceMemcpyH2D(delta_newD.begin(),
-                                        &delta_newH[0],
-                                        numberBins * sizeof(double));
-
-          // d *= beta;
-          if (localSize > 0)
-#  ifdef DFTFE_WITH_DEVICE_LANG_CUDA
-            scaleBlockedKernel<<<(numberBins +
-                                  (dftfe::utils::DEVICE_BLOCK_SIZE - 1)) /
-                                   dftfe::utils::DEVICE_BLOCK_SIZE * localSize,
-                                 dftfe::utils::DEVICE_BLOCK_SIZE>>>(
-              numberBins, localSize, d.begin(), betaD.begin());
-#  elif DFTFE_WITH_DEVICE_LANG_HIP
-            hipLaunchKernelGGL(scaleBlockedKernel,
-                               (numberBins +
-                                (dftfe::utils::DEVICE_BLOCK_SIZE - 1)) /
-                                 dftfe::utils::DEVICE_BLOCK_SIZE * localSize,
-                               dftfe::utils::DEVICE_BLOCK_SIZE,
-                               0,
-                               0,
-                               numberBins,
-                               localSize,
-                               d.begin(),
-                               betaD.begin());
-#  endif
-
-          // d.add(1.0,s);
-          if (localSize > 0)
-#  ifdef DFTFE_WITH_DEVICE_LANG_CUDA
-            daxpyBlockedKernel<<<(numberBins +
-                                  (dftfe::utils::DEVICE_BLOCK_SIZE - 1)) /
-                                   dftfe::utils::DEVICE_BLOCK_SIZE * localSize,
-                                 dftfe::utils::DEVICE_BLOCK_SIZE>>>(
-              numberBins, localSize, s.begin(), posOneD.begin(), d.begin());
-#  elif DFTFE_WITH_DEVICE_LANG_HIP
-            hipLaunchKernelGGL(daxpyBlockedKernel,
-                               (numberBins +
-                                (dftfe::utils::DEVICE_BLOCK_SIZE - 1)) /
-                                 dftfe::utils::DEVICE_BLOCK_SIZE * localSize,
-                               dftfe::utils::DEVICE_BLOCK_SIZE,
-                               0,
-                               0,
-                               numberBins,
-                               localSize,
-                               s.begin(),
-                               posOneD.begin(),
-                               d.begin());
-#  endif
-          unsigned int isBreak = 1;
-          // if(delta_new < relTolerance*relTolerance*delta_0)
-          //  isBreak = 1;
-
-          for (unsigned int i = 0; i < numberBins; i++)
-            if (delta_newH[i] > absTol * absTol)
-              isBreak = 0;
-
-          if (isBreak == 1)
-            break;
+          // w=A*u
+          computeAX(handle,
+                    constraintsMatrixDataInfoDevice,
+                    s,
+                    temp,
+                    totalLocallyOwnedCells,
+                    numberNodesPerElement,
+                    numberBins,
+                    localSize,
+                    ghostSize,
+                    poissonCellStiffnessMatricesD,
+                    inhomoIdsColoredVecFlattenedD,
+                    cellLocalProcIndexIdMapD,
+                    w,
+                    cellNodalVectorD,
+                    cellStiffnessMatrixTimesVectorD);
 
           iterationNumber += 1;
         }
 
-
-
       // compute residual norm at end
       computeResidualSq(handle,
                         r.begin(),
@@ -17,6 +17,7 @@
 // @author  Sambit Das, Phani Motamarri
 //
 
+#include <AtomSpatialIndex.h>
 #include <vectorUtilities.h>
 #include <vselfBinsManager.h>
 
@@ -202,12 +203,16 @@ namespace dftfe
       const unsigned int vertices_per_cell =
         dealii::GeometryInfo<3>::vertices_per_cell;
 
-      std::map<int, std::set<dealii::types::global_dof_index>>
-        atomToGlobalNodeIdMap;
+      //
+      // coordinates of the atoms followed by the image atoms, and the boxes
+      // around them
+      //
+      std::vector<double>                 atomPoints(3 * totalNumberAtoms);
+      std::vector<dealii::BoundingBox<3>> boundingBoxesAroundAtoms;
+      std::vector<bool> isAtomNearTria(totalNumberAtoms, false);
       for (unsigned int iAtom = 0; iAtom < totalNumberAtoms; ++iAtom)
         {
-          std::set<dealii::types::global_dof_index> tempNodalSet;
-          dealii::Point<3>                          atomCoor;
+          dealii::Point<3> atomCoor;
 
           if (iAtom < numberGlobalAtoms)
             {
@@ -224,6 +229,8 @@ namespace dftfe
               atomCoor[1] = imagePositions[iAtom - numberGlobalAtoms][1];
               atomCoor[2] = imagePositions[iAtom - numberGlobalAtoms][2];
             }
+          for (unsigned int iDim = 0; iDim < 3; ++iDim)
+            atomPoints[3 * iAtom + iDim] = atomCoor[iDim];
 
           dealii::Tensor<1, 3, double> tempDisp;
           tempDisp[0] = radiusAtomBall + 0.1;
@@ -233,30 +240,72 @@ namespace dftfe
             boundaryPoints;
           boundaryPoints.first  = atomCoor - tempDisp;
           boundaryPoints.second = atomCoor + tempDisp;
-          dealii::BoundingBox<3> boundingBoxAroundPoint(boundaryPoints);
+          boundingBoxesAroundAtoms.push_back(
+            dealii::BoundingBox<3>(boundaryPoints));
 
-          if (boundingBoxTria.get_neighbor_type(boundingBoxAroundPoint) ==
-              dealii::NeighborType::not_neighbors)
-            continue;
+          isAtomNearTria[iAtom] =
+            boundingBoxTria.get_neighbor_type(
+              boundingBoxesAroundAtoms[iAtom]) !=
+            dealii::NeighborType::not_neighbors;
+        }
 
-          dealii::DoFHandler<3>::active_cell_iterator cell = dofHandler
-                                                               .begin_active(),
-                                                      endc = dofHandler.end();
-          std::vector<dealii::types::global_dof_index> cell_dof_indices(
-            dofs_per_cell);
-
-          // loop over ghost cells is need to account for interactions between
-          // atom balls of diferent atoms interecting a locally owned cell and a
-          // neighbouring ghost cell.
-          for (; cell != endc; ++cell)
-            if (cell->is_locally_owned() || cell->is_ghost())
+      const utils::AtomSpatialIndex atomsSpatialIndex(atomPoints,
+                                                      radiusAtomBall);
+
+      std::vector<std::set<dealii::types::global_dof_index>> atomNodalSets(
+        totalNumberAtoms);
+      std::vector<unsigned int> cellAtomIds;
+      double                    maxCellDiameter = 0.0;
+
+      dealii::DoFHandler<3>::active_cell_iterator cell =
+                                                    dofHandler.begin_active(),
+                                                  endc = dofHandler.end();
+      std::vector<dealii::types::global_dof_index> cell_dof_indices(
+        dofs_per_cell);
+
+      // loop over ghost cells is need to account for interactions between
+      // atom balls of diferent atoms interecting a locally owned cell and a
+      // neighbouring ghost cell.
+      for (; cell != endc; ++cell)
+        if (cell->is_locally_owned() || cell->is_ghost())
+          {
+            const dealii::BoundingBox<3> &cellBoundingBox =
+              cell->bounding_box();
+            const std::pair<dealii::Point<3>, dealii::Point<3>>
+              &cellBoundaryPoints = cellBoundingBox.get_boundary_points();
+            const double cellDiameter =
+              cellBoundaryPoints.first.distance(cellBoundaryPoints.second);
+            maxCellDiameter = std::max(maxCellDiameter, cellDiameter);
+
+            //
+            // the box around an atom can only touch the bounding box of the
+            // cell if the atom is inside the ball around the centre of the
+            // cell enclosing both boxes
+            //
+            double cellCenter[3];
+            for (unsigned int iDim = 0; iDim < 3; ++iDim)
+              cellCenter[iDim] = 0.5 * (cellBoundaryPoints.first[iDim] +
+                                        cellBoundaryPoints.second[iDim]);
+            atomsSpatialIndex.findPointsInBall(
+              cellCenter,
+              0.5 * cellDiameter + std::sqrt(3.0) * (radiusAtomBall + 0.1) +
+                1e-6,
+              cellAtomIds);
+
+            for (const unsigned int iAtom : cellAtomIds)
               {
-                const dealii::BoundingBox<3> &cellBoundingBox =
-                  cell->bounding_box();
-                if (cellBoundingBox.get_neighbor_type(boundingBoxAroundPoint) ==
+                if (!isAtomNearTria[iAtom])
+                  continue;
+
+                if (cellBoundingBox.get_neighbor_type(
+                      boundingBoxesAroundAtoms[iAtom]) ==
                     dealii::NeighborType::not_neighbors)
                   continue;
 
+                const dealii::Point<3> atomCoor(atomPoints[3 * iAtom],
+                                                atomPoints[3 * iAtom + 1],
+                                                atomPoints[3 * iAtom + 2]);
+
                 int cutOffFlag = 0;
                 // cell->get_dof_indices(cell_dof_indices);
 
@@ -311,16 +360,18 @@ namespace dftfe
                       {
                         const dealii::types::global_dof_index nodeID =
                           cell->vertex_dof_index(iNode, 0);
-                        tempNodalSet.insert(nodeID);
+                        atomNodalSets[iAtom].insert(nodeID);
                       }
                   }
+              } // atom loop
 
-              } // cell locally owned if loop
-
-          if (!tempNodalSet.empty())
-            atomToGlobalNodeIdMap[iAtom] = tempNodalSet;
+          } // cell locally owned if loop
 
-        } // atom loop
+      std::map<int, std::set<dealii::types::global_dof_index>>
+        atomToGlobalNodeIdMap;
+      for (unsigned int iAtom = 0; iAtom < totalNumberAtoms; ++iAtom)
+        if (!atomNodalSets[iAtom].empty())
+          atomToGlobalNodeIdMap[iAtom] = std::move(atomNodalSets[iAtom]);
 
       computing_timer.leave_subsection(
         "create bins: find nodes inside atom balls");
@@ -333,7 +384,8 @@ namespace dftfe
       //					   mpi_communicator);
 
       computing_timer.enter_subsection("create bins: local interaction maps");
-      unsigned int ilegalInteraction = 0;
+      unsigned int              ilegalInteraction = 0;
+      std::vector<unsigned int> neighbourAtomIds;
 
       for (unsigned int iAtom = 0; iAtom < totalNumberAtoms; ++iAtom)
         {
@@ -348,11 +400,25 @@ namespace dftfe
 
           // std::cout<<"IAtom: "<<iAtom<<std::endl;
 
-          for (int jAtom = iAtom - 1; jAtom > -1; jAtom--)
+          //
+          // the nodes of an atom are vertices of cells intersecting its ball,
+          // so atoms sharing a node are within two ball radii and two cell
+          // diameters of each other. The candidates are visited in the same
+          // decreasing order as a scan over all jAtom < iAtom.
+          //
+          atomsSpatialIndex.findPointsInBall(
+            &atomPoints[3 * iAtom],
+            2.0 * (radiusAtomBall + maxCellDiameter) + 1e-6,
+            neighbourAtomIds);
+
+          for (auto jAtomIter = neighbourAtomIds.rbegin();
+               jAtomIter != neighbourAtomIds.rend();
+               ++jAtomIter)
             {
+              const int jAtom = *jAtomIter;
               // std::cout<<"JAtom: "<<jAtom<<std::endl;
-              if (atomToGlobalNodeIdMap.find(jAtom) ==
-                  atomToGlobalNodeIdMap.end())
+              if (jAtom >= (int)iAtom || atomToGlobalNodeIdMap.find(jAtom) ==
+                                           atomToGlobalNodeIdMap.end())
                 continue;
               //
               // compute intersection between the atomGlobalNodeIdMap of iAtom
@@ -1865,6 +1931,14 @@ namespace dftfe
     return d_storedAdaptiveBallRadius;
   }
 
+  template <unsigned int FEOrder, unsigned int FEOrderElectro>
+  void
+  vselfBinsManager<FEOrder, FEOrderElectro>::setMultigridPreconditioner(
+    const std::shared_ptr<poissonMultigridPreconditioner> &mgPreconditionerPtr)
+  {
+    d_mgPreconditionerPtr = mgPreconditionerPtr;
+  }
+
 #include "vselfBinsManager.inst.cc"
 
 } // namespace dftfe
@@ -0,0 +1,311 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2017-2022 The Regents of the University of Michigan and DFT-FE
+// authors.
+//
+// This file is part of the DFT-FE code.
+//
+// The DFT-FE code is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the DFT-FE distribution.
+//
+// ---------------------------------------------------------------------
+//
+
+#include <dft.h>
+#include <linearAlgebraOperations.h>
+#include <wfcExtrapolation.h>
+
+namespace dftfe
+{
+  namespace internal
+  {
+    std::vector<double>
+    getASPCPredictorCoefficients(const unsigned int order)
+    {
+      auto binomial = [](const unsigned int n, const unsigned int k) {
+        double value = 1.0;
+        for (unsigned int i = 1; i <= k; ++i)
+          value = value * (n - k + i) / i;
+        return value;
+      };
+
+      std::vector<double> coefficients(order + 2);
+      for (unsigned int j = 1; j <= order + 2; ++j)
+        coefficients[j - 1] = (j % 2 == 1 ? 1.0 : -1.0) * j *
+                              binomial(2 * order + 4, order + 2 - j) /
+                              binomial(2 * order + 2, order + 1);
+      return coefficients;
+    }
+
+    void
+    alignWaveFunctionsProcrustes(dataTypes::number *      X,
+                                 const dataTypes::number *Y,
+                                 const unsigned int       numBlocks,
+                                 const unsigned int       numRows,
+                                 const unsigned int       N,
+                                 const MPI_Comm &         mpiComm)
+    {
+      const dealii::types::global_dof_index blockSize =
+        (dealii::types::global_dof_index)numRows * N;
+      // rows of X rotated at once
+      const unsigned int rowsBlockSize = std::min(numRows, 1000u);
+
+      const dataTypes::number        scalarOne = 1.0, scalarZero = 0.0;
+      std::vector<dataTypes::number> T(N * N), Q(N * N), TQ(N * N), UT(N * N);
+      std::vector<dataTypes::number> XRotated(rowsBlockSize * N);
+      std::vector<double>            eigenValues(N);
+
+      for (unsigned int iBlock = 0; iBlock < numBlocks; ++iBlock)
+        {
+          dataTypes::number *XBlock =
+            X + (dealii::types::global_dof_index)iBlock * blockSize;
+          const dataTypes::number *YBlock =
+            Y + (dealii::types::global_dof_index)iBlock * blockSize;
+
+          // In column major storage the block is X^{T} with leading
+          // dimension N, so the rotation X <- X U reads X^{T} <- U^{T} X^{T},
+          // where U^{T} is the unitary polar factor of
+          // T=(X^{H}Y)^{T}=Y^{T}conj(X)
+          xgemm("N",
+                "C",
+                &N,
+                &N,
+                &numRows,
+                &scalarOne,
+                YBlock,
+                &N,
+                XBlock,
+                &N,
+                &scalarZero,
+                &T[0],
+                &N);
+          MPI_Allreduce(MPI_IN_PLACE,
+                        &T[0],
+                        N * N,
+                        dataTypes::mpi_type_id(&T[0]),
+                        MPI_SUM,
+                        mpiComm);
+
+          // U^{T}=T(T^{H}T)^{-1/2}=TQ\Lambda^{-1/2}Q^{H} with T^{H}T=Q\Lambda
+          // Q^{H}
+          xgemm("C",
+                "N",
+                &N,
+                &N,
+                &N,
+                &scalarOne,
+                &T[0],
+                &N,
+                &T[0],
+                &N,
+                &scalarZero,
+                &Q[0],
+                &N);
+
+          char               jobz = 'V', uplo = 'L';
+          int                info;
+          const unsigned int lwork = 1 + 6 * N + 2 * N * N, liwork = 3 + 5 * N;
+          std::vector<int>   iwork(liwork, 0);
+#ifdef USE_COMPLEX
+          const unsigned int                lrwork = 1 + 5 * N + 2 * N * N;
+          std::vector<double>               rwork(lrwork, 0.0);
+          std::vector<std::complex<double>> work(lwork);
+          zheevd_(&jobz,
+                  &uplo,
+                  &N,
+                  &Q[0],
+                  &N,
+                  &eigenValues[0],
+                  &work[0],
+                  &lwork,
+                  &rwork[0],
+                  &lrwork,
+                  &iwork[0],
+                  &liwork,
+                  &info);
+#else
+          std::vector<double> work(lwork, 0.0);
+          dsyevd_(&jobz,
+                  &uplo,
+                  &N,
+                  &Q[0],
+                  &N,
+                  &eigenValues[0],
+                  &work[0],
+                  &lwork,
+                  &iwork[0],
+                  &liwork,
+                  &info);
+#endif
+          AssertThrow(
+            info == 0,
+            dealii::ExcMessage(
+              "DFT-FE Error: eigen decomposition in the Procrustes alignment of wavefunctions failed."));
+
+          xgemm("N",
+                "N",
+                &N,
+                &N,
+                &N,
+                &scalarOne,
+                &T[0],
+                &N,
+                &Q[0],
+                &N,
+                &scalarZero,
+                &TQ[0],
+                &N);
+
+          // states which left the subspace make T^{H}T singular, their
+          // directions are not rotated
+          const double eigenValueTol = 1e-12 * std::abs(eigenValues[N - 1]);
+          for (unsigned int j = 0; j < N; ++j)
+            {
+              const double scaling =
+                1.0 / std::sqrt(std::max(eigenValues[j], eigenValueTol));
+              for (unsigned int i = 0; i < N; ++i)
+                TQ[j * N + i] *= scaling;
+            }
+
+          xgemm("N",
+                "C",
+                &N,
+                &N,
+                &N,
+                &scalarOne,
+                &TQ[0],
+                &N,
+                &Q[0],
+                &N,
+                &scalarZero,
+                &UT[0],
+                &N);
+
+          for (unsigned int iRow = 0; iRow < numRows; iRow += rowsBlockSize)
+            {
+              const unsigned int currentRows =
+                std::min(rowsBlockSize, numRows - iRow);
+              xgemm("N",
+                    "N",
+                    &N,
+                    &currentRows,
+                    &N,
+                    &scalarOne,
+                    &UT[0],
+                    &N,
+                    XBlock + (dealii::types::global_dof_index)iRow * N,
+                    &N,
+                    &scalarZero,
+                    &XRotated[0],
+                    &N);
+              std::copy(XRotated.begin(),
+                        XRotated.begin() + currentRows * N,
+                        XBlock + (dealii::types::global_dof_index)iRow * N);
+            }
+        }
+    }
+  } // namespace internal
+
+  template <unsigned int              FEOrder,
+            unsigned int              FEOrderElectro,
+            dftfe::utils::MemorySpace memorySpace>
+  unsigned int
+  dftClass<FEOrder, FEOrderElectro, memorySpace>::extrapolateWaveFunctions()
+  {
+    const unsigned int order       = d_dftParamsPtr->wfcExtrapolationOrder;
+    const unsigned int historySize = order + 2;
+
+#ifdef DFTFE_WITH_DEVICE
+    if constexpr (dftfe::utils::MemorySpace::DEVICE == memorySpace)
+      d_eigenVectorsFlattenedDevice.copyTo(d_eigenVectorsFlattenedHost);
+#endif
+
+    const dealii::types::global_dof_index totalSize =
+      d_eigenVectorsFlattenedHost.size();
+    if (!d_wfcExtrapolationHistory.empty() &&
+        d_wfcExtrapolationHistory[0].size() != totalSize)
+      {
+        d_wfcExtrapolationHistory.clear();
+        d_wfcExtrapolationPrediction.clear();
+      }
+
+    // ground-state wavefunctions of the last solve in the gauge of the
+    // history, the prediction being the closest reference if available
+    std::vector<dataTypes::number> current(d_eigenVectorsFlattenedHost.begin(),
+                                           d_eigenVectorsFlattenedHost.end());
+    const unsigned int numBlocks =
+      (1 + d_dftParamsPtr->spinPolarized) * d_kPointWeights.size();
+    const unsigned int numRows = totalSize / numBlocks / d_numEigenValues;
+    if (!d_wfcExtrapolationPrediction.empty())
+      internal::alignWaveFunctionsProcrustes(&current[0],
+                                             &d_wfcExtrapolationPrediction[0],
+                                             numBlocks,
+                                             numRows,
+                                             d_numEigenValues,
+                                             mpi_communicator);
+    else if (!d_wfcExtrapolationHistory.empty())
+      internal::alignWaveFunctionsProcrustes(&current[0],
+                                             &d_wfcExtrapolationHistory[0][0],
+                                             numBlocks,
+                                             numRows,
+                                             d_numEigenValues,
+                                             mpi_communicator);
+
+    // corrector. As the ground-state is solved to convergence it only enters
+    // the history, which damps the propagation of the residual errors of the
+    // solves
+    if (!d_wfcExtrapolationPrediction.empty())
+      {
+        const double omega = (order + 2.0) / (2.0 * order + 3.0);
+        for (dealii::types::global_dof_index i = 0; i < totalSize; ++i)
+          current[i] = omega * current[i] +
+                       (1.0 - omega) * d_wfcExtrapolationPrediction[i];
+      }
+
+    // latest first, the oldest entry is recycled once the history is complete
+    if (d_wfcExtrapolationHistory.size() < historySize)
+      d_wfcExtrapolationHistory.emplace_back();
+    std::rotate(d_wfcExtrapolationHistory.rbegin(),
+                d_wfcExtrapolationHistory.rbegin() + 1,
+                d_wfcExtrapolationHistory.rend());
+    d_wfcExtrapolationHistory[0].swap(current);
+
+    // until the history is complete the wavefunctions of the last solve are
+    // reused as they are
+    if (d_wfcExtrapolationHistory.size() < historySize)
+      {
+        d_wfcExtrapolationPrediction.clear();
+        return d_wfcExtrapolationHistory.size();
+      }
+
+    const std::vector<double> coefficients =
+      internal::getASPCPredictorCoefficients(order);
+    d_wfcExtrapolationPrediction.assign(totalSize, dataTypes::number(0.0));
+    for (unsigned int j = 0; j < historySize; ++j)
+      {
+        const std::vector<dataTypes::number> &previous =
+          d_wfcExtrapolationHistory[j];
+        for (dealii::types::global_dof_index i = 0; i < totalSize; ++i)
+          d_wfcExtrapolationPrediction[i] += coefficients[j] * previous[i];
+      }
+
+    std::copy(d_wfcExtrapolationPrediction.begin(),
+              d_wfcExtrapolationPrediction.end(),
+              d_eigenVectorsFlattenedHost.begin());
+#ifdef DFTFE_WITH_DEVICE
+    if constexpr (dftfe::utils::MemorySpace::DEVICE == memorySpace)
+      d_eigenVectorsFlattenedDevice.copyFrom(d_eigenVectorsFlattenedHost);
+#endif
+
+    if (d_dftParamsPtr->verbosity >= 2)
+      pcout << "Using ASPC extrapolated wavefunctions of order " << order
+            << " as the initial guess" << std::endl;
+
+    return d_wfcExtrapolationHistory.size();
+  }
+#include "dft.inst.cc"
+} // namespace dftfe
@@ -20,6 +20,8 @@
 #include <KohnShamHamiltonianOperator.h>
 #include <dftUtils.h>
 #include <DeviceAPICalls.h>
+#include <tensorProductUtils.h>
+#include <array>
 #ifdef _OPENMP
 #  include <omp.h>
 #else
@@ -132,6 +134,8 @@ namespace dftfe
     , d_lpspQuadratureID(lpspQuadratureID)
     , d_feOrderPlusOneQuadratureID(feOrderPlusOneQuadratureID)
     , d_isExternalPotCorrHamiltonianComputed(false)
+    , d_isSharedKPointHamiltonian(false)
+    , d_isKPointIndependentHamiltonianComputed(false)
     , d_mpiCommParent(mpi_comm_parent)
     , d_mpiCommDomain(mpi_comm_domain)
     , n_mpi_processes(dealii::Utilities::MPI::n_mpi_processes(mpi_comm_domain))
@@ -212,11 +216,21 @@ namespace dftfe
     d_kPointWeights     = kPointWeights;
     d_invJacKPointTimesJxW.resize(d_kPointWeights.size());
     d_cellHamiltonianMatrix.resize(
-      d_dftParamsPtr->memOptMode ?
-        1 :
-        (d_kPointWeights.size() * (d_dftParamsPtr->spinPolarized + 1)));
+      d_dftParamsPtr->matrixFreeHamiltonian ?
+        0 :
+        (d_dftParamsPtr->memOptMode ?
+           1 :
+           (d_kPointWeights.size() * (d_dftParamsPtr->spinPolarized + 1))));
     d_cellHamiltonianMatrixSinglePrec.resize(
       d_dftParamsPtr->useSinglePrecCheby ? d_cellHamiltonianMatrix.size() : 0);
+    d_isNonCollinSpinBlockHamiltonian =
+      d_dftParamsPtr->noncolin && d_dftParamsPtr->noncolinSpinBlockHamiltonian;
+    d_cellHamiltonianMatrixBZNonCollin.resize(
+      d_isNonCollinSpinBlockHamiltonian ? d_cellHamiltonianMatrix.size() : 0);
+    d_cellHamiltonianMatrixBZNonCollinSinglePrec.resize(
+      d_isNonCollinSpinBlockHamiltonian ?
+        d_cellHamiltonianMatrixSinglePrec.size() :
+        0);
 
     const unsigned int nCells       = d_basisOperationsPtr->nCells();
     const unsigned int nDofsPerCell = d_basisOperationsPtr->nDofsPerCell();
@@ -242,17 +256,79 @@ namespace dftfe
          ++iHamiltonian)
       d_cellHamiltonianMatrix[iHamiltonian].resize(
         nDofsPerCell * nDofsPerCell * nCells *
-        (d_dftParamsPtr->noncolin ? 4 : 1));
+        (d_dftParamsPtr->noncolin ? (d_isNonCollinSpinBlockHamiltonian ? 2 : 4) :
+                                    1));
     for (unsigned int iHamiltonian = 0;
          iHamiltonian < d_cellHamiltonianMatrixSinglePrec.size();
          ++iHamiltonian)
       d_cellHamiltonianMatrixSinglePrec[iHamiltonian].resize(
         nDofsPerCell * nDofsPerCell * nCells *
-        (d_dftParamsPtr->noncolin ? 4 : 1));
+        (d_dftParamsPtr->noncolin ? (d_isNonCollinSpinBlockHamiltonian ? 2 : 4) :
+                                    1));
+    for (unsigned int iHamiltonian = 0;
+         iHamiltonian < d_cellHamiltonianMatrixBZNonCollin.size();
+         ++iHamiltonian)
+      d_cellHamiltonianMatrixBZNonCollin[iHamiltonian].resize(
+        nDofsPerCell * nDofsPerCell * nCells);
+    for (unsigned int iHamiltonian = 0;
+         iHamiltonian < d_cellHamiltonianMatrixBZNonCollinSinglePrec.size();
+         ++iHamiltonian)
+      d_cellHamiltonianMatrixBZNonCollinSinglePrec[iHamiltonian].resize(
+        nDofsPerCell * nDofsPerCell * nCells);
 
     d_basisOperationsPtrHost->reinit(0, 0, d_densityQuadratureID, false);
     const unsigned int numberQuadraturePoints =
       d_basisOperationsPtrHost->nQuadsPerCell();
+    // -J^{-T}k JxW at the quadrature points, the weights of the k-point
+    // coupling term of the cell Hamiltonian matrices
+    auto computeInvJacKPointTimesJxW =
+      [&](const double *kPointCoordinatesPtr,
+          dftfe::utils::MemoryStorage<double, dftfe::utils::MemorySpace::HOST>
+            &invJacKPointTimesJxW) {
+        invJacKPointTimesJxW.resize(nCells * numberQuadraturePoints * 3, 0.0);
+        for (unsigned int iCell = 0; iCell < nCells; ++iCell)
+          {
+            auto cellJxWPtr = d_basisOperationsPtrHost->JxWBasisData().data() +
+                              iCell * numberQuadraturePoints;
+
+            if (d_basisOperationsPtrHost->cellsTypeFlag() != 2)
+              {
+                for (unsigned int iQuad = 0; iQuad < numberQuadraturePoints;
+                     ++iQuad)
+                  {
+                    const double *inverseJacobiansQuadPtr =
+                      d_basisOperationsPtrHost->inverseJacobiansBasisData()
+                        .data() +
+                      (d_basisOperationsPtrHost->cellsTypeFlag() == 0 ?
+                         iCell * numberQuadraturePoints * 9 + iQuad * 9 :
+                         iCell * 9);
+                    for (unsigned jDim = 0; jDim < 3; ++jDim)
+                      for (unsigned iDim = 0; iDim < 3; ++iDim)
+                        invJacKPointTimesJxW[iCell * numberQuadraturePoints *
+                                               3 +
+                                             iQuad * 3 + iDim] +=
+                          -inverseJacobiansQuadPtr[3 * jDim + iDim] *
+                          kPointCoordinatesPtr[jDim] * cellJxWPtr[iQuad];
+                  }
+              }
+            else if (d_basisOperationsPtrHost->cellsTypeFlag() == 2)
+              {
+                for (unsigned int iQuad = 0; iQuad < numberQuadraturePoints;
+                     ++iQuad)
+                  {
+                    const double *inverseJacobiansQuadPtr =
+                      d_basisOperationsPtrHost->inverseJacobiansBasisData()
+                        .data() +
+                      iCell * 3;
+                    for (unsigned iDim = 0; iDim < 3; ++iDim)
+                      invJacKPointTimesJxW[iCell * numberQuadraturePoints * 3 +
+                                           iQuad * 3 + iDim] =
+                        -inverseJacobiansQuadPtr[iDim] *
+                        kPointCoordinatesPtr[iDim] * cellJxWPtr[iQuad];
+                  }
+              }
+          }
+      };
     if constexpr (std::is_same<dataTypes::number, std::complex<double>>::value)
       for (unsigned int kPointIndex = 0; kPointIndex < d_kPointWeights.size();
            ++kPointIndex)
@@ -264,56 +340,9 @@ namespace dftfe
           auto &d_invJacKPointTimesJxWHost =
             d_invJacKPointTimesJxW[kPointIndex];
 #endif
-          d_invJacKPointTimesJxWHost.resize(nCells * numberQuadraturePoints * 3,
-                                            0.0);
-          for (unsigned int iCell = 0; iCell < nCells; ++iCell)
-            {
-              auto cellJxWPtr =
-                d_basisOperationsPtrHost->JxWBasisData().data() +
-                iCell * numberQuadraturePoints;
-              const double *kPointCoordinatesPtr =
-                kPointCoordinates.data() + 3 * kPointIndex;
-
-              if (d_basisOperationsPtrHost->cellsTypeFlag() != 2)
-                {
-                  for (unsigned int iQuad = 0; iQuad < numberQuadraturePoints;
-                       ++iQuad)
-                    {
-                      const double *inverseJacobiansQuadPtr =
-                        d_basisOperationsPtrHost->inverseJacobiansBasisData()
-                          .data() +
-                        (d_basisOperationsPtrHost->cellsTypeFlag() == 0 ?
-                           iCell * numberQuadraturePoints * 9 + iQuad * 9 :
-                           iCell * 9);
-                      for (unsigned jDim = 0; jDim < 3; ++jDim)
-                        for (unsigned iDim = 0; iDim < 3; ++iDim)
-                          d_invJacKPointTimesJxWHost[iCell *
-                                                       numberQuadraturePoints *
-                                                       3 +
-                                                     iQuad * 3 + iDim] +=
-                            -inverseJacobiansQuadPtr[3 * jDim + iDim] *
-                            kPointCoordinatesPtr[jDim] * cellJxWPtr[iQuad];
-                    }
-                }
-              else if (d_basisOperationsPtrHost->cellsTypeFlag() == 2)
-                {
-                  for (unsigned int iQuad = 0; iQuad < numberQuadraturePoints;
-                       ++iQuad)
-                    {
-                      const double *inverseJacobiansQuadPtr =
-                        d_basisOperationsPtrHost->inverseJacobiansBasisData()
-                          .data() +
-                        iCell * 3;
-                      for (unsigned iDim = 0; iDim < 3; ++iDim)
-                        d_invJacKPointTimesJxWHost[iCell *
-                                                     numberQuadraturePoints *
-                                                     3 +
-                                                   iQuad * 3 + iDim] =
-                          -inverseJacobiansQuadPtr[iDim] *
-                          kPointCoordinatesPtr[iDim] * cellJxWPtr[iQuad];
-                    }
-                }
-            }
+          computeInvJacKPointTimesJxW(kPointCoordinates.data() +
+                                        3 * kPointIndex,
+                                      d_invJacKPointTimesJxWHost);
 #if defined(DFTFE_WITH_DEVICE)
           d_invJacKPointTimesJxW[kPointIndex].resize(
             d_invJacKPointTimesJxWHost.size());
@@ -321,14 +350,646 @@ namespace dftfe
             d_invJacKPointTimesJxWHost);
 #endif
         }
+
+    // the k-point coupling term is linear in k, its cell matrices for the
+    // unit vectors along x, y and z are computed once for all the k-points
+    // and SCF iterations. This only shortens the assembly: the cell
+    // Hamiltonian matrices of all the k-points are still stored for HX, on
+    // top of four extra cell matrices per cell, so it is only used when a
+    // pool has more than one k-point
+    d_isSharedKPointHamiltonian =
+      std::is_same<dataTypes::number, std::complex<double>>::value &&
+      d_dftParamsPtr->sharedKPointHamiltonian && !d_dftParamsPtr->noncolin &&
+      !d_dftParamsPtr->matrixFreeHamiltonian && !d_dftParamsPtr->memOptMode &&
+      d_kPointWeights.size() > 1;
+    d_isKPointIndependentHamiltonianComputed = false;
+    if (d_isSharedKPointHamiltonian)
+      {
+        const double sharedKPointMemoryMB =
+          dealii::Utilities::MPI::sum(4.0 * nCells * nDofsPerCell *
+                                        nDofsPerCell * sizeof(double) /
+                                        (1024.0 * 1024.0),
+                                      d_mpiCommDomain);
+        if (d_dftParamsPtr->verbosity >= 1)
+          pcout << "SHARED KPOINT HAMILTONIAN: k-point independent cell "
+                << "matrices use " << sharedKPointMemoryMB
+                << " MB in addition to the cell Hamiltonian matrices of the "
+                << d_kPointWeights.size() << " k-points of the pool"
+                << std::endl;
+        d_basisOperationsPtr->reinit(0,
+                                     d_cellsBlockSizeHamiltonianConstruction,
+                                     d_densityQuadratureID,
+                                     false,
+                                     true);
+        d_cellHamiltonianMatrixKPointIndependent.resize(nDofsPerCell *
+                                                        nDofsPerCell * nCells);
+        d_cellNjGradNiMatrixKPointDirections.resize(
+          3 * nDofsPerCell * nDofsPerCell * nCells, 0.0);
+        for (unsigned int iDim = 0; iDim < 3; ++iDim)
+          {
+            double unitVector[3] = {0.0, 0.0, 0.0};
+            unitVector[iDim]     = 1.0;
+            dftfe::utils::MemoryStorage<double,
+                                        dftfe::utils::MemorySpace::HOST>
+              invJacUnitVectorTimesJxWHost;
+            computeInvJacKPointTimesJxW(unitVector,
+                                        invJacUnitVectorTimesJxWHost);
+            dftfe::utils::MemoryStorage<double, memorySpace>
+              invJacUnitVectorTimesJxW(invJacUnitVectorTimesJxWHost.size());
+            invJacUnitVectorTimesJxW.copyFrom(invJacUnitVectorTimesJxWHost);
+            for (unsigned int iCell = 0; iCell < nCells;
+                 iCell += d_cellsBlockSizeHamiltonianConstruction)
+              {
+                std::pair<unsigned int, unsigned int> cellRange(
+                  iCell,
+                  std::min(iCell + d_cellsBlockSizeHamiltonianConstruction,
+                           nCells));
+                tempHamMatrixImagBlock.setValue(0.0);
+                d_basisOperationsPtr->computeWeightedCellNjGradNiMatrix(
+                  cellRange, invJacUnitVectorTimesJxW, tempHamMatrixImagBlock);
+                d_BLASWrapperPtr->xcopy(
+                  nDofsPerCell * nDofsPerCell *
+                    (cellRange.second - cellRange.first),
+                  tempHamMatrixImagBlock.data(),
+                  1,
+                  d_cellNjGradNiMatrixKPointDirections.data() +
+                    (iDim * nCells + cellRange.first) * nDofsPerCell *
+                      nDofsPerCell,
+                  1);
+              }
+          }
+        const unsigned int nKPoints = d_kPointWeights.size();
+        d_tempHamMatrixRealBlockKPoints.resize(
+          nDofsPerCell * nDofsPerCell *
+          d_cellsBlockSizeHamiltonianConstruction * nKPoints);
+        d_tempHamMatrixImagBlockKPoints.resize(
+          nDofsPerCell * nDofsPerCell *
+          d_cellsBlockSizeHamiltonianConstruction * nKPoints);
+      }
+    if (d_dftParamsPtr->matrixFreeHamiltonian)
+      initMatrixFreeHamiltonian();
+    computeCellBlockColoring();
     computing_timer.leave_subsection("KohnShamHamiltonianOperator setup");
   }
 
+  template <dftfe::utils::MemorySpace memorySpace>
+  void
+  KohnShamHamiltonianOperator<memorySpace>::initMatrixFreeHamiltonian()
+  {
+    AssertThrow(
+      memorySpace == dftfe::utils::MemorySpace::HOST,
+      dealii::ExcMessage(
+        "DFT-FE Error: MATRIX FREE HAMILTONIAN is currently implemented only for host runs."));
+    d_basisOperationsPtrHost->computeTensorProductShapeData(
+      d_densityQuadratureID, true);
+    if (d_dftParamsPtr->isPseudopotential ||
+        d_dftParamsPtr->smearedNuclearCharges)
+      d_basisOperationsPtrHost->computeTensorProductShapeData(
+        d_lpspQuadratureID, false);
+
+    d_basisOperationsPtrHost->reinit(0, 0, d_densityQuadratureID, false);
+    const unsigned int nCells = d_basisOperationsPtrHost->nCells();
+    const unsigned int nQuadsPerCell =
+      d_basisOperationsPtrHost->nQuadsPerCell();
+    const unsigned int cellsTypeFlag =
+      d_basisOperationsPtrHost->cellsTypeFlag();
+    const double *inverseJacobians =
+      d_basisOperationsPtrHost->inverseJacobiansBasisData().data();
+    d_matrixFreeJxW.resize(nCells * nQuadsPerCell);
+    d_matrixFreeStiffnessWeights.assign(nCells * nQuadsPerCell * 9, 0.0);
+    for (unsigned int iCell = 0; iCell < nCells; ++iCell)
+      for (unsigned int iQuad = 0; iQuad < nQuadsPerCell; ++iQuad)
+        {
+          const double jxw =
+            d_basisOperationsPtrHost
+              ->JxWBasisData()[iCell * nQuadsPerCell + iQuad];
+          d_matrixFreeJxW[iCell * nQuadsPerCell + iQuad] = jxw;
+          // inverseJacobian[iDim][kDim] is stored at 3*kDim+iDim
+          double inverseJacobian[3][3] = {{0.0, 0.0, 0.0},
+                                          {0.0, 0.0, 0.0},
+                                          {0.0, 0.0, 0.0}};
+          for (unsigned int iDim = 0; iDim < 3; ++iDim)
+            if (cellsTypeFlag == 2)
+              inverseJacobian[iDim][iDim] = inverseJacobians[iCell * 3 + iDim];
+            else
+              for (unsigned int kDim = 0; kDim < 3; ++kDim)
+                inverseJacobian[iDim][kDim] =
+                  inverseJacobians[(cellsTypeFlag == 0 ?
+                                      iCell * nQuadsPerCell * 9 + iQuad * 9 :
+                                      iCell * 9) +
+                                   3 * kDim + iDim];
+          double *stiffnessWeightsQuad =
+            d_matrixFreeStiffnessWeights.data() +
+            (iCell * nQuadsPerCell + iQuad) * 9;
+          for (unsigned int iDim = 0; iDim < 3; ++iDim)
+            for (unsigned int jDim = 0; jDim < 3; ++jDim)
+              for (unsigned int kDim = 0; kDim < 3; ++kDim)
+                stiffnessWeightsQuad[3 * iDim + jDim] +=
+                  0.5 * inverseJacobian[iDim][kDim] *
+                  inverseJacobian[jDim][kDim] * jxw;
+        }
+
+    const unsigned int nDofs1D = d_basisOperationsPtrHost->nDofsPerCell1D();
+    unsigned int       maxExtent1D =
+      std::max(nDofs1D,
+               d_basisOperationsPtrHost->nQuadsPerCell1D(d_densityQuadratureID));
+    if (d_dftParamsPtr->isPseudopotential ||
+        d_dftParamsPtr->smearedNuclearCharges)
+      maxExtent1D =
+        std::max(maxExtent1D,
+                 d_basisOperationsPtrHost->nQuadsPerCell1D(d_lpspQuadratureID));
+    d_matrixFreeVectorsChunkSize = 32;
+    const unsigned int scratchBufferSize =
+      maxExtent1D * maxExtent1D * maxExtent1D *
+      (d_dftParamsPtr->noncolin ? 2 : 1) * d_matrixFreeVectorsChunkSize *
+      (sizeof(dataTypes::number) / sizeof(double));
+    d_matrixFreeScratchThreads.resize(d_nOMPThreads);
+    for (unsigned int iThread = 0; iThread < d_nOMPThreads; ++iThread)
+      d_matrixFreeScratchThreads[iThread].resize(7 * scratchBufferSize);
+    d_matrixFreeIncludeKineticAndExtPot = true;
+  }
+
+  template <dftfe::utils::MemorySpace memorySpace>
+  void
+  KohnShamHamiltonianOperator<memorySpace>::
+    computeMatrixFreeHamiltonianQuadData(
+      const bool onlyHPrimePartForFirstOrderDensityMatResponse)
+  {
+    // the k-point and spin dependent coefficients are read at the time of
+    // the application, only the choice of terms is recorded here
+    d_matrixFreeIncludeKineticAndExtPot =
+      !onlyHPrimePartForFirstOrderDensityMatResponse;
+  }
+
+  template <dftfe::utils::MemorySpace memorySpace>
+  void
+  KohnShamHamiltonianOperator<memorySpace>::applyMatrixFreeHamiltonianCell(
+    const unsigned int       iCell,
+    const unsigned int       numberWavefunctions,
+    const double             scalar,
+    const dataTypes::number *src,
+    dataTypes::number *      dst)
+  {
+    if constexpr (memorySpace == dftfe::utils::MemorySpace::HOST)
+      {
+        const unsigned int spinorFactor = d_dftParamsPtr->noncolin ? 2 : 1;
+        const unsigned int complexFactor =
+          sizeof(dataTypes::number) / sizeof(double);
+        const unsigned int nDofs1D = d_basisOperationsPtrHost->nDofsPerCell1D();
+        const unsigned int nQuads1D =
+          d_basisOperationsPtrHost->nQuadsPerCell1D(d_densityQuadratureID);
+        const unsigned int nDofsPerCell  = nDofs1D * nDofs1D * nDofs1D;
+        const unsigned int nQuadsPerCell = nQuads1D * nQuads1D * nQuads1D;
+        const double *     shapeValues =
+          d_basisOperationsPtrHost
+            ->tensorProductShapeValues1D(d_densityQuadratureID)
+            .data();
+        const double *collocationGradients =
+          d_basisOperationsPtrHost
+            ->tensorProductCollocationGradients1D(d_densityQuadratureID)
+            .data();
+        const std::vector<unsigned int> &lexicographicToCellDof =
+          d_basisOperationsPtrHost->lexicographicToCellDofNumbering();
+        const bool hasExtPot = (d_dftParamsPtr->isPseudopotential ||
+                                d_dftParamsPtr->smearedNuclearCharges) &&
+                               d_matrixFreeIncludeKineticAndExtPot;
+        const bool isGGA =
+          !d_dftParamsPtr->noncolin &&
+          d_excManagerPtr->getDensityBasedFamilyType() == densityFamilyType::GGA;
+        const bool computeGradients =
+          d_matrixFreeIncludeKineticAndExtPot || isGGA;
+        double kSquareTimesHalf = 0.0;
+        if constexpr (std::is_same<dataTypes::number,
+                                   std::complex<double>>::value)
+          if (d_matrixFreeIncludeKineticAndExtPot)
+            {
+              const double *kPointCoors =
+                d_kPointCoordinates.data() + 3 * d_kPointIndex;
+              kSquareTimesHalf = 0.5 * (kPointCoors[0] * kPointCoors[0] +
+                                        kPointCoors[1] * kPointCoors[1] +
+                                        kPointCoors[2] * kPointCoors[2]);
+            }
+        const bool includeKPointTerm = kSquareTimesHalf > 1e-12;
+
+        auto &scratch = d_matrixFreeScratchThreads[omp_get_thread_num()];
+        const unsigned int bufferSize  = scratch.size() / 7;
+        double *           cellValues  = scratch.data();
+        double *           tempValues1 = cellValues + bufferSize;
+        double *           tempValues2 = tempValues1 + bufferSize;
+        double *           quadValues  = tempValues2 + bufferSize;
+        double *           quadGradients[3] = {quadValues + bufferSize,
+                                     quadValues + 2 * bufferSize,
+                                     quadValues + 3 * bufferSize};
+        // the gradients are integrated into quadValues before the last
+        // contractions, so the result reuses the first gradient buffer
+        double *                          cellResult  = quadGradients[0];
+        const std::array<unsigned int, 3> dofExtents  = {nDofs1D,
+                                                        nDofs1D,
+                                                        nDofs1D};
+        const std::array<unsigned int, 3> quadExtents = {nQuads1D,
+                                                         nQuads1D,
+                                                         nQuads1D};
+
+        for (unsigned int startVec = 0; startVec < numberWavefunctions;
+             startVec += d_matrixFreeVectorsChunkSize)
+          {
+            const unsigned int nVecs =
+              std::min(d_matrixFreeVectorsChunkSize,
+                       numberWavefunctions - startVec);
+            const unsigned int nInner       = spinorFactor * nVecs;
+            const unsigned int nInnerDouble = nInner * complexFactor;
+
+            // gather the chunk in lexicographic dof order
+            dataTypes::number *cellValuesNumber =
+              reinterpret_cast<dataTypes::number *>(cellValues);
+            for (unsigned int iNode = 0; iNode < nDofsPerCell; ++iNode)
+              for (unsigned int iSpinor = 0; iSpinor < spinorFactor; ++iSpinor)
+                std::copy(src +
+                            lexicographicToCellDof[iNode] * spinorFactor *
+                              numberWavefunctions +
+                            iSpinor * numberWavefunctions + startVec,
+                          src +
+                            lexicographicToCellDof[iNode] * spinorFactor *
+                              numberWavefunctions +
+                            iSpinor * numberWavefunctions + startVec + nVecs,
+                          cellValuesNumber + (iNode * spinorFactor + iSpinor) *
+                                               nVecs);
+
+            // values and reference gradients at the quadrature points
+            tensorProductUtils::contractTensorProductDirection(
+              *d_BLASWrapperPtrHost,
+              shapeValues,
+              nQuads1D,
+              nDofs1D,
+              false,
+              0,
+              dofExtents,
+              nInnerDouble,
+              cellValues,
+              0.0,
+              tempValues1);
+            tensorProductUtils::contractTensorProductDirection(
+              *d_BLASWrapperPtrHost,
+              shapeValues,
+              nQuads1D,
+              nDofs1D,
+              false,
+              1,
+              {nQuads1D, nDofs1D, nDofs1D},
+              nInnerDouble,
+              tempValues1,
+              0.0,
+              tempValues2);
+            tensorProductUtils::contractTensorProductDirection(
+              *d_BLASWrapperPtrHost,
+              shapeValues,
+              nQuads1D,
+              nDofs1D,
+              false,
+              2,
+              {nQuads1D, nQuads1D, nDofs1D},
+              nInnerDouble,
+              tempValues2,
+              0.0,
+              quadValues);
+            if (computeGradients)
+              for (unsigned int iDim = 0; iDim < 3; ++iDim)
+                tensorProductUtils::contractTensorProductDirection(
+                  *d_BLASWrapperPtrHost,
+                  collocationGradients,
+                  nQuads1D,
+                  nQuads1D,
+                  false,
+                  iDim,
+                  quadExtents,
+                  nInnerDouble,
+                  quadValues,
+                  0.0,
+                  quadGradients[iDim]);
+
+            // apply the quadrature point coefficients
+            dataTypes::number *quadValuesNumber =
+              reinterpret_cast<dataTypes::number *>(quadValues);
+            dataTypes::number *quadGradientsNumber[3] = {
+              reinterpret_cast<dataTypes::number *>(quadGradients[0]),
+              reinterpret_cast<dataTypes::number *>(quadGradients[1]),
+              reinterpret_cast<dataTypes::number *>(quadGradients[2])};
+            for (unsigned int iQuad = 0; iQuad < nQuadsPerCell; ++iQuad)
+              {
+                const unsigned int cellQuad = iCell * nQuadsPerCell + iQuad;
+                const double valueWeight =
+                  d_VeffJxW.data()[cellQuad] +
+                  (includeKPointTerm ?
+                     kSquareTimesHalf * d_matrixFreeJxW[cellQuad] :
+                     0.0);
+                const double *stiffnessWeights =
+                  d_matrixFreeStiffnessWeights.data() + cellQuad * 9;
+                const double *ggaWeights =
+                  isGGA ? d_invJacderExcWithSigmaTimesGradRhoJxW.data() +
+                            cellQuad * 3 :
+                          nullptr;
+#ifdef USE_COMPLEX
+                const double *kPointWeights =
+                  includeKPointTerm ?
+                    d_invJacKPointTimesJxW[d_kPointIndex].data() +
+                      cellQuad * 3 :
+                    nullptr;
+                const double magneticFieldWeights[3] = {
+                  d_dftParamsPtr->noncolin ? d_BeffxJxW.data()[cellQuad] : 0.0,
+                  d_dftParamsPtr->noncolin ? d_BeffyJxW.data()[cellQuad] : 0.0,
+                  d_dftParamsPtr->noncolin ? d_BeffzJxW.data()[cellQuad] :
+                                             0.0};
+#endif
+                dataTypes::number *valuesQuad =
+                  quadValuesNumber + iQuad * nInner;
+                dataTypes::number *gradientsQuad[3] = {
+                  quadGradientsNumber[0] + iQuad * nInner,
+                  quadGradientsNumber[1] + iQuad * nInner,
+                  quadGradientsNumber[2] + iQuad * nInner};
+                for (unsigned int iVec = 0; iVec < nVecs; ++iVec)
+                  {
+                    dataTypes::number value[2], gradient[2][3];
+                    for (unsigned int iSpinor = 0; iSpinor < spinorFactor;
+                         ++iSpinor)
+                      {
+                        value[iSpinor] = valuesQuad[iSpinor * nVecs + iVec];
+                        for (unsigned int iDim = 0; iDim < 3; ++iDim)
+                          gradient[iSpinor][iDim] =
+                            computeGradients ?
+                              gradientsQuad[iDim][iSpinor * nVecs + iVec] :
+                              dataTypes::number(0.0);
+                      }
+                    for (unsigned int iSpinor = 0; iSpinor < spinorFactor;
+                         ++iSpinor)
+                      {
+                        dataTypes::number hValue = valueWeight * value[iSpinor];
+#ifdef USE_COMPLEX
+                        // (Bz, Bx-iBy; Bx+iBy, -Bz) coupling of the spinor
+                        // components
+                        if (d_dftParamsPtr->noncolin)
+                          hValue +=
+                            iSpinor == 0 ?
+                              magneticFieldWeights[2] * value[0] +
+                                dataTypes::number(magneticFieldWeights[0],
+                                                  -magneticFieldWeights[1]) *
+                                  value[1] :
+                              dataTypes::number(magneticFieldWeights[0],
+                                                magneticFieldWeights[1]) *
+                                  value[0] -
+                                magneticFieldWeights[2] * value[1];
+                        if (includeKPointTerm)
+                          for (unsigned int iDim = 0; iDim < 3; ++iDim)
+                            hValue += dataTypes::number(0.0, 1.0) *
+                                      kPointWeights[iDim] *
+                                      gradient[iSpinor][iDim];
+#endif
+                        if (isGGA)
+                          for (unsigned int iDim = 0; iDim < 3; ++iDim)
+                            hValue += ggaWeights[iDim] * gradient[iSpinor][iDim];
+                        valuesQuad[iSpinor * nVecs + iVec] = hValue;
+                        if (computeGradients)
+                          for (unsigned int iDim = 0; iDim < 3; ++iDim)
+                            {
+                              dataTypes::number hGradient =
+                                isGGA ? ggaWeights[iDim] * value[iSpinor] :
+                                        dataTypes::number(0.0);
+                              if (d_matrixFreeIncludeKineticAndExtPot)
+                                for (unsigned int jDim = 0; jDim < 3; ++jDim)
+                                  hGradient +=
+                                    stiffnessWeights[3 * iDim + jDim] *
+                                    gradient[iSpinor][jDim];
+                              gradientsQuad[iDim][iSpinor * nVecs + iVec] =
+                                hGradient;
+                            }
+                      }
+                  }
+              }
+
+            // integrate against the shape functions and their gradients
+            if (computeGradients)
+              for (unsigned int iDim = 0; iDim < 3; ++iDim)
+                tensorProductUtils::contractTensorProductDirection(
+                  *d_BLASWrapperPtrHost,
+                  collocationGradients,
+                  nQuads1D,
+                  nQuads1D,
+                  true,
+                  iDim,
+                  quadExtents,
+                  nInnerDouble,
+                  quadGradients[iDim],
+                  1.0,
+                  quadValues);
+            tensorProductUtils::contractTensorProductDirection(
+              *d_BLASWrapperPtrHost,
+              shapeValues,
+              nQuads1D,
+              nDofs1D,
+              true,
+              2,
+              quadExtents,
+              nInnerDouble,
+              quadValues,
+              0.0,
+              tempValues2);
+            tensorProductUtils::contractTensorProductDirection(
+              *d_BLASWrapperPtrHost,
+              shapeValues,
+              nQuads1D,
+              nDofs1D,
+              true,
+              1,
+              {nQuads1D, nQuads1D, nDofs1D},
+              nInnerDouble,
+              tempValues2,
+              0.0,
+              tempValues1);
+            tensorProductUtils::contractTensorProductDirection(
+              *d_BLASWrapperPtrHost,
+              shapeValues,
+              nQuads1D,
+              nDofs1D,
+              true,
+              0,
+              {nQuads1D, nDofs1D, nDofs1D},
+              nInnerDouble,
+              tempValues1,
+              0.0,
+              cellResult);
+
+            // local pseudopotential/smeared charge correction on the lpsp
+            // quadrature
+            if (hasExtPot)
+              {
+                const unsigned int nQuadsLpsp1D =
+                  d_basisOperationsPtrHost->nQuadsPerCell1D(d_lpspQuadratureID);
+                const unsigned int nQuadsLpspPerCell =
+                  nQuadsLpsp1D * nQuadsLpsp1D * nQuadsLpsp1D;
+                const double *shapeValuesLpsp =
+                  d_basisOperationsPtrHost
+                    ->tensorProductShapeValues1D(d_lpspQuadratureID)
+                    .data();
+                tensorProductUtils::contractTensorProductDirection(
+                  *d_BLASWrapperPtrHost,
+                  shapeValuesLpsp,
+                  nQuadsLpsp1D,
+                  nDofs1D,
+                  false,
+                  0,
+                  dofExtents,
+                  nInnerDouble,
+                  cellValues,
+                  0.0,
+                  tempValues1);
+                tensorProductUtils::contractTensorProductDirection(
+                  *d_BLASWrapperPtrHost,
+                  shapeValuesLpsp,
+                  nQuadsLpsp1D,
+                  nDofs1D,
+                  false,
+                  1,
+                  {nQuadsLpsp1D, nDofs1D, nDofs1D},
+                  nInnerDouble,
+                  tempValues1,
+                  0.0,
+                  tempValues2);
+                tensorProductUtils::contractTensorProductDirection(
+                  *d_BLASWrapperPtrHost,
+                  shapeValuesLpsp,
+                  nQuadsLpsp1D,
+                  nDofs1D,
+                  false,
+                  2,
+                  {nQuadsLpsp1D, nQuadsLpsp1D, nDofs1D},
+                  nInnerDouble,
+                  tempValues2,
+                  0.0,
+                  quadValues);
+                const double *extPotWeights =
+                  d_VeffExtPotJxW.data() + iCell * nQuadsLpspPerCell;
+                for (unsigned int iQuad = 0; iQuad < nQuadsLpspPerCell; ++iQuad)
+                  for (unsigned int iInner = 0; iInner < nInnerDouble; ++iInner)
+                    quadValues[iQuad * nInnerDouble + iInner] *=
+                      extPotWeights[iQuad];
+                tensorProductUtils::contractTensorProductDirection(
+                  *d_BLASWrapperPtrHost,
+                  shapeValuesLpsp,
+                  nQuadsLpsp1D,
+                  nDofs1D,
+                  true,
+                  2,
+                  {nQuadsLpsp1D, nQuadsLpsp1D, nQuadsLpsp1D},
+                  nInnerDouble,
+                  quadValues,
+                  0.0,
+                  tempValues2);
+                tensorProductUtils::contractTensorProductDirection(
+                  *d_BLASWrapperPtrHost,
+                  shapeValuesLpsp,
+                  nQuadsLpsp1D,
+                  nDofs1D,
+                  true,
+                  1,
+                  {nQuadsLpsp1D, nQuadsLpsp1D, nDofs1D},
+                  nInnerDouble,
+                  tempValues2,
+                  0.0,
+                  tempValues1);
+                tensorProductUtils::contractTensorProductDirection(
+                  *d_BLASWrapperPtrHost,
+                  shapeValuesLpsp,
+                  nQuadsLpsp1D,
+                  nDofs1D,
+                  true,
+                  0,
+                  {nQuadsLpsp1D, nDofs1D, nDofs1D},
+                  nInnerDouble,
+                  tempValues1,
+                  1.0,
+                  cellResult);
+              }
+
+            // scatter back to the cell dof order
+            const dataTypes::number *cellResultNumber =
+              reinterpret_cast<const dataTypes::number *>(cellResult);
+            for (unsigned int iNode = 0; iNode < nDofsPerCell; ++iNode)
+              for (unsigned int iSpinor = 0; iSpinor < spinorFactor; ++iSpinor)
+                {
+                  dataTypes::number *dstNode =
+                    dst +
+                    lexicographicToCellDof[iNode] * spinorFactor *
+                      numberWavefunctions +
+                    iSpinor * numberWavefunctions + startVec;
+                  const dataTypes::number *resultNode =
+                    cellResultNumber + (iNode * spinorFactor + iSpinor) * nVecs;
+                  for (unsigned int iVec = 0; iVec < nVecs; ++iVec)
+                    dstNode[iVec] = scalar * resultNode[iVec];
+                }
+          }
+      }
+  }
+
+  template <dftfe::utils::MemorySpace memorySpace>
+  void
+  KohnShamHamiltonianOperator<memorySpace>::computeCellBlockColoring()
+  {
+    const unsigned int nCells       = d_basisOperationsPtr->nCells();
+    const unsigned int nDofsPerCell = d_basisOperationsPtr->nDofsPerCell();
+    d_cellBlockColors.clear();
+    if (d_nOMPThreads == 1)
+      {
+        // single colour retaining the natural cell order
+        d_cellBlockColors.resize(1);
+        for (unsigned int iCell = 0; iCell < nCells;
+             iCell += d_cellsBlockSizeHX)
+          d_cellBlockColors[0].push_back(iCell);
+        return;
+      }
+    const auto &cellDofIndexToProcessDofIndexMap =
+      d_basisOperationsPtrHost->d_cellDofIndexToProcessDofIndexMap;
+    dftfe::global_size_type nLocalDofs = 0;
+    for (unsigned int iDof = 0; iDof < cellDofIndexToProcessDofIndexMap.size();
+         ++iDof)
+      nLocalDofs =
+        std::max(nLocalDofs, cellDofIndexToProcessDofIndexMap[iDof] + 1);
+    // greedy colouring, dofsInColor[iColor][iDof] is true if a cell block of
+    // colour iColor already touches iDof
+    std::vector<std::vector<bool>> dofsInColor;
+    for (unsigned int iCell = 0; iCell < nCells; iCell += d_cellsBlockSizeHX)
+      {
+        const unsigned int cellEnd =
+          std::min(iCell + d_cellsBlockSizeHX, nCells);
+        unsigned int iColor = 0;
+        for (; iColor < dofsInColor.size(); ++iColor)
+          {
+            bool hasConflict = false;
+            for (unsigned int iDof = iCell * nDofsPerCell;
+                 iDof < cellEnd * nDofsPerCell && !hasConflict;
+                 ++iDof)
+              hasConflict =
+                dofsInColor[iColor][cellDofIndexToProcessDofIndexMap[iDof]];
+            if (!hasConflict)
+              break;
+          }
+        if (iColor == dofsInColor.size())
+          {
+            dofsInColor.emplace_back(nLocalDofs, false);
+            d_cellBlockColors.emplace_back();
+          }
+        for (unsigned int iDof = iCell * nDofsPerCell;
+             iDof < cellEnd * nDofsPerCell;
+             ++iDof)
+          dofsInColor[iColor][cellDofIndexToProcessDofIndexMap[iDof]] = true;
+        d_cellBlockColors[iColor].push_back(iCell);
+      }
+  }
+
   template <dftfe::utils::MemorySpace memorySpace>
   void
   KohnShamHamiltonianOperator<memorySpace>::resetExtPotHamFlag()
   {
-    d_isExternalPotCorrHamiltonianComputed = false;
+    d_isExternalPotCorrHamiltonianComputed   = false;
+    d_isKPointIndependentHamiltonianComputed = false;
   }
 
 
@@ -347,6 +1008,7 @@ namespace dftfe
     const std::map<dealii::CellId, std::vector<double>> &gradRhoCoreValues,
     const unsigned int                                   spinIndex)
   {
+    d_isKPointIndependentHamiltonianComputed = false;
     const bool isGGA =
       d_excManagerPtr->getDensityBasedFamilyType() == densityFamilyType::GGA;
     const unsigned int spinPolarizedFactor =
@@ -404,13 +1066,6 @@ namespace dftfe
                             totalLocallyOwnedCells * numberQuadraturePoints :
                             0,
                           0.0);
-    std::vector<double> d_VeffGGA(isGGA ? numberQuadraturePoints : 0, 0.0);
-    std::vector<double> d_BeffxGGA(
-      isGGA && d_dftParamsPtr->noncolin ? numberQuadraturePoints : 0, 0.0);
-    std::vector<double> d_BeffyGGA(
-      isGGA && d_dftParamsPtr->noncolin ? numberQuadraturePoints : 0, 0.0);
-    std::vector<double> d_BeffzGGA(
-      isGGA && d_dftParamsPtr->noncolin ? numberQuadraturePoints : 0, 0.0);
     d_invJacderExcWithSigmaTimesGradRhoJxWHost.resize(
       isGGA ? totalLocallyOwnedCells * numberQuadraturePoints * 3 : 0, 0.0);
     d_invJacderExcWithSigmaTimesMagXTimesGradRhoJxWHost.resize(
@@ -429,25 +1084,27 @@ namespace dftfe
         0,
       0.0);
 
-    // allocate storage for exchange potential
-    std::vector<double> exchangePotentialVal(numberQuadraturePoints *
-                                             spinPolarizedFactor);
-    std::vector<double> corrPotentialVal(numberQuadraturePoints *
-                                         spinPolarizedFactor);
-    std::vector<double> densityValue(numberQuadraturePoints *
-                                     spinPolarizedFactor);
-    std::vector<double> sigmaValue(
-      isGGA ? numberQuadraturePoints * spinPolarizedSigmaFactor : 0);
-    std::vector<double> derExchEnergyWithSigmaVal(
-      isGGA ? numberQuadraturePoints * spinPolarizedSigmaFactor : 0);
-    std::vector<double> derCorrEnergyWithSigmaVal(
-      isGGA ? numberQuadraturePoints * spinPolarizedSigmaFactor : 0);
-    std::vector<double> gradDensityValue(
-      isGGA ? 3 * numberQuadraturePoints * spinPolarizedFactor : 0);
-    std::vector<double> magNorm(
-      d_dftParamsPtr->noncolin ? numberQuadraturePoints : 0);
-    std::vector<double> magAxis(
-      d_dftParamsPtr->noncolin ? numberQuadraturePoints * 3 : 0);
+    // the quadrature points of a chunk of cells are packed contiguously and
+    // the functional is called once per chunk, the chunks being distributed
+    // over the threads. The ML-XC functionals (EXCHANGE CORRELATION TYPE 6
+    // and 7) evaluate a torch model, which is threaded itself, so they are
+    // called from a single thread with larger chunks
+    const bool         isModelXC = d_dftParamsPtr->xc_id >= 6;
+    const unsigned int nThreads  = isModelXC ? 1 : d_nOMPThreads;
+    const unsigned int maxQuadsPerChunk = isModelXC ? 65536 : 4096;
+    const unsigned int cellsPerChunk    = std::max(
+      1u,
+      std::min(maxQuadsPerChunk / numberQuadraturePoints,
+               (totalLocallyOwnedCells + 4 * nThreads - 1) / (4 * nThreads)));
+    const unsigned int numChunks =
+      (totalLocallyOwnedCells + cellsPerChunk - 1) / cellsPerChunk;
+    const unsigned int maxChunkQuads = cellsPerChunk * numberQuadraturePoints;
+
+    const unsigned int cellsTypeFlag =
+      d_basisOperationsPtrHost->cellsTypeFlag();
+    const double *JxWPtr = d_basisOperationsPtrHost->JxWBasisData().data();
+    const double *inverseJacobiansPtr =
+      d_basisOperationsPtrHost->inverseJacobiansBasisData().data();
     auto dot3 = [](const double *a, const double *b) {
       double sum = 0.0;
       for (unsigned int i = 0; i < 3; i++)
@@ -457,185 +1114,214 @@ namespace dftfe
       return sum;
     };
 
-    for (unsigned int iCell = 0; iCell < totalLocallyOwnedCells; ++iCell)
+    d_xcScratchThreads.resize(d_nOMPThreads);
+#pragma omp parallel for num_threads(nThreads) if (nThreads > 1)
+    for (unsigned int iChunk = 0; iChunk < numChunks; ++iChunk)
       {
+        const unsigned int cellStart = iChunk * cellsPerChunk;
+        const unsigned int nCellsChunk =
+          std::min(cellsPerChunk, totalLocallyOwnedCells - cellStart);
+        const unsigned int nChunkQuads = nCellsChunk * numberQuadraturePoints;
+        const unsigned int quadStart   = cellStart * numberQuadraturePoints;
+
+        // scratch is sized for the largest chunk and reused across the SCF
+        // iterations, the functional only reads nChunkQuads points
+        xcEvaluationScratch &scratch = d_xcScratchThreads[omp_get_thread_num()];
+        std::vector<double> &exchangePotentialVal =
+          scratch.exchangePotentialVal;
+        std::vector<double> &corrPotentialVal = scratch.corrPotentialVal;
+        std::vector<double> &densityValue     = scratch.densityValue;
+        std::vector<double> &sigmaValue       = scratch.sigmaValue;
+        std::vector<double> &derExchEnergyWithSigmaVal =
+          scratch.derExchEnergyWithSigmaVal;
+        std::vector<double> &derCorrEnergyWithSigmaVal =
+          scratch.derCorrEnergyWithSigmaVal;
+        std::vector<double> &gradDensityValue = scratch.gradDensityValue;
+        exchangePotentialVal.resize(maxChunkQuads * spinPolarizedFactor);
+        corrPotentialVal.resize(maxChunkQuads * spinPolarizedFactor);
+        densityValue.resize(maxChunkQuads * spinPolarizedFactor);
+        sigmaValue.resize(isGGA ? maxChunkQuads * spinPolarizedSigmaFactor : 0);
+        derExchEnergyWithSigmaVal.resize(
+          isGGA ? maxChunkQuads * spinPolarizedSigmaFactor : 0);
+        derCorrEnergyWithSigmaVal.resize(
+          isGGA ? maxChunkQuads * spinPolarizedSigmaFactor : 0);
+        gradDensityValue.resize(
+          isGGA ? 3 * maxChunkQuads * spinPolarizedFactor : 0);
+        // components of the magnetization axis stored one after the other
+        scratch.magAxis.resize(d_dftParamsPtr->noncolin ? 3 * maxChunkQuads :
+                                                          0);
+        scratch.veffGGA.resize(
+          isGGA && d_dftParamsPtr->noncolin ? 4 * maxChunkQuads : 0);
+        double *magAxisX =
+          d_dftParamsPtr->noncolin ? scratch.magAxis.data() : nullptr;
+        double *magAxisY =
+          d_dftParamsPtr->noncolin ? magAxisX + maxChunkQuads : nullptr;
+        double *magAxisZ =
+          d_dftParamsPtr->noncolin ? magAxisY + maxChunkQuads : nullptr;
+
         if (d_dftParamsPtr->noncolin)
           {
-            const double *cellRhoValues =
-              rhoValues[0].data() + iCell * numberQuadraturePoints;
-            const double *cellMagZValues =
-              rhoValues[1].data() + iCell * numberQuadraturePoints;
-            const double *cellMagYValues =
-              rhoValues[2].data() + iCell * numberQuadraturePoints;
-            const double *cellMagXValues =
-              rhoValues[3].data() + iCell * numberQuadraturePoints;
-            for (unsigned int iQuad = 0; iQuad < numberQuadraturePoints;
-                 ++iQuad)
+            const double *chunkRhoValues  = rhoValues[0].data() + quadStart;
+            const double *chunkMagZValues = rhoValues[1].data() + quadStart;
+            const double *chunkMagYValues = rhoValues[2].data() + quadStart;
+            const double *chunkMagXValues = rhoValues[3].data() + quadStart;
+            double *      densityValuePtr = densityValue.data();
+            // local frame of the magnetization, branch free to vectorize
+#pragma omp simd
+            for (unsigned int iQuad = 0; iQuad < nChunkQuads; ++iQuad)
               {
-                const double rhoByTwo = cellRhoValues[iQuad] / 2.0;
-                magNorm[iQuad] =
-                  std::sqrt(cellMagZValues[iQuad] * cellMagZValues[iQuad] +
-                            cellMagYValues[iQuad] * cellMagYValues[iQuad] +
-                            cellMagXValues[iQuad] * cellMagXValues[iQuad]);
-                if (magNorm[iQuad] > 1e-12)
-                  {
-                    magAxis[3 * iQuad + 0] =
-                      cellMagXValues[iQuad] / magNorm[iQuad];
-                    magAxis[3 * iQuad + 1] =
-                      cellMagYValues[iQuad] / magNorm[iQuad];
-                    magAxis[3 * iQuad + 2] =
-                      cellMagZValues[iQuad] / magNorm[iQuad];
-                  }
-                else
-                  {
-                    magAxis[3 * iQuad + 0] = 0.0;
-                    magAxis[3 * iQuad + 1] = 0.0;
-                    magAxis[3 * iQuad + 2] = 0.0;
-                  }
-                const double magByTwo       = magNorm[iQuad] / 2.0;
-                densityValue[2 * iQuad]     = rhoByTwo + magByTwo;
-                densityValue[2 * iQuad + 1] = rhoByTwo - magByTwo;
+                const double rhoByTwo = chunkRhoValues[iQuad] / 2.0;
+                const double magNorm =
+                  std::sqrt(chunkMagZValues[iQuad] * chunkMagZValues[iQuad] +
+                            chunkMagYValues[iQuad] * chunkMagYValues[iQuad] +
+                            chunkMagXValues[iQuad] * chunkMagXValues[iQuad]);
+                const bool   isMagnetized = magNorm > 1e-12;
+                const double magNormSafe  = isMagnetized ? magNorm : 1.0;
+                magAxisX[iQuad] =
+                  isMagnetized ? chunkMagXValues[iQuad] / magNormSafe : 0.0;
+                magAxisY[iQuad] =
+                  isMagnetized ? chunkMagYValues[iQuad] / magNormSafe : 0.0;
+                magAxisZ[iQuad] =
+                  isMagnetized ? chunkMagZValues[iQuad] / magNormSafe : 0.0;
+                const double magByTwo          = magNorm / 2.0;
+                densityValuePtr[2 * iQuad]     = rhoByTwo + magByTwo;
+                densityValuePtr[2 * iQuad + 1] = rhoByTwo - magByTwo;
               }
           }
         else if (spinPolarizedFactor == 1)
           std::memcpy(densityValue.data(),
-                      rhoValues[0].data() + iCell * numberQuadraturePoints,
-                      numberQuadraturePoints * sizeof(double));
+                      rhoValues[0].data() + quadStart,
+                      nChunkQuads * sizeof(double));
         else if (spinPolarizedFactor == 2)
           {
-            const double *cellRhoValues =
-              rhoValues[0].data() + iCell * numberQuadraturePoints;
-            const double *cellMagValues =
-              rhoValues[1].data() + iCell * numberQuadraturePoints;
-            for (unsigned int iQuad = 0; iQuad < numberQuadraturePoints;
-                 ++iQuad)
+            const double *chunkRhoValues = rhoValues[0].data() + quadStart;
+            const double *chunkMagValues = rhoValues[1].data() + quadStart;
+            double *      densityValuePtr = densityValue.data();
+#pragma omp simd
+            for (unsigned int iQuad = 0; iQuad < nChunkQuads; ++iQuad)
               {
-                const double rhoByTwo       = cellRhoValues[iQuad] / 2.0;
-                const double magByTwo       = cellMagValues[iQuad] / 2.0;
-                densityValue[2 * iQuad]     = rhoByTwo + magByTwo;
-                densityValue[2 * iQuad + 1] = rhoByTwo - magByTwo;
+                const double rhoByTwo          = chunkRhoValues[iQuad] / 2.0;
+                const double magByTwo          = chunkMagValues[iQuad] / 2.0;
+                densityValuePtr[2 * iQuad]     = rhoByTwo + magByTwo;
+                densityValuePtr[2 * iQuad + 1] = rhoByTwo - magByTwo;
               }
           }
         if (isGGA)
           if (d_dftParamsPtr->noncolin)
             {
-              const double *cellGradRhoValues =
-                gradRhoValues[0].data() + 3 * iCell * numberQuadraturePoints;
-              const double *cellGradMagZValues =
-                gradRhoValues[1].data() + 3 * iCell * numberQuadraturePoints;
-              const double *cellGradMagYValues =
-                gradRhoValues[2].data() + 3 * iCell * numberQuadraturePoints;
-              const double *cellGradMagXValues =
-                gradRhoValues[3].data() + 3 * iCell * numberQuadraturePoints;
-              for (unsigned int iQuad = 0; iQuad < numberQuadraturePoints;
-                   ++iQuad)
-                {
-                  for (unsigned int iDim = 0; iDim < 3; ++iDim)
-                    {
-                      const double gradRhoByTwo =
-                        cellGradRhoValues[3 * iQuad + iDim] / 2.0;
-                      double gradMagByTwo =
-                        (magAxis[3 * iQuad + 2] *
-                           cellGradMagZValues[3 * iQuad + iDim] +
-                         magAxis[3 * iQuad + 1] *
-                           cellGradMagYValues[3 * iQuad + iDim] +
-                         magAxis[3 * iQuad + 0] *
-                           cellGradMagXValues[3 * iQuad + iDim]) /
-                        2.0;
-                      gradDensityValue[6 * iQuad + iDim] =
-                        gradRhoByTwo + gradMagByTwo;
-                      gradDensityValue[6 * iQuad + 3 + iDim] =
-                        gradRhoByTwo - gradMagByTwo;
-                    }
-                }
+              const double *chunkGradRhoValues =
+                gradRhoValues[0].data() + 3 * quadStart;
+              const double *chunkGradMagZValues =
+                gradRhoValues[1].data() + 3 * quadStart;
+              const double *chunkGradMagYValues =
+                gradRhoValues[2].data() + 3 * quadStart;
+              const double *chunkGradMagXValues =
+                gradRhoValues[3].data() + 3 * quadStart;
+              for (unsigned int iQuad = 0; iQuad < nChunkQuads; ++iQuad)
+                for (unsigned int iDim = 0; iDim < 3; ++iDim)
+                  {
+                    const unsigned int index = 3 * iQuad + iDim;
+                    const double       gradRhoByTwo =
+                      chunkGradRhoValues[index] / 2.0;
+                    const double gradMagByTwo =
+                      (magAxisZ[iQuad] * chunkGradMagZValues[index] +
+                       magAxisY[iQuad] * chunkGradMagYValues[index] +
+                       magAxisX[iQuad] * chunkGradMagXValues[index]) /
+                      2.0;
+                    gradDensityValue[6 * iQuad + iDim] =
+                      gradRhoByTwo + gradMagByTwo;
+                    gradDensityValue[6 * iQuad + 3 + iDim] =
+                      gradRhoByTwo - gradMagByTwo;
+                  }
             }
           else if (spinPolarizedFactor == 1)
             std::memcpy(gradDensityValue.data(),
-                        gradRhoValues[0].data() +
-                          iCell * numberQuadraturePoints * 3,
-                        3 * numberQuadraturePoints * sizeof(double));
+                        gradRhoValues[0].data() + 3 * quadStart,
+                        3 * nChunkQuads * sizeof(double));
           else if (spinPolarizedFactor == 2)
             {
-              const double *cellGradRhoValues =
-                gradRhoValues[0].data() + 3 * iCell * numberQuadraturePoints;
-              const double *cellGradMagValues =
-                gradRhoValues[1].data() + 3 * iCell * numberQuadraturePoints;
-              for (unsigned int iQuad = 0; iQuad < numberQuadraturePoints;
-                   ++iQuad)
+              const double *chunkGradRhoValues =
+                gradRhoValues[0].data() + 3 * quadStart;
+              const double *chunkGradMagValues =
+                gradRhoValues[1].data() + 3 * quadStart;
+              for (unsigned int iQuad = 0; iQuad < nChunkQuads; ++iQuad)
                 for (unsigned int iDim = 0; iDim < 3; ++iDim)
                   {
                     const double gradRhoByTwo =
-                      cellGradRhoValues[3 * iQuad + iDim] / 2.0;
+                      chunkGradRhoValues[3 * iQuad + iDim] / 2.0;
                     const double gradMagByTwo =
-                      cellGradMagValues[3 * iQuad + iDim] / 2.0;
+                      chunkGradMagValues[3 * iQuad + iDim] / 2.0;
                     gradDensityValue[6 * iQuad + iDim] =
                       gradRhoByTwo + gradMagByTwo;
                     gradDensityValue[6 * iQuad + 3 + iDim] =
                       gradRhoByTwo - gradMagByTwo;
                   }
             }
-        const double *tempPhi =
-          phiValues.data() + iCell * numberQuadraturePoints;
-
 
         if (d_dftParamsPtr->nonLinearCoreCorrection)
-          if (spinPolarizedFactor == 1)
-            {
-              std::transform(densityValue.data(),
-                             densityValue.data() + numberQuadraturePoints,
-                             rhoCoreValues
-                               .find(d_basisOperationsPtrHost->cellID(iCell))
-                               ->second.data(),
-                             densityValue.data(),
-                             std::plus<>{});
-              if (isGGA)
-                std::transform(gradDensityValue.data(),
-                               gradDensityValue.data() +
-                                 3 * numberQuadraturePoints,
-                               gradRhoCoreValues
-                                 .find(d_basisOperationsPtrHost->cellID(iCell))
-                                 ->second.data(),
-                               gradDensityValue.data(),
-                               std::plus<>{});
-            }
-          else if (spinPolarizedFactor == 2)
+          for (unsigned int iCell = cellStart; iCell < cellStart + nCellsChunk;
+               ++iCell)
             {
+              const unsigned int quadOffset =
+                (iCell - cellStart) * numberQuadraturePoints;
               const std::vector<double> &temp2 =
                 rhoCoreValues.find(d_basisOperationsPtrHost->cellID(iCell))
                   ->second;
-              for (unsigned int iQuad = 0; iQuad < numberQuadraturePoints;
-                   ++iQuad)
+              if (spinPolarizedFactor == 1)
                 {
-                  densityValue[2 * iQuad] += temp2[iQuad] / 2.0;
-                  densityValue[2 * iQuad + 1] += temp2[iQuad] / 2.0;
+                  for (unsigned int iQuad = 0; iQuad < numberQuadraturePoints;
+                       ++iQuad)
+                    densityValue[quadOffset + iQuad] += temp2[iQuad];
+                  if (isGGA)
+                    {
+                      const std::vector<double> &temp3 =
+                        gradRhoCoreValues
+                          .find(d_basisOperationsPtrHost->cellID(iCell))
+                          ->second;
+                      for (unsigned int i = 0; i < 3 * numberQuadraturePoints;
+                           ++i)
+                        gradDensityValue[3 * quadOffset + i] += temp3[i];
+                    }
                 }
-              if (isGGA)
+              else if (spinPolarizedFactor == 2)
                 {
-                  const std::vector<double> &temp3 =
-                    gradRhoCoreValues
-                      .find(d_basisOperationsPtrHost->cellID(iCell))
-                      ->second;
                   for (unsigned int iQuad = 0; iQuad < numberQuadraturePoints;
                        ++iQuad)
-                    for (unsigned int iDim = 0; iDim < 3; ++iDim)
-                      {
-                        gradDensityValue[6 * iQuad + iDim] +=
-                          temp3[3 * iQuad + iDim] / 2.0;
-                        gradDensityValue[6 * iQuad + iDim + 3] +=
-                          temp3[3 * iQuad + iDim] / 2.0;
-                      }
+                    {
+                      densityValue[2 * (quadOffset + iQuad)] +=
+                        temp2[iQuad] / 2.0;
+                      densityValue[2 * (quadOffset + iQuad) + 1] +=
+                        temp2[iQuad] / 2.0;
+                    }
+                  if (isGGA)
+                    {
+                      const std::vector<double> &temp3 =
+                        gradRhoCoreValues
+                          .find(d_basisOperationsPtrHost->cellID(iCell))
+                          ->second;
+                      for (unsigned int iQuad = 0;
+                           iQuad < numberQuadraturePoints;
+                           ++iQuad)
+                        for (unsigned int iDim = 0; iDim < 3; ++iDim)
+                          {
+                            const unsigned int index =
+                              6 * (quadOffset + iQuad) + iDim;
+                            gradDensityValue[index] +=
+                              temp3[3 * iQuad + iDim] / 2.0;
+                            gradDensityValue[index + 3] +=
+                              temp3[3 * iQuad + iDim] / 2.0;
+                          }
+                    }
                 }
             }
         if (isGGA)
           {
             if (spinPolarizedFactor == 1)
-              for (unsigned int iQuad = 0; iQuad < numberQuadraturePoints;
-                   ++iQuad)
+              for (unsigned int iQuad = 0; iQuad < nChunkQuads; ++iQuad)
                 sigmaValue[iQuad] = dot3(gradDensityValue.data() + 3 * iQuad,
                                          gradDensityValue.data() + 3 * iQuad);
             else if (spinPolarizedFactor == 2)
-              for (unsigned int iQuad = 0; iQuad < numberQuadraturePoints;
-                   ++iQuad)
+              for (unsigned int iQuad = 0; iQuad < nChunkQuads; ++iQuad)
                 {
                   sigmaValue[3 * iQuad] =
                     dot3(gradDensityValue.data() + 6 * iQuad,
@@ -674,69 +1360,97 @@ namespace dftfe
                 &derCorrEnergyWithSigmaVal;
           }
         d_excManagerPtr->getExcDensityObj()->computeDensityBasedVxc(
-          numberQuadraturePoints,
-          rhoData,
-          outputDerExchangeEnergy,
-          outputDerCorrEnergy);
-        auto cellJxWPtr = d_basisOperationsPtrHost->JxWBasisData().data() +
-                          iCell * numberQuadraturePoints;
-        if (spinPolarizedFactor == 1)
-          for (unsigned int iQuad = 0; iQuad < numberQuadraturePoints; ++iQuad)
-            d_VeffJxWHost[iCell * numberQuadraturePoints + iQuad] =
-              (tempPhi[iQuad] + exchangePotentialVal[iQuad] +
-               corrPotentialVal[iQuad]) *
-              cellJxWPtr[iQuad];
-        else if (!d_dftParamsPtr->noncolin)
-          for (unsigned int iQuad = 0; iQuad < numberQuadraturePoints; ++iQuad)
-            d_VeffJxWHost[iCell * numberQuadraturePoints + iQuad] =
-              (tempPhi[iQuad] + exchangePotentialVal[2 * iQuad + spinIndex] +
-               corrPotentialVal[2 * iQuad + spinIndex]) *
-              cellJxWPtr[iQuad];
-        else
+          nChunkQuads, rhoData, outputDerExchangeEnergy, outputDerCorrEnergy);
+
+        for (unsigned int iCell = cellStart; iCell < cellStart + nCellsChunk;
+             ++iCell)
           {
-            for (unsigned int iQuad = 0; iQuad < numberQuadraturePoints;
-                 ++iQuad)
-              {
+            const unsigned int quadOffset =
+              (iCell - cellStart) * numberQuadraturePoints;
+            const double *tempPhi =
+              phiValues.data() + iCell * numberQuadraturePoints;
+            const double *cellJxWPtr = JxWPtr + iCell * numberQuadraturePoints;
+            const double *cellExchangePotentialVal =
+              exchangePotentialVal.data() + spinPolarizedFactor * quadOffset;
+            const double *cellCorrPotentialVal =
+              corrPotentialVal.data() + spinPolarizedFactor * quadOffset;
+            const double *cellMagAxisX =
+              d_dftParamsPtr->noncolin ? magAxisX + quadOffset : nullptr;
+            const double *cellMagAxisY =
+              d_dftParamsPtr->noncolin ? magAxisY + quadOffset : nullptr;
+            const double *cellMagAxisZ =
+              d_dftParamsPtr->noncolin ? magAxisZ + quadOffset : nullptr;
+            if (spinPolarizedFactor == 1)
+              for (unsigned int iQuad = 0; iQuad < numberQuadraturePoints;
+                   ++iQuad)
+                d_VeffJxWHost[iCell * numberQuadraturePoints + iQuad] =
+                  (tempPhi[iQuad] + cellExchangePotentialVal[iQuad] +
+                   cellCorrPotentialVal[iQuad]) *
+                  cellJxWPtr[iQuad];
+            else if (!d_dftParamsPtr->noncolin)
+              for (unsigned int iQuad = 0; iQuad < numberQuadraturePoints;
+                   ++iQuad)
                 d_VeffJxWHost[iCell * numberQuadraturePoints + iQuad] =
-                  (tempPhi[iQuad] + 0.5 * (exchangePotentialVal[2 * iQuad + 0] +
-                                           exchangePotentialVal[2 * iQuad + 1] +
-                                           corrPotentialVal[2 * iQuad + 0] +
-                                           corrPotentialVal[2 * iQuad + 1])) *
+                  (tempPhi[iQuad] +
+                   cellExchangePotentialVal[2 * iQuad + spinIndex] +
+                   cellCorrPotentialVal[2 * iQuad + spinIndex]) *
                   cellJxWPtr[iQuad];
-                const double temp = 0.5 *
-                                    (exchangePotentialVal[2 * iQuad + 0] -
-                                     exchangePotentialVal[2 * iQuad + 1] +
-                                     corrPotentialVal[2 * iQuad + 0] -
-                                     corrPotentialVal[2 * iQuad + 1]) *
-                                    cellJxWPtr[iQuad];
-                d_BeffxJxWHost[iCell * numberQuadraturePoints + iQuad] =
-                  temp * magAxis[3 * iQuad + 0];
-                d_BeffyJxWHost[iCell * numberQuadraturePoints + iQuad] =
-                  temp * magAxis[3 * iQuad + 1];
-                d_BeffzJxWHost[iCell * numberQuadraturePoints + iQuad] =
-                  temp * magAxis[3 * iQuad + 2];
+            else
+              {
+                for (unsigned int iQuad = 0; iQuad < numberQuadraturePoints;
+                     ++iQuad)
+                  {
+                    d_VeffJxWHost[iCell * numberQuadraturePoints + iQuad] =
+                      (tempPhi[iQuad] +
+                       0.5 * (cellExchangePotentialVal[2 * iQuad + 0] +
+                              cellExchangePotentialVal[2 * iQuad + 1] +
+                              cellCorrPotentialVal[2 * iQuad + 0] +
+                              cellCorrPotentialVal[2 * iQuad + 1])) *
+                      cellJxWPtr[iQuad];
+                    const double temp =
+                      0.5 *
+                      (cellExchangePotentialVal[2 * iQuad + 0] -
+                       cellExchangePotentialVal[2 * iQuad + 1] +
+                       cellCorrPotentialVal[2 * iQuad + 0] -
+                       cellCorrPotentialVal[2 * iQuad + 1]) *
+                      cellJxWPtr[iQuad];
+                    d_BeffxJxWHost[iCell * numberQuadraturePoints + iQuad] =
+                      temp * cellMagAxisX[iQuad];
+                    d_BeffyJxWHost[iCell * numberQuadraturePoints + iQuad] =
+                      temp * cellMagAxisY[iQuad];
+                    d_BeffzJxWHost[iCell * numberQuadraturePoints + iQuad] =
+                      temp * cellMagAxisZ[iQuad];
+                  }
               }
-          }
-        if (isGGA)
-          {
+            if (!isGGA)
+              continue;
+
+            const double *cellDerExchEnergyWithSigmaVal =
+              derExchEnergyWithSigmaVal.data() +
+              spinPolarizedSigmaFactor * quadOffset;
+            const double *cellDerCorrEnergyWithSigmaVal =
+              derCorrEnergyWithSigmaVal.data() +
+              spinPolarizedSigmaFactor * quadOffset;
+            const double *cellGradDensityValue =
+              gradDensityValue.data() + 3 * spinPolarizedFactor * quadOffset;
             if (spinPolarizedFactor == 1)
               {
-                if (d_basisOperationsPtrHost->cellsTypeFlag() != 2)
+                if (cellsTypeFlag != 2)
                   {
                     for (unsigned int iQuad = 0; iQuad < numberQuadraturePoints;
                          ++iQuad)
                       {
                         const double *inverseJacobiansQuadPtr =
-                          d_basisOperationsPtrHost->inverseJacobiansBasisData()
-                            .data() +
-                          (d_basisOperationsPtrHost->cellsTypeFlag() == 0 ?
+                          inverseJacobiansPtr +
+                          (cellsTypeFlag == 0 ?
                              iCell * numberQuadraturePoints * 9 + iQuad * 9 :
                              iCell * 9);
                         const double *gradDensityQuadPtr =
-                          gradDensityValue.data() + 3 * iQuad;
-                        const double term = (derExchEnergyWithSigmaVal[iQuad] +
-                                             derCorrEnergyWithSigmaVal[iQuad]) *
-                                            cellJxWPtr[iQuad];
+                          cellGradDensityValue + 3 * iQuad;
+                        const double term =
+                          (cellDerExchEnergyWithSigmaVal[iQuad] +
+                           cellDerCorrEnergyWithSigmaVal[iQuad]) *
+                          cellJxWPtr[iQuad];
                         for (unsigned jDim = 0; jDim < 3; ++jDim)
                           for (unsigned iDim = 0; iDim < 3; ++iDim)
                             d_invJacderExcWithSigmaTimesGradRhoJxWHost
@@ -746,20 +1460,19 @@ namespace dftfe
                               gradDensityQuadPtr[jDim] * term;
                       }
                   }
-                else if (d_basisOperationsPtrHost->cellsTypeFlag() == 2)
+                else if (cellsTypeFlag == 2)
                   {
                     for (unsigned int iQuad = 0; iQuad < numberQuadraturePoints;
                          ++iQuad)
                       {
                         const double *inverseJacobiansQuadPtr =
-                          d_basisOperationsPtrHost->inverseJacobiansBasisData()
-                            .data() +
-                          iCell * 3;
+                          inverseJacobiansPtr + iCell * 3;
                         const double *gradDensityQuadPtr =
-                          gradDensityValue.data() + 3 * iQuad;
-                        const double term = (derExchEnergyWithSigmaVal[iQuad] +
-                                             derCorrEnergyWithSigmaVal[iQuad]) *
-                                            cellJxWPtr[iQuad];
+                          cellGradDensityValue + 3 * iQuad;
+                        const double term =
+                          (cellDerExchEnergyWithSigmaVal[iQuad] +
+                           cellDerCorrEnergyWithSigmaVal[iQuad]) *
+                          cellJxWPtr[iQuad];
                         for (unsigned iDim = 0; iDim < 3; ++iDim)
                           d_invJacderExcWithSigmaTimesGradRhoJxWHost
                             [iCell * numberQuadraturePoints * 3 + iQuad * 3 +
@@ -770,31 +1483,30 @@ namespace dftfe
               }
             else if (!d_dftParamsPtr->noncolin)
               {
-                if (d_basisOperationsPtrHost->cellsTypeFlag() != 2)
+                if (cellsTypeFlag != 2)
                   {
                     for (unsigned int iQuad = 0; iQuad < numberQuadraturePoints;
                          ++iQuad)
                       {
                         const double *inverseJacobiansQuadPtr =
-                          d_basisOperationsPtrHost->inverseJacobiansBasisData()
-                            .data() +
-                          (d_basisOperationsPtrHost->cellsTypeFlag() == 0 ?
+                          inverseJacobiansPtr +
+                          (cellsTypeFlag == 0 ?
                              iCell * numberQuadraturePoints * 9 + iQuad * 9 :
                              iCell * 9);
                         const double *gradDensityQuadPtr =
-                          gradDensityValue.data() + 6 * iQuad + 3 * spinIndex;
+                          cellGradDensityValue + 6 * iQuad + 3 * spinIndex;
                         const double *gradDensityOtherQuadPtr =
-                          gradDensityValue.data() + 6 * iQuad +
+                          cellGradDensityValue + 6 * iQuad +
                           3 * (1 - spinIndex);
                         const double term =
-                          (derExchEnergyWithSigmaVal[3 * iQuad +
-                                                     2 * spinIndex] +
-                           derCorrEnergyWithSigmaVal[3 * iQuad +
-                                                     2 * spinIndex]) *
+                          (cellDerExchEnergyWithSigmaVal[3 * iQuad +
+                                                         2 * spinIndex] +
+                           cellDerCorrEnergyWithSigmaVal[3 * iQuad +
+                                                         2 * spinIndex]) *
                           cellJxWPtr[iQuad];
                         const double termoff =
-                          (derExchEnergyWithSigmaVal[3 * iQuad + 1] +
-                           derCorrEnergyWithSigmaVal[3 * iQuad + 1]) *
+                          (cellDerExchEnergyWithSigmaVal[3 * iQuad + 1] +
+                           cellDerCorrEnergyWithSigmaVal[3 * iQuad + 1]) *
                           cellJxWPtr[iQuad];
                         for (unsigned jDim = 0; jDim < 3; ++jDim)
                           for (unsigned iDim = 0; iDim < 3; ++iDim)
@@ -806,29 +1518,27 @@ namespace dftfe
                                gradDensityOtherQuadPtr[jDim] * termoff);
                       }
                   }
-                else if (d_basisOperationsPtrHost->cellsTypeFlag() == 2)
+                else if (cellsTypeFlag == 2)
                   {
                     for (unsigned int iQuad = 0; iQuad < numberQuadraturePoints;
                          ++iQuad)
                       {
                         const double *inverseJacobiansQuadPtr =
-                          d_basisOperationsPtrHost->inverseJacobiansBasisData()
-                            .data() +
-                          iCell * 3;
+                          inverseJacobiansPtr + iCell * 3;
                         const double *gradDensityQuadPtr =
-                          gradDensityValue.data() + 6 * iQuad + 3 * spinIndex;
+                          cellGradDensityValue + 6 * iQuad + 3 * spinIndex;
                         const double *gradDensityOtherQuadPtr =
-                          gradDensityValue.data() + 6 * iQuad +
+                          cellGradDensityValue + 6 * iQuad +
                           3 * (1 - spinIndex);
                         const double term =
-                          (derExchEnergyWithSigmaVal[3 * iQuad +
-                                                     2 * spinIndex] +
-                           derCorrEnergyWithSigmaVal[3 * iQuad +
-                                                     2 * spinIndex]) *
+                          (cellDerExchEnergyWithSigmaVal[3 * iQuad +
+                                                         2 * spinIndex] +
+                           cellDerCorrEnergyWithSigmaVal[3 * iQuad +
+                                                         2 * spinIndex]) *
                           cellJxWPtr[iQuad];
                         const double termoff =
-                          (derExchEnergyWithSigmaVal[3 * iQuad + 1] +
-                           derCorrEnergyWithSigmaVal[3 * iQuad + 1]) *
+                          (cellDerExchEnergyWithSigmaVal[3 * iQuad + 1] +
+                           cellDerCorrEnergyWithSigmaVal[3 * iQuad + 1]) *
                           cellJxWPtr[iQuad];
                         for (unsigned iDim = 0; iDim < 3; ++iDim)
                           d_invJacderExcWithSigmaTimesGradRhoJxWHost
@@ -841,38 +1551,31 @@ namespace dftfe
               }
             else
               {
-                const double *cellGradMagZValues =
-                  gradRhoValues[1].data() + 3 * iCell * numberQuadraturePoints;
-                const double *cellGradMagYValues =
-                  gradRhoValues[2].data() + 3 * iCell * numberQuadraturePoints;
-                const double *cellGradMagXValues =
-                  gradRhoValues[3].data() + 3 * iCell * numberQuadraturePoints;
-                if (d_basisOperationsPtrHost->cellsTypeFlag() != 2)
+                if (cellsTypeFlag != 2)
                   {
                     for (unsigned int iQuad = 0; iQuad < numberQuadraturePoints;
                          ++iQuad)
                       {
                         const double *inverseJacobiansQuadPtr =
-                          d_basisOperationsPtrHost->inverseJacobiansBasisData()
-                            .data() +
-                          (d_basisOperationsPtrHost->cellsTypeFlag() == 0 ?
+                          inverseJacobiansPtr +
+                          (cellsTypeFlag == 0 ?
                              iCell * numberQuadraturePoints * 9 + iQuad * 9 :
                              iCell * 9);
                         const double *gradDensitySpin0QuadPtr =
-                          gradDensityValue.data() + 6 * iQuad;
+                          cellGradDensityValue + 6 * iQuad;
                         const double *gradDensitySpin1QuadPtr =
-                          gradDensityValue.data() + 6 * iQuad + 3;
+                          cellGradDensityValue + 6 * iQuad + 3;
                         const double termSpin0 =
-                          (derExchEnergyWithSigmaVal[3 * iQuad] +
-                           derCorrEnergyWithSigmaVal[3 * iQuad]) *
+                          (cellDerExchEnergyWithSigmaVal[3 * iQuad] +
+                           cellDerCorrEnergyWithSigmaVal[3 * iQuad]) *
                           cellJxWPtr[iQuad];
                         const double termSpin1 =
-                          (derExchEnergyWithSigmaVal[3 * iQuad + 2] +
-                           derCorrEnergyWithSigmaVal[3 * iQuad + 2]) *
+                          (cellDerExchEnergyWithSigmaVal[3 * iQuad + 2] +
+                           cellDerCorrEnergyWithSigmaVal[3 * iQuad + 2]) *
                           cellJxWPtr[iQuad];
                         const double termSpinCross =
-                          (derExchEnergyWithSigmaVal[3 * iQuad + 1] +
-                           derCorrEnergyWithSigmaVal[3 * iQuad + 1]) *
+                          (cellDerExchEnergyWithSigmaVal[3 * iQuad + 1] +
+                           cellDerCorrEnergyWithSigmaVal[3 * iQuad + 1]) *
                           cellJxWPtr[iQuad];
                         for (unsigned jDim = 0; jDim < 3; ++jDim)
                           for (unsigned iDim = 0; iDim < 3; ++iDim)
@@ -903,43 +1606,41 @@ namespace dftfe
                                 d_invJacderExcWithSigmaTimesMagXTimesGradRhoJxWHost
                                   [iCell * numberQuadraturePoints * 3 +
                                    iQuad * 3 + iDim] +=
-                                  termJac * magAxis[3 * iQuad + 0];
+                                  termJac * cellMagAxisX[iQuad];
                                 d_invJacderExcWithSigmaTimesMagYTimesGradRhoJxWHost
                                   [iCell * numberQuadraturePoints * 3 +
                                    iQuad * 3 + iDim] +=
-                                  termJac * magAxis[3 * iQuad + 1];
+                                  termJac * cellMagAxisY[iQuad];
                                 d_invJacderExcWithSigmaTimesMagZTimesGradRhoJxWHost
                                   [iCell * numberQuadraturePoints * 3 +
                                    iQuad * 3 + iDim] +=
-                                  termJac * magAxis[3 * iQuad + 2];
+                                  termJac * cellMagAxisZ[iQuad];
                               }
                           }
                       }
                   }
-                else if (d_basisOperationsPtrHost->cellsTypeFlag() == 2)
+                else if (cellsTypeFlag == 2)
                   {
                     for (unsigned int iQuad = 0; iQuad < numberQuadraturePoints;
                          ++iQuad)
                       {
                         const double *inverseJacobiansQuadPtr =
-                          d_basisOperationsPtrHost->inverseJacobiansBasisData()
-                            .data() +
-                          iCell * 3;
+                          inverseJacobiansPtr + iCell * 3;
                         const double *gradDensitySpin0QuadPtr =
-                          gradDensityValue.data() + 6 * iQuad;
+                          cellGradDensityValue + 6 * iQuad;
                         const double *gradDensitySpin1QuadPtr =
-                          gradDensityValue.data() + 6 * iQuad + 3;
+                          cellGradDensityValue + 6 * iQuad + 3;
                         const double termSpin0 =
-                          (derExchEnergyWithSigmaVal[3 * iQuad] +
-                           derCorrEnergyWithSigmaVal[3 * iQuad]) *
+                          (cellDerExchEnergyWithSigmaVal[3 * iQuad] +
+                           cellDerCorrEnergyWithSigmaVal[3 * iQuad]) *
                           cellJxWPtr[iQuad];
                         const double termSpin1 =
-                          (derExchEnergyWithSigmaVal[3 * iQuad + 2] +
-                           derCorrEnergyWithSigmaVal[3 * iQuad + 2]) *
+                          (cellDerExchEnergyWithSigmaVal[3 * iQuad + 2] +
+                           cellDerCorrEnergyWithSigmaVal[3 * iQuad + 2]) *
                           cellJxWPtr[iQuad];
                         const double termSpinCross =
-                          (derExchEnergyWithSigmaVal[3 * iQuad + 1] +
-                           derCorrEnergyWithSigmaVal[3 * iQuad + 1]) *
+                          (cellDerExchEnergyWithSigmaVal[3 * iQuad + 1] +
+                           cellDerCorrEnergyWithSigmaVal[3 * iQuad + 1]) *
                           cellJxWPtr[iQuad];
                         for (unsigned jDim = 0; jDim < 3; ++jDim)
                           {
@@ -966,102 +1667,61 @@ namespace dftfe
                                jDim] = termPlusJac;
                             d_invJacderExcWithSigmaTimesMagXTimesGradRhoJxWHost
                               [iCell * numberQuadraturePoints * 3 + iQuad * 3 +
-                               jDim] = termMinusJac * magAxis[3 * iQuad + 0];
+                               jDim] = termMinusJac * cellMagAxisX[iQuad];
                             d_invJacderExcWithSigmaTimesMagYTimesGradRhoJxWHost
                               [iCell * numberQuadraturePoints * 3 + iQuad * 3 +
-                               jDim] = termMinusJac * magAxis[3 * iQuad + 1];
+                               jDim] = termMinusJac * cellMagAxisY[iQuad];
                             d_invJacderExcWithSigmaTimesMagZTimesGradRhoJxWHost
                               [iCell * numberQuadraturePoints * 3 + iQuad * 3 +
-                               jDim] = termMinusJac * magAxis[3 * iQuad + 2];
+                               jDim] = termMinusJac * cellMagAxisZ[iQuad];
                           }
                       }
                   }
-                const double scalarCoeffOne  = 1.0;
-                const double scalarCoeffZero = 0.0;
-                d_BLASWrapperPtrHost->xgemm(
-                  'T',
-                  'N',
-                  numberQuadraturePoints,
-                  1,
-                  3 * numberQuadraturePoints,
-                  &scalarCoeffOne,
-                  d_basisOperationsPtrHost
-                    ->collocationShapeFunctionGradientBasisData()
-                    .data(),
-                  3 * numberQuadraturePoints,
-                  d_invJacderExcWithSigmaTimesGradRhoJxWHost.data() +
-                    iCell * numberQuadraturePoints * 3,
-                  3 * numberQuadraturePoints,
-                  &scalarCoeffZero,
-                  d_VeffGGA.data(),
-                  numberQuadraturePoints);
-                d_BLASWrapperPtrHost->xgemm(
-                  'T',
-                  'N',
-                  numberQuadraturePoints,
-                  1,
-                  3 * numberQuadraturePoints,
-                  &scalarCoeffOne,
-                  d_basisOperationsPtrHost
-                    ->collocationShapeFunctionGradientBasisData()
-                    .data(),
-                  3 * numberQuadraturePoints,
-                  d_invJacderExcWithSigmaTimesMagXTimesGradRhoJxWHost.data() +
-                    iCell * numberQuadraturePoints * 3,
-                  3 * numberQuadraturePoints,
-                  &scalarCoeffZero,
-                  d_BeffxGGA.data(),
-                  numberQuadraturePoints);
-                d_BLASWrapperPtrHost->xgemm(
-                  'T',
-                  'N',
-                  numberQuadraturePoints,
-                  1,
-                  3 * numberQuadraturePoints,
-                  &scalarCoeffOne,
-                  d_basisOperationsPtrHost
-                    ->collocationShapeFunctionGradientBasisData()
-                    .data(),
-                  3 * numberQuadraturePoints,
-                  d_invJacderExcWithSigmaTimesMagYTimesGradRhoJxWHost.data() +
-                    iCell * numberQuadraturePoints * 3,
-                  3 * numberQuadraturePoints,
-                  &scalarCoeffZero,
-                  d_BeffyGGA.data(),
-                  numberQuadraturePoints);
-                d_BLASWrapperPtrHost->xgemm(
-                  'T',
-                  'N',
-                  numberQuadraturePoints,
-                  1,
-                  3 * numberQuadraturePoints,
-                  &scalarCoeffOne,
-                  d_basisOperationsPtrHost
-                    ->collocationShapeFunctionGradientBasisData()
-                    .data(),
-                  3 * numberQuadraturePoints,
-                  d_invJacderExcWithSigmaTimesMagZTimesGradRhoJxWHost.data() +
-                    iCell * numberQuadraturePoints * 3,
-                  3 * numberQuadraturePoints,
-                  &scalarCoeffZero,
-                  d_BeffzGGA.data(),
-                  numberQuadraturePoints);
-                for (unsigned int iQuad = 0; iQuad < numberQuadraturePoints;
-                     ++iQuad)
-                  {
-                    const double temp =
-                      magAxis[3 * iQuad + 0] * d_BeffxGGA[iQuad] +
-                      magAxis[3 * iQuad + 1] * d_BeffyGGA[iQuad] +
-                      magAxis[3 * iQuad + 2] * d_BeffzGGA[iQuad];
-                    d_VeffJxWHost[iCell * numberQuadraturePoints + iQuad] +=
-                      d_VeffGGA[iQuad];
-                    d_BeffxJxWHost[iCell * numberQuadraturePoints + iQuad] +=
-                      temp * magAxis[3 * iQuad + 0];
-                    d_BeffyJxWHost[iCell * numberQuadraturePoints + iQuad] +=
-                      temp * magAxis[3 * iQuad + 1];
-                    d_BeffzJxWHost[iCell * numberQuadraturePoints + iQuad] +=
-                      temp * magAxis[3 * iQuad + 2];
-                  }
+              }
+          }
+
+        if (isGGA && d_dftParamsPtr->noncolin)
+          {
+            // contraction with the gradients of the collocation shape
+            // functions, a single GEMM over the cells of the chunk for each
+            // of the four components
+            const double scalarCoeffOne  = 1.0;
+            const double scalarCoeffZero = 0.0;
+            double *     veffGGA         = scratch.veffGGA.data();
+            double *     beffxGGA        = veffGGA + maxChunkQuads;
+            double *     beffyGGA        = beffxGGA + maxChunkQuads;
+            double *     beffzGGA        = beffyGGA + maxChunkQuads;
+            const std::array<const double *, 4> invJacderExcTimesGradRhoJxW{
+              {d_invJacderExcWithSigmaTimesGradRhoJxWHost.data(),
+               d_invJacderExcWithSigmaTimesMagXTimesGradRhoJxWHost.data(),
+               d_invJacderExcWithSigmaTimesMagYTimesGradRhoJxWHost.data(),
+               d_invJacderExcWithSigmaTimesMagZTimesGradRhoJxWHost.data()}};
+            for (unsigned int iComp = 0; iComp < 4; ++iComp)
+              d_BLASWrapperPtrHost->xgemm(
+                'T',
+                'N',
+                numberQuadraturePoints,
+                nCellsChunk,
+                3 * numberQuadraturePoints,
+                &scalarCoeffOne,
+                d_basisOperationsPtrHost
+                  ->collocationShapeFunctionGradientBasisData()
+                  .data(),
+                3 * numberQuadraturePoints,
+                invJacderExcTimesGradRhoJxW[iComp] + 3 * quadStart,
+                3 * numberQuadraturePoints,
+                &scalarCoeffZero,
+                veffGGA + iComp * maxChunkQuads,
+                numberQuadraturePoints);
+            for (unsigned int iQuad = 0; iQuad < nChunkQuads; ++iQuad)
+              {
+                const double temp = magAxisX[iQuad] * beffxGGA[iQuad] +
+                                    magAxisY[iQuad] * beffyGGA[iQuad] +
+                                    magAxisZ[iQuad] * beffzGGA[iQuad];
+                d_VeffJxWHost[quadStart + iQuad] += veffGGA[iQuad];
+                d_BeffxJxWHost[quadStart + iQuad] += temp * magAxisX[iQuad];
+                d_BeffyJxWHost[quadStart + iQuad] += temp * magAxisY[iQuad];
+                d_BeffzJxWHost[quadStart + iQuad] += temp * magAxisZ[iQuad];
               }
           }
       }
@@ -1101,6 +1761,7 @@ namespace dftfe
   KohnShamHamiltonianOperator<memorySpace>::computeVEffExternalPotCorr(
     const std::map<dealii::CellId, std::vector<double>> &externalPotCorrValues)
   {
+    d_isKPointIndependentHamiltonianComputed = false;
     d_basisOperationsPtrHost->reinit(0, 0, d_lpspQuadratureID, false);
     const unsigned int nCells = d_basisOperationsPtrHost->nCells();
     const int nQuadsPerCell   = d_basisOperationsPtrHost->nQuadsPerCell();
@@ -1297,151 +1958,530 @@ namespace dftfe
   KohnShamHamiltonianOperator<memorySpace>::computeCellHamiltonianMatrix(
     const bool onlyHPrimePartForFirstOrderDensityMatResponse)
   {
+    if (d_dftParamsPtr->matrixFreeHamiltonian)
+      {
+        computeMatrixFreeHamiltonianQuadData(
+          onlyHPrimePartForFirstOrderDensityMatResponse);
+        return;
+      }
     if ((d_dftParamsPtr->isPseudopotential ||
          d_dftParamsPtr->smearedNuclearCharges) &&
         !onlyHPrimePartForFirstOrderDensityMatResponse)
       if (!d_isExternalPotCorrHamiltonianComputed)
         computeCellHamiltonianMatrixExtPotContribution();
-    const unsigned int nCells           = d_basisOperationsPtr->nCells();
-    const unsigned int nQuadsPerCell    = d_basisOperationsPtr->nQuadsPerCell();
-    const unsigned int nDofsPerCell     = d_basisOperationsPtr->nDofsPerCell();
-    const double       scalarCoeffAlpha = 1.0;
-    const double       scalarCoeffHalf  = 0.5;
+    const unsigned int nCells = d_basisOperationsPtr->nCells();
+    d_basisOperationsPtr->reinit(0,
+                                 d_cellsBlockSizeHamiltonianConstruction,
+                                 d_densityQuadratureID,
+                                 false,
+                                 true);
+    if (d_isSharedKPointHamiltonian &&
+        !onlyHPrimePartForFirstOrderDensityMatResponse)
+      assembleCellHamiltonianMatricesKPoints(
+        std::vector<unsigned int>(1, d_kPointIndex),
+        std::vector<unsigned int>(1, d_HamiltonianIndex));
+    else
+      for (unsigned int iCell = 0; iCell < nCells;
+           iCell += d_cellsBlockSizeHamiltonianConstruction)
+        {
+          std::pair<unsigned int, unsigned int> cellRange(
+            iCell,
+            std::min(iCell + d_cellsBlockSizeHamiltonianConstruction, nCells));
+          computeCellHamiltonianMatrixCellRange(
+            cellRange,
+            d_kPointIndex,
+            d_HamiltonianIndex,
+            onlyHPrimePartForFirstOrderDensityMatResponse,
+            tempHamMatrixRealBlock,
+            tempHamMatrixImagBlock,
+            tempHamMatrixBZBlockNonCollin,
+            tempHamMatrixBYBlockNonCollin,
+            tempHamMatrixBXBlockNonCollin);
+        }
+    if (d_dftParamsPtr->useSinglePrecCheby)
+      {
+        d_BLASWrapperPtr->copyValueType1ArrToValueType2Arr(
+          d_cellHamiltonianMatrix[d_HamiltonianIndex].size(),
+          d_cellHamiltonianMatrix[d_HamiltonianIndex].data(),
+          d_cellHamiltonianMatrixSinglePrec[d_HamiltonianIndex].data());
+        if (d_isNonCollinSpinBlockHamiltonian)
+          d_BLASWrapperPtr->copyValueType1ArrToValueType2Arr(
+            d_cellHamiltonianMatrixBZNonCollin[d_HamiltonianIndex].size(),
+            d_cellHamiltonianMatrixBZNonCollin[d_HamiltonianIndex].data(),
+            d_cellHamiltonianMatrixBZNonCollinSinglePrec[d_HamiltonianIndex]
+              .data());
+      }
+    if (d_dftParamsPtr->memOptMode)
+      if ((d_dftParamsPtr->isPseudopotential ||
+           d_dftParamsPtr->smearedNuclearCharges) &&
+          !onlyHPrimePartForFirstOrderDensityMatResponse)
+        {
+          d_cellHamiltonianMatrixExtPot.clear();
+          d_isExternalPotCorrHamiltonianComputed = false;
+        }
+  }
+
+  template <dftfe::utils::MemorySpace memorySpace>
+  void
+  KohnShamHamiltonianOperator<memorySpace>::
+    computeCellHamiltonianMatrixBatchedkPoints(const unsigned int spinIndex)
+  {
+    AssertThrow(
+      !d_dftParamsPtr->memOptMode,
+      dealii::ExcMessage(
+        "DFT-FE Error: batched construction of the cell Hamiltonian matrices of all k-points is only available with MEM OPT MODE set to false."));
+    if (d_dftParamsPtr->isPseudopotential ||
+        d_dftParamsPtr->smearedNuclearCharges)
+      if (!d_isExternalPotCorrHamiltonianComputed)
+        computeCellHamiltonianMatrixExtPotContribution();
     d_basisOperationsPtr->reinit(0,
                                  d_cellsBlockSizeHamiltonianConstruction,
                                  d_densityQuadratureID,
                                  false,
                                  true);
+
+    const unsigned int        nKPoints = d_kPointWeights.size();
+    std::vector<unsigned int> kPointIndices(nKPoints), hamiltonianIndices(
+                                                         nKPoints);
+    for (unsigned int kPointIndex = 0; kPointIndex < nKPoints; ++kPointIndex)
+      {
+        kPointIndices[kPointIndex] = kPointIndex;
+        hamiltonianIndices[kPointIndex] =
+          kPointIndex * (d_dftParamsPtr->spinPolarized + 1) + spinIndex;
+      }
+    assembleCellHamiltonianMatricesKPoints(kPointIndices, hamiltonianIndices);
+
+    if (d_dftParamsPtr->useSinglePrecCheby)
+      for (const unsigned int hamiltonianIndex : hamiltonianIndices)
+        d_BLASWrapperPtr->copyValueType1ArrToValueType2Arr(
+          d_cellHamiltonianMatrix[hamiltonianIndex].size(),
+          d_cellHamiltonianMatrix[hamiltonianIndex].data(),
+          d_cellHamiltonianMatrixSinglePrec[hamiltonianIndex].data());
+  }
+
+  template <dftfe::utils::MemorySpace memorySpace>
+  void
+  KohnShamHamiltonianOperator<
+    memorySpace>::computeCellHamiltonianMatrixKPointIndependent()
+  {
+    if (d_isKPointIndependentHamiltonianComputed)
+      return;
+    const unsigned int nCells       = d_basisOperationsPtr->nCells();
+    const unsigned int nDofsPerCell = d_basisOperationsPtr->nDofsPerCell();
     for (unsigned int iCell = 0; iCell < nCells;
          iCell += d_cellsBlockSizeHamiltonianConstruction)
       {
         std::pair<unsigned int, unsigned int> cellRange(
           iCell,
           std::min(iCell + d_cellsBlockSizeHamiltonianConstruction, nCells));
-        tempHamMatrixRealBlock.setValue(0.0);
-        if ((d_dftParamsPtr->isPseudopotential ||
-             d_dftParamsPtr->smearedNuclearCharges) &&
-            !onlyHPrimePartForFirstOrderDensityMatResponse)
-          {
-            d_BLASWrapperPtr->xcopy(nDofsPerCell * nDofsPerCell *
-                                      (cellRange.second - cellRange.first),
-                                    d_cellHamiltonianMatrixExtPot.data() +
-                                      cellRange.first * nDofsPerCell *
-                                        nDofsPerCell,
-                                    1,
-                                    tempHamMatrixRealBlock.data(),
-                                    1);
-          }
-        d_basisOperationsPtr->computeWeightedCellMassMatrix(
-          cellRange, d_VeffJxW, tempHamMatrixRealBlock);
-        if (d_dftParamsPtr->noncolin)
-          {
-            tempHamMatrixBZBlockNonCollin.setValue(0.0);
-            tempHamMatrixBYBlockNonCollin.setValue(0.0);
-            tempHamMatrixBXBlockNonCollin.setValue(0.0);
-            d_basisOperationsPtr->computeWeightedCellMassMatrix(
-              cellRange, d_BeffzJxW, tempHamMatrixBZBlockNonCollin);
-            d_basisOperationsPtr->computeWeightedCellMassMatrix(
-              cellRange, d_BeffyJxW, tempHamMatrixBYBlockNonCollin);
-            d_basisOperationsPtr->computeWeightedCellMassMatrix(
-              cellRange, d_BeffxJxW, tempHamMatrixBXBlockNonCollin);
-          }
-        else
-          {
-            if (d_excManagerPtr->getDensityBasedFamilyType() ==
-                densityFamilyType::GGA)
-              d_basisOperationsPtr
-                ->computeWeightedCellNjGradNiPlusNiGradNjMatrix(
-                  cellRange,
-                  d_invJacderExcWithSigmaTimesGradRhoJxW,
-                  tempHamMatrixRealBlock);
-          }
-        if (!onlyHPrimePartForFirstOrderDensityMatResponse)
-          d_BLASWrapperPtr->xaxpy(
-            nDofsPerCell * nDofsPerCell * (cellRange.second - cellRange.first),
-            &scalarCoeffHalf,
-            d_basisOperationsPtr->cellStiffnessMatrixBasisData().data() +
-              cellRange.first * nDofsPerCell * nDofsPerCell,
-            1,
-            tempHamMatrixRealBlock.data(),
-            1);
+        computeCellHamiltonianMatrixRealBlockCellRange(
+          cellRange,
+          false,
+          tempHamMatrixRealBlock,
+          tempHamMatrixBZBlockNonCollin,
+          tempHamMatrixBYBlockNonCollin,
+          tempHamMatrixBXBlockNonCollin);
+        d_BLASWrapperPtr->xcopy(
+          nDofsPerCell * nDofsPerCell * (cellRange.second - cellRange.first),
+          tempHamMatrixRealBlock.data(),
+          1,
+          d_cellHamiltonianMatrixKPointIndependent.data() +
+            cellRange.first * nDofsPerCell * nDofsPerCell,
+          1);
+      }
+    d_isKPointIndependentHamiltonianComputed = true;
+  }
+
+  template <dftfe::utils::MemorySpace memorySpace>
+  void
+  KohnShamHamiltonianOperator<memorySpace>::
+    assembleCellHamiltonianMatricesKPoints(
+      const std::vector<unsigned int> &kPointIndices,
+      const std::vector<unsigned int> &hamiltonianIndices)
+  {
+    computeCellHamiltonianMatrixKPointIndependent();
+
+    const unsigned int nCells       = d_basisOperationsPtr->nCells();
+    const unsigned int nDofsPerCell = d_basisOperationsPtr->nDofsPerCell();
+    const unsigned int nKPoints     = kPointIndices.size();
+
+    // coefficients of the k-point dependent terms with the k-points as
+    // columns: 1 and |k|^2/2 for H_0 and M, k_x, k_y and k_z for the G_d
+    std::vector<double> realCoeffsHost(2 * nKPoints),
+      imagCoeffsHost(3 * nKPoints);
+    for (unsigned int iKPoint = 0; iKPoint < nKPoints; ++iKPoint)
+      {
+        const double *kPointCoors =
+          d_kPointCoordinates.data() + 3 * kPointIndices[iKPoint];
+        realCoeffsHost[2 * iKPoint + 0] = 1.0;
+        realCoeffsHost[2 * iKPoint + 1] =
+          0.5 * (kPointCoors[0] * kPointCoors[0] +
+                 kPointCoors[1] * kPointCoors[1] +
+                 kPointCoors[2] * kPointCoors[2]);
+        for (unsigned int iDim = 0; iDim < 3; ++iDim)
+          imagCoeffsHost[3 * iKPoint + iDim] = kPointCoors[iDim];
+      }
+    dftfe::utils::MemoryStorage<double, memorySpace> realCoeffs(
+      realCoeffsHost.size()),
+      imagCoeffs(imagCoeffsHost.size());
+    dftfe::utils::MemoryTransfer<memorySpace, dftfe::utils::MemorySpace::HOST>::
+      copy(realCoeffsHost.size(), realCoeffs.data(), realCoeffsHost.data());
+    dftfe::utils::MemoryTransfer<memorySpace, dftfe::utils::MemorySpace::HOST>::
+      copy(imagCoeffsHost.size(), imagCoeffs.data(), imagCoeffsHost.data());
+
+    if (d_tempHamMatrixRealBlockKPoints.size() <
+        nDofsPerCell * nDofsPerCell * d_cellsBlockSizeHamiltonianConstruction *
+          nKPoints)
+      {
+        d_tempHamMatrixRealBlockKPoints.resize(
+          nDofsPerCell * nDofsPerCell *
+          d_cellsBlockSizeHamiltonianConstruction * nKPoints);
+        d_tempHamMatrixImagBlockKPoints.resize(
+          nDofsPerCell * nDofsPerCell *
+          d_cellsBlockSizeHamiltonianConstruction * nKPoints);
+      }
+
+    const double scalarCoeffOne = 1.0, scalarCoeffZero = 0.0;
+    for (unsigned int iCell = 0; iCell < nCells;
+         iCell += d_cellsBlockSizeHamiltonianConstruction)
+      {
+        std::pair<unsigned int, unsigned int> cellRange(
+          iCell,
+          std::min(iCell + d_cellsBlockSizeHamiltonianConstruction, nCells));
+        const unsigned int blockSize =
+          nDofsPerCell * nDofsPerCell * (cellRange.second - cellRange.first);
+        const unsigned int blockOffset =
+          cellRange.first * nDofsPerCell * nDofsPerCell;
+
+        // real parts H_0+|k|^2/2 M of all the k-points
+        d_BLASWrapperPtr->xgemm(
+          'N',
+          'N',
+          blockSize,
+          nKPoints,
+          1,
+          &scalarCoeffOne,
+          d_cellHamiltonianMatrixKPointIndependent.data() + blockOffset,
+          blockSize,
+          realCoeffs.data(),
+          2,
+          &scalarCoeffZero,
+          d_tempHamMatrixRealBlockKPoints.data(),
+          blockSize);
+        d_BLASWrapperPtr->xgemm(
+          'N',
+          'N',
+          blockSize,
+          nKPoints,
+          1,
+          &scalarCoeffOne,
+          d_basisOperationsPtr->cellMassMatrixBasisData().data() + blockOffset,
+          blockSize,
+          realCoeffs.data() + 1,
+          2,
+          &scalarCoeffOne,
+          d_tempHamMatrixRealBlockKPoints.data(),
+          blockSize);
+
+        // imaginary parts sum_d k_d G_d of all the k-points, the G_d of the
+        // cell block are columns with a leading dimension of all the cells
+        d_BLASWrapperPtr->xgemm('N',
+                                'N',
+                                blockSize,
+                                nKPoints,
+                                3,
+                                &scalarCoeffOne,
+                                d_cellNjGradNiMatrixKPointDirections.data() +
+                                  blockOffset,
+                                nCells * nDofsPerCell * nDofsPerCell,
+                                imagCoeffs.data(),
+                                3,
+                                &scalarCoeffZero,
+                                d_tempHamMatrixImagBlockKPoints.data(),
+                                blockSize);
 
         if constexpr (std::is_same<dataTypes::number,
                                    std::complex<double>>::value)
+          for (unsigned int iKPoint = 0; iKPoint < nKPoints; ++iKPoint)
+            d_BLASWrapperPtr->copyRealArrsToComplexArr(
+              blockSize,
+              d_tempHamMatrixRealBlockKPoints.data() + iKPoint * blockSize,
+              d_tempHamMatrixImagBlockKPoints.data() + iKPoint * blockSize,
+              d_cellHamiltonianMatrix[hamiltonianIndices[iKPoint]].data() +
+                blockOffset);
+      }
+  }
+
+  template <dftfe::utils::MemorySpace memorySpace>
+  void
+  KohnShamHamiltonianOperator<memorySpace>::
+    computeCellHamiltonianMatrixRealBlockCellRange(
+      const std::pair<unsigned int, unsigned int> cellRange,
+      const bool onlyHPrimePartForFirstOrderDensityMatResponse,
+      dftfe::utils::MemoryStorage<double, memorySpace> &tempRealBlock,
+      dftfe::utils::MemoryStorage<double, memorySpace> &tempBZBlock,
+      dftfe::utils::MemoryStorage<double, memorySpace> &tempBYBlock,
+      dftfe::utils::MemoryStorage<double, memorySpace> &tempBXBlock)
+  {
+    const unsigned int nDofsPerCell    = d_basisOperationsPtr->nDofsPerCell();
+    const double       scalarCoeffHalf = 0.5;
+    tempRealBlock.setValue(0.0);
+    if ((d_dftParamsPtr->isPseudopotential ||
+         d_dftParamsPtr->smearedNuclearCharges) &&
+        !onlyHPrimePartForFirstOrderDensityMatResponse)
+      {
+        d_BLASWrapperPtr->xcopy(nDofsPerCell * nDofsPerCell *
+                                  (cellRange.second - cellRange.first),
+                                d_cellHamiltonianMatrixExtPot.data() +
+                                  cellRange.first * nDofsPerCell *
+                                    nDofsPerCell,
+                                1,
+                                tempRealBlock.data(),
+                                1);
+      }
+    d_basisOperationsPtr->computeWeightedCellMassMatrix(cellRange,
+                                                        d_VeffJxW,
+                                                        tempRealBlock);
+    if (d_dftParamsPtr->noncolin)
+      {
+        tempBZBlock.setValue(0.0);
+        tempBYBlock.setValue(0.0);
+        tempBXBlock.setValue(0.0);
+        d_basisOperationsPtr->computeWeightedCellMassMatrix(cellRange,
+                                                            d_BeffzJxW,
+                                                            tempBZBlock);
+        d_basisOperationsPtr->computeWeightedCellMassMatrix(cellRange,
+                                                            d_BeffyJxW,
+                                                            tempBYBlock);
+        d_basisOperationsPtr->computeWeightedCellMassMatrix(cellRange,
+                                                            d_BeffxJxW,
+                                                            tempBXBlock);
+      }
+    else
+      {
+        if (d_excManagerPtr->getDensityBasedFamilyType() ==
+            densityFamilyType::GGA)
+          d_basisOperationsPtr->computeWeightedCellNjGradNiPlusNiGradNjMatrix(
+            cellRange,
+            d_invJacderExcWithSigmaTimesGradRhoJxW,
+            tempRealBlock);
+      }
+    if (!onlyHPrimePartForFirstOrderDensityMatResponse)
+      d_BLASWrapperPtr->xaxpy(
+        nDofsPerCell * nDofsPerCell * (cellRange.second - cellRange.first),
+        &scalarCoeffHalf,
+        d_basisOperationsPtr->cellStiffnessMatrixBasisData().data() +
+          cellRange.first * nDofsPerCell * nDofsPerCell,
+        1,
+        tempRealBlock.data(),
+        1);
+  }
+
+  template <dftfe::utils::MemorySpace memorySpace>
+  void
+  KohnShamHamiltonianOperator<memorySpace>::
+    computeCellHamiltonianMatrixCellRange(
+      const std::pair<unsigned int, unsigned int> cellRange,
+      const unsigned int                          kPointIndex,
+      const unsigned int                          hamiltonianIndex,
+      const bool onlyHPrimePartForFirstOrderDensityMatResponse,
+      dftfe::utils::MemoryStorage<double, memorySpace> &tempRealBlock,
+      dftfe::utils::MemoryStorage<double, memorySpace> &tempImagBlock,
+      dftfe::utils::MemoryStorage<double, memorySpace> &tempBZBlock,
+      dftfe::utils::MemoryStorage<double, memorySpace> &tempBYBlock,
+      dftfe::utils::MemoryStorage<double, memorySpace> &tempBXBlock)
+  {
+    const unsigned int nDofsPerCell = d_basisOperationsPtr->nDofsPerCell();
+    computeCellHamiltonianMatrixRealBlockCellRange(
+      cellRange,
+      onlyHPrimePartForFirstOrderDensityMatResponse,
+      tempRealBlock,
+      tempBZBlock,
+      tempBYBlock,
+      tempBXBlock);
+
+    if constexpr (std::is_same<dataTypes::number, std::complex<double>>::value)
+      {
+        tempImagBlock.setValue(0.0);
+        if (!onlyHPrimePartForFirstOrderDensityMatResponse)
           {
-            tempHamMatrixImagBlock.setValue(0.0);
-            if (!onlyHPrimePartForFirstOrderDensityMatResponse)
-              {
-                const double *kPointCoors =
-                  d_kPointCoordinates.data() + 3 * d_kPointIndex;
-                const double kSquareTimesHalf =
-                  0.5 * (kPointCoors[0] * kPointCoors[0] +
-                         kPointCoors[1] * kPointCoors[1] +
-                         kPointCoors[2] * kPointCoors[2]);
-                if (kSquareTimesHalf > 1e-12)
-                  {
-                    d_BLASWrapperPtr->xaxpy(
-                      nDofsPerCell * nDofsPerCell *
-                        (cellRange.second - cellRange.first),
-                      &kSquareTimesHalf,
-                      d_basisOperationsPtr->cellMassMatrixBasisData().data() +
-                        cellRange.first * nDofsPerCell * nDofsPerCell,
-                      1,
-                      tempHamMatrixRealBlock.data(),
-                      1);
-                    d_basisOperationsPtr->computeWeightedCellNjGradNiMatrix(
-                      cellRange,
-                      d_invJacKPointTimesJxW[d_kPointIndex],
-                      tempHamMatrixImagBlock);
-                  }
-              }
-            if (!d_dftParamsPtr->noncolin)
-              d_BLASWrapperPtr->copyRealArrsToComplexArr(
-                nDofsPerCell * nDofsPerCell *
-                  (cellRange.second - cellRange.first),
-                tempHamMatrixRealBlock.data(),
-                tempHamMatrixImagBlock.data(),
-                d_cellHamiltonianMatrix[d_HamiltonianIndex].data() +
-                  cellRange.first * nDofsPerCell * nDofsPerCell);
-            else
+            const double *kPointCoors =
+              d_kPointCoordinates.data() + 3 * kPointIndex;
+            const double kSquareTimesHalf =
+              0.5 * (kPointCoors[0] * kPointCoors[0] +
+                     kPointCoors[1] * kPointCoors[1] +
+                     kPointCoors[2] * kPointCoors[2]);
+            if (kSquareTimesHalf > 1e-12)
               {
-                internal::computeCellHamiltonianMatrixNonCollinearFromBlocks(
+                d_BLASWrapperPtr->xaxpy(
+                  nDofsPerCell * nDofsPerCell *
+                    (cellRange.second - cellRange.first),
+                  &kSquareTimesHalf,
+                  d_basisOperationsPtr->cellMassMatrixBasisData().data() +
+                    cellRange.first * nDofsPerCell * nDofsPerCell,
+                  1,
+                  tempRealBlock.data(),
+                  1);
+                d_basisOperationsPtr->computeWeightedCellNjGradNiMatrix(
                   cellRange,
-                  nDofsPerCell,
-                  tempHamMatrixRealBlock,
-                  tempHamMatrixImagBlock,
-                  tempHamMatrixBZBlockNonCollin,
-                  tempHamMatrixBYBlockNonCollin,
-                  tempHamMatrixBXBlockNonCollin,
-                  d_cellHamiltonianMatrix[d_HamiltonianIndex]);
+                  d_invJacKPointTimesJxW[kPointIndex],
+                  tempImagBlock);
               }
           }
-        else
+        if (!d_dftParamsPtr->noncolin)
+          d_BLASWrapperPtr->copyRealArrsToComplexArr(
+            nDofsPerCell * nDofsPerCell * (cellRange.second - cellRange.first),
+            tempRealBlock.data(),
+            tempImagBlock.data(),
+            d_cellHamiltonianMatrix[hamiltonianIndex].data() +
+              cellRange.first * nDofsPerCell * nDofsPerCell);
+        else if (d_isNonCollinSpinBlockHamiltonian)
           {
+            // spin diagonal blocks of all the cells followed by the Bx+iBy
+            // blocks of all the cells. The real and imaginary parts are fused
+            // into complex blocks instead of keeping the real
+            // tempHamMatrixRealBlock/ImagBlock and Bx/By blocks separately:
+            // the storage is the same 5N^2 doubles per cell, while applying
+            // a separate imaginary block to complex wavefunctions needs an
+            // extra pass over the cell wavefunction block to multiply the
+            // result by i, and the coupling blocks would take two gemms
+            // instead of one
+            d_BLASWrapperPtr->copyRealArrsToComplexArr(
+              nDofsPerCell * nDofsPerCell * (cellRange.second - cellRange.first),
+              tempRealBlock.data(),
+              tempImagBlock.data(),
+              d_cellHamiltonianMatrix[hamiltonianIndex].data() +
+                cellRange.first * nDofsPerCell * nDofsPerCell);
+            d_BLASWrapperPtr->copyRealArrsToComplexArr(
+              nDofsPerCell * nDofsPerCell * (cellRange.second - cellRange.first),
+              tempBXBlock.data(),
+              tempBYBlock.data(),
+              d_cellHamiltonianMatrix[hamiltonianIndex].data() +
+                (d_basisOperationsPtr->nCells() + cellRange.first) *
+                  nDofsPerCell * nDofsPerCell);
             d_BLASWrapperPtr->xcopy(
-              nDofsPerCell * nDofsPerCell *
-                (cellRange.second - cellRange.first),
-              tempHamMatrixRealBlock.data(),
+              nDofsPerCell * nDofsPerCell * (cellRange.second - cellRange.first),
+              tempBZBlock.data(),
               1,
-              d_cellHamiltonianMatrix[d_HamiltonianIndex].data() +
+              d_cellHamiltonianMatrixBZNonCollin[hamiltonianIndex].data() +
                 cellRange.first * nDofsPerCell * nDofsPerCell,
               1);
           }
+        else
+          {
+            internal::computeCellHamiltonianMatrixNonCollinearFromBlocks(
+              cellRange,
+              nDofsPerCell,
+              tempRealBlock,
+              tempImagBlock,
+              tempBZBlock,
+              tempBYBlock,
+              tempBXBlock,
+              d_cellHamiltonianMatrix[hamiltonianIndex]);
+          }
       }
-    if (d_dftParamsPtr->useSinglePrecCheby)
-      d_BLASWrapperPtr->copyValueType1ArrToValueType2Arr(
-        d_cellHamiltonianMatrix[d_HamiltonianIndex].size(),
-        d_cellHamiltonianMatrix[d_HamiltonianIndex].data(),
-        d_cellHamiltonianMatrixSinglePrec[d_HamiltonianIndex].data());
-    if (d_dftParamsPtr->memOptMode)
-      if ((d_dftParamsPtr->isPseudopotential ||
-           d_dftParamsPtr->smearedNuclearCharges) &&
-          !onlyHPrimePartForFirstOrderDensityMatResponse)
-        {
-          d_cellHamiltonianMatrixExtPot.clear();
-          d_isExternalPotCorrHamiltonianComputed = false;
-        }
+    else
+      {
+        d_BLASWrapperPtr->xcopy(
+          nDofsPerCell * nDofsPerCell * (cellRange.second - cellRange.first),
+          tempRealBlock.data(),
+          1,
+          d_cellHamiltonianMatrix[hamiltonianIndex].data() +
+            cellRange.first * nDofsPerCell * nDofsPerCell,
+          1);
+      }
+  }
+  template <dftfe::utils::MemorySpace memorySpace>
+  template <typename ValueType, typename RealType>
+  void
+  KohnShamHamiltonianOperator<memorySpace>::
+    applyNonCollinearSpinBlockHamiltonian(
+      const std::pair<unsigned int, unsigned int> cellRange,
+      const unsigned int                          numberWavefunctions,
+      const RealType                              scalarHX,
+      const ValueType *                           cellHamiltonianMatrix,
+      const RealType *                            cellHamiltonianMatrixBZ,
+      const ValueType *                           src,
+      ValueType *                                 dst)
+  {
+    const unsigned int numCells       = d_basisOperationsPtr->nCells();
+    const unsigned int numDoFsPerCell = d_basisOperationsPtr->nDofsPerCell();
+    const unsigned int numCellsInRange = cellRange.second - cellRange.first;
+    const unsigned int complexFactor   = sizeof(ValueType) / sizeof(RealType);
+    const ValueType    scalarCoeffAlpha = ValueType(scalarHX),
+                    scalarCoeffBeta             = ValueType(0.0),
+                    scalarCoeffOne              = ValueType(1.0);
+    const RealType scalarCoeffAlphaUp = scalarHX,
+                   scalarCoeffAlphaDown = -scalarHX, scalarCoeffOneReal = 1.0;
+    // the up and down components of a dof are contiguous, so the spin
+    // diagonal block acts on both components with one multiplication
+    d_BLASWrapperPtr->xgemmStridedBatched(
+      'N',
+      'N',
+      2 * numberWavefunctions,
+      numDoFsPerCell,
+      numDoFsPerCell,
+      &scalarCoeffAlpha,
+      src,
+      2 * numberWavefunctions,
+      numDoFsPerCell * 2 * numberWavefunctions,
+      cellHamiltonianMatrix + cellRange.first * numDoFsPerCell * numDoFsPerCell,
+      numDoFsPerCell,
+      numDoFsPerCell * numDoFsPerCell,
+      &scalarCoeffBeta,
+      dst,
+      2 * numberWavefunctions,
+      numDoFsPerCell * 2 * numberWavefunctions,
+      numCellsInRange);
+    // +Bz on the up and -Bz on the down component, the real block acts on the
+    // real and imaginary parts alike
+    for (unsigned int iSpinor = 0; iSpinor < 2; ++iSpinor)
+      d_BLASWrapperPtr->xgemmStridedBatched(
+        'N',
+        'N',
+        complexFactor * numberWavefunctions,
+        numDoFsPerCell,
+        numDoFsPerCell,
+        iSpinor == 0 ? &scalarCoeffAlphaUp : &scalarCoeffAlphaDown,
+        reinterpret_cast<const RealType *>(src) +
+          iSpinor * complexFactor * numberWavefunctions,
+        complexFactor * 2 * numberWavefunctions,
+        numDoFsPerCell * complexFactor * 2 * numberWavefunctions,
+        cellHamiltonianMatrixBZ +
+          cellRange.first * numDoFsPerCell * numDoFsPerCell,
+        numDoFsPerCell,
+        numDoFsPerCell * numDoFsPerCell,
+        &scalarCoeffOneReal,
+        reinterpret_cast<RealType *>(dst) +
+          iSpinor * complexFactor * numberWavefunctions,
+        complexFactor * 2 * numberWavefunctions,
+        numDoFsPerCell * complexFactor * 2 * numberWavefunctions,
+        numCellsInRange);
+    // (Bx+iBy) couples up to down and its conjugate down to up, the mass
+    // weighted blocks are symmetric so the conjugate is the conjugate
+    // transpose
+    for (unsigned int iSpinor = 0; iSpinor < 2; ++iSpinor)
+      d_BLASWrapperPtr->xgemmStridedBatched(
+        'N',
+        iSpinor == 0 ? 'N' : 'C',
+        numberWavefunctions,
+        numDoFsPerCell,
+        numDoFsPerCell,
+        &scalarCoeffAlpha,
+        src + iSpinor * numberWavefunctions,
+        2 * numberWavefunctions,
+        numDoFsPerCell * 2 * numberWavefunctions,
+        cellHamiltonianMatrix +
+          (numCells + cellRange.first) * numDoFsPerCell * numDoFsPerCell,
+        numDoFsPerCell,
+        numDoFsPerCell * numDoFsPerCell,
+        &scalarCoeffOne,
+        dst + (1 - iSpinor) * numberWavefunctions,
+        2 * numberWavefunctions,
+        numDoFsPerCell * 2 * numberWavefunctions,
+        numCellsInRange);
   }
+
   template <dftfe::utils::MemorySpace memorySpace>
   void
   KohnShamHamiltonianOperator<memorySpace>::HX(
@@ -1483,7 +2523,7 @@ namespace dftfe
       (d_ONCVnonLocalOperator->getTotalNonLocalElementsInCurrentProcessor() >
        0) &&
       !onlyHPrimePartForFirstOrderDensityMatResponse;
-// #pragma omp parallel for num_threads(d_nOMPThreads)
+#pragma omp parallel for num_threads(d_nOMPThreads) if (d_nOMPThreads > 1)
     for (unsigned int iCell = 0; iCell < numCells; iCell += d_cellsBlockSizeHX)
       {
         std::pair<unsigned int, unsigned int> cellRange(
@@ -1498,14 +2538,21 @@ namespace dftfe
           d_basisOperationsPtr->d_flattenedCellDofIndexToProcessDofIndexMap
               .data() +
             cellRange.first * numDoFsPerCell);
-// #pragma omp critical(hx_Cconj)
-        if (hasNonlocalComponents)
+      }
+    // each cell block writes only its own rows of the cell major C^{\dagger}X
+    if (hasNonlocalComponents)
+#pragma omp parallel for num_threads(d_nOMPThreads) if (d_nOMPThreads > 1)
+      for (unsigned int iCell = 0; iCell < numCells;
+           iCell += d_cellsBlockSizeHX)
+        {
+          std::pair<unsigned int, unsigned int> cellRange(
+            iCell, std::min(iCell + d_cellsBlockSizeHX, numCells));
           d_ONCVnonLocalOperator->applyCconjtransOnX(
             d_cellWaveFunctionMatrixSrc.data() +
               cellRange.first * numDoFsPerCell * numberWavefunctions *
                 spinorFactor,
             cellRange);
-      }
+        }
     if (d_dftParamsPtr->isPseudopotential &&
         !onlyHPrimePartForFirstOrderDensityMatResponse)
       {
@@ -1519,53 +2566,81 @@ namespace dftfe
           d_ONCVNonLocalProjectorTimesVectorBlock,
           true);
       }
-// #pragma omp parallel for num_threads(d_nOMPThreads)
-    for (unsigned int iCell = 0; iCell < numCells; iCell += d_cellsBlockSizeHX)
+    for (const auto &cellBlocksInColor : d_cellBlockColors)
       {
-        std::pair<unsigned int, unsigned int> cellRange(
-          iCell, std::min(iCell + d_cellsBlockSizeHX, numCells));
-
-        d_BLASWrapperPtr->xgemmStridedBatched(
-          'N',
-          'N',
-          numberWavefunctions,
-          numDoFsPerCell * spinorFactor,
-          numDoFsPerCell * spinorFactor,
-          &scalarCoeffAlpha,
-          d_cellWaveFunctionMatrixSrc.data() +
-            cellRange.first * numDoFsPerCell * numberWavefunctions *
-              spinorFactor,
-          numberWavefunctions,
-          numDoFsPerCell * spinorFactor * numberWavefunctions,
-          d_cellHamiltonianMatrix[d_HamiltonianIndex].data() +
-            cellRange.first * numDoFsPerCell * numDoFsPerCell * spinorFactor *
-              spinorFactor,
-          numDoFsPerCell * spinorFactor,
-          numDoFsPerCell * spinorFactor * numDoFsPerCell * spinorFactor,
-          &scalarCoeffBeta,
-          d_cellWaveFunctionMatrixDst.data() +
-            omp_get_thread_num() * d_cellsBlockSizeHX * numDoFsPerCell *
-              spinorFactor * numberWavefunctions,
-          numberWavefunctions,
-          numDoFsPerCell * spinorFactor * numberWavefunctions,
-          cellRange.second - cellRange.first);
-        if (hasNonlocalComponents)
-          d_ONCVnonLocalOperator->applyCOnVCconjtransX(
-            d_cellWaveFunctionMatrixDst.data() +
+#pragma omp parallel for num_threads(d_nOMPThreads) if (d_nOMPThreads > 1)
+        for (unsigned int iBlock = 0; iBlock < cellBlocksInColor.size();
+             ++iBlock)
+          {
+            const unsigned int iCell = cellBlocksInColor[iBlock];
+            std::pair<unsigned int, unsigned int> cellRange(
+              iCell, std::min(iCell + d_cellsBlockSizeHX, numCells));
+            dataTypes::number *cellWaveFunctionMatrixDstThread =
+              d_cellWaveFunctionMatrixDst.data() +
               omp_get_thread_num() * d_cellsBlockSizeHX * numDoFsPerCell *
-                spinorFactor * numberWavefunctions,
-            cellRange);
-// #pragma omp critical(hx_assembly)
-        d_BLASWrapperPtr->axpyStridedBlockAtomicAdd(
-          numberWavefunctions * spinorFactor,
-          numDoFsPerCell * (cellRange.second - cellRange.first),
-          d_cellWaveFunctionMatrixDst.data() +
-            omp_get_thread_num() * d_cellsBlockSizeHX * numDoFsPerCell *
-              spinorFactor * numberWavefunctions,
-          dst.data(),
-          d_basisOperationsPtr->d_flattenedCellDofIndexToProcessDofIndexMap
-              .data() +
-            cellRange.first * numDoFsPerCell);
+                spinorFactor * numberWavefunctions;
+
+            if (d_dftParamsPtr->matrixFreeHamiltonian)
+              for (unsigned int jCell = cellRange.first;
+                   jCell < cellRange.second;
+                   ++jCell)
+                applyMatrixFreeHamiltonianCell(
+                  jCell,
+                  numberWavefunctions,
+                  scalarHX,
+                  d_cellWaveFunctionMatrixSrc.data() +
+                    jCell * numDoFsPerCell * numberWavefunctions *
+                      spinorFactor,
+                  cellWaveFunctionMatrixDstThread +
+                    (jCell - cellRange.first) * numDoFsPerCell *
+                      numberWavefunctions * spinorFactor);
+            else if (d_isNonCollinSpinBlockHamiltonian)
+              applyNonCollinearSpinBlockHamiltonian(
+                cellRange,
+                numberWavefunctions,
+                scalarHX,
+                d_cellHamiltonianMatrix[d_HamiltonianIndex].data(),
+                d_cellHamiltonianMatrixBZNonCollin[d_HamiltonianIndex].data(),
+                d_cellWaveFunctionMatrixSrc.data() +
+                  cellRange.first * numDoFsPerCell * numberWavefunctions *
+                    spinorFactor,
+                cellWaveFunctionMatrixDstThread);
+            else
+              d_BLASWrapperPtr->xgemmStridedBatched(
+                'N',
+                'N',
+                numberWavefunctions,
+                numDoFsPerCell * spinorFactor,
+                numDoFsPerCell * spinorFactor,
+                &scalarCoeffAlpha,
+                d_cellWaveFunctionMatrixSrc.data() +
+                  cellRange.first * numDoFsPerCell * numberWavefunctions *
+                    spinorFactor,
+                numberWavefunctions,
+                numDoFsPerCell * spinorFactor * numberWavefunctions,
+                d_cellHamiltonianMatrix[d_HamiltonianIndex].data() +
+                  cellRange.first * numDoFsPerCell * numDoFsPerCell *
+                    spinorFactor * spinorFactor,
+                numDoFsPerCell * spinorFactor,
+                numDoFsPerCell * spinorFactor * numDoFsPerCell * spinorFactor,
+                &scalarCoeffBeta,
+                cellWaveFunctionMatrixDstThread,
+                numberWavefunctions,
+                numDoFsPerCell * spinorFactor * numberWavefunctions,
+                cellRange.second - cellRange.first);
+            if (hasNonlocalComponents)
+              d_ONCVnonLocalOperator->applyCOnVCconjtransX(
+                cellWaveFunctionMatrixDstThread, cellRange);
+            // cell blocks of the same colour do not share dofs
+            d_BLASWrapperPtr->axpyStridedBlockAtomicAdd(
+              numberWavefunctions * spinorFactor,
+              numDoFsPerCell * (cellRange.second - cellRange.first),
+              cellWaveFunctionMatrixDstThread,
+              dst.data(),
+              d_basisOperationsPtr->d_flattenedCellDofIndexToProcessDofIndexMap
+                  .data() +
+                cellRange.first * numDoFsPerCell);
+          }
       }
 
     d_basisOperationsPtr->d_constraintInfo[d_basisOperationsPtr->d_dofHandlerID]
@@ -1726,7 +2801,7 @@ namespace dftfe
         if constexpr (memorySpace == dftfe::utils::MemorySpace::HOST)
           if (d_dftParamsPtr->isPseudopotential)
             d_ONCVnonLocalOperator->initialiseOperatorActionOnX(d_kPointIndex);
-// #pragma omp parallel for num_threads(d_nOMPThreads)
+#pragma omp parallel for num_threads(d_nOMPThreads) if (d_nOMPThreads > 1)
         for (unsigned int iCell = 0; iCell < numCells;
              iCell += d_cellsBlockSizeHX)
           {
@@ -1742,14 +2817,20 @@ namespace dftfe
               d_basisOperationsPtr->d_flattenedCellDofIndexToProcessDofIndexMap
                   .data() +
                 cellRange.first * numDoFsPerCell);
-// #pragma omp critical(hxc_Cconj)
-            if (hasNonlocalComponents)
+          }
+        if (hasNonlocalComponents)
+#pragma omp parallel for num_threads(d_nOMPThreads) if (d_nOMPThreads > 1)
+          for (unsigned int iCell = 0; iCell < numCells;
+               iCell += d_cellsBlockSizeHX)
+            {
+              std::pair<unsigned int, unsigned int> cellRange(
+                iCell, std::min(iCell + d_cellsBlockSizeHX, numCells));
               d_ONCVnonLocalOperator->applyCconjtransOnX(
                 d_cellWaveFunctionMatrixSrc.data() +
                   cellRange.first * numDoFsPerCell * numberWavefunctions *
                     spinorFactor,
                 cellRange);
-          }
+            }
       }
     if (!skip2)
       {
@@ -1790,56 +2871,86 @@ namespace dftfe
       }
     if (!skip3)
       {
-// #pragma omp parallel for num_threads(d_nOMPThreads)
-        for (unsigned int iCell = 0; iCell < numCells;
-             iCell += d_cellsBlockSizeHX)
+        for (const auto &cellBlocksInColor : d_cellBlockColors)
           {
-            std::pair<unsigned int, unsigned int> cellRange(
-              iCell, std::min(iCell + d_cellsBlockSizeHX, numCells));
-
-            d_BLASWrapperPtr->xgemmStridedBatched(
-              'N',
-              'N',
-              numberWavefunctions,
-              numDoFsPerCell * spinorFactor,
-              numDoFsPerCell * spinorFactor,
-              &scalarCoeffAlpha,
-              d_cellWaveFunctionMatrixSrc.data() +
-                cellRange.first * numDoFsPerCell * spinorFactor *
-                  numberWavefunctions,
-              numberWavefunctions,
-              numDoFsPerCell * spinorFactor * numberWavefunctions,
-              d_cellHamiltonianMatrix[d_HamiltonianIndex].data() +
-                cellRange.first * numDoFsPerCell * spinorFactor *
-                  numDoFsPerCell * spinorFactor,
-              numDoFsPerCell * spinorFactor,
-              numDoFsPerCell * spinorFactor * numDoFsPerCell * spinorFactor,
-              &scalarCoeffBeta,
-              d_cellWaveFunctionMatrixDst.data() +
-                omp_get_thread_num() * d_cellsBlockSizeHX * numDoFsPerCell *
-                  spinorFactor * numberWavefunctions,
-              numberWavefunctions,
-              numDoFsPerCell * spinorFactor * numberWavefunctions,
-              cellRange.second - cellRange.first);
-            if (hasNonlocalComponents)
-              d_ONCVnonLocalOperator->applyCOnVCconjtransX(
-                d_cellWaveFunctionMatrixDst.data() +
+#pragma omp parallel for num_threads(d_nOMPThreads) if (d_nOMPThreads > 1)
+            for (unsigned int iBlock = 0; iBlock < cellBlocksInColor.size();
+                 ++iBlock)
+              {
+                const unsigned int iCell = cellBlocksInColor[iBlock];
+                std::pair<unsigned int, unsigned int> cellRange(
+                  iCell, std::min(iCell + d_cellsBlockSizeHX, numCells));
+                dataTypes::number *cellWaveFunctionMatrixDstThread =
+                  d_cellWaveFunctionMatrixDst.data() +
                   omp_get_thread_num() * d_cellsBlockSizeHX * numDoFsPerCell *
-                    spinorFactor * numberWavefunctions,
-                cellRange);
-            d_BLASWrapperPtr->axpyStridedBlockAtomicAdd(
-              numberWavefunctions * spinorFactor,
-              numDoFsPerCell * (cellRange.second - cellRange.first),
-              scalarHX,
-              d_basisOperationsPtr->cellInverseMassVectorBasisData().data() +
-                cellRange.first * numDoFsPerCell,
-              d_cellWaveFunctionMatrixDst.data() +
-                omp_get_thread_num() * d_cellsBlockSizeHX * numDoFsPerCell *
-                  spinorFactor * numberWavefunctions,
-              dst.data(),
-              d_basisOperationsPtr->d_flattenedCellDofIndexToProcessDofIndexMap
-                  .data() +
-                cellRange.first * numDoFsPerCell);
+                    spinorFactor * numberWavefunctions;
+
+                if (d_dftParamsPtr->matrixFreeHamiltonian)
+                  for (unsigned int jCell = cellRange.first;
+                       jCell < cellRange.second;
+                       ++jCell)
+                    applyMatrixFreeHamiltonianCell(
+                      jCell,
+                      numberWavefunctions,
+                      1.0,
+                      d_cellWaveFunctionMatrixSrc.data() +
+                        jCell * numDoFsPerCell * spinorFactor *
+                          numberWavefunctions,
+                      cellWaveFunctionMatrixDstThread +
+                        (jCell - cellRange.first) * numDoFsPerCell *
+                          spinorFactor * numberWavefunctions);
+                else if (d_isNonCollinSpinBlockHamiltonian)
+                  applyNonCollinearSpinBlockHamiltonian(
+                    cellRange,
+                    numberWavefunctions,
+                    1.0,
+                    d_cellHamiltonianMatrix[d_HamiltonianIndex].data(),
+                    d_cellHamiltonianMatrixBZNonCollin[d_HamiltonianIndex]
+                      .data(),
+                    d_cellWaveFunctionMatrixSrc.data() +
+                      cellRange.first * numDoFsPerCell * spinorFactor *
+                        numberWavefunctions,
+                    cellWaveFunctionMatrixDstThread);
+                else
+                  d_BLASWrapperPtr->xgemmStridedBatched(
+                    'N',
+                    'N',
+                    numberWavefunctions,
+                    numDoFsPerCell * spinorFactor,
+                    numDoFsPerCell * spinorFactor,
+                    &scalarCoeffAlpha,
+                    d_cellWaveFunctionMatrixSrc.data() +
+                      cellRange.first * numDoFsPerCell * spinorFactor *
+                        numberWavefunctions,
+                    numberWavefunctions,
+                    numDoFsPerCell * spinorFactor * numberWavefunctions,
+                    d_cellHamiltonianMatrix[d_HamiltonianIndex].data() +
+                      cellRange.first * numDoFsPerCell * spinorFactor *
+                        numDoFsPerCell * spinorFactor,
+                    numDoFsPerCell * spinorFactor,
+                    numDoFsPerCell * spinorFactor * numDoFsPerCell *
+                      spinorFactor,
+                    &scalarCoeffBeta,
+                    cellWaveFunctionMatrixDstThread,
+                    numberWavefunctions,
+                    numDoFsPerCell * spinorFactor * numberWavefunctions,
+                    cellRange.second - cellRange.first);
+                if (hasNonlocalComponents)
+                  d_ONCVnonLocalOperator->applyCOnVCconjtransX(
+                    cellWaveFunctionMatrixDstThread, cellRange);
+                d_BLASWrapperPtr->axpyStridedBlockAtomicAdd(
+                  numberWavefunctions * spinorFactor,
+                  numDoFsPerCell * (cellRange.second - cellRange.first),
+                  scalarHX,
+                  d_basisOperationsPtr->cellInverseMassVectorBasisData()
+                      .data() +
+                    cellRange.first * numDoFsPerCell,
+                  cellWaveFunctionMatrixDstThread,
+                  dst.data(),
+                  d_basisOperationsPtr
+                      ->d_flattenedCellDofIndexToProcessDofIndexMap.data() +
+                    cellRange.first * numDoFsPerCell);
+              }
           }
 
         inverseMassVectorScaledConstraintsNoneDataInfoPtr
@@ -1907,7 +3018,7 @@ namespace dftfe
           if (d_dftParamsPtr->isPseudopotential)
             d_ONCVnonLocalOperatorSinglePrec->initialiseOperatorActionOnX(
               d_kPointIndex);
-// #pragma omp parallel for num_threads(d_nOMPThreads)
+#pragma omp parallel for num_threads(d_nOMPThreads) if (d_nOMPThreads > 1)
         for (unsigned int iCell = 0; iCell < numCells;
              iCell += d_cellsBlockSizeHX)
           {
@@ -1923,14 +3034,20 @@ namespace dftfe
               d_basisOperationsPtr->d_flattenedCellDofIndexToProcessDofIndexMap
                   .data() +
                 cellRange.first * numDoFsPerCell);
-// #pragma omp critical(hxc_Cconj)
-            if (hasNonlocalComponents)
+          }
+        if (hasNonlocalComponents)
+#pragma omp parallel for num_threads(d_nOMPThreads) if (d_nOMPThreads > 1)
+          for (unsigned int iCell = 0; iCell < numCells;
+               iCell += d_cellsBlockSizeHX)
+            {
+              std::pair<unsigned int, unsigned int> cellRange(
+                iCell, std::min(iCell + d_cellsBlockSizeHX, numCells));
               d_ONCVnonLocalOperatorSinglePrec->applyCconjtransOnX(
                 d_cellWaveFunctionMatrixSrcSinglePrec.data() +
                   cellRange.first * numDoFsPerCell * numberWavefunctions *
                     spinorFactor,
                 cellRange);
-          }
+            }
       }
     if (!skip2)
       {
@@ -1973,56 +3090,76 @@ namespace dftfe
       }
     if (!skip3)
       {
-// #pragma omp parallel for num_threads(d_nOMPThreads)
-        for (unsigned int iCell = 0; iCell < numCells;
-             iCell += d_cellsBlockSizeHX)
+        for (const auto &cellBlocksInColor : d_cellBlockColors)
           {
-            std::pair<unsigned int, unsigned int> cellRange(
-              iCell, std::min(iCell + d_cellsBlockSizeHX, numCells));
-
-            d_BLASWrapperPtr->xgemmStridedBatched(
-              'N',
-              'N',
-              numberWavefunctions,
-              numDoFsPerCell * spinorFactor,
-              numDoFsPerCell * spinorFactor,
-              &scalarCoeffAlpha,
-              d_cellWaveFunctionMatrixSrcSinglePrec.data() +
-                cellRange.first * numDoFsPerCell * spinorFactor *
-                  numberWavefunctions,
-              numberWavefunctions,
-              numDoFsPerCell * spinorFactor * numberWavefunctions,
-              d_cellHamiltonianMatrixSinglePrec[d_HamiltonianIndex].data() +
-                cellRange.first * numDoFsPerCell * spinorFactor *
-                  numDoFsPerCell * spinorFactor,
-              numDoFsPerCell * spinorFactor,
-              numDoFsPerCell * spinorFactor * numDoFsPerCell * spinorFactor,
-              &scalarCoeffBeta,
-              d_cellWaveFunctionMatrixDstSinglePrec.data() +
-                omp_get_thread_num() * d_cellsBlockSizeHX * numDoFsPerCell *
-                  spinorFactor * numberWavefunctions,
-              numberWavefunctions,
-              numDoFsPerCell * spinorFactor * numberWavefunctions,
-              cellRange.second - cellRange.first);
-            if (hasNonlocalComponents)
-              d_ONCVnonLocalOperatorSinglePrec->applyCOnVCconjtransX(
-                d_cellWaveFunctionMatrixDstSinglePrec.data() +
+#pragma omp parallel for num_threads(d_nOMPThreads) if (d_nOMPThreads > 1)
+            for (unsigned int iBlock = 0; iBlock < cellBlocksInColor.size();
+                 ++iBlock)
+              {
+                const unsigned int iCell = cellBlocksInColor[iBlock];
+                std::pair<unsigned int, unsigned int> cellRange(
+                  iCell, std::min(iCell + d_cellsBlockSizeHX, numCells));
+                dataTypes::numberFP32 *cellWaveFunctionMatrixDstThread =
+                  d_cellWaveFunctionMatrixDstSinglePrec.data() +
                   omp_get_thread_num() * d_cellsBlockSizeHX * numDoFsPerCell *
-                    spinorFactor * numberWavefunctions,
-                cellRange);
-            d_BLASWrapperPtr->axpyStridedBlockAtomicAdd(
-              numberWavefunctions * spinorFactor,
-              numDoFsPerCell * (cellRange.second - cellRange.first),
-              scalarHX,
-              d_basisOperationsPtr->cellInverseMassVectorBasisData().data() +
-                cellRange.first * numDoFsPerCell,
-              d_cellWaveFunctionMatrixDstSinglePrec.data() +
-                omp_get_thread_num() * d_cellsBlockSizeHX * numDoFsPerCell *
-                  spinorFactor * numberWavefunctions,
-              dst.data(),
-              d_basisOperationsPtr->d_flattenedCellDofIndexToProcessDofIndexMap
-                  .data() +
-                cellRange.first * numDoFsPerCell);
+                    spinorFactor * numberWavefunctions;
+
+                if (d_isNonCollinSpinBlockHamiltonian)
+                  applyNonCollinearSpinBlockHamiltonian<dataTypes::numberFP32,
+                                                        float>(
+                    cellRange,
+                    numberWavefunctions,
+                    1.0,
+                    d_cellHamiltonianMatrixSinglePrec[d_HamiltonianIndex]
+                      .data(),
+                    d_cellHamiltonianMatrixBZNonCollinSinglePrec
+                      [d_HamiltonianIndex]
+                        .data(),
+                    d_cellWaveFunctionMatrixSrcSinglePrec.data() +
+                      cellRange.first * numDoFsPerCell * spinorFactor *
+                        numberWavefunctions,
+                    cellWaveFunctionMatrixDstThread);
+                else
+                  d_BLASWrapperPtr->xgemmStridedBatched(
+                    'N',
+                    'N',
+                    numberWavefunctions,
+                    numDoFsPerCell * spinorFactor,
+                    numDoFsPerCell * spinorFactor,
+                    &scalarCoeffAlpha,
+                    d_cellWaveFunctionMatrixSrcSinglePrec.data() +
+                      cellRange.first * numDoFsPerCell * spinorFactor *
+                        numberWavefunctions,
+                    numberWavefunctions,
+                    numDoFsPerCell * spinorFactor * numberWavefunctions,
+                    d_cellHamiltonianMatrixSinglePrec[d_HamiltonianIndex]
+                        .data() +
+                      cellRange.first * numDoFsPerCell * spinorFactor *
+                        numDoFsPerCell * spinorFactor,
+                    numDoFsPerCell * spinorFactor,
+                    numDoFsPerCell * spinorFactor * numDoFsPerCell *
+                      spinorFactor,
+                    &scalarCoeffBeta,
+                    cellWaveFunctionMatrixDstThread,
+                    numberWavefunctions,
+                    numDoFsPerCell * spinorFactor * numberWavefunctions,
+                    cellRange.second - cellRange.first);
+                if (hasNonlocalComponents)
+                  d_ONCVnonLocalOperatorSinglePrec->applyCOnVCconjtransX(
+                    cellWaveFunctionMatrixDstThread, cellRange);
+                d_BLASWrapperPtr->axpyStridedBlockAtomicAdd(
+                  numberWavefunctions * spinorFactor,
+                  numDoFsPerCell * (cellRange.second - cellRange.first),
+                  scalarHX,
+                  d_basisOperationsPtr->cellInverseMassVectorBasisData()
+                      .data() +
+                    cellRange.first * numDoFsPerCell,
+                  cellWaveFunctionMatrixDstThread,
+                  dst.data(),
+                  d_basisOperationsPtr
+                      ->d_flattenedCellDofIndexToProcessDofIndexMap.data() +
+                    cellRange.first * numDoFsPerCell);
+              }
           }
 
         inverseMassVectorScaledConstraintsNoneDataInfoPtr
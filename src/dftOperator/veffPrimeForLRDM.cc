@@ -41,6 +41,7 @@ namespace dftfe
     const std::map<dealii::CellId, std::vector<double>> &gradRhoCoreValues,
     const unsigned int                                   spinIndex)
   {
+    d_isKPointIndependentHamiltonianComputed = false;
     const bool isGGA =
       d_excManagerPtr->getDensityBasedFamilyType() == densityFamilyType::GGA;
     const unsigned int spinPolarizedFactor = 1 + d_dftParamsPtr->spinPolarized;
@@ -126,11 +126,14 @@ namespace dftfe
           }
       }
 
-    const double spinPolarizedFactor =
-      (d_dftParams.spinPolarized == 1) ? 0.5 : 1.0;
+    // every spinor state of noncollinear and spin-orbit runs carries a single
+    // electron like the states of spin polarized runs
+    const bool isSingleOccupancy = d_dftParams.spinPolarized == 1 ||
+                                   d_dftParams.noncolin || d_dftParams.hasSOC;
+    const double spinPolarizedFactor = isSingleOccupancy ? 0.5 : 1.0;
     const dealii::VectorizedArray<double> spinPolarizedFactorVect =
-      (d_dftParams.spinPolarized == 1) ? dealii::make_vectorized_array(0.5) :
-                                         dealii::make_vectorized_array(1.0);
+      isSingleOccupancy ? dealii::make_vectorized_array(0.5) :
+                          dealii::make_vectorized_array(1.0);
 
     const unsigned int numPhysicalCells = matrixFreeData.n_physical_cells();
 
@@ -464,7 +467,7 @@ namespace dftfe
     // vector
     if (isPseudopotential)
       {
-        if (d_dftParams.spinPolarized == 1)
+        if (isSingleOccupancy)
           for (auto &iter : forceContributionFnlGammaAtoms)
             {
               std::vector<double> &fnlvec = iter.second;
@@ -517,7 +520,26 @@ namespace dftfe
         std::vector<double> gradRhoSpinPolarizedCellQuadValues(numQuadPoints *
                                                                  6,
                                                                0);
-        if (d_dftParams.spinPolarized == 1)
+
+        // noncollinear densities enter the spin polarized exchange-correlation
+        // terms in the frame of the local magnetization
+        std::vector<
+          dftfe::utils::MemoryStorage<double, dftfe::utils::MemorySpace::HOST>>
+          rhoOutValuesLocalFrame, gradRhoOutValuesLocalFrame;
+        if (d_dftParams.noncolin)
+          dftUtils::computeLocalFrameSpinDensity(
+            dftPtr->d_excManagerPtr->getDensityBasedFamilyType() ==
+              densityFamilyType::GGA,
+            rhoOutValues,
+            gradRhoOutValues,
+            rhoOutValuesLocalFrame,
+            gradRhoOutValuesLocalFrame);
+        const auto &rhoOutValuesXC =
+          d_dftParams.noncolin ? rhoOutValuesLocalFrame : rhoOutValues;
+        const auto &gradRhoOutValuesXC =
+          d_dftParams.noncolin ? gradRhoOutValuesLocalFrame : gradRhoOutValues;
+
+        if (d_dftParams.spinPolarized == 1 || d_dftParams.noncolin)
           {
             dealii::AlignedVector<dealii::VectorizedArray<double>>
               rhoXCQuadsVect(numQuadPoints, dealii::make_vectorized_array(0.0));
@@ -650,8 +672,8 @@ namespace dftfe
                         const unsigned int subCellIndex =
                           dftPtr->d_basisOperationsPtrHost->cellIndex(
                             subCellId);
-                        const auto &rhoTotalOutValues = rhoOutValues[0];
-                        const auto &rhoMagOutValues   = rhoOutValues[1];
+                        const auto &rhoTotalOutValues = rhoOutValuesXC[0];
+                        const auto &rhoMagOutValues   = rhoOutValuesXC[1];
                         for (unsigned int q = 0; q < numQuadPoints; ++q)
                           {
                             rhoTotalCellQuadValues[q] =
@@ -700,9 +722,9 @@ namespace dftfe
                             //    ->second;
 
                             const auto &gradRhoTotalOutValues =
-                              gradRhoOutValues[0];
+                              gradRhoOutValuesXC[0];
                             const auto &gradRhoMagOutValues =
-                              gradRhoOutValues[1];
+                              gradRhoOutValuesXC[1];
 
                             for (unsigned int q = 0; q < numQuadPoints; ++q)
                               for (unsigned int idim = 0; idim < 3; idim++)
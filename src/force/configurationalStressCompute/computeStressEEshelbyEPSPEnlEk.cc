@@ -94,11 +94,14 @@ namespace dftfe
                    dftPtr->d_nlpspQuadratureId);
 
 
-    const double spinPolarizedFactor =
-      (d_dftParams.spinPolarized == 1) ? 0.5 : 1.0;
+    // every spinor state of noncollinear and spin-orbit runs carries a single
+    // electron like the states of spin polarized runs
+    const bool isSingleOccupancy = d_dftParams.spinPolarized == 1 ||
+                                   d_dftParams.noncolin || d_dftParams.hasSOC;
+    const double spinPolarizedFactor = isSingleOccupancy ? 0.5 : 1.0;
     const dealii::VectorizedArray<double> spinPolarizedFactorVect =
-      (d_dftParams.spinPolarized == 1) ? dealii::make_vectorized_array(0.5) :
-                                         dealii::make_vectorized_array(1.0);
+      isSingleOccupancy ? dealii::make_vectorized_array(0.5) :
+                          dealii::make_vectorized_array(1.0);
 
     const unsigned int numQuadPoints    = forceEval.n_q_points;
     const unsigned int numQuadPointsNLP = forceEvalNLP.n_q_points;
@@ -423,7 +426,7 @@ namespace dftfe
                   projectorKetTimesPsiTimesVTimesPartOccContractionPsiQuadsFlattened,
 #endif
                   projectorKetTimesPsiTimesVTimesPartOccContractionGradPsiQuadsFlattened,
-                  d_dftParams.spinPolarized == 1);
+                  isSingleOccupancy);
 
               } // macro cell loop
           }     // pseudopotential check
@@ -459,7 +462,25 @@ namespace dftfe
                                                                0);
 
 
-        if (d_dftParams.spinPolarized == 1)
+        // noncollinear densities enter the spin polarized exchange-correlation
+        // terms in the frame of the local magnetization
+        std::vector<
+          dftfe::utils::MemoryStorage<double, dftfe::utils::MemorySpace::HOST>>
+          rhoOutValuesLocalFrame, gradRhoOutValuesLocalFrame;
+        if (d_dftParams.noncolin)
+          dftUtils::computeLocalFrameSpinDensity(
+            dftPtr->d_excManagerPtr->getDensityBasedFamilyType() ==
+              densityFamilyType::GGA,
+            rhoOutValues,
+            gradRhoOutValues,
+            rhoOutValuesLocalFrame,
+            gradRhoOutValuesLocalFrame);
+        const auto &rhoOutValuesXC =
+          d_dftParams.noncolin ? rhoOutValuesLocalFrame : rhoOutValues;
+        const auto &gradRhoOutValuesXC =
+          d_dftParams.noncolin ? gradRhoOutValuesLocalFrame : gradRhoOutValues;
+
+        if (d_dftParams.spinPolarized == 1 || d_dftParams.noncolin)
           {
             dealii::AlignedVector<dealii::VectorizedArray<double>>
               rhoXCQuadsVect(numQuadPoints, dealii::make_vectorized_array(0.0));
@@ -572,8 +593,8 @@ namespace dftfe
                         const unsigned int subCellIndex =
                           dftPtr->d_basisOperationsPtrHost->cellIndex(
                             subCellId);
-                        const auto &rhoTotalOutValues = rhoOutValues[0];
-                        const auto &rhoMagOutValues   = rhoOutValues[1];
+                        const auto &rhoTotalOutValues = rhoOutValuesXC[0];
+                        const auto &rhoMagOutValues   = rhoOutValuesXC[1];
                         for (unsigned int q = 0; q < numQuadPoints; ++q)
                           {
                             rhoTotalCellQuadValues[q] =
@@ -621,9 +642,9 @@ namespace dftfe
                             //    .find(subCellId)
                             //    ->second;
                             const auto &gradRhoTotalOutValues =
-                              gradRhoOutValues[0];
+                              gradRhoOutValuesXC[0];
                             const auto &gradRhoMagOutValues =
-                              gradRhoOutValues[1];
+                              gradRhoOutValuesXC[1];
 
                             for (unsigned int q = 0; q < numQuadPoints; ++q)
                               for (unsigned int idim = 0; idim < 3; idim++)
@@ -553,10 +553,12 @@ namespace dftfe
         const unsigned int startingVecId,
         const unsigned int N,
         const unsigned int numPsi,
+        const unsigned int numWfnSpinors,
         const unsigned int numCells,
         const unsigned int numQuads,
         const unsigned int numQuadsNLP,
         const unsigned int totalNonTrivialPseudoWfcs,
+        const CouplingStructure couplingType,
         dftfe::utils::MemoryStorage<dataTypes::number, memorySpace>
           &psiQuadsFlat,
         dftfe::utils::MemoryStorage<dataTypes::number, memorySpace>
@@ -602,18 +604,23 @@ namespace dftfe
           deviceFlattenedArrayBlock.data());
         */
 
+        // for spinors every dof holds the numPsi/numWfnSpinors wavefunctions
+        // of each spinor component in turn, the spinor components are then
+        // contracted as independent wavefunctions below
+        const unsigned int numWfcs = numPsi / numWfnSpinors;
+        const unsigned int numNodes =
+          basisOperationsPtr->nOwnedDofs() * numWfnSpinors;
         if (memorySpace == dftfe::utils::MemorySpace::HOST)
-          for (unsigned int iNode = 0; iNode < basisOperationsPtr->nOwnedDofs();
-               ++iNode)
-            std::memcpy(flattenedArrayBlock.data() + iNode * numPsi,
+          for (unsigned int iNode = 0; iNode < numNodes; ++iNode)
+            std::memcpy(flattenedArrayBlock.data() + iNode * numWfcs,
                         X + iNode * N + startingVecId,
-                        numPsi * sizeof(dataTypes::number));
+                        numWfcs * sizeof(dataTypes::number));
 #if defined(DFTFE_WITH_DEVICE)
         else if (memorySpace == dftfe::utils::MemorySpace::DEVICE)
           dftfe::utils::deviceKernelsGeneric::stridedCopyToBlockConstantStride(
-            numPsi,
+            numWfcs,
             N,
-            basisOperationsPtr->nOwnedDofs(),
+            numNodes,
             startingVecId,
             X,
             flattenedArrayBlock.data());
@@ -670,7 +677,7 @@ namespace dftfe
             oncvClassPtr->getNonLocalOperator()->applyVCconjtransOnX(
               flattenedArrayBlock,
               kPointIndex,
-              CouplingStructure::diagonal,
+              couplingType,
               oncvClassPtr->getCouplingMatrix(),
               projectorKetTimesVector);
 
@@ -782,6 +789,15 @@ namespace dftfe
         std::min(dftParams.chebyWfcBlockSize,
                  bandGroupLowHighPlusOneIndices[1]);
 
+      // the spinor components of a block of wavefunctions are contracted
+      // together as a block of numWfnSpinors*blockSize wavefunctions
+      const unsigned int numWfnSpinors =
+        (dftParams.noncolin || dftParams.hasSOC) ? 2 : 1;
+      const unsigned int spinorBlockSize = blockSize * numWfnSpinors;
+      const CouplingStructure couplingType =
+        dftParams.hasSOC ? CouplingStructure::blockDiagonal :
+                           CouplingStructure::diagonal;
+
       // int this_process;
       // MPI_Comm_rank(mpiCommParent, &this_process);
       // dftfe::utils::deviceSynchronize();
@@ -807,33 +823,35 @@ namespace dftfe
 
       // device_time = MPI_Wtime();
 
-      dftfe::utils::MemoryStorage<double, memorySpace> eigenValues(blockSize,
-                                                                   0.0);
+      dftfe::utils::MemoryStorage<double, memorySpace> eigenValues(
+        spinorBlockSize, 0.0);
       dftfe::utils::MemoryStorage<double, memorySpace> partialOccupancies(
-        blockSize, 0.0);
+        spinorBlockSize, 0.0);
       dftfe::utils::MemoryStorage<double, memorySpace>
         elocWfcEshelbyTensorQuadValues(numCells * numQuads * 9, 0.0);
 
-      dftfe::utils::MemoryStorage<double, memorySpace> onesVec(blockSize, 1.0);
+      dftfe::utils::MemoryStorage<double, memorySpace> onesVec(spinorBlockSize,
+                                                               1.0);
       dftfe::utils::MemoryStorage<dataTypes::number, memorySpace> onesVecNLP(
-        blockSize, dataTypes::number(1.0));
+        spinorBlockSize, dataTypes::number(1.0));
 
       const unsigned int cellsBlockSize = std::min((unsigned int)10, numCells);
 
       dftfe::utils::MemoryStorage<dataTypes::number, memorySpace> psiQuadsFlat(
-        cellsBlockSize * numQuads * blockSize, dataTypes::number(0.0));
+        cellsBlockSize * numQuads * spinorBlockSize, dataTypes::number(0.0));
       dftfe::utils::MemoryStorage<dataTypes::number, memorySpace>
-                                                                  gradPsiQuadsFlat(cellsBlockSize * numQuads * blockSize * 3,
+        gradPsiQuadsFlat(cellsBlockSize * numQuads * spinorBlockSize * 3,
                          dataTypes::number(0.0));
       dftfe::utils::MemoryStorage<dataTypes::number, memorySpace> psiQuadsNLP(
-        numCells * numQuadsNLP * blockSize, dataTypes::number(0.0));
+        numCells * numQuadsNLP * spinorBlockSize, dataTypes::number(0.0));
 
       dftfe::utils::MemoryStorage<dataTypes::number, memorySpace>
-        gradPsiQuadsNLPFlat(numCells * numQuadsNLP * 3 * blockSize,
+        gradPsiQuadsNLPFlat(numCells * numQuadsNLP * 3 * spinorBlockSize,
                             dataTypes::number(0.0));
 
       dftfe::utils::MemoryStorage<double, memorySpace>
-        eshelbyTensorContributions(cellsBlockSize * numQuads * blockSize * 9,
+        eshelbyTensorContributions(cellsBlockSize * numQuads *
+                                     spinorBlockSize * 9,
                                    0.0);
 
       const unsigned int totalNonTrivialPseudoWfcs =
@@ -845,7 +863,7 @@ namespace dftfe
         std::min((unsigned int)10, totalNonTrivialPseudoWfcs);
       dftfe::utils::MemoryStorage<dataTypes::number, memorySpace>
         nlpContractionContribution(innerBlockSizeEnlp * numQuadsNLP * 3 *
-                                     blockSize,
+                                     spinorBlockSize,
                                    dataTypes::number(0.0));
       dftfe::utils::MemoryStorage<dataTypes::number, memorySpace>
         projectorKetTimesPsiTimesVTimesPartOccContractionPsiQuadsFlattenedBlock;
@@ -939,12 +957,13 @@ namespace dftfe
               const unsigned int currentBlockSize =
                 std::min(blockSize, N - ivec);
 
-              flattenedArrayBlockPtr =
-                &(basisOperationsPtr->getMultiVector(currentBlockSize, 0));
+              flattenedArrayBlockPtr = &(basisOperationsPtr->getMultiVector(
+                currentBlockSize * numWfnSpinors, 0));
 
               if (isPsp)
                 oncvClassPtr->getNonLocalOperator()
-                  ->initialiseFlattenedDataStructure(currentBlockSize,
+                  ->initialiseFlattenedDataStructure(currentBlockSize *
+                                                       numWfnSpinors,
                                                      projectorKetTimesVector);
 
 
@@ -953,31 +972,37 @@ namespace dftfe
                   (ivec + currentBlockSize) >
                     bandGroupLowHighPlusOneIndices[2 * bandGroupTaskId])
                 {
-                  std::vector<double> blockedEigenValues(currentBlockSize, 0.0);
+                  std::vector<double> blockedEigenValues(currentBlockSize *
+                                                           numWfnSpinors,
+                                                         0.0);
                   std::vector<double> blockedPartialOccupancies(
-                    currentBlockSize, 0.0);
-                  for (unsigned int iWave = 0; iWave < currentBlockSize;
-                       ++iWave)
-                    {
-                      blockedEigenValues[iWave] =
-                        eigenValuesH[kPoint][spinIndex * N + ivec + iWave];
-                      blockedPartialOccupancies[iWave] =
-                        partialOccupanciesH[kPoint]
-                                           [spinIndex * N + ivec + iWave];
-                    }
+                    currentBlockSize * numWfnSpinors, 0.0);
+                  for (unsigned int iSpinor = 0; iSpinor < numWfnSpinors;
+                       ++iSpinor)
+                    for (unsigned int iWave = 0; iWave < currentBlockSize;
+                         ++iWave)
+                      {
+                        blockedEigenValues[iSpinor * currentBlockSize +
+                                           iWave] =
+                          eigenValuesH[kPoint][spinIndex * N + ivec + iWave];
+                        blockedPartialOccupancies[iSpinor * currentBlockSize +
+                                                  iWave] =
+                          partialOccupanciesH[kPoint]
+                                             [spinIndex * N + ivec + iWave];
+                      }
 
 
                   dftfe::utils::MemoryTransfer<
                     memorySpace,
                     dftfe::utils::MemorySpace::HOST>::
-                    copy(currentBlockSize,
+                    copy(currentBlockSize * numWfnSpinors,
                          eigenValues.data(),
                          &blockedEigenValues[0]);
 
                   dftfe::utils::MemoryTransfer<
                     memorySpace,
                     dftfe::utils::MemorySpace::HOST>::
-                    copy(currentBlockSize,
+                    copy(currentBlockSize * numWfnSpinors,
                          partialOccupancies.data(),
                          &blockedPartialOccupancies[0]);
 
@@ -1004,8 +1029,8 @@ namespace dftfe
                     kPoint,
                     *flattenedArrayBlockPtr,
                     projectorKetTimesVector,
-                    X +
-                      ((1 + spinPolarizedFlag) * kPoint + spinIndex) * MLoc * N,
+                    X + ((1 + spinPolarizedFlag) * kPoint + spinIndex) *
+                          MLoc * N * numWfnSpinors,
                     eigenValues,
                     partialOccupancies,
                     kcoordx,
@@ -1017,11 +1042,13 @@ namespace dftfe
                     projecterKetTimesFlattenedVectorLocalIds,
                     ivec,
                     N,
-                    currentBlockSize,
+                    currentBlockSize * numWfnSpinors,
+                    numWfnSpinors,
                     numCells,
                     numQuads,
                     numQuadsNLP,
                     totalNonTrivialPseudoWfcs,
+                    couplingType,
                     psiQuadsFlat,
                     gradPsiQuadsFlat,
                     psiQuadsNLP,
@@ -25,6 +25,7 @@
 
 #include "dftParameters.h"
 #include "dftUtils.h"
+#include "HostMemoryPool.h"
 #include "linearAlgebraOperations.h"
 #include "linearAlgebraOperationsInternal.h"
 #include "linearAlgebraOperationsDevice.h"
@@ -49,6 +50,7 @@ namespace dftfe
                     const double                                       b,
                     const double                                       a0)
     {
+      dftfe::utils::HostMemoryPool::ScopedTag memoryTag("chebyshevFilter");
       double e, c, sigma, sigma1, sigma2, gamma;
       e      = (b - a) / 2.0;
       c      = (b + a) / 2.0;
@@ -121,6 +123,8 @@ namespace dftfe
       const double                                           b,
       const double                                           a0)
     {
+      dftfe::utils::HostMemoryPool::ScopedTag memoryTag(
+        "chebyshevFilterSinglePrec");
       double e, c, sigma, sigma1, sigma2, gamma;
       e                               = (b - a) / 2.0;
       c                               = (b + a) / 2.0;
@@ -226,6 +230,446 @@ namespace dftfe
       // copy back YArray to XArray
     }
 
+    //
+    // chebyshev filtering of two given subspaces X1 and X2 simultaneously,
+    // the ghost communication of one overlaps with the cell level compute of
+    // the other
+    //
+    template <typename T, dftfe::utils::MemorySpace memorySpace>
+    void
+    chebyshevFilterOverlapComputeCommunication(
+      operatorDFTClass<memorySpace> &                    operatorMatrix,
+      dftfe::linearAlgebra::MultiVector<T, memorySpace> &X1,
+      dftfe::linearAlgebra::MultiVector<T, memorySpace> &Y1,
+      dftfe::linearAlgebra::MultiVector<T, memorySpace> &X2,
+      dftfe::linearAlgebra::MultiVector<T, memorySpace> &Y2,
+      const unsigned int                                 m,
+      const double                                       a,
+      const double                                       b,
+      const double                                       a0)
+    {
+      double e, c, sigma, sigma1, sigma2, gamma, alpha1Old, alpha2Old;
+      e      = (b - a) / 2.0;
+      c      = (b + a) / 2.0;
+      sigma  = e / (a0 - c);
+      sigma1 = sigma;
+      gamma  = 2.0 / sigma1;
+
+
+      //
+      // create YArray
+      // initialize to zeros.
+      // x
+      Y1.setValue(T(0.0));
+      Y2.setValue(T(0.0));
+
+
+      //
+      // call HX
+      //
+
+
+      double alpha1 = sigma1 / e, alpha2 = -c;
+      operatorMatrix.HXCheby(X1, alpha1, 0.0, alpha1 * alpha2, Y1);
+      X2.updateGhostValues();
+      operatorMatrix.HXCheby(
+        X2, alpha1, 0.0, alpha1 * alpha2, Y2, false, false, true, true);
+      //
+      // polynomial loop
+      //
+      for (unsigned int degree = 2; degree < m + 1; ++degree)
+        {
+          sigma2    = 1.0 / (gamma - sigma);
+          alpha1Old = alpha1, alpha2Old = alpha2;
+          alpha1 = 2.0 * sigma2 / e, alpha2 = -(sigma * sigma2);
+
+          if (degree == 2)
+            {
+              operatorMatrix.HXCheby(X2,
+                                     alpha1Old,
+                                     0.0,
+                                     alpha1Old * alpha2Old,
+                                     Y2,
+                                     false,
+                                     true,
+                                     false,
+                                     true);
+              Y1.updateGhostValuesBegin();
+              operatorMatrix.HXCheby(X2,
+                                     alpha1Old,
+                                     0.0,
+                                     alpha1Old * alpha2Old,
+                                     Y2,
+                                     false,
+                                     true,
+                                     true,
+                                     false);
+              Y1.updateGhostValuesEnd();
+              Y2.accumulateAddLocallyOwnedBegin();
+            }
+          else
+            {
+              operatorMatrix.HXCheby(Y2,
+                                     alpha1Old,
+                                     alpha2Old,
+                                     -c * alpha1Old,
+                                     X2,
+                                     false,
+                                     true,
+                                     false,
+                                     true);
+              Y1.updateGhostValuesBegin();
+              operatorMatrix.HXCheby(Y2,
+                                     alpha1Old,
+                                     alpha2Old,
+                                     -c * alpha1Old,
+                                     X2,
+                                     false,
+                                     true,
+                                     true,
+                                     false);
+              Y1.updateGhostValuesEnd();
+              X2.accumulateAddLocallyOwnedBegin();
+            }
+
+
+          //
+          // call HX
+          //
+          operatorMatrix.HXCheby(
+            Y1, alpha1, alpha2, -c * alpha1, X1, false, false, true, true);
+          if (degree == 2)
+            {
+              Y2.accumulateAddLocallyOwnedEnd();
+              Y2.zeroOutGhosts();
+            }
+          else
+            {
+              X2.accumulateAddLocallyOwnedEnd();
+              X2.zeroOutGhosts();
+              X2.swap(Y2);
+            }
+
+          operatorMatrix.HXCheby(
+            Y1, alpha1, alpha2, -c * alpha1, X1, false, true, false, true);
+          Y2.updateGhostValuesBegin();
+          operatorMatrix.HXCheby(
+            Y1, alpha1, alpha2, -c * alpha1, X1, false, true, true, false);
+          Y2.updateGhostValuesEnd();
+          X1.accumulateAddLocallyOwnedBegin();
+          operatorMatrix.HXCheby(
+            Y2, alpha1, alpha2, -c * alpha1, X2, false, false, true, true);
+          X1.accumulateAddLocallyOwnedEnd();
+          X1.zeroOutGhosts();
+
+          //
+          // XArray = YArray
+          //
+          X1.swap(Y1);
+
+          if (degree == m)
+            {
+              operatorMatrix.HXCheby(
+                Y2, alpha1, alpha2, -c * alpha1, X2, false, true, false, false);
+              X2.accumulateAddLocallyOwned();
+              X2.zeroOutGhosts();
+              X2.swap(Y2);
+            }
+
+          //
+          // YArray = YNewArray
+          //
+          sigma = sigma2;
+        }
+
+      // copy back YArray to XArray
+      X1 = Y1;
+      X2 = Y2;
+    }
+
+    template <typename T, typename TFP32, dftfe::utils::MemorySpace memorySpace>
+    void
+    chebyshevFilterOverlapComputeCommunicationSinglePrec(
+      const std::shared_ptr<dftfe::linearAlgebra::BLASWrapper<memorySpace>>
+        &                                                    BLASWrapperPtr,
+      operatorDFTClass<memorySpace> &                        operatorMatrix,
+      dftfe::linearAlgebra::MultiVector<T, memorySpace> &    X1,
+      dftfe::linearAlgebra::MultiVector<T, memorySpace> &    Y1,
+      dftfe::linearAlgebra::MultiVector<T, memorySpace> &    X2,
+      dftfe::linearAlgebra::MultiVector<T, memorySpace> &    Y2,
+      dftfe::linearAlgebra::MultiVector<TFP32, memorySpace> &X1_SP,
+      dftfe::linearAlgebra::MultiVector<TFP32, memorySpace> &Y1_SP,
+      dftfe::linearAlgebra::MultiVector<TFP32, memorySpace> &X2_SP,
+      dftfe::linearAlgebra::MultiVector<TFP32, memorySpace> &Y2_SP,
+      std::vector<double>                                    eigenvalues,
+      const unsigned int                                     m,
+      const double                                           a,
+      const double                                           b,
+      const double                                           a0)
+    {
+      double e, c, sigma, sigma1, sigma2, gamma, alpha1Old, alpha2Old;
+      e                               = (b - a) / 2.0;
+      c                               = (b + a) / 2.0;
+      sigma                           = e / (a0 - c);
+      sigma1                          = sigma;
+      gamma                           = 2.0 / sigma1;
+      const unsigned int numEigVals   = eigenvalues.size() / 2;
+      const unsigned int spinorFactor = X1.numVectors() / numEigVals;
+
+      dftfe::utils::MemoryStorage<double, memorySpace>
+        eigenValuesFiltered, eigenValuesFiltered1, eigenValuesFiltered2;
+      eigenValuesFiltered.resize(eigenvalues.size());
+      eigenValuesFiltered.copyFrom(eigenvalues);
+      eigenValuesFiltered1 = eigenValuesFiltered;
+      eigenValuesFiltered2 = eigenValuesFiltered;
+      eigenValuesFiltered1.setValue(1.0);
+
+      //
+      // create YArray
+      // initialize to zeros.
+      // x
+      operatorMatrix.HXCheby(X1, 1.0, 0.0, 0.0, Y1);
+
+
+      //
+      // call HX
+      //
+
+
+      double alpha1 = sigma1 / e, alpha2 = -c;
+      eigenValuesFiltered2.setValue(alpha1 * alpha2);
+      BLASWrapperPtr->ApaBD(1,
+                            eigenValuesFiltered2.size(),
+                            alpha1,
+                            eigenValuesFiltered2.data(),
+                            eigenValuesFiltered1.data(),
+                            eigenValuesFiltered.data(),
+                            eigenValuesFiltered2.data());
+      BLASWrapperPtr->ApaBD(X1.locallyOwnedSize() * spinorFactor,
+                            X1.numVectors() / spinorFactor,
+                            -1.0,
+                            Y1.data(),
+                            X1.data(),
+                            eigenValuesFiltered.data(),
+                            Y1.data());
+      X1_SP.setValue(0.0);
+      X2_SP.setValue(0.0);
+      BLASWrapperPtr->copyValueType1ArrToValueType2Arr(
+        X1.locallyOwnedSize() * X1.numVectors(), Y1.data(), Y1_SP.data());
+      BLASWrapperPtr->xscal(Y1_SP.data(),
+                            TFP32(alpha1),
+                            X2.locallyOwnedSize() * X2.numVectors());
+      X2.updateGhostValues();
+      operatorMatrix.HXCheby(X2, 1.0, 0.0, 0.0, Y2, false, false, true, true);
+      //
+      // polynomial loop
+      //
+      for (unsigned int degree = 2; degree < m + 1; ++degree)
+        {
+          sigma2    = 1.0 / (gamma - sigma);
+          alpha1Old = alpha1, alpha2Old = alpha2;
+          alpha1 = 2.0 * sigma2 / e, alpha2 = -(sigma * sigma2);
+
+          if (degree == 2)
+            {
+              operatorMatrix.HXCheby(
+                X2, 1.0, 0.0, 0.0, Y2, false, true, false, true);
+              Y1_SP.updateGhostValuesBegin();
+              operatorMatrix.HXCheby(
+                X2, 1.0, 0.0, 0.0, Y2, false, true, true, false);
+              Y1_SP.updateGhostValuesEnd();
+              Y2.accumulateAddLocallyOwnedBegin();
+            }
+          else
+            {
+              operatorMatrix.HXCheby(Y2_SP,
+                                     alpha1Old,
+                                     alpha2Old,
+                                     -c * alpha1Old,
+                                     X2_SP,
+                                     false,
+                                     true,
+                                     false,
+                                     true);
+              Y1_SP.updateGhostValuesBegin();
+              operatorMatrix.HXCheby(Y2_SP,
+                                     alpha1Old,
+                                     alpha2Old,
+                                     -c * alpha1Old,
+                                     X2_SP,
+                                     false,
+                                     true,
+                                     true,
+                                     false);
+              Y1_SP.updateGhostValuesEnd();
+              X2_SP.accumulateAddLocallyOwnedBegin();
+            }
+
+
+          //
+          // call HX
+          //
+          operatorMatrix.HXCheby(Y1_SP,
+                                 alpha1,
+                                 alpha2,
+                                 -c * alpha1,
+                                 X1_SP,
+                                 false,
+                                 false,
+                                 true,
+                                 true);
+          if (degree == 2)
+            {
+              Y2.accumulateAddLocallyOwnedEnd();
+              Y2.zeroOutGhosts();
+              BLASWrapperPtr->ApaBD(X2.locallyOwnedSize() * spinorFactor,
+                                    X2.numVectors() / spinorFactor,
+                                    -1.0,
+                                    Y2.data(),
+                                    X2.data(),
+                                    eigenValuesFiltered.data() + numEigVals,
+                                    Y2.data());
+              BLASWrapperPtr->copyValueType1ArrToValueType2Arr(
+                X2.locallyOwnedSize() * X2.numVectors(),
+                Y2.data(),
+                Y2_SP.data());
+              BLASWrapperPtr->xscal(Y2_SP.data(),
+                                    TFP32(alpha1Old),
+                                    X2.locallyOwnedSize() * X2.numVectors());
+            }
+          else
+            {
+              X2_SP.accumulateAddLocallyOwnedEnd();
+              X2_SP.zeroOutGhosts();
+              BLASWrapperPtr->ApaBD(X2_SP.locallyOwnedSize() * spinorFactor,
+                                    X2_SP.numVectors() / spinorFactor,
+                                    alpha1Old,
+                                    X2_SP.data(),
+                                    Y2.data(),
+                                    eigenValuesFiltered2.data() + numEigVals,
+                                    X2_SP.data());
+              BLASWrapperPtr->axpby(eigenValuesFiltered2.size(),
+                                    -c * alpha1Old,
+                                    eigenValuesFiltered2.data(),
+                                    alpha2Old,
+                                    eigenValuesFiltered1.data());
+              BLASWrapperPtr->ApaBD(1,
+                                    eigenValuesFiltered1.size(),
+                                    alpha1Old,
+                                    eigenValuesFiltered1.data(),
+                                    eigenValuesFiltered2.data(),
+                                    eigenValuesFiltered.data(),
+                                    eigenValuesFiltered1.data());
+              X2_SP.swap(Y2_SP);
+              eigenValuesFiltered1.swap(eigenValuesFiltered2);
+            }
+
+          operatorMatrix.HXCheby(Y1_SP,
+                                 alpha1,
+                                 alpha2,
+                                 -c * alpha1,
+                                 X1_SP,
+                                 false,
+                                 true,
+                                 false,
+                                 true);
+          Y2_SP.updateGhostValuesBegin();
+          operatorMatrix.HXCheby(Y1_SP,
+                                 alpha1,
+                                 alpha2,
+                                 -c * alpha1,
+                                 X1_SP,
+                                 false,
+                                 true,
+                                 true,
+                                 false);
+          Y2_SP.updateGhostValuesEnd();
+          X1_SP.accumulateAddLocallyOwnedBegin();
+          operatorMatrix.HXCheby(Y2_SP,
+                                 alpha1,
+                                 alpha2,
+                                 -c * alpha1,
+                                 X2_SP,
+                                 false,
+                                 false,
+                                 true,
+                                 true);
+          X1_SP.accumulateAddLocallyOwnedEnd();
+          X1_SP.zeroOutGhosts();
+          BLASWrapperPtr->ApaBD(X1_SP.locallyOwnedSize() * spinorFactor,
+                                X1_SP.numVectors() / spinorFactor,
+                                alpha1,
+                                X1_SP.data(),
+                                Y1.data(),
+                                eigenValuesFiltered2.data(),
+                                X1_SP.data());
+
+          //
+          // XArray = YArray
+          //
+          X1_SP.swap(Y1_SP);
+
+          if (degree == m)
+            {
+              operatorMatrix.HXCheby(Y2_SP,
+                                     alpha1,
+                                     alpha2,
+                                     -c * alpha1,
+                                     X2_SP,
+                                     false,
+                                     true,
+                                     false,
+                                     false);
+              X2_SP.accumulateAddLocallyOwned();
+              X2_SP.zeroOutGhosts();
+              BLASWrapperPtr->ApaBD(X2_SP.locallyOwnedSize() * spinorFactor,
+                                    X2_SP.numVectors() / spinorFactor,
+                                    alpha1,
+                                    X2_SP.data(),
+                                    Y2.data(),
+                                    eigenValuesFiltered2.data() + numEigVals,
+                                    X2_SP.data());
+              BLASWrapperPtr->axpby(eigenValuesFiltered2.size(),
+                                    -c * alpha1,
+                                    eigenValuesFiltered2.data(),
+                                    alpha2,
+                                    eigenValuesFiltered1.data());
+              BLASWrapperPtr->ApaBD(1,
+                                    eigenValuesFiltered1.size(),
+                                    alpha1,
+                                    eigenValuesFiltered1.data(),
+                                    eigenValuesFiltered2.data(),
+                                    eigenValuesFiltered.data(),
+                                    eigenValuesFiltered1.data());
+              X2_SP.swap(Y2_SP);
+              eigenValuesFiltered1.swap(eigenValuesFiltered2);
+            }
+
+          //
+          // YArray = YNewArray
+          //
+          sigma = sigma2;
+        }
+
+      // copy back YArray to XArray
+      BLASWrapperPtr->ApaBD(X1.locallyOwnedSize() * spinorFactor,
+                            X1.numVectors() / spinorFactor,
+                            1.0,
+                            Y1_SP.data(),
+                            X1.data(),
+                            eigenValuesFiltered2.data(),
+                            X1.data());
+
+      BLASWrapperPtr->ApaBD(X2.locallyOwnedSize() * spinorFactor,
+                            X2.numVectors() / spinorFactor,
+                            1.0,
+                            Y2_SP.data(),
+                            X2.data(),
+                            eigenValuesFiltered2.data() + numEigVals,
+                            X2.data());
+    }
+
+
     //
     // evaluate upper bound of the spectrum using k-step Lanczos iteration
     //
@@ -715,6 +1159,49 @@ namespace dftfe
       const double        b,
       const double        a0);
 
+    template void
+    chebyshevFilterOverlapComputeCommunication(
+      operatorDFTClass<dftfe::utils::MemorySpace::HOST> &operatorMatrix,
+      dftfe::linearAlgebra::MultiVector<dataTypes::number,
+                                        dftfe::utils::MemorySpace::HOST> &X1,
+      dftfe::linearAlgebra::MultiVector<dataTypes::number,
+                                        dftfe::utils::MemorySpace::HOST> &Y1,
+      dftfe::linearAlgebra::MultiVector<dataTypes::number,
+                                        dftfe::utils::MemorySpace::HOST> &X2,
+      dftfe::linearAlgebra::MultiVector<dataTypes::number,
+                                        dftfe::utils::MemorySpace::HOST> &Y2,
+      const unsigned int                                                  m,
+      const double                                                        a,
+      const double                                                        b,
+      const double                                                        a0);
+    template void
+    chebyshevFilterOverlapComputeCommunicationSinglePrec(
+      const std::shared_ptr<
+        dftfe::linearAlgebra::BLASWrapper<dftfe::utils::MemorySpace::HOST>>
+        &                                                BLASWrapperPtr,
+      operatorDFTClass<dftfe::utils::MemorySpace::HOST> &operatorMatrix,
+      dftfe::linearAlgebra::MultiVector<dataTypes::number,
+                                        dftfe::utils::MemorySpace::HOST> &X1,
+      dftfe::linearAlgebra::MultiVector<dataTypes::number,
+                                        dftfe::utils::MemorySpace::HOST> &Y1,
+      dftfe::linearAlgebra::MultiVector<dataTypes::number,
+                                        dftfe::utils::MemorySpace::HOST> &X2,
+      dftfe::linearAlgebra::MultiVector<dataTypes::number,
+                                        dftfe::utils::MemorySpace::HOST> &Y2,
+      dftfe::linearAlgebra::MultiVector<dataTypes::numberFP32,
+                                        dftfe::utils::MemorySpace::HOST> &X1_SP,
+      dftfe::linearAlgebra::MultiVector<dataTypes::numberFP32,
+                                        dftfe::utils::MemorySpace::HOST> &Y1_SP,
+      dftfe::linearAlgebra::MultiVector<dataTypes::numberFP32,
+                                        dftfe::utils::MemorySpace::HOST> &X2_SP,
+      dftfe::linearAlgebra::MultiVector<dataTypes::numberFP32,
+                                        dftfe::utils::MemorySpace::HOST> &Y2_SP,
+      std::vector<double> eigenvalues,
+      const unsigned int  m,
+      const double        a,
+      const double        b,
+      const double        a0);
+
 #ifdef DFTFE_WITH_DEVICE
     template void
     chebyshevFilter(
@@ -25,12 +25,18 @@ namespace dftfe
 {
   MixingScheme::MixingScheme(const MPI_Comm &   mpi_comm_parent,
                              const MPI_Comm &   mpi_comm_domain,
-                             const unsigned int verbosity)
+                             const unsigned int verbosity,
+                             const bool         useIncrementalGramMatrix,
+                             const bool         useModifiedBroyden)
     : d_mpi_comm_domain(mpi_comm_domain)
     , d_mpi_comm_parent(mpi_comm_parent)
     , pcout(std::cout,
             (dealii::Utilities::MPI::this_mpi_process(mpi_comm_parent) == 0))
+    , d_anyMixingParameterAdaptive(false)
     , d_verbosity(verbosity)
+    , d_useIncrementalGramMatrix(useIncrementalGramMatrix ||
+                                 useModifiedBroyden)
+    , d_useModifiedBroyden(useModifiedBroyden)
 
   {}
 
@@ -48,6 +54,7 @@ namespace dftfe
     d_variableHistoryResidual[mixingVariableList] = std::deque<
       dftfe::utils::MemoryStorage<double, dftfe::utils::MemorySpace::HOST>>();
     d_vectorDotProductWeights[mixingVariableList] = weightDotProducts;
+    d_residualGramMatrix.clear();
 
     d_performMPIReduce[mixingVariableList]     = performMPIReduce;
     d_mixingParameter[mixingVariableList]      = mixingValue;
@@ -165,6 +172,91 @@ namespace dftfe
       }
   }
 
+  void
+  MixingScheme::updateResidualGramMatrix(
+    const std::vector<mixingVariable> &mixingVariablesList)
+  {
+    if (!d_useIncrementalGramMatrix ||
+        mixingVariablesList != d_residualGramMatrixVariables)
+      {
+        d_residualGramMatrix.clear();
+        d_residualGramMatrixVariables = mixingVariablesList;
+      }
+
+    // the rows present belong to the oldest history entries as new entries
+    // are appended and popOldHistory removes the first row and column
+    const unsigned int historyLength =
+      d_variableHistoryResidual[mixingVariable::rho].size();
+    const unsigned int firstNewRow = d_residualGramMatrix.size();
+    if (firstNewRow >= historyLength)
+      return;
+
+    // the new rows are packed one after the other, with the contributions of
+    // variables without MPI reduction kept apart
+    const unsigned int numNewEntries =
+      (historyLength * (historyLength + 1) - firstNewRow * (firstNewRow + 1)) /
+      2;
+    std::vector<double> gramReduced(numNewEntries, 0.0);
+    std::vector<double> gramLocal(numNewEntries, 0.0);
+    std::vector<double> weightedResidual;
+    bool                isMPIAllReduce = false;
+    const unsigned int  inc            = 1;
+    for (const auto &key : mixingVariablesList)
+      {
+        if (!d_performMixing[key])
+          continue;
+        const auto &       residualHist      = d_variableHistoryResidual[key];
+        const auto &       weightDotProducts = d_vectorDotProductWeights[key];
+        const unsigned int numQuadPoints     = residualHist[0].size();
+        AssertThrow(numQuadPoints == weightDotProducts.size(),
+                    dealii::ExcMessage(
+                      "DFT-FE Error: The size of the weight dot products vec "
+                      "does not match the size of the vectors in history."
+                      "Please resize the vectors appropriately."));
+        isMPIAllReduce = isMPIAllReduce || d_performMPIReduce[key];
+        std::vector<double> &gram =
+          d_performMPIReduce[key] ? gramReduced : gramLocal;
+        if (numQuadPoints == 0)
+          continue;
+
+        // the weights are applied once to the new residual, the entries of
+        // its row are then dot products with the residual history itself
+        weightedResidual.resize(numQuadPoints);
+        unsigned int offset = 0;
+        for (unsigned int i = firstNewRow; i < historyLength; ++i)
+          {
+            for (unsigned int iQuad = 0; iQuad < numQuadPoints; ++iQuad)
+              weightedResidual[iQuad] =
+                weightDotProducts[iQuad] * residualHist[i][iQuad];
+            for (unsigned int j = 0; j <= i; ++j)
+              gram[offset + j] += ddot_(&numQuadPoints,
+                                        weightedResidual.data(),
+                                        &inc,
+                                        residualHist[j].data(),
+                                        &inc);
+            offset += i + 1;
+          }
+      }
+
+    if (isMPIAllReduce)
+      MPI_Allreduce(MPI_IN_PLACE,
+                    gramReduced.data(),
+                    numNewEntries,
+                    MPI_DOUBLE,
+                    MPI_SUM,
+                    d_mpi_comm_domain);
+
+    unsigned int offset = 0;
+    for (unsigned int i = firstNewRow; i < historyLength; ++i)
+      {
+        std::vector<double> row(i + 1);
+        for (unsigned int j = 0; j <= i; ++j)
+          row[j] = gramReduced[offset + j] + gramLocal[offset + j];
+        d_residualGramMatrix.push_back(row);
+        offset += i + 1;
+      }
+  }
+
   unsigned int
   MixingScheme::lengthOfHistory()
   {
@@ -179,6 +271,15 @@ namespace dftfe
     // initialize data structures
     // assumes rho is a mixing variable
     int N = d_variableHistoryIn[mixingVariable::rho].size() - 1;
+    if (d_useIncrementalGramMatrix)
+      updateResidualGramMatrix(mixingVariablesList);
+    auto gram = [this](const int i, const int j) {
+      return i >= j ? d_residualGramMatrix[i][j] : d_residualGramMatrix[j][i];
+    };
+
+    // norms of the successive residual differences F_{m+1}-F_m, which are
+    // normalized in the modified Broyden scheme
+    std::vector<double> residualDiffNorms(std::max(N, 0));
     if (N > 0)
       {
         int              NRHS = 1, lda = N, ldb = N, info;
@@ -190,22 +291,75 @@ namespace dftfe
         for (int i = 0; i < ldb * NRHS; i++)
           d_c[i] = 0.0;
 
-        for (const auto &key : mixingVariablesList)
+        if (d_useModifiedBroyden)
           {
-            computeMixingMatrices(d_variableHistoryIn[key],
-                                  d_variableHistoryResidual[key],
-                                  d_vectorDotProductWeights[key],
-                                  d_performMixing[key],
-                                  d_performMPIReduce[key],
-                                  d_A,
-                                  d_c);
+            // regularization weight w0 of the Broyden update
+            const double w0 = 0.01;
+            for (int m = 0; m < N; m++)
+              residualDiffNorms[m] =
+                std::sqrt(std::max(gram(m + 1, m + 1) - 2.0 * gram(m + 1, m) +
+                                     gram(m, m),
+                                   std::numeric_limits<double>::min()));
+            for (int m = 0; m < N; m++)
+              {
+                for (int k = 0; k < N; k++)
+                  d_A[k * N + m] =
+                    (gram(m + 1, k + 1) - gram(m + 1, k) - gram(m, k + 1) +
+                     gram(m, k)) /
+                    (residualDiffNorms[m] * residualDiffNorms[k]);
+                d_A[m * N + m] += w0 * w0;
+                d_c[m] = (gram(m + 1, N) - gram(m, N)) / residualDiffNorms[m];
+              }
           }
+        else if (d_useIncrementalGramMatrix)
+          {
+            const double gramNN = gram(N, N);
+            for (int m = 0; m < N; m++)
+              {
+                const double gramNm = gram(N, N - 1 - m);
+                for (int k = 0; k < N; k++)
+                  d_A[k * N + m] = gramNN - gramNm - gram(N, N - 1 - k) +
+                                   gram(N - 1 - m, N - 1 - k);
+                d_c[m] = gramNN - gramNm;
+              }
+          }
+        else
+          for (const auto &key : mixingVariablesList)
+            {
+              computeMixingMatrices(d_variableHistoryIn[key],
+                                    d_variableHistoryResidual[key],
+                                    d_vectorDotProductWeights[key],
+                                    d_performMixing[key],
+                                    d_performMPIReduce[key],
+                                    d_A,
+                                    d_c);
+            }
 
         dgesv_(&N, &NRHS, &d_A[0], &lda, &ipiv[0], &d_c[0], &ldb, &info);
       }
-    d_cFinal = 1.0;
-    for (int i = 0; i < N; i++)
-      d_cFinal -= d_c[i];
+    if (d_useModifiedBroyden)
+      {
+        // the Broyden update rho_n+alpha*F_n-sum_m gamma_m (Delta rho_m +
+        // alpha*Delta F_m) written as a combination of the history entries,
+        // the coefficient of the (N-1-i)^th entry being stored in d_c[i]
+        std::vector<double> coeffs(N + 1, 0.0);
+        coeffs[N] = 1.0;
+        for (int m = 0; m < N; m++)
+          {
+            const double gamma = d_c[m] / residualDiffNorms[m];
+            coeffs[m + 1] -= gamma;
+            coeffs[m] += gamma;
+          }
+        d_cFinal = coeffs[N];
+        for (int i = 0; i < N; i++)
+          d_c[i] = coeffs[N - 1 - i];
+      }
+    else
+      {
+        d_cFinal = 1.0;
+        for (int i = 0; i < N; i++)
+          d_cFinal -= d_c[i];
+      }
     computeAdaptiveAndersonMixingParameter();
   }
 
@@ -415,6 +569,7 @@ namespace dftfe
         d_variableHistoryIn[key].clear();
         d_variableHistoryResidual[key].clear();
       }
+    d_residualGramMatrix.clear();
   }
 
 
@@ -432,6 +587,12 @@ namespace dftfe
             d_variableHistoryIn[key].pop_front();
             d_variableHistoryResidual[key].pop_front();
           }
+        if (!d_residualGramMatrix.empty())
+          {
+            d_residualGramMatrix.pop_front();
+            for (auto &row : d_residualGramMatrix)
+              row.erase(row.begin());
+          }
       }
   }
 
@@ -194,7 +194,8 @@ main(int argc, char *argv[])
         runParams.optimizationSolver,
         runParams.coordinatesFileNEB,
         runParams.domainVectorsFileNEB,
-        runParams.ionRelaxFlagsFile);
+        runParams.ionRelaxFlagsFile,
+        runParams.numberImageGroups);
 
       int status = nebClass.findMEP();
     }
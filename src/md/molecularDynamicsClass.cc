@@ -117,6 +117,12 @@ namespace dftfe
     d_ThermostatType = d_dftPtr->getParametersObject().tempControllerTypeBOMD;
     d_numberGlobalCharges = d_dftPtr->getParametersObject().natoms;
     d_MaxWallTime         = d_dftPtr->getParametersObject().MaxWallTime;
+
+    d_wfcExtrapolatedForNextStep = false;
+    d_baselineFilterPasses       = 0;
+    d_baselineSteps              = 0;
+    d_extrapolatedFilterPasses   = 0;
+    d_extrapolatedSteps          = 0;
     pcout
       << "----------------------Starting Initialization of BOMD-------------------------"
       << std::endl;
@@ -334,6 +340,8 @@ namespace dftfe
         else if (d_dftPtr->getParametersObject().extrapolateDensity == 2 &&
                  d_dftPtr->getParametersObject().spinPolarized != 1)
           DensitySplitExtrapolation(0);
+        if (d_dftPtr->getParametersObject().extrapolateWfc)
+          WaveFunctionExtrapolation();
         double dt = d_TimeStep;
         for (int iCharge = 0; iCharge < d_numberGlobalCharges; iCharge++)
           {
@@ -1294,6 +1302,8 @@ namespace dftfe
     else if (d_dftPtr->getParametersObject().extrapolateDensity == 2 &&
              d_dftPtr->getParametersObject().spinPolarized != 1)
       DensitySplitExtrapolation(d_TimeIndex - d_startingTimeStep);
+    if (d_dftPtr->getParametersObject().extrapolateWfc)
+      WaveFunctionExtrapolation();
     // Call Force
     totalKE = 0.0;
     /* Second half of velocty verlet */
@@ -1713,6 +1723,8 @@ namespace dftfe
     else if (d_dftPtr->getParametersObject().extrapolateDensity == 2 &&
              d_dftPtr->getParametersObject().spinPolarized != 1)
       DensitySplitExtrapolation(0);
+    if (d_dftPtr->getParametersObject().extrapolateWfc)
+      WaveFunctionExtrapolation();
     /*if (dealii::Utilities::MPI::this_mpi_process(d_mpiCommParent) == 0)
       {
         std::string oldFolder1 = d_restartFilesPath + "/Step";
@@ -2030,6 +2042,54 @@ namespace dftfe
       }
   }
 
+  void
+  molecularDynamicsClass::WaveFunctionExtrapolation()
+  {
+    const unsigned int numberFilterPasses =
+      d_dftPtr->getNumberChebyshevFilterPassesLastSolve();
+    const bool wasExtrapolated = d_wfcExtrapolatedForNextStep;
+
+    const unsigned int numberStepsHistory =
+      d_dftPtr->extrapolateWaveFunctions();
+    d_wfcExtrapolatedForNextStep =
+      numberStepsHistory ==
+      d_dftPtr->getParametersObject().wfcExtrapolationOrder + 2;
+
+    // a history of one step means the last solve started from a fresh
+    // initial guess (first step or remeshing), not accounted for
+    if (numberStepsHistory == 1)
+      return;
+
+    if (wasExtrapolated)
+      {
+        d_extrapolatedFilterPasses += numberFilterPasses;
+        d_extrapolatedSteps += 1;
+      }
+    else
+      {
+        d_baselineFilterPasses += numberFilterPasses;
+        d_baselineSteps += 1;
+      }
+
+    pcout << "Chebyshev filtering passes in this step: " << numberFilterPasses
+          << (wasExtrapolated ? " (extrapolated wavefunctions)" :
+                                " (wavefunctions of previous step)")
+          << std::endl;
+    if (d_baselineSteps > 0 && d_extrapolatedSteps > 0)
+      {
+        const double baselineAverage =
+          double(d_baselineFilterPasses) / d_baselineSteps;
+        const double extrapolatedAverage =
+          double(d_extrapolatedFilterPasses) / d_extrapolatedSteps;
+        const double totalSaved =
+          baselineAverage * d_extrapolatedSteps - d_extrapolatedFilterPasses;
+        pcout << "Average Chebyshev filtering passes per step, without: "
+              << baselineAverage
+              << ", with extrapolation: " << extrapolatedAverage
+              << ", saved in total: " << totalSaved << std::endl;
+      }
+  }
+
 
 
 } // namespace dftfe
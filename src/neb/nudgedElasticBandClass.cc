@@ -44,7 +44,8 @@ namespace dftfe
     const std::string &optimizationSolver,
     const std::string &coordinatesFileNEB,
     const std::string &domainVectorsFileNEB,
-    const std::string &ionRelaxFlagsFile)
+    const std::string &ionRelaxFlagsFile,
+    const unsigned int numberImageGroups)
     : d_mpiCommParent(mpi_comm_parent)
     , d_this_mpi_process(
         dealii::Utilities::MPI::this_mpi_process(mpi_comm_parent))
@@ -65,8 +66,32 @@ namespace dftfe
     , d_optimizationSolver(optimizationSolver)
     , bfgsStepMethod(_bfgsStepMethod)
     , d_ionRelaxFlagsFile(ionRelaxFlagsFile)
+    , d_numberImageGroups(numberImageGroups)
 
   {
+    const unsigned int n_mpi_processes =
+      dealii::Utilities::MPI::n_mpi_processes(d_mpiCommParent);
+    AssertThrow(
+      d_numberImageGroups >= 1 && d_numberImageGroups <= d_numberOfImages,
+      dealii::ExcMessage(
+        "DFT-FE Error: NUMBER OF IMAGE GROUPS must be between 1 and NUMBER OF IMAGES."));
+    AssertThrow(
+      n_mpi_processes % d_numberImageGroups == 0,
+      dealii::ExcMessage(
+        "DFT-FE Error: Number of mpi tasks must be a multiple of NUMBER OF IMAGE GROUPS."));
+    d_imageGroupSize = n_mpi_processes / d_numberImageGroups;
+    d_imageGroupId   = d_this_mpi_process / d_imageGroupSize;
+    MPI_Comm_split(d_mpiCommParent,
+                   d_imageGroupId,
+                   d_this_mpi_process,
+                   &d_imageGroupComm);
+
+    d_dftfeWrapper.resize(d_numberOfImages);
+    d_imageFreeEnergy.resize(d_numberOfImages, 0.0);
+    d_imageEntropicEnergy.resize(d_numberOfImages, 0.0);
+    d_imageAtomPositionsCart.resize(d_numberOfImages);
+    d_imageForces.resize(d_numberOfImages);
+
     // Read Coordinates file and create coordinates for each image
 
     MPI_Barrier(d_mpiCommParent);
@@ -129,19 +154,41 @@ namespace dftfe
             dftUtils::writeDataIntoFile(domainVectors,
                                         domainVectorsFile,
                                         d_mpiCommParent);
+          }
+        // the files of an image may be read by a different image group
+        MPI_Barrier(d_mpiCommParent);
+
+        for (int Image = 0; Image < d_numberOfImages; Image++)
+          {
+            if (getImageGroupId(Image) != d_imageGroupId)
+              continue;
+            std::string coordinatesFile, domainVectorsFile;
+            coordinatesFile = d_restartFilesPath + "/Step0/Image" +
+                              std::to_string(Image) + "coordinates.inp";
+            domainVectorsFile = d_restartFilesPath + "/Step0/Image" +
+                                std::to_string(Image) + "domainVectors.inp";
 
-            d_dftfeWrapper.push_back(std::make_unique<dftfe::dftfeWrapper>(
+            // the image groups checkpoint concurrently, so every image
+            // writes its rho and wavefunction checkpoints into its own folder
+            const std::string imageRestartFolder =
+              d_restartFilesPath + "/Image" + std::to_string(Image);
+            if (dealii::Utilities::MPI::this_mpi_process(d_imageGroupComm) ==
+                0)
+              mkdir(imageRestartFolder.c_str(), ACCESSPERMS);
+            MPI_Barrier(d_imageGroupComm);
+
+            d_dftfeWrapper[Image] = std::make_unique<dftfe::dftfeWrapper>(
               parameter_file,
               coordinatesFile,
               domainVectorsFile,
-              d_mpiCommParent,
-              Image == 0 ? true : false,
+              d_imageGroupComm,
               Image == 0 ? true : false,
+              Image == d_imageGroupId ? true : false,
               "NEB",
-              d_restartFilesPath,
+              imageRestartFolder,
               d_verbosity < 4 ? -1 : d_verbosity,
               useDevice,
-              Image == 0 ? false : true));
+              Image == 0 ? false : true);
           }
       }
     else
@@ -175,6 +222,8 @@ namespace dftfe
 
         for (int Image = 0; Image < d_numberOfImages; Image++)
           {
+            if (getImageGroupId(Image) != d_imageGroupId)
+              continue;
             std::string coordinatesFile, domainVectorsFile;
             coordinatesFile = d_restartFilesPath + "/Step" +
                               std::to_string(d_totalUpdateCalls) + "/Image" +
@@ -187,21 +236,31 @@ namespace dftfe
                                 "domainBoundingVectorsCurrent.chk";
 
 
-            d_dftfeWrapper.push_back(std::make_unique<dftfe::dftfeWrapper>(
+            // the image groups checkpoint concurrently, so every image
+            // writes its rho and wavefunction checkpoints into its own folder
+            const std::string imageRestartFolder =
+              d_restartFilesPath + "/Image" + std::to_string(Image);
+            if (dealii::Utilities::MPI::this_mpi_process(d_imageGroupComm) ==
+                0)
+              mkdir(imageRestartFolder.c_str(), ACCESSPERMS);
+            MPI_Barrier(d_imageGroupComm);
+
+            d_dftfeWrapper[Image] = std::make_unique<dftfe::dftfeWrapper>(
               parameter_file,
               coordinatesFile,
               domainVectorsFile,
-              d_mpiCommParent,
-              Image == 0 ? true : false,
+              d_imageGroupComm,
               Image == 0 ? true : false,
+              Image == d_imageGroupId ? true : false,
               "NEB",
-              d_restartFilesPath,
+              imageRestartFolder,
               d_verbosity < 4 ? -1 : d_verbosity,
               useDevice,
-              Image == 0 ? false : true));
+              Image == 0 ? false : true);
           }
       }
-    d_dftPtr = d_dftfeWrapper[0]->getDftfeBasePtr();
+    // the first image owned by this image group
+    d_dftPtr = d_dftfeWrapper[d_imageGroupId]->getDftfeBasePtr();
     if (d_optimizationSolver == "BFGS")
       d_solver = 0;
     else if (d_optimizationSolver == "LBFGS")
@@ -236,6 +295,14 @@ namespace dftfe
   }
 
 
+  nudgedElasticBandClass::~nudgedElasticBandClass()
+  {
+    // the dftClass objects use the image group communicator
+    d_dftfeWrapper.clear();
+    MPI_Comm_free(&d_imageGroupComm);
+  }
+
+
   const MPI_Comm &
   nudgedElasticBandClass::getMPICommunicator()
   {
@@ -243,6 +310,123 @@ namespace dftfe
   }
 
 
+  unsigned int
+  nudgedElasticBandClass::getImageGroupId(const unsigned int image) const
+  {
+    return image % d_numberImageGroups;
+  }
+
+
+  void
+  nudgedElasticBandClass::exchangeImageData(const unsigned int image,
+                                            const bool isGroundStateConverged)
+  {
+    // free energy, entropic energy, convergence flag, positions and forces
+    std::vector<double> imageData(3 + 6 * d_numberGlobalCharges, 0.0);
+    if (getImageGroupId(image) == d_imageGroupId)
+      {
+        const std::vector<std::vector<double>> atomLocations =
+          (d_dftfeWrapper[image])->getAtomPositionsCart();
+        const std::vector<std::vector<double>> forceonAtoms =
+          (d_dftfeWrapper[image])->getForcesAtoms();
+        imageData[0] = (d_dftfeWrapper[image])->getDFTFreeEnergy();
+        imageData[1] = (d_dftfeWrapper[image])->getElectronicEntropicEnergy();
+        imageData[2] = isGroundStateConverged ? 1.0 : 0.0;
+        for (unsigned int iCharge = 0; iCharge < d_numberGlobalCharges;
+             ++iCharge)
+          for (unsigned int j = 0; j < 3; ++j)
+            {
+              imageData[3 + 3 * iCharge + j] = atomLocations[iCharge][j];
+              imageData[3 + 3 * d_numberGlobalCharges + 3 * iCharge + j] =
+                forceonAtoms[iCharge][j];
+            }
+      }
+    MPI_Bcast(imageData.data(),
+              imageData.size(),
+              MPI_DOUBLE,
+              getImageGroupId(image) * d_imageGroupSize,
+              d_mpiCommParent);
+
+    d_imageFreeEnergy[image]     = imageData[0];
+    d_imageEntropicEnergy[image] = imageData[1];
+    d_imageAtomPositionsCart[image].assign(d_numberGlobalCharges,
+                                           std::vector<double>(3, 0.0));
+    d_imageForces[image].assign(d_numberGlobalCharges,
+                                std::vector<double>(3, 0.0));
+    for (unsigned int iCharge = 0; iCharge < d_numberGlobalCharges; ++iCharge)
+      for (unsigned int j = 0; j < 3; ++j)
+        {
+          d_imageAtomPositionsCart[image][iCharge][j] =
+            imageData[3 + 3 * iCharge + j];
+          d_imageForces[image][iCharge][j] =
+            imageData[3 + 3 * d_numberGlobalCharges + 3 * iCharge + j];
+        }
+    if (imageData[2] < 0.5)
+      pcout << " NEB Warning!!: Ground State of Image: " << image
+            << " did not converge" << std::endl;
+  }
+
+
+  void
+  nudgedElasticBandClass::solveImages(
+    const std::vector<unsigned int> &images,
+    const std::map<unsigned int, std::vector<std::vector<double>>>
+      &        atomsDisplacements,
+    const bool computeImageErrors)
+  {
+    std::vector<std::vector<unsigned int>> imageGroupImages(
+      d_numberImageGroups);
+    for (unsigned int i = 0; i < images.size(); ++i)
+      imageGroupImages[getImageGroupId(images[i])].push_back(images[i]);
+    unsigned int numberRounds = 0;
+    for (unsigned int iGroup = 0; iGroup < d_numberImageGroups; ++iGroup)
+      numberRounds =
+        std::max(numberRounds, (unsigned int)imageGroupImages[iGroup].size());
+
+    for (unsigned int iRound = 0; iRound < numberRounds; ++iRound)
+      {
+        bool isGroundStateConverged = true;
+        if (iRound < imageGroupImages[d_imageGroupId].size())
+          {
+            const unsigned int image = imageGroupImages[d_imageGroupId][iRound];
+            auto displacementsIter   = atomsDisplacements.find(image);
+            if (displacementsIter != atomsDisplacements.end())
+              {
+                MPI_Barrier(d_imageGroupComm);
+                (d_dftfeWrapper[image])
+                  ->updateAtomPositions(displacementsIter->second);
+                if (d_verbosity > 4 &&
+                    !d_dftPtr->getParametersObject().reproducible_output)
+                  pcout << "--Positions of image: " << image << " updated--"
+                        << std::endl;
+                MPI_Barrier(d_imageGroupComm);
+              }
+            std::tuple<double, bool, double> groundStateOutput =
+              (d_dftfeWrapper[image])->computeDFTFreeEnergy(true, false);
+            isGroundStateConverged = std::get<1>(groundStateOutput);
+          }
+
+        std::vector<unsigned int> roundImages;
+        for (unsigned int iGroup = 0; iGroup < d_numberImageGroups; ++iGroup)
+          if (iRound < imageGroupImages[iGroup].size())
+            roundImages.push_back(imageGroupImages[iGroup][iRound]);
+        std::sort(roundImages.begin(), roundImages.end());
+
+        for (unsigned int i = 0; i < roundImages.size(); ++i)
+          exchangeImageData(roundImages[i], isGroundStateConverged);
+
+        if (computeImageErrors)
+          for (unsigned int i = 0; i < roundImages.size(); ++i)
+            {
+              double ForceError = 0.0;
+              d_NEBImageno      = roundImages[i];
+              ImageError(roundImages[i], ForceError);
+              d_ImageError[roundImages[i]] = ForceError;
+            }
+      }
+  }
+
+
   void
   nudgedElasticBandClass::CalculatePathTangent(int                  image,
                                                std::vector<double> &tangent)
@@ -252,15 +436,13 @@ namespace dftfe
       {
         std::vector<std::vector<double>> atomLocationsi, atomLocationsiminus,
           atomLocationsiplus;
-        atomLocationsi = (d_dftfeWrapper[image])->getAtomPositionsCart();
-        atomLocationsiminus =
-          (d_dftfeWrapper[image - 1])->getAtomPositionsCart();
-        atomLocationsiplus =
-          (d_dftfeWrapper[image + 1])->getAtomPositionsCart();
+        atomLocationsi      = d_imageAtomPositionsCart[image];
+        atomLocationsiminus = d_imageAtomPositionsCart[image - 1];
+        atomLocationsiplus  = d_imageAtomPositionsCart[image + 1];
         double GSEnergyminus, GSEnergyplus, GSEnergy;
-        GSEnergyminus = (d_dftfeWrapper[image - 1])->getDFTFreeEnergy();
-        GSEnergyplus  = (d_dftfeWrapper[image + 1])->getDFTFreeEnergy();
-        GSEnergy      = (d_dftfeWrapper[image])->getDFTFreeEnergy();
+        GSEnergyminus = d_imageFreeEnergy[image - 1];
+        GSEnergyplus  = d_imageFreeEnergy[image + 1];
+        GSEnergy      = d_imageFreeEnergy[image];
         if (GSEnergyplus > GSEnergy && GSEnergy > GSEnergyminus)
           {
             for (int iCharge = 0; iCharge < d_numberGlobalCharges; iCharge++)
@@ -435,9 +617,8 @@ namespace dftfe
     else if (image == 0)
       {
         std::vector<std::vector<double>> atomLocationsi, atomLocationsiplus;
-        atomLocationsi = (d_dftfeWrapper[image])->getAtomPositionsCart();
-        atomLocationsiplus =
-          (d_dftfeWrapper[image + 1])->getAtomPositionsCart();
+        atomLocationsi     = d_imageAtomPositionsCart[image];
+        atomLocationsiplus = d_imageAtomPositionsCart[image + 1];
         for (int iCharge = 0; iCharge < d_numberGlobalCharges; iCharge++)
           {
             for (int j = 0; j < 3; j++)
@@ -468,9 +649,8 @@ namespace dftfe
     else if (image == d_numberOfImages - 1)
       {
         std::vector<std::vector<double>> atomLocationsi, atomLocationsiminus;
-        atomLocationsi = (d_dftfeWrapper[image])->getAtomPositionsCart();
-        atomLocationsiminus =
-          (d_dftfeWrapper[image - 1])->getAtomPositionsCart();
+        atomLocationsi      = d_imageAtomPositionsCart[image];
+        atomLocationsiminus = d_imageAtomPositionsCart[image - 1];
         for (int iCharge = 0; iCharge < d_numberGlobalCharges; iCharge++)
           {
             for (int j = 0; j < 3; j++)
@@ -537,11 +717,9 @@ namespace dftfe
         std::vector<double>              v2(d_countrelaxationFlags, 0.0);
         std::vector<std::vector<double>> atomLocationsi, atomLocationsiminus,
           atomLocationsiplus;
-        atomLocationsi = (d_dftfeWrapper[image])->getAtomPositionsCart();
-        atomLocationsiminus =
-          (d_dftfeWrapper[image - 1])->getAtomPositionsCart();
-        atomLocationsiplus =
-          (d_dftfeWrapper[image + 1])->getAtomPositionsCart();
+        atomLocationsi      = d_imageAtomPositionsCart[image];
+        atomLocationsiminus = d_imageAtomPositionsCart[image - 1];
+        atomLocationsiplus  = d_imageAtomPositionsCart[image + 1];
         int count = 0;
         for (int iCharge = 0; iCharge < d_numberGlobalCharges; iCharge++)
           {
@@ -582,9 +760,8 @@ namespace dftfe
         std::vector<std::vector<double>> atomLocationsi, atomLocationsiminus,
           atomLocationsiplus;
         std::vector<double> v1(d_countrelaxationFlags, 0.0);
-        atomLocationsi = (d_dftfeWrapper[image])->getAtomPositionsCart();
-        atomLocationsiplus =
-          (d_dftfeWrapper[image + 1])->getAtomPositionsCart();
+        atomLocationsi     = d_imageAtomPositionsCart[image];
+        atomLocationsiplus = d_imageAtomPositionsCart[image + 1];
         int count = 0;
         for (int iCharge = 0; iCharge < d_numberGlobalCharges; iCharge++)
           {
@@ -614,9 +791,8 @@ namespace dftfe
         std::vector<std::vector<double>> atomLocationsi, atomLocationsiminus,
           atomLocationsplus;
         std::vector<double> v2(d_countrelaxationFlags, 0.0);
-        atomLocationsi = (d_dftfeWrapper[image])->getAtomPositionsCart();
-        atomLocationsiminus =
-          (d_dftfeWrapper[image - 1])->getAtomPositionsCart();
+        atomLocationsi      = d_imageAtomPositionsCart[image];
+        atomLocationsiminus = d_imageAtomPositionsCart[image - 1];
         int count = 0;
         for (int iCharge = 0; iCharge < d_numberGlobalCharges; iCharge++)
           {
@@ -655,8 +831,7 @@ namespace dftfe
   {
     if (true)
       {
-        std::vector<std::vector<double>> forceonAtoms =
-          (d_dftfeWrapper[image])->getForcesAtoms();
+        std::vector<std::vector<double>> forceonAtoms = d_imageForces[image];
         double       Innerproduct = 0.0;
         unsigned int count        = 0;
 
@@ -688,8 +863,7 @@ namespace dftfe
     const std::vector<double> &Forceparallel,
     const std::vector<double> &tangent)
   {
-    std::vector<std::vector<double>> forceonAtoms =
-      (d_dftfeWrapper[image])->getForcesAtoms();
+    std::vector<std::vector<double>> forceonAtoms = d_imageForces[image];
     unsigned int count = 0;
 
     for (int iCharge = 0; iCharge < d_numberGlobalCharges; iCharge++)
@@ -733,14 +907,13 @@ namespace dftfe
                   << " Free Energy(Ha) " << std::setw(16) << " Error(Ha/bohr) "
                   << std::endl;
           }
-        double maxEnergy = (d_dftfeWrapper[0])->getDFTFreeEnergy();
+        double maxEnergy = d_imageFreeEnergy[0];
         int    count     = 0;
         for (int image = 0; image < d_numberOfImages; image++)
           {
-            double FreeEnergy = (d_dftfeWrapper[image])->getDFTFreeEnergy();
+            double FreeEnergy = d_imageFreeEnergy[image];
             double InternalEnergy =
-              (d_dftfeWrapper[image])->getDFTFreeEnergy() +
-              (d_dftfeWrapper[image])->getElectronicEntropicEnergy();
+              d_imageFreeEnergy[image] + d_imageEntropicEnergy[image];
             double ForceError = d_ImageError[image];
             if (ForceError < 0.95 * d_optimizertolerance && d_imageFreeze &&
                 (image != 0 || image != d_numberOfImages - 1))
@@ -771,18 +944,15 @@ namespace dftfe
                         << std::floor(1000000000.0 * ForceError) / 1000000000.0
                         << std::endl;
               }
-            maxEnergy =
-              std::max(maxEnergy, (d_dftfeWrapper[image])->getDFTFreeEnergy());
+            maxEnergy = std::max(maxEnergy, d_imageFreeEnergy[image]);
           }
         if (!d_dftPtr->getParametersObject().reproducible_output)
           {
             pcout << "--> Activation Energy (meV): " << std::setprecision(8)
-                  << (maxEnergy - (d_dftfeWrapper[0])->getDFTFreeEnergy()) *
-                       C_haToeV * 1000
+                  << (maxEnergy - d_imageFreeEnergy[0]) * C_haToeV * 1000
                   << std::endl;
             pcout << "<-- Activation Energy (meV): " << std::setprecision(8)
-                  << (maxEnergy - (d_dftfeWrapper[d_numberOfImages - 1])
-                                    ->getDFTFreeEnergy()) *
+                  << (maxEnergy - d_imageFreeEnergy[d_numberOfImages - 1]) *
                        C_haToeV * 1000
                   << std::endl;
           }
@@ -790,15 +960,14 @@ namespace dftfe
           {
             pcout << "--> Activation Energy (meV): " << std::setprecision(4)
                   << std::floor(
-                       ((maxEnergy - (d_dftfeWrapper[0])->getDFTFreeEnergy()) *
+                       ((maxEnergy - d_imageFreeEnergy[0]) *
                         C_haToeV * 1000) /
                        1000000) *
                        1000000
                   << std::endl;
             pcout << "<-- Activation Energy (meV): " << std::setprecision(4)
                   << std::floor(
-                       ((maxEnergy - (d_dftfeWrapper[d_numberOfImages - 1])
-                                       ->getDFTFreeEnergy()) *
+                       ((maxEnergy - d_imageFreeEnergy[d_numberOfImages - 1]) *
                         C_haToeV * 1000) /
                        1000000) *
                        1000000
@@ -840,14 +1009,13 @@ namespace dftfe
           pcout << std::setw(12) << "Image No" << std::setw(25)
                 << " Free Energy(Ha) " << std::setw(16) << " Error(Ha/bohr) "
                 << std::endl;
-        double maxEnergy = (d_dftfeWrapper[0])->getDFTFreeEnergy();
+        double maxEnergy = d_imageFreeEnergy[0];
         int    count     = 0;
         for (int image = 0; image < d_numberOfImages; image++)
           {
-            double FreeEnergy = (d_dftfeWrapper[image])->getDFTFreeEnergy();
+            double FreeEnergy = d_imageFreeEnergy[image];
             double InternalEnergy =
-              (d_dftfeWrapper[image])->getDFTFreeEnergy() +
-              (d_dftfeWrapper[image])->getElectronicEntropicEnergy();
+              d_imageFreeEnergy[image] + d_imageEntropicEnergy[image];
             double ForceError = d_ImageError[image];
             if (ForceError < 0.95 * d_optimizertolerance && d_imageFreeze &&
                 (image != 0 || image != d_numberOfImages - 1))
@@ -878,18 +1046,15 @@ namespace dftfe
                         << std::floor(1000000000.0 * ForceError) / 1000000000.0
                         << std::endl;
               }
-            maxEnergy =
-              std::max(maxEnergy, (d_dftfeWrapper[image])->getDFTFreeEnergy());
+            maxEnergy = std::max(maxEnergy, d_imageFreeEnergy[image]);
           }
         if (!d_dftPtr->getParametersObject().reproducible_output)
           {
             pcout << "--> Activation Energy (meV): " << std::setprecision(8)
-                  << (maxEnergy - (d_dftfeWrapper[0])->getDFTFreeEnergy()) *
-                       C_haToeV * 1000
+                  << (maxEnergy - d_imageFreeEnergy[0]) * C_haToeV * 1000
                   << std::endl;
             pcout << "<-- Activation Energy (meV): " << std::setprecision(8)
-                  << (maxEnergy - (d_dftfeWrapper[d_numberOfImages - 1])
-                                    ->getDFTFreeEnergy()) *
+                  << (maxEnergy - d_imageFreeEnergy[d_numberOfImages - 1]) *
                        C_haToeV * 1000
                   << std::endl;
           }
@@ -897,15 +1062,14 @@ namespace dftfe
           {
             pcout << "--> Activation Energy (meV): " << std::setprecision(4)
                   << std::floor(
-                       ((maxEnergy - (d_dftfeWrapper[0])->getDFTFreeEnergy()) *
+                       ((maxEnergy - d_imageFreeEnergy[0]) *
                         C_haToeV * 1000) /
                        1000000) *
                        1000000
                   << std::endl;
             pcout << "<-- Activation Energy (meV): " << std::setprecision(4)
                   << std::floor(
-                       ((maxEnergy - (d_dftfeWrapper[d_numberOfImages - 1])
-                                       ->getDFTFreeEnergy()) *
+                       ((maxEnergy - d_imageFreeEnergy[d_numberOfImages - 1]) *
                         C_haToeV * 1000) /
                        1000000) *
                        1000000
@@ -977,14 +1141,13 @@ namespace dftfe
       pcout << std::setw(12) << "Image No" << std::setw(25)
             << " Free Energy(Ha) " << std::setw(16) << " Error(Ha/bohr) "
             << std::endl;
-    double maxEnergy = (d_dftfeWrapper[0])->getDFTFreeEnergy();
+    double maxEnergy = d_imageFreeEnergy[0];
     int    count     = 0;
     for (int image = 0; image < d_numberOfImages; image++)
       {
-        double FreeEnergy = (d_dftfeWrapper[image])->getDFTFreeEnergy();
+        double FreeEnergy = d_imageFreeEnergy[image];
         double InternalEnergy =
-          (d_dftfeWrapper[image])->getDFTFreeEnergy() +
-          (d_dftfeWrapper[image])->getElectronicEntropicEnergy();
+          d_imageFreeEnergy[image] + d_imageEntropicEnergy[image];
         double ForceError = d_ImageError[image];
         if (ForceError < 0.95 * d_optimizertolerance && d_imageFreeze &&
             (image != 0 || image != d_numberOfImages - 1))
@@ -1015,30 +1178,27 @@ namespace dftfe
                     << std::floor(1000000000.0 * ForceError) / 1000000000.0
                     << std::endl;
           }
-        maxEnergy =
-          std::max(maxEnergy, (d_dftfeWrapper[image])->getDFTFreeEnergy());
+        maxEnergy = std::max(maxEnergy, d_imageFreeEnergy[image]);
       }
     if (!d_dftPtr->getParametersObject().reproducible_output)
       {
         pcout << "--> Activation Energy (meV): " << std::setprecision(8)
-              << (maxEnergy - (d_dftfeWrapper[0])->getDFTFreeEnergy()) *
-                   C_haToeV * 1000
+              << (maxEnergy - d_imageFreeEnergy[0]) * C_haToeV * 1000
               << std::endl;
         pcout << "<-- Activation Energy (meV): " << std::setprecision(8)
               << (maxEnergy -
-                  (d_dftfeWrapper[d_numberOfImages - 1])->getDFTFreeEnergy()) *
+                  d_imageFreeEnergy[d_numberOfImages - 1]) *
                    C_haToeV * 1000
               << std::endl;
       }
     else
       {
         pcout << "--> Activation Energy (meV): " << std::setprecision(4)
-              << (maxEnergy - (d_dftfeWrapper[0])->getDFTFreeEnergy()) *
-                   C_haToeV * 1000
+              << (maxEnergy - d_imageFreeEnergy[0]) * C_haToeV * 1000
               << std::endl;
         pcout << "<-- Activation Energy (meV): " << std::setprecision(4)
               << (maxEnergy -
-                  (d_dftfeWrapper[d_numberOfImages - 1])->getDFTFreeEnergy()) *
+                  d_imageFreeEnergy[d_numberOfImages - 1]) *
                    C_haToeV * 1000
               << std::endl;
       }
@@ -1135,6 +1295,8 @@ namespace dftfe
   {
     std::vector<std::vector<double>> globalAtomsDisplacements(
       d_numberGlobalCharges, std::vector<double>(3, 0.0));
+    std::vector<unsigned int>                                imagesToSolve;
+    std::map<unsigned int, std::vector<std::vector<double>>> imageDisplacements;
 
     for (int image = 1; image < d_numberOfImages - 1; image++)
       {
@@ -1191,26 +1353,13 @@ namespace dftfe
 
         if (multiplier == 1)
           {
-            MPI_Barrier(d_mpiCommParent);
-            (d_dftfeWrapper[image])
-              ->updateAtomPositions(globalAtomsDisplacements);
-            if (d_verbosity > 4 &&
-                !d_dftPtr->getParametersObject().reproducible_output)
-              pcout << "--Positions of image: " << image << " updated--"
-                    << std::endl;
-            MPI_Barrier(d_mpiCommParent);
-            std::tuple<double, bool, double> groundStateOutput =
-              (d_dftfeWrapper[image])->computeDFTFreeEnergy(true, false);
-            if (!std::get<1>(groundStateOutput))
-              pcout << " NEB Warning!!: Ground State of Image: " << d_NEBImageno
-                    << " did not converge" << std::endl;
-            double ForceError = 0.0;
-            d_NEBImageno      = image;
-            ImageError(image, ForceError);
-            d_ImageError[image] = ForceError;
+            imagesToSolve.push_back(image);
+            imageDisplacements[image] = globalAtomsDisplacements;
           }
       }
 
+    solveImages(imagesToSolve, imageDisplacements, true);
+
     d_totalUpdateCalls += 1;
   }
 
@@ -1255,6 +1404,7 @@ namespace dftfe
 
         if (d_this_mpi_process == 0)
           mkdir(savePath.c_str(), ACCESSPERMS);
+        MPI_Barrier(d_mpiCommParent);
 
         std::vector<std::vector<double>> forceData(1,
                                                    std::vector<double>(1, 0.0));
@@ -1264,9 +1414,11 @@ namespace dftfe
                                     d_mpiCommParent);
         for (int i = 0; i < d_numberOfImages; i++)
           {
-            d_dftfeWrapper[i]->writeDomainAndAtomCoordinates(
-              savePath + "/Image" + std::to_string(i));
+            if (getImageGroupId(i) == d_imageGroupId)
+              d_dftfeWrapper[i]->writeDomainAndAtomCoordinates(
+                savePath + "/Image" + std::to_string(i));
           }
+        MPI_Barrier(d_mpiCommParent);
         d_nonLinearSolverPtr->save(savePath + "/ionRelax.chk");
 
 
@@ -1291,7 +1443,7 @@ namespace dftfe
     functionValue.clear();
 
     int midImage = d_numberOfImages / 2;
-    functionValue.push_back((d_dftfeWrapper[midImage])->getDFTFreeEnergy());
+    functionValue.push_back(d_imageFreeEnergy[midImage]);
   }
 
 
@@ -1314,8 +1466,8 @@ namespace dftfe
 
     for (int i = 0; i < d_numberOfImages - 1; i++)
       {
-        atomLocations        = (d_dftfeWrapper[i + 1])->getAtomPositionsCart();
-        atomLocationsInitial = (d_dftfeWrapper[i])->getAtomPositionsCart();
+        atomLocations        = d_imageAtomPositionsCart[i + 1];
+        atomLocationsInitial = d_imageAtomPositionsCart[i];
         double tempx, tempy, tempz, temp;
         temp = 0.0;
         for (int iCharge = 0; iCharge < d_numberGlobalCharges; iCharge++)
@@ -1364,12 +1516,12 @@ namespace dftfe
     Emin = 500;
     for (int image = 0; image < d_numberOfImages - 1; image++)
       {
-        Emax = std::max(Emax, (d_dftfeWrapper[image])->getDFTFreeEnergy());
-        Emin = std::min(Emin, (d_dftfeWrapper[image])->getDFTFreeEnergy());
+        Emax = std::max(Emax, d_imageFreeEnergy[image]);
+        Emin = std::min(Emin, d_imageFreeEnergy[image]);
       }
     deltaE = Emax - Emin;
 
-    Ei = (d_dftfeWrapper[NEBImage])->getDFTFreeEnergy();
+    Ei = d_imageFreeEnergy[NEBImage];
 
 
 
@@ -1406,7 +1558,7 @@ namespace dftfe
     for (int i = 0; i < d_numberOfImages; i++)
       {
         double Force  = d_ImageError[i];
-        double Energy = (d_dftfeWrapper[i])->getDFTFreeEnergy();
+        double Energy = d_imageFreeEnergy[i];
         if ((i > 0 && i < d_numberOfImages - 1))
           {
             if (Force < d_optimizertolerance)
@@ -1548,15 +1700,12 @@ namespace dftfe
     MPI_Barrier(d_mpiCommParent);
     step_time = MPI_Wtime();
 
+    std::vector<unsigned int> allImages(d_numberOfImages);
     for (int i = 0; i < d_numberOfImages; i++)
-      {
-        d_NEBImageno = i;
-        auto groundState =
-          (d_dftfeWrapper[d_NEBImageno])->computeDFTFreeEnergy(true, false);
-        if (!std::get<1>(groundState))
-          pcout << " NEB Warning!!: Ground State of Image: " << d_NEBImageno
-                << " did not converge" << std::endl;
-      }
+      allImages[i] = i;
+    solveImages(allImages,
+                std::map<unsigned int, std::vector<std::vector<double>>>(),
+                false);
     bool flag = true;
     if (!d_dftPtr->getParametersObject().reproducible_output)
       {
@@ -1579,7 +1728,7 @@ namespace dftfe
         d_NEBImageno = i;
         Force        = 0.0;
         ImageError(d_NEBImageno, Force);
-        double Energy = (d_dftfeWrapper[i])->getDFTFreeEnergy();
+        double Energy = d_imageFreeEnergy[i];
         if (!d_dftPtr->getParametersObject().reproducible_output)
           pcout << std::setw(8) << i << std::setw(25) << std::setprecision(14)
                 << Energy << std::setw(16) << std::setprecision(4)
@@ -0,0 +1,595 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2017-2022  The Regents of the University of Michigan and DFT-FE
+// authors.
+//
+// This file is part of the DFT-FE code.
+//
+// The DFT-FE code is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the DFT-FE distribution.
+//
+// ---------------------------------------------------------------------
+
+#include <poissonMultigridPreconditioner.h>
+#include <vectorUtilities.h>
+
+#include <algorithm>
+
+namespace dftfe
+{
+  void
+  poissonMGLevelOperator::reinit(
+    const dealii::MatrixFree<3, double> &matrixFreeData,
+    const unsigned int                   dofHandlerIndex,
+    const unsigned int                   quadratureIndex)
+  {
+    d_matrixFreeDataPtr = &matrixFreeData;
+    d_dofHandlerIndex   = dofHandlerIndex;
+    d_quadratureIndex   = quadratureIndex;
+  }
+
+  void
+  poissonMGLevelOperator::initialize_dof_vector(
+    distributedCPUVec<double> &vec) const
+  {
+    d_matrixFreeDataPtr->initialize_dof_vector(vec, d_dofHandlerIndex);
+  }
+
+  dealii::types::global_dof_index
+  poissonMGLevelOperator::m() const
+  {
+    return d_matrixFreeDataPtr->get_vector_partitioner(d_dofHandlerIndex)
+      ->size();
+  }
+
+  dealii::types::global_dof_index
+  poissonMGLevelOperator::n() const
+  {
+    return m();
+  }
+
+  void
+  poissonMGLevelOperator::AX(
+    const dealii::MatrixFree<3, double> &        matrixFreeData,
+    distributedCPUVec<double> &                  dst,
+    const distributedCPUVec<double> &            src,
+    const std::pair<unsigned int, unsigned int> &cell_range) const
+  {
+    dealii::VectorizedArray<double> quarter =
+      dealii::make_vectorized_array(1.0 / (4.0 * M_PI));
+
+    dealii::FEEvaluation<3, -1> fe_eval(matrixFreeData,
+                                        d_dofHandlerIndex,
+                                        d_quadratureIndex);
+
+    for (unsigned int cell = cell_range.first; cell < cell_range.second; ++cell)
+      {
+        fe_eval.reinit(cell);
+        fe_eval.read_dof_values(src);
+        fe_eval.evaluate(false, true);
+        for (unsigned int q = 0; q < fe_eval.n_q_points; ++q)
+          fe_eval.submit_gradient(fe_eval.get_gradient(q) * quarter, q);
+        fe_eval.integrate(false, true);
+        fe_eval.distribute_local_to_global(dst);
+      }
+  }
+
+  void
+  poissonMGLevelOperator::addConstrainedDofs(
+    distributedCPUVec<double> &      dst,
+    const distributedCPUVec<double> &src) const
+  {
+    const std::vector<unsigned int> &constrainedDofs =
+      d_matrixFreeDataPtr->get_constrained_dofs(d_dofHandlerIndex);
+    for (unsigned int i = 0; i < constrainedDofs.size(); ++i)
+      dst.local_element(constrainedDofs[i]) +=
+        src.local_element(constrainedDofs[i]);
+  }
+
+  void
+  poissonMGLevelOperator::vmult(distributedCPUVec<double> &      dst,
+                                const distributedCPUVec<double> &src) const
+  {
+    d_matrixFreeDataPtr->cell_loop(
+      &poissonMGLevelOperator::AX, this, dst, src, true);
+    addConstrainedDofs(dst, src);
+  }
+
+  void
+  poissonMGLevelOperator::Tvmult(distributedCPUVec<double> &      dst,
+                                 const distributedCPUVec<double> &src) const
+  {
+    vmult(dst, src);
+  }
+
+  void
+  poissonMGLevelOperator::vmult_add(distributedCPUVec<double> &      dst,
+                                    const distributedCPUVec<double> &src) const
+  {
+    d_matrixFreeDataPtr->cell_loop(
+      &poissonMGLevelOperator::AX, this, dst, src, false);
+    addConstrainedDofs(dst, src);
+  }
+
+  void
+  poissonMGLevelOperator::Tvmult_add(
+    distributedCPUVec<double> &      dst,
+    const distributedCPUVec<double> &src) const
+  {
+    vmult_add(dst, src);
+  }
+
+  void
+  poissonMGLevelOperator::computeInverseDiagonal(
+    const dealii::AffineConstraints<double> &constraintMatrix,
+    distributedCPUVec<double> &              inverseDiagonal) const
+  {
+    initialize_dof_vector(inverseDiagonal);
+    inverseDiagonal = 0;
+
+    const dealii::DoFHandler<3> &dofHandler =
+      d_matrixFreeDataPtr->get_dof_handler(d_dofHandlerIndex);
+
+    const dealii::Quadrature<3> &quadrature =
+      d_matrixFreeDataPtr->get_quadrature(d_quadratureIndex);
+    dealii::FEValues<3>    fe_values(dofHandler.get_fe(),
+                                  quadrature,
+                                  dealii::update_gradients |
+                                    dealii::update_JxW_values);
+    const unsigned int     dofs_per_cell   = dofHandler.get_fe().dofs_per_cell;
+    const unsigned int     num_quad_points = quadrature.size();
+    dealii::Vector<double> elementalDiagonalA(dofs_per_cell);
+    std::vector<dealii::types::global_dof_index> local_dof_indices(
+      dofs_per_cell);
+
+    typename dealii::DoFHandler<3>::active_cell_iterator
+      cell = dofHandler.begin_active(),
+      endc = dofHandler.end();
+    for (; cell != endc; ++cell)
+      if (cell->is_locally_owned())
+        {
+          fe_values.reinit(cell);
+
+          cell->get_dof_indices(local_dof_indices);
+
+          elementalDiagonalA = 0.0;
+          for (unsigned int i = 0; i < dofs_per_cell; ++i)
+            for (unsigned int q_point = 0; q_point < num_quad_points; ++q_point)
+              elementalDiagonalA(i) += (1.0 / (4.0 * M_PI)) *
+                                       (fe_values.shape_grad(i, q_point) *
+                                        fe_values.shape_grad(i, q_point)) *
+                                       fe_values.JxW(q_point);
+
+          constraintMatrix.distribute_local_to_global(elementalDiagonalA,
+                                                      local_dof_indices,
+                                                      inverseDiagonal);
+        }
+
+    inverseDiagonal.compress(dealii::VectorOperation::add);
+
+    for (unsigned int i = 0; i < inverseDiagonal.locally_owned_size(); ++i)
+      if (std::abs(inverseDiagonal.local_element(i)) > 1e-15)
+        inverseDiagonal.local_element(i) =
+          1.0 / inverseDiagonal.local_element(i);
+
+    // identity rows for the constrained dofs
+    const std::vector<unsigned int> &constrainedDofs =
+      d_matrixFreeDataPtr->get_constrained_dofs(d_dofHandlerIndex);
+    for (unsigned int i = 0; i < constrainedDofs.size(); ++i)
+      inverseDiagonal.local_element(constrainedDofs[i]) = 1.0;
+  }
+
+
+  //
+  // constructor
+  //
+  poissonMultigridPreconditioner::poissonMultigridPreconditioner(
+    const MPI_Comm &mpi_comm)
+    : d_activeHierarchyPtr(NULL)
+    , d_fineDofHandlerPtr(NULL)
+    , d_fineHangingPeriodicConstraintsPtr(NULL)
+    , d_constraintsParallelCheck(false)
+    , d_verbosity(0)
+    , mpi_communicator(mpi_comm)
+    , n_mpi_processes(dealii::Utilities::MPI::n_mpi_processes(mpi_comm))
+    , this_mpi_process(dealii::Utilities::MPI::this_mpi_process(mpi_comm))
+    , pcout(std::cout,
+            (dealii::Utilities::MPI::this_mpi_process(mpi_comm) == 0))
+  {}
+
+  void
+  poissonMultigridPreconditioner::clearMultigridData()
+  {
+    d_activeHierarchyPtr = NULL;
+    d_hierarchies.clear();
+  }
+
+  void
+  poissonMultigridPreconditioner::initializeLevels(
+    const dealii::DoFHandler<3> &            fineDofHandler,
+    const dealii::AffineConstraints<double> &fineHangingPeriodicConstraints,
+    const std::vector<std::vector<double>> & domainBoundingVectors,
+    const dftParameters &                    dftParams)
+  {
+    clearMultigridData();
+
+    d_fineDofHandlerPtr                 = &fineDofHandler;
+    d_fineHangingPeriodicConstraintsPtr = &fineHangingPeriodicConstraints;
+    d_constraintsParallelCheck = dftParams.constraintsParallelCheck;
+    d_verbosity                = dftParams.verbosity;
+    d_levelDegrees =
+      dealii::MGTransferGlobalCoarseningTools::
+        create_polynomial_coarsening_sequence(
+          fineDofHandler.get_fe().degree,
+          dealii::MGTransferGlobalCoarseningTools::
+            PolynomialCoarseningSequenceType::bisect);
+
+    const unsigned int maxLevel = d_levelDegrees.size() - 1;
+    d_levelDofHandlers.resize(0, maxLevel);
+    d_levelHangingPeriodicConstraints.resize(0, maxLevel);
+
+    std::vector<dealii::Tensor<1, 3>> offsetVectors(3);
+    for (unsigned int i = 0; i < 3; ++i)
+      for (unsigned int j = 0; j < 3; ++j)
+        offsetVectors[i][j] = -domainBoundingVectors[i][j];
+
+    const std::array<unsigned int, 3> periodic = {dftParams.periodicX,
+                                                  dftParams.periodicY,
+                                                  dftParams.periodicZ};
+
+    std::vector<int> periodicDirectionVector;
+    for (unsigned int d = 0; d < 3; ++d)
+      if (periodic[d] == 1)
+        periodicDirectionVector.push_back(d);
+
+    // the finest level uses the dofHandler and constraints of the fine problem
+    for (unsigned int level = 0; level < maxLevel; ++level)
+      {
+        dealii::DoFHandler<3> &dofHandler = d_levelDofHandlers[level];
+        dofHandler.reinit(fineDofHandler.get_triangulation());
+        dofHandler.distribute_dofs(dealii::FE_Q<3>(
+          dealii::QGaussLobatto<1>(d_levelDegrees[level] + 1)));
+
+        dealii::IndexSet locallyRelevantDofs;
+        dealii::DoFTools::extract_locally_relevant_dofs(dofHandler,
+                                                        locallyRelevantDofs);
+
+        dealii::AffineConstraints<double> &constraints =
+          d_levelHangingPeriodicConstraints[level];
+        constraints.clear();
+        constraints.reinit(locallyRelevantDofs);
+        dealii::DoFTools::make_hanging_node_constraints(dofHandler,
+                                                        constraints);
+
+        std::vector<dealii::GridTools::PeriodicFacePair<
+          typename dealii::DoFHandler<3>::cell_iterator>>
+          periodicity_vector;
+        for (unsigned int i = 0; i < periodicDirectionVector.size(); ++i)
+          dealii::GridTools::collect_periodic_faces(
+            dofHandler,
+            /*b_id1*/ 2 * i + 1,
+            /*b_id2*/ 2 * i + 2,
+            /*direction*/ periodicDirectionVector[i],
+            periodicity_vector,
+            offsetVectors[periodicDirectionVector[i]]);
+
+        dealii::DoFTools::make_periodicity_constraints<3, 3>(
+          periodicity_vector, constraints);
+
+        if (d_constraintsParallelCheck)
+          dftfe::vectorTools::makeAffineConstraintsConsistentInParallel(
+            dofHandler, constraints);
+        constraints.close();
+      }
+
+    if (d_verbosity >= 2)
+      {
+        pcout << "Poisson multigrid preconditioner levels (FE order, dofs):";
+        for (unsigned int level = 0; level < maxLevel; ++level)
+          pcout << " (" << d_levelDegrees[level] << ", "
+                << d_levelDofHandlers[level].n_dofs() << ")";
+        pcout << " (" << d_levelDegrees[maxLevel] << ", "
+              << fineDofHandler.n_dofs() << ")" << std::endl;
+      }
+  }
+
+  void
+  poissonMultigridPreconditioner::createLevelDirichletConstraints(
+    const std::vector<dealii::types::global_dof_index> &fineDirichletDofs,
+    const unsigned int                                  level,
+    dealii::AffineConstraints<double> &levelDirichletConstraints) const
+  {
+    const dealii::DoFHandler<3> &levelDofHandler = d_levelDofHandlers[level];
+    const dealii::FiniteElement<3> &levelFE      = levelDofHandler.get_fe();
+
+    auto isFineDirichletDof =
+      [&fineDirichletDofs](const dealii::types::global_dof_index dof) {
+        return std::binary_search(fineDirichletDofs.begin(),
+                                  fineDirichletDofs.end(),
+                                  dof);
+      };
+
+    auto addDirichletDof =
+      [&levelDirichletConstraints](const dealii::types::global_dof_index dof) {
+        if (!levelDirichletConstraints.is_constrained(dof))
+          levelDirichletConstraints.add_line(dof);
+      };
+
+    // the vertex dofs of FE_Q of any order are the first dofs of a cell and
+    // follow the same ordering, so a coarse vertex dof is a Dirichlet dof if
+    // the fine dof at the same vertex is. Coarse edge and face dofs are
+    // Dirichlet dofs if all the vertices of the edge or face are.
+    const unsigned int verticesPerCell =
+      dealii::GeometryInfo<3>::vertices_per_cell;
+    const unsigned int linesPerCell = dealii::GeometryInfo<3>::lines_per_cell;
+    const unsigned int facesPerCell = dealii::GeometryInfo<3>::faces_per_cell;
+    const unsigned int verticesPerFace =
+      dealii::GeometryInfo<3>::vertices_per_face;
+
+    std::vector<bool> isVertexDirichlet(verticesPerCell);
+    typename dealii::DoFHandler<3>::active_cell_iterator
+      cell = d_fineDofHandlerPtr->begin_active(),
+      endc = d_fineDofHandlerPtr->end();
+    for (; cell != endc; ++cell)
+      if (cell->is_locally_owned() || cell->is_ghost())
+        {
+          bool isCellTouchingDirichlet = false;
+          for (unsigned int v = 0; v < verticesPerCell; ++v)
+            {
+              isVertexDirichlet[v] =
+                isFineDirichletDof(cell->vertex_dof_index(v, 0));
+              isCellTouchingDirichlet =
+                isCellTouchingDirichlet || isVertexDirichlet[v];
+            }
+
+          if (!isCellTouchingDirichlet)
+            continue;
+
+          typename dealii::DoFHandler<3>::active_cell_iterator levelCell(
+            &(d_fineDofHandlerPtr->get_triangulation()),
+            cell->level(),
+            cell->index(),
+            &levelDofHandler);
+
+          for (unsigned int v = 0; v < verticesPerCell; ++v)
+            if (isVertexDirichlet[v])
+              addDirichletDof(levelCell->vertex_dof_index(v, 0));
+
+          for (unsigned int l = 0; l < linesPerCell; ++l)
+            if (isVertexDirichlet[dealii::GeometryInfo<
+                  3>::line_to_cell_vertices(l, 0)] &&
+                isVertexDirichlet[dealii::GeometryInfo<
+                  3>::line_to_cell_vertices(l, 1)])
+              for (unsigned int i = 0; i < levelFE.n_dofs_per_line(); ++i)
+                addDirichletDof(levelCell->line(l)->dof_index(i));
+
+          for (unsigned int f = 0; f < facesPerCell; ++f)
+            {
+              bool isFaceDirichlet = true;
+              for (unsigned int v = 0; v < verticesPerFace; ++v)
+                isFaceDirichlet =
+                  isFaceDirichlet &&
+                  isVertexDirichlet[dealii::GeometryInfo<
+                    3>::face_to_cell_vertices(f, v)];
+
+              if (isFaceDirichlet)
+                for (unsigned int i = 0; i < levelFE.n_dofs_per_quad(f); ++i)
+                  addDirichletDof(levelCell->face(f)->dof_index(i));
+            }
+        }
+  }
+
+  void
+  poissonMultigridPreconditioner::setupHierarchy(
+    const dealii::AffineConstraints<double> &constraintMatrix,
+    multigridHierarchy &                     hierarchy) const
+  {
+    const unsigned int maxLevel = d_levelDegrees.size() - 1;
+    hierarchy.levelConstraints.resize(0, maxLevel);
+    hierarchy.levelMatrixFreeData.resize(0, maxLevel);
+    hierarchy.levelOperators.resize(0, maxLevel);
+    hierarchy.levelTransfers.resize(0, maxLevel);
+
+    // finest level: homogeneous copy of the fine problem constraints
+    hierarchy.levelConstraints[maxLevel].copy_from(constraintMatrix);
+    for (const auto &line : constraintMatrix.get_lines())
+      hierarchy.levelConstraints[maxLevel].set_inhomogeneity(line.index, 0.0);
+    hierarchy.levelOperators[maxLevel].reinit(*hierarchy.matrixFreeDataPtr,
+                                              hierarchy.dofHandlerIndex,
+                                              hierarchy.quadratureIndex);
+
+    typename dealii::MatrixFree<3>::AdditionalData additional_data;
+    additional_data.tasks_parallel_scheme =
+      dealii::MatrixFree<3>::AdditionalData::none;
+    additional_data.mapping_update_flags =
+      dealii::update_gradients | dealii::update_JxW_values;
+
+    for (unsigned int level = 0; level < maxLevel; ++level)
+      {
+        dealii::IndexSet locallyRelevantDofs;
+        dealii::DoFTools::extract_locally_relevant_dofs(
+          d_levelDofHandlers[level], locallyRelevantDofs);
+
+        dealii::AffineConstraints<double> &constraints =
+          hierarchy.levelConstraints[level];
+        constraints.clear();
+        constraints.reinit(locallyRelevantDofs);
+        createLevelDirichletConstraints(hierarchy.fineDirichletDofs,
+                                        level,
+                                        constraints);
+        constraints.merge(
+          d_levelHangingPeriodicConstraints[level],
+          dealii::AffineConstraints<
+            double>::MergeConflictBehavior::left_object_wins);
+        if (d_constraintsParallelCheck)
+          dftfe::vectorTools::makeAffineConstraintsConsistentInParallel(
+            d_levelDofHandlers[level], constraints);
+        constraints.close();
+
+        hierarchy.levelMatrixFreeData[level].reinit(
+          dealii::MappingQ1<3, 3>(),
+          d_levelDofHandlers[level],
+          constraints,
+          dealii::QGauss<1>(d_levelDegrees[level] + 1),
+          additional_data);
+        hierarchy.levelOperators[level].reinit(
+          hierarchy.levelMatrixFreeData[level], 0, 0);
+      }
+
+    for (unsigned int level = 1; level <= maxLevel; ++level)
+      hierarchy.levelTransfers[level].reinit(
+        level == maxLevel ? *d_fineDofHandlerPtr : d_levelDofHandlers[level],
+        d_levelDofHandlers[level - 1],
+        hierarchy.levelConstraints[level],
+        hierarchy.levelConstraints[level - 1]);
+
+    hierarchy.transferPtr = std::make_unique<
+      dealii::MGTransferGlobalCoarsening<3, distributedCPUVec<double>>>(
+      hierarchy.levelTransfers,
+      [&hierarchy](const unsigned int level, distributedCPUVec<double> &vec) {
+        hierarchy.levelOperators[level].initialize_dof_vector(vec);
+      });
+
+    // Chebyshev smoothers preconditioned with the inverse diagonal. The
+    // linear level is solved approximately by a Chebyshev iteration whose
+    // degree is chosen to reduce the residual by the smoothing range.
+    dealii::MGLevelObject<typename smootherType::AdditionalData> smootherData(
+      0, maxLevel);
+    for (unsigned int level = 0; level <= maxLevel; ++level)
+      {
+        smootherData[level].preconditioner = std::make_shared<
+          dealii::DiagonalMatrix<distributedCPUVec<double>>>();
+        hierarchy.levelOperators[level].computeInverseDiagonal(
+          hierarchy.levelConstraints[level],
+          smootherData[level].preconditioner->get_vector());
+        if (level > 0)
+          {
+            smootherData[level].smoothing_range     = 20.0;
+            smootherData[level].degree              = 5;
+            smootherData[level].eig_cg_n_iterations = 20;
+          }
+        else
+          {
+            smootherData[level].smoothing_range = 1e-3;
+            smootherData[level].degree = dealii::numbers::invalid_unsigned_int;
+            smootherData[level].eig_cg_n_iterations =
+              std::min(hierarchy.levelOperators[level].m(),
+                       (dealii::types::global_dof_index)100);
+          }
+      }
+
+    hierarchy.mgMatrixPtr =
+      std::make_unique<dealii::mg::Matrix<distributedCPUVec<double>>>(
+        hierarchy.levelOperators);
+
+    hierarchy.mgSmootherPtr = std::make_unique<
+      dealii::MGSmootherPrecondition<poissonMGLevelOperator,
+                                     smootherType,
+                                     distributedCPUVec<double>>>();
+    hierarchy.mgSmootherPtr->initialize(hierarchy.levelOperators,
+                                        smootherData);
+
+    hierarchy.mgCoarsePtr = std::make_unique<
+      dealii::MGCoarseGridApplySmoother<distributedCPUVec<double>>>();
+    hierarchy.mgCoarsePtr->initialize(*hierarchy.mgSmootherPtr);
+
+    hierarchy.mgPtr =
+      std::make_unique<dealii::Multigrid<distributedCPUVec<double>>>(
+        *hierarchy.mgMatrixPtr,
+        *hierarchy.mgCoarsePtr,
+        *hierarchy.transferPtr,
+        *hierarchy.mgSmootherPtr,
+        *hierarchy.mgSmootherPtr,
+        0,
+        maxLevel);
+
+    hierarchy.preconditionerPtr = std::make_unique<dealii::PreconditionMG<
+      3,
+      distributedCPUVec<double>,
+      dealii::MGTransferGlobalCoarsening<3, distributedCPUVec<double>>>>(
+      *d_fineDofHandlerPtr, *hierarchy.mgPtr, *hierarchy.transferPtr);
+  }
+
+  void
+  poissonMultigridPreconditioner::reinit(
+    const dealii::MatrixFree<3, double> &    matrixFreeData,
+    const unsigned int                       dofHandlerIndex,
+    const unsigned int                       quadratureIndex,
+    const dealii::AffineConstraints<double> &constraintMatrix)
+  {
+    AssertThrow(
+      d_fineDofHandlerPtr == &(matrixFreeData.get_dof_handler(dofHandlerIndex)),
+      dealii::ExcMessage(
+        "DFT-FE Error: Poisson multigrid levels were initialized for a different dofHandler."));
+
+    // the Dirichlet dofs are the dofs which are constrained by the fine
+    // problem but are neither hanging nor periodic. A hanging or periodic
+    // dof whose master dofs are Dirichlet dofs has no constraint entries
+    // after closing, but keeps its hanging or periodic constraint on the
+    // coarse levels.
+    std::vector<dealii::types::global_dof_index> fineDirichletDofs;
+    for (const auto &line : constraintMatrix.get_lines())
+      if (!d_fineHangingPeriodicConstraintsPtr->is_constrained(line.index))
+        fineDirichletDofs.push_back(line.index);
+    std::sort(fineDirichletDofs.begin(), fineDirichletDofs.end());
+
+    // look for a hierarchy set up for the same fine problem on all the
+    // processors
+    std::vector<int> isSameFineProblem(d_hierarchies.size(), 0);
+    for (unsigned int i = 0; i < d_hierarchies.size(); ++i)
+      isSameFineProblem[i] =
+        d_hierarchies[i]->matrixFreeDataPtr == &matrixFreeData &&
+        d_hierarchies[i]->dofHandlerIndex == dofHandlerIndex &&
+        d_hierarchies[i]->quadratureIndex == quadratureIndex &&
+        d_hierarchies[i]->fineDirichletDofs == fineDirichletDofs;
+    MPI_Allreduce(MPI_IN_PLACE,
+                  isSameFineProblem.data(),
+                  isSameFineProblem.size(),
+                  MPI_INT,
+                  MPI_MIN,
+                  mpi_communicator);
+    for (unsigned int i = 0; i < d_hierarchies.size(); ++i)
+      if (isSameFineProblem[i] == 1)
+        {
+          d_activeHierarchyPtr = d_hierarchies[i].get();
+          return;
+        }
+
+    MPI_Barrier(mpi_communicator);
+    double time = MPI_Wtime();
+
+    d_hierarchies.push_back(std::make_unique<multigridHierarchy>());
+    multigridHierarchy &hierarchy = *d_hierarchies.back();
+    hierarchy.matrixFreeDataPtr   = &matrixFreeData;
+    hierarchy.dofHandlerIndex     = dofHandlerIndex;
+    hierarchy.quadratureIndex     = quadratureIndex;
+    hierarchy.fineDirichletDofs.swap(fineDirichletDofs);
+    setupHierarchy(constraintMatrix, hierarchy);
+    d_activeHierarchyPtr = &hierarchy;
+
+    MPI_Barrier(mpi_communicator);
+    time = MPI_Wtime() - time;
+    if (d_verbosity >= 4)
+      pcout << "Time for Poisson multigrid preconditioner setup: " << time
+            << std::endl;
+  }
+
+  void
+  poissonMultigridPreconditioner::vmult(
+    distributedCPUVec<double> &      dst,
+    const distributedCPUVec<double> &src) const
+  {
+    d_activeHierarchyPtr->preconditionerPtr->vmult(dst, src);
+  }
+
+  bool
+  poissonMultigridPreconditioner::isInitialized() const
+  {
+    return d_activeHierarchyPtr != NULL;
+  }
+
+} // namespace dftfe
@@ -126,6 +126,12 @@ namespace dftfe
     if (isComputeDiagonalA)
       computeDiagonalA();
 
+    if (isComputeDiagonalA && d_mgPreconditionerPtr)
+      d_mgPreconditionerPtr->reinit(*d_matrixFreeDataPtr,
+                                    matrixFreeVectorComponent,
+                                    matrixFreeQuadratureComponentAX,
+                                    constraintMatrix);
+
     if (!d_isFastConstraintsInitialized || reinitializeFastConstraints)
       {
         d_constraintsInfo.initialize(
@@ -433,6 +439,27 @@ namespace dftfe
         d_diagonalA.local_element(i) * src.local_element(i);
   }
 
+  template <unsigned int FEOrder, unsigned int FEOrderElectro>
+  void
+  poissonSolverProblem<FEOrder, FEOrderElectro>::precondition(
+    distributedCPUVec<double> &      dst,
+    const distributedCPUVec<double> &src,
+    const double                     omega) const
+  {
+    if (d_mgPreconditionerPtr && d_mgPreconditionerPtr->isInitialized())
+      d_mgPreconditionerPtr->vmult(dst, src);
+    else
+      precondition_Jacobi(dst, src, omega);
+  }
+
+  template <unsigned int FEOrder, unsigned int FEOrderElectro>
+  void
+  poissonSolverProblem<FEOrder, FEOrderElectro>::setMultigridPreconditioner(
+    const std::shared_ptr<poissonMultigridPreconditioner> &mgPreconditionerPtr)
+  {
+    d_mgPreconditionerPtr = mgPreconditionerPtr;
+  }
+
   // Compute and fill value at mean value constrained dof
   // u_o= -\sum_{i \neq o} a_i * u_i where i runs over all dofs
   // except the mean value constrained dof (o^{th})
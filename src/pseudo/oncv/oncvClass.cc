@@ -112,8 +112,10 @@ namespace dftfe
   } // namespace internal
   template <typename ValueType, dftfe::utils::MemorySpace memorySpace>
   oncvClass<ValueType, memorySpace>::oncvClass(
-    const MPI_Comm &                            mpi_comm_parent,
-    const std::string &                         scratchFolderName,
+    const MPI_Comm &mpi_comm_parent,
+    const std::map<unsigned int,
+                   std::shared_ptr<const pseudoUtils::pseudoPotentialData>>
+      &                                         pseudoPotentialData,
     const std::set<unsigned int> &              atomTypes,
     const bool                                  floatingNuclearCharges,
     const unsigned int                          nOMPThreads,
@@ -127,7 +129,7 @@ namespace dftfe
     , pcout(std::cout,
             (dealii::Utilities::MPI::this_mpi_process(mpi_comm_parent) == 0))
   {
-    d_dftfeScratchFolderName = scratchFolderName;
+    d_pseudoPotentialData    = pseudoPotentialData;
     d_atomTypes              = atomTypes;
     d_floatingNuclearCharges = floatingNuclearCharges;
     d_nOMPThreads            = nOMPThreads;
@@ -152,26 +154,18 @@ namespace dftfe
          it != d_atomTypes.end();
          ++it)
       {
-        unsigned int atomicNumber = *it;
-        char         valenceDataFile[256];
-        strcpy(valenceDataFile,
-               (d_dftfeScratchFolderName + "/z" + std::to_string(*it) +
-                "/density.inp")
-                 .c_str());
-        char coreDataFile[256];
-        strcpy(coreDataFile,
-               (d_dftfeScratchFolderName + "/z" + std::to_string(*it) +
-                "/coreDensity.inp")
-                 .c_str());
+        unsigned int                            atomicNumber = *it;
+        const pseudoUtils::pseudoPotentialData &pseudoData =
+          *d_pseudoPotentialData.at(atomicNumber);
 
         for (unsigned int i = 0; i < d_nOMPThreads; i++)
           {
             d_atomicValenceDensityVector[i][*it] = std::make_shared<
               AtomCenteredSphericalFunctionValenceDensitySpline>(
-              valenceDataFile, 1E-10, false);
+              pseudoData.valenceDensity, 1E-10, false);
             d_atomicCoreDensityVector[i][*it] =
               std::make_shared<AtomCenteredSphericalFunctionCoreDensitySpline>(
-                coreDataFile, 1E-12, true);
+                pseudoData.coreDensity, 1E-12, true);
           }
         if (d_atomicCoreDensityVector[0][atomicNumber]->isDataPresent())
           d_atomTypeCoreFlagMap[atomicNumber] = true;
@@ -455,15 +449,8 @@ namespace dftfe
         unsigned int numTotalProjectors =
           d_atomicProjectorFnsContainer
             ->getTotalNumberOfSphericalFunctionsPerAtom(Znum);
-        char denominatorDataFileName[256];
-        strcpy(denominatorDataFileName,
-               (d_dftfeScratchFolderName + "/z" + std::to_string(Znum) + "/" +
-                "denom.dat")
-                 .c_str());
-        std::vector<std::vector<double>> denominator(0);
-        dftUtils::readFile(numRadProjectors,
-                           denominator,
-                           denominatorDataFileName);
+        const std::vector<std::vector<double>> &denominator =
+          d_pseudoPotentialData.at(Znum)->couplingMatrix;
         std::vector<double> pseudoPotentialConstants(numTotalProjectors, 0.0);
         unsigned int        ProjId = 0;
         for (unsigned int iProj = 0; iProj < numRadProjectors; iProj++)
@@ -491,109 +478,38 @@ namespace dftfe
             memorySpace>::createAtomCenteredSphericalFunctionsForProjectors()
   {
     d_atomicProjectorFnsVector.clear();
-    std::vector<std::vector<int>> projectorIdDetails;
-    std::vector<std::vector<int>> atomicFunctionIdDetails;
     for (std::set<unsigned int>::iterator it = d_atomTypes.begin();
          it != d_atomTypes.end();
          ++it)
       {
-        char         pseudoAtomDataFile[256];
-        unsigned int cumulativeSplineId = 0;
-        strcpy(pseudoAtomDataFile,
-               (d_dftfeScratchFolderName + "/z" + std::to_string(*it) +
-                "/PseudoAtomDat")
-                 .c_str());
-
-        unsigned int  Znum = *it;
-        std::ifstream readPseudoDataFileNames(pseudoAtomDataFile);
-        unsigned int  numberOfProjectors;
-        unsigned int  socFlag;
-        readPseudoDataFileNames >> numberOfProjectors;
-        readPseudoDataFileNames >> socFlag;
-        readPseudoDataFileNames.ignore();
-        projectorIdDetails.resize(numberOfProjectors);
-        std::string   readLine;
-        std::set<int> radFunctionIds;
-        unsigned int  maxCount = socFlag == 1 ? 4 : 3;
-        d_hasSOC               = socFlag == 1;
-        atomicFunctionIdDetails.resize(numberOfProjectors);
-        for (unsigned int i = 0; i < numberOfProjectors; ++i)
-          {
-            std::vector<int> &radAndAngularFunctionId =
-              atomicFunctionIdDetails[i];
-            radAndAngularFunctionId.resize(3, 0);
-            std::getline(readPseudoDataFileNames, readLine);
-
-            std::istringstream lineString(readLine);
-            unsigned int       count = 0;
-            int                Id;
-            double             mollifierRadius;
-            std::string        dummyString;
-            while (lineString >> dummyString)
-              {
-                if (count < maxCount)
-                  {
-                    Id = atoi(dummyString.c_str());
-
-                    if (count == 1)
-                      radFunctionIds.insert(Id);
-                    radAndAngularFunctionId[count] = Id;
-                    if (socFlag == 1)
-                      {
-                        d_atomicProjectorFnsljmValues[Znum][i][count] =
-                          std::stod(dummyString.c_str());
-                      }
-                  }
+        unsigned int                            Znum = *it;
+        const pseudoUtils::pseudoPotentialData &pseudoData =
+          *d_pseudoPotentialData.at(Znum);
+        d_hasSOC = pseudoData.hasSOC;
+        if (d_hasSOC)
+          for (unsigned int i = 0; i < pseudoData.projectorIds.size(); ++i)
+            for (unsigned int count = 0; count < 4; ++count)
+              d_atomicProjectorFnsljmValues[Znum][i][count] =
+                pseudoData.projectorIds[i][count];
 
-                if (count >= maxCount)
-                  {
-                    std::cerr << "Invalid argument in the SingleAtomData file"
-                              << std::endl;
-                    exit(-1);
-                  }
-
-                count++;
-              }
-          }
-        std::string  tempProjRadialFunctionFileName;
-        unsigned int numProj;
         unsigned int alpha = 0;
-        for (std::set<int>::iterator i = radFunctionIds.begin();
-             i != radFunctionIds.end();
-             ++i)
+        for (unsigned int i = 0; i < pseudoData.radialProjectors.size(); ++i)
           {
-            char         projRadialFunctionFileName[512];
-            unsigned int lQuantumNo = *i;
-            readPseudoDataFileNames >> tempProjRadialFunctionFileName;
-            readPseudoDataFileNames >> numProj;
-            strcpy(projRadialFunctionFileName,
-                   (d_dftfeScratchFolderName + "/z" + std::to_string(*it) +
-                    "/" + tempProjRadialFunctionFileName)
-                     .c_str());
-
-            //
-            // 2D vector to store the radial coordinate and its
-            // corresponding function value
-            std::vector<std::vector<double>> radialFunctionData(0);
+            unsigned int lQuantumNo = pseudoData.radialProjectors[i].first;
 
             //
-            // read the radial function file
-            //
-            dftUtils::readFile(numProj + 1,
-                               radialFunctionData,
-                               projRadialFunctionFileName);
+            // 2D vector of the radial coordinate and the corresponding
+            // values of the radial projectors with this l
+            const std::vector<std::vector<double>> &radialFunctionData =
+              pseudoData.radialProjectors[i].second;
+            const unsigned int numProj = radialFunctionData[0].size() - 1;
 
             for (int j = 1; j < numProj + 1; j++)
               {
                 d_atomicProjectorFnsMap[std::make_pair(Znum, alpha)] =
                   std::make_shared<
                     AtomCenteredSphericalFunctionProjectorSpline>(
-                    projRadialFunctionFileName,
-                    lQuantumNo,
-                    0,
-                    j,
-                    numProj + 1,
-                    1E-12);
+                    radialFunctionData, lQuantumNo, 0, j, 1E-12);
                 alpha++;
               }
           } // i loop
@@ -616,15 +532,10 @@ namespace dftfe
          ++it)
       {
         unsigned int atomicNumber = *it;
-        char         LocalDataFile[256];
-        strcpy(LocalDataFile,
-               (d_dftfeScratchFolderName + "/z" + std::to_string(*it) +
-                "/locPot.dat")
-                 .c_str());
         for (unsigned int i = 0; i < d_nOMPThreads; i++)
           d_atomicLocalPotVector[i][*it] =
             std::make_shared<AtomCenteredSphericalFunctionLocalPotentialSpline>(
-              LocalDataFile,
+              d_pseudoPotentialData.at(atomicNumber)->localPotential,
               d_atomTypeAtributes[*it],
               d_reproducible_output ? 1.0e-8 : 1.0e-7,
               d_reproducible_output ? 8.0001 : 10.0001);
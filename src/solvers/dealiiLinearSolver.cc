@@ -118,7 +118,7 @@ namespace dftfe
 
                 if (it > 1)
                   {
-                    problem.precondition_Jacobi(hvec, gvec, omega);
+                    problem.precondition(hvec, gvec, omega);
                     beta = gh;
                     AssertThrow(std::abs(beta) != 0.,
                                 dealii::ExcMessage("Division by zero\n"));
@@ -128,7 +128,7 @@ namespace dftfe
                   }
                 else
                   {
-                    problem.precondition_Jacobi(hvec, gvec, omega);
+                    problem.precondition(hvec, gvec, omega);
                     dvec.equ(-1., hvec);
                     gh = gvec * hvec;
                   }
@@ -192,4 +192,210 @@ namespace dftfe
       pcout << "Time for Poisson/Helmholtz problem CG iterations: " << time
             << std::endl;
   }
+
+  // solve several linear systems together
+  void
+  dealiiLinearSolver::solveBlock(
+    const std::vector<dealiiLinearSolverProblem *> &problems,
+    const double                                    absTolerance,
+    const unsigned int                              maxNumberIterations,
+    const int                                       debugLevel,
+    bool                                            distributeFlag)
+  {
+    const unsigned int numberSystems = problems.size();
+    if (numberSystems == 0)
+      return;
+
+    MPI_Barrier(mpi_communicator);
+    double start_time = MPI_Wtime();
+    double time;
+
+    // residual r=rhs-A*x, preconditioned residual u=M^{-1}*r, w=A*u, search
+    // direction p and s=A*p
+    std::vector<distributedCPUVec<double>> rvec(numberSystems),
+      uvec(numberSystems), wvec(numberSystems), pvec(numberSystems),
+      svec(numberSystems);
+
+    for (unsigned int iSystem = 0; iSystem < numberSystems; ++iSystem)
+      {
+        problems[iSystem]->computeRhs(rvec[iSystem]);
+
+        distributedCPUVec<double> &x = problems[iSystem]->getX();
+        x.update_ghost_values();
+
+        uvec[iSystem].reinit(x, true);
+        wvec[iSystem].reinit(x);
+        pvec[iSystem].reinit(x);
+        svec[iSystem].reinit(x);
+        uvec[iSystem].zero_out_ghosts();
+        wvec[iSystem].zero_out_ghosts();
+
+        if (!x.all_zero())
+          {
+            problems[iSystem]->vmult(wvec[iSystem], x);
+            for (unsigned int i = 0; i < rvec[iSystem].local_size(); i++)
+              rvec[iSystem].local_element(i) -= wvec[iSystem].local_element(i);
+          }
+      }
+
+    MPI_Barrier(mpi_communicator);
+    time = MPI_Wtime();
+
+    if (debugLevel >= 4)
+      pcout << "Time for compute rhs: " << time - start_time << std::endl;
+
+    const double omega = 0.3;
+
+    std::vector<double>       alpha(numberSystems, 0.0);
+    std::vector<double>       gammaOld(numberSystems, 0.0);
+    std::vector<double>       res(numberSystems, 0.0);
+    std::vector<double>       initialRes(numberSystems, 0.0);
+    std::vector<unsigned int> numberIterations(numberSystems, 0);
+
+    // residual norms of the initial guesses, the systems which already
+    // satisfy the tolerance skip the preconditioner and A*u applications
+    for (unsigned int iSystem = 0; iSystem < numberSystems; ++iSystem)
+      for (unsigned int i = 0; i < rvec[iSystem].local_size(); i++)
+        res[iSystem] +=
+          rvec[iSystem].local_element(i) * rvec[iSystem].local_element(i);
+
+    MPI_Allreduce(MPI_IN_PLACE,
+                  &res[0],
+                  numberSystems,
+                  MPI_DOUBLE,
+                  MPI_SUM,
+                  mpi_communicator);
+
+    std::vector<unsigned int> activeSystems;
+    for (unsigned int iSystem = 0; iSystem < numberSystems; ++iSystem)
+      {
+        res[iSystem]        = std::sqrt(res[iSystem]);
+        initialRes[iSystem] = res[iSystem];
+        if (res[iSystem] >= absTolerance && maxNumberIterations > 0)
+          activeSystems.push_back(iSystem);
+      }
+
+    // packed [(r,u),(w,u),(r,r)] of the active systems
+    std::vector<double> innerProducts;
+
+    unsigned int it = 0;
+    while (activeSystems.size() > 0)
+      {
+        const unsigned int numberActiveSystems = activeSystems.size();
+        innerProducts.assign(3 * numberActiveSystems, 0.0);
+        for (unsigned int iActive = 0; iActive < numberActiveSystems;
+             ++iActive)
+          {
+            const unsigned int iSystem = activeSystems[iActive];
+            problems[iSystem]->precondition(uvec[iSystem],
+                                            rvec[iSystem],
+                                            omega);
+            problems[iSystem]->vmult(wvec[iSystem], uvec[iSystem]);
+
+            double gamma = 0.0, delta = 0.0, resSq = 0.0;
+            for (unsigned int i = 0; i < rvec[iSystem].local_size(); i++)
+              {
+                const double r = rvec[iSystem].local_element(i);
+                const double u = uvec[iSystem].local_element(i);
+                gamma += r * u;
+                delta += wvec[iSystem].local_element(i) * u;
+                resSq += r * r;
+              }
+            innerProducts[3 * iActive]     = gamma;
+            innerProducts[3 * iActive + 1] = delta;
+            innerProducts[3 * iActive + 2] = resSq;
+          }
+
+        MPI_Allreduce(MPI_IN_PLACE,
+                      &innerProducts[0],
+                      3 * numberActiveSystems,
+                      MPI_DOUBLE,
+                      MPI_SUM,
+                      mpi_communicator);
+
+        std::vector<unsigned int> activeSystemsNext;
+        for (unsigned int iActive = 0; iActive < numberActiveSystems;
+             ++iActive)
+          {
+            const unsigned int iSystem = activeSystems[iActive];
+            const double       gamma   = innerProducts[3 * iActive];
+            const double       delta   = innerProducts[3 * iActive + 1];
+            res[iSystem] = std::sqrt(std::abs(innerProducts[3 * iActive + 2]));
+            numberIterations[iSystem] = it;
+
+            if (res[iSystem] < absTolerance || it == maxNumberIterations)
+              continue;
+
+            activeSystemsNext.push_back(iSystem);
+
+            double beta = 0.0;
+            if (it == 0)
+              {
+                AssertThrow(std::abs(delta) != 0.,
+                            dealii::ExcMessage("Division by zero\n"));
+                alpha[iSystem] = gamma / delta;
+              }
+            else
+              {
+                AssertThrow(std::abs(gammaOld[iSystem]) != 0.,
+                            dealii::ExcMessage("Division by zero\n"));
+                beta = gamma / gammaOld[iSystem];
+                const double denominator =
+                  delta - beta * gamma / alpha[iSystem];
+                AssertThrow(std::abs(denominator) != 0.,
+                            dealii::ExcMessage("Division by zero\n"));
+                alpha[iSystem] = gamma / denominator;
+              }
+            gammaOld[iSystem] = gamma;
+
+            distributedCPUVec<double> &x = problems[iSystem]->getX();
+            for (unsigned int i = 0; i < x.local_size(); i++)
+              {
+                double &p = pvec[iSystem].local_element(i);
+                double &s = svec[iSystem].local_element(i);
+                p         = uvec[iSystem].local_element(i) + beta * p;
+                s         = wvec[iSystem].local_element(i) + beta * s;
+                x.local_element(i) += alpha[iSystem] * p;
+                rvec[iSystem].local_element(i) -= alpha[iSystem] * s;
+              }
+          }
+
+        if (it == maxNumberIterations || activeSystemsNext.size() == 0)
+          break;
+
+        activeSystems.swap(activeSystemsNext);
+        it++;
+      }
+
+    for (unsigned int iSystem = 0; iSystem < numberSystems; ++iSystem)
+      {
+        if (debugLevel >= 2)
+          {
+            pcout << std::endl;
+            pcout << "system: " << iSystem
+                  << " , initial abs. residual: " << initialRes[iSystem]
+                  << " , current abs. residual: " << res[iSystem]
+                  << " , nsteps: " << numberIterations[iSystem]
+                  << " , abs. tolerance criterion:  " << absTolerance
+                  << "\n\n";
+          }
+
+        AssertThrow(
+          res[iSystem] < absTolerance,
+          dealii::ExcMessage(
+            "DFT-FE Error: Poisson solver did not converge as per set tolerances. consider increasing MAXIMUM ITERATIONS in Poisson problem parameters. In rare cases for all-electron problems this can also occur due to a known parallel constraints issue in dealii library. Try using set CONSTRAINTS FROM SERIAL DOFHANDLER=true under the Boundary conditions subsection."));
+
+        if (distributeFlag)
+          problems[iSystem]->distributeX();
+
+        problems[iSystem]->getX().update_ghost_values();
+      }
+
+    MPI_Barrier(mpi_communicator);
+    time = MPI_Wtime() - time;
+
+    if (debugLevel >= 4)
+      pcout << "Time for Poisson/Helmholtz problem block CG iterations: "
+            << time << std::endl;
+  }
 } // namespace dftfe
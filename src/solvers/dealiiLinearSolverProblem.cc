@@ -26,4 +26,13 @@ namespace dftfe
     return;
   }
 
+  void
+  dealiiLinearSolverProblem::precondition(
+    distributedCPUVec<double> &      dst,
+    const distributedCPUVec<double> &src,
+    const double                     omega) const
+  {
+    precondition_Jacobi(dst, src, omega);
+  }
+
 } // namespace dftfe
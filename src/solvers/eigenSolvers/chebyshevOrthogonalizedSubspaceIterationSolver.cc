@@ -258,26 +258,82 @@ namespace dftfe
                                                             1) :
           NULL;
 
+    distributedCPUMultiVec<dataTypes::number>
+      *eigenVectorsFlattenedArrayBlock3 =
+        d_dftParams.overlapComputeCommunChebyHost ?
+          &operatorMatrix.getScratchFEMultivector(vectorsBlockSize, 2) :
+          NULL;
+    distributedCPUMultiVec<dataTypes::number>
+      *eigenVectorsFlattenedArrayBlock4 =
+        d_dftParams.overlapComputeCommunChebyHost ?
+          &operatorMatrix.getScratchFEMultivector(vectorsBlockSize, 3) :
+          NULL;
+    distributedCPUMultiVec<dataTypes::numberFP32>
+      *eigenVectorsFlattenedArrayBlock3FP32 =
+        d_dftParams.overlapComputeCommunChebyHost &&
+            d_dftParams.useSinglePrecCheby ?
+          &operatorMatrix.getScratchFEMultivectorSinglePrec(vectorsBlockSize,
+                                                            2) :
+          NULL;
+    distributedCPUMultiVec<dataTypes::numberFP32>
+      *eigenVectorsFlattenedArrayBlock4FP32 =
+        d_dftParams.overlapComputeCommunChebyHost &&
+            d_dftParams.useSinglePrecCheby ?
+          &operatorMatrix.getScratchFEMultivectorSinglePrec(vectorsBlockSize,
+                                                            3) :
+          NULL;
+
     std::vector<double> eigenValuesBlock(vectorsBlockSize);
     /// storage for cell wavefunction matrix
     std::vector<dataTypes::number> cellWaveFunctionMatrix;
 
-    int startIndexBandParal = totalNumberWaveFunctions;
-    int numVectorsBandParal = 0;
+    const bool useSinglePrecCommun =
+      useMixedPrec && d_dftParams.useSinglePrecCommunChebyHost;
+    const auto setCommunicationPrecisionBlocks =
+      [&](const unsigned int                              numBlocks,
+          const dftfe::utils::mpi::communicationPrecision precision) {
+        eigenVectorsFlattenedArrayBlock->setCommunicationPrecision(precision);
+        eigenVectorsFlattenedArrayBlock2->setCommunicationPrecision(precision);
+        if (numBlocks == 2)
+          {
+            eigenVectorsFlattenedArrayBlock3->setCommunicationPrecision(
+              precision);
+            eigenVectorsFlattenedArrayBlock4->setCommunicationPrecision(
+              precision);
+          }
+      };
+
+    // two blocks of wavefunctions are filtered simultaneously when overlap
+    // compute communication in chebyshev filtering is toggled on. Only full
+    // blocks which both lie inside the band group are paired
+    unsigned int numSimultaneousBlocksCurrent = 1;
+    int          startIndexBandParal          = totalNumberWaveFunctions;
+    int          numVectorsBandParal          = 0;
     for (unsigned int jvec = 0; jvec < totalNumberWaveFunctions;
-         jvec += vectorsBlockSize)
+         jvec += numSimultaneousBlocksCurrent * vectorsBlockSize)
       {
         // Correct block dimensions if block "goes off edge of" the matrix
         const unsigned int BVec =
           std::min(vectorsBlockSize, totalNumberWaveFunctions - jvec);
 
+        numSimultaneousBlocksCurrent =
+          (d_dftParams.overlapComputeCommunChebyHost &&
+           BVec == vectorsBlockSize &&
+           (jvec + 2 * BVec) <=
+             bandGroupLowHighPlusOneIndices[2 * bandGroupTaskId + 1] &&
+           (jvec + BVec) >
+             bandGroupLowHighPlusOneIndices[2 * bandGroupTaskId]) ?
+            2 :
+            1;
+
         if ((jvec + BVec) <=
               bandGroupLowHighPlusOneIndices[2 * bandGroupTaskId + 1] &&
             (jvec + BVec) > bandGroupLowHighPlusOneIndices[2 * bandGroupTaskId])
           {
             if (jvec < startIndexBandParal)
               startIndexBandParal = jvec;
-            numVectorsBandParal = jvec + BVec - startIndexBandParal;
+            numVectorsBandParal =
+              jvec + numSimultaneousBlocksCurrent * BVec - startIndexBandParal;
 
             // create custom partitioned dealii array
             if (BVec != vectorsBlockSize)
@@ -307,36 +363,82 @@ namespace dftfe
                         eigenVectorsFlattened +
                           iNode * totalNumberWaveFunctions + jvec + BVec,
                         eigenVectorsFlattenedArrayBlock->data() + iNode * BVec);
+            if (numSimultaneousBlocksCurrent == 2)
+              for (unsigned int iNode = 0; iNode < localVectorSize; ++iNode)
+                std::copy(eigenVectorsFlattened +
+                            iNode * totalNumberWaveFunctions + jvec + BVec,
+                          eigenVectorsFlattened +
+                            iNode * totalNumberWaveFunctions + jvec + 2 * BVec,
+                          eigenVectorsFlattenedArrayBlock3->data() +
+                            iNode * BVec);
             computing_timer.leave_subsection(
               "Copy from full to block flattened array");
 
 
 
             //
-            // call Chebyshev filtering function only for the current block to
-            // be filtered and does in-place filtering
+            // call Chebyshev filtering function only for the current block
+            // or two simulataneous blocks (in case of overlap computation
+            // and communication) to be filtered and does in-place filtering
             computing_timer.enter_subsection("Chebyshev filtering");
+            if (useSinglePrecCommun)
+              setCommunicationPrecisionBlocks(
+                numSimultaneousBlocksCurrent,
+                dftfe::utils::mpi::communicationPrecision::single);
             if (d_dftParams.useSinglePrecCheby && !isFirstFilteringCall)
               {
-                eigenValuesBlock.resize(BVec);
-                for (unsigned int i = 0; i < BVec; i++)
+                eigenValuesBlock.resize(numSimultaneousBlocksCurrent * BVec);
+                for (unsigned int i = 0;
+                     i < numSimultaneousBlocksCurrent * BVec;
+                     i++)
                   {
                     eigenValuesBlock[i] = eigenValues[jvec + i];
                   }
 
-                linearAlgebraOperations::chebyshevFilterSinglePrec(
-                  BLASWrapperPtr,
+                if (numSimultaneousBlocksCurrent == 2)
+                  linearAlgebraOperations::
+                    chebyshevFilterOverlapComputeCommunicationSinglePrec(
+                      BLASWrapperPtr,
+                      operatorMatrix,
+                      (*eigenVectorsFlattenedArrayBlock),
+                      (*eigenVectorsFlattenedArrayBlock2),
+                      (*eigenVectorsFlattenedArrayBlock3),
+                      (*eigenVectorsFlattenedArrayBlock4),
+                      (*eigenVectorsFlattenedArrayBlockFP32),
+                      (*eigenVectorsFlattenedArrayBlock2FP32),
+                      (*eigenVectorsFlattenedArrayBlock3FP32),
+                      (*eigenVectorsFlattenedArrayBlock4FP32),
+                      eigenValuesBlock,
+                      chebyshevOrder,
+                      d_lowerBoundUnWantedSpectrum,
+                      d_upperBoundUnWantedSpectrum,
+                      d_lowerBoundWantedSpectrum);
+                else
+                  linearAlgebraOperations::chebyshevFilterSinglePrec(
+                    BLASWrapperPtr,
+                    operatorMatrix,
+                    (*eigenVectorsFlattenedArrayBlock),
+                    (*eigenVectorsFlattenedArrayBlock2),
+                    (*eigenVectorsFlattenedArrayBlockFP32),
+                    (*eigenVectorsFlattenedArrayBlock2FP32),
+                    eigenValuesBlock,
+                    chebyshevOrder,
+                    d_lowerBoundUnWantedSpectrum,
+                    d_upperBoundUnWantedSpectrum,
+                    d_lowerBoundWantedSpectrum);
+              }
+            else if (numSimultaneousBlocksCurrent == 2)
+              linearAlgebraOperations::
+                chebyshevFilterOverlapComputeCommunication(
                   operatorMatrix,
-                  (*eigenVectorsFlattenedArrayBlock),
-                  (*eigenVectorsFlattenedArrayBlock2),
-                  (*eigenVectorsFlattenedArrayBlockFP32),
-                  (*eigenVectorsFlattenedArrayBlock2FP32),
-                  eigenValuesBlock,
+                  *eigenVectorsFlattenedArrayBlock,
+                  *eigenVectorsFlattenedArrayBlock2,
+                  *eigenVectorsFlattenedArrayBlock3,
+                  *eigenVectorsFlattenedArrayBlock4,
                   chebyshevOrder,
                   d_lowerBoundUnWantedSpectrum,
                   d_upperBoundUnWantedSpectrum,
                   d_lowerBoundWantedSpectrum);
-              }
             else
               linearAlgebraOperations::chebyshevFilter(
                 operatorMatrix,
@@ -346,6 +448,10 @@ namespace dftfe
                 d_lowerBoundUnWantedSpectrum,
                 d_upperBoundUnWantedSpectrum,
                 d_lowerBoundWantedSpectrum);
+            if (useSinglePrecCommun)
+              setCommunicationPrecisionBlocks(
+                numSimultaneousBlocksCurrent,
+                dftfe::utils::mpi::communicationPrecision::full);
 
             computing_timer.leave_subsection("Chebyshev filtering");
 
@@ -365,6 +471,14 @@ namespace dftfe
                           (iNode + 1) * BVec,
                         eigenVectorsFlattened +
                           iNode * totalNumberWaveFunctions + jvec);
+            if (numSimultaneousBlocksCurrent == 2)
+              for (unsigned int iNode = 0; iNode < localVectorSize; ++iNode)
+                std::copy(eigenVectorsFlattenedArrayBlock3->data() +
+                            iNode * BVec,
+                          eigenVectorsFlattenedArrayBlock3->data() +
+                            (iNode + 1) * BVec,
+                          eigenVectorsFlattened +
+                            iNode * totalNumberWaveFunctions + jvec + BVec);
 
             computing_timer.leave_subsection(
               "Copy from block to full flattened array");
@@ -75,6 +75,7 @@ namespace dftfe
     send_buf_size.clear();
     recv_buf_size.clear();
     rhoRecvd.clear();
+    rhoRecvdOffsets.clear();
     groupOffsets.clear();
     if (dftPtr->d_excManagerPtr->getDensityBasedFamilyType() ==
         densityFamilyType::GGA)
@@ -125,6 +126,15 @@ namespace dftfe
     std::map<dealii::CellId, int> globalCellId_parallel;
     //
     clearMaps();
+    numDensityComponents =
+      dftPtr->getParametersObject().noncolin ?
+        4 :
+        (1 + dftPtr->getParametersObject().spinPolarized);
+    //
+    symmMatCart.resize(numSymm);
+    for (unsigned int iSymm = 0; iSymm < numSymm; ++iSymm)
+      symmMatCart[iSymm] = crys2cartRotation(symmMat[iSymm]);
+    timeReversedSymm.resize(numSymm, 0);
     //================================================================================================================================================
     //							Allocate memory for the mapping tables
     //================================================================================================================================================
@@ -137,11 +147,7 @@ namespace dftfe
     mappedGroupRecvd1.resize(numSymm);
     send_buf_size.resize(numSymm);
     recv_buf_size.resize(numSymm);
-    rhoRecvd.resize(numSymm);
     groupOffsets.resize(numSymm);
-    if (dftPtr->d_excManagerPtr->getDensityBasedFamilyType() ==
-        densityFamilyType::GGA)
-      gradRhoRecvd.resize(numSymm);
     //
     const dealii::parallel::distributed::Triangulation<3> &triangulationSer =
       (dftPtr->d_mesh).getSerialMeshUnmoved();
@@ -174,14 +180,8 @@ namespace dftfe
           std::vector<std::vector<std::vector<int>>>(cell_id);
         recv_buf_size[iSymm] =
           std::vector<std::vector<std::vector<int>>>(cell_id);
-        rhoRecvd[iSymm] =
-          std::vector<std::vector<std::vector<double>>>(cell_id);
         groupOffsets[iSymm] =
           std::vector<std::vector<std::vector<int>>>(cell_id);
-        if (dftPtr->d_excManagerPtr->getDensityBasedFamilyType() ==
-            densityFamilyType::GGA)
-          gradRhoRecvd[iSymm] =
-            std::vector<std::vector<std::vector<double>>>(cell_id);
       }
     //================================================================================================================================================
     //					     Create local and global maps to locate cells on their
@@ -239,8 +239,6 @@ namespace dftfe
                   std::vector<std::tuple<int, int, int>>(num_quad_points);
                 mappedGroupRecvd1[iSymm][globalCellId_parallel[cell->id()]] =
                   std::vector<std::vector<double>>(3);
-                rhoRecvd[iSymm][globalCellId_parallel[cell->id()]] =
-                  std::vector<std::vector<double>>(dftPtr->n_mpi_processes);
               }
             for (unsigned int iSymm = 0; iSymm < numSymm; ++iSymm)
               {
@@ -501,13 +499,6 @@ namespace dftfe
                     send_size0 +=
                       send_buf_size[iSymm][globalCellId_parallel[cell->id()]]
                                    [proc][0];
-                    //
-                    rhoRecvd[iSymm][globalCellId_parallel[cell->id()]][proc]
-                      .resize(
-                        (1 + dftPtr->getParametersObject().spinPolarized) *
-                        send_buf_size[iSymm][globalCellId_parallel[cell->id()]]
-                                     [proc][1]); // to be used later to recv
-                                                 // symmetrized rho
                   }
               }
           }
@@ -614,75 +605,74 @@ namespace dftfe
     // symmetrizeRho.cc, because symmetrizeRho.cc is to be called during each
     // SCF iteration 							So this better be a one time cost
     //================================================================================================================================================
-    cell      = (dftPtr->dofHandlerEigen).begin_active();
-    totPoints = 0;
-    recv_size.resize(dftPtr->n_mpi_processes, 0);
-    //
+    // the density on the points of a (cell, symmetry, processor) triplet is
+    // received in a single flattened buffer, laid out by processor first as
+    // sent back from computeLocalrhoOut
+    const unsigned int numLocallyOwnedCells =
+      dftPtr->matrix_free_data.n_physical_cells();
+    std::vector<unsigned int> numPointsRecvd(dftPtr->n_mpi_processes, 0);
+    rhoRecvdOffsets.resize(numLocallyOwnedCells * numSymm *
+                           dftPtr->n_mpi_processes);
+    cell               = (dftPtr->dofHandlerEigen).begin_active();
+    unsigned int iCell = 0;
     for (; cell != endc; ++cell)
       {
         if (cell->is_locally_owned())
           {
             for (unsigned int iSymm = 0; iSymm < numSymm; ++iSymm)
-              {
-                rhoRecvd[iSymm][globalCellId_parallel[cell->id()]] =
-                  std::vector<std::vector<double>>(dftPtr->n_mpi_processes);
-                for (unsigned int proc = 0; proc < dftPtr->n_mpi_processes;
-                     ++proc)
-                  {
-                    recv_size[proc] =
-                      recv_size[proc] +
-                      (1 + dftPtr->getParametersObject().spinPolarized) *
-                        send_buf_size[iSymm][globalCellId_parallel[cell->id()]]
-                                     [proc][1];
-                    rhoRecvd[iSymm][globalCellId_parallel[cell->id()]][proc]
-                      .resize(
-                        (1 + dftPtr->getParametersObject().spinPolarized) *
-                        send_buf_size[iSymm][globalCellId_parallel[cell->id()]]
-                                     [proc][1]);
-                  }
-              }
+              for (unsigned int proc = 0; proc < dftPtr->n_mpi_processes;
+                   ++proc)
+                {
+                  rhoRecvdOffsets[(iCell * numSymm + iSymm) *
+                                    dftPtr->n_mpi_processes +
+                                  proc] = numPointsRecvd[proc];
+                  numPointsRecvd[proc] +=
+                    send_buf_size[iSymm][globalCellId_parallel[cell->id()]]
+                                 [proc][1];
+                }
+            ++iCell;
           }
       }
     //
+    std::vector<unsigned int> pointOffsetsRecvd(dftPtr->n_mpi_processes, 0);
+    for (unsigned int proc = 1; proc < dftPtr->n_mpi_processes; ++proc)
+      pointOffsetsRecvd[proc] =
+        pointOffsetsRecvd[proc - 1] + numPointsRecvd[proc - 1];
+    const unsigned int numPointsRecvdTotal =
+      pointOffsetsRecvd[dftPtr->n_mpi_processes - 1] +
+      numPointsRecvd[dftPtr->n_mpi_processes - 1];
+    for (unsigned int i = 0; i < rhoRecvdOffsets.size(); ++i)
+      rhoRecvdOffsets[i] += pointOffsetsRecvd[i % dftPtr->n_mpi_processes];
+    //
+    recv_size.resize(dftPtr->n_mpi_processes, 0);
+    recv_offsets.resize(dftPtr->n_mpi_processes, 0);
+    for (unsigned int proc = 0; proc < dftPtr->n_mpi_processes; ++proc)
+      {
+        recv_size[proc]    = numDensityComponents * numPointsRecvd[proc];
+        recv_offsets[proc] = numDensityComponents * pointOffsetsRecvd[proc];
+      }
+    rhoRecvd.resize(numDensityComponents * numPointsRecvdTotal, 0.0);
+    //
     for (int i = 0; i < dftPtr->n_mpi_processes; i++)
       {
-        recv_size1[i] =
-          (1 + dftPtr->getParametersObject().spinPolarized) * recv_size1[i];
-        mpi_offsets1[i] =
-          (1 + dftPtr->getParametersObject().spinPolarized) * mpi_offsets1[i];
+        recv_size1[i]   = numDensityComponents * recv_size1[i];
+        mpi_offsets1[i] = numDensityComponents * mpi_offsets1[i];
       }
     //
     if (dftPtr->d_excManagerPtr->getDensityBasedFamilyType() ==
         densityFamilyType::GGA)
       {
-        cell = (dftPtr->dofHandlerEigen).begin_active();
+        recvGrad_size.resize(dftPtr->n_mpi_processes, 0);
+        recvGrad_offsets.resize(dftPtr->n_mpi_processes, 0);
         for (int i = 0; i < dftPtr->n_mpi_processes; i++)
           {
             recvGrad_size1[i]   = 3 * recv_size1[i];
             mpiGrad_offsets1[i] = 3 * mpi_offsets1[i];
+            recvGrad_size[i]    = 3 * recv_size[i];
+            recvGrad_offsets[i] = 3 * recv_offsets[i];
           }
-        //
-        for (; cell != endc; ++cell)
-          {
-            if (cell->is_locally_owned())
-              {
-                for (unsigned int iSymm = 0; iSymm < numSymm; ++iSymm)
-                  {
-                    gradRhoRecvd[iSymm][globalCellId_parallel[cell->id()]] =
-                      std::vector<std::vector<double>>(dftPtr->n_mpi_processes);
-                    for (unsigned int proc = 0; proc < dftPtr->n_mpi_processes;
-                         ++proc)
-                      gradRhoRecvd
-                        [iSymm][globalCellId_parallel[cell->id()]][proc]
-                          .resize(
-                            (1 + dftPtr->getParametersObject().spinPolarized) *
-                            3 *
-                            send_buf_size[iSymm]
-                                         [globalCellId_parallel[cell->id()]]
-                                         [proc][1]);
-                  }
-              }
-          }
+        gradRhoRecvd.resize(3 * numDensityComponents * numPointsRecvdTotal,
+                            0.0);
       }
     //
   }
@@ -780,6 +770,33 @@ namespace dftfe
     return ptemp;
   }
   //================================================================================================================================================
+  //			           Cartesian representation of a rotation given in crystal
+  // coordinates, obtained by transforming the cartesian unit vectors
+  //================================================================================================================================================
+  template <unsigned int              FEOrder,
+            unsigned int              FEOrderElectro,
+            dftfe::utils::MemorySpace memorySpace>
+  std::vector<std::vector<double>>
+  symmetryClass<FEOrder, FEOrderElectro, memorySpace>::crys2cartRotation(
+    const std::vector<std::vector<double>> &rotation)
+  {
+    std::vector<std::vector<double>> rotationCart(3,
+                                                  std::vector<double>(3, 0.0));
+    for (unsigned int j = 0; j < 3; ++j)
+      {
+        dealii::Point<3> unitVector, ptemp;
+        unitVector[j]             = 1.0;
+        const dealii::Point<3> p0 = crys2cart(unitVector, -1);
+        for (unsigned int i = 0; i < 3; ++i)
+          ptemp[i] = rotation[i][0] * p0[0] + rotation[i][1] * p0[1] +
+                     rotation[i][2] * p0[2];
+        const dealii::Point<3> p = crys2cart(ptemp, 1);
+        for (unsigned int i = 0; i < 3; ++i)
+          rotationCart[i][j] = p[i];
+      }
+    return rotationCart;
+  }
+  //================================================================================================================================================
 #include "symmetrize.inst.cc"
   //=================================================================================================================================================
 } // namespace dftfe
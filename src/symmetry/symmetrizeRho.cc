@@ -57,14 +57,19 @@ namespace dftfe
       dftPtr->matrix_free_data.get_quadrature(dftPtr->d_densityQuadratureId);
     const unsigned int num_quad_points = quadrature.size();
     const unsigned int numCells = dftPtr->matrix_free_data.n_physical_cells();
+    const bool         isGGA =
+      dftPtr->d_excManagerPtr->getDensityBasedFamilyType() ==
+      densityFamilyType::GGA;
+    const bool isSpinPolarized =
+      dftPtr->getParametersObject().spinPolarized == 1;
     //
     dftPtr->d_densityOutQuadValues.resize(
-      dftPtr->getParametersObject().spinPolarized == 1 ? 2 : 1);
-    if (dftPtr->d_excManagerPtr->getDensityBasedFamilyType() ==
-        densityFamilyType::GGA)
+      dftPtr->getParametersObject().noncolin ? 4 : (isSpinPolarized ? 2 : 1));
+    if (isGGA)
       {
         dftPtr->d_gradDensityOutQuadValues.resize(
-          dftPtr->getParametersObject().spinPolarized == 1 ? 2 : 1);
+          dftPtr->getParametersObject().noncolin ? 4 :
+                                                   (isSpinPolarized ? 2 : 1));
       }
     for (unsigned int iComp = 0; iComp < dftPtr->d_densityOutQuadValues.size();
          ++iComp)
@@ -75,9 +80,8 @@ namespace dftfe
       dftPtr->d_gradDensityOutQuadValues[iComp].resize(3 * numCells *
                                                        num_quad_points);
 
-    std::vector<double> rhoOut(num_quad_points),
-      gradRhoOut(3 * num_quad_points), rhoOutSpinPolarized(2 * num_quad_points),
-      gradRhoOutSpinPolarized(6 * num_quad_points);
+    std::vector<double> rhoOut(numDensityComponents),
+      gradRhoOut(3 * numDensityComponents);
     //=============================================================================================================================================
     //				Loop over cell and quad point and compute density by summing over
     // all the used symmetries
@@ -90,116 +94,73 @@ namespace dftfe
       {
         if (cell->is_locally_owned())
           {
-            std::fill(rhoOut.begin(), rhoOut.end(), 0.0);
-            if (dftPtr->getParametersObject().spinPolarized == 1)
-              {
-                std::fill(rhoOutSpinPolarized.begin(),
-                          rhoOutSpinPolarized.end(),
-                          0.0);
-              }
-            //
-            if (dftPtr->d_excManagerPtr->getDensityBasedFamilyType() ==
-                densityFamilyType::GGA)
-              {
-                std::fill(gradRhoOut.begin(), gradRhoOut.end(), 0.0);
-                if (dftPtr->getParametersObject().spinPolarized == 1)
-                  {
-                    std::fill(gradRhoOutSpinPolarized.begin(),
-                              gradRhoOutSpinPolarized.end(),
-                              0.0);
-                  }
-              }
-            //
             for (unsigned int q_point = 0; q_point < num_quad_points; ++q_point)
               {
+                std::fill(rhoOut.begin(), rhoOut.end(), 0.0);
+                if (isGGA)
+                  std::fill(gradRhoOut.begin(), gradRhoOut.end(), 0.0);
                 for (unsigned int iSymm = 0; iSymm < numSymm; ++iSymm)
                   {
                     const unsigned int proc = std::get<0>(
                       mappedGroup[iSymm][globalCellId[cell->id()]][q_point]);
-                    const unsigned int group = std::get<1>(
-                      mappedGroup[iSymm][globalCellId[cell->id()]][q_point]);
                     const unsigned int point = std::get<2>(
                       mappedGroup[iSymm][globalCellId[cell->id()]][q_point]);
+                    const unsigned int pointIndex =
+                      rhoRecvdOffsets[(iCell * numSymm + iSymm) *
+                                        n_mpi_processes +
+                                      proc] +
+                      point;
                     //
-                    if (dftPtr->getParametersObject().spinPolarized == 1)
-                      {
-                        rhoOutSpinPolarized[2 * q_point] +=
-                          rhoRecvd[iSymm][globalCellId[cell->id()]][proc]
-                                  [2 * point];
-                        rhoOutSpinPolarized[2 * q_point + 1] +=
-                          rhoRecvd[iSymm][globalCellId[cell->id()]][proc]
-                                  [2 * point + 1];
-                      }
-                    else
-                      rhoOut[q_point] +=
-                        rhoRecvd[iSymm][globalCellId[cell->id()]][proc][point];
-                    if (dftPtr->d_excManagerPtr->getDensityBasedFamilyType() ==
-                        densityFamilyType::GGA)
-                      {
-                        if (dftPtr->getParametersObject().spinPolarized == 1)
-                          {
-                            for (unsigned int j = 0; j < 6; ++j)
-                              gradRhoOutSpinPolarized[6 * q_point + j] +=
-                                gradRhoRecvd[iSymm][globalCellId[cell->id()]]
-                                            [proc][6 * point + j];
-                          }
-                        else
-                          {
-                            for (unsigned int j = 0; j < 3; ++j)
-                              gradRhoOut[3 * q_point + j] +=
-                                gradRhoRecvd[iSymm][globalCellId[cell->id()]]
-                                            [proc][3 * point + j];
-                          }
-                      }
+                    for (unsigned int iComp = 0; iComp < numDensityComponents;
+                         ++iComp)
+                      rhoOut[iComp] +=
+                        rhoRecvd[numDensityComponents * pointIndex + iComp];
+                    if (isGGA)
+                      for (unsigned int j = 0; j < 3 * numDensityComponents;
+                           ++j)
+                        gradRhoOut[j] +=
+                          gradRhoRecvd[3 * numDensityComponents * pointIndex +
+                                       j];
                   }
-                if (dftPtr->getParametersObject().spinPolarized == 1)
+                // spin up and down densities are converted to the total
+                // density and magnetization
+                if (isSpinPolarized)
                   {
                     dftPtr->d_densityOutQuadValues[0][iCell * num_quad_points +
                                                       q_point] =
-                      rhoOutSpinPolarized[2 * q_point] +
-                      rhoOutSpinPolarized[2 * q_point + 1];
+                      rhoOut[0] + rhoOut[1];
                     dftPtr->d_densityOutQuadValues[1][iCell * num_quad_points +
                                                       q_point] =
-                      rhoOutSpinPolarized[2 * q_point] -
-                      rhoOutSpinPolarized[2 * q_point + 1];
-                  }
-                else
-                  dftPtr->d_densityOutQuadValues[0][iCell * num_quad_points +
-                                                    q_point] = rhoOut[q_point];
-                //
-                if (dftPtr->d_excManagerPtr->getDensityBasedFamilyType() ==
-                    densityFamilyType::GGA)
-                  {
-                    if (dftPtr->getParametersObject().spinPolarized == 1)
-                      {
-                        //
-                        for (unsigned int j = 0; j < 3; ++j)
+                      rhoOut[0] - rhoOut[1];
+                    if (isGGA)
+                      for (unsigned int j = 0; j < 3; ++j)
+                        {
                           dftPtr->d_gradDensityOutQuadValues
                             [0][iCell * num_quad_points * 3 + 3 * q_point + j] =
-                            gradRhoOutSpinPolarized[6 * q_point + j] +
-                            gradRhoOutSpinPolarized[6 * q_point + j + 3];
-                        for (unsigned int j = 0; j < 3; ++j)
+                            gradRhoOut[j] + gradRhoOut[j + 3];
                           dftPtr->d_gradDensityOutQuadValues
                             [1][iCell * num_quad_points * 3 + 3 * q_point + j] =
-                            gradRhoOutSpinPolarized[6 * q_point + j] -
-                            gradRhoOutSpinPolarized[6 * q_point + j + 3];
-                      }
-                    else
-                      {
+                            gradRhoOut[j] - gradRhoOut[j + 3];
+                        }
+                  }
+                else
+                  for (unsigned int iComp = 0; iComp < numDensityComponents;
+                       ++iComp)
+                    {
+                      dftPtr->d_densityOutQuadValues
+                        [iComp][iCell * num_quad_points + q_point] =
+                        rhoOut[iComp];
+                      if (isGGA)
                         for (unsigned int j = 0; j < 3; ++j)
                           dftPtr->d_gradDensityOutQuadValues
-                            [0][iCell * num_quad_points * 3 + 3 * q_point + j] =
-                            gradRhoOut[3 * q_point + j];
-                      }
-                  }
+                            [iComp]
+                            [iCell * num_quad_points * 3 + 3 * q_point + j] =
+                            gradRhoOut[3 * iComp + j];
+                    }
               }
             ++iCell;
           }
       }
-    //=============================================================================================================================================
-    //			Free up some memory by getting rid of density history beyond what is
-    // required by mixing scheme
-    //=============================================================================================================================================
   }
   //=============================================================================================================================================
   //=============================================================================================================================================
@@ -214,9 +175,24 @@ namespace dftfe
   void
   symmetryClass<FEOrder, FEOrderElectro, memorySpace>::computeLocalrhoOut()
   {
+    const dftParameters &dftParams = dftPtr->getParametersObject();
+    const bool           isGGA =
+      dftPtr->d_excManagerPtr->getDensityBasedFamilyType() ==
+      densityFamilyType::GGA;
+    const unsigned int numSpins = 1 + dftParams.spinPolarized;
+    const unsigned int numWfnSpinors =
+      (dftParams.noncolin || dftParams.hasSOC) ? 2 : 1;
+    const unsigned int numEigenValues = dftPtr->d_numEigenValues;
+    const unsigned int numKPoints     = dftPtr->d_kPointWeights.size();
+    // occupancies of the spin unpolarized collinear case account for both
+    // spins
+    const double spinFactor =
+      (dftParams.spinPolarized == 1 || numWfnSpinors == 2) ? 1.0 : 2.0;
+
+    // one set of single component vectors for each spinor component of the
+    // wavefunctions of a k-point and spin
     std::vector<std::vector<distributedCPUVec<double>>> eigenVectors(
-      (1 + dftPtr->getParametersObject().spinPolarized) *
-      dftPtr->d_kPointWeights.size());
+      numSpins * numKPoints * numWfnSpinors);
 
     const unsigned int localVectorSize =
       dftPtr->matrix_free_data.get_vector_partitioner()->locally_owned_size();
@@ -224,78 +200,63 @@ namespace dftfe
     distributedCPUVec<dataTypes::number> eigenVectorsFlattenedArrayFullBlock;
     vectorTools::createDealiiVector<dataTypes::number>(
       dftPtr->matrix_free_data.get_vector_partitioner(),
-      dftPtr->d_numEigenValues,
+      numEigenValues,
       eigenVectorsFlattenedArrayFullBlock);
 
-    for (unsigned int kPoint = 0;
-         kPoint < (1 + dftPtr->getParametersObject().spinPolarized) *
-                    dftPtr->d_kPointWeights.size();
-         ++kPoint)
-      {
-        eigenVectors[kPoint].resize(dftPtr->d_numEigenValues);
-        for (unsigned int i = 0; i < dftPtr->d_numEigenValues; ++i)
-          eigenVectors[kPoint][i].reinit(dftPtr->d_tempEigenVec);
+    for (unsigned int kPoint = 0; kPoint < numSpins * numKPoints; ++kPoint)
+      for (unsigned int iSpinor = 0; iSpinor < numWfnSpinors; ++iSpinor)
+        {
+          std::vector<distributedCPUVec<double>> &eigenVectorsSpinor =
+            eigenVectors[kPoint * numWfnSpinors + iSpinor];
+          eigenVectorsSpinor.resize(numEigenValues);
+          for (unsigned int i = 0; i < numEigenValues; ++i)
+            eigenVectorsSpinor[i].reinit(dftPtr->d_tempEigenVec);
 
-        for (unsigned int iNode = 0; iNode < localVectorSize; ++iNode)
-          for (unsigned int iWave = 0; iWave < dftPtr->d_numEigenValues;
-               ++iWave)
-            eigenVectorsFlattenedArrayFullBlock.local_element(
-              iNode * dftPtr->d_numEigenValues + iWave) =
-              dftPtr->d_eigenVectorsFlattenedHost
-                [kPoint * localVectorSize * dftPtr->d_numEigenValues +
-                 iNode * dftPtr->d_numEigenValues + iWave];
-        eigenVectorsFlattenedArrayFullBlock.update_ghost_values();
-        dftPtr->constraintsNoneDataInfo.distribute(
-          eigenVectorsFlattenedArrayFullBlock, dftPtr->d_numEigenValues);
+          // the spinor components of a node are stored contiguously
+          for (unsigned int iNode = 0; iNode < localVectorSize; ++iNode)
+            for (unsigned int iWave = 0; iWave < numEigenValues; ++iWave)
+              eigenVectorsFlattenedArrayFullBlock.local_element(
+                iNode * numEigenValues + iWave) =
+                dftPtr->d_eigenVectorsFlattenedHost
+                  [((dealii::types::global_dof_index)kPoint * localVectorSize *
+                      numWfnSpinors +
+                    iNode * numWfnSpinors + iSpinor) *
+                     numEigenValues +
+                   iWave];
+          eigenVectorsFlattenedArrayFullBlock.update_ghost_values();
+          dftPtr->constraintsNoneDataInfo.distribute(
+            eigenVectorsFlattenedArrayFullBlock, numEigenValues);
 
 
 #ifdef USE_COMPLEX
-        vectorTools::copyFlattenedDealiiVecToSingleCompVec(
-          eigenVectorsFlattenedArrayFullBlock,
-          dftPtr->d_numEigenValues,
-          std::make_pair(0, dftPtr->d_numEigenValues),
-          dftPtr->localProc_dof_indicesReal,
-          dftPtr->localProc_dof_indicesImag,
-          eigenVectors[kPoint]);
+          vectorTools::copyFlattenedDealiiVecToSingleCompVec(
+            eigenVectorsFlattenedArrayFullBlock,
+            numEigenValues,
+            std::make_pair(0, numEigenValues),
+            dftPtr->localProc_dof_indicesReal,
+            dftPtr->localProc_dof_indicesImag,
+            eigenVectorsSpinor);
 #endif
-      }
+        }
     //
-    const dealii::Quadrature<3> &quadrature =
-      dftPtr->matrix_free_data.get_quadrature(dftPtr->d_densityQuadratureId);
-    const unsigned int num_quad_points = quadrature.size();
-    totPoints                          = recvdData1[0].size();
-    double                              px, py, pz;
-    std::vector<dealii::Vector<double>> tempPsiAlpha, tempPsiBeta;
-    std::vector<std::vector<dealii::Tensor<1, 3, double>>> tempGradPsi,
-      tempGradPsiTempAlpha, tempGradPsiTempBeta;
+    totPoints = recvdData1[0].size();
+    double                        px, py, pz;
     std::vector<dealii::Point<3>> quadPointList;
-    std::vector<double>           sendData, recvdData;
-    //
-    std::vector<double> rhoLocal, gradRhoLocal, rhoLocalSpinPolarized,
-      gradRhoLocalSpinPolarized;
-    std::vector<double> rhoTemp, gradRhoTemp, rhoTempSpinPolarized,
-      gradRhoTempSpinPolarized;
-    rhoLocal.resize(totPoints, 0.0);
-    rhoTemp.resize(totPoints, 0.0);
     //
-    if (dftPtr->getParametersObject().spinPolarized == 1)
-      {
-        rhoLocalSpinPolarized.resize(2 * totPoints, 0.0);
-        rhoTempSpinPolarized.resize(2 * totPoints, 0.0);
-      }
+    // density computed at the transformed points, the density components
+    // followed by their gradients, in the order the points were received
+    const unsigned int densityTempSize =
+      (isGGA ? 4 : 1) * numDensityComponents * totPoints;
+    std::vector<double> densityTemp(densityTempSize, 0.0);
+    double *            rhoTemp     = densityTemp.data();
+    double *            gradRhoTemp = densityTemp.data() +
+                               numDensityComponents * totPoints;
     //
-    if (dftPtr->d_excManagerPtr->getDensityBasedFamilyType() ==
-        densityFamilyType::GGA)
-      {
-        gradRhoLocal.resize(3 * totPoints, 0.0);
-        gradRhoTemp.resize(3 * totPoints, 0.0);
-        if (dftPtr->getParametersObject().spinPolarized)
-          {
-            gradRhoLocalSpinPolarized.resize(6 * totPoints, 0.0);
-            gradRhoTempSpinPolarized.resize(6 * totPoints, 0.0);
-          }
-      }
-    unsigned int numPointsDone = 0, numGroupsDone = 0;
+    std::vector<std::vector<dealii::Vector<double>>> psiValues(numWfnSpinors);
+    std::vector<std::vector<std::vector<dealii::Tensor<1, 3, double>>>>
+                        gradPsiValues(numWfnSpinors);
+    std::vector<double> rhoGroup, gradRhoGroup;
+    unsigned int        numPointsDone = 0, numGroupsDone = 0;
     for (unsigned int proc = 0; proc < n_mpi_processes; ++proc)
       {
         //
@@ -305,16 +266,13 @@ namespace dftfe
             const unsigned int numPoint = recvdData2[numGroupsDone + iGroup];
             const unsigned int cellId   = recvdData0[numGroupsDone + iGroup];
             //
-            tempPsiAlpha.resize(numPoint);
-            tempPsiBeta.resize(numPoint);
             quadPointList.resize(numPoint);
-            //
-            if (dftPtr->d_excManagerPtr->getDensityBasedFamilyType() ==
-                densityFamilyType::GGA)
+            for (unsigned int iSpinor = 0; iSpinor < numWfnSpinors; ++iSpinor)
               {
-                tempGradPsi.resize(numPoint);
-                tempGradPsiTempAlpha.resize(numPoint);
-                tempGradPsiTempBeta.resize(numPoint);
+                psiValues[iSpinor].resize(numPoint, dealii::Vector<double>(2));
+                if (isGGA)
+                  gradPsiValues[iSpinor].resize(
+                    numPoint, std::vector<dealii::Tensor<1, 3, double>>(2));
               }
             for (unsigned int iList = 0; iList < numPoint; ++iList)
               {
@@ -325,16 +283,6 @@ namespace dftfe
                 //
                 const dealii::Point<3> pointTemp(px, py, pz);
                 quadPointList[iList] = pointTemp;
-                tempPsiAlpha[iList].reinit(2);
-                tempPsiBeta[iList].reinit(2);
-                //
-                if (dftPtr->d_excManagerPtr->getDensityBasedFamilyType() ==
-                    densityFamilyType::GGA)
-                  {
-                    tempGradPsi[iList].resize(2);
-                    tempGradPsiTempAlpha[iList].resize(2);
-                    tempGradPsiTempBeta[iList].resize(2);
-                  }
               } // loop on points
             //
             //
@@ -348,260 +296,218 @@ namespace dftfe
             fe_values.reinit(dealIICellId[cellId]);
             const unsigned int iSymm = recvdData3[numGroupsDone + iGroup];
             //
+            rhoGroup.assign(numDensityComponents * numPoint, 0.0);
+            if (isGGA)
+              gradRhoGroup.assign(3 * numDensityComponents * numPoint, 0.0);
             //
             //=============================================================================================================================================
             //				             Sum over the star of the k point and the
             // bands
             //				  	     Rho(r) = \sum_(n, Sk) | Psi (n, Sr + tau ) |^2
             //=============================================================================================================================================
-            for (unsigned int kPoint = 0;
-                 kPoint < (dftPtr->d_kPointWeights.size());
-                 ++kPoint)
+            for (unsigned int kPoint = 0; kPoint < numKPoints; ++kPoint)
               {
-                if (symmUnderGroup[kPoint][iSymm] == 1)
-                  {
-                    for (unsigned int i = 0; i < (dftPtr->d_numEigenValues);
-                         ++i)
-                      {
-                        double factor =
-                          ((dftPtr->eigenValues)[kPoint][i] -
-                           (dftPtr->fermiEnergy)) /
-                          (C_kb * dftPtr->getParametersObject().TVal);
-                        double partialOccupancyAlpha = getOccupancy(factor);
-                        //
-                        factor =
-                          ((dftPtr->eigenValues)
-                             [kPoint]
-                             [i + dftPtr->getParametersObject().spinPolarized *
-                                    (dftPtr->d_numEigenValues)] -
-                           (dftPtr->fermiEnergy)) /
-                          (C_kb * dftPtr->getParametersObject().TVal);
-                        double partialOccupancyBeta = getOccupancy(factor);
-                        //
-                        if (dftPtr->getParametersObject()
-                              .constraintMagnetization)
-                          {
-                            partialOccupancyAlpha = 1.0,
-                            partialOccupancyBeta  = 1.0;
-                            if ((dftPtr->eigenValues)
-                                  [kPoint][i + dftPtr->getParametersObject()
-                                                   .spinPolarized *
-                                                 (dftPtr->d_numEigenValues)] >
-                                (dftPtr->fermiEnergyDown))
-                              partialOccupancyBeta = 0.0;
-                            if ((dftPtr->eigenValues)[kPoint][i] >
-                                (dftPtr->fermiEnergyUp))
-                              partialOccupancyAlpha = 0.0;
-                          }
-                        //
-                        fe_values.get_function_values(
-                          (eigenVectors[(1 + dftPtr->getParametersObject()
-                                               .spinPolarized) *
-                                        kPoint][i]),
-                          tempPsiAlpha);
-                        if (dftPtr->getParametersObject().spinPolarized == 1)
-                          fe_values.get_function_values(
-                            (eigenVectors[(1 + dftPtr->getParametersObject()
-                                                 .spinPolarized) *
-                                            kPoint +
-                                          1][i]),
-                            tempPsiBeta);
-                        //
-                        if (dftPtr->d_excManagerPtr
-                              ->getDensityBasedFamilyType() ==
-                            densityFamilyType::GGA)
-                          {
+                if (symmUnderGroup[kPoint][iSymm] != 1)
+                  continue;
+                for (unsigned int spinIndex = 0; spinIndex < numSpins;
+                     ++spinIndex)
+                  for (unsigned int i = 0; i < numEigenValues; ++i)
+                    {
+                      const double eigenValue =
+                        (dftPtr->eigenValues)[kPoint]
+                                             [i + spinIndex * numEigenValues];
+                      double partialOccupancy =
+                        getOccupancy((eigenValue - (dftPtr->fermiEnergy)) /
+                                     (C_kb * dftParams.TVal));
+                      if (dftParams.constraintMagnetization)
+                        partialOccupancy =
+                          eigenValue > (spinIndex == 0 ?
+                                          dftPtr->fermiEnergyUp :
+                                          dftPtr->fermiEnergyDown) ?
+                            0.0 :
+                            1.0;
+                      const double weight =
+                        spinFactor * partialOccupancy *
+                        (dftPtr->d_kPointWeights)[kPoint] /
+                        double(numSymmUnderGroup[kPoint]);
+                      //
+                      for (unsigned int iSpinor = 0; iSpinor < numWfnSpinors;
+                           ++iSpinor)
+                        {
+                          const distributedCPUVec<double> &eigenVector =
+                            eigenVectors[(numSpins * kPoint + spinIndex) *
+                                           numWfnSpinors +
+                                         iSpinor][i];
+                          fe_values.get_function_values(eigenVector,
+                                                        psiValues[iSpinor]);
+                          if (isGGA)
                             fe_values.get_function_gradients(
-                              (eigenVectors[(1 + dftPtr->getParametersObject()
-                                                   .spinPolarized) *
-                                            kPoint][i]),
-                              tempGradPsiTempAlpha);
-                            if (dftPtr->getParametersObject().spinPolarized ==
-                                1)
-                              fe_values.get_function_gradients(
-                                (eigenVectors[(1 + dftPtr->getParametersObject()
-                                                     .spinPolarized) *
-                                                kPoint +
-                                              1][i]),
-                                tempGradPsiTempBeta);
-                          }
-                        //
-                        for (unsigned int iList = 0; iList < numPoint; ++iList)
-                          {
-                            //
-                            if (dftPtr->getParametersObject().spinPolarized ==
-                                1)
-                              {
-                                rhoTempSpinPolarized[2 *
-                                                     (numPointsDone + iList)] +=
-                                  1.0 / (double(numSymmUnderGroup[kPoint])) *
-                                  partialOccupancyAlpha *
-                                  (dftPtr->d_kPointWeights)[kPoint] *
-                                  (tempPsiAlpha[iList](0) *
-                                     tempPsiAlpha[iList](0) +
-                                   tempPsiAlpha[iList](1) *
-                                     tempPsiAlpha[iList](1));
-                                rhoTempSpinPolarized[2 *
-                                                       (numPointsDone + iList) +
-                                                     1] +=
-                                  1.0 / (double(numSymmUnderGroup[kPoint])) *
-                                  partialOccupancyBeta *
-                                  (dftPtr->d_kPointWeights)[kPoint] *
-                                  (tempPsiBeta[iList](0) *
-                                     tempPsiBeta[iList](0) +
-                                   tempPsiBeta[iList](1) *
-                                     tempPsiBeta[iList](1));
-                              }
-                            else
-                              rhoTemp[numPointsDone + iList] +=
-                                1.0 / (double(numSymmUnderGroup[kPoint])) *
-                                2.0 * partialOccupancyAlpha *
-                                (dftPtr->d_kPointWeights)[kPoint] *
-                                (tempPsiAlpha[iList](0) *
-                                   tempPsiAlpha[iList](0) +
-                                 tempPsiAlpha[iList](1) *
-                                   tempPsiAlpha[iList](1));
-                            if (dftPtr->d_excManagerPtr
-                                  ->getDensityBasedFamilyType() ==
-                                densityFamilyType::GGA)
-                              {
-                                for (unsigned int j = 0; j < 3; ++j)
+                              eigenVector, gradPsiValues[iSpinor]);
+                        }
+                      //
+                      for (unsigned int iList = 0; iList < numPoint; ++iList)
+                        {
+                          if (numDensityComponents == 4)
+                            {
+                              // rho, mz, my and mx of the spinor
+                              const double upReal = psiValues[0][iList](0);
+                              const double upImag = psiValues[0][iList](1);
+                              const double downReal = psiValues[1][iList](0);
+                              const double downImag = psiValues[1][iList](1);
+                              const double upSquare =
+                                upReal * upReal + upImag * upImag;
+                              const double downSquare =
+                                downReal * downReal + downImag * downImag;
+                              double *rhoPoint = &rhoGroup[4 * iList];
+                              rhoPoint[0] += weight * (upSquare + downSquare);
+                              rhoPoint[1] += weight * (upSquare - downSquare);
+                              rhoPoint[2] += weight * 2.0 *
+                                             (upReal * downImag -
+                                              upImag * downReal);
+                              rhoPoint[3] += weight * 2.0 *
+                                             (upReal * downReal +
+                                              upImag * downImag);
+                              if (isGGA)
+                                for (unsigned int iDim = 0; iDim < 3; ++iDim)
                                   {
-                                    tempGradPsi[iList][0][j] =
-                                      tempGradPsiTempAlpha[iList][0][0] *
-                                        symmMat[iSymm][0][j] +
-                                      tempGradPsiTempAlpha[iList][0][1] *
-                                        symmMat[iSymm][1][j] +
-                                      tempGradPsiTempAlpha[iList][0][2] *
-                                        symmMat[iSymm][2][j];
-                                    tempGradPsi[iList][1][j] =
-                                      tempGradPsiTempAlpha[iList][1][0] *
-                                        symmMat[iSymm][0][j] +
-                                      tempGradPsiTempAlpha[iList][1][1] *
-                                        symmMat[iSymm][1][j] +
-                                      tempGradPsiTempAlpha[iList][1][2] *
-                                        symmMat[iSymm][2][j];
+                                    const double gradUpReal =
+                                      gradPsiValues[0][iList][0][iDim];
+                                    const double gradUpImag =
+                                      gradPsiValues[0][iList][1][iDim];
+                                    const double gradDownReal =
+                                      gradPsiValues[1][iList][0][iDim];
+                                    const double gradDownImag =
+                                      gradPsiValues[1][iList][1][iDim];
+                                    const double upGradUp =
+                                      upReal * gradUpReal + upImag * gradUpImag;
+                                    const double downGradDown =
+                                      downReal * gradDownReal +
+                                      downImag * gradDownImag;
+                                    const double crossReal =
+                                      gradUpReal * downReal +
+                                      gradUpImag * downImag +
+                                      upReal * gradDownReal +
+                                      upImag * gradDownImag;
+                                    const double crossImag =
+                                      gradUpReal * downImag -
+                                      gradUpImag * downReal +
+                                      upReal * gradDownImag -
+                                      upImag * gradDownReal;
+                                    double *gradRhoPoint =
+                                      &gradRhoGroup[12 * iList];
+                                    gradRhoPoint[iDim] += 2.0 * weight *
+                                                          (upGradUp +
+                                                           downGradDown);
+                                    gradRhoPoint[3 + iDim] +=
+                                      2.0 * weight * (upGradUp - downGradDown);
+                                    gradRhoPoint[6 + iDim] +=
+                                      2.0 * weight * crossImag;
+                                    gradRhoPoint[9 + iDim] +=
+                                      2.0 * weight * crossReal;
                                   }
-                                if (dftPtr->getParametersObject()
-                                      .spinPolarized == 1)
-                                  {
-                                    gradRhoTempSpinPolarized
-                                      [6 * (numPointsDone + iList) + 0] +=
-                                      1.0 /
-                                      (double(numSymmUnderGroup[kPoint])) *
-                                      2.0 * partialOccupancyAlpha *
-                                      (dftPtr->d_kPointWeights)[kPoint] *
-                                      (tempPsiAlpha[iList](0) *
-                                         tempGradPsi[iList][0][0] +
-                                       tempPsiAlpha[iList](1) *
-                                         tempGradPsi[iList][1][0]);
-                                    gradRhoTempSpinPolarized
-                                      [6 * (numPointsDone + iList) + 1] +=
-                                      1.0 /
-                                      (double(numSymmUnderGroup[kPoint])) *
-                                      2.0 * partialOccupancyAlpha *
-                                      (dftPtr->d_kPointWeights)[kPoint] *
-                                      (tempPsiAlpha[iList](0) *
-                                         tempGradPsi[iList][0][1] +
-                                       tempPsiAlpha[iList](1) *
-                                         tempGradPsi[iList][1][1]);
-                                    gradRhoTempSpinPolarized
-                                      [6 * (numPointsDone + iList) + 2] +=
-                                      1.0 /
-                                      (double(numSymmUnderGroup[kPoint])) *
-                                      2.0 * partialOccupancyAlpha *
-                                      (dftPtr->d_kPointWeights)[kPoint] *
-                                      (tempPsiAlpha[iList](0) *
-                                         tempGradPsi[iList][0][2] +
-                                       tempPsiAlpha[iList](1) *
-                                         tempGradPsi[iList][1][2]);
-                                    for (unsigned int j = 0; j < 3; ++j)
-                                      {
-                                        tempGradPsi[iList][0][j] =
-                                          tempGradPsiTempBeta[iList][0][0] *
-                                            symmMat[iSymm][0][j] +
-                                          tempGradPsiTempBeta[iList][0][1] *
-                                            symmMat[iSymm][1][j] +
-                                          tempGradPsiTempBeta[iList][0][2] *
-                                            symmMat[iSymm][2][j];
-                                        tempGradPsi[iList][1][j] =
-                                          tempGradPsiTempBeta[iList][1][0] *
-                                            symmMat[iSymm][0][j] +
-                                          tempGradPsiTempBeta[iList][1][1] *
-                                            symmMat[iSymm][1][j] +
-                                          tempGradPsiTempBeta[iList][1][2] *
-                                            symmMat[iSymm][2][j];
-                                      }
-                                    //
-                                    gradRhoTempSpinPolarized
-                                      [6 * (numPointsDone + iList) + 3] +=
-                                      1.0 /
-                                      (double(numSymmUnderGroup[kPoint])) *
-                                      2.0 * partialOccupancyBeta *
-                                      (dftPtr->d_kPointWeights)[kPoint] *
-                                      (tempPsiBeta[iList](0) *
-                                         tempGradPsi[iList][0][0] +
-                                       tempPsiBeta[iList](1) *
-                                         tempGradPsi[iList][1][0]);
-                                    gradRhoTempSpinPolarized
-                                      [6 * (numPointsDone + iList) + 4] +=
-                                      1.0 /
-                                      (double(numSymmUnderGroup[kPoint])) *
-                                      2.0 * partialOccupancyBeta *
-                                      (dftPtr->d_kPointWeights)[kPoint] *
-                                      (tempPsiBeta[iList](0) *
-                                         tempGradPsi[iList][0][1] +
-                                       tempPsiBeta[iList](1) *
-                                         tempGradPsi[iList][1][1]);
-                                    gradRhoTempSpinPolarized
-                                      [6 * (numPointsDone + iList) + 5] +=
-                                      1.0 /
-                                      (double(numSymmUnderGroup[kPoint])) *
-                                      2.0 * partialOccupancyBeta *
-                                      (dftPtr->d_kPointWeights)[kPoint] *
-                                      (tempPsiBeta[iList](0) *
-                                         tempGradPsi[iList][0][2] +
-                                       tempPsiBeta[iList](1) *
-                                         tempGradPsi[iList][1][2]);
-                                  }
-                                else
-                                  {
-                                    gradRhoTemp[3 * (numPointsDone + iList) +
-                                                0] +=
-                                      1.0 /
-                                      (double(numSymmUnderGroup[kPoint])) *
-                                      2.0 * 2.0 * partialOccupancyAlpha *
-                                      (dftPtr->d_kPointWeights)[kPoint] *
-                                      (tempPsiAlpha[iList](0) *
-                                         tempGradPsi[iList][0][0] +
-                                       tempPsiAlpha[iList](1) *
-                                         tempGradPsi[iList][1][0]);
-                                    gradRhoTemp[3 * (numPointsDone + iList) +
-                                                1] +=
-                                      1.0 /
-                                      (double(numSymmUnderGroup[kPoint])) *
-                                      2.0 * 2.0 * partialOccupancyAlpha *
-                                      (dftPtr->d_kPointWeights)[kPoint] *
-                                      (tempPsiAlpha[iList](0) *
-                                         tempGradPsi[iList][0][1] +
-                                       tempPsiAlpha[iList](1) *
-                                         tempGradPsi[iList][1][1]);
-                                    gradRhoTemp[3 * (numPointsDone + iList) +
-                                                2] +=
-                                      1.0 /
-                                      (double(numSymmUnderGroup[kPoint])) *
-                                      2.0 * 2.0 * partialOccupancyAlpha *
-                                      (dftPtr->d_kPointWeights)[kPoint] *
-                                      (tempPsiAlpha[iList](0) *
-                                         tempGradPsi[iList][0][2] +
-                                       tempPsiAlpha[iList](1) *
-                                         tempGradPsi[iList][1][2]);
-                                  }
-                              }
-                          } // loop on points list
-                      }     // loop on eigenValues
-                  } // if this symm is part of the group under this kpoint
-              }     // loop on k Points
+                            }
+                          else
+                            {
+                              const unsigned int iComp =
+                                numDensityComponents == 2 ? spinIndex : 0;
+                              for (unsigned int iSpinor = 0;
+                                   iSpinor < numWfnSpinors;
+                                   ++iSpinor)
+                                {
+                                  const dealii::Vector<double> &psi =
+                                    psiValues[iSpinor][iList];
+                                  rhoGroup[numDensityComponents * iList +
+                                           iComp] +=
+                                    weight *
+                                    (psi(0) * psi(0) + psi(1) * psi(1));
+                                  if (isGGA)
+                                    for (unsigned int iDim = 0; iDim < 3;
+                                         ++iDim)
+                                      gradRhoGroup[3 * numDensityComponents *
+                                                     iList +
+                                                   3 * iComp + iDim] +=
+                                        2.0 * weight *
+                                        (psi(0) *
+                                           gradPsiValues[iSpinor][iList][0]
+                                                        [iDim] +
+                                         psi(1) *
+                                           gradPsiValues[iSpinor][iList][1]
+                                                        [iDim]);
+                                }
+                            }
+                        } // loop on points list
+                    }     // loop on eigenValues
+              }           // loop on k Points
+            //
+            //=============================================================================================================================================
+            //				  Transform to the untransformed point, the gradients
+            // along with the symmetry operation and the magnetization as an
+            // axial vector, flipped by time reversal
+            //=============================================================================================================================================
+            const std::vector<std::vector<double>> &rotationCart =
+              symmMatCart[iSymm];
+            const double axialFactor =
+              (timeReversedSymm[iSymm] == 1 ? -1.0 : 1.0) *
+              (rotationCart[0][0] * (rotationCart[1][1] * rotationCart[2][2] -
+                                     rotationCart[1][2] * rotationCart[2][1]) -
+               rotationCart[0][1] * (rotationCart[1][0] * rotationCart[2][2] -
+                                     rotationCart[1][2] * rotationCart[2][0]) +
+               rotationCart[0][2] * (rotationCart[1][0] * rotationCart[2][1] -
+                                     rotationCart[1][1] * rotationCart[2][0]));
+            // density component of the magnetization along a cartesian
+            // direction
+            const unsigned int magComponent[3] = {3, 2, 1};
+            for (unsigned int iList = 0; iList < numPoint; ++iList)
+              {
+                const double *rhoPoint =
+                  &rhoGroup[numDensityComponents * iList];
+                double *rhoPointTemp =
+                  rhoTemp + numDensityComponents * (numPointsDone + iList);
+                for (unsigned int iComp = 0; iComp < numDensityComponents;
+                     ++iComp)
+                  rhoPointTemp[iComp] = rhoPoint[iComp];
+                if (numDensityComponents == 4)
+                  for (unsigned int i = 0; i < 3; ++i)
+                    {
+                      rhoPointTemp[magComponent[i]] = 0.0;
+                      for (unsigned int j = 0; j < 3; ++j)
+                        rhoPointTemp[magComponent[i]] +=
+                          axialFactor * rotationCart[j][i] *
+                          rhoPoint[magComponent[j]];
+                    }
+                //
+                if (isGGA)
+                  {
+                    double *gradRhoPoint =
+                      &gradRhoGroup[3 * numDensityComponents * iList];
+                    double *gradRhoPointTemp =
+                      gradRhoTemp +
+                      3 * numDensityComponents * (numPointsDone + iList);
+                    for (unsigned int iComp = 0; iComp < numDensityComponents;
+                         ++iComp)
+                      for (unsigned int j = 0; j < 3; ++j)
+                        gradRhoPointTemp[3 * iComp + j] =
+                          gradRhoPoint[3 * iComp + 0] * symmMat[iSymm][0][j] +
+                          gradRhoPoint[3 * iComp + 1] * symmMat[iSymm][1][j] +
+                          gradRhoPoint[3 * iComp + 2] * symmMat[iSymm][2][j];
+                    if (numDensityComponents == 4)
+                      {
+                        std::copy(gradRhoPointTemp,
+                                  gradRhoPointTemp + 12,
+                                  gradRhoPoint);
+                        for (unsigned int i = 0; i < 3; ++i)
+                          for (unsigned int iDim = 0; iDim < 3; ++iDim)
+                            {
+                              gradRhoPointTemp[3 * magComponent[i] + iDim] =
+                                0.0;
+                              for (unsigned int j = 0; j < 3; ++j)
+                                gradRhoPointTemp[3 * magComponent[i] + iDim] +=
+                                  axialFactor * rotationCart[j][i] *
+                                  gradRhoPoint[3 * magComponent[j] + iDim];
+                            }
+                      }
+                  }
+              }
             //
             numPointsDone += numPoint;
           } // loop on group
@@ -609,136 +515,35 @@ namespace dftfe
         numGroupsDone += recv_size0[proc];
       } // loop on proc
     //
-    MPI_Allreduce(
-      &rhoTemp[0], &rhoLocal[0], totPoints, MPI_DOUBLE, MPI_SUM, interpoolcomm);
-    if (dftPtr->d_excManagerPtr->getDensityBasedFamilyType() ==
-        densityFamilyType::GGA)
-      MPI_Allreduce(&gradRhoTemp[0],
-                    &gradRhoLocal[0],
-                    3 * totPoints,
-                    MPI_DOUBLE,
-                    MPI_SUM,
-                    interpoolcomm);
-    if (dftPtr->getParametersObject().spinPolarized == 1)
-      {
-        MPI_Allreduce(&rhoTempSpinPolarized[0],
-                      &rhoLocalSpinPolarized[0],
-                      2 * totPoints,
-                      MPI_DOUBLE,
-                      MPI_SUM,
-                      interpoolcomm);
-        if (dftPtr->d_excManagerPtr->getDensityBasedFamilyType() ==
-            densityFamilyType::GGA)
-          MPI_Allreduce(&gradRhoTempSpinPolarized[0],
-                        &gradRhoLocalSpinPolarized[0],
-                        6 * totPoints,
-                        MPI_DOUBLE,
-                        MPI_SUM,
-                        interpoolcomm);
-      }
+    MPI_Allreduce(MPI_IN_PLACE,
+                  densityTemp.data(),
+                  densityTempSize,
+                  MPI_DOUBLE,
+                  MPI_SUM,
+                  interpoolcomm);
     //================================================================================================================================================
-    //			      Now first prepare the flattened sending vectors and then MPI
-    // scatter. 		         The essential idea here is that each processor
-    // sends the computed density on the transformed points
-    //                                back to all other processors.from which
-    //                                the points came from.
+    //			      The density computed on the transformed points is sent back
+    // to the processors the points came from, in a single exchange over
+    // flattened buffers
     //================================================================================================================================================
-    sendData.resize((1 + dftPtr->getParametersObject().spinPolarized) *
-                    totPoints);
-    if (dftPtr->getParametersObject().spinPolarized == 1)
-      sendData = rhoLocalSpinPolarized;
-    else
-      sendData = rhoLocal;
-    //
-    typename dealii::DoFHandler<3>::active_cell_iterator cell;
-    typename dealii::DoFHandler<3>::active_cell_iterator endc =
-      (dftPtr->dofHandlerEigen).end();
-    //
-    for (int sendProc = 0; sendProc < n_mpi_processes; ++sendProc)
-      {
-        recvdData.resize(recv_size[sendProc]);
-        MPI_Scatterv(&(sendData[0]),
-                     &(recv_size1[0]),
-                     &(mpi_offsets1[0]),
-                     MPI_DOUBLE,
-                     &(recvdData[0]),
-                     recv_size[sendProc],
-                     MPI_DOUBLE,
-                     sendProc,
-                     mpi_communicator);
-        //
-        cell                = (dftPtr->dofHandlerEigen).begin_active();
-        unsigned int offset = 0;
-        for (; cell != endc; ++cell)
-          {
-            if (cell->is_locally_owned())
-              {
-                for (unsigned int iSymm = 0; iSymm < numSymm; ++iSymm)
-                  {
-                    for (unsigned int i = 0;
-                         i < rhoRecvd[iSymm][globalCellId[cell->id()]][sendProc]
-                               .size();
-                         ++i)
-                      rhoRecvd[iSymm][globalCellId[cell->id()]][sendProc][i] =
-                        recvdData[offset + i];
-                    //
-                    offset +=
-                      rhoRecvd[iSymm][globalCellId[cell->id()]][sendProc]
-                        .size();
-                  }
-              }
-          }
-        recvdData.clear();
-      }
-    //
-    if (dftPtr->d_excManagerPtr->getDensityBasedFamilyType() ==
-        densityFamilyType::GGA)
-      {
-        sendData.resize(3 * (1 + dftPtr->getParametersObject().spinPolarized) *
-                        totPoints);
-        if (dftPtr->getParametersObject().spinPolarized == 1)
-          sendData = gradRhoLocalSpinPolarized;
-        else
-          sendData = gradRhoLocal;
-        //
-        for (int sendProc = 0; sendProc < n_mpi_processes; ++sendProc)
-          {
-            recvdData.resize(3 * recv_size[sendProc]);
-            MPI_Scatterv(&(sendData[0]),
-                         &(recvGrad_size1[0]),
-                         &(mpiGrad_offsets1[0]),
-                         MPI_DOUBLE,
-                         &(recvdData[0]),
-                         3 * recv_size[sendProc],
-                         MPI_DOUBLE,
-                         sendProc,
-                         mpi_communicator);
-            //
-            cell                = (dftPtr->dofHandlerEigen).begin_active();
-            unsigned int offset = 0;
-            //
-            for (; cell != endc; ++cell)
-              {
-                if (cell->is_locally_owned())
-                  {
-                    for (unsigned int iSymm = 0; iSymm < numSymm; ++iSymm)
-                      {
-                        for (unsigned int i = 0;
-                             i < gradRhoRecvd[iSymm][globalCellId[cell->id()]]
-                                             [sendProc]
-                                               .size();
-                             ++i)
-                          gradRhoRecvd[iSymm][globalCellId[cell->id()]]
-                                      [sendProc][i] = recvdData[offset + i];
-                        //
-                        offset += gradRhoRecvd[iSymm][globalCellId[cell->id()]]
-                                              [sendProc]
-                                                .size();
-                      }
-                  }
-              }
-            recvdData.clear();
-          }
-      }
+    MPI_Alltoallv(rhoTemp,
+                  recv_size1.data(),
+                  mpi_offsets1.data(),
+                  MPI_DOUBLE,
+                  rhoRecvd.data(),
+                  recv_size.data(),
+                  recv_offsets.data(),
+                  MPI_DOUBLE,
+                  mpi_communicator);
+    if (isGGA)
+      MPI_Alltoallv(gradRhoTemp,
+                    recvGrad_size1.data(),
+                    mpiGrad_offsets1.data(),
+                    MPI_DOUBLE,
+                    gradRhoRecvd.data(),
+                    recvGrad_size.data(),
+                    recvGrad_offsets.data(),
+                    MPI_DOUBLE,
+                    mpi_communicator);
   } // end function
 } // namespace dftfe
@@ -439,6 +439,8 @@ namespace dftfe
           }
       }
 
+    const utils::AtomSpatialIndex atomsSpatialIndex(atomPointsLocal);
+
     //
     //
     //
@@ -476,21 +478,22 @@ namespace dftfe
             bool cellRefineFlag = false;
 
 
-            // loop over all atoms
+            // closest atom or image atom
             double           distanceToClosestAtom = 1e8;
             dealii::Point<3> closestAtom;
             unsigned int     closestId = 0;
-            for (unsigned int n = 0; n < atomPointsLocal.size() / 3; n++)
+            if (atomsSpatialIndex.numPoints() > 0)
               {
-                dealii::Point<3> atom(atomPointsLocal[3 * n],
-                                      atomPointsLocal[3 * n + 1],
-                                      atomPointsLocal[3 * n + 2]);
-                if (center.distance(atom) < distanceToClosestAtom)
-                  {
-                    distanceToClosestAtom = center.distance(atom);
-                    closestAtom           = atom;
-                    closestId             = n;
-                  }
+                const double centerCoord[3] = {center[0], center[1], center[2]};
+                double       closestDistance;
+                closestId =
+                  atomsSpatialIndex.findClosestPoint(centerCoord,
+                                                     closestDistance);
+                closestAtom =
+                  dealii::Point<3>(atomPointsLocal[3 * closestId],
+                                   atomPointsLocal[3 * closestId + 1],
+                                   atomPointsLocal[3 * closestId + 2]);
+                distanceToClosestAtom = center.distance(closestAtom);
               }
 
             if (d_dftParams.autoAdaptBaseMeshSize)
@@ -22,6 +22,7 @@
  */
 
 
+#include <AtomSpatialIndex.h>
 #include <constants.h>
 #include <dftUtils.h>
 #include <vectorUtilities.h>
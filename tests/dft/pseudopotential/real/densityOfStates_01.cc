@@ -0,0 +1,167 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2017-2022 The Regents of the University of Michigan and DFT-FE
+// authors.
+//
+// This file is part of the DFT-FE code.
+//
+// The DFT-FE code is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the DFT-FE distribution.
+//
+// ---------------------------------------------------------------------
+//
+// Checks the kernels of the batched LDOS and PDOS computations against the
+// direct loops they replace. The spinor sums of |psi|^2 of a block of states
+// are compared for one and two spinor components. The Lorentzian smearing of
+// 10 states with per region weights onto an energy grid of 1000 intervals, a
+// single GEMM, is compared with the loop over regions, states and energies,
+// also when the states are accumulated in two blocks. On a grid wide
+// compared to the smearing the density of states of each region has to
+// integrate to the sum of its weights.
+//
+#include <densityOfStates.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+int
+main()
+{
+  const dftfe::linearAlgebra::BLASWrapper<dftfe::utils::MemorySpace::HOST>
+    BLASWrapper;
+
+  // spinor sums, rows are quadrature points or orbitals
+  const unsigned int numRows = 7, blockSize = 5;
+  for (const unsigned int numWfnSpinors : {1, 2})
+    {
+      const unsigned int                    numVec = blockSize * numWfnSpinors;
+      std::vector<dftfe::dataTypes::number> values(numRows * numVec);
+      for (unsigned int i = 0; i < values.size(); ++i)
+        values[i] = std::sin(0.9 * i + 0.2);
+      std::vector<double> normSquared(numRows * blockSize);
+      dftfe::internal::computeSpinorNormSquared(
+        values.data(), numRows, numWfnSpinors, blockSize, normSquared.data());
+      double error = 0.0;
+      for (unsigned int iRow = 0; iRow < numRows; ++iRow)
+        for (unsigned int iWave = 0; iWave < blockSize; ++iWave)
+          {
+            double reference = 0.0;
+            for (unsigned int iSpinor = 0; iSpinor < numWfnSpinors; ++iSpinor)
+              reference += std::norm(
+                values[iRow * numVec + iSpinor * blockSize + iWave]);
+            error = std::max(error,
+                             std::abs(normSquared[iRow * blockSize + iWave] -
+                                      reference));
+          }
+      std::printf("spinors %u: norms exact %d\n",
+                  numWfnSpinors,
+                  (int)(error == 0.0));
+    }
+
+  // smearing onto the energy grid, the weights are indexed by
+  // [iRegion * numStates + iState]
+  const unsigned int numStates = 10, numRegions = 3, numberIntervals = 1000;
+  const double       lowerBoundEpsilon = -5.0, intervalSize = 0.01;
+  const double       sigma = 0.02, scalingFactor = 0.5;
+  std::vector<double> eigenValues(numStates);
+  std::vector<double> stateWeights(numRegions * numStates);
+  for (unsigned int iState = 0; iState < numStates; ++iState)
+    eigenValues[iState] = -1.5 + 0.3 * iState + 0.01 * std::sin(iState);
+  for (unsigned int i = 0; i < stateWeights.size(); ++i)
+    stateWeights[i] = 0.5 + 0.4 * std::cos(1.3 * i);
+
+  std::vector<double> densityOfStates(numRegions * numberIntervals, 0.0);
+  std::vector<double> smearingKernel(numStates * numberIntervals);
+  dftfe::internal::accumulateSmearedDensityOfStates(BLASWrapper,
+                                                    eigenValues.data(),
+                                                    numStates,
+                                                    lowerBoundEpsilon,
+                                                    intervalSize,
+                                                    numberIntervals,
+                                                    sigma,
+                                                    scalingFactor,
+                                                    stateWeights.data(),
+                                                    numRegions,
+                                                    smearingKernel,
+                                                    densityOfStates.data());
+
+  double maxValue = 0.0, gemmError = 0.0;
+  for (unsigned int iRegion = 0; iRegion < numRegions; ++iRegion)
+    for (unsigned int epsInt = 0; epsInt < numberIntervals; ++epsInt)
+      {
+        double reference = 0.0;
+        for (unsigned int iState = 0; iState < numStates; ++iState)
+          {
+            const double term1 =
+              lowerBoundEpsilon + epsInt * intervalSize - eigenValues[iState];
+            reference += scalingFactor * (sigma / M_PI) *
+                         (1.0 / (term1 * term1 + sigma * sigma)) *
+                         stateWeights[iRegion * numStates + iState];
+          }
+        maxValue  = std::max(maxValue, std::abs(reference));
+        gemmError = std::max(
+          gemmError,
+          std::abs(densityOfStates[iRegion * numberIntervals + epsInt] -
+                   reference));
+      }
+  std::printf("single GEMM matches the direct loop: %d\n",
+              (int)(gemmError < 1e-13 * maxValue));
+
+  // the same states in blocks of 6 and 4, with the weights of each block
+  std::vector<double> densityOfStatesBlocked(numRegions * numberIntervals,
+                                             0.0);
+  for (unsigned int startState = 0; startState < numStates; startState += 6)
+    {
+      const unsigned int numBlockStates =
+        std::min(6u, numStates - startState);
+      std::vector<double> blockWeights(numRegions * numBlockStates);
+      for (unsigned int iRegion = 0; iRegion < numRegions; ++iRegion)
+        for (unsigned int iState = 0; iState < numBlockStates; ++iState)
+          blockWeights[iRegion * numBlockStates + iState] =
+            stateWeights[iRegion * numStates + startState + iState];
+      dftfe::internal::accumulateSmearedDensityOfStates(
+        BLASWrapper,
+        eigenValues.data() + startState,
+        numBlockStates,
+        lowerBoundEpsilon,
+        intervalSize,
+        numberIntervals,
+        sigma,
+        scalingFactor,
+        blockWeights.data(),
+        numRegions,
+        smearingKernel,
+        densityOfStatesBlocked.data());
+    }
+  double blockedError = 0.0;
+  for (unsigned int i = 0; i < densityOfStates.size(); ++i)
+    blockedError = std::max(blockedError,
+                            std::abs(densityOfStatesBlocked[i] -
+                                     densityOfStates[i]));
+  std::printf("blocked accumulation matches: %d\n",
+              (int)(blockedError < 1e-13 * maxValue));
+
+  // the Lorentzian tails outside of the grid are below 4e-3 of the weights
+  // and the rectangle rule is accurate for a spacing of half the smearing
+  double integralError = 0.0;
+  for (unsigned int iRegion = 0; iRegion < numRegions; ++iRegion)
+    {
+      double integral = 0.0, weightSum = 0.0;
+      for (unsigned int epsInt = 0; epsInt < numberIntervals; ++epsInt)
+        integral +=
+          densityOfStates[iRegion * numberIntervals + epsInt] * intervalSize;
+      for (unsigned int iState = 0; iState < numStates; ++iState)
+        weightSum += scalingFactor * stateWeights[iRegion * numStates + iState];
+      integralError =
+        std::max(integralError, std::abs(integral - weightSum) / weightSum);
+    }
+  std::printf("integrated density of states matches the weights: %d\n",
+              (int)(integralError < 1e-2));
+  return 0;
+}
@@ -0,0 +1,185 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2017-2022 The Regents of the University of Michigan and DFT-FE
+// authors.
+//
+// This file is part of the DFT-FE code.
+//
+// The DFT-FE code is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the DFT-FE distribution.
+//
+// ---------------------------------------------------------------------
+//
+// Evaluates dftUtils::computeLocalFrameSpinDensity, which maps the
+// noncollinear density (rho, mz, my, mx) to the (rho, |m|) input of the spin
+// polarized exchange-correlation terms of the noncollinear forces and stress,
+// for an analytic magnetization field on 64 points. |m| and the density have
+// to be reproduced exactly and grad|m| has to agree with central finite
+// differences of |m|. A point with vanishing magnetization has to get a zero
+// gradient, and for LDA no gradients may be written.
+//
+#include <dftUtils.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+  typedef dftfe::utils::MemoryStorage<double, dftfe::utils::MemorySpace::HOST>
+    hostStorage;
+
+  // rho, mz, my, mx at x and their gradients
+  void
+  evaluateDensity(const double *x, double *values, double *gradients)
+  {
+    values[0]    = 1.0 + 0.3 * std::sin(x[0]) * std::cos(x[1]);
+    gradients[0] = 0.3 * std::cos(x[0]) * std::cos(x[1]);
+    gradients[1] = -0.3 * std::sin(x[0]) * std::sin(x[1]);
+    gradients[2] = 0.0;
+
+    values[1]    = 0.2 * std::sin(x[0] + 2.0 * x[1]);
+    gradients[3] = 0.2 * std::cos(x[0] + 2.0 * x[1]);
+    gradients[4] = 0.4 * std::cos(x[0] + 2.0 * x[1]);
+    gradients[5] = 0.0;
+
+    values[2]    = 0.1 * std::cos(x[2] - x[0]);
+    gradients[6] = 0.1 * std::sin(x[2] - x[0]);
+    gradients[7] = 0.0;
+    gradients[8] = -0.1 * std::sin(x[2] - x[0]);
+
+    values[3]     = 0.05 + 0.15 * std::sin(x[1]) * std::cos(x[2]);
+    gradients[9]  = 0.0;
+    gradients[10] = 0.15 * std::cos(x[1]) * std::cos(x[2]);
+    gradients[11] = -0.15 * std::sin(x[1]) * std::sin(x[2]);
+  }
+
+  double
+  magnetizationNorm(const double *x)
+  {
+    double values[4], gradients[12];
+    evaluateDensity(x, values, gradients);
+    return std::sqrt(values[1] * values[1] + values[2] * values[2] +
+                     values[3] * values[3]);
+  }
+} // namespace
+
+int
+main()
+{
+  const unsigned int numPoints = 64;
+  // the last point has a vanishing magnetization
+  const unsigned int numPointsTotal = numPoints + 1;
+
+  std::vector<double> points(3 * numPoints);
+  for (unsigned int iPoint = 0; iPoint < numPoints; ++iPoint)
+    for (unsigned int iDim = 0; iDim < 3; ++iDim)
+      points[3 * iPoint + iDim] =
+        2.0 * std::sin(1.7 * iPoint + 2.3 * iDim + 0.4 * iPoint * iDim);
+
+  std::vector<std::vector<double>> rhoValuesHost(
+    4, std::vector<double>(numPointsTotal, 0.0));
+  std::vector<std::vector<double>> gradRhoValuesHost(
+    4, std::vector<double>(3 * numPointsTotal, 0.0));
+  for (unsigned int iPoint = 0; iPoint < numPoints; ++iPoint)
+    {
+      double values[4], gradients[12];
+      evaluateDensity(&points[3 * iPoint], values, gradients);
+      for (unsigned int iComp = 0; iComp < 4; ++iComp)
+        {
+          rhoValuesHost[iComp][iPoint] = values[iComp];
+          for (unsigned int iDim = 0; iDim < 3; ++iDim)
+            gradRhoValuesHost[iComp][3 * iPoint + iDim] =
+              gradients[3 * iComp + iDim];
+        }
+    }
+  rhoValuesHost[0][numPoints] = 1.0;
+  for (unsigned int iDim = 0; iDim < 3; ++iDim)
+    for (unsigned int iComp = 0; iComp < 4; ++iComp)
+      gradRhoValuesHost[iComp][3 * numPoints + iDim] = 0.1 * (iComp + 1);
+
+  std::vector<hostStorage> rhoValues(4), gradRhoValues(4);
+  for (unsigned int iComp = 0; iComp < 4; ++iComp)
+    {
+      rhoValues[iComp].resize(numPointsTotal);
+      rhoValues[iComp].copyFrom(rhoValuesHost[iComp]);
+      gradRhoValues[iComp].resize(3 * numPointsTotal);
+      gradRhoValues[iComp].copyFrom(gradRhoValuesHost[iComp]);
+    }
+
+  std::vector<hostStorage> rhoLocalFrameValues, gradRhoLocalFrameValues;
+  dftfe::dftUtils::computeLocalFrameSpinDensity(true,
+                                                rhoValues,
+                                                gradRhoValues,
+                                                rhoLocalFrameValues,
+                                                gradRhoLocalFrameValues);
+
+  double       densityError = 0.0, normError = 0.0, gradientError = 0.0;
+  double       gradientDensityError = 0.0;
+  const double h                    = 1e-5;
+  for (unsigned int iPoint = 0; iPoint < numPoints; ++iPoint)
+    {
+      densityError =
+        std::max(densityError,
+                 std::abs(rhoLocalFrameValues[0][iPoint] -
+                          rhoValuesHost[0][iPoint]));
+      normError = std::max(normError,
+                           std::abs(rhoLocalFrameValues[1][iPoint] -
+                                    magnetizationNorm(&points[3 * iPoint])));
+      for (unsigned int iDim = 0; iDim < 3; ++iDim)
+        {
+          double xPlus[3], xMinus[3];
+          for (unsigned int jDim = 0; jDim < 3; ++jDim)
+            xPlus[jDim] = xMinus[jDim] = points[3 * iPoint + jDim];
+          xPlus[iDim] += h;
+          xMinus[iDim] -= h;
+          const double finiteDifference =
+            (magnetizationNorm(xPlus) - magnetizationNorm(xMinus)) / (2.0 * h);
+          gradientError = std::max(
+            gradientError,
+            std::abs(gradRhoLocalFrameValues[1][3 * iPoint + iDim] -
+                     finiteDifference));
+          gradientDensityError =
+            std::max(gradientDensityError,
+                     std::abs(gradRhoLocalFrameValues[0][3 * iPoint + iDim] -
+                              gradRhoValuesHost[0][3 * iPoint + iDim]));
+        }
+    }
+  double vanishingError = std::abs(rhoLocalFrameValues[1][numPoints]);
+  for (unsigned int iDim = 0; iDim < 3; ++iDim)
+    vanishingError =
+      std::max(vanishingError,
+               std::abs(gradRhoLocalFrameValues[1][3 * numPoints + iDim]));
+
+  std::printf("density exact %d gradient exact %d\n",
+              (int)(densityError == 0.0),
+              (int)(gradientDensityError == 0.0));
+  std::printf("magnetization norm error below 1e-14: %d\n",
+              (int)(normError < 1e-14));
+  std::printf("finite difference error of grad|m| below 1e-8: %d\n",
+              (int)(gradientError < 1e-8));
+  std::printf("vanishing magnetization zero gradient: %d\n",
+              (int)(vanishingError == 0.0));
+
+  std::vector<hostStorage> rhoLocalFrameValuesLDA, gradRhoLocalFrameValuesLDA;
+  dftfe::dftUtils::computeLocalFrameSpinDensity(false,
+                                                rhoValues,
+                                                gradRhoValues,
+                                                rhoLocalFrameValuesLDA,
+                                                gradRhoLocalFrameValuesLDA);
+  double ldaError = 0.0;
+  for (unsigned int iPoint = 0; iPoint < numPointsTotal; ++iPoint)
+    for (unsigned int iComp = 0; iComp < 2; ++iComp)
+      ldaError = std::max(ldaError,
+                          std::abs(rhoLocalFrameValuesLDA[iComp][iPoint] -
+                                   rhoLocalFrameValues[iComp][iPoint]));
+  std::printf("LDA same values %d no gradients %d\n",
+              (int)(ldaError == 0.0),
+              (int)gradRhoLocalFrameValuesLDA.empty());
+  return 0;
+}
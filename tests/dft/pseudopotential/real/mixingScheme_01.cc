@@ -0,0 +1,159 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2017-2022 The Regents of the University of Michigan and DFT-FE
+// authors.
+//
+// This file is part of the DFT-FE code.
+//
+// The DFT-FE code is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the DFT-FE distribution.
+//
+// ---------------------------------------------------------------------
+//
+// Solves the fixed point problem x = g(x), g_i(x) = c_i x_i + 0.1 sin(x_i) +
+// b_i, whose 240 points are distributed over the MPI processes, with
+// MixingScheme in the three modes: Anderson with the Gram matrix recomputed
+// from the history, Anderson with the incremental Gram matrix and modified
+// Broyden. The incremental Gram matrix has to reproduce the iterates of the
+// recomputed one, also once popOldHistory starts dropping the oldest entries.
+// The number of iterations to converge is printed for each mode and history
+// length.
+//
+#include <deal.II/base/mpi.h>
+#include <mixingClass.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+  const unsigned int numPoints     = 240;
+  const unsigned int maxIterations = 100;
+  const double       tolerance     = 1e-9;
+
+  // weighted norm of the residual g(x) - x over all the processes
+  double
+  computeResidual(const std::vector<double> &x,
+                  const std::vector<double> &weights,
+                  const unsigned int         offset,
+                  std::vector<double> &      residual)
+  {
+    double normSquared = 0.0;
+    for (unsigned int i = 0; i < x.size(); ++i)
+      {
+        const double t = (offset + i + 0.5) / numPoints;
+        const double c = -0.6 + 1.2 * t;
+        const double b = std::cos(7.0 * t);
+        residual[i]    = c * x[i] + 0.1 * std::sin(x[i]) + b - x[i];
+        normSquared += weights[i] * residual[i] * residual[i];
+      }
+    MPI_Allreduce(
+      MPI_IN_PLACE, &normSquared, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    return std::sqrt(normSquared);
+  }
+
+  // returns the number of iterations to converge and the iterates
+  unsigned int
+  solve(const bool                        useIncrementalGramMatrix,
+        const bool                        useModifiedBroyden,
+        const unsigned int                mixingHistory,
+        std::vector<std::vector<double>> &iterates)
+  {
+    const unsigned int numProcesses =
+      dealii::Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+    const unsigned int process =
+      dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+    const unsigned int offset = numPoints * process / numProcesses;
+    const unsigned int numPointsPerProcess =
+      numPoints * (process + 1) / numProcesses - offset;
+    dftfe::utils::MemoryStorage<double, dftfe::utils::MemorySpace::HOST>
+      weights(numPointsPerProcess);
+    std::vector<double> weightsHost(numPointsPerProcess);
+    for (unsigned int i = 0; i < numPointsPerProcess; ++i)
+      weightsHost[i] = 1.0 + 0.5 * std::sin((double)(offset + i));
+    weights.copyFrom(weightsHost);
+
+    dftfe::MixingScheme mixingScheme(MPI_COMM_WORLD,
+                                     MPI_COMM_WORLD,
+                                     0,
+                                     useIncrementalGramMatrix,
+                                     useModifiedBroyden);
+    mixingScheme.addMixingVariable(
+      dftfe::mixingVariable::rho, weights, true, 0.5, false);
+
+    std::vector<double> x(numPointsPerProcess, 0.0);
+    std::vector<double> residual(numPointsPerProcess);
+    iterates.clear();
+    for (unsigned int iteration = 0; iteration < maxIterations; ++iteration)
+      {
+        if (computeResidual(x, weightsHost, offset, residual) < tolerance)
+          return iteration;
+        mixingScheme.addVariableToInHist(dftfe::mixingVariable::rho,
+                                         x.data(),
+                                         numPointsPerProcess);
+        mixingScheme.addVariableToResidualHist(dftfe::mixingVariable::rho,
+                                               residual.data(),
+                                               numPointsPerProcess);
+        mixingScheme.popOldHistory(mixingHistory);
+        mixingScheme.computeAndersonMixingCoeff({dftfe::mixingVariable::rho});
+        mixingScheme.mixVariable(dftfe::mixingVariable::rho,
+                                 x.data(),
+                                 numPointsPerProcess);
+        iterates.push_back(x);
+      }
+    return maxIterations;
+  }
+
+  double
+  maxDifference(const std::vector<std::vector<double>> &a,
+                const std::vector<std::vector<double>> &b)
+  {
+    if (a.size() != b.size())
+      return 1.0;
+    double difference = 0.0;
+    for (unsigned int iteration = 0; iteration < a.size(); ++iteration)
+      for (unsigned int i = 0; i < a[iteration].size(); ++i)
+        difference = std::max(difference,
+                              std::abs(a[iteration][i] - b[iteration][i]));
+    MPI_Allreduce(
+      MPI_IN_PLACE, &difference, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+    return difference;
+  }
+} // namespace
+
+int
+main(int argc, char *argv[])
+{
+  dealii::Utilities::MPI::MPI_InitFinalize mpiInitialization(argc, argv, 1);
+  const bool isRoot =
+    dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0;
+
+  for (const unsigned int mixingHistory : {2, 4, 8, 20})
+    {
+      std::vector<std::vector<double>> iteratesAnderson, iteratesIncremental,
+        iteratesBroyden;
+      const unsigned int numIterationsAnderson =
+        solve(false, false, mixingHistory, iteratesAnderson);
+      const unsigned int numIterationsIncremental =
+        solve(true, false, mixingHistory, iteratesIncremental);
+      const unsigned int numIterationsBroyden =
+        solve(false, true, mixingHistory, iteratesBroyden);
+      const bool isIncrementalSame =
+        maxDifference(iteratesAnderson, iteratesIncremental) < 1e-8;
+      if (isRoot)
+        std::printf("history %u: Anderson %u incremental %u (same iterates %d) "
+                    "Broyden %u\n",
+                    mixingHistory,
+                    numIterationsAnderson,
+                    numIterationsIncremental,
+                    (int)isIncrementalSame,
+                    numIterationsBroyden);
+    }
+  return 0;
+}
@@ -0,0 +1,114 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2017-2022 The Regents of the University of Michigan and DFT-FE
+// authors.
+//
+// This file is part of the DFT-FE code.
+//
+// The DFT-FE code is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the DFT-FE distribution.
+//
+// ---------------------------------------------------------------------
+//
+// Parses upf files in memory and prints the tables the atom centered
+// spherical functions are built from. The reference output was generated
+// from the dftfe format files written by the former upf converter
+// (pseudoPotentialToDftfeConverter) for the same upf files, so this checks
+// that the in memory parsing reproduces them. A second request for the same
+// file has to be served from the cache.
+//
+#include <deal.II/base/mpi.h>
+#include <pseudoPotentialData.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace
+{
+  // the number of rows and columns, every stride-th row, the last row and
+  // the column sums
+  void
+  printTable(const std::string &                     name,
+             const std::vector<std::vector<double>> &table)
+  {
+    const std::size_t numColumns = table.empty() ? 0 : table[0].size();
+    std::printf("%s rows %zu columns %zu\n",
+                name.c_str(),
+                table.size(),
+                numColumns);
+    const std::size_t   stride = std::max<std::size_t>(1, table.size() / 12);
+    std::vector<double> columnSums(numColumns, 0.0);
+    for (std::size_t iRow = 0; iRow < table.size(); ++iRow)
+      {
+        for (std::size_t iColumn = 0; iColumn < numColumns; ++iColumn)
+          columnSums[iColumn] += table[iRow][iColumn];
+        if (iRow % stride == 0 || iRow + 1 == table.size())
+          {
+            std::printf("  %5zu", iRow);
+            for (const double value : table[iRow])
+              std::printf(" %16.8e", value);
+            std::printf("\n");
+          }
+      }
+    if (numColumns > 0)
+      {
+        std::printf("  %5s", "sum");
+        for (const double value : columnSums)
+          std::printf(" %16.8e", value);
+        std::printf("\n");
+      }
+  }
+} // namespace
+
+int
+main(int argc, char *argv[])
+{
+  dealii::Utilities::MPI::MPI_InitFinalize mpiInitialization(argc, argv, 1);
+  const bool isRoot =
+    dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0;
+
+  for (const std::string upfFile : {"AlNLCC.upf", "N_ONCV_PBE-1.0.upf"})
+    {
+      const std::string fileName = std::string(SOURCE_DIR) + "/" + upfFile;
+      const std::shared_ptr<const dftfe::pseudoUtils::pseudoPotentialData>
+        data =
+          dftfe::pseudoUtils::getPseudoPotentialData(fileName, MPI_COMM_WORLD);
+      const bool isCached =
+        dftfe::pseudoUtils::getPseudoPotentialData(fileName, MPI_COMM_WORLD) ==
+        data;
+      if (!isRoot)
+        continue;
+
+      std::printf("%s\n", upfFile.c_str());
+      std::printf("NLCC %d SOC %d PAW %d cached %d\n",
+                  (int)data->hasNLCC,
+                  (int)data->hasSOC,
+                  (int)data->isPAW,
+                  (int)isCached);
+      std::printf("projectors %zu\n", data->projectorIds.size());
+      for (const std::vector<double> &projectorId : data->projectorIds)
+        {
+          for (const double value : projectorId)
+            std::printf(" %g", value);
+          std::printf("\n");
+        }
+      for (const auto &radialProjectors : data->radialProjectors)
+        printTable("projectors l=" + std::to_string(radialProjectors.first),
+                   radialProjectors.second);
+      printTable("coupling matrix", data->couplingMatrix);
+      printTable("local potential", data->localPotential);
+      printTable("valence density", data->valenceDensity);
+      printTable("core density", data->coreDensity);
+      for (const auto &orbital : data->orbitals)
+        printTable("orbital n=" + std::to_string(orbital.first.first) +
+                     " l=" + std::to_string(orbital.first.second),
+                   orbital.second);
+    }
+  return 0;
+}
@@ -0,0 +1,52 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2017-2022 The Regents of the University of Michigan and DFT-FE
+// authors.
+//
+// This file is part of the DFT-FE code.
+//
+// The DFT-FE code is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the DFT-FE distribution.
+//
+// ---------------------------------------------------------------------
+//
+// Prints the predictor coefficients B_j of the always stable
+// predictor-corrector used by EXTRAPOLATE WAVEFUNCTIONS for the orders
+// allowed by WAVEFUNCTION EXTRAPOLATION ORDER, together with sum_j B_j, which
+// has to be one, and sum_j j B_j, which has to vanish for the predictor to be
+// exact on a linear trajectory. Orders 0 to 2 are the values tabulated by
+// Kolafa [J. Comput. Chem. 25, 335 (2004)]: (2,-1), (5/2,-2,1/2) and
+// (14/5,-14/5,6/5,-1/5).
+//
+#include <wfcExtrapolation.h>
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+int
+main()
+{
+  for (unsigned int order = 0; order <= 6; ++order)
+    {
+      const std::vector<double> coefficients =
+        dftfe::internal::getASPCPredictorCoefficients(order);
+      double sum = 0.0, firstMoment = 0.0;
+      std::printf("order %u:", order);
+      for (unsigned int j = 1; j <= coefficients.size(); ++j)
+        {
+          std::printf(" %.10f", coefficients[j - 1]);
+          sum += coefficients[j - 1];
+          firstMoment += j * coefficients[j - 1];
+        }
+      // rounding errors are not printed, so that the output has no -0
+      std::printf("\n  sum %.10f first moment %.10f\n",
+                  sum,
+                  std::abs(firstMoment) < 1e-12 ? 0.0 : firstMoment);
+    }
+  return 0;
+}
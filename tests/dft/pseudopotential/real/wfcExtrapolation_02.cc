@@ -0,0 +1,183 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2017-2022 The Regents of the University of Michigan and DFT-FE
+// authors.
+//
+// This file is part of the DFT-FE code.
+//
+// The DFT-FE code is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the DFT-FE distribution.
+//
+// ---------------------------------------------------------------------
+//
+// Aligns two blocks of 6 orthonormal states on 200 points, distributed over
+// the MPI processes, with internal::alignWaveFunctionsProcrustes to a rotated
+// copy of the same subspace, Y = X R with R a product of Givens rotations,
+// which has to be recovered exactly, and to Y = X R + E with a small
+// perturbation E. In the second case the aligned states have to remain
+// orthonormal and be at least as close to Y as X R, the Procrustes rotation
+// being the closest unitary rotation.
+//
+#include <deal.II/base/mpi.h>
+#include <wfcExtrapolation.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+  const unsigned int numPoints = 200;
+  const unsigned int numStates = 6;
+  const unsigned int numBlocks = 2;
+
+  double
+  sumOverProcesses(double value)
+  {
+    MPI_Allreduce(MPI_IN_PLACE, &value, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    return value;
+  }
+
+  double
+  maxOverProcesses(double value)
+  {
+    MPI_Allreduce(MPI_IN_PLACE, &value, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+    return value;
+  }
+
+  // orthonormal cosine states on the points offset,...,offset+numRows-1,
+  // stored row major for each block, the frequencies shifted by the block
+  std::vector<double>
+  createStates(const unsigned int offset, const unsigned int numRows)
+  {
+    std::vector<double> X(numBlocks * numRows * numStates);
+    for (unsigned int iBlock = 0; iBlock < numBlocks; ++iBlock)
+      for (unsigned int i = 0; i < numRows; ++i)
+        for (unsigned int j = 0; j < numStates; ++j)
+          {
+            const unsigned int frequency = j + iBlock;
+            X[(iBlock * numRows + i) * numStates + j] =
+              std::sqrt((frequency == 0 ? 1.0 : 2.0) / numPoints) *
+              std::cos(M_PI * (offset + i + 0.5) * frequency / numPoints);
+          }
+    return X;
+  }
+
+  // Y = X R with R the product of the Givens rotations of the neighbouring
+  // states
+  std::vector<double>
+  rotateStates(const std::vector<double> &X, const unsigned int numRows)
+  {
+    std::vector<double> Y(X);
+    for (unsigned int iBlock = 0; iBlock < numBlocks; ++iBlock)
+      for (unsigned int j = 0; j + 1 < numStates; ++j)
+        {
+          const double angle = 0.3 + 0.2 * j + 0.5 * iBlock;
+          for (unsigned int i = 0; i < numRows; ++i)
+            {
+              double *row = &Y[(iBlock * numRows + i) * numStates];
+              const double first = row[j], second = row[j + 1];
+              row[j]     = std::cos(angle) * first - std::sin(angle) * second;
+              row[j + 1] = std::sin(angle) * first + std::cos(angle) * second;
+            }
+        }
+    return Y;
+  }
+
+  double
+  maxDifference(const std::vector<double> &a, const std::vector<double> &b)
+  {
+    double difference = 0.0;
+    for (unsigned int i = 0; i < a.size(); ++i)
+      difference = std::max(difference, std::abs(a[i] - b[i]));
+    return maxOverProcesses(difference);
+  }
+
+  double
+  distance(const std::vector<double> &a, const std::vector<double> &b)
+  {
+    double normSquared = 0.0;
+    for (unsigned int i = 0; i < a.size(); ++i)
+      normSquared += (a[i] - b[i]) * (a[i] - b[i]);
+    return std::sqrt(sumOverProcesses(normSquared));
+  }
+
+  // max |X^{T}X - I| over the blocks
+  double
+  orthonormalityError(const std::vector<double> &X, const unsigned int numRows)
+  {
+    double error = 0.0;
+    for (unsigned int iBlock = 0; iBlock < numBlocks; ++iBlock)
+      for (unsigned int j = 0; j < numStates; ++j)
+        for (unsigned int k = 0; k < numStates; ++k)
+          {
+            double overlap = 0.0;
+            for (unsigned int i = 0; i < numRows; ++i)
+              overlap += X[(iBlock * numRows + i) * numStates + j] *
+                         X[(iBlock * numRows + i) * numStates + k];
+            overlap = sumOverProcesses(overlap);
+            error   = std::max(error, std::abs(overlap - (j == k ? 1.0 : 0.0)));
+          }
+    return error;
+  }
+} // namespace
+
+int
+main(int argc, char *argv[])
+{
+  dealii::Utilities::MPI::MPI_InitFinalize mpiInitialization(argc, argv, 1);
+  const unsigned int                       numProcesses =
+    dealii::Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+  const unsigned int process =
+    dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+  const bool         isRoot = process == 0;
+  const unsigned int offset = numPoints * process / numProcesses;
+  const unsigned int numRows =
+    numPoints * (process + 1) / numProcesses - offset;
+
+  const std::vector<double> X        = createStates(offset, numRows);
+  const std::vector<double> XRotated = rotateStates(X, numRows);
+
+  // rotated subspace
+  std::vector<double> XAligned(X);
+  dftfe::internal::alignWaveFunctionsProcrustes(XAligned.data(),
+                                                XRotated.data(),
+                                                numBlocks,
+                                                numRows,
+                                                numStates,
+                                                MPI_COMM_WORLD);
+  const bool isRotated        = maxDifference(X, XRotated) > 0.1;
+  const bool isRotationExact  = maxDifference(XAligned, XRotated) < 1e-12;
+  const bool isOrthonormalOne = orthonormalityError(XAligned, numRows) < 1e-12;
+  if (isRoot)
+    std::printf("rotated subspace: rotated %d recovered %d orthonormal %d\n",
+                (int)isRotated,
+                (int)isRotationExact,
+                (int)isOrthonormalOne);
+
+  // rotated and perturbed subspace
+  std::vector<double> Y(XRotated);
+  for (unsigned int i = 0; i < numRows; ++i)
+    for (unsigned int iBlock = 0; iBlock < numBlocks; ++iBlock)
+      for (unsigned int j = 0; j < numStates; ++j)
+        Y[(iBlock * numRows + i) * numStates + j] +=
+          1e-3 * std::sin(0.7 * (offset + i) + 1.3 * j + 2.1 * iBlock);
+  XAligned = X;
+  dftfe::internal::alignWaveFunctionsProcrustes(
+    XAligned.data(), Y.data(), numBlocks, numRows, numStates, MPI_COMM_WORLD);
+  const bool isClosest = distance(XAligned, Y) <= distance(XRotated, Y);
+  const bool isNearRotation   = maxDifference(XAligned, XRotated) < 1e-2;
+  const bool isOrthonormalTwo = orthonormalityError(XAligned, numRows) < 1e-12;
+  if (isRoot)
+    std::printf(
+      "perturbed subspace: closest %d near rotation %d orthonormal %d\n",
+      (int)isClosest,
+      (int)isNearRotation,
+      (int)isOrthonormalTwo);
+  return 0;
+}
@@ -0,0 +1,243 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2017-2022 The Regents of the University of Michigan and DFT-FE
+// authors.
+//
+// This file is part of the DFT-FE code.
+//
+// The DFT-FE code is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the DFT-FE distribution.
+//
+// ---------------------------------------------------------------------
+
+#include <AtomSpatialIndex.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace dftfe
+{
+  namespace utils
+  {
+    AtomSpatialIndex::AtomSpatialIndex()
+    {
+      reinit(std::vector<double>());
+    }
+
+    AtomSpatialIndex::AtomSpatialIndex(const std::vector<double> &points,
+                                       const double               binSize)
+    {
+      reinit(points, binSize);
+    }
+
+    void
+    AtomSpatialIndex::reinit(const std::vector<double> &points,
+                             const double               binSize)
+    {
+      d_points                   = points;
+      const unsigned int nPoints = numPoints();
+
+      double upperCorner[3];
+      for (unsigned int iDim = 0; iDim < 3; ++iDim)
+        {
+          d_lowerCorner[iDim] = 0.0;
+          upperCorner[iDim]   = 0.0;
+        }
+      for (unsigned int iPoint = 0; iPoint < nPoints; ++iPoint)
+        for (unsigned int iDim = 0; iDim < 3; ++iDim)
+          {
+            const double coord = d_points[3 * iPoint + iDim];
+            if (iPoint == 0 || coord < d_lowerCorner[iDim])
+              d_lowerCorner[iDim] = coord;
+            if (iPoint == 0 || coord > upperCorner[iDim])
+              upperCorner[iDim] = coord;
+          }
+
+      double extent[3], maxExtent = 0.0;
+      for (unsigned int iDim = 0; iDim < 3; ++iDim)
+        {
+          extent[iDim] = upperCorner[iDim] - d_lowerCorner[iDim];
+          maxExtent    = std::max(maxExtent, extent[iDim]);
+        }
+
+      d_binSize = binSize;
+      if (d_binSize <= 0.0)
+        {
+          // mean volume per point, flat and linear point sets are given a
+          // small thickness
+          double volume = 1.0;
+          for (unsigned int iDim = 0; iDim < 3; ++iDim)
+            volume *= std::max(extent[iDim], 1e-3 * maxExtent);
+          d_binSize = std::cbrt(volume / std::max(nPoints, 1u));
+        }
+      if (!(d_binSize > 1e-8))
+        d_binSize = std::max(maxExtent, 1.0);
+
+      // keep the number of bins of the order of the number of points
+      const double maxNumBins = 2.0 * nPoints + 8.0;
+      while (true)
+        {
+          double totalBins = 1.0;
+          for (unsigned int iDim = 0; iDim < 3; ++iDim)
+            totalBins *= std::floor(extent[iDim] / d_binSize) + 1.0;
+          if (totalBins <= maxNumBins)
+            break;
+          d_binSize *= 1.25;
+        }
+      for (unsigned int iDim = 0; iDim < 3; ++iDim)
+        d_numBins[iDim] = (int)std::floor(extent[iDim] / d_binSize) + 1;
+
+      const unsigned int totalBins = d_numBins[0] * d_numBins[1] * d_numBins[2];
+      std::vector<unsigned int> pointBinIds(nPoints);
+      d_binStart.assign(totalBins + 1, 0);
+      for (unsigned int iPoint = 0; iPoint < nPoints; ++iPoint)
+        {
+          int binIndex[3];
+          for (unsigned int iDim = 0; iDim < 3; ++iDim)
+            binIndex[iDim] = std::min(
+              (int)std::floor(
+                (d_points[3 * iPoint + iDim] - d_lowerCorner[iDim]) /
+                d_binSize),
+              d_numBins[iDim] - 1);
+          pointBinIds[iPoint] =
+            (binIndex[0] * d_numBins[1] + binIndex[1]) * d_numBins[2] +
+            binIndex[2];
+          d_binStart[pointBinIds[iPoint] + 1] += 1;
+        }
+      for (unsigned int iBin = 0; iBin < totalBins; ++iBin)
+        d_binStart[iBin + 1] += d_binStart[iBin];
+
+      // point ids are inserted in increasing order within each bin
+      d_binPointIds.resize(nPoints);
+      std::vector<unsigned int> binFill(d_binStart.begin(),
+                                        d_binStart.end() - 1);
+      for (unsigned int iPoint = 0; iPoint < nPoints; ++iPoint)
+        d_binPointIds[binFill[pointBinIds[iPoint]]++] = iPoint;
+    }
+
+    unsigned int
+    AtomSpatialIndex::numPoints() const
+    {
+      return d_points.size() / 3;
+    }
+
+    bool
+    AtomSpatialIndex::getBinRange(const double *x,
+                                  const double  radius,
+                                  int *         binMin,
+                                  int *         binMax) const
+    {
+      for (unsigned int iDim = 0; iDim < 3; ++iDim)
+        {
+          // clamped before the conversion to int, the query point can be far
+          // outside the points
+          const double lower =
+            std::floor((x[iDim] - radius - d_lowerCorner[iDim]) / d_binSize);
+          const double upper =
+            std::floor((x[iDim] + radius - d_lowerCorner[iDim]) / d_binSize);
+          if (upper < 0.0 || lower > d_numBins[iDim] - 1)
+            return false;
+          binMin[iDim] = (int)std::max(lower, 0.0);
+          binMax[iDim] = (int)std::min(upper, (double)(d_numBins[iDim] - 1));
+        }
+      return true;
+    }
+
+    double
+    AtomSpatialIndex::distanceSquared(const double *     x,
+                                      const unsigned int pointId) const
+    {
+      const double dx = x[0] - d_points[3 * pointId + 0];
+      const double dy = x[1] - d_points[3 * pointId + 1];
+      const double dz = x[2] - d_points[3 * pointId + 2];
+      return dx * dx + dy * dy + dz * dz;
+    }
+
+    void
+    AtomSpatialIndex::findPointsInBall(
+      const double *             x,
+      const double               radius,
+      std::vector<unsigned int> &pointIds) const
+    {
+      pointIds.clear();
+      int binMin[3], binMax[3];
+      if (numPoints() == 0 || !getBinRange(x, radius, binMin, binMax))
+        return;
+
+      for (int i = binMin[0]; i <= binMax[0]; ++i)
+        for (int j = binMin[1]; j <= binMax[1]; ++j)
+          for (int k = binMin[2]; k <= binMax[2]; ++k)
+            {
+              const unsigned int iBin =
+                (i * d_numBins[1] + j) * d_numBins[2] + k;
+              for (unsigned int iEntry = d_binStart[iBin];
+                   iEntry < d_binStart[iBin + 1];
+                   ++iEntry)
+                {
+                  const unsigned int pointId = d_binPointIds[iEntry];
+                  if (std::sqrt(distanceSquared(x, pointId)) <= radius)
+                    pointIds.push_back(pointId);
+                }
+            }
+      std::sort(pointIds.begin(), pointIds.end());
+    }
+
+    unsigned int
+    AtomSpatialIndex::findClosestPoint(const double *x, double &distance) const
+    {
+      unsigned int closestId = 0;
+      distance               = std::numeric_limits<double>::max();
+      if (numPoints() == 0)
+        return closestId;
+
+      // start from a ball just reaching the bins and grow it until it contains
+      // a point, every point closer than the radius of the ball is then
+      // guaranteed to have been visited
+      double distanceToBinsSquared = 0.0;
+      for (unsigned int iDim = 0; iDim < 3; ++iDim)
+        {
+          const double upper =
+            d_lowerCorner[iDim] + d_numBins[iDim] * d_binSize;
+          const double gap = std::max(
+            std::max(d_lowerCorner[iDim] - x[iDim], x[iDim] - upper), 0.0);
+          distanceToBinsSquared += gap * gap;
+        }
+      double radius = std::sqrt(distanceToBinsSquared) + d_binSize;
+
+      while (true)
+        {
+          int binMin[3], binMax[3];
+          if (getBinRange(x, radius, binMin, binMax))
+            for (int i = binMin[0]; i <= binMax[0]; ++i)
+              for (int j = binMin[1]; j <= binMax[1]; ++j)
+                for (int k = binMin[2]; k <= binMax[2]; ++k)
+                  {
+                    const unsigned int iBin =
+                      (i * d_numBins[1] + j) * d_numBins[2] + k;
+                    for (unsigned int iEntry = d_binStart[iBin];
+                         iEntry < d_binStart[iBin + 1];
+                         ++iEntry)
+                      {
+                        const unsigned int pointId = d_binPointIds[iEntry];
+                        const double       pointDistance =
+                          std::sqrt(distanceSquared(x, pointId));
+                        if (pointDistance < distance ||
+                            (pointDistance == distance && pointId < closestId))
+                          {
+                            distance  = pointDistance;
+                            closestId = pointId;
+                          }
+                      }
+                  }
+          if (distance <= radius)
+            return closestId;
+          radius *= 2.0;
+        }
+    }
+  } // namespace utils
+
+} // namespace dftfe
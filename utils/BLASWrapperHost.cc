@@ -17,12 +17,42 @@
 #include <BLASWrapper.h>
 #include <linearAlgebraOperations.h>
 #include <dftUtils.h>
+#if defined(DFTFE_WITH_MKL)
+#  include <mkl.h>
+#endif
 namespace dftfe
 {
   namespace linearAlgebra
   {
     BLASWrapper<dftfe::utils::MemorySpace::HOST>::BLASWrapper()
-    {}
+    {
+      int nOMPThreads = 1;
+      if (const char *penv = std::getenv("DFTFE_NUM_THREADS"))
+        {
+          try
+            {
+              nOMPThreads = std::stoi(std::string(penv));
+            }
+          catch (...)
+            {
+              AssertThrow(
+                false,
+                dealii::ExcMessage(
+                  std::string(
+                    "When specifying the <DFTFE_NUM_THREADS> environment "
+                    "variable, it needs to be something that can be "
+                    "interpreted as an integer. The text you have in the "
+                    "environment variable is <") +
+                  penv + ">"));
+            }
+
+          AssertThrow(nOMPThreads > 0,
+                      dealii::ExcMessage(
+                        "When specifying the <DFTFE_NUM_THREADS> environment "
+                        "variable, it needs to be a positive number."));
+        }
+      d_nOMPThreads = nOMPThreads;
+    }
 
 
     void
@@ -592,6 +622,438 @@ namespace dftfe
       xaxpy(size, &alpha, x, 1, y, 1);
     }
 
+    namespace
+    {
+#if defined(DFTFE_WITH_MKL)
+      inline CBLAS_TRANSPOSE
+      cblasTranspose(const char trans)
+      {
+        return (trans == 'N' || trans == 'n') ?
+                 CblasNoTrans :
+                 ((trans == 'T' || trans == 't') ? CblasTrans :
+                                                   CblasConjTrans);
+      }
+
+      inline void
+      mklGemmBatchStrided(const char    transA,
+                          const char    transB,
+                          const MKL_INT m,
+                          const MKL_INT n,
+                          const MKL_INT k,
+                          const double *alpha,
+                          const double *A,
+                          const MKL_INT lda,
+                          const MKL_INT strideA,
+                          const double *B,
+                          const MKL_INT ldb,
+                          const MKL_INT strideB,
+                          const double *beta,
+                          double *      C,
+                          const MKL_INT ldc,
+                          const MKL_INT strideC,
+                          const MKL_INT batchCount)
+      {
+        cblas_dgemm_batch_strided(CblasColMajor,
+                                  cblasTranspose(transA),
+                                  cblasTranspose(transB),
+                                  m,
+                                  n,
+                                  k,
+                                  *alpha,
+                                  A,
+                                  lda,
+                                  strideA,
+                                  B,
+                                  ldb,
+                                  strideB,
+                                  *beta,
+                                  C,
+                                  ldc,
+                                  strideC,
+                                  batchCount);
+      }
+
+      inline void
+      mklGemmBatchStrided(const char    transA,
+                          const char    transB,
+                          const MKL_INT m,
+                          const MKL_INT n,
+                          const MKL_INT k,
+                          const float * alpha,
+                          const float * A,
+                          const MKL_INT lda,
+                          const MKL_INT strideA,
+                          const float * B,
+                          const MKL_INT ldb,
+                          const MKL_INT strideB,
+                          const float * beta,
+                          float *       C,
+                          const MKL_INT ldc,
+                          const MKL_INT strideC,
+                          const MKL_INT batchCount)
+      {
+        cblas_sgemm_batch_strided(CblasColMajor,
+                                  cblasTranspose(transA),
+                                  cblasTranspose(transB),
+                                  m,
+                                  n,
+                                  k,
+                                  *alpha,
+                                  A,
+                                  lda,
+                                  strideA,
+                                  B,
+                                  ldb,
+                                  strideB,
+                                  *beta,
+                                  C,
+                                  ldc,
+                                  strideC,
+                                  batchCount);
+      }
+
+      inline void
+      mklGemmBatchStrided(const char                  transA,
+                          const char                  transB,
+                          const MKL_INT               m,
+                          const MKL_INT               n,
+                          const MKL_INT               k,
+                          const std::complex<double> *alpha,
+                          const std::complex<double> *A,
+                          const MKL_INT               lda,
+                          const MKL_INT               strideA,
+                          const std::complex<double> *B,
+                          const MKL_INT               ldb,
+                          const MKL_INT               strideB,
+                          const std::complex<double> *beta,
+                          std::complex<double> *      C,
+                          const MKL_INT               ldc,
+                          const MKL_INT               strideC,
+                          const MKL_INT               batchCount)
+      {
+        cblas_zgemm_batch_strided(CblasColMajor,
+                                  cblasTranspose(transA),
+                                  cblasTranspose(transB),
+                                  m,
+                                  n,
+                                  k,
+                                  alpha,
+                                  A,
+                                  lda,
+                                  strideA,
+                                  B,
+                                  ldb,
+                                  strideB,
+                                  beta,
+                                  C,
+                                  ldc,
+                                  strideC,
+                                  batchCount);
+      }
+
+      inline void
+      mklGemmBatchStrided(const char                 transA,
+                          const char                 transB,
+                          const MKL_INT              m,
+                          const MKL_INT              n,
+                          const MKL_INT              k,
+                          const std::complex<float> *alpha,
+                          const std::complex<float> *A,
+                          const MKL_INT              lda,
+                          const MKL_INT              strideA,
+                          const std::complex<float> *B,
+                          const MKL_INT              ldb,
+                          const MKL_INT              strideB,
+                          const std::complex<float> *beta,
+                          std::complex<float> *      C,
+                          const MKL_INT              ldc,
+                          const MKL_INT              strideC,
+                          const MKL_INT              batchCount)
+      {
+        cblas_cgemm_batch_strided(CblasColMajor,
+                                  cblasTranspose(transA),
+                                  cblasTranspose(transB),
+                                  m,
+                                  n,
+                                  k,
+                                  alpha,
+                                  A,
+                                  lda,
+                                  strideA,
+                                  B,
+                                  ldb,
+                                  strideB,
+                                  beta,
+                                  C,
+                                  ldc,
+                                  strideC,
+                                  batchCount);
+      }
+#endif
+
+      // Largest inner and outer dimension handled by smallGemmNN, covers the
+      // cell level matrices up to FE order 3 (64 dofs per cell) and their
+      // spinor counterparts up to p=2. Beyond that the four column update
+      // no longer keeps the columns of B in registers and BLAS is faster
+      constexpr unsigned int smallGemmMaxDim = 64;
+      // Rows of C processed at a time so that the active slices of A and C
+      // stay in cache
+      constexpr unsigned int smallGemmRowBlock = 256;
+
+      // C = alpha*A*B + beta*C for column major A (m x k), B (k x n) and
+      // C (m x n) with small k and n. Four columns of C are updated together
+      // against each column of A, with the innermost loop running over the
+      // contiguous rows so that it vectorizes. Follows BLAS semantics for
+      // beta = 0, i.e. C is not read in that case.
+      template <typename ValueType>
+      void
+      smallGemmNN(const unsigned int m,
+                  const unsigned int n,
+                  const unsigned int k,
+                  const ValueType    alpha,
+                  const ValueType *  A,
+                  const unsigned int lda,
+                  const ValueType *  B,
+                  const unsigned int ldb,
+                  const ValueType    beta,
+                  ValueType *        C,
+                  const unsigned int ldc)
+      {
+        const bool isBetaZero = beta == ValueType(0.0);
+        for (unsigned int iRowStart = 0; iRowStart < m;
+             iRowStart += smallGemmRowBlock)
+          {
+            const unsigned int nRows =
+              std::min(smallGemmRowBlock, m - iRowStart);
+            unsigned int jCol = 0;
+            for (; jCol + 4 <= n; jCol += 4)
+              {
+                ValueType *C0 = C + jCol * ldc + iRowStart;
+                ValueType *C1 = C0 + ldc;
+                ValueType *C2 = C1 + ldc;
+                ValueType *C3 = C2 + ldc;
+                for (unsigned int iRow = 0; iRow < nRows; ++iRow)
+                  {
+                    C0[iRow] = isBetaZero ? ValueType(0.0) : beta * C0[iRow];
+                    C1[iRow] = isBetaZero ? ValueType(0.0) : beta * C1[iRow];
+                    C2[iRow] = isBetaZero ? ValueType(0.0) : beta * C2[iRow];
+                    C3[iRow] = isBetaZero ? ValueType(0.0) : beta * C3[iRow];
+                  }
+                for (unsigned int l = 0; l < k; ++l)
+                  {
+                    const ValueType  b0   = alpha * B[jCol * ldb + l];
+                    const ValueType  b1   = alpha * B[(jCol + 1) * ldb + l];
+                    const ValueType  b2   = alpha * B[(jCol + 2) * ldb + l];
+                    const ValueType  b3   = alpha * B[(jCol + 3) * ldb + l];
+                    const ValueType *Acol = A + l * lda + iRowStart;
+                    for (unsigned int iRow = 0; iRow < nRows; ++iRow)
+                      {
+                        const ValueType a = Acol[iRow];
+                        C0[iRow] += a * b0;
+                        C1[iRow] += a * b1;
+                        C2[iRow] += a * b2;
+                        C3[iRow] += a * b3;
+                      }
+                  }
+              }
+            for (; jCol < n; ++jCol)
+              {
+                ValueType *C0 = C + jCol * ldc + iRowStart;
+                for (unsigned int iRow = 0; iRow < nRows; ++iRow)
+                  C0[iRow] = isBetaZero ? ValueType(0.0) : beta * C0[iRow];
+                for (unsigned int l = 0; l < k; ++l)
+                  {
+                    const ValueType  b0   = alpha * B[jCol * ldb + l];
+                    const ValueType *Acol = A + l * lda + iRowStart;
+                    for (unsigned int iRow = 0; iRow < nRows; ++iRow)
+                      C0[iRow] += Acol[iRow] * b0;
+                  }
+              }
+          }
+      }
+
+      inline bool
+      useSmallGemmKernel(const char         transA,
+                         const char         transB,
+                         const unsigned int n,
+                         const unsigned int k)
+      {
+        return (transA == 'N' || transA == 'n') &&
+               (transB == 'N' || transB == 'n') && n <= smallGemmMaxDim &&
+               k <= smallGemmMaxDim;
+      }
+
+      // Whether the batch is distributed over the threads. The BLAS xgemm may
+      // be threaded itself, so larger products are only run concurrently when
+      // the BLAS can be made sequential inside the parallel region (MKL),
+      // otherwise the batch is run serially and the BLAS uses its threads.
+      inline bool
+      isBatchThreaded(const bool         isSmall,
+                      const unsigned int nOMPThreads,
+                      const int          batchCount)
+      {
+#if defined(DFTFE_WITH_MKL)
+        return nOMPThreads > 1 && batchCount > 1;
+#else
+        return isSmall && nOMPThreads > 1 && batchCount > 1;
+#endif
+      }
+
+      // Batched GEMM on host without a vendor batched interface. The batch is
+      // distributed over nOMPThreads threads (serialized when already inside a
+      // parallel region). Small 'N','N' products go through smallGemmNN,
+      // larger ones call the BLAS xgemm, with MKL limited to one thread in
+      // each thread of the region so that the cores are not oversubscribed.
+      template <typename ValueType>
+      void
+      gemmBatched(
+        const BLASWrapper<dftfe::utils::MemorySpace::HOST> &blasWrapper,
+        const unsigned int                                  nOMPThreads,
+        const char                                          transA,
+        const char                                          transB,
+        const unsigned int                                  m,
+        const unsigned int                                  n,
+        const unsigned int                                  k,
+        const ValueType *                                   alpha,
+        const ValueType *const *                            A,
+        const unsigned int                                  lda,
+        const ValueType *const *                            B,
+        const unsigned int                                  ldb,
+        const ValueType *                                   beta,
+        ValueType *const *                                  C,
+        const unsigned int                                  ldc,
+        const int                                           batchCount)
+      {
+        const bool isSmall = useSmallGemmKernel(transA, transB, n, k);
+        const bool isThreaded =
+          isBatchThreaded(isSmall, nOMPThreads, batchCount);
+#pragma omp parallel num_threads(nOMPThreads) if (isThreaded)
+        {
+#if defined(DFTFE_WITH_MKL)
+          const int mklNumThreads =
+            isThreaded && !isSmall ? mkl_set_num_threads_local(1) : 0;
+#endif
+#pragma omp for schedule(static)
+          for (int iBatch = 0; iBatch < batchCount; iBatch++)
+            {
+              if (isSmall)
+                smallGemmNN(m,
+                            n,
+                            k,
+                            *alpha,
+                            A[iBatch],
+                            lda,
+                            B[iBatch],
+                            ldb,
+                            *beta,
+                            C[iBatch],
+                            ldc);
+              else
+                blasWrapper.xgemm(transA,
+                                  transB,
+                                  m,
+                                  n,
+                                  k,
+                                  alpha,
+                                  A[iBatch],
+                                  lda,
+                                  B[iBatch],
+                                  ldb,
+                                  beta,
+                                  C[iBatch],
+                                  ldc);
+            }
+#if defined(DFTFE_WITH_MKL)
+          if (isThreaded && !isSmall)
+            mkl_set_num_threads_local(mklNumThreads);
+#endif
+        }
+      }
+
+      template <typename ValueType>
+      void
+      gemmStridedBatched(
+        const BLASWrapper<dftfe::utils::MemorySpace::HOST> &blasWrapper,
+        const unsigned int                                  nOMPThreads,
+        const char                                          transA,
+        const char                                          transB,
+        const unsigned int                                  m,
+        const unsigned int                                  n,
+        const unsigned int                                  k,
+        const ValueType *                                   alpha,
+        const ValueType *                                   A,
+        const unsigned int                                  lda,
+        long long int                                       strideA,
+        const ValueType *                                   B,
+        const unsigned int                                  ldb,
+        long long int                                       strideB,
+        const ValueType *                                   beta,
+        ValueType *                                         C,
+        const unsigned int                                  ldc,
+        long long int                                       strideC,
+        const int                                           batchCount)
+      {
+        const bool isSmall = useSmallGemmKernel(transA, transB, n, k);
+#if defined(DFTFE_WITH_MKL)
+        if (!isSmall)
+          {
+            mklGemmBatchStrided(transA,
+                                transB,
+                                m,
+                                n,
+                                k,
+                                alpha,
+                                A,
+                                lda,
+                                strideA,
+                                B,
+                                ldb,
+                                strideB,
+                                beta,
+                                C,
+                                ldc,
+                                strideC,
+                                batchCount);
+            return;
+          }
+#endif
+        // without MKL the larger products reach here and are run serially
+        const bool isThreaded =
+          isBatchThreaded(isSmall, nOMPThreads, batchCount);
+#pragma omp parallel for schedule(static) num_threads(nOMPThreads) \
+  if (isThreaded)
+        for (int iBatch = 0; iBatch < batchCount; iBatch++)
+          {
+            if (isSmall)
+              smallGemmNN(m,
+                          n,
+                          k,
+                          *alpha,
+                          A + iBatch * strideA,
+                          lda,
+                          B + iBatch * strideB,
+                          ldb,
+                          *beta,
+                          C + iBatch * strideC,
+                          ldc);
+            else
+              blasWrapper.xgemm(transA,
+                                transB,
+                                m,
+                                n,
+                                k,
+                                alpha,
+                                A + iBatch * strideA,
+                                lda,
+                                B + iBatch * strideB,
+                                ldb,
+                                beta,
+                                C + iBatch * strideC,
+                                ldc);
+          }
+      }
+    } // namespace
+
     void
     BLASWrapper<dftfe::utils::MemorySpace::HOST>::xgemmBatched(
       const char         transA,
@@ -609,11 +1071,24 @@ namespace dftfe
       const unsigned int ldc,
       const int          batchCount) const
     {
-      AssertThrow(false, dftUtils::ExcNotImplementedYet());
+      gemmBatched(*this,
+                  d_nOMPThreads,
+                  transA,
+                  transB,
+                  m,
+                  n,
+                  k,
+                  alpha,
+                  A,
+                  lda,
+                  B,
+                  ldb,
+                  beta,
+                  C,
+                  ldc,
+                  batchCount);
     }
 
-
-
     void
     BLASWrapper<dftfe::utils::MemorySpace::HOST>::xgemmBatched(
       const char                  transA,
@@ -631,9 +1106,93 @@ namespace dftfe
       const unsigned int          ldc,
       const int                   batchCount) const
     {
-      AssertThrow(false, dftUtils::ExcNotImplementedYet());
+      gemmBatched(*this,
+                  d_nOMPThreads,
+                  transA,
+                  transB,
+                  m,
+                  n,
+                  k,
+                  alpha,
+                  A,
+                  lda,
+                  B,
+                  ldb,
+                  beta,
+                  C,
+                  ldc,
+                  batchCount);
+    }
+
+    void
+    BLASWrapper<dftfe::utils::MemorySpace::HOST>::xgemmBatched(
+      const char         transA,
+      const char         transB,
+      const unsigned int m,
+      const unsigned int n,
+      const unsigned int k,
+      const float *      alpha,
+      const float *      A[],
+      const unsigned int lda,
+      const float *      B[],
+      const unsigned int ldb,
+      const float *      beta,
+      float *            C[],
+      const unsigned int ldc,
+      const int          batchCount) const
+    {
+      gemmBatched(*this,
+                  d_nOMPThreads,
+                  transA,
+                  transB,
+                  m,
+                  n,
+                  k,
+                  alpha,
+                  A,
+                  lda,
+                  B,
+                  ldb,
+                  beta,
+                  C,
+                  ldc,
+                  batchCount);
     }
 
+    void
+    BLASWrapper<dftfe::utils::MemorySpace::HOST>::xgemmBatched(
+      const char                 transA,
+      const char                 transB,
+      const unsigned int         m,
+      const unsigned int         n,
+      const unsigned int         k,
+      const std::complex<float> *alpha,
+      const std::complex<float> *A[],
+      const unsigned int         lda,
+      const std::complex<float> *B[],
+      const unsigned int         ldb,
+      const std::complex<float> *beta,
+      std::complex<float> *      C[],
+      const unsigned int         ldc,
+      const int                  batchCount) const
+    {
+      gemmBatched(*this,
+                  d_nOMPThreads,
+                  transA,
+                  transB,
+                  m,
+                  n,
+                  k,
+                  alpha,
+                  A,
+                  lda,
+                  B,
+                  ldb,
+                  beta,
+                  C,
+                  ldc,
+                  batchCount);
+    }
 
     void
     BLASWrapper<dftfe::utils::MemorySpace::HOST>::xgemmStridedBatched(
@@ -655,25 +1214,27 @@ namespace dftfe
       long long int      strideC,
       const int          batchCount) const
     {
-      for (int iBatch = 0; iBatch < batchCount; iBatch++)
-        {
-          xgemm(transA,
-                transB,
-                m,
-                n,
-                k,
-                alpha,
-                A + iBatch * strideA,
-                lda,
-                B + iBatch * strideB,
-                ldb,
-                beta,
-                C + iBatch * strideC,
-                ldc);
-        }
+      gemmStridedBatched(*this,
+                         d_nOMPThreads,
+                         transA,
+                         transB,
+                         m,
+                         n,
+                         k,
+                         alpha,
+                         A,
+                         lda,
+                         strideA,
+                         B,
+                         ldb,
+                         strideB,
+                         beta,
+                         C,
+                         ldc,
+                         strideC,
+                         batchCount);
     }
 
-
     void
     BLASWrapper<dftfe::utils::MemorySpace::HOST>::xgemmStridedBatched(
       const char                  transA,
@@ -694,22 +1255,25 @@ namespace dftfe
       long long int               strideC,
       const int                   batchCount) const
     {
-      for (int iBatch = 0; iBatch < batchCount; iBatch++)
-        {
-          xgemm(transA,
-                transB,
-                m,
-                n,
-                k,
-                alpha,
-                A + iBatch * strideA,
-                lda,
-                B + iBatch * strideB,
-                ldb,
-                beta,
-                C + iBatch * strideC,
-                ldc);
-        }
+      gemmStridedBatched(*this,
+                         d_nOMPThreads,
+                         transA,
+                         transB,
+                         m,
+                         n,
+                         k,
+                         alpha,
+                         A,
+                         lda,
+                         strideA,
+                         B,
+                         ldb,
+                         strideB,
+                         beta,
+                         C,
+                         ldc,
+                         strideC,
+                         batchCount);
     }
 
     void
@@ -732,25 +1296,27 @@ namespace dftfe
       long long int      strideC,
       const int          batchCount) const
     {
-      for (int iBatch = 0; iBatch < batchCount; iBatch++)
-        {
-          xgemm(transA,
-                transB,
-                m,
-                n,
-                k,
-                alpha,
-                A + iBatch * strideA,
-                lda,
-                B + iBatch * strideB,
-                ldb,
-                beta,
-                C + iBatch * strideC,
-                ldc);
-        }
+      gemmStridedBatched(*this,
+                         d_nOMPThreads,
+                         transA,
+                         transB,
+                         m,
+                         n,
+                         k,
+                         alpha,
+                         A,
+                         lda,
+                         strideA,
+                         B,
+                         ldb,
+                         strideB,
+                         beta,
+                         C,
+                         ldc,
+                         strideC,
+                         batchCount);
     }
 
-
     void
     BLASWrapper<dftfe::utils::MemorySpace::HOST>::xgemmStridedBatched(
       const char                 transA,
@@ -771,22 +1337,25 @@ namespace dftfe
       long long int              strideC,
       const int                  batchCount) const
     {
-      for (int iBatch = 0; iBatch < batchCount; iBatch++)
-        {
-          xgemm(transA,
-                transB,
-                m,
-                n,
-                k,
-                alpha,
-                A + iBatch * strideA,
-                lda,
-                B + iBatch * strideB,
-                ldb,
-                beta,
-                C + iBatch * strideC,
-                ldc);
-        }
+      gemmStridedBatched(*this,
+                         d_nOMPThreads,
+                         transA,
+                         transB,
+                         m,
+                         n,
+                         k,
+                         alpha,
+                         A,
+                         lda,
+                         strideA,
+                         B,
+                         ldb,
+                         strideB,
+                         beta,
+                         C,
+                         ldc,
+                         strideC,
+                         batchCount);
     }
 
     template <typename ValueTypeComplex, typename ValueTypeReal>
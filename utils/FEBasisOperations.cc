@@ -16,6 +16,8 @@
 //
 #include <FEBasisOperations.h>
 #include <FEBasisOperationsKernelsInternal.h>
+#include <deal.II/base/polynomial.h>
+#include <deal.II/fe/fe_tools.h>
 
 namespace dftfe
 {
@@ -82,6 +84,9 @@ namespace dftfe
       d_quadratureIDsVector.clear();
       d_nQuadsPerCell.clear();
       d_updateFlags.clear();
+      d_tensorProductShapeValues1D.clear();
+      d_tensorProductCollocationGradients1D.clear();
+      d_lexicographicToCellDofNumbering.clear();
     }
 
     template <typename ValueTypeBasisCoeff,
@@ -603,6 +608,152 @@ namespace dftfe
              (unsigned int)areAllCellsCartesian;
     }
 
+    template <typename ValueTypeBasisCoeff,
+              typename ValueTypeBasisData,
+              dftfe::utils::MemorySpace memorySpace>
+    void
+    FEBasisOperations<ValueTypeBasisCoeff, ValueTypeBasisData, memorySpace>::
+      computeTensorProductShapeData(const unsigned int quadratureID,
+                                    const bool computeCollocationGradients)
+    {
+      const dealii::FiniteElement<3> &fe =
+        d_matrixFreeDataPtr->get_dof_handler(d_dofHandlerID).get_fe();
+      const dealii::Quadrature<3> &quadrature =
+        d_matrixFreeDataPtr->get_quadrature(quadratureID);
+      const unsigned int nDofs1D = fe.degree + 1;
+      const unsigned int nQuads1D =
+        std::round(std::cbrt((double)quadrature.size()));
+      AssertThrow(
+        fe.n_components() == 1 &&
+          fe.n_dofs_per_cell() == nDofs1D * nDofs1D * nDofs1D &&
+          quadrature.size() == nQuads1D * nQuads1D * nQuads1D,
+        dealii::ExcMessage(
+          "DFT-FE Error: tensor product shape data requires a scalar tensor product Lagrange element and a tensor product quadrature."));
+      AssertThrow(
+        !computeCollocationGradients || nQuads1D >= nDofs1D,
+        dealii::ExcMessage(
+          "DFT-FE Error: collocation gradients on the quadrature points require at least as many 1D quadrature points as 1D dofs."));
+
+      d_nDofsPerCell1D                  = nDofs1D;
+      d_lexicographicToCellDofNumbering =
+        dealii::FETools::lexicographic_to_hierarchic_numbering<3>(fe.degree);
+
+      // 1D support points and quadrature points are taken along the x axis,
+      // which runs fastest in both the lexicographic dof numbering and the
+      // tensor product quadrature
+      std::vector<dealii::Point<1>> supportPoints1D(nDofs1D);
+      for (unsigned int iNode = 0; iNode < nDofs1D; ++iNode)
+        supportPoints1D[iNode][0] =
+          fe.unit_support_point(d_lexicographicToCellDofNumbering[iNode])[0];
+      std::vector<dealii::Point<1>> quadPoints1D(nQuads1D);
+      for (unsigned int iQuad = 0; iQuad < nQuads1D; ++iQuad)
+        quadPoints1D[iQuad][0] = quadrature.point(iQuad)[0];
+
+      const std::vector<dealii::Polynomials::Polynomial<double>>
+        shapeFunctions1D =
+          dealii::Polynomials::generate_complete_Lagrange_basis(
+            supportPoints1D);
+      std::vector<ValueTypeBasisData> &shapeValues1D =
+        d_tensorProductShapeValues1D[quadratureID];
+      shapeValues1D.resize(nQuads1D * nDofs1D);
+      for (unsigned int iQuad = 0; iQuad < nQuads1D; ++iQuad)
+        for (unsigned int iNode = 0; iNode < nDofs1D; ++iNode)
+          shapeValues1D[iQuad * nDofs1D + iNode] =
+            shapeFunctions1D[iNode].value(quadPoints1D[iQuad][0]);
+
+      for (unsigned int iQuad = 0; iQuad < quadrature.size(); ++iQuad)
+        for (unsigned int iNode = 0; iNode < fe.n_dofs_per_cell(); ++iNode)
+          {
+            const unsigned int iQuadX = iQuad % nQuads1D,
+                               iQuadY = (iQuad / nQuads1D) % nQuads1D,
+                               iQuadZ = iQuad / (nQuads1D * nQuads1D);
+            const unsigned int iNodeX = iNode % nDofs1D,
+                               iNodeY = (iNode / nDofs1D) % nDofs1D,
+                               iNodeZ = iNode / (nDofs1D * nDofs1D);
+            const double tensorProductValue =
+              shapeValues1D[iQuadX * nDofs1D + iNodeX] *
+              shapeValues1D[iQuadY * nDofs1D + iNodeY] *
+              shapeValues1D[iQuadZ * nDofs1D + iNodeZ];
+            AssertThrow(
+              std::abs(tensorProductValue -
+                       fe.shape_value(d_lexicographicToCellDofNumbering[iNode],
+                                      quadrature.point(iQuad))) < 1e-10,
+              dealii::ExcMessage(
+                "DFT-FE Error: the basis is not a tensor product of the 1D shape functions on the 1D quadrature points."));
+          }
+
+      std::vector<ValueTypeBasisData> &collocationGradients1D =
+        d_tensorProductCollocationGradients1D[quadratureID];
+      collocationGradients1D.clear();
+      if (computeCollocationGradients)
+        {
+          const std::vector<dealii::Polynomials::Polynomial<double>>
+            collocationFunctions1D =
+              dealii::Polynomials::generate_complete_Lagrange_basis(
+                quadPoints1D);
+          collocationGradients1D.resize(nQuads1D * nQuads1D);
+          std::vector<double> values(2);
+          for (unsigned int iQuad = 0; iQuad < nQuads1D; ++iQuad)
+            for (unsigned int jQuad = 0; jQuad < nQuads1D; ++jQuad)
+              {
+                collocationFunctions1D[jQuad].value(quadPoints1D[iQuad][0],
+                                                    values);
+                collocationGradients1D[iQuad * nQuads1D + jQuad] = values[1];
+              }
+        }
+    }
+
+    template <typename ValueTypeBasisCoeff,
+              typename ValueTypeBasisData,
+              dftfe::utils::MemorySpace memorySpace>
+    unsigned int
+    FEBasisOperations<ValueTypeBasisCoeff, ValueTypeBasisData, memorySpace>::
+      nDofsPerCell1D() const
+    {
+      return d_nDofsPerCell1D;
+    }
+
+    template <typename ValueTypeBasisCoeff,
+              typename ValueTypeBasisData,
+              dftfe::utils::MemorySpace memorySpace>
+    unsigned int
+    FEBasisOperations<ValueTypeBasisCoeff, ValueTypeBasisData, memorySpace>::
+      nQuadsPerCell1D(const unsigned int quadratureID) const
+    {
+      return d_tensorProductShapeValues1D.find(quadratureID)->second.size() /
+             d_nDofsPerCell1D;
+    }
+
+    template <typename ValueTypeBasisCoeff,
+              typename ValueTypeBasisData,
+              dftfe::utils::MemorySpace memorySpace>
+    const std::vector<ValueTypeBasisData> &
+    FEBasisOperations<ValueTypeBasisCoeff, ValueTypeBasisData, memorySpace>::
+      tensorProductShapeValues1D(const unsigned int quadratureID) const
+    {
+      return d_tensorProductShapeValues1D.find(quadratureID)->second;
+    }
+
+    template <typename ValueTypeBasisCoeff,
+              typename ValueTypeBasisData,
+              dftfe::utils::MemorySpace memorySpace>
+    const std::vector<ValueTypeBasisData> &
+    FEBasisOperations<ValueTypeBasisCoeff, ValueTypeBasisData, memorySpace>::
+      tensorProductCollocationGradients1D(const unsigned int quadratureID) const
+    {
+      return d_tensorProductCollocationGradients1D.find(quadratureID)->second;
+    }
+
+    template <typename ValueTypeBasisCoeff,
+              typename ValueTypeBasisData,
+              dftfe::utils::MemorySpace memorySpace>
+    const std::vector<unsigned int> &
+    FEBasisOperations<ValueTypeBasisCoeff, ValueTypeBasisData, memorySpace>::
+      lexicographicToCellDofNumbering() const
+    {
+      return d_lexicographicToCellDofNumbering;
+    }
+
     template <typename ValueTypeBasisCoeff,
               typename ValueTypeBasisData,
               dftfe::utils::MemorySpace memorySpace>
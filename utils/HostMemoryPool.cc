@@ -0,0 +1,228 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2017-2022 The Regents of the University of Michigan and DFT-FE
+// authors.
+//
+// This file is part of the DFT-FE code.
+//
+// The DFT-FE code is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the DFT-FE distribution.
+//
+// ---------------------------------------------------------------------
+
+#include <HostMemoryPool.h>
+#include <cstdlib>
+#include <new>
+#ifdef __linux__
+#  include <sys/mman.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#endif
+
+namespace dftfe
+{
+  namespace utils
+  {
+    namespace
+    {
+      constexpr std::size_t alignment         = 64;
+      constexpr std::size_t hugePageAlignment = 2 * 1024 * 1024;
+      constexpr std::size_t pageSize          = 4096;
+
+      thread_local const char *currentTag = "untagged";
+    } // namespace
+
+    HostMemoryPool::ScopedTag::ScopedTag(const char *tag)
+      : d_previousTag(currentTag)
+    {
+      currentTag = tag;
+    }
+
+    HostMemoryPool::ScopedTag::~ScopedTag()
+    {
+      currentTag = d_previousTag;
+    }
+
+    HostMemoryPool &
+    HostMemoryPool::instance()
+    {
+      static HostMemoryPool *pool = new HostMemoryPool();
+      return *pool;
+    }
+
+    HostMemoryPool::HostMemoryPool()
+      : d_isEnabled(false)
+      , d_hasAllocated(false)
+      , d_maxCachedBytes(std::size_t(1) << 30)
+      , d_cachedBytes(0)
+      , d_liveBytes(0)
+      , d_highWaterBytes(0)
+    {}
+
+    void
+    HostMemoryPool::setEnabled(const bool enabled)
+    {
+      d_isEnabled = enabled;
+    }
+
+    bool
+    HostMemoryPool::isEnabled() const
+    {
+      return d_isEnabled;
+    }
+
+    void
+    HostMemoryPool::setMaxCachedBytes(const std::size_t maxCachedBytes)
+    {
+      std::lock_guard<std::mutex> lock(d_mutex);
+      d_maxCachedBytes = maxCachedBytes;
+    }
+
+    std::size_t
+    HostMemoryPool::getSizeClass(const std::size_t size)
+    {
+      if (size <= 4 * alignment)
+        return ((size + alignment - 1) / alignment) * alignment;
+      // four classes per power of two, at most 25% padding
+      unsigned int log2Size = 0;
+      while ((std::size_t(1) << (log2Size + 1)) <= size)
+        ++log2Size;
+      const std::size_t granularity = std::size_t(1) << (log2Size - 2);
+      return ((size + granularity - 1) / granularity) * granularity;
+    }
+
+    unsigned int
+    HostMemoryPool::getCurrentNumaNode()
+    {
+#if defined(__linux__) && defined(SYS_getcpu)
+      unsigned int cpu = 0, node = 0;
+      if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0)
+        return node;
+#endif
+      return 0;
+    }
+
+    void *
+    HostMemoryPool::allocate(const std::size_t size)
+    {
+      if (size == 0)
+        return nullptr;
+      const std::size_t  classSize = getSizeClass(size);
+      const unsigned int numaNode  = getCurrentNumaNode();
+      void *             ptr       = nullptr;
+      {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_hasAllocated = true;
+        if (numaNode < d_freeBlocks.size())
+          {
+            auto it = d_freeBlocks[numaNode].find(classSize);
+            if (it != d_freeBlocks[numaNode].end() && !it->second.empty())
+              {
+                ptr = it->second.back();
+                it->second.pop_back();
+                d_cachedBytes -= classSize;
+              }
+          }
+      }
+
+      if (ptr == nullptr)
+        {
+          const std::size_t blockAlignment =
+            classSize >= hugePageAlignment ? hugePageAlignment : alignment;
+          if (posix_memalign(&ptr, blockAlignment, classSize) != 0)
+            throw std::bad_alloc();
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+          if (classSize >= hugePageAlignment)
+            madvise(ptr, classSize, MADV_HUGEPAGE);
+#endif
+          // first touch by the allocating thread places the pages on its
+          // numa node
+          char *bytes = static_cast<char *>(ptr);
+          for (std::size_t offset = 0; offset < classSize; offset += pageSize)
+            bytes[offset] = 0;
+        }
+
+      std::lock_guard<std::mutex> lock(d_mutex);
+      TagStatistics &tagStatistics = d_tagStatistics[currentTag];
+      tagStatistics.currentBytes += size;
+      tagStatistics.numAllocations += 1;
+      if (tagStatistics.currentBytes > tagStatistics.highWaterBytes)
+        tagStatistics.highWaterBytes = tagStatistics.currentBytes;
+      d_liveBytes += classSize;
+      if (d_liveBytes > d_highWaterBytes)
+        d_highWaterBytes = d_liveBytes;
+      d_liveBlocks[ptr] = BlockInfo{classSize, numaNode, &tagStatistics, size};
+      return ptr;
+    }
+
+    bool
+    HostMemoryPool::deallocate(void *ptr)
+    {
+      if (ptr == nullptr || !d_hasAllocated)
+        return false;
+      std::lock_guard<std::mutex> lock(d_mutex);
+      auto                        it = d_liveBlocks.find(ptr);
+      if (it == d_liveBlocks.end())
+        return false;
+      const BlockInfo blockInfo = it->second;
+      d_liveBlocks.erase(it);
+      blockInfo.tagStatistics->currentBytes -= blockInfo.requestedSize;
+      d_liveBytes -= blockInfo.classSize;
+      if (d_cachedBytes + blockInfo.classSize <= d_maxCachedBytes)
+        {
+          if (blockInfo.numaNode >= d_freeBlocks.size())
+            d_freeBlocks.resize(blockInfo.numaNode + 1);
+          d_freeBlocks[blockInfo.numaNode][blockInfo.classSize].push_back(ptr);
+          d_cachedBytes += blockInfo.classSize;
+        }
+      else
+        std::free(ptr);
+      return true;
+    }
+
+    void
+    HostMemoryPool::releaseFreeBlocks()
+    {
+      std::lock_guard<std::mutex> lock(d_mutex);
+      for (auto &freeBlocksNode : d_freeBlocks)
+        for (auto &freeBlocksClass : freeBlocksNode)
+          for (void *ptr : freeBlocksClass.second)
+            std::free(ptr);
+      d_freeBlocks.clear();
+      d_cachedBytes = 0;
+    }
+
+    std::map<std::string, HostMemoryPool::TagStatistics>
+    HostMemoryPool::getTagStatistics() const
+    {
+      std::lock_guard<std::mutex> lock(d_mutex);
+      return d_tagStatistics;
+    }
+
+    std::size_t
+    HostMemoryPool::getLiveBytes() const
+    {
+      std::lock_guard<std::mutex> lock(d_mutex);
+      return d_liveBytes;
+    }
+
+    std::size_t
+    HostMemoryPool::getHighWaterBytes() const
+    {
+      std::lock_guard<std::mutex> lock(d_mutex);
+      return d_highWaterBytes;
+    }
+
+    std::size_t
+    HostMemoryPool::getCachedBytes() const
+    {
+      std::lock_guard<std::mutex> lock(d_mutex);
+      return d_cachedBytes;
+    }
+  } // namespace utils
+
+} // namespace dftfe
@@ -25,12 +25,36 @@
 #include <Exceptions.h>
 #include <DeviceAPICalls.h>
 #include <deviceDirectCCLWrapper.h>
+#include <algorithm>
 namespace dftfe
 {
   namespace utils
   {
     namespace mpi
     {
+      namespace
+      {
+        communicationMode defaultCommunicationMode =
+          communicationMode::nonBlocking;
+
+        // buffers with cached persistent requests per tag and direction of a
+        // communicator, enough for the full and single precision buffers of
+        // a few vectors sharing the communicator
+        const unsigned int maxPersistentBuffersPerTag = 4;
+      } // namespace
+
+      void
+      setDefaultCommunicationMode(const communicationMode mode)
+      {
+        defaultCommunicationMode = mode;
+      }
+
+      communicationMode
+      getDefaultCommunicationMode()
+      {
+        return defaultCommunicationMode;
+      }
+
       template <typename ValueType, dftfe::utils::MemorySpace memorySpace>
       MPICommunicatorP2P<ValueType, memorySpace>::MPICommunicatorP2P(
         std::shared_ptr<const MPIPatternP2P<memorySpace>> mpiPatternP2P,
@@ -39,7 +63,10 @@ namespace dftfe
         , d_blockSize(blockSize)
         , d_locallyOwnedSize(mpiPatternP2P->localOwnedSize())
         , d_ghostSize(mpiPatternP2P->localGhostSize())
+        , d_neighborhoodCommUpdateGhostValues(MPI_COMM_NULL)
+        , d_neighborhoodCommAccumulateAddLocallyOwned(MPI_COMM_NULL)
         , d_commPrecision(communicationPrecision::full)
+        , d_commMode(getDefaultCommunicationMode())
       {
         d_commProtocol = communicationProtocol::mpiHost;
 #if defined(DFTFE_WITH_DEVICE) && defined(DFTFE_WITH_DEVICE_AWARE_MPI)
@@ -60,10 +87,12 @@ namespace dftfe
 
         d_requestsUpdateGhostValues.resize(
           d_mpiPatternP2P->getGhostProcIds().size() +
-          d_mpiPatternP2P->getTargetProcIds().size());
+            d_mpiPatternP2P->getTargetProcIds().size(),
+          MPI_REQUEST_NULL);
         d_requestsAccumulateAddLocallyOwned.resize(
           d_mpiPatternP2P->getGhostProcIds().size() +
-          d_mpiPatternP2P->getTargetProcIds().size());
+            d_mpiPatternP2P->getTargetProcIds().size(),
+          MPI_REQUEST_NULL);
 
 
 #ifdef DFTFE_WITH_DEVICE
@@ -151,6 +180,320 @@ namespace dftfe
           }
       }
 
+      template <typename ValueType, dftfe::utils::MemorySpace memorySpace>
+      MPICommunicatorP2P<ValueType, memorySpace>::~MPICommunicatorP2P()
+      {
+        int isFinalized = 0;
+        MPI_Finalized(&isFinalized);
+        if (isFinalized)
+          return;
+
+        freePersistentRequests();
+        if (d_neighborhoodCommUpdateGhostValues != MPI_COMM_NULL)
+          MPI_Comm_free(&d_neighborhoodCommUpdateGhostValues);
+        if (d_neighborhoodCommAccumulateAddLocallyOwned != MPI_COMM_NULL)
+          MPI_Comm_free(&d_neighborhoodCommAccumulateAddLocallyOwned);
+      }
+
+      template <typename ValueType, dftfe::utils::MemorySpace memorySpace>
+      void
+      MPICommunicatorP2P<ValueType, memorySpace>::setCommunicationMode(
+        communicationMode mode)
+      {
+        if (d_commMode == mode)
+          return;
+        freePersistentRequests();
+        d_commMode = mode;
+      }
+
+      template <typename ValueType, dftfe::utils::MemorySpace memorySpace>
+      void
+      MPICommunicatorP2P<ValueType, memorySpace>::freePersistentRequests()
+      {
+        if (d_commMode != communicationMode::persistent)
+          return;
+
+        for (auto &cachedRequestsOfTag : d_persistentRequests)
+          for (auto &cachedRequests : cachedRequestsOfTag.second)
+            for (auto &request : cachedRequests.requests)
+              if (request != MPI_REQUEST_NULL)
+                MPI_Request_free(&request);
+        d_persistentRequests.clear();
+        // these only hold copies of the handles freed above
+        std::fill(d_requestsUpdateGhostValues.begin(),
+                  d_requestsUpdateGhostValues.end(),
+                  MPI_REQUEST_NULL);
+        std::fill(d_requestsAccumulateAddLocallyOwned.begin(),
+                  d_requestsAccumulateAddLocallyOwned.end(),
+                  MPI_REQUEST_NULL);
+      }
+
+      template <typename ValueType, dftfe::utils::MemorySpace memorySpace>
+      template <typename T>
+      void
+      MPICommunicatorP2P<ValueType, memorySpace>::startMessages(
+        T *           buffer,
+        const bool    isGhostProcs,
+        const bool    isSend,
+        const int     tag,
+        MPI_Request * requests)
+      {
+        const std::vector<size_type> &procIds =
+          isGhostProcs ? d_mpiPatternP2P->getGhostProcIds() :
+                         d_mpiPatternP2P->getTargetProcIds();
+        const size_type bytesPerIndex = d_blockSize * sizeof(T);
+        const bool      isPersistent =
+          d_commMode == communicationMode::persistent;
+
+        // the persistent requests are cached per tag, direction and buffer,
+        // so that alternating between data arrays or between the full and
+        // single precision buffers does not re-create them. Only the
+        // maxPersistentBuffersPerTag most recently used buffers are kept per
+        // tag and direction
+        persistentRequests *cachedRequests = nullptr;
+        if (isPersistent)
+          {
+            std::vector<persistentRequests> &cachedRequestsOfTag =
+              d_persistentRequests[std::make_tuple(tag, isGhostProcs, isSend)];
+            auto it = std::find_if(cachedRequestsOfTag.begin(),
+                                   cachedRequestsOfTag.end(),
+                                   [&](const persistentRequests &cached) {
+                                     return cached.buffer == buffer &&
+                                            cached.bytesPerIndex ==
+                                              bytesPerIndex;
+                                   });
+            if (it == cachedRequestsOfTag.end())
+              {
+                if (cachedRequestsOfTag.size() >= maxPersistentBuffersPerTag)
+                  {
+                    for (auto &request : cachedRequestsOfTag.front().requests)
+                      if (request != MPI_REQUEST_NULL)
+                        MPI_Request_free(&request);
+                    cachedRequestsOfTag.erase(cachedRequestsOfTag.begin());
+                  }
+                cachedRequestsOfTag.emplace_back();
+              }
+            else
+              std::rotate(it, it + 1, cachedRequestsOfTag.end());
+            cachedRequests = &cachedRequestsOfTag.back();
+          }
+        if (!isPersistent || cachedRequests->requests.empty())
+          {
+            if (isPersistent)
+              cachedRequests->requests.assign(procIds.size(),
+                                              MPI_REQUEST_NULL);
+            MPI_Request *newRequests =
+              isPersistent ? cachedRequests->requests.data() : requests;
+
+            T *startPtr = buffer;
+            for (size_type i = 0; i < procIds.size(); ++i)
+              {
+                const size_type numIndices =
+                  isGhostProcs ?
+                    (d_mpiPatternP2P->getGhostLocalIndicesRanges()
+                       .data()[2 * i + 1] -
+                     d_mpiPatternP2P->getGhostLocalIndicesRanges()
+                       .data()[2 * i]) :
+                    d_mpiPatternP2P->getNumOwnedIndicesForTargetProcs()
+                      .data()[i];
+
+                const std::string mpiFunctionName =
+                  isPersistent ? (isSend ? "MPI_Send_init" : "MPI_Recv_init") :
+                                 (isSend ? "MPI_Isend" : "MPI_Irecv");
+                int err;
+                if (isPersistent && isSend)
+                  err = MPI_Send_init(startPtr,
+                                      numIndices * bytesPerIndex,
+                                      MPI_BYTE,
+                                      procIds[i],
+                                      tag,
+                                      d_mpiCommunicator,
+                                      &newRequests[i]);
+                else if (isPersistent)
+                  err = MPI_Recv_init(startPtr,
+                                      numIndices * bytesPerIndex,
+                                      MPI_BYTE,
+                                      procIds[i],
+                                      tag,
+                                      d_mpiCommunicator,
+                                      &newRequests[i]);
+                else if (isSend)
+                  err = MPI_Isend(startPtr,
+                                  numIndices * bytesPerIndex,
+                                  MPI_BYTE,
+                                  procIds[i],
+                                  tag,
+                                  d_mpiCommunicator,
+                                  &newRequests[i]);
+                else
+                  err = MPI_Irecv(startPtr,
+                                  numIndices * bytesPerIndex,
+                                  MPI_BYTE,
+                                  procIds[i],
+                                  tag,
+                                  d_mpiCommunicator,
+                                  &newRequests[i]);
+
+                std::string errMsg = "Error occured while using " +
+                                     mpiFunctionName +
+                                     ". Error code: " + std::to_string(err);
+                throwException(err == MPI_SUCCESS, errMsg);
+
+                startPtr += numIndices * d_blockSize;
+              }
+
+            if (!isPersistent)
+              return;
+
+            cachedRequests->buffer        = buffer;
+            cachedRequests->bytesPerIndex = bytesPerIndex;
+          }
+
+        // the handles are copied to the requests waited on in the end calls,
+        // waiting on a persistent request only makes it inactive
+        std::copy(cachedRequests->requests.begin(),
+                  cachedRequests->requests.end(),
+                  requests);
+        if (procIds.size() > 0)
+          {
+            const int   err    = MPI_Startall(procIds.size(), requests);
+            std::string errMsg = "Error occured while using MPI_Startall. "
+                                 "Error code: " +
+                                 std::to_string(err);
+            throwException(err == MPI_SUCCESS, errMsg);
+          }
+      }
+
+      template <typename ValueType, dftfe::utils::MemorySpace memorySpace>
+      template <typename T>
+      void
+      MPICommunicatorP2P<ValueType, memorySpace>::startNeighborhoodAlltoallv(
+        const T *       sendBuffer,
+        T *             recvBuffer,
+        const bool      isUpdateGhostValues,
+        const size_type communicationChannel)
+      {
+        // the ghost values are received from the ghost processors and sent to
+        // the target processors, the accumulate add goes the reverse way
+        const std::vector<size_type> &ghostProcIds =
+          d_mpiPatternP2P->getGhostProcIds();
+        const std::vector<size_type> &targetProcIds =
+          d_mpiPatternP2P->getTargetProcIds();
+        MPI_Comm &neighborhoodComm =
+          isUpdateGhostValues ? d_neighborhoodCommUpdateGhostValues :
+                                d_neighborhoodCommAccumulateAddLocallyOwned;
+        std::map<size_type, MPI_Request> &requests =
+          isUpdateGhostValues ? d_requestsNeighborhoodUpdateGhostValues :
+                                d_requestsNeighborhoodAccumulateAddLocallyOwned;
+
+        if (d_neighborhoodCommUpdateGhostValues == MPI_COMM_NULL &&
+            d_neighborhoodCommAccumulateAddLocallyOwned == MPI_COMM_NULL)
+          {
+            d_neighborhoodGhostCounts.resize(ghostProcIds.size());
+            d_neighborhoodGhostDisplacements.resize(ghostProcIds.size());
+            d_neighborhoodTargetCounts.resize(targetProcIds.size());
+            d_neighborhoodTargetDisplacements.resize(targetProcIds.size());
+            int displacement = 0;
+            for (size_type i = 0; i < ghostProcIds.size(); ++i)
+              {
+                d_neighborhoodGhostCounts[i] =
+                  d_mpiPatternP2P->getGhostLocalIndicesRanges()
+                    .data()[2 * i + 1] -
+                  d_mpiPatternP2P->getGhostLocalIndicesRanges().data()[2 * i];
+                d_neighborhoodGhostDisplacements[i] = displacement;
+                displacement += d_neighborhoodGhostCounts[i];
+              }
+            displacement = 0;
+            for (size_type i = 0; i < targetProcIds.size(); ++i)
+              {
+                d_neighborhoodTargetCounts[i] =
+                  d_mpiPatternP2P->getNumOwnedIndicesForTargetProcs()
+                    .data()[i];
+                d_neighborhoodTargetDisplacements[i] = displacement;
+                displacement += d_neighborhoodTargetCounts[i];
+              }
+          }
+
+        if (neighborhoodComm == MPI_COMM_NULL)
+          {
+            std::vector<int> sources, destinations;
+            if (isUpdateGhostValues)
+              {
+                sources.assign(ghostProcIds.begin(), ghostProcIds.end());
+                destinations.assign(targetProcIds.begin(), targetProcIds.end());
+              }
+            else
+              {
+                sources.assign(targetProcIds.begin(), targetProcIds.end());
+                destinations.assign(ghostProcIds.begin(), ghostProcIds.end());
+              }
+
+            const int err = MPI_Dist_graph_create_adjacent(d_mpiCommunicator,
+                                                           sources.size(),
+                                                           sources.data(),
+                                                           MPI_UNWEIGHTED,
+                                                           destinations.size(),
+                                                           destinations.data(),
+                                                           MPI_UNWEIGHTED,
+                                                           MPI_INFO_NULL,
+                                                           0,
+                                                           &neighborhoodComm);
+            std::string errMsg =
+              "Error occured while using MPI_Dist_graph_create_adjacent. "
+              "Error code: " +
+              std::to_string(err);
+            throwException(err == MPI_SUCCESS, errMsg);
+          }
+
+        // the counts are in number of indices, the datatype holds the block
+        // of one index. Freeing it right away is fine, pending exchanges
+        // using it complete normally.
+        MPI_Datatype indexType;
+        MPI_Type_contiguous(d_blockSize * sizeof(T), MPI_BYTE, &indexType);
+        MPI_Type_commit(&indexType);
+
+        MPI_Request &request = requests[communicationChannel];
+        const int    err     = MPI_Ineighbor_alltoallv(
+          sendBuffer,
+          isUpdateGhostValues ? d_neighborhoodTargetCounts.data() :
+                                d_neighborhoodGhostCounts.data(),
+          isUpdateGhostValues ? d_neighborhoodTargetDisplacements.data() :
+                                d_neighborhoodGhostDisplacements.data(),
+          indexType,
+          recvBuffer,
+          isUpdateGhostValues ? d_neighborhoodGhostCounts.data() :
+                                d_neighborhoodTargetCounts.data(),
+          isUpdateGhostValues ? d_neighborhoodGhostDisplacements.data() :
+                                d_neighborhoodTargetDisplacements.data(),
+          indexType,
+          neighborhoodComm,
+          &request);
+        MPI_Type_free(&indexType);
+        std::string errMsg = "Error occured while using "
+                             "MPI_Ineighbor_alltoallv. Error code: " +
+                             std::to_string(err);
+        throwException(err == MPI_SUCCESS, errMsg);
+      }
+
+      template <typename ValueType, dftfe::utils::MemorySpace memorySpace>
+      void
+      MPICommunicatorP2P<ValueType, memorySpace>::waitNeighborhoodAlltoallv(
+        const bool isUpdateGhostValues)
+      {
+        std::map<size_type, MPI_Request> &requests =
+          isUpdateGhostValues ? d_requestsNeighborhoodUpdateGhostValues :
+                                d_requestsNeighborhoodAccumulateAddLocallyOwned;
+        for (auto &request : requests)
+          {
+            const int   err    = MPI_Wait(&request.second, MPI_STATUS_IGNORE);
+            std::string errMsg = "Error occured while using MPI_Wait. "
+                                 "Error code: " +
+                                 std::to_string(err);
+            throwException(err == MPI_SUCCESS, errMsg);
+          }
+        requests.clear();
+      }
+
       template <typename ValueType, dftfe::utils::MemorySpace memorySpace>
       void
       MPICommunicatorP2P<ValueType, memorySpace>::updateGhostValues(
@@ -182,38 +525,15 @@ namespace dftfe
                 dftfe::utils::deviceSynchronize();
               }
 #endif
-            if (d_commProtocol != communicationProtocol::nccl)
-              for (size_type i = 0;
-                   i < (d_mpiPatternP2P->getGhostProcIds()).size();
-                   ++i)
-                {
-                  const int err =
-                    MPI_Irecv(recvArrayStartPtr,
-                              (d_mpiPatternP2P->getGhostLocalIndicesRanges()
-                                 .data()[2 * i + 1] -
-                               d_mpiPatternP2P->getGhostLocalIndicesRanges()
-                                 .data()[2 * i]) *
-                                d_blockSize * sizeof(ValueType),
-                              MPI_BYTE,
-                              d_mpiPatternP2P->getGhostProcIds().data()[i],
-                              static_cast<size_type>(
-                                MPITags::MPI_P2P_COMMUNICATOR_SCATTER_TAG) +
-                                communicationChannel,
-                              d_mpiCommunicator,
-                              &d_requestsUpdateGhostValues[i]);
-
-                  std::string errMsg = "Error occured while using MPI_Irecv. "
-                                       "Error code: " +
-                                       std::to_string(err);
-                  throwException(err == MPI_SUCCESS, errMsg);
-
-                  recvArrayStartPtr +=
-                    (d_mpiPatternP2P->getGhostLocalIndicesRanges()
-                       .data()[2 * i + 1] -
-                     d_mpiPatternP2P->getGhostLocalIndicesRanges()
-                       .data()[2 * i]) *
-                    d_blockSize;
-                }
+            if (d_commProtocol != communicationProtocol::nccl &&
+                d_commMode != communicationMode::neighborhoodCollective)
+              startMessages(recvArrayStartPtr,
+                            true,
+                            false,
+                            static_cast<size_type>(
+                              MPITags::MPI_P2P_COMMUNICATOR_SCATTER_TAG) +
+                              communicationChannel,
+                            d_requestsUpdateGhostValues.data());
 
             // gather locally owned entries into a contiguous send buffer
             if ((d_mpiPatternP2P->getOwnedLocalIndicesForTargetProcs().size()) >
@@ -317,35 +637,22 @@ namespace dftfe
 #  endif
 #endif
             if (d_commProtocol != communicationProtocol::nccl)
-              for (size_type i = 0;
-                   i < (d_mpiPatternP2P->getTargetProcIds()).size();
-                   ++i)
-                {
-                  const int err = MPI_Isend(
-                    sendArrayStartPtr,
-                    d_mpiPatternP2P->getNumOwnedIndicesForTargetProcs()
-                        .data()[i] *
-                      d_blockSize * sizeof(ValueType),
-                    MPI_BYTE,
-                    d_mpiPatternP2P->getTargetProcIds().data()[i],
-                    static_cast<size_type>(
-                      MPITags::MPI_P2P_COMMUNICATOR_SCATTER_TAG) +
-                      communicationChannel,
-
-                    d_mpiCommunicator,
-                    &d_requestsUpdateGhostValues
-                      [d_mpiPatternP2P->getGhostProcIds().size() + i]);
-
-                  std::string errMsg = "Error occured while using MPI_Isend. "
-                                       "Error code: " +
-                                       std::to_string(err);
-                  throwException(err == MPI_SUCCESS, errMsg);
-
-                  sendArrayStartPtr +=
-                    d_mpiPatternP2P->getNumOwnedIndicesForTargetProcs()
-                      .data()[i] *
-                    d_blockSize;
-                }
+              {
+                if (d_commMode == communicationMode::neighborhoodCollective)
+                  startNeighborhoodAlltoallv(sendArrayStartPtr,
+                                             recvArrayStartPtr,
+                                             true,
+                                             communicationChannel);
+                else
+                  startMessages(sendArrayStartPtr,
+                                false,
+                                true,
+                                static_cast<size_type>(
+                                  MPITags::MPI_P2P_COMMUNICATOR_SCATTER_TAG) +
+                                  communicationChannel,
+                                d_requestsUpdateGhostValues.data() +
+                                  d_mpiPatternP2P->getGhostProcIds().size());
+              }
           }
         else
           {
@@ -361,41 +668,15 @@ namespace dftfe
                 dftfe::utils::deviceSynchronize();
               }
 #endif
-            if (d_commProtocol != communicationProtocol::nccl)
-              for (size_type i = 0;
-                   i < (d_mpiPatternP2P->getGhostProcIds()).size();
-                   ++i)
-                {
-                  const int err =
-                    MPI_Irecv(recvArrayStartPtr,
-                              (d_mpiPatternP2P->getGhostLocalIndicesRanges()
-                                 .data()[2 * i + 1] -
-                               d_mpiPatternP2P->getGhostLocalIndicesRanges()
-                                 .data()[2 * i]) *
-                                d_blockSize *
-                                sizeof(
-                                  typename dftfe::dataTypes::singlePrecType<
-                                    ValueType>::type),
-                              MPI_BYTE,
-                              d_mpiPatternP2P->getGhostProcIds().data()[i],
-                              static_cast<size_type>(
-                                MPITags::MPI_P2P_COMMUNICATOR_SCATTER_TAG) +
-                                communicationChannel,
-                              d_mpiCommunicator,
-                              &d_requestsUpdateGhostValues[i]);
-
-                  std::string errMsg = "Error occured while using MPI_Irecv. "
-                                       "Error code: " +
-                                       std::to_string(err);
-                  throwException(err == MPI_SUCCESS, errMsg);
-
-                  recvArrayStartPtr +=
-                    (d_mpiPatternP2P->getGhostLocalIndicesRanges()
-                       .data()[2 * i + 1] -
-                     d_mpiPatternP2P->getGhostLocalIndicesRanges()
-                       .data()[2 * i]) *
-                    d_blockSize;
-                }
+            if (d_commProtocol != communicationProtocol::nccl &&
+                d_commMode != communicationMode::neighborhoodCollective)
+              startMessages(recvArrayStartPtr,
+                            true,
+                            false,
+                            static_cast<size_type>(
+                              MPITags::MPI_P2P_COMMUNICATOR_SCATTER_TAG) +
+                              communicationChannel,
+                            d_requestsUpdateGhostValues.data());
 
             // gather locally owned entries into a contiguous send buffer
             if ((d_mpiPatternP2P->getOwnedLocalIndicesForTargetProcs().size()) >
@@ -507,37 +788,22 @@ namespace dftfe
 #  endif
 #endif
             if (d_commProtocol != communicationProtocol::nccl)
-              for (size_type i = 0;
-                   i < (d_mpiPatternP2P->getTargetProcIds()).size();
-                   ++i)
-                {
-                  const int err = MPI_Isend(
-                    sendArrayStartPtr,
-                    d_mpiPatternP2P->getNumOwnedIndicesForTargetProcs()
-                        .data()[i] *
-                      d_blockSize *
-                      sizeof(typename dftfe::dataTypes::singlePrecType<
-                             ValueType>::type),
-                    MPI_BYTE,
-                    d_mpiPatternP2P->getTargetProcIds().data()[i],
-                    static_cast<size_type>(
-                      MPITags::MPI_P2P_COMMUNICATOR_SCATTER_TAG) +
-                      communicationChannel,
-
-                    d_mpiCommunicator,
-                    &d_requestsUpdateGhostValues
-                      [d_mpiPatternP2P->getGhostProcIds().size() + i]);
-
-                  std::string errMsg = "Error occured while using MPI_Isend. "
-                                       "Error code: " +
-                                       std::to_string(err);
-                  throwException(err == MPI_SUCCESS, errMsg);
-
-                  sendArrayStartPtr +=
-                    d_mpiPatternP2P->getNumOwnedIndicesForTargetProcs()
-                      .data()[i] *
-                    d_blockSize;
-                }
+              {
+                if (d_commMode == communicationMode::neighborhoodCollective)
+                  startNeighborhoodAlltoallv(sendArrayStartPtr,
+                                             recvArrayStartPtr,
+                                             true,
+                                             communicationChannel);
+                else
+                  startMessages(sendArrayStartPtr,
+                                false,
+                                true,
+                                static_cast<size_type>(
+                                  MPITags::MPI_P2P_COMMUNICATOR_SCATTER_TAG) +
+                                  communicationChannel,
+                                d_requestsUpdateGhostValues.data() +
+                                  d_mpiPatternP2P->getGhostProcIds().size());
+              }
           }
       }
 
@@ -554,6 +820,9 @@ namespace dftfe
             dftfe::utils::deviceStreamSynchronize(
               dftfe::utils::DeviceCCLWrapper::d_deviceCommStream);
 #endif
+        if (d_commProtocol != communicationProtocol::nccl &&
+            d_commMode == communicationMode::neighborhoodCollective)
+          waitNeighborhoodAlltoallv(true);
         if (d_requestsUpdateGhostValues.size() > 0)
           {
             if (d_commProtocol != communicationProtocol::nccl)
@@ -653,36 +922,15 @@ namespace dftfe
                 dftfe::utils::deviceSynchronize();
               }
 #endif
-            if (d_commProtocol != communicationProtocol::nccl)
-              for (size_type i = 0;
-                   i < (d_mpiPatternP2P->getTargetProcIds()).size();
-                   ++i)
-                {
-                  const int err =
-                    MPI_Irecv(recvArrayStartPtr,
-                              d_mpiPatternP2P
-                                  ->getNumOwnedIndicesForTargetProcs()
-                                  .data()[i] *
-                                d_blockSize * sizeof(ValueType),
-                              MPI_BYTE,
-                              d_mpiPatternP2P->getTargetProcIds().data()[i],
-                              static_cast<size_type>(
-                                MPITags::MPI_P2P_COMMUNICATOR_GATHER_TAG) +
-                                communicationChannel,
-                              d_mpiCommunicator,
-                              &d_requestsAccumulateAddLocallyOwned[i]);
-
-                  std::string errMsg = "Error occured while using MPI_Irecv. "
-                                       "Error code: " +
-                                       std::to_string(err);
-                  throwException(err == MPI_SUCCESS, errMsg);
-
-
-                  recvArrayStartPtr +=
-                    d_mpiPatternP2P->getNumOwnedIndicesForTargetProcs()
-                      .data()[i] *
-                    d_blockSize;
-                }
+            if (d_commProtocol != communicationProtocol::nccl &&
+                d_commMode != communicationMode::neighborhoodCollective)
+              startMessages(recvArrayStartPtr,
+                            false,
+                            false,
+                            static_cast<size_type>(
+                              MPITags::MPI_P2P_COMMUNICATOR_GATHER_TAG) +
+                              communicationChannel,
+                            d_requestsAccumulateAddLocallyOwned.data());
 
             // initiate non-blocking sends to ghost processors
             ValueType *sendArrayStartPtr =
@@ -762,39 +1010,22 @@ namespace dftfe
 #  endif
 #endif
             if (d_commProtocol != communicationProtocol::nccl)
-              for (size_type i = 0;
-                   i < (d_mpiPatternP2P->getGhostProcIds()).size();
-                   ++i)
-                {
-                  const int err = MPI_Isend(
-                    sendArrayStartPtr,
-                    (d_mpiPatternP2P->getGhostLocalIndicesRanges()
-                       .data()[2 * i + 1] -
-                     d_mpiPatternP2P->getGhostLocalIndicesRanges()
-                       .data()[2 * i]) *
-                      d_blockSize * sizeof(ValueType),
-                    MPI_BYTE,
-                    d_mpiPatternP2P->getGhostProcIds().data()[i],
-                    static_cast<size_type>(
-                      MPITags::MPI_P2P_COMMUNICATOR_GATHER_TAG) +
-                      communicationChannel,
-                    d_mpiCommunicator,
-                    &d_requestsAccumulateAddLocallyOwned
-                      [(d_mpiPatternP2P->getTargetProcIds()).size() + i]);
-
-
-                  std::string errMsg = "Error occured while using MPI_Isend. "
-                                       "Error code: " +
-                                       std::to_string(err);
-                  throwException(err == MPI_SUCCESS, errMsg);
-
-                  sendArrayStartPtr +=
-                    (d_mpiPatternP2P->getGhostLocalIndicesRanges()
-                       .data()[2 * i + 1] -
-                     d_mpiPatternP2P->getGhostLocalIndicesRanges()
-                       .data()[2 * i]) *
-                    d_blockSize;
-                }
+              {
+                if (d_commMode == communicationMode::neighborhoodCollective)
+                  startNeighborhoodAlltoallv(sendArrayStartPtr,
+                                             recvArrayStartPtr,
+                                             false,
+                                             communicationChannel);
+                else
+                  startMessages(sendArrayStartPtr,
+                                true,
+                                true,
+                                static_cast<size_type>(
+                                  MPITags::MPI_P2P_COMMUNICATOR_GATHER_TAG) +
+                                  communicationChannel,
+                                d_requestsAccumulateAddLocallyOwned.data() +
+                                  d_mpiPatternP2P->getTargetProcIds().size());
+              }
           }
         else
           {
@@ -811,37 +1042,15 @@ namespace dftfe
                 dftfe::utils::deviceSynchronize();
               }
 #endif
-            if (d_commProtocol != communicationProtocol::nccl)
-              for (size_type i = 0;
-                   i < (d_mpiPatternP2P->getTargetProcIds()).size();
-                   ++i)
-                {
-                  const int err = MPI_Irecv(
-                    recvArrayStartPtr,
-                    d_mpiPatternP2P->getNumOwnedIndicesForTargetProcs()
-                        .data()[i] *
-                      d_blockSize *
-                      sizeof(typename dftfe::dataTypes::singlePrecType<
-                             ValueType>::type),
-                    MPI_BYTE,
-                    d_mpiPatternP2P->getTargetProcIds().data()[i],
-                    static_cast<size_type>(
-                      MPITags::MPI_P2P_COMMUNICATOR_GATHER_TAG) +
-                      communicationChannel,
-                    d_mpiCommunicator,
-                    &d_requestsAccumulateAddLocallyOwned[i]);
-
-                  std::string errMsg = "Error occured while using MPI_Irecv. "
-                                       "Error code: " +
-                                       std::to_string(err);
-                  throwException(err == MPI_SUCCESS, errMsg);
-
-
-                  recvArrayStartPtr +=
-                    d_mpiPatternP2P->getNumOwnedIndicesForTargetProcs()
-                      .data()[i] *
-                    d_blockSize;
-                }
+            if (d_commProtocol != communicationProtocol::nccl &&
+                d_commMode != communicationMode::neighborhoodCollective)
+              startMessages(recvArrayStartPtr,
+                            false,
+                            false,
+                            static_cast<size_type>(
+                              MPITags::MPI_P2P_COMMUNICATOR_GATHER_TAG) +
+                              communicationChannel,
+                            d_requestsAccumulateAddLocallyOwned.data());
 
 #ifdef DFTFE_WITH_DEVICE
             if constexpr (memorySpace == MemorySpace::DEVICE)
@@ -949,41 +1158,22 @@ namespace dftfe
 #  endif
 #endif
             if (d_commProtocol != communicationProtocol::nccl)
-              for (size_type i = 0;
-                   i < (d_mpiPatternP2P->getGhostProcIds()).size();
-                   ++i)
-                {
-                  const int err = MPI_Isend(
-                    sendArrayStartPtr,
-                    (d_mpiPatternP2P->getGhostLocalIndicesRanges()
-                       .data()[2 * i + 1] -
-                     d_mpiPatternP2P->getGhostLocalIndicesRanges()
-                       .data()[2 * i]) *
-                      d_blockSize *
-                      sizeof(typename dftfe::dataTypes::singlePrecType<
-                             ValueType>::type),
-                    MPI_BYTE,
-                    d_mpiPatternP2P->getGhostProcIds().data()[i],
-                    static_cast<size_type>(
-                      MPITags::MPI_P2P_COMMUNICATOR_GATHER_TAG) +
-                      communicationChannel,
-                    d_mpiCommunicator,
-                    &d_requestsAccumulateAddLocallyOwned
-                      [(d_mpiPatternP2P->getTargetProcIds()).size() + i]);
-
-
-                  std::string errMsg = "Error occured while using MPI_Isend. "
-                                       "Error code: " +
-                                       std::to_string(err);
-                  throwException(err == MPI_SUCCESS, errMsg);
-
-                  sendArrayStartPtr +=
-                    (d_mpiPatternP2P->getGhostLocalIndicesRanges()
-                       .data()[2 * i + 1] -
-                     d_mpiPatternP2P->getGhostLocalIndicesRanges()
-                       .data()[2 * i]) *
-                    d_blockSize;
-                }
+              {
+                if (d_commMode == communicationMode::neighborhoodCollective)
+                  startNeighborhoodAlltoallv(sendArrayStartPtr,
+                                             recvArrayStartPtr,
+                                             false,
+                                             communicationChannel);
+                else
+                  startMessages(sendArrayStartPtr,
+                                true,
+                                true,
+                                static_cast<size_type>(
+                                  MPITags::MPI_P2P_COMMUNICATOR_GATHER_TAG) +
+                                  communicationChannel,
+                                d_requestsAccumulateAddLocallyOwned.data() +
+                                  d_mpiPatternP2P->getTargetProcIds().size());
+              }
           }
       }
 
@@ -1000,6 +1190,9 @@ namespace dftfe
             dftfe::utils::deviceStreamSynchronize(
               dftfe::utils::DeviceCCLWrapper::d_deviceCommStream);
 #endif
+        if (d_commProtocol != communicationProtocol::nccl &&
+            d_commMode == communicationMode::neighborhoodCollective)
+          waitNeighborhoodAlltoallv(false);
         if (d_requestsAccumulateAddLocallyOwned.size() > 0)
           {
             if (d_commProtocol != communicationProtocol::nccl)
@@ -22,6 +22,7 @@
 //
 
 #include "MPIWriteOnFile.h"
+#include <deal.II/base/exceptions.h>
 #include <iostream>
 #include <fstream>
 #include <numeric>
@@ -136,5 +137,123 @@ namespace dftfe
 
       return;
     }
+
+    namespace
+    {
+      // file view selecting the records recordIds of size recordSize
+      void
+      createRecordsFileType(const std::vector<unsigned long> &recordIds,
+                            const unsigned long               recordSize,
+                            MPI_Datatype &                    recordType,
+                            MPI_Datatype &                    fileType)
+      {
+        MPI_Type_contiguous(static_cast<int>(recordSize),
+                            MPI_BYTE,
+                            &recordType);
+        MPI_Type_commit(&recordType);
+
+        std::vector<MPI_Aint> displacements(recordIds.size());
+        for (unsigned long i = 0; i < recordIds.size(); ++i)
+          displacements[i] = static_cast<MPI_Aint>(recordIds[i] * recordSize);
+
+        MPI_Type_create_hindexed_block(static_cast<int>(recordIds.size()),
+                                       1,
+                                       displacements.data(),
+                                       recordType,
+                                       &fileType);
+        MPI_Type_commit(&fileType);
+      }
+    } // namespace
+
+    void
+    MPIWriteOnFile::writeBinaryRecords(
+      const std::vector<char> &         header,
+      const char *                      data,
+      const std::vector<unsigned long> &recordIds,
+      const unsigned long               recordSize,
+      const std::string &               fileName,
+      const MPI_Comm &                  mpiComm)
+    {
+      int rank;
+      MPI_Comm_rank(mpiComm, &rank);
+
+      MPI_File  file;
+      const int err = MPI_File_open(mpiComm,
+                                    fileName.c_str(),
+                                    MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                                    MPI_INFO_NULL,
+                                    &file);
+      AssertThrow(err == MPI_SUCCESS,
+                  dealii::ExcMessage("DFT-FE Error: unable to open file " +
+                                     fileName + " for writing."));
+
+      // discard the contents of an older file
+      MPI_File_set_size(file, 0);
+
+      MPI_Status status;
+      if (rank == 0 && header.size() > 0)
+        MPI_File_write_at(
+          file, 0, header.data(), header.size(), MPI_BYTE, &status);
+
+      MPI_Datatype recordType, fileType;
+      createRecordsFileType(recordIds, recordSize, recordType, fileType);
+
+      MPI_File_set_view(
+        file, header.size(), MPI_BYTE, fileType, "native", MPI_INFO_NULL);
+      MPI_File_write_all(
+        file, data, static_cast<int>(recordIds.size()), recordType, &status);
+
+      MPI_File_close(&file);
+      MPI_Type_free(&fileType);
+      MPI_Type_free(&recordType);
+    }
+
+    void
+    MPIWriteOnFile::readBinaryHeader(std::vector<char> & header,
+                                     const std::string &fileName,
+                                     const MPI_Comm &   mpiComm)
+    {
+      MPI_File  file;
+      const int err = MPI_File_open(
+        mpiComm, fileName.c_str(), MPI_MODE_RDONLY, MPI_INFO_NULL, &file);
+      AssertThrow(err == MPI_SUCCESS,
+                  dealii::ExcMessage("DFT-FE Error: unable to open file " +
+                                     fileName + " for reading."));
+
+      MPI_Status status;
+      MPI_File_read_at_all(
+        file, 0, header.data(), header.size(), MPI_BYTE, &status);
+      MPI_File_close(&file);
+    }
+
+    void
+    MPIWriteOnFile::readBinaryRecords(
+      const unsigned long               headerSize,
+      const std::vector<unsigned long> &recordIds,
+      const unsigned long               recordSize,
+      char *                            data,
+      const std::string &               fileName,
+      const MPI_Comm &                  mpiComm)
+    {
+      MPI_File  file;
+      const int err = MPI_File_open(
+        mpiComm, fileName.c_str(), MPI_MODE_RDONLY, MPI_INFO_NULL, &file);
+      AssertThrow(err == MPI_SUCCESS,
+                  dealii::ExcMessage("DFT-FE Error: unable to open file " +
+                                     fileName + " for reading."));
+
+      MPI_Datatype recordType, fileType;
+      createRecordsFileType(recordIds, recordSize, recordType, fileType);
+
+      MPI_Status status;
+      MPI_File_set_view(
+        file, headerSize, MPI_BYTE, fileType, "native", MPI_INFO_NULL);
+      MPI_File_read_all(
+        file, data, static_cast<int>(recordIds.size()), recordType, &status);
+
+      MPI_File_close(&file);
+      MPI_Type_free(&fileType);
+      MPI_Type_free(&recordType);
+    }
   } // namespace dftUtils
 } // namespace dftfe
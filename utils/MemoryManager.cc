@@ -30,6 +30,7 @@
 #include <DeviceAPICalls.h>
 #include <algorithm>
 #include <MemoryManager.h>
+#include <HostMemoryPool.h>
 #include <complex>
 
 namespace dftfe
@@ -42,7 +43,13 @@ namespace dftfe
                                                           ValueType **ptr)
     {
       if (size > 0)
-        *ptr = new ValueType[size];
+        {
+          if (HostMemoryPool::instance().isEnabled())
+            *ptr = static_cast<ValueType *>(
+              HostMemoryPool::instance().allocate(size * sizeof(ValueType)));
+          else
+            *ptr = new ValueType[size];
+        }
       else
         *ptr = nullptr;
     }
@@ -51,7 +58,8 @@ namespace dftfe
     void
     MemoryManager<ValueType, MemorySpace::HOST>::deallocate(ValueType *ptr)
     {
-      if (ptr != nullptr)
+      // the pool may have been enabled after ptr was allocated
+      if (ptr != nullptr && !HostMemoryPool::instance().deallocate(ptr))
         delete[] ptr;
     }
 
@@ -56,6 +56,36 @@ namespace dftfe
         "[Adavanced] Uses algorithms which have lower peak memory but with a marginal performance degradation. Default: true.",
         true);
 
+      prm.declare_entry(
+        "MATRIX FREE HAMILTONIAN",
+        "false",
+        dealii::Patterns::Bool(),
+        "[Advanced] Applies the local part of the Kohn-Sham Hamiltonian (kinetic, effective potential, local pseudopotential and magnetic field terms) in a sum-factorized matrix-free manner using the one dimensional tensor product shape functions, instead of storing the dense cell Hamiltonian matrices. This reduces the memory of the Hamiltonian from (number of dofs per cell)^2 to a few values per quadrature point for each cell, which is beneficial at higher FE orders and for the non-collinear case. The nonlocal pseudopotential part is unchanged. Currently implemented only for host runs without SINGLE PREC CHEBY. Default: false.");
+
+      prm.declare_entry(
+        "SHARED KPOINT HAMILTONIAN",
+        "false",
+        dealii::Patterns::Bool(),
+        "[Advanced] Computes the k-point independent part of the cell Hamiltonian matrices (kinetic, effective potential and local pseudopotential terms) once per spin index in every SCF iteration and stores the k-point dependent terms as the mass matrix and the cell matrices of the k-point coupling term along the three Cartesian directions. The cell Hamiltonian matrices of all the k-points of a pool are then assembled from these in one batched matrix multiplication with the k-points as columns, instead of evaluating the quadrature sums for every k-point. This only speeds up the assembly of the cell Hamiltonian matrices and does not save memory: the cell Hamiltonian matrices of all the k-points of the pool are still stored and applied in the Hamiltonian times vector products as without this option, and four extra cell matrices per cell (the k-point independent part and the three coupling matrices) are stored on top of them. Their size is printed at the setup. Used only for complex (k-point) builds with more than one k-point per pool, without NONCOLLINEAR SPIN and MATRIX FREE HAMILTONIAN and with MEM OPT MODE set to false. Default: false.");
+
+      prm.declare_entry(
+        "HOST MEMORY POOL",
+        "false",
+        dealii::Patterns::Bool(),
+        "[Advanced] Serves the host memory of the DFT-FE data structures from a pool of 64 byte (2 MB for large blocks) aligned blocks with size class free lists, so that the temporaries created in the SCF iterations are reused instead of being returned to the system allocator. The free blocks are kept separately for each NUMA node and new blocks are first touched by the allocating thread. The high-water marks of the pool per allocation tag are printed at the end of the run for VERBOSITY>=1. Default: false.");
+
+      prm.declare_entry(
+        "HOST MEMORY POOL CACHE SIZE",
+        "1024",
+        dealii::Patterns::Integer(0),
+        "[Advanced] Maximum memory in MB per MPI task kept on the free lists of the HOST MEMORY POOL. Blocks released beyond this are returned to the system allocator. Default: 1024.");
+
+      prm.declare_entry(
+        "NONCOLLINEAR SPIN BLOCK HAMILTONIAN",
+        "false",
+        dealii::Patterns::Bool(),
+        "[Advanced] For NONCOLLINEAR SPIN calculations, stores the cell Hamiltonian matrices as the spin diagonal complex block (kinetic, effective potential and k-point terms), the complex Bx+iBy block and the real Bz block instead of the full complex (2 x number of dofs per cell)^2 matrices, and applies them as separate batched matrix multiplications on the spinor components. This reduces the memory of the cell Hamiltonian matrices to 5/8 of the full matrices. Default: false.");
+
 
       prm.enter_subsection("GPU");
       {
@@ -177,6 +207,13 @@ namespace dftfe
           dealii::Patterns::Double(0),
           R"([Advanced] Block message size in MB used to break a single MPI\_Allreduce call on wavefunction vectors data into multiple MPI\_Allreduce calls. This is useful on certain architectures which take advantage of High Bandwidth Memory to improve efficiency of MPI operations. This variable is relevant only if NPBAND>1. Default value is 100.0 MB.)");
 
+        prm.declare_entry(
+          "MPI P2P COMMUNICATION MODE",
+          "NONBLOCKING",
+          dealii::Patterns::Selection(
+            "NONBLOCKING|PERSISTENT|NEIGHBORHOOD COLLECTIVE"),
+          "[Advanced] Mode of the point-to-point MPI communication of the ghost values of the distributed vectors (used for instance in the Chebyshev filtering and the Poisson solves), which is relevant for the host runs and the GPU runs without NCCL/RCCL. NONBLOCKING posts new MPI\_Isend/MPI\_Irecv calls in every exchange. PERSISTENT creates MPI\_Send\_init/MPI\_Recv\_init requests once for the fixed communication pattern and buffers of each vector and only starts them in every exchange, saving the per message setup cost. NEIGHBORHOOD COLLECTIVE issues a single MPI\_Ineighbor\_alltoallv on a graph communicator built from the communication pattern, which can be faster on networks where the MPI library optimizes neighborhood collectives. Default: NONBLOCKING.");
+
         prm.declare_entry(
           "BAND PARAL OPT",
           "true",
@@ -199,6 +236,18 @@ namespace dftfe
           dealii::Patterns::Bool(),
           "[Standard] Loads charge density and mesh triagulation data from file.");
 
+        prm.declare_entry(
+          "SAVE WFC DATA",
+          "false",
+          dealii::Patterns::Bool(),
+          "[Standard] Saves the wavefunctions of all k-points and spins, the eigenvalues and the Fermi energy along with the charge density and mesh triangulation data, i.e. every 10 SCF iterations in GS mode and after each SCF solve. The wavefunctions are written with MPI-IO in a layout independent of the number of MPI tasks. Requires SAVE RHO DATA to be true.");
+
+        prm.declare_entry(
+          "LOAD WFC DATA",
+          "false",
+          dealii::Patterns::Bool(),
+          "[Standard] Uses the wavefunctions, eigenvalues and Fermi energy saved with SAVE WFC DATA as the starting guess of the SCF solve instead of the atomic or random wavefunctions. The number of MPI tasks and pools can differ from the run which saved the data. If a wavefunction checkpoint file is missing, incomplete or was written for a different mesh or real/complex build, a warning is printed and the SCF solve starts from the initial guess wavefunctions. Requires LOAD RHO DATA to be true.");
+
         prm.declare_entry(
           "RESTART SP FROM NO SP",
           "false",
@@ -597,13 +646,13 @@ namespace dftfe
           "USE GROUP SYMMETRY",
           "false",
           dealii::Patterns::Bool(),
-          "[Standard] Flag to control the use of point group symmetries. Currently this feature cannot be used if ION FORCE or CELL STRESS input parameters are set to true.");
+          "[Standard] Flag to control the use of point group symmetries. Currently this feature cannot be used if ION FORCE or CELL STRESS input parameters are set to true. For NONCOLLINEAR SPIN only the magnetic symmetries consistent with the starting magnetization of the atoms are used.");
 
         prm.declare_entry(
           "USE TIME REVERSAL SYMMETRY",
           "false",
           dealii::Patterns::Bool(),
-          "[Standard] Flag to control the use of time reversal symmetry.");
+          "[Standard] Flag to control the use of time reversal symmetry. For NONCOLLINEAR SPIN time reversal is only used combined with the magnetic symmetries when USE GROUP SYMMETRY is set to true.");
       }
       prm.leave_subsection();
 
@@ -816,6 +865,18 @@ namespace dftfe
             "ANDERSON|ANDERSON_WITH_KERKER|ANDERSON_WITH_RESTA|LOW_RANK_DIELECM_PRECOND"),
           "[Standard] Method for density mixing. ANDERSON is the default option.");
 
+        prm.declare_entry(
+          "MIXING HISTORY SCHEME",
+          "ANDERSON",
+          dealii::Patterns::Selection("ANDERSON|BROYDEN"),
+          "[Advanced] Scheme used to combine the SCF iteration history in the ANDERSON, ANDERSON\_WITH\_KERKER and ANDERSON\_WITH\_RESTA mixing methods: ANDERSON(Anderson mixing), BROYDEN(modified Broyden mixing of Johnson [PRB 38, 12807 (1988)] with regularization weight w0=0.01, which can be more robust for long mixing histories). BROYDEN always uses the incremental Gram matrix, independent of INCREMENTAL MIXING GRAM MATRIX. Default: ANDERSON.");
+
+        prm.declare_entry(
+          "INCREMENTAL MIXING GRAM MATRIX",
+          "false",
+          dealii::Patterns::Bool(),
+          "[Advanced] Boolean parameter specifying whether to keep the Gram matrix of the residual history across SCF iterations, such that only the dot products of the latest residual with the history are computed and all the mixing variables are reduced by a single MPI\_Allreduce. Reduces the mixing cost for long mixing histories. Default: false.");
+
 
         prm.declare_entry(
           "CONSTRAINT MAGNETIZATION",
@@ -952,6 +1013,12 @@ namespace dftfe
             dealii::Patterns::Integer(1),
             "[Advanced]  This parameter specifies the block size of the wavefunction matrix to be used for memory optimization purposes in the orthogonalization, Rayleigh-Ritz, and density computation steps. The optimum block size is dependent on the computing architecture. For optimum work sharing during band parallelization (NPBAND > 1), we recommend adjusting WFC BLOCK SIZE and NUMBER OF KOHN-SHAM WAVEFUNCTIONS such that NUMBER OF KOHN-SHAM WAVEFUNCTIONS/NPBAND/WFC BLOCK SIZE equals an integer value. Default value is 400.");
 
+          prm.declare_entry(
+            "DENSITY CELLS BLOCK SIZE CPU",
+            "16",
+            dealii::Patterns::Integer(1),
+            "[Advanced] Number of finite-element cells whose wavefunction values at quadrature points are interpolated together in a single batched matrix-matrix multiplication during the electron density computation on CPUs. Larger values improve the BLAS efficiency for small CHEBY WFC BLOCK SIZE at the expense of memory proportional to this value times the wavefunction block size. Default value is 16.");
+
           prm.declare_entry(
             "SUBSPACE ROT DOFS BLOCK SIZE",
             "10000",
@@ -1025,7 +1092,7 @@ namespace dftfe
             "USE SINGLE PREC COMMUN CHEBY",
             "false",
             dealii::Patterns::Bool(),
-            "[Advanced] Use single precision communication in Chebyshev filtering. Default setting is false.");
+            "[Advanced] Use single precision communication in Chebyshev filtering. ALGO=FAST turns this on for GPU runs, while on CPUs the single precision communication is only used when this is set explicitly. Default setting is false.");
 
           prm.declare_entry(
             "USE MIXED PREC COMMUN ONLY XTX XTHX",
@@ -1051,6 +1118,12 @@ namespace dftfe
             dealii::Patterns::Bool(),
             "[Advanced] Overlap communication and computation in Chebyshev filtering. This option can only be activated for USE GPU=true. Default setting is true.");
 
+          prm.declare_entry(
+            "OVERLAP COMPUTE COMMUN CHEBY HOST",
+            "false",
+            dealii::Patterns::Bool(),
+            "[Advanced] Overlap communication and computation in Chebyshev filtering on CPUs. Two blocks of CHEBY WFC BLOCK SIZE wavefunctions are filtered simultaneously, and the ghost communication of one block is overlapped with the cell level computation of the other. This doubles the memory of the scratch wavefunction blocks. Only used for pseudopotential calculations with USE GPU=false. Default setting is false.");
+
           prm.declare_entry(
             "OVERLAP COMPUTE COMMUN ORTHO RR",
             "true",
@@ -1115,6 +1188,18 @@ namespace dftfe
                           "true",
                           dealii::Patterns::Bool(),
                           "[Advanced] Toggle GPU MODE in vself Poisson solve.");
+
+        prm.declare_entry(
+          "PRECONDITIONER",
+          "JACOBI",
+          dealii::Patterns::Selection("JACOBI|MULTIGRID"),
+          "[Advanced] Preconditioner used in the CG iterations of the CPU total electrostatic potential and vself Poisson solves. JACOBI uses the inverse diagonal. MULTIGRID uses a matrix-free p-multigrid V-cycle with Chebyshev smoothing, coarsening the electrostatics FE order down to linear elements on the same mesh. Default: JACOBI.");
+
+        prm.declare_entry(
+          "VSELF BLOCK SIZE",
+          "16",
+          dealii::Patterns::Integer(1),
+          "[Advanced] Maximum number of vself Poisson problems (the vself and, with smeared charges, its three derivative problems per bin) solved together by the block CG in the CPU vself solve with JACOBI preconditioning. Every problem solved together keeps its own solver vectors, so smaller values reduce the memory, larger values reduce the number of MPI reductions. Default: 16.");
       }
       prm.leave_subsection();
 
@@ -1155,6 +1240,18 @@ namespace dftfe
           dealii::Patterns::Integer(0, 2),
           "[Standard] Parameter controlling the reuse of ground-state density during molecular dynamics. The options are 0 default setting where superposition of atomic densities is the initial rho, 1 (second order extrapolation of density), and 2 (extrapolation of split density and the atomic densities are added) Option 2 is not enabled for spin-polarized case. Default setting is 0.");
 
+        prm.declare_entry(
+          "EXTRAPOLATE WAVEFUNCTIONS",
+          "false",
+          dealii::Patterns::Bool(),
+          "[Advanced] Extrapolate the Kohn-Sham wavefunctions to the next time step by the always stable predictor-corrector (ASPC) scheme, using a history of subspaces aligned to a common gauge by orthogonal Procrustes rotations. The extrapolated wavefunctions are the initial guess of the next ground-state solve, which reduces the number of Chebyshev filtering passes per time step. The history is reset on remeshing. Requires storage of WAVEFUNCTION EXTRAPOLATION ORDER+3 additional copies of the wavefunctions. Default: false.");
+
+        prm.declare_entry(
+          "WAVEFUNCTION EXTRAPOLATION ORDER",
+          "2",
+          dealii::Patterns::Integer(0, 6),
+          "[Advanced] Order K of the ASPC wavefunction extrapolation, which uses the last K+2 time steps. Default: 2.");
+
         prm.declare_entry(
           "MAX JACOBIAN RATIO FACTOR",
           "1.5",
@@ -1224,6 +1321,8 @@ namespace dftfe
     maxLinearSolverIterations                  = 1;
     poissonGPU                                 = true;
     vselfGPU                                   = true;
+    poissonPreconditioner                      = "JACOBI";
+    vselfBlockSolveSize                        = 16;
     mixingHistory                              = 1;
     npool                                      = 1;
     maxLinearSolverIterationsHelmholtz         = 1;
@@ -1238,6 +1337,7 @@ namespace dftfe
     absLinearSolverToleranceHelmholtz = 1e-10;
     chebyshevTolerance                = 1e-02;
     mixingMethod                      = "";
+    mixingHistoryScheme               = "";
     optimizationMode                  = "";
     ionOptSolver                      = "";
     cellOptSolver                     = "";
@@ -1287,9 +1387,16 @@ namespace dftfe
 
     verbosity                                      = 0;
     keepScratchFolder                              = false;
+    matrixFreeHamiltonian                          = false;
+    sharedKPointHamiltonian                        = false;
+    noncolinSpinBlockHamiltonian                   = false;
+    useHostMemoryPool                              = false;
+    hostMemoryPoolCacheSizeMB                      = 1024;
     restartFolder                                  = ".";
     saveRhoData                                    = false;
     loadRhoData                                    = false;
+    saveWfcData                                    = false;
+    loadWfcData                                    = false;
     restartSpinFromNoSpin                          = false;
     reproducible_output                            = false;
     meshAdaption                                   = false;
@@ -1300,6 +1407,7 @@ namespace dftfe
     writeDensitySolutionFields                     = false;
     writeDensityQuadData                           = false;
     wfcBlockSize                                   = 400;
+    cellsBlockSizeDensityHost                      = 16;
     chebyWfcBlockSize                              = 400;
     subspaceRotDofsBlockSize                       = 2000;
     nbandGrps                                      = 1;
@@ -1313,6 +1421,7 @@ namespace dftfe
     reuseWfcGeoOpt                                 = false;
     reuseDensityGeoOpt                             = 0;
     mpiAllReduceMessageBlockSizeMB                 = 2.0;
+    mpiP2PCommunicationMode                        = "NONBLOCKING";
     useSubspaceProjectedSHEPGPU                    = false;
     useMixedPrecCGS_SR                             = false;
     useMixedPrecCGS_O                              = false;
@@ -1330,11 +1439,15 @@ namespace dftfe
     deviceFineGrainedTimings                       = false;
     allowFullCPUMemSubspaceRot                     = true;
     useSinglePrecCommunCheby                       = false;
+    useSinglePrecCommunChebyHost                   = false;
     overlapComputeCommunCheby                      = false;
+    overlapComputeCommunChebyHost                  = false;
     overlapComputeCommunOrthoRR                    = false;
     autoDeviceBlockSizes                           = true;
     maxJacobianRatioFactorForMD                    = 1.5;
     extrapolateDensity                             = 0;
+    extrapolateWfc                                 = false;
+    wfcExtrapolationOrder                          = 2;
     timeStepBOMD                                   = 0.5;
     numberStepsBOMD                                = 1000;
     gaussianConstantForce                          = 0.75;
@@ -1421,7 +1534,13 @@ namespace dftfe
     if (auto memOptSet = entriesNotSet.find("MEM_20OPT_20MODE");
         memOptSet != entriesNotSet.end())
       prm.set("MEM OPT MODE", solverMode == "NSCF");
-    memOptMode = prm.get_bool("MEM OPT MODE");
+    memOptMode              = prm.get_bool("MEM OPT MODE");
+    matrixFreeHamiltonian   = prm.get_bool("MATRIX FREE HAMILTONIAN");
+    sharedKPointHamiltonian = prm.get_bool("SHARED KPOINT HAMILTONIAN");
+    noncolinSpinBlockHamiltonian =
+      prm.get_bool("NONCOLLINEAR SPIN BLOCK HAMILTONIAN");
+    useHostMemoryPool         = prm.get_bool("HOST MEMORY POOL");
+    hostMemoryPoolCacheSizeMB = prm.get_integer("HOST MEMORY POOL CACHE SIZE");
     writeStructreEnergyForcesFileForPostProcess =
       prm.get_bool("WRITE STRUCTURE ENERGY FORCES DATA POST PROCESS");
 
@@ -1461,6 +1580,7 @@ namespace dftfe
       bandParalOpt = prm.get_bool("BAND PARAL OPT");
       mpiAllReduceMessageBlockSizeMB =
         prm.get_double("MPI ALLREDUCE BLOCK SIZE");
+      mpiP2PCommunicationMode = prm.get("MPI P2P COMMUNICATION MODE");
     }
     prm.leave_subsection();
 
@@ -1468,6 +1588,8 @@ namespace dftfe
     {
       saveRhoData           = prm.get_bool("SAVE RHO DATA");
       loadRhoData           = prm.get_bool("LOAD RHO DATA");
+      saveWfcData           = prm.get_bool("SAVE WFC DATA");
+      loadWfcData           = prm.get_bool("LOAD WFC DATA");
       restartSpinFromNoSpin = prm.get_bool("RESTART SP FROM NO SP");
       if (solverMode == "NEB")
         saveRhoData = true;
@@ -1633,6 +1755,9 @@ namespace dftfe
       restaFermiWavevector       = prm.get_double("RESTA FERMI WAVEVECTOR");
       restaScreeningLength       = prm.get_double("RESTA SCREENING LENGTH");
       mixingMethod               = prm.get("MIXING METHOD");
+      mixingHistoryScheme        = prm.get("MIXING HISTORY SCHEME");
+      incrementalMixingGramMatrix =
+        prm.get_bool("INCREMENTAL MIXING GRAM MATRIX");
       constraintMagnetization    = prm.get_bool("CONSTRAINT MAGNETIZATION");
       startingWFCType            = prm.get("STARTING WFC");
       computeEnergyEverySCF      = prm.get_bool("COMPUTE ENERGY EACH ITER");
@@ -1668,6 +1793,8 @@ namespace dftfe
         orthogType         = prm.get("ORTHOGONALIZATION TYPE");
         chebyshevTolerance = prm.get_double("CHEBYSHEV FILTER TOLERANCE");
         wfcBlockSize       = prm.get_integer("WFC BLOCK SIZE");
+        cellsBlockSizeDensityHost =
+          prm.get_integer("DENSITY CELLS BLOCK SIZE CPU");
         chebyWfcBlockSize  = prm.get_integer("CHEBY WFC BLOCK SIZE");
         subspaceRotDofsBlockSize =
           prm.get_integer("SUBSPACE ROT DOFS BLOCK SIZE");
@@ -1685,6 +1812,8 @@ namespace dftfe
         tensorOpType             = prm.get("TENSOR OP TYPE SINGLE PREC CHEBY");
         overlapComputeCommunCheby =
           prm.get_bool("OVERLAP COMPUTE COMMUN CHEBY");
+        overlapComputeCommunChebyHost =
+          prm.get_bool("OVERLAP COMPUTE COMMUN CHEBY HOST");
         overlapComputeCommunOrthoRR =
           prm.get_bool("OVERLAP COMPUTE COMMUN ORTHO RR");
         algoType                                       = prm.get("ALGO");
@@ -1711,6 +1840,8 @@ namespace dftfe
       absLinearSolverTolerance  = prm.get_double("TOLERANCE");
       poissonGPU                = prm.get_bool("GPU MODE");
       vselfGPU                  = prm.get_bool("VSELF GPU MODE");
+      poissonPreconditioner     = prm.get("PRECONDITIONER");
+      vselfBlockSolveSize       = prm.get_integer("VSELF BLOCK SIZE");
     }
     prm.leave_subsection();
 
@@ -1727,6 +1858,9 @@ namespace dftfe
     {
       atomicMassesFile            = prm.get("ATOMIC MASSES FILE");
       extrapolateDensity          = prm.get_integer("EXTRAPOLATE DENSITY");
+      extrapolateWfc              = prm.get_bool("EXTRAPOLATE WAVEFUNCTIONS");
+      wfcExtrapolationOrder =
+        prm.get_integer("WAVEFUNCTION EXTRAPOLATION ORDER");
       isBOMD                      = prm.get_bool("BOMD");
       maxJacobianRatioFactorForMD = prm.get_double("MAX JACOBIAN RATIO FACTOR");
       timeStepBOMD                = prm.get_double("TIME STEP");
@@ -1794,6 +1928,7 @@ namespace dftfe
       dealii::ExcMessage(
         "DFT-FE Error: Real executable cannot be used for non-zero k point."));
 #endif
+
     if (numberEigenValues != 0)
       AssertThrow(
         nbandGrps <= numberEigenValues,
@@ -1821,6 +1956,16 @@ namespace dftfe
                 dealii::ExcMessage(
                   "DFT-FE Error: DOMAIN VECTORS FILE not given."));
 
+    AssertThrow(
+      !saveWfcData || saveRhoData,
+      dealii::ExcMessage(
+        "DFT-FE Error: SAVE WFC DATA requires SAVE RHO DATA to be set to true."));
+
+    AssertThrow(
+      !loadWfcData || loadRhoData,
+      dealii::ExcMessage(
+        "DFT-FE Error: LOAD WFC DATA requires LOAD RHO DATA to be set to true."));
+
     if (solverMode == "NSCF")
       AssertThrow(
         loadRhoData == true,
@@ -1868,6 +2013,12 @@ namespace dftfe
       dealii::ExcMessage(
         "DFT-FE Error: Number of atom types not specified or given a value of zero, which is not allowed."));
 
+    if (matrixFreeHamiltonian)
+      AssertThrow(
+        !useDevice && !useSinglePrecCheby,
+        dealii::ExcMessage(
+          "DFT-FE Error: MATRIX FREE HAMILTONIAN is currently implemented only for host runs with SINGLE PREC CHEBY set to false."));
+
     if (nbandGrps > 1)
       AssertThrow(
         wfcBlockSize == chebyWfcBlockSize,
@@ -2002,6 +2153,9 @@ namespace dftfe
       }
 
 
+    // the single precision communication implied by ALGO=FAST is only
+    // applied on GPUs, on CPUs it has to be requested explicitly
+    useSinglePrecCommunChebyHost = useSinglePrecCommunCheby;
     if (algoType == "FAST")
       {
         useMixedPrecCGS_O                   = true;
@@ -2018,6 +2172,11 @@ namespace dftfe
       }
 #endif
 
+    if (!isPseudopotential || useDevice)
+      {
+        overlapComputeCommunChebyHost = false;
+      }
+
 
 #ifndef DFTFE_WITH_DEVICE
     useDevice           = false;
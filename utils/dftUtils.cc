@@ -32,6 +32,7 @@
  */
 
 #include <dftUtils.h>
+#include <HostMemoryPool.h>
 
 #include <fstream>
 #include <iostream>
@@ -110,6 +111,59 @@ namespace dftfe
       crossProductVector = crossProduct;
     }
 
+    void
+    computeLocalFrameSpinDensity(
+      const bool isGGA,
+      const std::vector<
+        dftfe::utils::MemoryStorage<double, dftfe::utils::MemorySpace::HOST>>
+        &rhoValues,
+      const std::vector<
+        dftfe::utils::MemoryStorage<double, dftfe::utils::MemorySpace::HOST>>
+        &gradRhoValues,
+      std::vector<
+        dftfe::utils::MemoryStorage<double, dftfe::utils::MemorySpace::HOST>>
+        &rhoLocalFrameValues,
+      std::vector<
+        dftfe::utils::MemoryStorage<double, dftfe::utils::MemorySpace::HOST>>
+        &gradRhoLocalFrameValues)
+    {
+      // components of the noncollinear density are rho, mz, my and mx. In
+      // the frame of the local magnetization the exchange-correlation energy
+      // is that of a collinear density with magnetization |m|
+      const unsigned int numPoints = rhoValues[0].size();
+
+      rhoLocalFrameValues.resize(2);
+      rhoLocalFrameValues[0] = rhoValues[0];
+      rhoLocalFrameValues[1].resize(numPoints, 0.0);
+      if (isGGA)
+        {
+          gradRhoLocalFrameValues.resize(2);
+          gradRhoLocalFrameValues[0] = gradRhoValues[0];
+          gradRhoLocalFrameValues[1].resize(3 * numPoints, 0.0);
+        }
+
+      for (unsigned int iPoint = 0; iPoint < numPoints; ++iPoint)
+        {
+          const double magZ = rhoValues[1][iPoint];
+          const double magY = rhoValues[2][iPoint];
+          const double magX = rhoValues[3][iPoint];
+          const double magNorm =
+            std::sqrt(magX * magX + magY * magY + magZ * magZ);
+          rhoLocalFrameValues[1][iPoint] = magNorm;
+
+          // grad|m| = (m.grad m)/|m|, taken as zero where m vanishes
+          if (isGGA)
+            for (unsigned int iDim = 0; iDim < 3; ++iDim)
+              gradRhoLocalFrameValues[1][3 * iPoint + iDim] =
+                magNorm < 1e-12 ?
+                  0.0 :
+                  (magZ * gradRhoValues[1][3 * iPoint + iDim] +
+                   magY * gradRhoValues[2][3 * iPoint + iDim] +
+                   magX * gradRhoValues[3][3 * iPoint + iDim]) /
+                    magNorm;
+        }
+    }
+
     void
     transformDomainBoundingVectors(
       std::vector<std::vector<double>> &  domainBoundingVectors,
@@ -173,6 +227,33 @@ namespace dftfe
 #endif
     }
 
+    void
+    printHostMemoryPoolStatistics(const MPI_Comm &mpiComm)
+    {
+      const dftfe::utils::HostMemoryPool &pool =
+        dftfe::utils::HostMemoryPool::instance();
+      const double maxHighWaterBytes =
+        dealii::Utilities::MPI::max((double)pool.getHighWaterBytes(), mpiComm);
+      const double maxCachedBytes =
+        dealii::Utilities::MPI::max((double)pool.getCachedBytes(), mpiComm);
+      dealii::ConditionalOStream pcout(
+        std::cout, (dealii::Utilities::MPI::this_mpi_process(mpiComm) == 0));
+      pcout << std::endl
+            << "Host memory pool high-water mark, maximum across all "
+               "processors: "
+            << maxHighWaterBytes / 1024.0 / 1024.0
+            << " MB, cached free blocks: " << maxCachedBytes / 1024.0 / 1024.0
+            << " MB" << std::endl;
+      pcout << "Host memory pool high-water marks per tag on task 0:"
+            << std::endl;
+      for (const auto &tagStatistics : pool.getTagStatistics())
+        pcout << "  " << tagStatistics.first << ": "
+              << tagStatistics.second.highWaterBytes / 1024.0 / 1024.0
+              << " MB in " << tagStatistics.second.numAllocations
+              << " allocations" << std::endl;
+      pcout << std::endl;
+    }
+
     void
     writeDataVTUParallelLowestPoolId(const dealii::DoFHandler<3> &dofHandler,
                                      const dealii::DataOut<3> &   dataOut,
@@ -18,15 +18,12 @@
 //
 #include <headers.h>
 #include <pseudoConverter.h>
-#include <sys/stat.h>
 
 #include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
 
-#include "../pseudoConverters/pseudoPotentialToDftfeConverter.cc"
-
 namespace dftfe
 {
   namespace pseudoUtils
@@ -55,30 +52,30 @@ namespace dftfe
 
     std::vector<int>
     convert(const std::string &fileName,
-            const std::string &dftfeScratchFolderName,
+            const MPI_Comm &   mpiComm,
             const int          verbosity,
             const unsigned int natomTypes,
-            const bool         pseudoTestsFlag)
+            const bool         pseudoTestsFlag,
+            std::map<unsigned int, std::shared_ptr<const pseudoPotentialData>>
+              &pseudoPotentialDataMap)
     {
-      dealii::ConditionalOStream pcout(std::cout);
-
-
-      std::ifstream input_file;
-      input_file.open(fileName);
+      dealii::ConditionalOStream pcout(
+        std::cout, (dealii::Utilities::MPI::this_mpi_process(mpiComm) == 0));
 
-      AssertThrow(!input_file.fail(),
+      std::string fileContents;
+      AssertThrow(readAndBroadcastFile(fileName, mpiComm, fileContents),
                   dealii::ExcMessage(
                     "Not a valid list of pseudopotential files "));
+      std::istringstream input_file(fileContents);
 
       std::string              z;
       std::string              toParse;
       std::vector<std::string> atomTypes;
       unsigned int             nlccSum = 0;
 
+      pseudoPotentialDataMap.clear();
       while (input_file >> z >> toParse)
         {
-          std::string newFolder = dftfeScratchFolderName + "/" + "z" + z;
-          mkdir(newFolder.c_str(), ACCESSPERMS);
           AssertThrow(
             isupf(toParse),
             dealii::ExcMessage(
@@ -88,69 +85,40 @@ namespace dftfe
 
           if (isupf(toParse))
             {
-              // std::string xmlFileName = newFolder + "/" + toParse.substr(0,
-              // toParse.find(".upf"));
-              std::string xmlFileName = newFolder + "/" + "z" + z + ".xml";
-              int         errorFlag;
+              std::string upfFileName = toParse;
               if (pseudoTestsFlag)
                 {
                   std::string dftPath = DFTFE_PATH;
 #ifdef USE_COMPLEX
-                  std::string newPath =
+                  upfFileName =
                     dftPath + "/tests/dft/pseudopotential/complex/" + toParse;
 #else
-                  std::string newPath =
+                  upfFileName =
                     dftPath + "/tests/dft/pseudopotential/real/" + toParse;
 #endif
-
-                  unsigned int nlccFlag = 0;
-                  unsigned int socFlag  = 0;
-                  unsigned int pawFlag  = 0;
-                  errorFlag = dftfe::pseudoUtils::pseudoPotentialToDftfeParser(
-                    newPath, newFolder, verbosity, nlccFlag, socFlag, pawFlag);
-                  nlccSum += nlccFlag;
                 }
-              else
+
+              std::shared_ptr<const pseudoPotentialData> data =
+                getPseudoPotentialData(upfFileName, mpiComm);
+              pseudoPotentialDataMap[std::stoi(z)] = data;
+              nlccSum += data->hasNLCC ? 1 : 0;
+
+              if (!pseudoTestsFlag && verbosity >= 1)
                 {
-                  unsigned int nlccFlag = 0;
-                  unsigned int socFlag  = 0;
-                  unsigned int pawFlag  = 0;
-                  errorFlag = dftfe::pseudoUtils::pseudoPotentialToDftfeParser(
-                    toParse, newFolder, verbosity, nlccFlag, socFlag, pawFlag);
-                  nlccSum += nlccFlag;
-
-                  if (verbosity >= 1)
-                    {
-                      pcout << " Reading Pseudopotential File: " << toParse
-                            << ", with atomic number: " << z;
-                      if (nlccFlag > 0)
-                        pcout << ", has data for nonlinear core-correction";
-                      else
-                        pcout << ", has no nonlinear core-correction";
-                    }
-                  if (verbosity >= 1)
-                    {
-                      if (socFlag > 0)
-                        pcout << ", and has data for SOC" << std::endl;
-                      else
-                        pcout << ", and has no SOC" << std::endl;
-                    }
+                  pcout << " Reading Pseudopotential File: " << toParse
+                        << ", with atomic number: " << z;
+                  if (data->hasNLCC)
+                    pcout << ", has data for nonlinear core-correction";
+                  else
+                    pcout << ", has no nonlinear core-correction";
+                  if (data->hasSOC)
+                    pcout << ", and has data for SOC" << std::endl;
+                  else
+                    pcout << ", and has no SOC" << std::endl;
                 }
-
-              AssertThrow(errorFlag == 0,
-                          dealii::ExcMessage(
-                            "Error in reading Pseudopotential File"));
             }
         }
 
-      // if(nlccSum > 0)
-      // dftParameters::nonLinearCoreCorrection = true;
-
-      // if(dftParameters::nonLinearCoreCorrection == true)
-      // pcout<<"Few atoms have pseudopotentials with nonlinear core
-      // correction"<<std::endl;
-
-
       AssertThrow(
         atomTypes.size() == natomTypes,
         dealii::ExcMessage(
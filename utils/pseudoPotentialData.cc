@@ -0,0 +1,416 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2017-2022 The Regents of the University of Michigan and DFT-FE
+// authors.
+//
+// This file is part of the DFT-FE code.
+//
+// The DFT-FE code is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the DFT-FE distribution.
+//
+// ---------------------------------------------------------------------
+
+#include <headers.h>
+#include <pseudoPotentialData.h>
+#include <libxml/parser.h>
+#include <libxml/tree.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <sstream>
+
+namespace dftfe
+{
+  namespace pseudoUtils
+  {
+    namespace internal
+    {
+      // first child element of parent with the given name, NULL if there is
+      // none
+      xmlNodePtr
+      findChild(const xmlNodePtr parent, const std::string &name)
+      {
+        for (xmlNodePtr cur = parent->children; cur != NULL; cur = cur->next)
+          if (cur->type == XML_ELEMENT_NODE &&
+              !xmlStrcmp(cur->name, (const xmlChar *)name.c_str()))
+            return cur;
+        return NULL;
+      }
+
+      xmlNodePtr
+      getChild(const xmlNodePtr   parent,
+               const std::string &name,
+               const std::string &fileName)
+      {
+        const xmlNodePtr child = findChild(parent, name);
+        AssertThrow(child != NULL,
+                    dealii::ExcMessage("DFT-FE Error: tag " + name +
+                                       " not found in pseudopotential file " +
+                                       fileName));
+        return child;
+      }
+
+      std::string
+      getAttribute(const xmlNodePtr   node,
+                   const std::string &name,
+                   const std::string &fileName)
+      {
+        xmlChar *value = xmlGetProp(node, (const xmlChar *)name.c_str());
+        AssertThrow(value != NULL,
+                    dealii::ExcMessage(
+                      "DFT-FE Error: attribute " + name + " of tag " +
+                      std::string((const char *)node->name) +
+                      " not found in pseudopotential file " + fileName));
+        std::string attribute((const char *)value);
+        xmlFree(value);
+
+        const std::size_t first = attribute.find_first_not_of(" \t\n\r");
+        if (first == std::string::npos)
+          return std::string();
+        const std::size_t last = attribute.find_last_not_of(" \t\n\r");
+        return attribute.substr(first, last - first + 1);
+      }
+
+      std::vector<double>
+      getValues(const xmlNodePtr node)
+      {
+        std::vector<double> values;
+        xmlChar *           content = xmlNodeGetContent(node);
+        if (content == NULL)
+          return values;
+        std::istringstream ss((const char *)content);
+        xmlFree(content);
+        double value;
+        while (ss >> value)
+          values.push_back(value);
+        return values;
+      }
+
+      // rows of (r, f(r)) with f(r) = scaling * data(r) / r^radialPower,
+      // with the value at the first grid point replaced by the value at the
+      // second one if replaceFirstRow is set
+      std::vector<std::vector<double>>
+      createRadialTable(const std::vector<double> &radialCoord,
+                        const std::vector<double> &data,
+                        const double               scaling,
+                        const int                  radialPower,
+                        const bool                 replaceFirstRow,
+                        const std::string &        tagName,
+                        const std::string &        fileName)
+      {
+        AssertThrow(data.size() <= radialCoord.size() &&
+                      (!replaceFirstRow || data.size() > 1),
+                    dealii::ExcMessage(
+                      "DFT-FE Error: size of " + tagName +
+                      " does not match the radial mesh in pseudopotential "
+                      "file " +
+                      fileName));
+        std::vector<std::vector<double>> table(data.size(),
+                                               std::vector<double>(2, 0.0));
+        for (unsigned int i = 0; i < data.size(); ++i)
+          {
+            const unsigned int j = (replaceFirstRow && i == 0) ? 1 : i;
+            table[i][0]          = radialCoord[i];
+            table[i][1] =
+              scaling * data[j] / std::pow(radialCoord[j], radialPower);
+          }
+        return table;
+      }
+
+      unsigned int
+      getAngularMomentum(const char orbitalType)
+      {
+        const std::string orbitalTypes = "spdf";
+        const std::size_t l            = orbitalTypes.find(orbitalType);
+        AssertThrow(l != std::string::npos,
+                    dealii::ExcMessage(
+                      "DFT-FE Error: invalid orbital label in pseudopotential "
+                      "file"));
+        return l;
+      }
+    } // namespace internal
+
+    bool
+    readAndBroadcastFile(const std::string &fileName,
+                         const MPI_Comm &   mpiComm,
+                         std::string &      contents)
+    {
+      int rank;
+      MPI_Comm_rank(mpiComm, &rank);
+
+      long long size = -1;
+      if (rank == 0)
+        {
+          std::ifstream file(fileName.c_str(), std::ios::binary);
+          if (!file.fail())
+            {
+              std::ostringstream ss;
+              ss << file.rdbuf();
+              contents = ss.str();
+              size     = contents.size();
+            }
+        }
+      MPI_Bcast(&size, 1, MPI_LONG_LONG, 0, mpiComm);
+      if (size < 0)
+        return false;
+
+      contents.resize(size);
+      MPI_Bcast(&contents[0], size, MPI_CHAR, 0, mpiComm);
+      return true;
+    }
+
+    std::shared_ptr<const pseudoPotentialData>
+    parseUPF(const std::string &fileName, const std::string &contents)
+    {
+      std::unique_ptr<xmlDoc, void (*)(xmlDocPtr)> doc(
+        xmlReadMemory(contents.data(),
+                      contents.size(),
+                      fileName.c_str(),
+                      NULL,
+                      XML_PARSE_NONET | XML_PARSE_HUGE),
+        xmlFreeDoc);
+      AssertThrow(doc != nullptr,
+                  dealii::ExcMessage(
+                    "DFT-FE Error: could not parse pseudopotential file " +
+                    fileName));
+      const xmlNodePtr root = xmlDocGetRootElement(doc.get());
+      AssertThrow(root != NULL,
+                  dealii::ExcMessage(
+                    "DFT-FE Error: empty pseudopotential file " + fileName));
+
+      std::shared_ptr<pseudoPotentialData> data =
+        std::make_shared<pseudoPotentialData>();
+      data->fileName = fileName;
+
+      const xmlNodePtr header = internal::getChild(root, "PP_HEADER", fileName);
+      data->hasNLCC =
+        internal::getAttribute(header, "core_correction", fileName) == "T";
+      data->hasSOC = internal::getAttribute(header, "has_so", fileName) == "T";
+      data->isPAW  = internal::getAttribute(header, "is_paw", fileName) == "T";
+
+      const std::vector<double> radialCoord = internal::getValues(
+        internal::getChild(internal::getChild(root, "PP_MESH", fileName),
+                           "PP_R",
+                           fileName));
+      AssertThrow(radialCoord.size() > 1,
+                  dealii::ExcMessage(
+                    "DFT-FE Error: empty radial mesh in pseudopotential file " +
+                    fileName));
+
+      //
+      // projectors, in the order of the upf file
+      //
+      const xmlNodePtr nonLocal =
+        internal::getChild(root, "PP_NONLOCAL", fileName);
+      std::vector<unsigned int>        angularMomenta;
+      std::vector<std::vector<double>> betaValues;
+      for (unsigned int i = 1;; ++i)
+        {
+          const xmlNodePtr beta =
+            internal::findChild(nonLocal, "PP_BETA." + std::to_string(i));
+          if (beta == NULL)
+            break;
+          angularMomenta.push_back(std::stoi(
+            internal::getAttribute(beta, "angular_momentum", fileName)));
+          betaValues.push_back(internal::getValues(beta));
+        }
+      const unsigned int numRadProjectors = angularMomenta.size();
+
+      std::vector<double> totalAngularMomenta(numRadProjectors, 0.0);
+      if (data->hasSOC)
+        {
+          const xmlNodePtr spinOrbit =
+            internal::getChild(root, "PP_SPIN_ORB", fileName);
+          for (unsigned int i = 0; i < numRadProjectors; ++i)
+            totalAngularMomenta[i] = std::stod(internal::getAttribute(
+              internal::getChild(spinOrbit,
+                                 "PP_RELBETA." + std::to_string(i + 1),
+                                 fileName),
+              "jjj",
+              fileName));
+        }
+
+      // the radial projectors are grouped by l in increasing order
+      std::vector<unsigned int> projectorOrder(numRadProjectors);
+      for (unsigned int i = 0; i < numRadProjectors; ++i)
+        projectorOrder[i] = i;
+      std::stable_sort(projectorOrder.begin(),
+                       projectorOrder.end(),
+                       [&angularMomenta](const unsigned int a,
+                                         const unsigned int b) {
+                         return angularMomenta[a] < angularMomenta[b];
+                       });
+
+      for (unsigned int i = 0; i < numRadProjectors; ++i)
+        {
+          const unsigned int iBeta = projectorOrder[i];
+          const unsigned int l     = angularMomenta[iBeta];
+          const std::vector<std::vector<double>> table =
+            internal::createRadialTable(radialCoord,
+                                        betaValues[iBeta],
+                                        1.0,
+                                        1,
+                                        true,
+                                        "PP_BETA." + std::to_string(iBeta + 1),
+                                        fileName);
+          AssertThrow(table.size() == radialCoord.size(),
+                      dealii::ExcMessage(
+                        "DFT-FE Error: size of PP_BETA." +
+                        std::to_string(iBeta + 1) +
+                        " does not match the radial mesh in pseudopotential "
+                        "file " +
+                        fileName));
+
+          if (data->radialProjectors.empty() ||
+              data->radialProjectors.back().first != l)
+            data->radialProjectors.push_back(std::make_pair(l, table));
+          else
+            {
+              std::vector<std::vector<double>> &projectorTable =
+                data->radialProjectors.back().second;
+              for (unsigned int k = 0; k < table.size(); ++k)
+                projectorTable[k].push_back(table[k][1]);
+            }
+
+          for (int m = -(int)l; m <= (int)l; ++m)
+            {
+              std::vector<double> projectorId;
+              projectorId.push_back(i);
+              projectorId.push_back(l);
+              if (data->hasSOC)
+                projectorId.push_back(totalAngularMomenta[iBeta]);
+              projectorId.push_back(m);
+              data->projectorIds.push_back(projectorId);
+            }
+        }
+
+      const std::vector<double> dij =
+        internal::getValues(internal::getChild(nonLocal, "PP_DIJ", fileName));
+      AssertThrow(dij.size() == numRadProjectors * numRadProjectors,
+                  dealii::ExcMessage(
+                    "DFT-FE Error: size of PP_DIJ does not match the number "
+                    "of projectors in pseudopotential file " +
+                    fileName));
+      data->couplingMatrix.resize(numRadProjectors,
+                                  std::vector<double>(numRadProjectors, 0.0));
+      for (unsigned int i = 0; i < numRadProjectors; ++i)
+        for (unsigned int j = 0; j < numRadProjectors; ++j)
+          data->couplingMatrix[i][j] =
+            dij[projectorOrder[i] * numRadProjectors + projectorOrder[j]] / 2;
+
+      //
+      // local potential and densities
+      //
+      data->localPotential = internal::createRadialTable(
+        radialCoord,
+        internal::getValues(internal::getChild(root, "PP_LOCAL", fileName)),
+        0.5,
+        0,
+        false,
+        "PP_LOCAL",
+        fileName);
+
+      const std::vector<double> rhoAtom =
+        internal::getValues(internal::getChild(root, "PP_RHOATOM", fileName));
+      data->valenceDensity = internal::createRadialTable(
+        radialCoord,
+        rhoAtom,
+        1.0 / (4 * M_PI),
+        2,
+        false,
+        "PP_RHOATOM",
+        fileName);
+      // PP_RHOATOM is 4*pi*r^2 times the density and the grid usually starts
+      // at r=0, the value at the first grid point is taken as is
+      if (!rhoAtom.empty())
+        data->valenceDensity[0][1] = rhoAtom[0];
+
+      if (data->hasNLCC)
+        data->coreDensity = internal::createRadialTable(
+          radialCoord,
+          internal::getValues(internal::getChild(root, "PP_NLCC", fileName)),
+          1.0,
+          0,
+          false,
+          "PP_NLCC",
+          fileName);
+
+      //
+      // single atom wavefunctions
+      //
+      const xmlNodePtr pswfc = internal::findChild(root, "PP_PSWFC");
+      for (unsigned int i = 1; pswfc != NULL; ++i)
+        {
+          const xmlNodePtr chi =
+            internal::findChild(pswfc, "PP_CHI." + std::to_string(i));
+          if (chi == NULL)
+            break;
+          std::string label = internal::getAttribute(chi, "label", fileName);
+          std::transform(label.begin(), label.end(), label.begin(), ::tolower);
+          AssertThrow(label.size() > 1 && std::isdigit(label[0]),
+                      dealii::ExcMessage(
+                        "DFT-FE Error: invalid orbital label " + label +
+                        " in pseudopotential file " + fileName));
+          const unsigned int n = label[0] - '0';
+          const unsigned int l = internal::getAngularMomentum(label[1]);
+          data->orbitals[std::make_pair(n, l)] =
+            internal::createRadialTable(radialCoord,
+                                        internal::getValues(chi),
+                                        1.0,
+                                        0,
+                                        false,
+                                        "PP_CHI." + std::to_string(i),
+                                        fileName);
+        }
+
+      return data;
+    }
+
+    std::shared_ptr<const pseudoPotentialData>
+    getPseudoPotentialData(const std::string &fileName,
+                           const MPI_Comm &   mpiComm)
+    {
+      // parsed files for the lifetime of the process, keyed on the file path
+      // and validated with the size and hash of the contents
+      struct cacheEntry
+      {
+        std::size_t                                size;
+        std::size_t                                hash;
+        std::shared_ptr<const pseudoPotentialData> data;
+      };
+      static std::mutex                        cacheMutex;
+      static std::map<std::string, cacheEntry> cache;
+
+      std::string contents;
+      AssertThrow(readAndBroadcastFile(fileName, mpiComm, contents),
+                  dealii::ExcMessage(
+                    "DFT-FE Error: could not open pseudopotential file " +
+                    fileName));
+      const std::size_t hash = std::hash<std::string>()(contents);
+
+      {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        std::map<std::string, cacheEntry>::const_iterator it =
+          cache.find(fileName);
+        if (it != cache.end() && it->second.size == contents.size() &&
+            it->second.hash == hash)
+          return it->second.data;
+      }
+
+      std::shared_ptr<const pseudoPotentialData> data =
+        parseUPF(fileName, contents);
+
+      std::lock_guard<std::mutex> lock(cacheMutex);
+      cache[fileName] = cacheEntry{contents.size(), hash, data};
+      return data;
+    }
+  } // namespace pseudoUtils
+} // namespace dftfe
@@ -70,6 +70,12 @@ namespace dftfe
           dealii::Patterns::Integer(1, 50),
           "[Standard] NUMBER OF IMAGES:Default option is 7. When NEB is triggered this controls the total number of images along the MEP including the end points");
 
+        prm.declare_entry(
+          "NUMBER OF IMAGE GROUPS",
+          "1",
+          dealii::Patterns::Integer(1, 50),
+          "[Advanced] Number of groups the MPI tasks are split into to solve the images concurrently. The images are distributed round robin over the groups, each group solves the ground states of its images on its own MPI communicator, and only the energies, forces and atomic positions of the images are exchanged between the groups at every NEB step. The total number of MPI tasks must be a multiple of the number of groups, and the number of groups cannot exceed NUMBER OF IMAGES. Default is 1, where all the images are solved one after another using all the MPI tasks.");
+
         prm.declare_entry(
           "MAXIMUM SPRING CONSTANT",
           "5e-3",
@@ -176,6 +182,7 @@ namespace dftfe
     {
       numberOfImages      = prm.get_integer("NUMBER OF IMAGES");
       imageFreeze         = prm.get_bool("ALLOW IMAGE FREEZING");
+      numberImageGroups   = prm.get_integer("NUMBER OF IMAGE GROUPS");
       Kmax                = prm.get_double("MAXIMUM SPRING CONSTANT");
       Kmin                = prm.get_double("MINIMUM SPRING CONSTANT");
       pathThreshold       = prm.get_double("PATH THRESHOLD");
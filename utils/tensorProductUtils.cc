@@ -0,0 +1,65 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2017-2022 The Regents of the University of Michigan and DFT-FE
+// authors.
+//
+// This file is part of the DFT-FE code.
+//
+// The DFT-FE code is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the DFT-FE distribution.
+//
+// ---------------------------------------------------------------------
+
+#include <tensorProductUtils.h>
+
+namespace dftfe
+{
+  namespace tensorProductUtils
+  {
+    void
+    contractTensorProductDirection(
+      const dftfe::linearAlgebra::BLASWrapper<dftfe::utils::MemorySpace::HOST>
+        &                                BLASWrapper,
+      const double *                     matrix,
+      const unsigned int                 matrixRows,
+      const unsigned int                 matrixCols,
+      const bool                         transpose,
+      const unsigned int                 direction,
+      const std::array<unsigned int, 3> &extents,
+      const unsigned int                 nInner,
+      const double *                     in,
+      const double                       beta,
+      double *                           out)
+    {
+      const unsigned int contractedExtent = transpose ? matrixRows : matrixCols;
+      const unsigned int outputExtent     = transpose ? matrixCols : matrixRows;
+      unsigned int       nAfter = nInner, nBefore = 1;
+      for (unsigned int iDim = 0; iDim < direction; ++iDim)
+        nAfter *= extents[iDim];
+      for (unsigned int iDim = direction + 1; iDim < 3; ++iDim)
+        nBefore *= extents[iDim];
+      const double alpha = 1.0;
+      BLASWrapper.xgemmStridedBatched('N',
+                                      transpose ? 'T' : 'N',
+                                      nAfter,
+                                      outputExtent,
+                                      contractedExtent,
+                                      &alpha,
+                                      in,
+                                      nAfter,
+                                      (long long int)contractedExtent * nAfter,
+                                      matrix,
+                                      matrixCols,
+                                      0,
+                                      &beta,
+                                      out,
+                                      nAfter,
+                                      (long long int)outputExtent * nAfter,
+                                      nBefore);
+    }
+  } // namespace tensorProductUtils
+} // namespace dftfe